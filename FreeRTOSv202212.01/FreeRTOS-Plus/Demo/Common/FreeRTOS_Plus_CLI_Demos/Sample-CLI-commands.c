@@ -70,6 +70,13 @@ static BaseType_t prvTaskStatsCommand( char *pcWriteBuffer, size_t xWriteBufferL
 	static BaseType_t prvRunTimeStatsCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+/*
+ * Implements the critical-sections command.
+ */
+#if( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+	static BaseType_t prvCriticalSectionsCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+#endif /* configUSE_CRITICAL_SECTION_HISTOGRAMS */
+
 /*
  * Implements the echo-three-parameters command.
  */
@@ -138,6 +145,20 @@ static const CLI_Command_Definition_t xParameterEcho =
 	};
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+#if( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+	/* Structure that defines the "critical-sections" command line command.  This
+	generates one line for each call site that entered a critical section or
+	suspended the scheduler, with a log2 histogram of how long the sections
+	lasted.  The optional "reset" parameter clears the histograms. */
+	static const CLI_Command_Definition_t xCriticalSections =
+	{
+		"critical-sections", /* The command string to type. */
+		"\r\ncritical-sections [reset]:\r\n Displays a histogram of how long the critical sections and scheduler suspensions entered from each call site lasted\r\n",
+		prvCriticalSectionsCommand, /* The function to run. */
+		-1 /* Either no parameter or "reset" is expected. */
+	};
+#endif /* configUSE_CRITICAL_SECTION_HISTOGRAMS */
+
 #if( configINCLUDE_QUERY_HEAP_COMMAND == 1 )
 	/* Structure that defines the "query_heap" command line command. */
 	static const CLI_Command_Definition_t xQueryHeap =
@@ -175,6 +196,12 @@ void vRegisterSampleCLICommands( void )
 		FreeRTOS_CLIRegisterCommand( &xRunTimeStats );
 	}
 	#endif
+
+	#if( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+	{
+		FreeRTOS_CLIRegisterCommand( &xCriticalSections );
+	}
+	#endif
 	
 	#if( configINCLUDE_QUERY_HEAP_COMMAND == 1 )
 	{
@@ -291,6 +318,88 @@ BaseType_t xSpacePadding;
 #endif /* configGENERATE_RUN_TIME_STATS */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+
+	static BaseType_t prvCriticalSectionsCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+	{
+	static CriticalSectionHistogram_t xHistograms[ configCRITICAL_SECTION_HISTOGRAM_SITES ];
+	static UBaseType_t uxHistograms = 0, uxNextHistogram = 0;
+	const char *pcParameter;
+	BaseType_t xParameterStringLength, xReturn = pdFALSE;
+	CriticalSectionHistogram_t *pxHistogram;
+	UBaseType_t uxBucket, uxLastBucket;
+	size_t xLength;
+
+		configASSERT( pcWriteBuffer );
+
+		if( uxNextHistogram == 0 )
+		{
+			pcParameter = FreeRTOS_CLIGetParameter( pcCommandString, 1, &xParameterStringLength );
+
+			if( ( pcParameter != NULL ) && ( strncmp( pcParameter, "reset", ( size_t ) xParameterStringLength ) == 0 ) )
+			{
+				vTaskResetCriticalSectionHistograms();
+				snprintf( pcWriteBuffer, xWriteBufferLen, "Critical section histograms reset\r\n" );
+			}
+			else
+			{
+				/* Take a copy of the histograms, then return one line per call
+				site on each subsequent call. */
+				uxHistograms = uxTaskGetCriticalSectionHistograms( xHistograms, configCRITICAL_SECTION_HISTOGRAM_SITES );
+				snprintf( pcWriteBuffer, xWriteBufferLen, "Call site          Kind       Count    Longest  Histogram (log2 buckets from 1)\r\n" );
+
+				if( uxHistograms > 0 )
+				{
+					uxNextHistogram = 1;
+					xReturn = pdTRUE;
+				}
+			}
+		}
+		else
+		{
+			pxHistogram = &( xHistograms[ uxNextHistogram - 1 ] );
+
+			/* Only print the buckets up to the last one used. */
+			uxLastBucket = 0;
+			for( uxBucket = 0; uxBucket < configCRITICAL_SECTION_HISTOGRAM_BUCKETS; uxBucket++ )
+			{
+				if( pxHistogram->ulBuckets[ uxBucket ] != 0 )
+				{
+					uxLastBucket = uxBucket;
+				}
+			}
+
+			xLength = ( size_t ) snprintf( pcWriteBuffer, xWriteBufferLen, "%-18p %-9s %6lu %10lu ", pxHistogram->pvCallSite,
+										   ( pxHistogram->xSchedulerSuspended != pdFALSE ) ? "suspended" : "critical",
+										   ( unsigned long ) pxHistogram->ulCount, ( unsigned long ) pxHistogram->ulLongest );
+
+			for( uxBucket = 0; ( uxBucket <= uxLastBucket ) && ( xLength < xWriteBufferLen ); uxBucket++ )
+			{
+				xLength += ( size_t ) snprintf( pcWriteBuffer + xLength, xWriteBufferLen - xLength, " %lu", ( unsigned long ) pxHistogram->ulBuckets[ uxBucket ] );
+			}
+
+			if( xLength < xWriteBufferLen )
+			{
+				snprintf( pcWriteBuffer + xLength, xWriteBufferLen - xLength, "\r\n" );
+			}
+
+			if( uxNextHistogram < uxHistograms )
+			{
+				uxNextHistogram++;
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				uxNextHistogram = 0;
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CRITICAL_SECTION_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvThreeParameterEchoCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
 {
 const char *pcParameter;
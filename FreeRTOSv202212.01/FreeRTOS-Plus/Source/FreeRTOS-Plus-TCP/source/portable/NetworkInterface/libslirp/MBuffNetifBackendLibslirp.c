@@ -64,6 +64,20 @@
 #define xRECV_BUFFER_SIZE     ( 32U * NETWORK_BUFFER_LEN )
 #define xNUM_TIMERS           ( 10U )
 
+/* Ports that simulate time, such as the Posix port in virtual time mode, need
+ * to know about host threads that can ready a task from outside the kernel. */
+#ifndef portADD_EXTERNAL_EVENT_SOURCE
+    #define portADD_EXTERNAL_EVENT_SOURCE()
+#endif
+
+#ifndef portREMOVE_EXTERNAL_EVENT_SOURCE
+    #define portREMOVE_EXTERNAL_EVENT_SOURCE()
+#endif
+
+#ifndef portSIGNAL_EXTERNAL_EVENT
+    #define portSIGNAL_EXTERNAL_EVENT()
+#endif
+
 #if defined( _WIN32 )
     typedef uintptr_t         Thread_t;
     typedef HANDLE            Mutex_t;
@@ -297,6 +311,8 @@ void vMBuffNetifBackendInit( MessageBufferHandle_t * pxSendMsgBuffer,
                 lRslt = pthread_create( &( pxCtx->xRxThread ), NULL, vReceiveThread, pvContextBuffer );
                 configASSERT( lRslt == 0U );
             #endif /* if defined( _WIN32 ) */
+
+            portADD_EXTERNAL_EVENT_SOURCE();
         }
     }
 
@@ -369,6 +385,8 @@ void vMBuffNetifBackendDeInit( void * pvBackendContext )
             pthread_join( pxCtx->xRxThread, NULL );
         #endif
 
+        portREMOVE_EXTERNAL_EVENT_SOURCE();
+
         vLockSlirpContext( pxCtx );
 
         #if defined( _WIN32 )
@@ -426,6 +444,7 @@ static slirp_ssize_t xSlirp_WriteCallback( const void * pvBuffer,
 
         configASSERT( uxBytesSent == uxLen );
 
+        portSIGNAL_EXTERNAL_EVENT();
         portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
     }
 
@@ -647,6 +666,7 @@ static THREAD_RETURN THREAD_FUNC_DEF vTransmitThread( void * pvParameters )
             }
             vUnlockSlirpContext( pxCtx );
 
+            portSIGNAL_EXTERNAL_EVENT();
             portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
         }
     }
@@ -66,6 +66,20 @@
 #define MAX_CAPTURE_LEN      65535
 #define IP_SIZE              100
 
+/* Ports that simulate time, such as the Posix port in virtual time mode, need
+ * to know about host threads that can ready a task from outside the kernel. */
+#ifndef portADD_EXTERNAL_EVENT_SOURCE
+    #define portADD_EXTERNAL_EVENT_SOURCE()
+#endif
+
+#ifndef portREMOVE_EXTERNAL_EVENT_SOURCE
+    #define portREMOVE_EXTERNAL_EVENT_SOURCE()
+#endif
+
+#ifndef portSIGNAL_EXTERNAL_EVENT
+    #define portSIGNAL_EXTERNAL_EVENT()
+#endif
+
 /* ================== Static Function Prototypes ============================ */
 static int prvConfigureCaptureBehaviour( void );
 static int prvCreateThreadSafeBuffers( void );
@@ -528,6 +542,10 @@ static int prvCreateWorkerThreads( void )
                 break;
             }
 
+            /* The pcap threads only fill buffers that the MAC_ISR task polls,
+             * but while they run, idle time must track the host clock. */
+            portADD_EXTERNAL_EVENT_SOURCE();
+
             ret = pdPASS;
         } while( 0 );
 
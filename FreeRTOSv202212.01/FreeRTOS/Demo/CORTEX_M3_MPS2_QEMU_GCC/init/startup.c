@@ -67,7 +67,9 @@ void Reset_Handler( void )
     _start();
 }
 
-void prvGetRegistersFromStack( uint32_t * pulFaultStackAddress )
+/* Only referenced from the hard fault handler's assembly, so marked used in
+ * case link time optimisation is used. */
+__attribute__( ( used ) ) void prvGetRegistersFromStack( uint32_t * pulFaultStackAddress )
 {
 /* These are volatile to try and prevent the compiler/linker optimising them
  * away as the variables never actually get used.  If the debugger won't show the
@@ -167,7 +169,7 @@ void Default_Handler6( void )
     }
 }
 
-const uint32_t * isr_vector[] __attribute__( ( section( ".isr_vector" ) ) ) =
+const uint32_t * isr_vector[] __attribute__( ( section( ".isr_vector" ), used ) ) =
 {
     ( uint32_t * ) &_estack,
     ( uint32_t * ) &Reset_Handler,       /* Reset                -15 */
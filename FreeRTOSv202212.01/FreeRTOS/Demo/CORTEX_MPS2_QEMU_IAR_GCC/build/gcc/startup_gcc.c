@@ -33,6 +33,9 @@
 #define UART_STATE( baseaddr ) ( *( uint32_t * ) ( baseaddr + 4 ) )
 #define UART_STATE_TXFULL      ( 1 << 0 )
 
+/* Coprocessor access control register, which enables the FPU. */
+#define SCB_CPACR              ( *( volatile uint32_t * ) 0xe000ed88 )
+
 typedef struct UART_t
 {
     volatile uint32_t DATA;
@@ -47,6 +50,8 @@ typedef struct UART_t
 extern void vPortSVCHandler( void );
 extern void xPortPendSVHandler( void );
 extern void xPortSysTickHandler( void );
+extern void UARTRX0_Handler( void );
+extern void UARTTX0_Handler( void );
 extern void TIMER0_Handler( void );
 extern void TIMER1_Handler( void );
 
@@ -58,8 +63,9 @@ void Reset_Handler( void );
 extern int main( void );
 extern uint32_t _estack;
 
-/* Vector table. */
-const uint32_t* isr_vector[] __attribute__((section(".isr_vector"))) =
+/* Vector table.  Marked used as nothing references it when link time
+ * optimisation is used. */
+const uint32_t* isr_vector[] __attribute__((section(".isr_vector"), used)) =
 {
     ( uint32_t * ) &_estack,
     ( uint32_t * ) &Reset_Handler,     // Reset                -15
@@ -77,8 +83,8 @@ const uint32_t* isr_vector[] __attribute__((section(".isr_vector"))) =
     0, // reserved
     ( uint32_t * ) &xPortPendSVHandler, // PendSV handler    -2
     ( uint32_t * ) &xPortSysTickHandler,// SysTick_Handler   -1
-    0,
-    0,
+    ( uint32_t * ) UARTRX0_Handler,    // UART 0 receive
+    ( uint32_t * ) UARTTX0_Handler,    // UART 0 transmit
     0,
     0,
     0,
@@ -95,6 +101,16 @@ const uint32_t* isr_vector[] __attribute__((section(".isr_vector"))) =
 
 void Reset_Handler( void )
 {
+    #if defined( __ARM_FP )
+    {
+        /* Built for the CM4F or CM7 port, so give full access to the FPU
+         * before any code that may use it runs.  The port enables it again
+         * when the scheduler starts. */
+        SCB_CPACR |= ( 0xfUL << 20 );
+        __asm volatile ( "dsb \n isb" ::: "memory" );
+    }
+    #endif
+
     main();
 }
 
@@ -111,9 +127,10 @@ volatile uint32_t pc; /* Program counter. */
 volatile uint32_t psr;/* Program status register. */
 
 /* Called from the hardfault handler to provide information on the processor
- * state at the time of the fault.
+ * state at the time of the fault.  Only referenced from assembly, so marked
+ * used for link time optimisation.
  */
-void prvGetRegistersFromStack( uint32_t *pulFaultStackAddress )
+__attribute__((used)) void prvGetRegistersFromStack( uint32_t *pulFaultStackAddress )
 {
     r0 = pulFaultStackAddress[ 0 ];
     r1 = pulFaultStackAddress[ 1 ];
@@ -60,6 +60,8 @@ extern void __iar_program_start(void);
 extern void xPortPendSVHandler(void);
 extern void xPortSysTickHandler(void);
 extern void vPortSVCHandler(void);
+extern void UARTRX0_Handler( void );
+extern void UARTTX0_Handler( void );
 extern void TIMER0_Handler( void );
 extern void TIMER1_Handler( void );
 
@@ -113,8 +115,8 @@ __root const uVectorEntry __vector_table[] @ ".intvec" =
     0,                                      // Reserved
     xPortPendSVHandler,                     // The PendSV handler
     xPortSysTickHandler,                    // The SysTick handler
-    0,                                      // uart0 receive 0
-    0,                                      // uart0 transmit
+    UARTRX0_Handler,                        // uart0 receive 0
+    UARTTX0_Handler,                        // uart0 transmit
     0,                                      // uart1 receive
     0,                                      // uart1 transmit
     0,                                      // uart 2 receive
@@ -6,6 +6,9 @@
 #include <stdio.h>
 #include <string.h>
 
+/* Demo includes. */
+#include "uart.h"
+
 /* This project provides two demo applications.  A simple blinky style demo
 application, and a more comprehensive test and demo application.  The
 mainCREATE_SIMPLE_BLINKY_DEMO_ONLY setting is used to select between the two.
@@ -18,15 +21,6 @@ demo application will be built.  The comprehensive test and demo application is
 implemented and described in main_full.c. */
 #define mainCREATE_SIMPLE_BLINKY_DEMO_ONLY	1
 
-/* printf() output uses the UART.  These constants define the addresses of the
-required UART registers. */
-#define UART0_ADDRESS 	( 0x40004000UL )
-#define UART0_DATA		( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 0UL ) ) ) )
-#define UART0_STATE		( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 4UL ) ) ) )
-#define UART0_CTRL		( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 8UL ) ) ) )
-#define UART0_BAUDDIV	( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 16UL ) ) ) )
-#define TX_BUFFER_MASK	( 1UL )
-
 /*
  * main_blinky() is used when mainCREATE_SIMPLE_BLINKY_DEMO_ONLY is set to 1.
  * main_full() is used when mainCREATE_SIMPLE_BLINKY_DEMO_ONLY is set to 0.
@@ -41,11 +35,6 @@ extern void main_full( void );
 void vFullDemoTickHookFunction( void );
 void vFullDemoIdleFunction( void );
 
-/*
- * Printf() output is sent to the serial port.  Initialise the serial hardware.
- */
-static void prvUARTInit( void );
-
 /*-----------------------------------------------------------*/
 
 void main( void )
@@ -53,8 +42,9 @@ void main( void )
 	/* See https://www.freertos.org/freertos-on-qemu-mps2-an385-model.html for
 	instructions. */
 
-	/* Hardware initialisation.  printf() output uses the UART for IO. */
-	prvUARTInit();
+	/* Hardware initialisation.  printf() output uses the UART for IO, see
+	uart.c. */
+	uart_init();
 
 	/* The mainCREATE_SIMPLE_BLINKY_DEMO_ONLY setting is described at the top
 	of this file. */
@@ -206,27 +196,14 @@ static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
 }
 /*-----------------------------------------------------------*/
 
-static void prvUARTInit( void )
-{
-	UART0_BAUDDIV = 16;
-	UART0_CTRL = 1;
-}
-/*-----------------------------------------------------------*/
-
 int __write( int iFile, char *pcString, int iStringLength )
 {
-	int iNextChar;
-
 	/* Avoid compiler warnings about unused parameters. */
 	( void ) iFile;
 
-	/* Output the formatted string to the UART. */
-	for( iNextChar = 0; iNextChar < iStringLength; iNextChar++ )
-	{
-		while( ( UART0_STATE & TX_BUFFER_MASK ) != 0 );
-		UART0_DATA = *pcString;
-		pcString++;
-	}
+	/* Queue the formatted string for the UART TX interrupt.  Output is dropped
+	rather than blocking the caller if the TX buffer is full. */
+	( void ) uart_log( pcString, iStringLength );
 
 	return iStringLength;
 }
@@ -12,8 +12,8 @@
 #include "FreeRTOSConfig.h"
 #include "portmacro.h"
 
-/* Mock hardware specific includes. */
-#include "mock_uart.h"
+/* Hardware specific includes. */
+#include "uart.h"
 #include "mock_gpio.h"
 
 /* Priorities at which the tasks are created. */
@@ -23,8 +23,10 @@
 /* The rate at which the LED blinks. */
 #define mainBLINKY_DELAY_MS           pdMS_TO_TICKS( 500UL )
 
-/* UART buffer size. */
-#define mainUART_BUFFER_SIZE          ( 128 )
+/* UART buffer sizes.  Received bytes are collected into a line of up to
+mainUART_LINE_SIZE characters before being matched against the commands. */
+#define mainUART_BUFFER_SIZE          ( 16 )
+#define mainUART_LINE_SIZE            ( 16 )
 
 /* Function declarations */
 static void vBlinkyTask(void *pvParameters);
@@ -59,27 +61,48 @@ static void vBlinkyTask(void *pvParameters)
 static void vUARTTask(void *pvParameters)
 {
     char buffer[mainUART_BUFFER_SIZE];
-    int len;
+    char line[mainUART_LINE_SIZE + 1];
+    int lineLength = 0;
+    int len, i;
 
     for (;;)
     {
         /* Wait for UART data */
         if (xSemaphoreTake(xUARTSemaphore, portMAX_DELAY) == pdTRUE)
         {
-            /* Read the received data */
-            len = uart_read(buffer, mainUART_BUFFER_SIZE);
-
-            /* Echo the received data back */
-            uart_write(buffer, len);
-
-            /* Process the received command (if any) */
-            if (strncmp(buffer, "BLINK ON", len) == 0)
+            /* The RX interrupt fires per character, so drain everything
+               received since the last time the semaphore was given. */
+            while ((len = uart_read(buffer, mainUART_BUFFER_SIZE)) > 0)
             {
-                xBlinkingEnabled = 1;
-            }
-            else if (strncmp(buffer, "BLINK OFF", len) == 0)
-            {
-                xBlinkingEnabled = 0;
+                /* Echo the received data back */
+                uart_write(buffer, len);
+
+                for (i = 0; i < len; i++)
+                {
+                    if ((buffer[i] != '\r') && (buffer[i] != '\n'))
+                    {
+                        /* Characters beyond the longest command are ignored. */
+                        if (lineLength < mainUART_LINE_SIZE)
+                        {
+                            line[lineLength++] = buffer[i];
+                        }
+                        continue;
+                    }
+
+                    /* Process the received command (if any) */
+                    line[lineLength] = '\0';
+
+                    if (strcmp(line, "BLINK ON") == 0)
+                    {
+                        xBlinkingEnabled = 1;
+                    }
+                    else if (strcmp(line, "BLINK OFF") == 0)
+                    {
+                        xBlinkingEnabled = 0;
+                    }
+
+                    lineLength = 0;
+                }
             }
         }
     }
@@ -104,12 +127,10 @@ void main_blinky(void)
     /* Initialize GPIO for LED */
     gpio_init(GPIO_LED1);
 
-    /* Initialize UART */
-    uart_init();
-    uart_set_interrupt_handler(vUARTInterruptHandler);
-
-    /* Create the semaphore for UART handling */
+    /* Create the semaphore for UART handling before the RX interrupt can
+       give it.  The UART itself was initialised by main(). */
     xUARTSemaphore = xSemaphoreCreateBinary();
+    uart_set_interrupt_handler(vUARTInterruptHandler);
 
     /* Create the blinky task */
     xTaskCreate(vBlinkyTask, "Blinky", configMINIMAL_STACK_SIZE, NULL, mainBLINKY_TASK_PRIORITY, NULL);
@@ -125,7 +146,7 @@ void main_blinky(void)
 }
 
 /*-----------------------------------------------------------*/
-/* Mock implementations of UART and GPIO functions */
+/* Mock implementations of GPIO functions */
 
 /* GPIO implementation */
 void gpio_init(int pin)
@@ -140,29 +161,6 @@ void gpio_toggle(int pin)
     printf("GPIO %d toggled to %d.\n", pin, state);
 }
 
-/* UART implementation */
-void uart_init(void)
-{
-    printf("UART initialized.\n");
-}
-
-void uart_set_interrupt_handler(void (*handler)(void))
-{
-    printf("UART interrupt handler set.\n");
-}
-
-int uart_read(char *buffer, int length)
-{
-    /* Simulate receiving "BLINK ON" or "BLINK OFF" command from ground station */
-    strcpy(buffer, "BLINK ON");
-    return strlen(buffer);
-}
-
-void uart_write(const char *buffer, int length)
-{
-    printf("UART write: %.*s\n", length, buffer);
-}
-
 /*-----------------------------------------------------------*/
 
 /* Idle hook function implementation */
@@ -0,0 +1,343 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+
+/* Demo includes. */
+#include "uart.h"
+
+/* Library includes. */
+#include "SMM_MPS2.h"
+
+/* The UART clock is divided by this value to obtain the baud rate. */
+#define uartBAUD_DIVISOR			( 16UL )
+
+/* Sizes of the stream buffers between the tasks and the UART interrupts.  The
+TX buffer has to absorb bursts of printf() output from all the tasks. */
+#define uartTX_BUFFER_SIZE			( 1024 )
+#define uartRX_BUFFER_SIZE			( 128 )
+
+/* A task blocked in uart_write() is unblocked once this much of the TX buffer
+is free, rather than on every byte sent. */
+#define uartTX_RESUME_SPACE			( uartTX_BUFFER_SIZE / 2 )
+
+/* The RX and TX interrupts must be able to use the FromISR() API. */
+#define uartINTERRUPT_PRIORITY		( configMAX_SYSCALL_INTERRUPT_PRIORITY )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE if output has to be written by polling the UART because the
+ * TX interrupt cannot run.
+ */
+static BaseType_t prvMustPoll( void );
+
+/*
+ * Write bytes to the UART by polling, after first sending anything already
+ * queued in the TX stream buffer.
+ */
+static void prvWritePolled( const char *pcBuffer, size_t xLength );
+
+/*
+ * Write the next queued byte to the UART if the TX interrupt is not already
+ * doing so.  Called with the UART interrupts masked.
+ */
+static void prvStartTransmission( void );
+
+/*
+ * The UART0 interrupt handlers, installed in the vector table.
+ */
+void UARTRX0_Handler( void );
+void UARTTX0_Handler( void );
+
+/*-----------------------------------------------------------*/
+
+/* The stream buffers and their storage.  Stream buffers need one more byte of
+storage than the number of bytes they can hold. */
+static StreamBufferHandle_t xTxStreamBuffer = NULL;
+static StreamBufferHandle_t xRxStreamBuffer = NULL;
+static StaticStreamBuffer_t xTxStreamBufferStruct, xRxStreamBufferStruct;
+static uint8_t ucTxStorage[ uartTX_BUFFER_SIZE + 1 ];
+static uint8_t ucRxStorage[ uartRX_BUFFER_SIZE + 1 ];
+
+/* uart_write() callers take xTxMutex so only one of them at a time waits on
+xTxSpaceSemaphore, which the TX interrupt gives when xTxWriterWaiting is set
+and uartTX_RESUME_SPACE bytes are free. */
+static SemaphoreHandle_t xTxMutex = NULL;
+static SemaphoreHandle_t xTxSpaceSemaphore = NULL;
+static StaticSemaphore_t xTxMutexBuffer, xTxSpaceSemaphoreBuffer;
+static volatile BaseType_t xTxWriterWaiting = pdFALSE;
+
+/* pdTRUE while a byte written to the UART will generate a TX interrupt that
+continues sending from the TX stream buffer. */
+static volatile BaseType_t xTxActive = pdFALSE;
+
+/* Called from the RX interrupt after received bytes have been buffered. */
+static void ( * volatile pxRxHandler )( void ) = NULL;
+
+/* Bytes lost because a stream buffer was full.  Inspect in the debugger or
+read the TX count with uart_get_dropped_bytes(). */
+static volatile uint32_t ulTxDroppedBytes = 0, ulRxDroppedBytes = 0;
+
+/*-----------------------------------------------------------*/
+
+void uart_init( void )
+{
+	/* Enable the transmitter first so polled output works while the rest of
+	the driver is set up. */
+	CMSDK_UART0->BAUDDIV = uartBAUD_DIVISOR;
+	CMSDK_UART0->CTRL = CMSDK_UART_CTRL_TXEN_Msk;
+
+	xTxStreamBuffer = xStreamBufferCreateStatic( uartTX_BUFFER_SIZE, 1, ucTxStorage, &xTxStreamBufferStruct );
+	xRxStreamBuffer = xStreamBufferCreateStatic( uartRX_BUFFER_SIZE, 1, ucRxStorage, &xRxStreamBufferStruct );
+	xTxMutex = xSemaphoreCreateMutexStatic( &xTxMutexBuffer );
+	xTxSpaceSemaphore = xSemaphoreCreateBinaryStatic( &xTxSpaceSemaphoreBuffer );
+	configASSERT( xTxStreamBuffer );
+	configASSERT( xRxStreamBuffer );
+
+	/* The TX interrupt is left enabled permanently.  It fires once for each
+	byte sent, and the handler simply stops when there is nothing more to
+	send, so there is no enable/disable race with the writers. */
+	CMSDK_UART0->INTCLEAR = CMSDK_UART_CTRL_TXIRQ_Msk | CMSDK_UART_CTRL_RXIRQ_Msk;
+	NVIC_SetPriority( UARTRX0_IRQn, uartINTERRUPT_PRIORITY );
+	NVIC_SetPriority( UARTTX0_IRQn, uartINTERRUPT_PRIORITY );
+	NVIC_EnableIRQ( UARTRX0_IRQn );
+	NVIC_EnableIRQ( UARTTX0_IRQn );
+
+	CMSDK_UART0->CTRL = CMSDK_UART_CTRL_TXEN_Msk | CMSDK_UART_CTRL_RXEN_Msk |
+						CMSDK_UART_CTRL_TXIRQEN_Msk | CMSDK_UART_CTRL_RXIRQEN_Msk;
+}
+/*-----------------------------------------------------------*/
+
+void uart_set_interrupt_handler( void ( *handler )( void ) )
+{
+	pxRxHandler = handler;
+}
+/*-----------------------------------------------------------*/
+
+int uart_read( char *buffer, int length )
+{
+	configASSERT( xRxStreamBuffer );
+
+	return ( int ) xStreamBufferReceive( xRxStreamBuffer, buffer, ( size_t ) length, 0 );
+}
+/*-----------------------------------------------------------*/
+
+void uart_write( const char *buffer, int length )
+{
+UBaseType_t uxSavedInterruptStatus;
+size_t xSent;
+
+	if( prvMustPoll() != pdFALSE )
+	{
+		prvWritePolled( buffer, ( size_t ) length );
+		return;
+	}
+
+	xSemaphoreTake( xTxMutex, portMAX_DELAY );
+	{
+		while( length > 0 )
+		{
+			/* Writers from tasks and interrupts are serialised by masking the
+			UART interrupts, which also stops the TX interrupt reading from
+			the stream buffer while prvStartTransmission() does. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xSent = xStreamBufferSendFromISR( xTxStreamBuffer, buffer, ( size_t ) length, NULL );
+				prvStartTransmission();
+
+				if( xSent < ( size_t ) length )
+				{
+					xTxWriterWaiting = pdTRUE;
+				}
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+			buffer += xSent;
+			length -= ( int ) xSent;
+
+			if( length > 0 )
+			{
+				xSemaphoreTake( xTxSpaceSemaphore, portMAX_DELAY );
+			}
+		}
+	}
+	xSemaphoreGive( xTxMutex );
+}
+/*-----------------------------------------------------------*/
+
+int uart_log( const char *buffer, int length )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	if( prvMustPoll() != pdFALSE )
+	{
+		prvWritePolled( buffer, ( size_t ) length );
+		return length;
+	}
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		/* All or nothing, so a full buffer never leaves half a message. */
+		if( xStreamBufferSpacesAvailable( xTxStreamBuffer ) >= ( size_t ) length )
+		{
+			( void ) xStreamBufferSendFromISR( xTxStreamBuffer, buffer, ( size_t ) length, NULL );
+			prvStartTransmission();
+		}
+		else
+		{
+			ulTxDroppedBytes += ( uint32_t ) length;
+			length = 0;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return length;
+}
+/*-----------------------------------------------------------*/
+
+void uart_putchar( char c )
+{
+	( void ) uart_log( &c, 1 );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long uart_get_dropped_bytes( void )
+{
+	return ( unsigned long ) ulTxDroppedBytes;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMustPoll( void )
+{
+	/* Interrupts are masked before the scheduler starts, inside critical
+	sections and in the assert and fault handlers.  Anything queued then would
+	not be sent until the mask is cleared, which might never happen. */
+	return ( ( xTxStreamBuffer == NULL ) || ( __get_PRIMASK() != 0UL ) || ( __get_BASEPRI() != 0UL ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWritePolled( const char *pcBuffer, size_t xLength )
+{
+uint8_t ucByte;
+
+	/* The TX interrupt cannot run, so it is safe to read from the stream
+	buffer here. */
+	if( xTxStreamBuffer != NULL )
+	{
+		while( xStreamBufferReceiveFromISR( xTxStreamBuffer, &ucByte, 1, NULL ) == 1 )
+		{
+			while( ( CMSDK_UART0->STATE & CMSDK_UART_STATE_TXBF_Msk ) != 0 );
+			CMSDK_UART0->DATA = ucByte;
+		}
+	}
+
+	while( xLength > 0 )
+	{
+		while( ( CMSDK_UART0->STATE & CMSDK_UART_STATE_TXBF_Msk ) != 0 );
+		CMSDK_UART0->DATA = ( uint8_t ) *pcBuffer;
+		pcBuffer++;
+		xLength--;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTransmission( void )
+{
+uint8_t ucByte;
+
+	if( xTxActive == pdFALSE )
+	{
+		if( ( CMSDK_UART0->STATE & CMSDK_UART_STATE_TXBF_Msk ) != 0 )
+		{
+			/* A byte written by prvWritePolled() is still being sent.  Its TX
+			interrupt will continue from the stream buffer. */
+			xTxActive = pdTRUE;
+		}
+		else if( xStreamBufferReceiveFromISR( xTxStreamBuffer, &ucByte, 1, NULL ) == 1 )
+		{
+			xTxActive = pdTRUE;
+			CMSDK_UART0->DATA = ucByte;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void UARTTX0_Handler( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+uint8_t ucByte;
+
+	CMSDK_UART0->INTCLEAR = CMSDK_UART_CTRL_TXIRQ_Msk;
+
+	if( xStreamBufferReceiveFromISR( xTxStreamBuffer, &ucByte, 1, NULL ) == 1 )
+	{
+		CMSDK_UART0->DATA = ucByte;
+	}
+	else
+	{
+		xTxActive = pdFALSE;
+	}
+
+	if( ( xTxWriterWaiting != pdFALSE ) && ( xStreamBufferSpacesAvailable( xTxStreamBuffer ) >= uartTX_RESUME_SPACE ) )
+	{
+		xTxWriterWaiting = pdFALSE;
+		xSemaphoreGiveFromISR( xTxSpaceSemaphore, &xHigherPriorityTaskWoken );
+	}
+
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+void UARTRX0_Handler( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+uint8_t ucByte;
+
+	CMSDK_UART0->INTCLEAR = CMSDK_UART_CTRL_RXIRQ_Msk;
+
+	while( ( CMSDK_UART0->STATE & CMSDK_UART_STATE_RXBF_Msk ) != 0 )
+	{
+		ucByte = ( uint8_t ) CMSDK_UART0->DATA;
+
+		if( xStreamBufferSendFromISR( xRxStreamBuffer, &ucByte, 1, &xHigherPriorityTaskWoken ) == 0 )
+		{
+			ulRxDroppedBytes++;
+		}
+	}
+
+	if( pxRxHandler != NULL )
+	{
+		pxRxHandler();
+	}
+
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
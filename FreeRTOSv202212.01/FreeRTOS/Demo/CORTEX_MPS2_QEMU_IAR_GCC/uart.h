@@ -0,0 +1,84 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+#ifndef UART_H
+#define UART_H
+
+/*
+ * Interrupt driven driver for the CMSDK UART0 on the MPS2 boards.  Received
+ * bytes are moved into a stream buffer by the RX interrupt, and bytes to send
+ * are queued in a stream buffer that the TX interrupt drains, so neither side
+ * busy waits on the UART status register.
+ *
+ * Output falls back to polling the UART while its interrupts cannot run -
+ * before uart_init() is called, before the scheduler starts, inside critical
+ * sections, and from the assert and fault paths - so those messages are not
+ * lost.  Anything already queued is sent first so output stays in order.
+ */
+
+/*
+ * Set the baud rate, create the stream buffers and enable the UART0 RX and TX
+ * interrupts.  Call once from main() before the scheduler is started.
+ */
+void uart_init( void );
+
+/*
+ * Register a function to be called from the RX interrupt each time received
+ * bytes have been added to the RX stream buffer.  The function runs in
+ * interrupt context so must only use FromISR() API functions.
+ */
+void uart_set_interrupt_handler( void ( *handler )( void ) );
+
+/*
+ * Copy up to length received bytes into buffer without blocking.  Returns the
+ * number of bytes copied, which is 0 if nothing has been received.  Only one
+ * task may read from the UART.
+ */
+int uart_read( char *buffer, int length );
+
+/*
+ * Queue length bytes for transmission, blocking the calling task only while
+ * the TX stream buffer is full.  Must not be called from an interrupt.
+ */
+void uart_write( const char *buffer, int length );
+
+/*
+ * Non-blocking logging path used by printf().  Queues the whole buffer if it
+ * fits in the TX stream buffer, otherwise drops it and adds length to the
+ * count returned by uart_get_dropped_bytes().  Returns the number of bytes
+ * queued.  Can be called from tasks and from interrupts that are permitted to
+ * use the FreeRTOS API.
+ */
+int uart_log( const char *buffer, int length );
+
+/* Single character version of uart_log(), used by printf-stdarg.c. */
+void uart_putchar( char c );
+
+/* The number of log bytes dropped because the TX stream buffer was full. */
+unsigned long uart_get_dropped_bytes( void );
+
+#endif /* UART_H */
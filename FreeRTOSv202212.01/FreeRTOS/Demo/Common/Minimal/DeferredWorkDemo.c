@@ -0,0 +1,235 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Tests the deferred work lanes (configUSE_DEFERRED_WORK).
+ *
+ * An interrupt (the tick hook) submits a work item on the first lane each time
+ * it executes, passing the next of 32 event bits in turn.  Submissions made
+ * while the item is still queued are coalesced, so the work function checks
+ * each call receives a run of consecutive bits starting with the bit after
+ * the last one it received - so no submission was lost or delivered twice.
+ *
+ * A task submits a second work item, on the last lane, three times with the
+ * scheduler suspended.  Only the first submission queues the item, and the
+ * work function must then run once with the events of all three.
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "deferred_work.h"
+
+/* Demo app includes. */
+#include "DeferredWorkDemo.h"
+
+#if ( configUSE_DEFERRED_WORK == 1 )
+
+/* The number of event bits the interrupt cycles through. */
+    #define dwdNUM_EVENT_BITS         ( 32UL )
+
+/* The events the task submits, one per submission. */
+    #define dwdTASK_EVENT_1           ( 0x01UL )
+    #define dwdTASK_EVENT_2           ( 0x02UL )
+    #define dwdTASK_EVENT_3           ( 0x04UL )
+
+/* The time the task waits for its work function to run. */
+    #define dwdTASK_WORK_TIMEOUT      pdMS_TO_TICKS( 100 )
+
+/* The delay between the task's coalescing tests. */
+    #define dwdTASK_CYCLE_DELAY       pdMS_TO_TICKS( 20 )
+
+/*-----------------------------------------------------------*/
+
+/* The work functions for the items submitted by the interrupt and the task. */
+    static void prvInterruptWork( void * pvParameter,
+                                  uint32_t ulEvents );
+    static void prvTaskWork( void * pvParameter,
+                             uint32_t ulEvents );
+
+/* The task that tests coalescing. */
+    static void prvCoalescingTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+    static DeferredWorkHandle_t xInterruptWork = NULL, xTaskWork = NULL;
+
+/* The bit the interrupt submits next, and the bit the interrupt work function
+ * expects to receive next. */
+    static uint32_t ulNextBitToSubmit = 0, ulNextBitToReceive = 0;
+
+/* The events passed to prvTaskWork(), and the number of times it ran. */
+    static volatile uint32_t ulTaskWorkEvents = 0, ulTaskWorkCalls = 0;
+
+/* The task notified by prvTaskWork(). */
+    static TaskHandle_t xCoalescingTask = NULL;
+
+/* Incremented while no errors have been found, so the check task can see the
+ * demo is still running. */
+    static volatile uint32_t ulInterruptWorkCycles = 0, ulTaskCycles = 0;
+    static volatile BaseType_t xDemoStatus = pdPASS;
+
+/*-----------------------------------------------------------*/
+
+    void vStartDeferredWorkDemo( void )
+    {
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            static StaticDeferredWork_t xInterruptWorkBuffer;
+
+            xInterruptWork = xDeferredWorkCreateStatic( prvInterruptWork, NULL, 0, &xInterruptWorkBuffer );
+        #else
+            xInterruptWork = xDeferredWorkCreate( prvInterruptWork, NULL, 0 );
+        #endif
+
+        xTaskWork = xDeferredWorkCreate( prvTaskWork, NULL, configDEFERRED_WORK_LANES - 1 );
+        configASSERT( xInterruptWork );
+        configASSERT( xTaskWork );
+
+        xTaskCreate( prvCoalescingTask, "DWCoal", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, &xCoalescingTask );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInterruptWork( void * pvParameter,
+                                  uint32_t ulEvents )
+    {
+        uint32_t ulExpected = 0, ulBit = ulNextBitToReceive;
+
+        ( void ) pvParameter;
+
+        /* Find the run of consecutive bits, starting at ulNextBitToReceive,
+         * that matches ulEvents. */
+        do
+        {
+            ulExpected |= ( 1UL << ulBit );
+            ulBit = ( ulBit + 1UL ) % dwdNUM_EVENT_BITS;
+        } while( ( ulExpected != ulEvents ) && ( ulBit != ulNextBitToReceive ) );
+
+        if( ulExpected == ulEvents )
+        {
+            ulNextBitToReceive = ulBit;
+
+            if( xDemoStatus == pdPASS )
+            {
+                ulInterruptWorkCycles++;
+            }
+        }
+        else
+        {
+            xDemoStatus = pdFAIL;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vDeferredWorkPeriodicISRTest( void )
+    {
+        /* The tick interrupt performs any context switch needed. */
+        ( void ) xDeferredWorkSubmitFromISR( xInterruptWork, 1UL << ulNextBitToSubmit, NULL );
+        ulNextBitToSubmit = ( ulNextBitToSubmit + 1UL ) % dwdNUM_EVENT_BITS;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTaskWork( void * pvParameter,
+                             uint32_t ulEvents )
+    {
+        ( void ) pvParameter;
+
+        ulTaskWorkEvents = ulEvents;
+        ulTaskWorkCalls++;
+        xTaskNotifyGive( xCoalescingTask );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCoalescingTask( void * pvParameters )
+    {
+        uint32_t ulCallsBefore;
+
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            ulCallsBefore = ulTaskWorkCalls;
+
+            /* The worker cannot run while the scheduler is suspended, so the
+             * second and third submissions find the item still queued. */
+            vTaskSuspendAll();
+            {
+                if( xDeferredWorkSubmit( xTaskWork, dwdTASK_EVENT_1 ) != pdTRUE )
+                {
+                    xDemoStatus = pdFAIL;
+                }
+
+                if( xDeferredWorkSubmit( xTaskWork, dwdTASK_EVENT_2 ) != pdFALSE )
+                {
+                    xDemoStatus = pdFAIL;
+                }
+
+                if( xDeferredWorkSubmit( xTaskWork, dwdTASK_EVENT_3 ) != pdFALSE )
+                {
+                    xDemoStatus = pdFAIL;
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            /* Wait for the work function to run. */
+            if( ulTaskNotifyTake( pdTRUE, dwdTASK_WORK_TIMEOUT ) == 0 )
+            {
+                xDemoStatus = pdFAIL;
+            }
+
+            if( ( ulTaskWorkCalls != ( ulCallsBefore + 1UL ) ) ||
+                ( ulTaskWorkEvents != ( dwdTASK_EVENT_1 | dwdTASK_EVENT_2 | dwdTASK_EVENT_3 ) ) )
+            {
+                xDemoStatus = pdFAIL;
+            }
+
+            if( xDemoStatus == pdPASS )
+            {
+                ulTaskCycles++;
+            }
+
+            vTaskDelay( dwdTASK_CYCLE_DELAY );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAreDeferredWorkDemoTasksStillRunning( void )
+    {
+        static uint32_t ulLastInterruptWorkCycles = 0, ulLastTaskCycles = 0;
+        BaseType_t xReturn = xDemoStatus;
+
+        if( ( ulInterruptWorkCycles == ulLastInterruptWorkCycles ) || ( ulTaskCycles == ulLastTaskCycles ) )
+        {
+            xReturn = pdFAIL;
+        }
+
+        ulLastInterruptWorkCycles = ulInterruptWorkCycles;
+        ulLastTaskCycles = ulTaskCycles;
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_DEFERRED_WORK */
@@ -101,6 +101,15 @@ static void prvTakeTwoMutexesReturnInSameOrder( SemaphoreHandle_t xMutex,
 static void prvTakeTwoMutexesReturnInDifferentOrder( SemaphoreHandle_t xMutex,
                                                      SemaphoreHandle_t xLocalMutex );
 
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+/* Tests that a low priority task is raised to the ceiling priority of a
+ * priority ceiling mutex as soon as it takes the mutex, so a medium priority
+ * task cannot preempt it, and drops back to its own priority when it gives the
+ * mutex back. */
+    static void prvTakeCeilingMutex( SemaphoreHandle_t xCeilingMutex );
+#endif
+
 #if ( INCLUDE_xTaskAbortDelay == 1 )
 
     #if ( configUSE_PREEMPTION == 0 )
@@ -724,8 +733,9 @@ static void prvTakeTwoMutexesReturnInDifferentOrder( SemaphoreHandle_t xMutex,
      * yet be disinherited because the local mutex is still held.  This is a
      * simplification to allow FreeRTOS to be integrated with middleware that
      * attempts to hold multiple mutexes without bloating the code with complex
-     * algorithms.  It is possible that the high priority mutex task will
-     * execute as it shares a priority with this task. */
+     * algorithms, unless configUSE_PRIORITY_INHERITANCE_CHAINS is 1.  It is
+     * possible that the high priority mutex task will execute as it shares a
+     * priority with this task. */
     if( xSemaphoreGive( xMutex ) != pdPASS )
     {
         xErrorDetected = pdTRUE;
@@ -735,18 +745,38 @@ static void prvTakeTwoMutexesReturnInDifferentOrder( SemaphoreHandle_t xMutex,
         taskYIELD();
     #endif
 
-    /* The guarded variable is only incremented by the medium priority task,
-     * which still should not have executed as this task should remain at the
-     * higher priority, ensure this is the case. */
-    if( ulGuardedVariable != 0 )
+    #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
     {
-        xErrorDetected = pdTRUE;
-    }
+        /* The priority is recalculated from the mutexes that are still held
+         * each time a mutex is given back.  No task is waiting for the local
+         * mutex, so this task has already been disinherited back to
+         * genqMUTEX_TEST_PRIORITY and the medium priority task has executed. */
+        if( ulGuardedVariable != 1 )
+        {
+            xErrorDetected = pdTRUE;
+        }
 
-    if( uxTaskPriorityGet( NULL ) != genqMUTEX_HIGH_PRIORITY )
+        if( uxTaskPriorityGet( NULL ) != genqMUTEX_TEST_PRIORITY )
+        {
+            xErrorDetected = pdTRUE;
+        }
+    }
+    #else
     {
-        xErrorDetected = pdTRUE;
+        /* The guarded variable is only incremented by the medium priority task,
+         * which still should not have executed as this task should remain at the
+         * higher priority, ensure this is the case. */
+        if( ulGuardedVariable != 0 )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        if( uxTaskPriorityGet( NULL ) != genqMUTEX_HIGH_PRIORITY )
+        {
+            xErrorDetected = pdTRUE;
+        }
     }
+    #endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
 
     /* Now also give back the local mutex, taking the held count back to 0.
      * This time the priority of this task should be disinherited back to the
@@ -900,10 +930,81 @@ static void prvTakeTwoMutexesReturnInSameOrder( SemaphoreHandle_t xMutex,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+    static void prvTakeCeilingMutex( SemaphoreHandle_t xCeilingMutex )
+    {
+        /* Set the guarded variable to a known start value. */
+        ulGuardedVariable = 0;
+
+        /* This task's priority should be as per that assigned when the task
+         * was created. */
+        if( uxTaskPriorityGet( NULL ) != genqMUTEX_LOW_PRIORITY )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        /* Take the ceiling mutex.  No other task uses it so it should be
+         * available now, and this task should be raised to the ceiling priority
+         * without any other task having to wait for the mutex. */
+        if( xSemaphoreTake( xCeilingMutex, intsemNO_BLOCK ) != pdPASS )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        if( uxTaskPriorityGet( NULL ) != genqMUTEX_HIGH_PRIORITY )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        /* Now unsuspend the medium priority task.  This should not run as the
+         * ceiling priority of this task is above that of the medium priority
+         * task. */
+        vTaskResume( xMediumPriorityMutexTask );
+
+        if( ulGuardedVariable != 0 )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        /* Giving the mutex back returns this task to its own priority, so the
+         * medium priority task should execute and increment the guarded
+         * variable before this task runs again. */
+        if( xSemaphoreGive( xCeilingMutex ) != pdPASS )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        #if configUSE_PREEMPTION == 0
+            taskYIELD();
+        #endif
+
+        if( ulGuardedVariable != 1 )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        if( uxTaskPriorityGet( NULL ) != genqMUTEX_LOW_PRIORITY )
+        {
+            xErrorDetected = pdTRUE;
+        }
+    }
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING == 1 */
+/*-----------------------------------------------------------*/
+
 static void prvLowPriorityMutexTask( void * pvParameters )
 {
     SemaphoreHandle_t xMutex = ( SemaphoreHandle_t ) pvParameters, xLocalMutex;
 
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        SemaphoreHandle_t xCeilingMutex;
+
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            static StaticSemaphore_t xCeilingMutexBuffer;
+        #endif
+    #endif
+
     #ifdef USE_STDIO
         void vPrintDisplayMessage( const char * const * ppcMessageToSend );
 
@@ -917,6 +1018,19 @@ static void prvLowPriorityMutexTask( void * pvParameters )
     xLocalMutex = xSemaphoreCreateMutex();
     configASSERT( xLocalMutex );
 
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+    {
+        /* The ceiling mutex is only used by this task, but is given the
+         * ceiling it would need if the high priority task used it too. */
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            xCeilingMutex = xSemaphoreCreateMutexWithCeilingStatic( genqMUTEX_HIGH_PRIORITY, &xCeilingMutexBuffer );
+        #else
+            xCeilingMutex = xSemaphoreCreateMutexWithCeiling( genqMUTEX_HIGH_PRIORITY );
+        #endif
+        configASSERT( xCeilingMutex );
+    }
+    #endif
+
     for( ; ; )
     {
         /* The first tests exercise the priority inheritance when two mutexes
@@ -942,6 +1056,14 @@ static void prvLowPriorityMutexTask( void * pvParameters )
             taskYIELD();
         #endif
 
+        #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        {
+            /* Tests that taking a priority ceiling mutex raises this task to
+             * the ceiling priority straight away. */
+            prvTakeCeilingMutex( xCeilingMutex );
+        }
+        #endif
+
         #if ( INCLUDE_xTaskAbortDelay == 1 )
         {
             /* Tests the behaviour when a low priority task inherits the
@@ -346,13 +346,27 @@ static void prvTakeAndGiveInTheOppositeOrder( void )
         xErrorDetected = pdTRUE;
     }
 
-    /* Should still be at the priority of the slave task as this task still
-     * holds one semaphore (this is a simplification in the priority inheritance
-     * mechanism. */
-    if( uxTaskPriorityGet( NULL ) != intsemSLAVE_PRIORITY )
+    #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
     {
-        xErrorDetected = pdTRUE;
+        /* The priority is recalculated from the mutexes that are still held,
+         * and no task is waiting for the ISR mutex, so this task should already
+         * be back at its own priority. */
+        if( uxTaskPriorityGet( NULL ) != intsemMASTER_PRIORITY )
+        {
+            xErrorDetected = pdTRUE;
+        }
+    }
+    #else
+    {
+        /* Should still be at the priority of the slave task as this task still
+         * holds one semaphore (this is a simplification in the priority
+         * inheritance mechanism. */
+        if( uxTaskPriorityGet( NULL ) != intsemSLAVE_PRIORITY )
+        {
+            xErrorDetected = pdTRUE;
+        }
     }
+    #endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
 
     /* Give back the ISR semaphore, which should result in the priority being
      * disinherited as it was the last mutex held. */
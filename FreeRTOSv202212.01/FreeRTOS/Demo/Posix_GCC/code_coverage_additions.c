@@ -376,7 +376,7 @@ static BaseType_t prvTaskQueryFunctions( void )
     TaskHandle_t xTimerTask, xIdleTask;
     BaseType_t xReturn = pdPASS;
     UBaseType_t uxNumberOfTasks, uxReturned, ux;
-    uint32_t ulTotalRunTime1, ulTotalRunTime2;
+    configRUN_TIME_COUNTER_TYPE ulTotalRunTime1, ulTotalRunTime2;
     const uint32_t ulRunTimeTollerance = ( uint32_t ) 0xfff;
 
     /* Obtain task status with the stack high water mark and without the
@@ -106,6 +106,7 @@
 #include "StreamBufferDemo.h"
 #include "StreamBufferInterrupt.h"
 #include "MessageBufferAMP.h"
+#include "DeferredWorkDemo.h"
 #include "console.h"
 
 /* Priorities at which the tasks are created. */
@@ -201,21 +202,32 @@ int main_full( void )
     /* Create the standard demo tasks. */
     vStartTaskNotifyTask();
     /* vStartTaskNotifyArrayTask(); */
-    vStartBlockingQueueTasks( mainBLOCK_Q_PRIORITY );
     vStartSemaphoreTasks( mainSEM_TEST_PRIORITY );
     vStartPolledQueueTasks( mainQUEUE_POLL_PRIORITY );
     vStartIntegerMathTasks( mainINTEGER_TASK_PRIORITY );
-    vStartGenericQueueTasks( mainGEN_QUEUE_TASK_PRIORITY );
-    vStartQueuePeekTasks();
     vStartMathTasks( mainFLOP_TASK_PRIORITY );
-    vStartRecursiveMutexTasks();
     vStartCountingSemaphoreTasks();
-    vStartDynamicPriorityTasks();
     vStartQueueOverwriteTask( mainQUEUE_OVERWRITE_PRIORITY );
-    vStartEventGroupTasks();
-    vStartInterruptSemaphoreTasks();
-    vCreateBlockTimeTasks();
-    vCreateAbortDelayTasks();
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        {
+            /* These tests use task priorities to control which task runs
+             * when - for example, they expect a task that has just been
+             * resumed to have already run and blocked again, or a lower
+             * priority task not to run until a higher priority task has
+             * suspended itself.  That is not the case when there is more than
+             * one core, so they are only created in the single core build. */
+            vStartBlockingQueueTasks( mainBLOCK_Q_PRIORITY );
+            vStartGenericQueueTasks( mainGEN_QUEUE_TASK_PRIORITY );
+            vStartRecursiveMutexTasks();
+            vStartDynamicPriorityTasks();
+            vStartInterruptSemaphoreTasks();
+            vStartQueuePeekTasks();
+            vStartEventGroupTasks();
+            vCreateBlockTimeTasks();
+            vCreateAbortDelayTasks();
+        }
+    #endif
     xTaskCreate( prvDemoQueueSpaceFunctions, "QSpace", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL );
     xTaskCreate( prvPermanentlyBlockingSemaphoreTask, "BlockSem", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL );
     xTaskCreate( prvPermanentlyBlockingNotificationTask, "BlockNoti", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL );
@@ -225,22 +237,36 @@ int main_full( void )
     vStartStreamBufferInterruptDemo();
     vStartMessageBufferAMPTasks( configMINIMAL_STACK_SIZE );
 
+    #if ( configUSE_DEFERRED_WORK == 1 )
+        {
+            vStartDeferredWorkDemo();
+        }
+    #endif
+
     #if ( configUSE_QUEUE_SETS == 1 )
         {
-            vStartQueueSetTasks();
+            /* The queue set tasks also rely on there being one core. */
+            #if ( configNUMBER_OF_CORES == 1 )
+                vStartQueueSetTasks();
+            #endif
             vStartQueueSetPollingTask();
         }
     #endif
 
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
         {
+            /* The statically allocated tasks are created with their TCBs on
+             * the stack of the creating task, so must have finished with them
+             * before it returns - which is only the case if they have run on
+             * the same core. */
             vStartStaticallyAllocatedTasks();
         }
     #endif
 
-    #if ( configUSE_PREEMPTION != 0 )
+    #if ( ( configUSE_PREEMPTION != 0 ) && ( configNUMBER_OF_CORES == 1 ) )
         {
-            /* Don't expect these tasks to pass when preemption is not used. */
+            /* Don't expect these tasks to pass when preemption is not used, or
+             * when the timer task can run alongside the tasks under test. */
             vStartTimerDemoTask( mainTIMER_TEST_PERIOD );
         }
     #endif
@@ -282,7 +308,7 @@ static void prvCheckTask( void * pvParameters )
         vTaskDelayUntil( &xNextWakeTime, xCycleFrequency );
 
         /* Check the standard demo tasks are running without error. */
-        #if ( configUSE_PREEMPTION != 0 )
+        #if ( ( configUSE_PREEMPTION != 0 ) && ( configNUMBER_OF_CORES == 1 ) )
             {
                 /* These tasks are only created when preemption is used. */
                 if( xAreTimerDemoTasksStillRunning( xCycleFrequency ) != pdTRUE )
@@ -314,36 +340,42 @@ static void prvCheckTask( void * pvParameters )
          * pcStatusMessage = "Error:  NotificationArray";
          *  xErrorCount++;
          * } */
-        else if( xAreInterruptSemaphoreTasksStillRunning() != pdTRUE )
-        {
-            pcStatusMessage = "Error: IntSem";
-            xErrorCount++;
-        }
-        else if( xAreEventGroupTasksStillRunning() != pdTRUE )
-        {
-            pcStatusMessage = "Error: EventGroup";
-            xErrorCount++;
-        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            else if( xAreInterruptSemaphoreTasksStillRunning() != pdTRUE )
+            {
+                pcStatusMessage = "Error: IntSem";
+                xErrorCount++;
+            }
+            else if( xAreEventGroupTasksStillRunning() != pdTRUE )
+            {
+                pcStatusMessage = "Error: EventGroup";
+                xErrorCount++;
+            }
+        #endif
         else if( xAreIntegerMathsTaskStillRunning() != pdTRUE )
         {
             pcStatusMessage = "Error: IntMath";
             xErrorCount++;
         }
-        else if( xAreGenericQueueTasksStillRunning() != pdTRUE )
-        {
-            pcStatusMessage = "Error: GenQueue";
-            xErrorCount++;
-        }
-        else if( xAreQueuePeekTasksStillRunning() != pdTRUE )
-        {
-            pcStatusMessage = "Error: QueuePeek";
-            xErrorCount++;
-        }
-        else if( xAreBlockingQueuesStillRunning() != pdTRUE )
-        {
-            pcStatusMessage = "Error: BlockQueue";
-            xErrorCount++;
-        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            else if( xAreGenericQueueTasksStillRunning() != pdTRUE )
+            {
+                pcStatusMessage = "Error: GenQueue";
+                xErrorCount++;
+            }
+            else if( xAreQueuePeekTasksStillRunning() != pdTRUE )
+            {
+                pcStatusMessage = "Error: QueuePeek";
+                xErrorCount++;
+            }
+            else if( xAreBlockingQueuesStillRunning() != pdTRUE )
+            {
+                pcStatusMessage = "Error: BlockQueue";
+                xErrorCount++;
+            }
+        #endif
         else if( xAreSemaphoreTasksStillRunning() != pdTRUE )
         {
             pcStatusMessage = "Error: SemTest";
@@ -359,11 +391,14 @@ static void prvCheckTask( void * pvParameters )
             pcStatusMessage = "Error: Flop";
             xErrorCount++;
         }
-        else if( xAreRecursiveMutexTasksStillRunning() != pdTRUE )
-        {
-            pcStatusMessage = "Error: RecMutex";
-            xErrorCount++;
-        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            else if( xAreRecursiveMutexTasksStillRunning() != pdTRUE )
+            {
+                pcStatusMessage = "Error: RecMutex";
+                xErrorCount++;
+            }
+        #endif
         else if( xAreCountingSemaphoreTasksStillRunning() != pdTRUE )
         {
             pcStatusMessage = "Error: CountSem";
@@ -374,26 +409,32 @@ static void prvCheckTask( void * pvParameters )
             pcStatusMessage = "Error: Death";
             xErrorCount++;
         }
-        else if( xAreDynamicPriorityTasksStillRunning() != pdPASS )
-        {
-            pcStatusMessage = "Error: Dynamic";
-            xErrorCount++;
-        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            else if( xAreDynamicPriorityTasksStillRunning() != pdPASS )
+            {
+                pcStatusMessage = "Error: Dynamic";
+                xErrorCount++;
+            }
+        #endif
         else if( xIsQueueOverwriteTaskStillRunning() != pdPASS )
         {
             pcStatusMessage = "Error: Queue overwrite";
             xErrorCount++;
         }
-        else if( xAreBlockTimeTestTasksStillRunning() != pdPASS )
-        {
-            pcStatusMessage = "Error: Block time";
-            xErrorCount++;
-        }
-        else if( xAreAbortDelayTestTasksStillRunning() != pdPASS )
-        {
-            pcStatusMessage = "Error: Abort delay";
-            xErrorCount++;
-        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            else if( xAreBlockTimeTestTasksStillRunning() != pdPASS )
+            {
+                pcStatusMessage = "Error: Block time";
+                xErrorCount++;
+            }
+            else if( xAreAbortDelayTestTasksStillRunning() != pdPASS )
+            {
+                pcStatusMessage = "Error: Abort delay";
+                xErrorCount++;
+            }
+        #endif
         else if( xIsInterruptStreamBufferDemoStillRunning() != pdPASS )
         {
             pcStatusMessage = "Error: Stream buffer interrupt";
@@ -405,12 +446,23 @@ static void prvCheckTask( void * pvParameters )
             xErrorCount++;
         }
 
-        #if ( configUSE_QUEUE_SETS == 1 )
+        #if ( configUSE_DEFERRED_WORK == 1 )
+            else if( xAreDeferredWorkDemoTasksStillRunning() != pdPASS )
+            {
+                pcStatusMessage = "Error: Deferred work";
+                xErrorCount++;
+            }
+        #endif
+
+        #if ( ( configUSE_QUEUE_SETS == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
             else if( xAreQueueSetTasksStillRunning() != pdPASS )
             {
                 pcStatusMessage = "Error: Queue set";
                 xErrorCount++;
             }
+        #endif
+
+        #if ( configUSE_QUEUE_SETS == 1 )
             else if( xAreQueueSetPollTasksStillRunning() != pdPASS )
             {
                 pcStatusMessage = "Error: Queue set polling";
@@ -418,13 +470,13 @@ static void prvCheckTask( void * pvParameters )
             }
         #endif /* if ( configUSE_QUEUE_SETS == 1 ) */
 
-        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
             else if( xAreStaticAllocationTasksStillRunning() != pdPASS )
             {
                 xErrorCount++;
                 pcStatusMessage = "Error: Static allocation";
             }
-        #endif /* configSUPPORT_STATIC_ALLOCATION */
+        #endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configNUMBER_OF_CORES == 1 ) */
 
         printf( "%s - tick count %lu \r\n",
                 pcStatusMessage,
@@ -542,9 +594,9 @@ void vFullDemoTickHookFunction( void )
 
     /* Call the periodic timer test, which tests the timer API functions that
      * can be called from an ISR. */
-    #if ( configUSE_PREEMPTION != 0 )
+    #if ( ( configUSE_PREEMPTION != 0 ) && ( configNUMBER_OF_CORES == 1 ) )
         {
-            /* Only created when preemption is used. */
+            /* Only created when preemption is used, and there is one core. */
             vTimerPeriodicISRTests();
         }
     #endif
@@ -556,16 +608,22 @@ void vFullDemoTickHookFunction( void )
         {
             /* Write to a queue that is in use as part of the queue set demo to
              * demonstrate using queue sets from an ISR. */
-            vQueueSetAccessQueueSetFromISR();
+            #if ( configNUMBER_OF_CORES == 1 )
+                vQueueSetAccessQueueSetFromISR();
+            #endif
             vQueueSetPollingInterruptAccess();
         }
     #endif
 
-    /* Exercise event groups from interrupts. */
-    vPeriodicEventGroupsProcessing();
+    #if ( configNUMBER_OF_CORES == 1 )
+        {
+            /* Exercise event groups from interrupts. */
+            vPeriodicEventGroupsProcessing();
 
-    /* Exercise giving mutexes from an interrupt. */
-    vInterruptSemaphorePeriodicTest();
+            /* Exercise giving mutexes from an interrupt. */
+            vInterruptSemaphorePeriodicTest();
+        }
+    #endif
 
     /* Exercise using task notifications from an interrupt. */
     xNotifyTaskFromISR();
@@ -579,6 +637,13 @@ void vFullDemoTickHookFunction( void )
      * a stream being sent from an interrupt to a task. */
     vBasicStreamBufferSendFromISR();
 
+    #if ( configUSE_DEFERRED_WORK == 1 )
+        {
+            /* Hand work to the deferred work lanes from an interrupt. */
+            vDeferredWorkPeriodicISRTest();
+        }
+    #endif
+
     /* For code coverage purposes. */
     xTimerTask = xTimerGetTimerDaemonTaskHandle();
     configASSERT( uxTaskPriorityGetFromISR( xTimerTask ) == configTIMER_TASK_PRIORITY );
@@ -677,6 +742,7 @@ static void prvDemonstrateTaskStateAndHandleGetFunctions( void )
     static portBASE_TYPE xPerformedOneShotTests = pdFALSE;
     TaskHandle_t xTestTask;
     TaskStatus_t xTaskInfo;
+    eTaskState eState;
     extern StackType_t uxTimerTaskStack[];
 
     /* Demonstrate the use of the xTimerGetTimerDaemonTaskHandle() and
@@ -729,8 +795,13 @@ static void prvDemonstrateTaskStateAndHandleGetFunctions( void )
         xErrorCount++;
     }
 
-    /* If this task is running, then the timer task must be blocked. */
-    if( eTaskStateGet( xTimerTaskHandle ) != eBlocked )
+    /* If this task is running, then the timer task must be blocked - unless
+     * there is more than one core, in which case it may be running on another
+     * core, or have been readied for another core that has yet to switch to
+     * it. */
+    eState = eTaskStateGet( xTimerTaskHandle );
+
+    if( ( eState != eBlocked ) && ( ( configNUMBER_OF_CORES == 1 ) || ( ( eState != eRunning ) && ( eState != eReady ) ) ) )
     {
         pcStatusMessage = "Error:  Returned timer task state was incorrect";
         xErrorCount++;
@@ -743,7 +814,7 @@ static void prvDemonstrateTaskStateAndHandleGetFunctions( void )
                   eInvalid );       /* Include the task state in the structure. */
 
     /* Check the information returned by vTaskGetInfo() is as expected. */
-    if( ( xTaskInfo.eCurrentState != eBlocked ) ||
+    if( ( ( xTaskInfo.eCurrentState != eBlocked ) && ( ( configNUMBER_OF_CORES == 1 ) || ( ( xTaskInfo.eCurrentState != eRunning ) && ( xTaskInfo.eCurrentState != eReady ) ) ) ) ||
         ( strcmp( xTaskInfo.pcTaskName, "Tmr Svc" ) != 0 ) ||
         ( xTaskInfo.uxCurrentPriority != configTIMER_TASK_PRIORITY ) ||
         ( xTaskInfo.pxStackBase != uxTimerTaskStack ) ||
@@ -764,8 +835,11 @@ static void prvDemonstrateTaskStateAndHandleGetFunctions( void )
         /* Create a test task to use to test other eTaskStateGet() return values. */
         if( xTaskCreate( prvTestTask, "Test", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, &xTestTask ) == pdPASS )
         {
-            /* If this task is running, the test task must be in the ready state. */
-            if( eTaskStateGet( xTestTask ) != eReady )
+            /* If this task is running, the test task must be in the ready
+             * state - or running, if there is another core to run it. */
+            eState = eTaskStateGet( xTestTask );
+
+            if( ( eState != eReady ) && ( ( configNUMBER_OF_CORES == 1 ) || ( eState != eRunning ) ) )
             {
                 pcStatusMessage = "Error: Returned test task state was incorrect 1";
                 xErrorCount++;
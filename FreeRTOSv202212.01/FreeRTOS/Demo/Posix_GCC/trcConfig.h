@@ -313,6 +313,18 @@ extern "C" {
  */
 #define TRC_CFG_USE_TRACE_ASSERT 0
 
+/**
+ * The trace hooks are called from the simulated interrupts as well as from
+ * tasks.  With more than one simulated core the kernel's task level critical
+ * sections cannot be entered from an interrupt, so the interrupt safe ones
+ * are used instead.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+#define TRACE_ALLOC_CRITICAL_SECTION() UBaseType_t uxTraceSavedInterruptStatus;
+#define TRACE_ENTER_CRITICAL_SECTION() { uxTraceSavedInterruptStatus = vTaskEnterCriticalFromISR(); }
+#define TRACE_EXIT_CRITICAL_SECTION() { vTaskExitCriticalFromISR( uxTraceSavedInterruptStatus ); }
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,421 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "deferred_work.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include deferred work.  This #if is closed at the very bottom of this
+ * file. */
+#if ( configUSE_DEFERRED_WORK == 1 )
+
+/* Each lane holds the items submitted to it on a singly linked stack.  An
+ * interrupt or task pushes an item with a compare and swap on the head of the
+ * stack, and the worker task takes the whole stack at once by exchanging the
+ * head with NULL, so no item is ever removed from the middle of the stack and
+ * the stack needs no lock.  The worker reverses the stack it takes so items
+ * run in the order they were submitted.
+ *
+ * An item is queued while its ulPendingEvents is non-zero.  Submitting ORs the
+ * new events into ulPendingEvents, and only the submission that finds it zero
+ * pushes the item, which is how submissions are coalesced.  The worker reads
+ * the item's pxNext before exchanging ulPendingEvents with zero, as the item
+ * can be pushed again, overwriting pxNext, as soon as ulPendingEvents is
+ * zero.
+ *
+ * Only the submission that pushes onto an empty stack notifies the worker.  The
+ * worker only blocks on its notification after taking an empty stack, so a
+ * notification given between the worker taking the stack and blocking is not
+ * lost - the notification value counts it.
+ *
+ * The macros can be defined in FreeRTOSConfig.h for compilers that do not
+ * provide the GCC __atomic builtins. */
+    #ifndef dwCOMPARE_AND_SWAP_POINTER
+        #define dwCOMPARE_AND_SWAP_POINTER( pxDestination, ppxExpected, pxDesired ) \
+    __atomic_compare_exchange_n( &( pxDestination ), ( ppxExpected ), ( pxDesired ), pdFALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST )
+    #endif
+    #ifndef dwEXCHANGE_POINTER
+        #define dwEXCHANGE_POINTER( pxDestination, pxNewValue )    __atomic_exchange_n( &( pxDestination ), ( pxNewValue ), __ATOMIC_SEQ_CST )
+    #endif
+    #ifndef dwLOAD_POINTER
+        #define dwLOAD_POINTER( pxSource )                         __atomic_load_n( &( pxSource ), __ATOMIC_SEQ_CST )
+    #endif
+    #ifndef dwFETCH_OR
+        #define dwFETCH_OR( ulDestination, ulValue )               __atomic_fetch_or( &( ulDestination ), ( ulValue ), __ATOMIC_SEQ_CST )
+    #endif
+    #ifndef dwEXCHANGE
+        #define dwEXCHANGE( ulDestination, ulNewValue )            __atomic_exchange_n( &( ulDestination ), ( ulNewValue ), __ATOMIC_SEQ_CST )
+    #endif
+
+/* The name given to every worker task. */
+    #ifndef configDEFERRED_WORK_TASK_NAME
+        #define configDEFERRED_WORK_TASK_NAME    "DWork"
+    #endif
+
+/* The definition of a work item. */
+    typedef struct DeferredWorkDefinition
+    {
+        struct DeferredWorkDefinition * pxNext; /*< The next item on the lane's stack while this item is queued. */
+        uint32_t ulPendingEvents;               /*< The events submitted since the function last ran.  Non-zero while the item is queued. */
+        DeferredWorkFunction_t pxFunction;      /*< The function the worker task calls. */
+        void * pvParameter;                     /*< Passed into pxFunction. */
+        UBaseType_t uxLane;                     /*< Index into xLanes[] of the lane the item runs on. */
+    } DeferredWork_t;
+
+/* A lane is a stack of queued items and the task that runs them. */
+    typedef struct DeferredWorkLane
+    {
+        DeferredWork_t * pxQueued; /*< The most recently queued item, or NULL if the lane is idle. */
+        TaskHandle_t xWorkerTask;  /*< The task that runs the lane's items, NULL until the scheduler starts. */
+    } DeferredWorkLane_t;
+
+/*lint -save -e956 A manual analysis and inspection has been used to determine
+ * which static variables must be declared volatile. */
+    PRIVILEGED_DATA static DeferredWorkLane_t xLanes[ configDEFERRED_WORK_LANES ];
+
+/*lint -restore */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The worker task that runs the items queued on one lane.  pvParameters points
+ * to the lane's entry in xLanes[].
+ */
+    static portTASK_FUNCTION_PROTO( prvDeferredWorkTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both versions of the create function to fill in a new item.
+ */
+    static void prvInitialiseNewWork( DeferredWork_t * pxNewWork,
+                                      DeferredWorkFunction_t pxFunction,
+                                      void * pvParameter,
+                                      UBaseType_t uxLane ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both versions of the submit function.  Queues pxWork, or merges
+ * ulEvents into its pending events.  Returns the lane's worker task if the
+ * caller must notify it, otherwise NULL.  *pxQueued is set to pdTRUE if pxWork
+ * was queued.
+ */
+    static TaskHandle_t prvQueueWork( DeferredWork_t * pxWork,
+                                      uint32_t ulEvents,
+                                      BaseType_t * pxQueued ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    BaseType_t xDeferredWorkCreateLanes( void )
+    {
+        static const UBaseType_t uxLanePriorities[ configDEFERRED_WORK_LANES ] = configDEFERRED_WORK_LANE_PRIORITIES;
+        BaseType_t xReturn = pdPASS;
+        UBaseType_t uxLane;
+
+        for( uxLane = 0; ( uxLane < ( UBaseType_t ) configDEFERRED_WORK_LANES ) && ( xReturn == pdPASS ); uxLane++ )
+        {
+            configASSERT( uxLanePriorities[ uxLane ] < ( UBaseType_t ) configMAX_PRIORITIES );
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                xReturn = xTaskCreate( prvDeferredWorkTask,
+                                       configDEFERRED_WORK_TASK_NAME,
+                                       configDEFERRED_WORK_STACK_DEPTH,
+                                       ( void * ) &( xLanes[ uxLane ] ),
+                                       uxLanePriorities[ uxLane ] | portPRIVILEGE_BIT,
+                                       &( xLanes[ uxLane ].xWorkerTask ) );
+            }
+            #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+            {
+                StaticTask_t * pxLaneTaskTCBBuffer = NULL;
+                StackType_t * pxLaneTaskStackBuffer = NULL;
+                uint32_t ulLaneTaskStackSize;
+
+                vApplicationGetDeferredWorkLaneMemory( uxLane, &pxLaneTaskTCBBuffer, &pxLaneTaskStackBuffer, &ulLaneTaskStackSize );
+                xLanes[ uxLane ].xWorkerTask = xTaskCreateStatic( prvDeferredWorkTask,
+                                                                  configDEFERRED_WORK_TASK_NAME,
+                                                                  ulLaneTaskStackSize,
+                                                                  ( void * ) &( xLanes[ uxLane ] ),
+                                                                  uxLanePriorities[ uxLane ] | portPRIVILEGE_BIT,
+                                                                  pxLaneTaskStackBuffer,
+                                                                  pxLaneTaskTCBBuffer );
+
+                if( xLanes[ uxLane ].xWorkerTask == NULL )
+                {
+                    xReturn = pdFAIL;
+                }
+            }
+            #endif /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+        }
+
+        configASSERT( xReturn );
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        DeferredWorkHandle_t xDeferredWorkCreate( DeferredWorkFunction_t pxFunction,
+                                                  void * pvParameter,
+                                                  UBaseType_t uxLane )
+        {
+            DeferredWork_t * pxNewWork;
+
+            pxNewWork = ( DeferredWork_t * ) pvPortMalloc( sizeof( DeferredWork_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of DeferredWork_t is always a pointer to the work item's type. */
+
+            if( pxNewWork != NULL )
+            {
+                prvInitialiseNewWork( pxNewWork, pxFunction, pvParameter, uxLane );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxNewWork;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        DeferredWorkHandle_t xDeferredWorkCreateStatic( DeferredWorkFunction_t pxFunction,
+                                                        void * pvParameter,
+                                                        UBaseType_t uxLane,
+                                                        StaticDeferredWork_t * pxWorkBuffer )
+        {
+            DeferredWork_t * pxNewWork;
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticDeferredWork_t equals the size of the
+                 * real work item structure. */
+                volatile size_t xSize = sizeof( StaticDeferredWork_t );
+                configASSERT( xSize == sizeof( DeferredWork_t ) );
+                ( void ) xSize; /* Keeps lint quiet when configASSERT() is not defined. */
+            }
+            #endif /* configASSERT_DEFINED */
+
+            configASSERT( pxWorkBuffer );
+            pxNewWork = ( DeferredWork_t * ) pxWorkBuffer; /*lint !e740 !e9087 StaticDeferredWork_t is a pointer to a DeferredWork_t, so guaranteed to be aligned and sized correctly (checked by an assert()), so this is safe. */
+
+            if( pxNewWork != NULL )
+            {
+                prvInitialiseNewWork( pxNewWork, pxFunction, pvParameter, uxLane );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxNewWork;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewWork( DeferredWork_t * pxNewWork,
+                                      DeferredWorkFunction_t pxFunction,
+                                      void * pvParameter,
+                                      UBaseType_t uxLane )
+    {
+        configASSERT( pxFunction );
+        configASSERT( uxLane < ( UBaseType_t ) configDEFERRED_WORK_LANES );
+
+        pxNewWork->pxNext = NULL;
+        pxNewWork->ulPendingEvents = 0;
+        pxNewWork->pxFunction = pxFunction;
+        pxNewWork->pvParameter = pvParameter;
+        pxNewWork->uxLane = uxLane;
+    }
+/*-----------------------------------------------------------*/
+
+    static TaskHandle_t prvQueueWork( DeferredWork_t * pxWork,
+                                      uint32_t ulEvents,
+                                      BaseType_t * pxQueued )
+    {
+        DeferredWorkLane_t * const pxLane = &( xLanes[ pxWork->uxLane ] );
+        DeferredWork_t * pxHead;
+        TaskHandle_t xTaskToNotify = NULL;
+
+        configASSERT( ulEvents != 0U );
+
+        if( dwFETCH_OR( pxWork->ulPendingEvents, ulEvents ) == 0U )
+        {
+            /* The item was not queued, and this submission has made it
+             * pending, so no other submission will push it. */
+            pxHead = dwLOAD_POINTER( pxLane->pxQueued );
+
+            do
+            {
+                pxWork->pxNext = pxHead;
+            } while( dwCOMPARE_AND_SWAP_POINTER( pxLane->pxQueued, &pxHead, pxWork ) == pdFALSE );
+
+            if( pxHead == NULL )
+            {
+                /* The lane was idle, so its worker may be blocked.  Before the
+                 * scheduler starts the worker does not exist, and runs the item
+                 * when it is created. */
+                xTaskToNotify = pxLane->xWorkerTask;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            *pxQueued = pdTRUE;
+        }
+        else
+        {
+            /* Coalesced into the pending submission. */
+            *pxQueued = pdFALSE;
+        }
+
+        return xTaskToNotify;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xDeferredWorkSubmitFromISR( DeferredWorkHandle_t xWork,
+                                           uint32_t ulEvents,
+                                           BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xQueued;
+        TaskHandle_t xTaskToNotify;
+
+        configASSERT( xWork );
+
+        xTaskToNotify = prvQueueWork( xWork, ulEvents, &xQueued );
+
+        if( xTaskToNotify != NULL )
+        {
+            vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xQueued;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xDeferredWorkSubmit( DeferredWorkHandle_t xWork,
+                                    uint32_t ulEvents )
+    {
+        BaseType_t xQueued;
+        TaskHandle_t xTaskToNotify;
+
+        configASSERT( xWork );
+
+        xTaskToNotify = prvQueueWork( xWork, ulEvents, &xQueued );
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyGive( xTaskToNotify );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xQueued;
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xDeferredWorkGetLaneTaskHandle( UBaseType_t uxLane )
+    {
+        configASSERT( uxLane < ( UBaseType_t ) configDEFERRED_WORK_LANES );
+
+        return xLanes[ uxLane ].xWorkerTask;
+    }
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvDeferredWorkTask, pvParameters )
+    {
+        DeferredWorkLane_t * const pxLane = ( DeferredWorkLane_t * ) pvParameters;
+        DeferredWork_t * pxWork;
+        DeferredWork_t * pxNext;
+        DeferredWork_t * pxInOrder;
+        uint32_t ulEvents;
+
+        for( ; ; )
+        {
+            pxWork = dwEXCHANGE_POINTER( pxLane->pxQueued, NULL );
+
+            if( pxWork == NULL )
+            {
+                /* Nothing queued, wait for the next submission to an idle lane. */
+                ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            }
+            else
+            {
+                /* The items taken from the lane are still pending, so no other
+                 * submission can push them, and their pxNext can be rewritten
+                 * to reverse the stack into submission order. */
+                pxInOrder = NULL;
+
+                while( pxWork != NULL )
+                {
+                    pxNext = pxWork->pxNext;
+                    pxWork->pxNext = pxInOrder;
+                    pxInOrder = pxWork;
+                    pxWork = pxNext;
+                }
+
+                while( pxInOrder != NULL )
+                {
+                    pxWork = pxInOrder;
+                    pxInOrder = pxWork->pxNext;
+
+                    /* From this point pxWork can be submitted again. */
+                    ulEvents = dwEXCHANGE( pxWork->ulPendingEvents, 0U );
+                    pxWork->pxFunction( pxWork->pvParameter, ulEvents );
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include deferred work.  If you want to include deferred work then ensure
+ * configUSE_DEFERRED_WORK is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_DEFERRED_WORK == 1 */
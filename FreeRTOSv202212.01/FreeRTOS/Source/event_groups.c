@@ -40,6 +40,10 @@
 #include "timers.h"
 #include "event_groups.h"
 
+#if ( configEVENT_GROUP_POOL_LENGTH > 0 )
+    #include "object_pool.h"
+#endif
+
 /* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -54,6 +58,12 @@
     #define eventUNBLOCKED_DUE_TO_BIT_SET    0x0200U
     #define eventWAIT_FOR_ALL_BITS           0x0400U
     #define eventEVENT_BITS_CONTROL_BYTES    0xff00U
+#elif ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+    /* Shifted into place as C89 has no 64-bit integer constants. */
+    #define eventCLEAR_EVENTS_ON_EXIT_BIT    ( ( EventBits_t ) 0x01U << 56 )
+    #define eventUNBLOCKED_DUE_TO_BIT_SET    ( ( EventBits_t ) 0x02U << 56 )
+    #define eventWAIT_FOR_ALL_BITS           ( ( EventBits_t ) 0x04U << 56 )
+    #define eventEVENT_BITS_CONTROL_BYTES    ( ( EventBits_t ) 0xffU << 56 )
 #else
     #define eventCLEAR_EVENTS_ON_EXIT_BIT    0x01000000UL
     #define eventUNBLOCKED_DUE_TO_BIT_SET    0x02000000UL
@@ -61,6 +71,15 @@
     #define eventEVENT_BITS_CONTROL_BYTES    0xff000000UL
 #endif
 
+/* The event bits that have their own list of waiting tasks, and the list a task
+ * waiting for uxBitsToWaitFor should be placed in. */
+#if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+    #define eventINDEXED_BITS_MASK    ( ( ( EventBits_t ) 1U << configEVENT_GROUP_INDEXED_BITS ) - ( EventBits_t ) 1U )
+    #define eventGET_WAITING_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits )    prvGetWaitingList( ( pxEventBits ), ( uxBitsToWaitFor ), ( xWaitForAllBits ) )
+#else
+    #define eventGET_WAITING_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits )    ( &( ( pxEventBits )->xTasksWaitingForBits ) )
+#endif
+
 typedef struct EventGroupDef_t
 {
     EventBits_t uxEventBits;
@@ -73,8 +92,26 @@ typedef struct EventGroupDef_t
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
     #endif
+
+    #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+        List_t xTasksWaitingForBit[ configEVENT_GROUP_INDEXED_BITS ]; /*< Tasks that cannot be unblocked until a particular one of the indexed bits is set.  Other waiting tasks are held in xTasksWaitingForBits. */
+    #endif
 } EventGroup_t;
 
+/* Event groups that are allocated dynamically are taken from a fixed pool of
+ * configEVENT_GROUP_POOL_LENGTH event groups before falling back to the heap. */
+#if ( configEVENT_GROUP_POOL_LENGTH > 0 )
+    PRIVILEGED_DATA static uint8_t ucEventGroupPoolStorage[ poolSTORAGE_SIZE( configEVENT_GROUP_POOL_LENGTH, sizeof( EventGroup_t ) ) ];
+    PRIVILEGED_DATA static uint32_t ulEventGroupPoolSlotsInUse[ poolBITMAP_WORDS( configEVENT_GROUP_POOL_LENGTH ) ];
+    PRIVILEGED_DATA static ObjectPool_t xEventGroupPool = { ucEventGroupPoolStorage, poolSLOT_SIZE( sizeof( EventGroup_t ) ), configEVENT_GROUP_POOL_LENGTH, ulEventGroupPoolSlotsInUse };
+
+    #define eventMALLOC_EVENT_GROUP()               pvObjectPoolMalloc( &xEventGroupPool, sizeof( EventGroup_t ) )
+    #define eventFREE_EVENT_GROUP( pxEventBits )    vObjectPoolFree( &xEventGroupPool, ( pxEventBits ) )
+#else
+    #define eventMALLOC_EVENT_GROUP()               pvPortMalloc( sizeof( EventGroup_t ) )
+    #define eventFREE_EVENT_GROUP( pxEventBits )    vPortFree( pxEventBits )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -89,6 +126,36 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Unblock the tasks in pxList, which is one of the lists of tasks waiting for
+ * bits in pxEventBits, whose wait condition is met by the event bits as they
+ * now are.  The bits those tasks asked to be cleared on exit are added to
+ * *puxBitsToClear.  Called with the scheduler suspended.
+ */
+static void prvUnblockWaitingTasks( EventGroup_t * const pxEventBits,
+                                    const List_t * const pxList,
+                                    EventBits_t * const puxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialise the lists of tasks waiting for bits in pxEventBits.
+ */
+static void prvInitialiseWaitingLists( EventGroup_t * const pxEventBits ) PRIVILEGED_FUNCTION;
+
+#if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+
+/*
+ * Return the list a task waiting for uxBitsToWaitFor should be placed in.  A
+ * task waiting for any one of several bits can be unblocked by setting any of
+ * them, so is placed in xTasksWaitingForBits.  Otherwise the task cannot be
+ * unblocked until the lowest bit it is waiting for that is still clear is set,
+ * so is placed in that bit's list if the bit is indexed.
+ */
+    static List_t * prvGetWaitingList( EventGroup_t * const pxEventBits,
+                                       const EventBits_t uxBitsToWaitFor,
+                                       const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -116,7 +183,15 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         if( pxEventBits != NULL )
         {
             pxEventBits->uxEventBits = 0;
-            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            prvInitialiseWaitingLists( pxEventBits );
+
+            #if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+            {
+                /* The control bits are held in the top byte of a 64-bit
+                 * EventBits_t. */
+                configASSERT( sizeof( EventBits_t ) == sizeof( uint64_t ) );
+            }
+            #endif
 
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
             {
@@ -162,12 +237,20 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
          * sizeof( TickType_t ), the TickType_t variables will be accessed in two
          * or more reads operations, and the alignment requirements is only that
          * of each individual read. */
-        pxEventBits = ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) ); /*lint !e9087 !e9079 see comment above. */
+        pxEventBits = ( EventGroup_t * ) eventMALLOC_EVENT_GROUP(); /*lint !e9087 !e9079 see comment above. */
 
         if( pxEventBits != NULL )
         {
             pxEventBits->uxEventBits = 0;
-            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            prvInitialiseWaitingLists( pxEventBits );
+
+            #if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+            {
+                /* The control bits are held in the top byte of a 64-bit
+                 * EventBits_t. */
+                configASSERT( sizeof( EventBits_t ) == sizeof( uint64_t ) );
+            }
+            #endif
 
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
@@ -235,7 +318,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                vTaskPlaceOnUnorderedEventList( eventGET_WAITING_LIST( pxEventBits, uxBitsToWaitFor, pdTRUE ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                 /* This assignment is obsolete as uxReturn will get set after
                  * the task unblocks, but some compilers mistakenly generate a
@@ -394,7 +477,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
             /* Store the bits that the calling task is waiting for in the
              * task's event list item so the kernel knows when a match is
              * found.  Then enter the blocked state. */
-            vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+            vTaskPlaceOnUnorderedEventList( eventGET_WAITING_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
             /* This is obsolete as it will get set after the task unblocks, but
              * some compilers mistakenly generate a warning about the variable
@@ -505,6 +588,14 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
     {
         BaseType_t xReturn;
 
+        #if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+        {
+            /* The bits are passed to the timer service task in a 32-bit
+             * parameter. */
+            configASSERT( ( uxBitsToClear >> 32 ) == ( EventBits_t ) 0 );
+        }
+        #endif
+
         traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
         xReturn = xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
 
@@ -520,11 +611,11 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
     EventGroup_t const * const pxEventBits = xEventGroup;
     EventBits_t uxReturn;
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         uxReturn = pxEventBits->uxEventBits;
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return uxReturn;
 } /*lint !e818 EventGroupHandle_t is a typedef used in other functions to so can't be pointer to const. */
@@ -533,99 +624,211 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                 const EventBits_t uxBitsToSet )
 {
-    ListItem_t * pxListItem;
-    ListItem_t * pxNext;
-    ListItem_t const * pxListEnd;
-    List_t const * pxList;
-    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+    EventBits_t uxBitsToClear = 0;
     EventGroup_t * pxEventBits = xEventGroup;
-    BaseType_t xMatchFound = pdFALSE;
 
     /* Check the user is not attempting to set the bits used by the kernel
      * itself. */
     configASSERT( xEventGroup );
     configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-    pxList = &( pxEventBits->xTasksWaitingForBits );
-    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
     vTaskSuspendAll();
     {
         traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-        pxListItem = listGET_HEAD_ENTRY( pxList );
-
         /* Set the bits. */
         pxEventBits->uxEventBits |= uxBitsToSet;
 
-        /* See if the new bit value should unblock any tasks. */
-        while( pxListItem != pxListEnd )
+        #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
         {
-            pxNext = listGET_NEXT( pxListItem );
-            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-            xMatchFound = pdFALSE;
-
-            /* Split the bits waited for from the control bits. */
-            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+            EventBits_t uxBitsToVisit = uxBitsToSet & eventINDEXED_BITS_MASK;
+            UBaseType_t uxBit;
+
+            /* Only the lists of the bits being set can hold tasks that are
+             * unblocked by them, as every task in an indexed list is waiting
+             * for that list's bit, and the bit was clear when the task was
+             * placed in the list. */
+            for( uxBit = 0U; uxBitsToVisit != ( EventBits_t ) 0; uxBit++ )
             {
-                /* Just looking for single bit being set. */
-                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+                if( ( uxBitsToVisit & ( ( EventBits_t ) 1U << uxBit ) ) != ( EventBits_t ) 0 )
                 {
-                    xMatchFound = pdTRUE;
+                    uxBitsToVisit &= ~( ( EventBits_t ) 1U << uxBit );
+                    prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ uxBit ] ), &uxBitsToClear );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+        }
+        #endif /* configEVENT_GROUP_INDEXED_BITS */
+
+        /* See if the new bit value should unblock any tasks. */
+        prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), &uxBitsToClear );
+
+        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+         * bit was set in the control word. */
+        pxEventBits->uxEventBits &= ~uxBitsToClear;
+    }
+    ( void ) xTaskResumeAll();
+
+    return pxEventBits->uxEventBits;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnblockWaitingTasks( EventGroup_t * const pxEventBits,
+                                    const List_t * const pxList,
+                                    EventBits_t * const puxBitsToClear )
+{
+    ListItem_t * pxListItem;
+    ListItem_t * pxNext;
+    ListItem_t const * pxListEnd;
+    EventBits_t uxBitsWaitedFor, uxControlBits;
+    BaseType_t xMatchFound;
+
+    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    pxListItem = listGET_HEAD_ENTRY( pxList );
+
+    while( pxListItem != pxListEnd )
+    {
+        pxNext = listGET_NEXT( pxListItem );
+        uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+        xMatchFound = pdFALSE;
+
+        /* Split the bits waited for from the control bits. */
+        uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+        uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+        if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+        {
+            /* Just looking for single bit being set. */
+            if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
             {
-                /* All bits are set. */
                 xMatchFound = pdTRUE;
             }
             else
             {
-                /* Need all bits to be set, but not all the bits were set. */
+                mtCOVERAGE_TEST_MARKER();
             }
-
-            if( xMatchFound != pdFALSE )
+        }
+        else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+        {
+            /* All bits are set. */
+            xMatchFound = pdTRUE;
+        }
+        else
+        {
+            /* Need all bits to be set, but not all the bits were set. */
+            #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
             {
-                /* The bits match.  Should the bits be cleared on exit? */
-                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                if( pxList != &( pxEventBits->xTasksWaitingForBits ) )
                 {
-                    uxBitsToClear |= uxBitsWaitedFor;
+                    /* The bit this task was waiting in the list of is now
+                     * set, so move it to the list of a bit that is still
+                     * clear. */
+                    ( void ) uxListRemove( pxListItem );
+                    vListInsertEnd( prvGetWaitingList( pxEventBits, uxBitsWaitedFor, pdTRUE ), pxListItem );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+            }
+            #endif /* configEVENT_GROUP_INDEXED_BITS */
+        }
 
-                /* Store the actual event flag value in the task's event list
-                 * item before removing the task from the event list.  The
-                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                 * that is was unblocked due to its required bits matching, rather
-                 * than because it timed out. */
-                vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+        if( xMatchFound != pdFALSE )
+        {
+            /* The bits match.  Should the bits be cleared on exit? */
+            if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+            {
+                *puxBitsToClear |= uxBitsWaitedFor;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
 
-            /* Move onto the next list item.  Note pxListItem->pxNext is not
-             * used here as the list item may have been removed from the event list
-             * and inserted into the ready/pending reading list. */
-            pxListItem = pxNext;
+            /* Store the actual event flag value in the task's event list
+             * item before removing the task from the event list.  The
+             * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+             * that is was unblocked due to its required bits matching, rather
+             * than because it timed out. */
+            vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
         }
 
-        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-         * bit was set in the control word. */
-        pxEventBits->uxEventBits &= ~uxBitsToClear;
+        /* Move onto the next list item.  Note pxListItem->pxNext is not
+         * used here as the list item may have been removed from the event list
+         * and inserted into the ready/pending reading list. */
+        pxListItem = pxNext;
     }
-    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
 
-    return pxEventBits->uxEventBits;
+static void prvInitialiseWaitingLists( EventGroup_t * const pxEventBits )
+{
+    vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+    #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+    {
+        UBaseType_t uxBit;
+
+        for( uxBit = 0U; uxBit < ( UBaseType_t ) configEVENT_GROUP_INDEXED_BITS; uxBit++ )
+        {
+            vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+        }
+    }
+    #endif /* configEVENT_GROUP_INDEXED_BITS */
 }
 /*-----------------------------------------------------------*/
 
+#if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+
+    static List_t * prvGetWaitingList( EventGroup_t * const pxEventBits,
+                                       const EventBits_t uxBitsToWaitFor,
+                                       const BaseType_t xWaitForAllBits )
+    {
+        List_t * pxList = &( pxEventBits->xTasksWaitingForBits );
+        EventBits_t uxKeyBits;
+        UBaseType_t uxBit;
+
+        if( xWaitForAllBits != pdFALSE )
+        {
+            uxKeyBits = uxBitsToWaitFor & ~( pxEventBits->uxEventBits );
+        }
+        else if( ( uxBitsToWaitFor & ( uxBitsToWaitFor - ( EventBits_t ) 1U ) ) == ( EventBits_t ) 0 )
+        {
+            /* Waiting for a single bit, which must be clear or the task
+             * would not be waiting. */
+            uxKeyBits = uxBitsToWaitFor;
+        }
+        else
+        {
+            uxKeyBits = 0;
+        }
+
+        uxKeyBits &= eventINDEXED_BITS_MASK;
+
+        if( uxKeyBits != ( EventBits_t ) 0 )
+        {
+            for( uxBit = 0U; ( uxKeyBits & ( ( EventBits_t ) 1U << uxBit ) ) == ( EventBits_t ) 0; uxBit++ )
+            {
+                /* Find the lowest bit. */
+            }
+
+            pxList = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxList;
+    }
+
+#endif /* configEVENT_GROUP_INDEXED_BITS */
+/*-----------------------------------------------------------*/
+
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
     EventGroup_t * pxEventBits = xEventGroup;
@@ -639,6 +842,24 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
     {
         traceEVENT_GROUP_DELETE( xEventGroup );
 
+        #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+        {
+            UBaseType_t uxBit;
+            const List_t * pxTasksWaitingForBit;
+
+            for( uxBit = 0U; uxBit < ( UBaseType_t ) configEVENT_GROUP_INDEXED_BITS; uxBit++ )
+            {
+                pxTasksWaitingForBit = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+
+                while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBit ) > ( UBaseType_t ) 0 )
+                {
+                    /* As below. */
+                    vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBit->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                }
+            }
+        }
+        #endif /* configEVENT_GROUP_INDEXED_BITS */
+
         while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
         {
             /* Unblock the task, returning 0 as the event list is being deleted
@@ -653,7 +874,7 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
     {
         /* The event group can only have been allocated dynamically - free
          * it again. */
-        vPortFree( pxEventBits );
+        eventFREE_EVENT_GROUP( pxEventBits );
     }
     #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
     {
@@ -661,7 +882,7 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
          * dynamically, so check before attempting to free the memory. */
         if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
         {
-            vPortFree( pxEventBits );
+            eventFREE_EVENT_GROUP( pxEventBits );
         }
         else
         {
@@ -735,6 +956,14 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
     {
         BaseType_t xReturn;
 
+        #if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+        {
+            /* The bits are passed to the timer service task in a 32-bit
+             * parameter. */
+            configASSERT( ( uxBitsToSet >> 32 ) == ( EventBits_t ) 0 );
+        }
+        #endif
+
         traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
         xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
 
@@ -61,6 +61,12 @@
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
+/* Must be defaulted before the port layer is included, as ports that support
+ * more than one core select their implementation from it. */
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES    1
+#endif
+
 /* Definitions specific to the port being used. */
 #include "portable.h"
 
@@ -489,6 +495,33 @@
     #define configCHECK_FOR_STACK_OVERFLOW    0
 #endif
 
+/* Setting configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE to 1 removes the stack
+ * overflow check from every context switch and relies on the port's stack limit
+ * register instead.  The fault raised when a task's stack pointer passes the
+ * limit happens before anything outside the stack is written.  The application's
+ * handler for that fault reports it to vApplicationStackOverflowHook() through a
+ * port function, vPortCheckStackOverflowFault() on the Armv8-M ports, called
+ * from UsageFault_Handler().  Only ports that set
+ * portHAS_STACK_OVERFLOW_CHECKING and report the fault can use this, currently
+ * the Armv8-M mainline ports (Cortex-M33, Cortex-M55 and Cortex-M85). */
+#ifndef configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE
+    #define configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE    0
+#endif
+
+#if ( configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE == 1 )
+    #if ( portHAS_STACK_OVERFLOW_CHECKING != 1 )
+        #error configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE needs a port with a stack limit register
+    #endif
+
+    #if ( configCHECK_FOR_STACK_OVERFLOW == 0 )
+        #error configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE reports overflows through vApplicationStackOverflowHook(), so configCHECK_FOR_STACK_OVERFLOW must be 1 or 2
+    #endif
+
+    #if ( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+        #error configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE needs xTaskGetCurrentTaskHandle().  Set INCLUDE_xTaskGetCurrentTaskHandle to 1 in FreeRTOSConfig.h.
+    #endif
+#endif
+
 #ifndef configRECORD_STACK_HIGH_ADDRESS
     #define configRECORD_STACK_HIGH_ADDRESS    0
 #endif
@@ -838,19 +871,30 @@
 #endif
 
 #ifndef portYIELD_WITHIN_API
-    #define portYIELD_WITHIN_API    portYIELD
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define portYIELD_WITHIN_API    portYIELD
+    #else
+        #define portYIELD_WITHIN_API    vTaskYieldWithinAPI
+    #endif
 #endif
 
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
     #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
 #endif
 
+#ifndef portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP
+
+/* The shortest expected idle time, in ticks, for which the port can suppress
+ * the tick. */
+    #define portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+#endif
+
 #ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
-    #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+    #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP
 #endif
 
-#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2
-    #error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP
+    #error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP
 #endif
 
 #ifndef configUSE_TICKLESS_IDLE
@@ -914,13 +958,114 @@
 #endif
 
 #ifndef portASSERT_IF_IN_ISR
-    #define portASSERT_IF_IN_ISR()
+    #if ( configNUMBER_OF_CORES > 1 )
+        #define portASSERT_IF_IN_ISR()    configASSERT( portCHECK_IF_IN_ISR() == pdFALSE )
+    #else
+        #define portASSERT_IF_IN_ISR()
+    #endif
 #endif
 
 #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 #endif
 
+/* When configUSE_PORT_OPTIMISED_TASK_SELECTION is 0, setting
+ * configUSE_READY_PRIORITY_BITMAP to 1 makes the generic task selection
+ * mechanism track ready priorities in a two level bitmap, so the highest
+ * priority ready task is found in constant time for up to 256 priorities
+ * rather than by searching down through the ready lists one priority at a
+ * time. */
+#ifndef configUSE_READY_PRIORITY_BITMAP
+    #define configUSE_READY_PRIORITY_BITMAP    0
+#endif
+
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+        #error configUSE_READY_PRIORITY_BITMAP can only be used when configUSE_PORT_OPTIMISED_TASK_SELECTION is 0.
+    #endif
+
+    #if ( configMAX_PRIORITIES > 256 )
+        #error configMAX_PRIORITIES must not exceed 256 when configUSE_READY_PRIORITY_BITMAP is 1.
+    #endif
+#endif
+
+/* When configNUMBER_OF_CORES is greater than 1 the scheduler runs one task on
+ * each core.  configRUN_MULTIPLE_PRIORITIES set to 0 only lets tasks of the same
+ * priority run at the same time, which preserves the guarantee that a lower
+ * priority task never runs while a higher priority task is ready.
+ * configUSE_CORE_AFFINITY set to 1 allows tasks to be restricted to a subset
+ * of the cores with vTaskCoreAffinitySet(). */
+#ifndef configRUN_MULTIPLE_PRIORITIES
+    #define configRUN_MULTIPLE_PRIORITIES    1
+#endif
+
+#ifndef configUSE_CORE_AFFINITY
+    #define configUSE_CORE_AFFINITY    0
+#endif
+
+#ifndef configTASK_DEFAULT_CORE_AFFINITY
+    #define configTASK_DEFAULT_CORE_AFFINITY    tskNO_AFFINITY
+#endif
+
+#ifndef configUSE_PASSIVE_IDLE_HOOK
+    #define configUSE_PASSIVE_IDLE_HOOK    0
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+    #ifndef portGET_CORE_ID
+        #error portGET_CORE_ID is required when configNUMBER_OF_CORES is greater than 1.  The port does not support more than one core.
+    #endif
+
+    #ifndef portYIELD_CORE
+        #error portYIELD_CORE is required when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK )
+        #error portGET_TASK_LOCK and portRELEASE_TASK_LOCK are required when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if !defined( portGET_ISR_LOCK ) || !defined( portRELEASE_ISR_LOCK )
+        #error portGET_ISR_LOCK and portRELEASE_ISR_LOCK are required when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if !defined( portENTER_CRITICAL_FROM_ISR ) || !defined( portEXIT_CRITICAL_FROM_ISR )
+        #error portENTER_CRITICAL_FROM_ISR and portEXIT_CRITICAL_FROM_ISR are required when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #ifndef portCHECK_IF_IN_ISR
+        #error portCHECK_IF_IN_ISR is required when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if !defined( portGET_CRITICAL_NESTING_COUNT ) || !defined( portSET_CRITICAL_NESTING_COUNT ) || \
+    !defined( portINCREMENT_CRITICAL_NESTING_COUNT ) || !defined( portDECREMENT_CRITICAL_NESTING_COUNT )
+        #error The port must maintain a critical nesting count per core when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+        #error portCRITICAL_NESTING_IN_TCB cannot be used when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+        #error configUSE_PORT_OPTIMISED_TASK_SELECTION must be 0 when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_READY_PRIORITY_BITMAP != 0 )
+        #error configUSE_READY_PRIORITY_BITMAP must be 0 when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        #error configUSE_TICKLESS_IDLE is not supported when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_NEWLIB_REENTRANT == 1 )
+        #error Newlib keeps a single _impure_ptr for all cores, so configUSE_NEWLIB_REENTRANT must be 0 when configNUMBER_OF_CORES is greater than 1.
+    #endif
+#else
+    #ifndef portGET_CORE_ID
+        #define portGET_CORE_ID()    0
+    #endif
+#endif /* configNUMBER_OF_CORES */
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
@@ -947,6 +1092,16 @@
     #define configUSE_SB_COMPLETED_CALLBACK    0
 #endif
 
+#ifndef configUSE_STREAM_BUFFER_LOCK_FREE
+
+/* By default stream buffers use critical sections and scheduler suspension to
+ * register and wake blocked tasks.  Setting configUSE_STREAM_BUFFER_LOCK_FREE to
+ * 1 uses atomic operations on the head and tail indexes and the waiting task
+ * handles instead, which requires a compiler that provides the GCC __atomic
+ * builtins, or definitions of the sb* atomic macros in stream_buffer.c. */
+    #define configUSE_STREAM_BUFFER_LOCK_FREE    0
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
     #define portTICK_TYPE_IS_ATOMIC    0
 #endif
@@ -965,6 +1120,110 @@
     #error configUSE_STATS_FORMATTING_FUNCTIONS cannot be used without dynamic allocation, but configSUPPORT_DYNAMIC_ALLOCATION is not set to 1.
 #endif
 
+/* Setting any of the configXXX_POOL_LENGTH constants to a non-zero value
+ * reserves a fixed pool of that many objects of the corresponding type.
+ * Objects created dynamically are taken from the pool while it has a free
+ * slot, and from the FreeRTOS heap once it is empty.  Queues (including
+ * semaphores and mutexes) and stream buffers (including message buffers) hold
+ * their storage area in the same allocation, so only those whose storage area
+ * fits in configQUEUE_POOL_STORAGE_SIZE or configSTREAM_BUFFER_POOL_STORAGE_SIZE
+ * bytes are taken from the pool.  The default queue storage size of 0 pools
+ * semaphores and mutexes only. */
+#ifndef configTASK_POOL_LENGTH
+    #define configTASK_POOL_LENGTH    0
+#endif
+
+#ifndef configQUEUE_POOL_LENGTH
+    #define configQUEUE_POOL_LENGTH    0
+#endif
+
+#ifndef configQUEUE_POOL_STORAGE_SIZE
+    #define configQUEUE_POOL_STORAGE_SIZE    0
+#endif
+
+#ifndef configTIMER_POOL_LENGTH
+    #define configTIMER_POOL_LENGTH    0
+#endif
+
+#ifndef configEVENT_GROUP_POOL_LENGTH
+    #define configEVENT_GROUP_POOL_LENGTH    0
+#endif
+
+#ifndef configSTREAM_BUFFER_POOL_LENGTH
+    #define configSTREAM_BUFFER_POOL_LENGTH    0
+#endif
+
+#ifndef configSTREAM_BUFFER_POOL_STORAGE_SIZE
+    #define configSTREAM_BUFFER_POOL_STORAGE_SIZE    0
+#endif
+
+#if ( ( configTASK_POOL_LENGTH + configQUEUE_POOL_LENGTH + configTIMER_POOL_LENGTH + configEVENT_GROUP_POOL_LENGTH + configSTREAM_BUFFER_POOL_LENGTH ) > 0 )
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error Object pools replace dynamic allocation, so cannot be used unless configSUPPORT_DYNAMIC_ALLOCATION is set to 1.
+    #endif
+#endif
+
+#if ( ( configSTREAM_BUFFER_POOL_LENGTH > 0 ) && ( configSTREAM_BUFFER_POOL_STORAGE_SIZE == 0 ) )
+    #error configSTREAM_BUFFER_POOL_STORAGE_SIZE must be set to the largest stream buffer size that can be taken from the pool.
+#endif
+
+/* Setting configUSE_HEAP_TASK_CACHE to 1 gives each task a small cache of
+ * free blocks in front of the heap_4 free list.  Requests of up to
+ * 16 << ( configHEAP_TASK_CACHE_SIZE_CLASSES - 1 ) bytes are rounded up to a
+ * power of two size class and, while the calling task's cache holds a block of
+ * that class, are served without suspending the scheduler or searching the
+ * free list.  An empty cache is refilled, and a full one emptied, by
+ * configHEAP_TASK_CACHE_BATCH_SIZE blocks at a time.  A task's cache is
+ * created on its first small allocation and is reached through its thread
+ * local storage pointer configHEAP_TASK_CACHE_TLS_INDEX.  That index has no
+ * default and must be set in FreeRTOSConfig.h to one the application does not
+ * use for anything else.  If an allocation cannot be met from the heap, the
+ * blocks held in the caches of tasks that are not using them at the time are
+ * returned to the heap before the allocation fails.  Only heap_4 implements
+ * the caches - the other heaps build with the option set, but do not cache. */
+#ifndef configUSE_HEAP_TASK_CACHE
+    #define configUSE_HEAP_TASK_CACHE    0
+#endif
+
+#ifndef configHEAP_TASK_CACHE_SIZE_CLASSES
+    #define configHEAP_TASK_CACHE_SIZE_CLASSES    5
+#endif
+
+#ifndef configHEAP_TASK_CACHE_MAGAZINE_SIZE
+    #define configHEAP_TASK_CACHE_MAGAZINE_SIZE    16
+#endif
+
+#ifndef configHEAP_TASK_CACHE_BATCH_SIZE
+    #define configHEAP_TASK_CACHE_BATCH_SIZE    8
+#endif
+
+#if ( configUSE_HEAP_TASK_CACHE == 1 )
+    #ifndef configHEAP_TASK_CACHE_TLS_INDEX
+        #error configUSE_HEAP_TASK_CACHE needs configHEAP_TASK_CACHE_TLS_INDEX to be set to a thread local storage pointer index that the application does not use.
+    #endif
+
+    #if ( ( configHEAP_TASK_CACHE_TLS_INDEX < 0 ) || ( configHEAP_TASK_CACHE_TLS_INDEX >= configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        #error configUSE_HEAP_TASK_CACHE needs a thread local storage pointer.  Increase configNUM_THREAD_LOCAL_STORAGE_POINTERS or set configHEAP_TASK_CACHE_TLS_INDEX to a free index.
+    #endif
+
+    #if ( INCLUDE_xTaskGetSchedulerState != 1 )
+        #error INCLUDE_xTaskGetSchedulerState must be set to 1 in FreeRTOSConfig.h to use configUSE_HEAP_TASK_CACHE.
+    #endif
+
+    #if ( ( configHEAP_TASK_CACHE_BATCH_SIZE < 1 ) || ( configHEAP_TASK_CACHE_BATCH_SIZE > configHEAP_TASK_CACHE_MAGAZINE_SIZE ) )
+        #error configHEAP_TASK_CACHE_BATCH_SIZE must be between 1 and configHEAP_TASK_CACHE_MAGAZINE_SIZE.
+    #endif
+#endif
+
+/* Setting configUSE_QUEUE_ZERO_COPY to 1 adds an API that lends the calling
+ * task a slot in the queue storage area, so an item can be written in place
+ * before it is committed to the queue, or read in place before the slot is
+ * released back to the queue.  At most one send slot and one receive slot can
+ * be lent per queue at any time. */
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
     #if ( ( configUSE_TRACE_FACILITY != 1 ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
         #error configUSE_STATS_FORMATTING_FUNCTIONS is 1 but the functions it enables are not used because neither configUSE_TRACE_FACILITY or configGENERATE_RUN_TIME_STATS are 1.  Set configUSE_STATS_FORMATTING_FUNCTIONS to 0 in FreeRTOSConfig.h.
@@ -978,12 +1237,93 @@
     #define configSTACK_DEPTH_TYPE    uint16_t
 #endif
 
+/* Setting configUSE_RUN_TIME_ACCOUNTING to 1 splits the run time counted by
+ * configGENERATE_RUN_TIME_STATS between tasks, interrupts that report their entry
+ * and exit, and task level critical sections, and extends a run time counter of
+ * up to 32 bits to the width of configRUN_TIME_COUNTER_TYPE.  See
+ * uxTaskGetRunTimeSnapshot(). */
+#ifndef configUSE_RUN_TIME_ACCOUNTING
+    #define configUSE_RUN_TIME_ACCOUNTING    0
+#endif
+
+/* The number of interrupts that can report their run time separately.  Ports
+ * that support run time accounting report the tick interrupt as interrupt 0. */
+#ifndef configRUN_TIME_ISR_COUNT
+    #define configRUN_TIME_ISR_COUNT    1
+#endif
+
+#if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+    #if ( configGENERATE_RUN_TIME_STATS != 1 )
+        #error configUSE_RUN_TIME_ACCOUNTING requires configGENERATE_RUN_TIME_STATS to be 1
+    #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error configUSE_RUN_TIME_ACCOUNTING is not supported when configNUMBER_OF_CORES is greater than 1
+    #endif
+
+    #if ( configRUN_TIME_ISR_COUNT < 1 )
+        #error configRUN_TIME_ISR_COUNT must be at least 1
+    #endif
+#endif
+
 #ifndef configRUN_TIME_COUNTER_TYPE
 
 /* Defaults to uint32_t for backward compatibility, but can be overridden in
- * FreeRTOSConfig.h if uint32_t is too restrictive. */
+ * FreeRTOSConfig.h if uint32_t is too restrictive.  Run time accounting is
+ * intended to be left enabled, so defaults to 64-bit counters that will not
+ * overflow. */
+    #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        #define configRUN_TIME_COUNTER_TYPE    uint64_t
+    #else
+        #define configRUN_TIME_COUNTER_TYPE    uint32_t
+    #endif
+#endif
 
-    #define configRUN_TIME_COUNTER_TYPE    uint32_t
+/* Setting configUSE_CRITICAL_SECTION_HISTOGRAMS to 1 records a log2 histogram
+ * of how long each critical section and each scheduler suspension lasts, per
+ * call site.  See uxTaskGetCriticalSectionHistograms(). */
+#ifndef configUSE_CRITICAL_SECTION_HISTOGRAMS
+    #define configUSE_CRITICAL_SECTION_HISTOGRAMS    0
+#endif
+
+/* The number of call sites the histograms are kept for, including the two
+ * entries that collect sections whose call site is unknown or did not fit. */
+#ifndef configCRITICAL_SECTION_HISTOGRAM_SITES
+    #define configCRITICAL_SECTION_HISTOGRAM_SITES    32
+#endif
+
+/* Bucket n counts the sections that lasted from 2^n to 2^(n+1) - 1 timestamp
+ * units, with the last bucket also counting everything longer. */
+#ifndef configCRITICAL_SECTION_HISTOGRAM_BUCKETS
+    #define configCRITICAL_SECTION_HISTOGRAM_BUCKETS    24
+#endif
+
+/* Returns the address a port function was called from, used to identify the
+ * call site of a critical section.  NULL if the port cannot provide it. */
+#ifndef portGET_CALL_SITE
+    #define portGET_CALL_SITE()    NULL
+#endif
+
+#if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+    #ifndef portCRITICAL_SECTION_TIMESTAMP
+        #ifdef portGET_RUN_TIME_COUNTER_VALUE
+            #define portCRITICAL_SECTION_TIMESTAMP()    ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+        #else
+            #error configUSE_CRITICAL_SECTION_HISTOGRAMS requires portCRITICAL_SECTION_TIMESTAMP() or portGET_RUN_TIME_COUNTER_VALUE() to be defined
+        #endif
+    #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error configUSE_CRITICAL_SECTION_HISTOGRAMS is not supported when configNUMBER_OF_CORES is greater than 1
+    #endif
+
+    #if ( configCRITICAL_SECTION_HISTOGRAM_SITES < 3 )
+        #error configCRITICAL_SECTION_HISTOGRAM_SITES must be at least 3
+    #endif
+
+    #if ( ( configCRITICAL_SECTION_HISTOGRAM_BUCKETS < 1 ) || ( configCRITICAL_SECTION_HISTOGRAM_BUCKETS > 32 ) )
+        #error configCRITICAL_SECTION_HISTOGRAM_BUCKETS must be between 1 and 32
+    #endif
 #endif
 
 #ifndef configMESSAGE_BUFFER_LENGTH_TYPE
@@ -1003,10 +1343,176 @@
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+/* Setting configUSE_PRIORITY_INHERITANCE_CHAINS to 1 makes priority inheritance
+ * transitive.  Each task keeps a list of the mutexes it holds, a priority
+ * inherited through a mutex is passed on to the holder of any mutex the
+ * inheriting task is itself blocked on, and a task's priority is recalculated
+ * from the mutexes it still holds each time it gives one back, rather than
+ * only once it holds no mutexes at all. */
+#ifndef configUSE_PRIORITY_INHERITANCE_CHAINS
+    #define configUSE_PRIORITY_INHERITANCE_CHAINS    0
+#endif
+
+#if ( ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use configUSE_PRIORITY_INHERITANCE_CHAINS
+#endif
+
+/* Setting configUSE_MUTEX_PRIORITY_CEILING to 1 adds mutexes that use the
+ * immediate priority ceiling protocol instead of priority inheritance.  A task
+ * that takes such a mutex is raised straight away to the mutex's ceiling
+ * priority.  See xSemaphoreCreateMutexWithCeiling(). */
+#ifndef configUSE_MUTEX_PRIORITY_CEILING
+    #define configUSE_MUTEX_PRIORITY_CEILING    0
+#endif
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use configUSE_MUTEX_PRIORITY_CEILING
+#endif
+
+/* Setting configUSE_DEFERRED_WORK to 1 creates configDEFERRED_WORK_LANES worker
+ * tasks when the scheduler starts.  Interrupts hand work to them with
+ * xDeferredWorkSubmitFromISR() rather than each having a handler task of its
+ * own.  See deferred_work.h. */
+#ifndef configUSE_DEFERRED_WORK
+    #define configUSE_DEFERRED_WORK    0
+#endif
+
+#ifndef configDEFERRED_WORK_LANES
+    #define configDEFERRED_WORK_LANES    1
+#endif
+
+#if ( configDEFERRED_WORK_LANES < 1 )
+    #error configDEFERRED_WORK_LANES must be at least 1
+#endif
+
+/* An initialiser list holding the priority of each lane's worker task. */
+#ifndef configDEFERRED_WORK_LANE_PRIORITIES
+    #if ( ( configUSE_DEFERRED_WORK == 1 ) && ( configDEFERRED_WORK_LANES != 1 ) )
+        #error Define configDEFERRED_WORK_LANE_PRIORITIES to one priority per lane in FreeRTOSConfig.h, for example { configMAX_PRIORITIES - 1, 1 }
+    #endif
+    #define configDEFERRED_WORK_LANE_PRIORITIES    { configMAX_PRIORITIES - 1 }
+#endif
+
+#ifndef configDEFERRED_WORK_STACK_DEPTH
+    #define configDEFERRED_WORK_STACK_DEPTH    configMINIMAL_STACK_SIZE
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
     #define configINITIAL_TICK_COUNT    0
 #endif
 
+#ifndef configUSE_DELAYED_TASK_WHEEL
+    #define configUSE_DELAYED_TASK_WHEEL    0
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SLOT_BITS
+    #define configDELAYED_TASK_WHEEL_SLOT_BITS    5
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_LEVELS
+    #define configDELAYED_TASK_WHEEL_LEVELS    4
+#endif
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+    #if ( ( configDELAYED_TASK_WHEEL_SLOT_BITS < 1 ) || ( configDELAYED_TASK_WHEEL_SLOT_BITS > 5 ) )
+        #error configDELAYED_TASK_WHEEL_SLOT_BITS must be between 1 and 5
+    #endif
+
+    #if ( configDELAYED_TASK_WHEEL_LEVELS < 1 )
+        #error configDELAYED_TASK_WHEEL_LEVELS must be at least 1
+    #endif
+
+    #if ( ( configDELAYED_TASK_WHEEL_LEVELS * configDELAYED_TASK_WHEEL_SLOT_BITS ) > 32 )
+        #error The delayed task wheel cannot span more than 32 bits of tick count
+    #endif
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
+/* Setting configUSE_TIMER_WHEEL to 1 holds active software timers in a
+ * hierarchical timing wheel of configTIMER_WHEEL_LEVELS levels of
+ * 2^configTIMER_WHEEL_SLOT_BITS slots each, rather than in a sorted list, so
+ * starting, resetting and stopping a timer take constant time. */
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+    #define configTIMER_WHEEL_SLOT_BITS    5
+#endif
+
+#ifndef configTIMER_WHEEL_LEVELS
+    #define configTIMER_WHEEL_LEVELS    4
+#endif
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+    #if ( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 5 ) )
+        #error configTIMER_WHEEL_SLOT_BITS must be between 1 and 5
+    #endif
+
+    #if ( configTIMER_WHEEL_LEVELS < 1 )
+        #error configTIMER_WHEEL_LEVELS must be at least 1
+    #endif
+
+    #if ( ( configTIMER_WHEEL_LEVELS * configTIMER_WHEEL_SLOT_BITS ) > 32 )
+        #error The timer wheel cannot span more than 32 bits of tick count
+    #endif
+#endif /* configUSE_TIMER_WHEEL */
+
+/* The timer service task receives up to configTIMER_COMMAND_BATCH_SIZE
+ * commands from the timer command queue in a single queue operation. */
+#ifndef configTIMER_COMMAND_BATCH_SIZE
+    #define configTIMER_COMMAND_BATCH_SIZE    1
+#endif
+
+#if ( configTIMER_COMMAND_BATCH_SIZE < 1 )
+    #error configTIMER_COMMAND_BATCH_SIZE must be at least 1
+#endif
+
+/* Setting configUSE_TIMER_DIRECT_COMMANDS to 1 lets timer callbacks, and
+ * functions pended to the timer service task, start, reset, stop and change the
+ * period of timers without going through the timer command queue. */
+#ifndef configUSE_TIMER_DIRECT_COMMANDS
+    #define configUSE_TIMER_DIRECT_COMMANDS    0
+#endif
+
+#if ( ( configUSE_TIMER_DIRECT_COMMANDS == 1 ) && ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_TIMER_DIRECT_COMMANDS needs xTaskGetCurrentTaskHandle().  Set INCLUDE_xTaskGetCurrentTaskHandle to 1 in FreeRTOSConfig.h.
+#endif
+
+/* Setting configUSE_64_BIT_EVENT_GROUPS to 1 places the event group control
+ * bits at the top of a 64-bit EventBits_t, giving 56 usable event bits rather
+ * than 24.  EventBits_t is a TickType_t, so this can only be used on ports
+ * where TickType_t is 64 bits wide, such as the Posix and ARM_CA53_64_BIT
+ * ports. */
+#ifndef configUSE_64_BIT_EVENT_GROUPS
+    #define configUSE_64_BIT_EVENT_GROUPS    0
+#endif
+
+#if ( ( configUSE_64_BIT_EVENT_GROUPS == 1 ) && ( configUSE_16_BIT_TICKS == 1 ) )
+    #error configUSE_64_BIT_EVENT_GROUPS cannot be used with configUSE_16_BIT_TICKS
+#endif
+
+/* Tasks that wait for one of the lowest configEVENT_GROUP_INDEXED_BITS bits
+ * of an event group, or for all of a set of bits that includes one of them, are
+ * held in a list per bit, so setting bits only visits the tasks that could be
+ * unblocked by them.  Each indexed bit adds a list to every event group. */
+#ifndef configEVENT_GROUP_INDEXED_BITS
+    #define configEVENT_GROUP_INDEXED_BITS    0
+#endif
+
+#if ( configUSE_16_BIT_TICKS == 1 )
+    #if ( configEVENT_GROUP_INDEXED_BITS > 8 )
+        #error configEVENT_GROUP_INDEXED_BITS cannot be more than the 8 usable bits of an event group
+    #endif
+#elif ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+    #if ( configEVENT_GROUP_INDEXED_BITS > 56 )
+        #error configEVENT_GROUP_INDEXED_BITS cannot be more than the 56 usable bits of an event group
+    #endif
+#else
+    #if ( configEVENT_GROUP_INDEXED_BITS > 24 )
+        #error configEVENT_GROUP_INDEXED_BITS cannot be more than the 24 usable bits of an event group
+    #endif
+#endif
+
 #if ( portTICK_TYPE_IS_ATOMIC == 0 )
 
 /* Either variables of tick type cannot be read atomically, or
@@ -1301,6 +1807,20 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xDummy23;
+        UBaseType_t uxDummy24;
+    #endif
+    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+        UBaseType_t uxDummy25;
+    #endif
+    #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        UBaseType_t uxDummy26;
+    #endif
+    #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+        StaticList_t xDummy27;
+        void * pvDummy28;
+    #endif
 } StaticTask_t;
 
 /*
@@ -1343,6 +1863,18 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucDummy10;
+    #endif
+
+    #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+        StaticListItem_t xDummy11;
+    #endif
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxDummy12;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1372,6 +1904,10 @@ typedef struct xSTATIC_EVENT_GROUP
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
+
+    #if ( configEVENT_GROUP_INDEXED_BITS > 0 )
+        StaticList_t xDummy5[ configEVENT_GROUP_INDEXED_BITS ];
+    #endif
 } StaticEventGroup_t;
 
 /*
@@ -1431,6 +1967,23 @@ typedef struct xSTATIC_STREAM_BUFFER
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the deferred work item structure used internally by
+ * FreeRTOS is not accessible to application code.  The StaticDeferredWork_t
+ * structure below has the same size and alignment requirements as the genuine
+ * structure, so the application writer can statically allocate the memory for
+ * a work item.  Its contents are obfuscated to discourage direct use.
+ */
+typedef struct xSTATIC_DEFERRED_WORK
+{
+    void * pvDummy1;
+    uint32_t ulDummy2;
+    TaskFunction_t pvDummy3;
+    void * pvDummy4;
+    UBaseType_t uxDummy5;
+} StaticDeferredWork_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
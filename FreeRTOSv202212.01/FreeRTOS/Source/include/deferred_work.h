@@ -0,0 +1,228 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef DEFERRED_WORK_H
+#define DEFERRED_WORK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include deferred_work.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Deferred work moves the processing of an interrupt out of the interrupt and
+ * into a task, without the interrupt needing a task of its own.  When
+ * configUSE_DEFERRED_WORK is 1 the scheduler starts configDEFERRED_WORK_LANES
+ * worker tasks, one per lane, at the priorities listed in
+ * configDEFERRED_WORK_LANE_PRIORITIES.  A work item names a function and the
+ * lane on which it runs.  Submitting the item queues it on its lane, and the
+ * lane's worker task calls the function.  Items on a lane run one at a time,
+ * in the order they were submitted, so work that must not be delayed by other
+ * work is placed on a higher priority lane.
+ *
+ * Submitting an item that is already queued does not queue it again.  Each
+ * submission passes a non-zero set of event bits, and the bits from all the
+ * submissions made while the item was queued are ORed together and passed to
+ * the function when it runs.
+ *
+ * Submission is lock free.  It uses the GCC __atomic builtins unless the dw*
+ * atomic macros are defined in FreeRTOSConfig.h.
+ */
+
+/**
+ * deferred_work.h
+ *
+ * Type by which deferred work items are referenced.
+ */
+struct DeferredWorkDefinition;
+typedef struct DeferredWorkDefinition * DeferredWorkHandle_t;
+
+/**
+ * Defines the prototype to which deferred work functions must conform.
+ * ulEvents is the OR of the event bits passed to every submission made since
+ * the function last ran, so is never 0.  The function runs in a worker task
+ * shared with the other items on the same lane, so must not block, and must
+ * not use the worker task's notification at index 0.
+ */
+typedef void (* DeferredWorkFunction_t)( void * pvParameter,
+                                         uint32_t ulEvents );
+
+/**
+ * deferred_work.h
+ * @code{c}
+ * DeferredWorkHandle_t xDeferredWorkCreate( DeferredWorkFunction_t pxFunction,
+ *                                           void * pvParameter,
+ *                                           UBaseType_t uxLane );
+ * @endcode
+ *
+ * Creates a deferred work item using dynamically allocated memory.  Work items
+ * cannot be deleted, as an interrupt could submit the item at any time.
+ *
+ * @param pxFunction The function called by the lane's worker task each time
+ * the item is processed.
+ *
+ * @param pvParameter Passed into pxFunction each time it is called.
+ *
+ * @param uxLane The lane on which the item runs, from 0 to
+ * configDEFERRED_WORK_LANES - 1.
+ *
+ * @return A handle to the work item, or NULL if there was insufficient heap
+ * memory to create it.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    DeferredWorkHandle_t xDeferredWorkCreate( DeferredWorkFunction_t pxFunction,
+                                              void * pvParameter,
+                                              UBaseType_t uxLane ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * deferred_work.h
+ * @code{c}
+ * DeferredWorkHandle_t xDeferredWorkCreateStatic( DeferredWorkFunction_t pxFunction,
+ *                                                 void * pvParameter,
+ *                                                 UBaseType_t uxLane,
+ *                                                 StaticDeferredWork_t * pxWorkBuffer );
+ * @endcode
+ *
+ * As xDeferredWorkCreate(), but the work item is placed in pxWorkBuffer, which
+ * must persist for as long as the item can be submitted.
+ *
+ * @return A handle to the work item, or NULL if pxWorkBuffer was NULL.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    DeferredWorkHandle_t xDeferredWorkCreateStatic( DeferredWorkFunction_t pxFunction,
+                                                    void * pvParameter,
+                                                    UBaseType_t uxLane,
+                                                    StaticDeferredWork_t * pxWorkBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * deferred_work.h
+ * @code{c}
+ * BaseType_t xDeferredWorkSubmitFromISR( DeferredWorkHandle_t xWork,
+ *                                        uint32_t ulEvents,
+ *                                        BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Queues xWork on its lane, or adds ulEvents to the pending events of xWork if
+ * it is already queued.  Can be called from an interrupt.
+ *
+ * @param xWork The work item to submit.
+ *
+ * @param ulEvents Event bits ORed into the value passed to the work function.
+ * Must not be 0.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if waking the lane's worker
+ * task means a context switch should be requested before the interrupt exits.
+ *
+ * @return pdTRUE if xWork was queued, or pdFALSE if it was already queued and
+ * ulEvents were merged into its pending events.
+ *
+ * Example usage:
+ * @code{c}
+ * static DeferredWorkHandle_t xRxWork;
+ *
+ * void vUARTInterruptHandler( void )
+ * {
+ *  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *     vClearUARTInterrupt();
+ *     xDeferredWorkSubmitFromISR( xRxWork, UART_RX_EVENT, &xHigherPriorityTaskWoken );
+ *     portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ */
+BaseType_t xDeferredWorkSubmitFromISR( DeferredWorkHandle_t xWork,
+                                       uint32_t ulEvents,
+                                       BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * deferred_work.h
+ * @code{c}
+ * BaseType_t xDeferredWorkSubmit( DeferredWorkHandle_t xWork, uint32_t ulEvents );
+ * @endcode
+ *
+ * The version of xDeferredWorkSubmitFromISR() that is called from a task.  If
+ * the lane's worker task has a higher priority than the calling task it runs
+ * before this function returns.
+ */
+BaseType_t xDeferredWorkSubmit( DeferredWorkHandle_t xWork,
+                                uint32_t ulEvents ) PRIVILEGED_FUNCTION;
+
+/**
+ * deferred_work.h
+ * @code{c}
+ * TaskHandle_t xDeferredWorkGetLaneTaskHandle( UBaseType_t uxLane );
+ * @endcode
+ *
+ * Returns the handle of the worker task that runs the items on uxLane, for
+ * example to check its stack high water mark.  Returns NULL if called before
+ * the scheduler has been started.
+ */
+TaskHandle_t xDeferredWorkGetLaneTaskHandle( UBaseType_t uxLane ) PRIVILEGED_FUNCTION;
+
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
+
+/**
+ * deferred_work.h
+ * @code{c}
+ * void vApplicationGetDeferredWorkLaneMemory( UBaseType_t uxLane, StaticTask_t ** ppxLaneTaskTCBBuffer, StackType_t ** ppxLaneTaskStackBuffer, uint32_t * pulLaneTaskStackSize )
+ * @endcode
+ *
+ * Provides the statically allocated TCB and stack for the worker task of
+ * uxLane.  Only required when configUSE_DEFERRED_WORK is 1 and dynamic
+ * allocation is not supported.
+ */
+    void vApplicationGetDeferredWorkLaneMemory( UBaseType_t uxLane,
+                                                StaticTask_t ** ppxLaneTaskTCBBuffer,
+                                                StackType_t ** ppxLaneTaskStackBuffer,
+                                                uint32_t * pulLaneTaskStackSize );
+
+#endif
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the kernel only.
+ */
+BaseType_t xDeferredWorkCreateLanes( void ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* DEFERRED_WORK_H */
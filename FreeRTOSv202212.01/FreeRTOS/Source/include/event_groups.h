@@ -85,7 +85,7 @@ typedef struct EventGroupDef_t   * EventGroupHandle_t;
 /*
  * The type that holds event bits always matches TickType_t - therefore the
  * number of bits it holds is set by configUSE_16_BIT_TICKS (16 bits if set to 1,
- * 32 bits if set to 0.
+ * 32 bits if set to 0), or is 64 bits on ports with a 64-bit TickType_t.
  *
  * \defgroup EventBits_t EventBits_t
  * \ingroup EventGroup
@@ -115,8 +115,9 @@ typedef TickType_t               EventBits_t;
  * on the configUSE_16_BIT_TICKS setting in FreeRTOSConfig.h.  If
  * configUSE_16_BIT_TICKS is 1 then each event group contains 8 usable bits (bit
  * 0 to bit 7).  If configUSE_16_BIT_TICKS is set to 0 then each event group has
- * 24 usable bits (bit 0 to bit 23).  The EventBits_t type is used to store
- * event bits within an event group.
+ * 24 usable bits (bit 0 to bit 23), or 56 usable bits (bit 0 to bit 55) if
+ * configUSE_64_BIT_EVENT_GROUPS is set to 1 on a port with a 64-bit TickType_t.
+ * The EventBits_t type is used to store event bits within an event group.
  *
  * @return If the event group was created then a handle to the event group is
  * returned.  If there was insufficient FreeRTOS heap available to create the
@@ -171,8 +172,9 @@ typedef TickType_t               EventBits_t;
  * on the configUSE_16_BIT_TICKS setting in FreeRTOSConfig.h.  If
  * configUSE_16_BIT_TICKS is 1 then each event group contains 8 usable bits (bit
  * 0 to bit 7).  If configUSE_16_BIT_TICKS is set to 0 then each event group has
- * 24 usable bits (bit 0 to bit 23).  The EventBits_t type is used to store
- * event bits within an event group.
+ * 24 usable bits (bit 0 to bit 23), or 56 usable bits (bit 0 to bit 55) if
+ * configUSE_64_BIT_EVENT_GROUPS is set to 1 on a port with a 64-bit TickType_t.
+ * The EventBits_t type is used to store event bits within an event group.
  *
  * @param pxEventGroupBuffer pxEventGroupBuffer must point to a variable of type
  * StaticEventGroup_t, which will be then be used to hold the event group's data
@@ -386,7 +388,9 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  *
  * @param uxBitsToClear A bitwise value that indicates the bit or bits to clear.
  * For example, to clear bit 3 only, set uxBitsToClear to 0x08.  To clear bit 3
- * and bit 0 set uxBitsToClear to 0x09.
+ * and bit 0 set uxBitsToClear to 0x09.  The bits are passed to the timer task
+ * as a 32-bit value, so only bits 0 to 31 can be cleared when
+ * configUSE_64_BIT_EVENT_GROUPS is 1.
  *
  * @return If the request to execute the function was posted successfully then
  * pdPASS is returned, otherwise pdFALSE is returned.  pdFALSE will be returned
@@ -521,7 +525,9 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
  * For example, to set bit 3 only, set uxBitsToSet to 0x08.  To set bit 3
- * and bit 0 set uxBitsToSet to 0x09.
+ * and bit 0 set uxBitsToSet to 0x09.  The bits are passed to the timer task
+ * as a 32-bit value, so only bits 0 to 31 can be set when
+ * configUSE_64_BIT_EVENT_GROUPS is 1.
  *
  * @param pxHigherPriorityTaskWoken As mentioned above, calling this function
  * will result in a message being sent to the timer daemon task.  If the
@@ -641,6 +641,239 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveFromISR( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendMultiple( MessageBufferHandle_t xMessageBuffer,
+ *                                    const void * const * ppvTxMessages,
+ *                                    const size_t * pxMessageLengths,
+ *                                    size_t xMessageCount,
+ *                                    TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Sends up to xMessageCount discrete messages to the message buffer in one
+ * call.  Message i is pxMessageLengths[ i ] bytes long and is copied from
+ * ppvTxMessages[ i ].  The messages are written in order, and as many as fit
+ * in the free space are written before the message buffer is updated, so the
+ * receiving task sees them all at once and is notified at most once - rather
+ * than once per message as when xMessageBufferSend() is called in a loop.
+ *
+ * Each message uses the same space in the message buffer as it would if it
+ * were sent using xMessageBufferSend(), and the same single writer
+ * restrictions apply.
+ *
+ * @param xMessageBuffer The handle of the message buffer to which the messages
+ * are being sent.
+ *
+ * @param ppvTxMessages An array of xMessageCount pointers to the messages to
+ * be copied into the message buffer.
+ *
+ * @param pxMessageLengths An array of xMessageCount message lengths, in bytes.
+ * Sending stops at the first zero length message.
+ *
+ * @param xMessageCount The number of messages in the ppvTxMessages and
+ * pxMessageLengths arrays.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should remain
+ * in the Blocked state to wait for enough space to become available in the
+ * message buffer for the first message.  The call does not wait for space for
+ * the remaining messages.
+ *
+ * @return The number of messages written to the message buffer, which will be
+ * less than xMessageCount if the buffer did not have space for all of them.
+ *
+ * \defgroup xMessageBufferSendMultiple xMessageBufferSendMultiple
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendMultiple( xMessageBuffer, ppvTxMessages, pxMessageLengths, xMessageCount, xTicksToWait ) \
+    xStreamBufferSendMessages( ( xMessageBuffer ), ( ppvTxMessages ), ( pxMessageLengths ), ( xMessageCount ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendMultipleFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                           const void * const * ppvTxMessages,
+ *                                           const size_t * pxMessageLengths,
+ *                                           size_t xMessageCount,
+ *                                           BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xMessageBufferSendMultiple().  Never blocks.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if sending the messages unblocked
+ * a task that has a priority above the currently running task.
+ *
+ * \defgroup xMessageBufferSendMultipleFromISR xMessageBufferSendMultipleFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendMultipleFromISR( xMessageBuffer, ppvTxMessages, pxMessageLengths, xMessageCount, pxHigherPriorityTaskWoken ) \
+    xStreamBufferSendMessagesFromISR( ( xMessageBuffer ), ( ppvTxMessages ), ( pxMessageLengths ), ( xMessageCount ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveMultiple( MessageBufferHandle_t xMessageBuffer,
+ *                                       void * pvRxData,
+ *                                       size_t xBufferLengthBytes,
+ *                                       size_t * pxMessageLengths,
+ *                                       size_t xMaxMessages,
+ *                                       TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives up to xMaxMessages discrete messages from the message buffer in one
+ * call.  The messages are copied one after another into pvRxData, and the
+ * length of each is written to the corresponding element of
+ * pxMessageLengths.  Reception stops when the next message would not fit in
+ * the remaining space in pvRxData.  The space freed by all the messages is
+ * released together, so a task waiting to send is notified at most once.
+ *
+ * @param xMessageBuffer The handle of the message buffer from which the
+ * messages are being received.
+ *
+ * @param pvRxData A pointer to the buffer into which the received messages are
+ * copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by pvRxData.
+ *
+ * @param pxMessageLengths An array of at least xMaxMessages elements that
+ * receives the length of each message received.
+ *
+ * @param xMaxMessages The maximum number of messages to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should remain
+ * in the Blocked state to wait for a message, should the message buffer be
+ * empty.
+ *
+ * @return The number of messages received.  Zero is returned if the call timed
+ * out or if the first message is longer than xBufferLengthBytes, in which case
+ * the message is left in the message buffer.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( MessageBufferHandle_t xMessageBuffer )
+ * {
+ * uint8_t ucRxData[ 128 ], *pucMessage = ucRxData;
+ * size_t xLengths[ 8 ], xReceived, x;
+ *
+ *  // Receive up to 8 messages, waiting at most 100ms for the first.
+ *  xReceived = xMessageBufferReceiveMultiple( xMessageBuffer,
+ *                                             ucRxData,
+ *                                             sizeof( ucRxData ),
+ *                                             xLengths,
+ *                                             8,
+ *                                             pdMS_TO_TICKS( 100 ) );
+ *
+ *  for( x = 0; x < xReceived; x++ )
+ *  {
+ *      // Message x is xLengths[ x ] bytes starting at pucMessage.
+ *      pucMessage += xLengths[ x ];
+ *  }
+ * }
+ * @endcode
+ * \defgroup xMessageBufferReceiveMultiple xMessageBufferReceiveMultiple
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveMultiple( xMessageBuffer, pvRxData, xBufferLengthBytes, pxMessageLengths, xMaxMessages, xTicksToWait ) \
+    xStreamBufferReceiveMessages( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxMessageLengths ), ( xMaxMessages ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveMultipleFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                              void * pvRxData,
+ *                                              size_t xBufferLengthBytes,
+ *                                              size_t * pxMessageLengths,
+ *                                              size_t xMaxMessages,
+ *                                              BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xMessageBufferReceiveMultiple().  Never blocks.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if receiving the messages
+ * unblocked a task that has a priority above the currently running task.
+ *
+ * \defgroup xMessageBufferReceiveMultipleFromISR xMessageBufferReceiveMultipleFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveMultipleFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxMessageLengths, xMaxMessages, pxHigherPriorityTaskWoken ) \
+    xStreamBufferReceiveMessagesFromISR( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxMessageLengths ), ( xMaxMessages ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendReserve( MessageBufferHandle_t xMessageBuffer,
+ *                                   StreamBufferSpans_t * const pxSpans,
+ *                                   TickType_t xTicksToWait );
+ * size_t xMessageBufferSendReserveFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                          StreamBufferSpans_t * const pxSpans );
+ * size_t xMessageBufferSendCommit( MessageBufferHandle_t xMessageBuffer,
+ *                                  size_t xMessageLength );
+ * size_t xMessageBufferSendCommitFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                         size_t xMessageLength,
+ *                                         BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Writes a message in place.  xMessageBufferSendReserve() describes, as up to
+ * two contiguous spans, the space available for the body of the next message,
+ * and returns its size in bytes.  The message is written into the spans - span
+ * 0 first - then sent by xMessageBufferSendCommit(), which adds the message's
+ * length in front of it.  Committing a length of zero sends nothing.
+ *
+ * This avoids copying messages that are produced in place, for example by a
+ * DMA controller, or by another core in the AMP pattern where the message
+ * buffer's storage area is in shared memory.  See xStreamBufferSendReserve()
+ * and xStreamBufferSendCommit() for details.
+ *
+ * \defgroup xMessageBufferSendReserve xMessageBufferSendReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendReserve( xMessageBuffer, pxSpans, xTicksToWait ) \
+    xStreamBufferSendReserve( ( xMessageBuffer ), ( pxSpans ), ( xTicksToWait ) )
+#define xMessageBufferSendReserveFromISR( xMessageBuffer, pxSpans ) \
+    xStreamBufferSendReserveFromISR( ( xMessageBuffer ), ( pxSpans ) )
+#define xMessageBufferSendCommit( xMessageBuffer, xMessageLength ) \
+    xStreamBufferSendCommit( ( xMessageBuffer ), ( xMessageLength ) )
+#define xMessageBufferSendCommitFromISR( xMessageBuffer, xMessageLength, pxHigherPriorityTaskWoken ) \
+    xStreamBufferSendCommitFromISR( ( xMessageBuffer ), ( xMessageLength ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveAcquire( MessageBufferHandle_t xMessageBuffer,
+ *                                      StreamBufferSpans_t * const pxSpans,
+ *                                      TickType_t xTicksToWait );
+ * size_t xMessageBufferReceiveAcquireFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                             StreamBufferSpans_t * const pxSpans );
+ * size_t xMessageBufferReceiveRelease( MessageBufferHandle_t xMessageBuffer,
+ *                                      size_t xMessageLength );
+ * size_t xMessageBufferReceiveReleaseFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                             size_t xMessageLength,
+ *                                             BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Reads a message in place.  xMessageBufferReceiveAcquire() describes the
+ * body of the next message as up to two contiguous spans, and returns its
+ * length, or zero if the message buffer is empty.  The message stays in the
+ * message buffer until xMessageBufferReceiveRelease() is called with the
+ * message's length.  See xStreamBufferReceiveAcquire() and
+ * xStreamBufferReceiveRelease() for details.
+ *
+ * \defgroup xMessageBufferReceiveAcquire xMessageBufferReceiveAcquire
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveAcquire( xMessageBuffer, pxSpans, xTicksToWait ) \
+    xStreamBufferReceiveAcquire( ( xMessageBuffer ), ( pxSpans ), ( xTicksToWait ) )
+#define xMessageBufferReceiveAcquireFromISR( xMessageBuffer, pxSpans ) \
+    xStreamBufferReceiveAcquireFromISR( ( xMessageBuffer ), ( pxSpans ) )
+#define xMessageBufferReceiveRelease( xMessageBuffer, xMessageLength ) \
+    xStreamBufferReceiveRelease( ( xMessageBuffer ), ( xMessageLength ) )
+#define xMessageBufferReceiveReleaseFromISR( xMessageBuffer, xMessageLength, pxHigherPriorityTaskWoken ) \
+    xStreamBufferReceiveReleaseFromISR( ( xMessageBuffer ), ( xMessageLength ), ( pxHigherPriorityTaskWoken ) )
+
 /**
  * message_buffer.h
  *
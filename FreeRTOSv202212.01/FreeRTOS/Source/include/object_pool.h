@@ -0,0 +1,261 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/**
+ * @file object_pool.h
+ * @brief Fixed size object pools used by the kernel's create functions.
+ *
+ * A pool is an array of equally sized slots and a bitmap that records which
+ * slots are in use.  Slots are claimed with a compare-and-swap on the bitmap
+ * and released by clearing their bit, so the pool can be used from any context
+ * without suspending the scheduler.  Unlike a linked free list a bitmap cannot
+ * suffer from the ABA problem, which matters because atomic.h only provides a
+ * single word compare-and-swap.
+ *
+ * The pools are internal to the kernel - see the configXXX_POOL_LENGTH
+ * constants in FreeRTOS.h.  This header is only included by the kernel source
+ * files that define a pool.
+ */
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include object_pool.h"
+#endif
+
+#ifndef INC_TASK_H
+    #error "include task.h must appear in source files before include object_pool.h"
+#endif
+
+#include "atomic.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Each slot is rounded up to a multiple of portBYTE_ALIGNMENT so every object
+ * handed out is aligned as if it came from pvPortMalloc().  The storage array
+ * has portBYTE_ALIGNMENT bytes of slack so the first slot can be aligned. */
+#define poolSLOT_SIZE( xObjectSize )                 ( ( ( size_t ) ( xObjectSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+#define poolSTORAGE_SIZE( uxLength, xObjectSize )    ( ( ( size_t ) ( uxLength ) * poolSLOT_SIZE( xObjectSize ) ) + ( size_t ) portBYTE_ALIGNMENT )
+#define poolBITMAP_WORDS( uxLength )                 ( ( ( uxLength ) + 31U ) / 32U )
+
+/* A pool.  pucStorage must point to poolSTORAGE_SIZE( uxLength, xSlotSize )
+ * bytes, pulSlotsInUse to poolBITMAP_WORDS( uxLength ) zero initialised
+ * words, and xSlotSize must already be rounded with poolSLOT_SIZE(). */
+typedef struct xOBJECT_POOL
+{
+    uint8_t * pucStorage;
+    size_t xSlotSize;
+    UBaseType_t uxLength;
+    uint32_t volatile * pulSlotsInUse;
+} ObjectPool_t;
+
+/* The first correctly aligned slot in the pool's storage. */
+#define poolFIRST_SLOT( pxPool )    ( ( uint8_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxPool )->pucStorage + ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) )
+
+/* atomic.h only masks interrupts on the calling core, so where there is more
+ * than one core the bitmap is updated inside a kernel critical section
+ * instead, which also takes the inter-core ISR lock. */
+#if ( configNUMBER_OF_CORES == 1 )
+    #define poolCOMPARE_AND_SWAP( pulDestination, ulExchange, ulComparand )    Atomic_CompareAndSwap_u32( ( pulDestination ), ( ulExchange ), ( ulComparand ) )
+    #define poolCLEAR_BITS( pulDestination, ulBits )                           ( void ) Atomic_AND_u32( ( pulDestination ), ~( ulBits ) )
+#else
+    #define poolCOMPARE_AND_SWAP( pulDestination, ulExchange, ulComparand )    prvObjectPoolCompareAndSwap( ( pulDestination ), ( ulExchange ), ( ulComparand ) )
+    #define poolCLEAR_BITS( pulDestination, ulBits )                           prvObjectPoolClearBits( ( pulDestination ), ( ulBits ) )
+#endif
+
+#if defined( __GNUC__ ) && defined( __SIZEOF_INT__ ) && ( __SIZEOF_INT__ == 4 )
+    #define poolLOWEST_SET_BIT( ulBitmap )    ( ( UBaseType_t ) __builtin_ctz( ( unsigned int ) ( ulBitmap ) ) )
+#else
+    #define poolLOWEST_SET_BIT( ulBitmap )    prvObjectPoolLowestSetBit( ulBitmap )
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static portFORCE_INLINE uint32_t prvObjectPoolCompareAndSwap( uint32_t volatile * pulDestination,
+                                                                  uint32_t ulExchange,
+                                                                  uint32_t ulComparand )
+    {
+        uint32_t ulReturn = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( *pulDestination == ulComparand )
+            {
+                *pulDestination = ulExchange;
+                ulReturn = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return ulReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static portFORCE_INLINE void prvObjectPoolClearBits( uint32_t volatile * pulDestination,
+                                                         uint32_t ulBits )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            *pulDestination &= ~ulBits;
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configNUMBER_OF_CORES > 1 */
+
+#if !( defined( __GNUC__ ) && defined( __SIZEOF_INT__ ) && ( __SIZEOF_INT__ == 4 ) )
+
+    static portFORCE_INLINE UBaseType_t prvObjectPoolLowestSetBit( uint32_t ulBitmap )
+    {
+        UBaseType_t uxBit = 0;
+
+        while( ( ulBitmap & 1UL ) == 0UL )
+        {
+            ulBitmap >>= 1;
+            uxBit++;
+        }
+
+        return uxBit;
+    }
+/*-----------------------------------------------------------*/
+
+#endif
+
+/**
+ * @brief Allocates an object from a pool, or from the FreeRTOS heap if the
+ * object does not fit in a slot or the pool has no free slot.
+ *
+ * @param[in] pxPool The pool to allocate from.
+ * @param[in] xWantedSize The size of the object in bytes.
+ *
+ * @return A pointer to the object, or NULL if neither the pool nor the heap
+ * could supply the memory.
+ */
+static portFORCE_INLINE void * pvObjectPoolMalloc( ObjectPool_t * pxPool,
+                                                   size_t xWantedSize )
+{
+    void * pvReturn = NULL;
+    UBaseType_t uxWord, uxSlot;
+    uint32_t ulInUse;
+
+    if( xWantedSize <= pxPool->xSlotSize )
+    {
+        for( uxWord = 0; ( uxWord < poolBITMAP_WORDS( pxPool->uxLength ) ) && ( pvReturn == NULL ); uxWord++ )
+        {
+            ulInUse = pxPool->pulSlotsInUse[ uxWord ];
+
+            /* Try to claim the lowest free slot described by this word, and
+             * try again if another context changed the word first. */
+            while( ( pvReturn == NULL ) && ( ulInUse != 0xFFFFFFFFUL ) )
+            {
+                uxSlot = poolLOWEST_SET_BIT( ~ulInUse );
+
+                if( ( ( uxWord * 32U ) + uxSlot ) >= pxPool->uxLength )
+                {
+                    /* Only the unused bits past the end of the pool are
+                     * clear. */
+                    ulInUse = 0xFFFFFFFFUL;
+                }
+                else if( poolCOMPARE_AND_SWAP( &( pxPool->pulSlotsInUse[ uxWord ] ), ulInUse | ( 1UL << uxSlot ), ulInUse ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                {
+                    pvReturn = ( void * ) ( poolFIRST_SLOT( pxPool ) + ( ( ( uxWord * 32U ) + uxSlot ) * pxPool->xSlotSize ) );
+                }
+                else
+                {
+                    ulInUse = pxPool->pulSlotsInUse[ uxWord ];
+                }
+            }
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pvReturn == NULL )
+    {
+        pvReturn = pvPortMalloc( xWantedSize );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Frees an object allocated by pvObjectPoolMalloc(), returning it to
+ * the pool or to the FreeRTOS heap depending on where it came from.
+ *
+ * @param[in] pxPool The pool the object was allocated from.
+ * @param[in] pv The object.
+ */
+static portFORCE_INLINE void vObjectPoolFree( ObjectPool_t * pxPool,
+                                              void * pv )
+{
+    uint8_t * pucFirstSlot = poolFIRST_SLOT( pxPool );
+    UBaseType_t uxSlot;
+    uint32_t ulBit;
+
+    if( ( ( uint8_t * ) pv >= pucFirstSlot ) && ( ( uint8_t * ) pv < ( pucFirstSlot + ( pxPool->uxLength * pxPool->xSlotSize ) ) ) )
+    {
+        uxSlot = ( UBaseType_t ) ( ( size_t ) ( ( uint8_t * ) pv - pucFirstSlot ) / pxPool->xSlotSize );
+        ulBit = 1UL << ( uxSlot % 32U );
+
+        /* Only the owner of a slot clears its bit, so the slot must still be
+         * marked as in use. */
+        configASSERT( ( pxPool->pulSlotsInUse[ uxSlot / 32U ] & ulBit ) != 0UL );
+        poolCLEAR_BITS( &( pxPool->pulSlotsInUse[ uxSlot / 32U ] ), ulBit );
+    }
+    else
+    {
+        vPortFree( pv );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* OBJECT_POOL_H */
@@ -130,8 +130,8 @@
     #endif
 #endif /* if ( portUSING_MPU_WRAPPERS == 1 ) */
 
-/* Used by heap_5.c to define the start address and size of each memory region
- * that together comprise the total FreeRTOS heap space. */
+/* Used by heap_5.c and heap_6.c to define the start address and size of each
+ * memory region that together comprise the total FreeRTOS heap space. */
 typedef struct HeapRegion
 {
     uint8_t * pucStartAddress;
@@ -151,10 +151,10 @@ typedef struct xHeapStats
 } HeapStats_t;
 
 /*
- * Used to define multiple heap regions for use by heap_5.c.  This function
- * must be called before any calls to pvPortMalloc() - not creating a task,
- * queue, semaphore, mutex, software timer, event group, etc. will result in
- * pvPortMalloc being called.
+ * Used to define multiple heap regions for use by heap_5.c and heap_6.c.  This
+ * function must be called before any calls to pvPortMalloc() - not creating a
+ * task, queue, semaphore, mutex, software timer, event group, etc. will result
+ * in pvPortMalloc being called.
  *
  * pxHeapRegions passes in an array of HeapRegion_t structures - each of which
  * defines a region of memory that can be used as the heap.  The array is
@@ -169,6 +169,31 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
  */
 void vPortGetHeapStats( HeapStats_t * pxHeapStats );
 
+/* Used to pass information about the per task heap caches out of
+ * vPortGetHeapTaskCacheStats(). */
+typedef struct xHeapTaskCacheStats
+{
+    size_t xNumberOfTaskCaches;   /* The number of tasks that currently own a heap cache. */
+    size_t xNumberOfCachedBlocks; /* The number of free blocks held in task caches rather than in the heap at the time vPortGetHeapTaskCacheStats() is called. */
+    size_t xNumberOfCacheHits;    /* The number of calls to pvPortMalloc() that were served from the calling task's cache. */
+    size_t xNumberOfCacheMisses;  /* The number of calls to pvPortMalloc() that found the calling task's cache empty, so refilled it from the heap. */
+} HeapTaskCacheStats_t;
+
+/*
+ * Returns a HeapTaskCacheStats_t structure filled with the statistics of all
+ * the task heap caches, including those of tasks that have since been deleted.
+ * Only provided by heap_4.c when configUSE_HEAP_TASK_CACHE is 1.
+ */
+void vPortGetHeapTaskCacheStats( HeapTaskCacheStats_t * pxCacheStats );
+
+/*
+ * Returns the blocks held in a deleted task's heap cache to the heap.  Called
+ * by the kernel with the task's configHEAP_TASK_CACHE_TLS_INDEX thread local
+ * storage pointer.  Heaps other than heap_4.c never create a cache, so provide
+ * an empty implementation.
+ */
+void vPortReleaseTaskCache( void * pvTaskCache ) PRIVILEGED_FUNCTION;
+
 /*
  * Map to the memory management routines required for the port.
  */
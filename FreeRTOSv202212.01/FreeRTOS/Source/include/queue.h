@@ -512,7 +512,11 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
  * @return xQueueOverwrite() is a macro that calls xQueueGenericSend(), and
  * therefore has the same return values as xQueueSendToFront().  However, pdPASS
  * is the only value that can be returned because xQueueOverwrite() will write
- * to the queue even when the queue is already full.
+ * to the queue even when the queue is already full.  The exception is when
+ * configUSE_QUEUE_ZERO_COPY is 1 and the queue's only slot is lent to a task by
+ * pvQueueAcquireSendSlot() or pvQueueBorrowReceiveSlot().  The slot cannot be
+ * overwritten while the task is using it, so errQUEUE_FULL is returned, without
+ * blocking, until the slot is committed or released.
  *
  * Example usage:
  * @code{c}
@@ -885,6 +889,227 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * void * pvQueueAcquireSendSlot( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Lend the calling task the next free slot in a queue's storage area so an
+ * item can be written directly into the queue instead of being copied into it
+ * by xQueueSend().  The item does not become part of the queue until
+ * vQueueCommitSendSlot() is called, and is then received in the same order as
+ * if it had been sent to the back of the queue.
+ *
+ * Only one send slot can be lent from a queue at a time.  While it is lent
+ * the queue appears full to other tasks and interrupts that send to the back
+ * of the queue, and xQueueOverwrite() and xQueueOverwriteFromISR() return
+ * errQUEUE_FULL.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  The slot is inside the kernel's copy of the
+ * queue, so the function is not available to unprivileged tasks.
+ *
+ * @param xQueue The handle of the queue to which the item is to be sent.  The
+ * queue must not be a semaphore or a queue set.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot to become free, as for xQueueSend().
+ *
+ * @return A pointer to uxItemSize bytes of queue storage if a slot was
+ * acquired, otherwise NULL.
+ *
+ * Example usage:
+ * @code{c}
+ * void vSendFrame( QueueHandle_t xFrameQueue )
+ * {
+ * Frame_t *pxFrame;
+ *
+ *  pxFrame = ( Frame_t * ) pvQueueAcquireSendSlot( xFrameQueue, pdMS_TO_TICKS( 10 ) );
+ *
+ *  if( pxFrame != NULL )
+ *  {
+ *      // Build the frame in place then make it visible to receivers.
+ *      prvFillFrame( pxFrame );
+ *      vQueueCommitSendSlot( xFrameQueue );
+ *  }
+ * }
+ * @endcode
+ * \defgroup pvQueueAcquireSendSlot pvQueueAcquireSendSlot
+ * \ingroup QueueManagement
+ */
+void * pvQueueAcquireSendSlot( QueueHandle_t xQueue,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * void vQueueCommitSendSlot( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Add the item written into the slot returned by pvQueueAcquireSendSlot() to
+ * the back of the queue.  Tasks blocked on the queue, or on a queue set that
+ * contains the queue, are unblocked exactly as if the item had been sent with
+ * xQueueSend().  The slot must not be accessed after it has been committed.
+ *
+ * @param xQueue The handle of the queue from which the slot was acquired.
+ *
+ * \defgroup vQueueCommitSendSlot vQueueCommitSendSlot
+ * \ingroup QueueManagement
+ */
+void vQueueCommitSendSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * void * pvQueueBorrowReceiveSlot( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Remove the item at the front of a queue, as xQueueReceive() does, but lend
+ * the calling task the slot holding the item instead of copying the item into
+ * a buffer.  The slot is not reused until vQueueReleaseReceiveSlot() is called.
+ *
+ * Only one receive slot can be borrowed from a queue at a time.  While it is
+ * borrowed the queue appears empty to other tasks and interrupts that receive
+ * from it, items cannot be sent to the front of the queue, and
+ * xQueueOverwrite() and xQueueOverwriteFromISR() return errQUEUE_FULL.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle of the queue from which the item is to be received.
+ * The queue must not be a semaphore or a queue set.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive, as for xQueueReceive().
+ *
+ * @return A pointer to the received item if one was available, otherwise NULL.
+ *
+ * \defgroup pvQueueBorrowReceiveSlot pvQueueBorrowReceiveSlot
+ * \ingroup QueueManagement
+ */
+void * pvQueueBorrowReceiveSlot( QueueHandle_t xQueue,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * void vQueueReleaseReceiveSlot( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Return the slot lent by pvQueueBorrowReceiveSlot() to the queue so it can be
+ * used by a later send.  The slot must not be accessed after it is released.
+ *
+ * @param xQueue The handle of the queue from which the slot was borrowed.
+ *
+ * \defgroup vQueueReleaseReceiveSlot vQueueReleaseReceiveSlot
+ * \ingroup QueueManagement
+ */
+void vQueueReleaseReceiveSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+ *                                 const void * const pvItems,
+ *                                 UBaseType_t uxItemCount,
+ *                                 TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Send up to uxItemCount items to the back of a queue in one operation.  The
+ * items are copied into the queue inside a single critical section, and at
+ * most one task blocked on the queue is unblocked per item sent - so a single
+ * waiting receiver is only woken once however many items are sent.  Items are
+ * received in the order they appear in pvItems.
+ *
+ * If the queue is full the calling task waits, for at most xTicksToWait
+ * ticks, for space for one item.  As many items as will then fit are sent,
+ * which may be fewer than uxItemCount.
+ *
+ * This function must not be used on a semaphore, or from an interrupt service
+ * routine.  See xQueueSendMultipleFromISR() for an alternative which may be
+ * used in an ISR.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to an array of uxItemCount items, each the size
+ * the queue was created to hold.
+ *
+ * @param uxItemCount The number of items in pvItems.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space on the queue, as for xQueueSend().
+ *
+ * @return The number of items sent, which is 0 if the queue stayed full for
+ * xTicksToWait ticks.
+ *
+ * Example usage:
+ * @code{c}
+ * void vFlushLog( QueueHandle_t xLogQueue, LogRecord_t *pxRecords, UBaseType_t uxCount )
+ * {
+ * UBaseType_t uxSent;
+ *
+ *  while( uxCount > 0 )
+ *  {
+ *      uxSent = xQueueSendMultiple( xLogQueue, pxRecords, uxCount, portMAX_DELAY );
+ *      pxRecords += uxSent;
+ *      uxCount -= uxSent;
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                const void * const pvItems,
+                                UBaseType_t uxItemCount,
+                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+ *                                    void * const pvBuffer,
+ *                                    UBaseType_t uxMaxItems,
+ *                                    TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receive up to uxMaxItems items from a queue in one operation.  The items
+ * are copied out of the queue inside a single critical section, and at most
+ * one task blocked waiting to send to the queue is unblocked per item
+ * received.
+ *
+ * If the queue is empty the calling task waits, for at most xTicksToWait
+ * ticks, for an item to arrive.  All the items then in the queue are
+ * received, up to a maximum of uxMaxItems.
+ *
+ * This function must not be used on a semaphore, or from an interrupt service
+ * routine.  See xQueueReceiveMultipleFromISR() for an alternative which may be
+ * used in an ISR.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items are
+ * copied, one after another.  It must be large enough to hold uxMaxItems
+ * items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive, as for xQueueReceive().
+ *
+ * @return The number of items received, which is 0 if the queue stayed empty
+ * for xTicksToWait ticks.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                   void * const pvBuffer,
+                                   UBaseType_t uxMaxItems,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * @code{c}
@@ -1116,7 +1341,9 @@ void vQueueDelete( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
  * xQueueGenericSendFromISR(), and therefore has the same return values as
  * xQueueSendToFrontFromISR().  However, pdPASS is the only value that can be
  * returned because xQueueOverwriteFromISR() will write to the queue even when
- * the queue is already full.
+ * the queue is already full.  As for xQueueOverwrite(), errQUEUE_FULL is
+ * returned instead while the queue's only slot is lent to a task by the zero
+ * copy API.
  *
  * Example usage:
  * @code{c}
@@ -1418,6 +1645,75 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+ *                                        const void * const pvItems,
+ *                                        UBaseType_t uxItemCount,
+ *                                        BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xQueueSendMultiple() that can be called from an interrupt
+ * service routine.  It sends as many of the items as there is space for
+ * without blocking.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to an array of uxItemCount items.
+ *
+ * @param uxItemCount The number of items in pvItems.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the items
+ * unblocked a task with a priority higher than the currently running task,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return The number of items sent.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                       const void * const pvItems,
+                                       UBaseType_t uxItemCount,
+                                       BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+ *                                           void * const pvBuffer,
+ *                                           UBaseType_t uxMaxItems,
+ *                                           BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xQueueReceiveMultiple() that can be called from an interrupt
+ * service routine.  It receives the items that are already in the queue,
+ * up to a maximum of uxMaxItems, without blocking.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the items
+ * unblocked a task with a priority higher than the currently running task,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                          void * const pvBuffer,
+                                          UBaseType_t uxMaxItems,
+                                          BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from within an ISR, or within a critical section.
@@ -1450,12 +1746,15 @@ BaseType_t xQueueCRReceive( QueueHandle_t xQueue,
 
 /*
  * For internal use only.  Use xSemaphoreCreateMutex(),
- * xSemaphoreCreateCounting() or xSemaphoreGetMutexHolder() instead of calling
- * these functions directly.
+ * xSemaphoreCreateMutexWithCeiling(), xSemaphoreCreateCounting() or
+ * xSemaphoreGetMutexHolder() instead of calling these functions directly.
  */
 QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
                                        StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeilingStatic( const UBaseType_t uxCeilingPriority,
+                                                  StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                              const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
@@ -798,6 +798,110 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority );
+ * @endcode
+ *
+ * Creates a new mutex type semaphore that uses the immediate priority ceiling
+ * protocol instead of priority inheritance, and returns a handle by which the
+ * new mutex can be referenced.  configUSE_MUTEX_PRIORITY_CEILING must be set to
+ * 1 in FreeRTOSConfig.h for xSemaphoreCreateMutexWithCeiling() to be available.
+ *
+ * uxCeilingPriority must be at least the priority of the highest priority task
+ * that will ever take the mutex.  A task that takes the mutex is raised to the
+ * ceiling priority straight away, so no other task that uses the mutex can
+ * preempt it while it holds the mutex.  A task whose priority equals the
+ * ceiling can still share processing time with the holder, in which case it
+ * just waits for the mutex to be given back.  A task therefore blocks for at
+ * most one critical section of a lower priority task, no task inherits a
+ * priority from a task waiting for the mutex, and tasks that only use mutexes
+ * created with this function, and never block while holding one, cannot
+ * deadlock.  This bounds blocking so it can be analysed offline.
+ *
+ * The task's priority is lowered again when the mutex is given back.  As with
+ * priority inheritance it is only lowered once the task holds no other
+ * mutexes, unless configUSE_PRIORITY_INHERITANCE_CHAINS is set to 1, in which
+ * case it is lowered to the highest ceiling or inherited priority that the
+ * mutexes still held call for.
+ *
+ * Mutexes created using this function can be accessed using the
+ * xSemaphoreTake() and xSemaphoreGive() macros.  The xSemaphoreTakeRecursive()
+ * and xSemaphoreGiveRecursive() macros must not be used.  Mutex type semaphores
+ * cannot be used from within interrupt service routines.
+ *
+ * @param uxCeilingPriority The priority a task that takes the mutex runs at
+ * until it gives the mutex back.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * semaphore is returned.  If there was not enough heap to allocate the mutex
+ * data structures then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xSemaphore;
+ *
+ * void vControlLoopTask( void * pvParameters )
+ * {
+ *  // The mutex is shared by tasks of priority 2, 3 and 4, so its ceiling
+ *  // is 4.
+ *  xSemaphore = xSemaphoreCreateMutexWithCeiling( 4 );
+ *
+ *  if( xSemaphore != NULL )
+ *  {
+ *      // The semaphore was created successfully.  A task that takes it runs
+ *      // at priority 4 until it gives it back.
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority )    xQueueCreateMutexWithCeiling( ( uxCeilingPriority ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority,
+ *                                                          StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * As xSemaphoreCreateMutexWithCeiling(), but the application writer provides
+ * the memory the mutex is stored in, so the mutex can be created without using
+ * any dynamic memory allocation.
+ *
+ * @param uxCeilingPriority The priority a task that takes the mutex runs at
+ * until it gives the mutex back.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the mutex's data structure, removing the need for
+ * the memory to be allocated dynamically.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If pxMutexBuffer was NULL then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xSemaphore;
+ * StaticSemaphore_t xMutexBuffer;
+ *
+ * void vControlLoopTask( void * pvParameters )
+ * {
+ *  // The mutex is shared by tasks of priority 2, 3 and 4, so its ceiling
+ *  // is 4.  No dynamic memory allocation is attempted.
+ *  xSemaphore = xSemaphoreCreateMutexWithCeilingStatic( 4, &xMutexBuffer );
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateMutexWithCeilingStatic xSemaphoreCreateMutexWithCeilingStatic
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateMutexWithCeilingStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
@@ -78,6 +78,19 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+/**
+ *  Type used to describe a region of a stream buffer's storage area that can be
+ *  written or read in place - see xStreamBufferSendReserve() and
+ *  xStreamBufferReceiveAcquire().  The region wraps from the end of the storage
+ *  area back to its start, so is described as up to two contiguous spans.  The
+ *  second span is only used if xSpanLength[ 1 ] is not zero.
+ */
+typedef struct xSTREAM_BUFFER_SPANS
+{
+    uint8_t * pucSpan[ 2 ];
+    size_t xSpanLength[ 2 ];
+} StreamBufferSpans_t;
+
 /**
  * stream_buffer.h
  *
@@ -633,6 +646,241 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
                                     size_t xBufferLengthBytes,
                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+ *                                  StreamBufferSpans_t * const pxSpans,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtains the free space in a stream buffer so it can be written in place -
+ * for example by a DMA controller or a driver filling a buffer directly -
+ * rather than by copying the data in with xStreamBufferSend().  The free space
+ * is described as up to two contiguous spans in *pxSpans.  Writing the space
+ * does not add any data to the stream buffer until xStreamBufferSendCommit()
+ * is called.
+ *
+ * When used with a message buffer the space is for the body of one message,
+ * and the message's length is added when it is committed.
+ *
+ * The same single writer restrictions as xStreamBufferSend() apply, and the
+ * stream buffer must not be sent to between reserving space and committing it.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to be written.
+ *
+ * @param pxSpans Set to describe the free space.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should remain
+ * in the Blocked state to wait for free space, should the stream buffer be
+ * full.
+ *
+ * @return The number of bytes described by *pxSpans, which is the sum of
+ * pxSpans->xSpanLength[ 0 ] and pxSpans->xSpanLength[ 1 ].  Zero is returned if
+ * there was no free space.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( StreamBufferHandle_t xStreamBuffer )
+ * {
+ * StreamBufferSpans_t xSpans;
+ * size_t xSpace;
+ *
+ *  xSpace = xStreamBufferSendReserve( xStreamBuffer, &xSpans, pdMS_TO_TICKS( 100 ) );
+ *
+ *  if( xSpace > 0 )
+ *  {
+ *      // Fill the first span, which runs up to the end of the storage area.
+ *      // The DMA transfer function is for illustration only.
+ *      vStartDMAReceive( xSpans.pucSpan[ 0 ], xSpans.xSpanLength[ 0 ] );
+ *      vWaitForDMAComplete();
+ *
+ *      // Make the bytes written available to the reader.
+ *      xStreamBufferSendCommit( xStreamBuffer, xSpans.xSpanLength[ 0 ] );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferSendReserve xStreamBufferSendReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferSpans_t * const pxSpans,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                         StreamBufferSpans_t * const pxSpans );
+ * @endcode
+ *
+ * A version of xStreamBufferSendReserve() that can be called from an
+ * interrupt service routine (ISR).  It never blocks.
+ *
+ * \defgroup xStreamBufferSendReserveFromISR xStreamBufferSendReserveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+ *                                 size_t xBytesWritten );
+ * @endcode
+ *
+ * Adds bytes written in place, into space obtained from
+ * xStreamBufferSendReserve(), to the stream buffer.  The first xBytesWritten
+ * bytes of the reserved space are added - that is, all of span 0 before any of
+ * span 1.  A task waiting for data is notified as it would be by
+ * xStreamBufferSend().
+ *
+ * When used with a message buffer xBytesWritten is the length of the message,
+ * and a message of zero bytes is not sent.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written.
+ *
+ * @param xBytesWritten The number of bytes written, which must not be more than
+ * were reserved.
+ *
+ * @return xBytesWritten.
+ *
+ * \defgroup xStreamBufferSendCommit xStreamBufferSendCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+                                size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                        size_t xBytesWritten,
+ *                                        BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferSendCommit() that can be called from an interrupt
+ * service routine (ISR).  *pxHigherPriorityTaskWoken is set to pdTRUE if a task
+ * that was waiting for data has a priority above the interrupted task - see
+ * xStreamBufferSendFromISR().
+ *
+ * \defgroup xStreamBufferSendCommitFromISR xStreamBufferSendCommitFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                       size_t xBytesWritten,
+                                       BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+ *                                     StreamBufferSpans_t * const pxSpans,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtains the data in a stream buffer so it can be read in place rather than
+ * copied out with xStreamBufferReceive().  The data is described as up to two
+ * contiguous spans in *pxSpans, and remains in the stream buffer until
+ * xStreamBufferReceiveRelease() is called.
+ *
+ * When used with a message buffer only the next message is described, not
+ * including its length.
+ *
+ * The same single reader restrictions as xStreamBufferReceive() apply, and the
+ * stream buffer must not be received from between acquiring data and
+ * releasing it.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to be read.
+ *
+ * @param pxSpans Set to describe the data.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should remain
+ * in the Blocked state to wait for data, should the stream buffer be empty.
+ *
+ * @return The number of bytes described by *pxSpans.  Zero is returned if there
+ * was no data.
+ *
+ * \defgroup xStreamBufferReceiveAcquire xStreamBufferReceiveAcquire
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+                                    StreamBufferSpans_t * const pxSpans,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                            StreamBufferSpans_t * const pxSpans );
+ * @endcode
+ *
+ * A version of xStreamBufferReceiveAcquire() that can be called from an
+ * interrupt service routine (ISR).  It never blocks.
+ *
+ * \defgroup xStreamBufferReceiveAcquireFromISR xStreamBufferReceiveAcquireFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+ *                                     size_t xBytesRead );
+ * @endcode
+ *
+ * Removes bytes read in place, from data obtained from
+ * xStreamBufferReceiveAcquire(), from the stream buffer.  The first xBytesRead
+ * bytes of the acquired data are removed.  A task waiting for space is notified
+ * as it would be by xStreamBufferReceive().
+ *
+ * When used with a message buffer xBytesRead must be either zero, which leaves
+ * the message in the message buffer, or the length of the message.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read.
+ *
+ * @param xBytesRead The number of bytes to remove, which must not be more than
+ * were acquired.
+ *
+ * @return xBytesRead.
+ *
+ * \defgroup xStreamBufferReceiveRelease xStreamBufferReceiveRelease
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                            size_t xBytesRead,
+ *                                            BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferReceiveRelease() that can be called from an
+ * interrupt service routine (ISR).  *pxHigherPriorityTaskWoken is set to pdTRUE
+ * if a task that was waiting for space has a priority above the interrupted
+ * task - see xStreamBufferReceiveFromISR().
+ *
+ * \defgroup xStreamBufferReceiveReleaseFromISR xStreamBufferReceiveReleaseFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           size_t xBytesRead,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -897,6 +1145,32 @@ StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
 
 size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 
+size_t xStreamBufferSendMessages( StreamBufferHandle_t xStreamBuffer,
+                                  const void * const * ppvTxMessages,
+                                  const size_t * pxMessageLengths,
+                                  size_t xMessageCount,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferSendMessagesFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         const void * const * ppvTxMessages,
+                                         const size_t * pxMessageLengths,
+                                         size_t xMessageCount,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferReceiveMessages( StreamBufferHandle_t xStreamBuffer,
+                                     void * pvRxData,
+                                     size_t xBufferLengthBytes,
+                                     size_t * pxMessageLengths,
+                                     size_t xMaxMessages,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferReceiveMessagesFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            void * pvRxData,
+                                            size_t xBufferLengthBytes,
+                                            size_t * pxMessageLengths,
+                                            size_t xMaxMessages,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_TRACE_FACILITY == 1 )
     void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer,
                                              UBaseType_t uxStreamBufferNumber ) PRIVILEGED_FUNCTION;
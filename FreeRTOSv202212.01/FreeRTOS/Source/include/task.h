@@ -168,6 +168,38 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with the uxTaskGetRunTimeSnapshot() function to return the run time of
+ * each task in the system. */
+typedef struct xTASK_RUN_TIME
+{
+    TaskHandle_t xHandle;                         /* The handle of the task to which the rest of the information in the structure relates. */
+    eTaskState eCurrentState;                     /* The state in which the task existed when the structure was populated. */
+    UBaseType_t uxCurrentPriority;                /* The priority at which the task was running (may be inherited) when the structure was populated. */
+    configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /* The run time charged to the task so far, excluding task level critical sections and interrupts that report their run time. */
+} TaskRunTime_t;
+
+/* Used with the uxTaskGetRunTimeSnapshot() function to return where the run
+ * time not charged to tasks went. */
+typedef struct xRUN_TIME_TOTALS
+{
+    configRUN_TIME_COUNTER_TYPE ulTotalRunTime;                          /* The run time since the scheduler was started. */
+    configRUN_TIME_COUNTER_TYPE ulIdleRunTime;                           /* The run time charged to the idle task. */
+    configRUN_TIME_COUNTER_TYPE ulKernelRunTime;                         /* The run time spent in task level critical sections. */
+    configRUN_TIME_COUNTER_TYPE ulISRRunTime[ configRUN_TIME_ISR_COUNT ]; /* The run time spent in each interrupt that reports its run time, indexed by the number passed to uxTaskRunTimeEnterISR(). */
+} RunTimeTotals_t;
+
+/* Used with the uxTaskGetCriticalSectionHistograms() function to return how
+ * long the critical sections or scheduler suspensions entered from one call
+ * site lasted. */
+typedef struct xCRITICAL_SECTION_HISTOGRAM
+{
+    const void * pvCallSite;                                          /* The address the section was entered from, or NULL for the sections whose call site is unknown or did not fit in the table. */
+    BaseType_t xSchedulerSuspended;                                   /* pdTRUE if the sections are vTaskSuspendAll() windows, pdFALSE if they are critical sections. */
+    uint32_t ulCount;                                                 /* The number of sections recorded. */
+    uint32_t ulLongest;                                               /* The length of the longest section recorded, in portCRITICAL_SECTION_TIMESTAMP() units. */
+    uint32_t ulBuckets[ configCRITICAL_SECTION_HISTOGRAM_BUCKETS ];   /* ulBuckets[ n ] counts the sections that lasted from 2^n to 2^(n+1) - 1 units.  The first bucket also counts zero length sections and the last bucket longer ones. */
+} CriticalSectionHistogram_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -185,6 +217,14 @@ typedef enum
  */
 #define tskIDLE_PRIORITY    ( ( UBaseType_t ) 0U )
 
+/**
+ * Defines the affinity mask that allows a task to run on any core.  Only used
+ * when configNUMBER_OF_CORES is greater than 1 and configUSE_CORE_AFFINITY is 1.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskNO_AFFINITY      ( ( UBaseType_t ) -1 )
+
 /**
  * task. h
  *
@@ -208,7 +248,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskENTER_CRITICAL()               portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR()      portSET_INTERRUPT_MASK_FROM_ISR()
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskENTER_CRITICAL_FROM_ISR()    portSET_INTERRUPT_MASK_FROM_ISR()
+#else
+    #define taskENTER_CRITICAL_FROM_ISR()    portENTER_CRITICAL_FROM_ISR()
+#endif
 
 /**
  * task. h
@@ -223,7 +267,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#else
+    #define taskEXIT_CRITICAL_FROM_ISR( x )    portEXIT_CRITICAL_FROM_ISR( x )
+#endif
 
 /**
  * task. h
@@ -1088,6 +1136,54 @@ void vTaskGetInfo( TaskHandle_t xTask,
 void vTaskPrioritySet( TaskHandle_t xTask,
                        UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );
+ * @endcode
+ *
+ * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+ * must be defined as 1 for this function to be available.
+ *
+ * Sets the cores on which a task can run.  Bit N of the mask set to 1 allows
+ * the task to run on core N.  If the task is running on a core that is not in
+ * the new mask it is moved off that core.
+ *
+ * @param xTask The handle of the task to set the core affinity for.  Passing
+ * NULL results in the affinity of the calling task being set.
+ *
+ * @param uxCoreAffinityMask A bitwise value in which each set bit is a core
+ * the task can run on, or tskNO_AFFINITY to allow the task to run on any core.
+ *
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup TaskCtrl
+ */
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t vTaskCoreAffinityGet( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+ * must be defined as 1 for this function to be available.
+ *
+ * @param xTask The handle of the task to query.  Passing NULL results in the
+ * affinity of the calling task being returned.
+ *
+ * @return The core affinity mask of the task, as set by vTaskCoreAffinitySet().
+ *
+ * \defgroup vTaskCoreAffinityGet vTaskCoreAffinityGet
+ * \ingroup TaskCtrl
+ */
+    UBaseType_t vTaskCoreAffinityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#endif /* if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+
 /**
  * task. h
  * @code{c}
@@ -1681,7 +1777,30 @@ configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVIL
     void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
                                         StackType_t ** ppxIdleTaskStackBuffer,
                                         uint32_t * pulIdleTaskStackSize ); /*lint !e526 Symbol not defined as it is an application callback. */
-#endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer, StackType_t ** ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex )
+ * @endcode
+ *
+ * This function is used to provide statically allocated memory to FreeRTOS to hold the idle tasks of the cores other than the first.  The idle task of the
+ * first core still uses vApplicationGetIdleTaskMemory().  This function is required when configSUPPORT_STATIC_ALLOCATION is set and configNUMBER_OF_CORES
+ * is greater than 1.
+ *
+ * @param ppxIdleTaskTCBBuffer A handle to a statically allocated TCB buffer
+ * @param ppxIdleTaskStackBuffer A handle to a statically allocated Stack buffer for the idle task
+ * @param pulIdleTaskStackSize A pointer to the number of elements that will fit in the allocated stack buffer
+ * @param xPassiveIdleTaskIndex The index of the passive idle task, from 0 to configNUMBER_OF_CORES - 2
+ */
+        void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                                   StackType_t ** ppxIdleTaskStackBuffer,
+                                                   uint32_t * pulIdleTaskStackSize,
+                                                   BaseType_t xPassiveIdleTaskIndex ); /*lint !e526 Symbol not defined as it is an application callback. */
+    #endif /* configNUMBER_OF_CORES > 1 */
+#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 /**
  * task.h
@@ -1708,6 +1827,18 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/**
+ * xTaskGetIdleTaskHandleForCore() is only available if
+ * INCLUDE_xTaskGetIdleTaskHandle is set to 1 in FreeRTOSConfig.h.
+ *
+ * Returns the handle of the idle task that runs on core xCoreID.
+ * xTaskGetIdleTaskHandle() returns the handle of the idle task of core 0.
+ */
+    TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -1957,6 +2088,117 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTime_t * const pxRunTimeArray, const UBaseType_t uxArraySize, RunTimeTotals_t * const pxTotals );
+ * @endcode
+ *
+ * configUSE_RUN_TIME_ACCOUNTING must be defined as 1 for this function to be
+ * available.
+ *
+ * With run time accounting the run time counter is sampled whenever the place
+ * the time is charged to changes, rather than only when tasks switch, so the
+ * time spent in task level critical sections and in interrupts that call
+ * uxTaskRunTimeEnterISR() and vTaskRunTimeExitISR() is counted separately
+ * instead of being charged to whichever task was interrupted.  The counts are
+ * configRUN_TIME_COUNTER_TYPE wide, which defaults to 64 bits, and are
+ * extended from the port's counter so do not wrap when it does.  The total
+ * run time is the sum of the task, kernel and interrupt run times.
+ *
+ * Unlike vTaskGetRunTimeStats() this function does no formatting, and unlike
+ * uxTaskGetSystemState() it does not measure stack high water marks, so it is
+ * cheap enough to call periodically from production code.
+ *
+ * @param pxRunTimeArray An array of TaskRunTime_t structures, one of which is
+ * filled in for each task.  May be NULL if only the totals are wanted.
+ *
+ * @param uxArraySize The size of the array pointed to by pxRunTimeArray.  If
+ * the array is too small to hold a structure for every task then no task is
+ * reported.
+ *
+ * @param pxTotals Filled in with the total, idle, kernel and per interrupt run
+ * times.  May be NULL.
+ *
+ * @return The number of TaskRunTime_t structures that were filled in.
+ *
+ * \defgroup uxTaskGetRunTimeSnapshot uxTaskGetRunTimeSnapshot
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTime_t * const pxRunTimeArray,
+                                      const UBaseType_t uxArraySize,
+                                      RunTimeTotals_t * const pxTotals ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskRunTimeEnterISR( UBaseType_t uxISR );
+ * void vTaskRunTimeExitISR( UBaseType_t uxPreviousContext );
+ * @endcode
+ *
+ * configUSE_RUN_TIME_ACCOUNTING must be defined as 1 for these functions to be
+ * available.
+ *
+ * Called at the start and end of an interrupt service routine to charge the
+ * time spent in it to the interrupt numbered uxISR, which must be less than
+ * configRUN_TIME_ISR_COUNT.  Ports that support accounting report the tick
+ * interrupt as number 0.  The value returned by uxTaskRunTimeEnterISR() must
+ * be passed to vTaskRunTimeExitISR(), which allows interrupts to nest.
+ *
+ * Example usage:
+ * @code{c}
+ * void vUARTInterruptHandler( void )
+ * {
+ * UBaseType_t uxPrevious = uxTaskRunTimeEnterISR( 1 );
+ *
+ *  // Service the interrupt.
+ *
+ *  vTaskRunTimeExitISR( uxPrevious );
+ * }
+ * @endcode
+ * \defgroup uxTaskRunTimeEnterISR uxTaskRunTimeEnterISR
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskRunTimeEnterISR( UBaseType_t uxISR ) PRIVILEGED_FUNCTION;
+void vTaskRunTimeExitISR( UBaseType_t uxPreviousContext ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetCriticalSectionHistograms( CriticalSectionHistogram_t * const pxHistogramArray, const UBaseType_t uxArraySize );
+ * void vTaskResetCriticalSectionHistograms( void );
+ * @endcode
+ *
+ * configUSE_CRITICAL_SECTION_HISTOGRAMS must be defined as 1 for these
+ * functions to be available.
+ *
+ * Ports that support the histograms time every outermost critical section
+ * from taskENTER_CRITICAL() to taskEXIT_CRITICAL(), which bounds interrupt
+ * latency, and the kernel times every outermost vTaskSuspendAll() to
+ * xTaskResumeAll() window, which bounds task switch latency.  Each length is
+ * counted in a log2 histogram kept for the address the section was entered
+ * from, as returned by portGET_CALL_SITE().  Use addr2line or the map file to
+ * find the source line.  A critical section that ends in a task switch, which
+ * some ports perform with interrupts masked, is timed up to the switch.
+ *
+ * Lengths are in portCRITICAL_SECTION_TIMESTAMP() units, which default to the
+ * run time stats clock.
+ *
+ * @param pxHistogramArray An array filled in with the histogram of each call
+ * site recorded so far.
+ *
+ * @param uxArraySize The size of the array pointed to by pxHistogramArray.
+ * The array needs no more than configCRITICAL_SECTION_HISTOGRAM_SITES entries.
+ *
+ * @return The number of CriticalSectionHistogram_t structures filled in.
+ *
+ * \defgroup uxTaskGetCriticalSectionHistograms uxTaskGetCriticalSectionHistograms
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetCriticalSectionHistograms( CriticalSectionHistogram_t * const pxHistogramArray,
+                                                const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+void vTaskResetCriticalSectionHistograms( void ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -2923,6 +3165,35 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
  */
 BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THESE FUNCTIONS MUST BE CALLED WITH INTERRUPTS DISABLED.
+ *
+ * Called by ports that support configUSE_RUN_TIME_ACCOUNTING as the critical
+ * nesting count goes from zero to one, and as it returns to zero, so the time
+ * spent in task level critical sections is charged to the kernel rather than
+ * to the task.
+ */
+void vTaskRunTimeEnterCritical( void ) PRIVILEGED_FUNCTION;
+void vTaskRunTimeExitCritical( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THESE FUNCTIONS MUST BE CALLED WITH INTERRUPTS DISABLED.
+ *
+ * Called by ports that support configUSE_CRITICAL_SECTION_HISTOGRAMS as the
+ * critical nesting count goes from zero to one, passing the address the
+ * critical section was entered from, and as it returns to zero.
+ */
+void vTaskCriticalSectionHistogramEnter( const void * pvCallSite ) PRIVILEGED_FUNCTION;
+void vTaskCriticalSectionHistogramExit( void ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -3011,7 +3282,11 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
  * Sets the pointer to the current TCB to the TCB of the highest priority task
  * that is ready to run.
  */
-portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+#else
+    portDONT_DISCARD void vTaskSwitchContext( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
@@ -3024,6 +3299,25 @@ TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * Return the handle of the task running on core xCoreID.
+ */
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
+ * PORTS THAT SUPPORT MORE THAN ONE CORE TO IMPLEMENT portENTER_CRITICAL(),
+ * portENTER_CRITICAL_FROM_ISR() and portYIELD_WITHIN_API().
+ */
+    void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+    UBaseType_t vTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+    void vTaskYieldWithinAPI( void ) PRIVILEGED_FUNCTION;
+#endif /* configNUMBER_OF_CORES > 1 */
+
 /*
  * Shortcut used by the queue implementation to prevent unnecessary call to
  * taskYIELD();
@@ -3103,6 +3397,40 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only, and only available when
+ * configUSE_PRIORITY_INHERITANCE_CHAINS is set to 1.  Used in place of
+ * pvTaskIncrementMutexHeldCount(), xTaskPriorityInherit(),
+ * xTaskPriorityDisinherit() and vTaskPriorityDisinheritAfterTimeout().
+ *
+ * pvTaskAddHeldMutex() adds the mutex referenced by pxMutexListItem, whose
+ * owner must be the list of tasks waiting for the mutex, to the list of mutexes
+ * held by the calling task and returns the handle of the calling task.
+ * xTaskRemoveHeldMutex() removes it again when the mutex is given, recalculates
+ * the priority of the calling task from the mutexes it still holds, and returns
+ * pdTRUE if that lowered the priority.
+ *
+ * xTaskPriorityInheritChain() records that the calling task is about to wait
+ * for the mutex whose holder is pointed to by pxMutexHolder, and raises the
+ * holder, the holder of the mutex that task is waiting for, and so on, to the
+ * priority of the calling task.
+ * vTaskPriorityDisinheritChainAfterTimeout() recalculates the priorities along
+ * the same chain after the calling task timed out waiting for the mutex.
+ */
+TaskHandle_t pvTaskAddHeldMutex( ListItem_t * const pxMutexListItem ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskRemoveHeldMutex( ListItem_t * const pxMutexListItem ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskPriorityInheritChain( TaskHandle_t * const pxMutexHolder ) PRIVILEGED_FUNCTION;
+void vTaskPriorityDisinheritChainAfterTimeout( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only, and only available when
+ * configUSE_MUTEX_PRIORITY_CEILING is set to 1.  Raises the priority of the
+ * calling task, which has just taken a mutex that has a ceiling, to
+ * uxCeilingPriority.  The priority is lowered again by the same mechanism that
+ * disinherits a priority when the mutex is given back.
+ */
+void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
@@ -55,6 +55,10 @@
 #if( configTOTAL_MPU_REGIONS == 16 )
     #error 16 MPU regions are not yet supported for this port.
 #endif
+
+#if( configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE == 1 )
+    #error Armv8-M baseline cores have no UsageFault, so stack limit violations cannot be reported by this port.
+#endif
 /*-----------------------------------------------------------*/
 
 /**
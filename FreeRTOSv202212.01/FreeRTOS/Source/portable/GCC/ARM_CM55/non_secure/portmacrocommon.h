@@ -121,6 +121,30 @@
         extern BaseType_t xIsPrivileged( void ) /* __attribute__ (( naked )) */;
         extern void vResetPrivilege( void ) /* __attribute__ (( naked )) */;
     #endif /* configENABLE_MPU */
+
+    #if ( defined( configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE ) && ( configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE == 1 ) )
+
+/**
+ * @brief Reports a stack limit fault to vApplicationStackOverflowHook().
+ *
+ * The port enables UsageFault but does not define its handler, so that it
+ * does not clash with one the application already has.  Install the check by
+ * calling this first from the application's UsageFault handler:
+ *
+ * @code{c}
+ * void UsageFault_Handler( void )
+ * {
+ *     vPortCheckStackOverflowFault();
+ *
+ *     // Handle any other usage fault here.
+ * }
+ * @endcode
+ *
+ * Does not return if the running task's stack pointer went below PSPLIM, and
+ * returns without doing anything for any other usage fault.
+ */
+        extern void vPortCheckStackOverflowFault( void ) /* PRIVILEGED_FUNCTION */;
+    #endif /* configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE */
 /*-----------------------------------------------------------*/
 
 /**
@@ -411,6 +411,18 @@ void vPortEnterCritical( void )
     if( uxCriticalNesting == 1 )
     {
         configASSERT( ( portNVIC_INT_CTRL_REG & portVECTACTIVE_MASK ) == 0 );
+
+        #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        {
+            vTaskRunTimeEnterCritical();
+        }
+        #endif
+
+        #if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+        {
+            vTaskCriticalSectionHistogramEnter( portGET_CALL_SITE() );
+        }
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -422,6 +434,18 @@ void vPortExitCritical( void )
 
     if( uxCriticalNesting == 0 )
     {
+        #if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+        {
+            vTaskCriticalSectionHistogramExit();
+        }
+        #endif
+
+        #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        {
+            vTaskRunTimeExitCritical();
+        }
+        #endif
+
         portENABLE_INTERRUPTS();
     }
 }
@@ -488,6 +512,11 @@ void xPortPendSVHandler( void )
 
 void xPortSysTickHandler( void )
 {
+    #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        /* The tick interrupt is reported as interrupt 0. */
+        UBaseType_t uxPreviousRunTimeContext = uxTaskRunTimeEnterISR( 0 );
+    #endif
+
     /* The SysTick runs at the lowest interrupt priority, so when this interrupt
      * executes all interrupts must be unmasked.  There is therefore no need to
      * save and then restore the interrupt mask value as its value is already
@@ -503,6 +532,12 @@ void xPortSysTickHandler( void )
         }
     }
     portENABLE_INTERRUPTS();
+
+    #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+    {
+        vTaskRunTimeExitISR( uxPreviousRunTimeContext );
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -242,6 +242,42 @@
 
     #define portMEMORY_BARRIER()    __asm volatile ( "" ::: "memory" )
 
+/* Identifies the call sites of critical sections for
+ * configUSE_CRITICAL_SECTION_HISTOGRAMS. */
+    #define portGET_CALL_SITE()     __builtin_return_address( 0 )
+
+/*-----------------------------------------------------------*/
+
+/* Set configUSE_DWT_CYCLE_COUNTER to 1 in FreeRTOSConfig.h to use the DWT
+ * cycle counter as the run time stats clock, which gives cycle accurate
+ * results when used with configUSE_RUN_TIME_ACCOUNTING.  The counter is 32
+ * bits wide, so without run time accounting the results are only valid until
+ * it first wraps.  The CM7 DWT must also be unlocked before it can be
+ * written. */
+    #ifndef configUSE_DWT_CYCLE_COUNTER
+        #define configUSE_DWT_CYCLE_COUNTER    0
+    #endif
+
+    #if ( configUSE_DWT_CYCLE_COUNTER == 1 )
+        #define portDEMCR_REG             ( *( ( volatile uint32_t * ) 0xe000edfc ) )
+        #define portDWT_CTRL_REG          ( *( ( volatile uint32_t * ) 0xe0001000 ) )
+        #define portDWT_CYCCNT_REG        ( *( ( volatile uint32_t * ) 0xe0001004 ) )
+        #define portDWT_LAR_REG           ( *( ( volatile uint32_t * ) 0xe0001fb0 ) )
+        #define portDWT_LAR_UNLOCK_KEY    ( 0xC5ACCE55UL )
+        #define portDEMCR_TRCENA_BIT      ( 1UL << 24UL )
+        #define portDWT_CYCCNTENA_BIT     ( 1UL << 0UL )
+
+        #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()                         \
+    {                                                                            \
+        portDEMCR_REG |= portDEMCR_TRCENA_BIT;                                   \
+        portDWT_LAR_REG = portDWT_LAR_UNLOCK_KEY;                                \
+        portDWT_CYCCNT_REG = 0UL;                                                \
+        portDWT_CTRL_REG |= portDWT_CYCCNTENA_BIT;                               \
+    }
+        #define portGET_RUN_TIME_COUNTER_VALUE()    ( portDWT_CYCCNT_REG )
+        #define portCRITICAL_SECTION_TIMESTAMP()    ( portDWT_CYCCNT_REG )
+    #endif /* configUSE_DWT_CYCLE_COUNTER */
+
     #ifdef __cplusplus
         }
     #endif
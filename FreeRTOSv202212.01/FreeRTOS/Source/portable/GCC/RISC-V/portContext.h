@@ -58,6 +58,40 @@
     #define portMSTATUS_OFFSET  30
 #endif
 
+/* When the F or D extension is in use the floating point registers are only
+ * saved for tasks that have written to them.  mstatus.FS (bits 13 and 14) is 0
+ * when the unit is off, 1 when it holds its initial state, 2 when it is clean
+ * and 3 when it is dirty.  Tasks start with FS set to initial, and the hardware
+ * sets it to dirty as soon as the task writes to a floating point register or
+ * fcsr.  The floating point registers are then stored above the rest of the
+ * context each time the task is switched out, and the dirty state in the
+ * mstatus value saved with the context records that they are there. */
+#ifdef __riscv_flen
+    /* f0 to f31, then fcsr, then a word used to hold t0 while the floating
+     * point registers are saved, rounded up to keep the stack 16 byte aligned
+     * on both 32-bit and 64-bit cores. */
+    #if __riscv_flen == 32
+        #define store_f fsw
+        #define load_f flw
+        #define portFPU_REG_SIZE 4
+        #define portFPU_CONTEXT_SIZE 144
+    #elif __riscv_flen == 64
+        #define store_f fsd
+        #define load_f fld
+        #define portFPU_REG_SIZE 8
+        #define portFPU_CONTEXT_SIZE 272
+    #else
+        #error The port only saves 32-bit and 64-bit floating point registers
+    #endif
+
+    #define portMSTATUS_FS_MASK 0x6000
+    #define portMSTATUS_FS_INITIAL 0x2000
+    #define portMSTATUS_FS_SHIFT 13
+    #define portMSTATUS_FS_DIRTY 3
+    #define portFPU_FCSR_OFFSET 32 * portFPU_REG_SIZE
+    #define portFPU_T0_OFFSET portFPU_CONTEXT_SIZE - portWORD_SIZE
+#endif /* __riscv_flen */
+
 /*-----------------------------------------------------------*/
 
 .extern pxCurrentTCB
@@ -66,7 +100,116 @@
 .extern pxCriticalNesting
 /*-----------------------------------------------------------*/
 
+#ifdef __riscv_flen
+
+/* Save the floating point registers if mstatus.FS is dirty.  t0 is needed to
+ * read mstatus, so is held just below the stack pointer until it has been
+ * reloaded - interrupts are disabled on entry to the trap so nothing else can
+ * use the stack in the meantime. */
+.macro portcontextSAVE_FPU_CONTEXT
+    store_x t0, -portWORD_SIZE( sp )
+    csrr t0, mstatus
+    srli t0, t0, portMSTATUS_FS_SHIFT
+    andi t0, t0, 3
+    addi t0, t0, -portMSTATUS_FS_DIRTY
+    bnez t0, 1f                         /* Not dirty, so the task has not used the floating point registers. */
+    addi sp, sp, -portFPU_CONTEXT_SIZE  /* The held t0 is now at portFPU_T0_OFFSET. */
+    store_f f0, 0 * portFPU_REG_SIZE( sp )
+    store_f f1, 1 * portFPU_REG_SIZE( sp )
+    store_f f2, 2 * portFPU_REG_SIZE( sp )
+    store_f f3, 3 * portFPU_REG_SIZE( sp )
+    store_f f4, 4 * portFPU_REG_SIZE( sp )
+    store_f f5, 5 * portFPU_REG_SIZE( sp )
+    store_f f6, 6 * portFPU_REG_SIZE( sp )
+    store_f f7, 7 * portFPU_REG_SIZE( sp )
+    store_f f8, 8 * portFPU_REG_SIZE( sp )
+    store_f f9, 9 * portFPU_REG_SIZE( sp )
+    store_f f10, 10 * portFPU_REG_SIZE( sp )
+    store_f f11, 11 * portFPU_REG_SIZE( sp )
+    store_f f12, 12 * portFPU_REG_SIZE( sp )
+    store_f f13, 13 * portFPU_REG_SIZE( sp )
+    store_f f14, 14 * portFPU_REG_SIZE( sp )
+    store_f f15, 15 * portFPU_REG_SIZE( sp )
+    store_f f16, 16 * portFPU_REG_SIZE( sp )
+    store_f f17, 17 * portFPU_REG_SIZE( sp )
+    store_f f18, 18 * portFPU_REG_SIZE( sp )
+    store_f f19, 19 * portFPU_REG_SIZE( sp )
+    store_f f20, 20 * portFPU_REG_SIZE( sp )
+    store_f f21, 21 * portFPU_REG_SIZE( sp )
+    store_f f22, 22 * portFPU_REG_SIZE( sp )
+    store_f f23, 23 * portFPU_REG_SIZE( sp )
+    store_f f24, 24 * portFPU_REG_SIZE( sp )
+    store_f f25, 25 * portFPU_REG_SIZE( sp )
+    store_f f26, 26 * portFPU_REG_SIZE( sp )
+    store_f f27, 27 * portFPU_REG_SIZE( sp )
+    store_f f28, 28 * portFPU_REG_SIZE( sp )
+    store_f f29, 29 * portFPU_REG_SIZE( sp )
+    store_f f30, 30 * portFPU_REG_SIZE( sp )
+    store_f f31, 31 * portFPU_REG_SIZE( sp )
+    frcsr t0
+    store_x t0, portFPU_FCSR_OFFSET( sp )
+    fscsr x0                            /* Tasks that have not used the floating point unit, so do not restore fcsr, see the default rounding mode. */
+    load_x t0, portFPU_T0_OFFSET( sp )
+    j 2f
+1:
+    load_x t0, -portWORD_SIZE( sp )
+2:
+    .endm
+/*-----------------------------------------------------------*/
+
+/* Restore the floating point registers if the mstatus value in t0, which was
+ * saved with the rest of the context, shows they were saved too.  Must be used
+ * after mstatus has been restored, so the floating point unit is on. */
+.macro portcontextRESTORE_FPU_CONTEXT
+    srli t1, t0, portMSTATUS_FS_SHIFT
+    andi t1, t1, 3
+    addi t1, t1, -portMSTATUS_FS_DIRTY
+    bnez t1, 1f
+    addi t1, sp, portCONTEXT_SIZE       /* The floating point registers are above the rest of the context. */
+    load_f  f0, 0 * portFPU_REG_SIZE( t1 )
+    load_f  f1, 1 * portFPU_REG_SIZE( t1 )
+    load_f  f2, 2 * portFPU_REG_SIZE( t1 )
+    load_f  f3, 3 * portFPU_REG_SIZE( t1 )
+    load_f  f4, 4 * portFPU_REG_SIZE( t1 )
+    load_f  f5, 5 * portFPU_REG_SIZE( t1 )
+    load_f  f6, 6 * portFPU_REG_SIZE( t1 )
+    load_f  f7, 7 * portFPU_REG_SIZE( t1 )
+    load_f  f8, 8 * portFPU_REG_SIZE( t1 )
+    load_f  f9, 9 * portFPU_REG_SIZE( t1 )
+    load_f  f10, 10 * portFPU_REG_SIZE( t1 )
+    load_f  f11, 11 * portFPU_REG_SIZE( t1 )
+    load_f  f12, 12 * portFPU_REG_SIZE( t1 )
+    load_f  f13, 13 * portFPU_REG_SIZE( t1 )
+    load_f  f14, 14 * portFPU_REG_SIZE( t1 )
+    load_f  f15, 15 * portFPU_REG_SIZE( t1 )
+    load_f  f16, 16 * portFPU_REG_SIZE( t1 )
+    load_f  f17, 17 * portFPU_REG_SIZE( t1 )
+    load_f  f18, 18 * portFPU_REG_SIZE( t1 )
+    load_f  f19, 19 * portFPU_REG_SIZE( t1 )
+    load_f  f20, 20 * portFPU_REG_SIZE( t1 )
+    load_f  f21, 21 * portFPU_REG_SIZE( t1 )
+    load_f  f22, 22 * portFPU_REG_SIZE( t1 )
+    load_f  f23, 23 * portFPU_REG_SIZE( t1 )
+    load_f  f24, 24 * portFPU_REG_SIZE( t1 )
+    load_f  f25, 25 * portFPU_REG_SIZE( t1 )
+    load_f  f26, 26 * portFPU_REG_SIZE( t1 )
+    load_f  f27, 27 * portFPU_REG_SIZE( t1 )
+    load_f  f28, 28 * portFPU_REG_SIZE( t1 )
+    load_f  f29, 29 * portFPU_REG_SIZE( t1 )
+    load_f  f30, 30 * portFPU_REG_SIZE( t1 )
+    load_f  f31, 31 * portFPU_REG_SIZE( t1 )
+    load_x  t2, portFPU_FCSR_OFFSET( t1 )
+    fscsr t2
+1:
+    .endm
+/*-----------------------------------------------------------*/
+
+#endif /* __riscv_flen */
+
 .macro portcontextSAVE_CONTEXT_INTERNAL
+#ifdef __riscv_flen
+    portcontextSAVE_FPU_CONTEXT
+#endif
     addi sp, sp, -portCONTEXT_SIZE
     store_x x1, 1 * portWORD_SIZE( sp )
     store_x x5, 2 * portWORD_SIZE( sp )
@@ -149,12 +292,18 @@
     load_x  t0, portMSTATUS_OFFSET * portWORD_SIZE( sp )
     csrw mstatus, t0                        /* Required for MPIE bit. */
 
+#ifdef __riscv_flen
+    portcontextRESTORE_FPU_CONTEXT          /* Leaves mstatus.FS dirty, so the registers are saved again when the task is next switched out. */
+#endif
+
     load_x  t0, portCRITICAL_NESTING_OFFSET * portWORD_SIZE( sp )    /* Obtain xCriticalNesting value for this task from task's stack. */
     load_x  t1, pxCriticalNesting           /* Load the address of xCriticalNesting into t1. */
     store_x t0, 0( t1 )                     /* Restore the critical nesting value for this task. */
 
     load_x  x1, 1 * portWORD_SIZE( sp )
+#ifndef __riscv_flen
     load_x  x5, 2 * portWORD_SIZE( sp )
+#endif
     load_x  x6, 3 * portWORD_SIZE( sp )
     load_x  x7, 4 * portWORD_SIZE( sp )
     load_x  x8, 5 * portWORD_SIZE( sp )
@@ -183,6 +332,21 @@
     load_x  x30, 27 * portWORD_SIZE( sp )
     load_x  x31, 28 * portWORD_SIZE( sp )
 #endif
+
+#ifdef __riscv_flen
+    /* x5 (t0) is restored last as it is needed to check whether the floating
+     * point registers are on the stack above the rest of the context. */
+    load_x  x5, portMSTATUS_OFFSET * portWORD_SIZE( sp )
+    srli x5, x5, portMSTATUS_FS_SHIFT
+    andi x5, x5, 3
+    addi x5, x5, -portMSTATUS_FS_DIRTY
+    bnez x5, 3f
+    load_x  x5, 2 * portWORD_SIZE( sp )
+    addi sp, sp, portCONTEXT_SIZE + portFPU_CONTEXT_SIZE
+    mret
+3:
+    load_x  x5, 2 * portWORD_SIZE( sp )
+#endif
     addi sp, sp, portCONTEXT_SIZE
 
     mret
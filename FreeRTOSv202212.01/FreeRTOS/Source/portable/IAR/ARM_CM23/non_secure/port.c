@@ -92,6 +92,9 @@
  */
 #define portSCB_SYS_HANDLER_CTRL_STATE_REG    ( *( volatile uint32_t * ) 0xe000ed24 )
 #define portSCB_MEM_FAULT_ENABLE_BIT          ( 1UL << 16UL )
+#define portSCB_USG_FAULT_ENABLE_BIT          ( 1UL << 18UL )
+#define portSCB_CONFIGURABLE_FAULT_STATUS_REG ( *( volatile uint32_t * ) 0xe000ed28 )
+#define portSCB_CFSR_STKOF_BIT                ( 1UL << 20UL )
 /*-----------------------------------------------------------*/
 
 /**
@@ -825,6 +828,30 @@ void SysTick_Handler( void ) /* PRIVILEGED_FUNCTION */
 }
 /*-----------------------------------------------------------*/
 
+#if ( configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE == 1 )
+    void vPortCheckStackOverflowFault( void ) /* PRIVILEGED_FUNCTION */
+    {
+        /* PSPLIM holds the start of the running task's stack, so a stack limit
+         * fault means the task tried to push below it.  The push that raised
+         * the fault did not write anything, so the memory beyond the stack
+         * is intact, but the task cannot be resumed. */
+        if( ( portSCB_CONFIGURABLE_FAULT_STATUS_REG & portSCB_CFSR_STKOF_BIT ) != 0UL )
+        {
+            vApplicationStackOverflowHook( xTaskGetCurrentTaskHandle(), pcTaskGetName( NULL ) );
+
+            /* The stack overflow hook returned. */
+            portDISABLE_INTERRUPTS();
+
+            for( ; ; )
+            {
+            }
+        }
+
+        /* Any other usage fault is left to the application's handler. */
+    }
+#endif /* configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE */
+/*-----------------------------------------------------------*/
+
 void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) /* PRIVILEGED_FUNCTION portDONT_DISCARD */
 {
     #if ( configENABLE_MPU == 1 )
@@ -1080,6 +1107,15 @@ BaseType_t xPortStartScheduler( void ) /* PRIVILEGED_FUNCTION */
     }
     #endif /* configENABLE_MPU */
 
+    #if ( configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE == 1 )
+    {
+        /* Route stack limit violations to the application's UsageFault
+         * handler, which calls vPortCheckStackOverflowFault(), rather than
+         * letting them escalate to a HardFault. */
+        portSCB_SYS_HANDLER_CTRL_STATE_REG |= portSCB_USG_FAULT_ENABLE_BIT;
+    }
+    #endif /* configCHECK_FOR_STACK_OVERFLOW_IN_HARDWARE */
+
     /* Start the timer that generates the tick ISR. Interrupts are disabled
      * here already. */
     vPortSetupTimerInterrupt();
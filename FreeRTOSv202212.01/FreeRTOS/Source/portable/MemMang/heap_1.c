@@ -150,3 +150,16 @@ size_t xPortGetFreeHeapSize( void )
 {
     return( configADJUSTED_HEAP_SIZE - xNextFreeByte );
 }
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_TASK_CACHE == 1 )
+
+/* Only heap_4.c implements the task caches, so a task never has one to
+ * release. */
+    void vPortReleaseTaskCache( void * pvTaskCache ) /* PRIVILEGED_FUNCTION */
+    {
+        ( void ) pvTaskCache;
+    }
+
+#endif /* configUSE_HEAP_TASK_CACHE */
+/*-----------------------------------------------------------*/
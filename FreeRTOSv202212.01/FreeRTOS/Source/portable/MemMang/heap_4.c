@@ -100,6 +100,49 @@ typedef struct A_BLOCK_LINK
     size_t xBlockSize;                     /*<< The size of the free block. */
 } BlockLink_t;
 
+#if ( configUSE_HEAP_TASK_CACHE == 1 )
+
+/* The smallest block size class held in the task caches.  Each following
+ * class is twice the size of the one before it. */
+    #define heapCACHE_SMALLEST_CLASS    ( ( size_t ) 16 )
+    #define heapCACHE_LARGEST_CLASS     ( heapCACHE_SMALLEST_CLASS << ( configHEAP_TASK_CACHE_SIZE_CLASSES - 1 ) )
+
+/* The xBlockSize of a block allocated for a request of xClassSize bytes - the
+ * same adjustment prvAllocateBlock() makes to the wanted size. */
+    #define heapCACHE_BLOCK_SIZE( xClassSize )    ( ( xClassSize ) + xHeapStructSize + portBYTE_ALIGNMENT - ( ( xClassSize ) & portBYTE_ALIGNMENT_MASK ) )
+
+/* Blocks held in a task cache remain marked as allocated, but are linked
+ * through their pxNextFreeBlock member.  The lists end with a pointer to xStart
+ * rather than NULL so that no cached block has a NULL pxNextFreeBlock, which
+ * means freeing a cached block a second time is caught by vPortFree(). */
+    #define heapCACHE_LIST_END    ( &xStart )
+
+/* The free blocks of one size class held by a task. */
+    typedef struct A_HEAP_CACHE_MAGAZINE
+    {
+        BlockLink_t * pxFirstBlock; /*<< The most recently cached block. */
+        size_t xNumberOfBlocks;     /*<< The number of blocks in the magazine. */
+    } HeapCacheMagazine_t;
+
+/* The cache of a single task, pointed to by its configHEAP_TASK_CACHE_TLS_INDEX
+ * thread local storage pointer.  The owning task takes blocks from and returns
+ * blocks to its magazines without a critical section, setting xInUse while it
+ * does so.  Any other access is made with the scheduler suspended, and only
+ * while xInUse is clear and the owning task is not running. */
+    typedef struct A_HEAP_TASK_CACHE
+    {
+        HeapCacheMagazine_t xMagazines[ configHEAP_TASK_CACHE_SIZE_CLASSES ];
+        volatile BaseType_t xInUse;         /*<< pdTRUE while the owning task is accessing its magazines outside a scheduler suspension. */
+        size_t xCacheHits;                  /*<< Allocations served from a magazine. */
+        size_t xCacheMisses;                /*<< Allocations that had to refill a magazine. */
+        struct A_HEAP_TASK_CACHE * pxNext;  /*<< The next cache in the list of all caches. */
+        #if ( configNUMBER_OF_CORES > 1 )
+            TaskHandle_t xOwner;            /*<< The task that owns the cache. */
+        #endif
+    } HeapTaskCache_t;
+
+#endif /* configUSE_HEAP_TASK_CACHE */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -116,6 +159,51 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEG
  */
 static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Takes a block of at least xWantedSize bytes from the free list.  Must be
+ * called with the scheduler suspended.
+ */
+static void * prvAllocateBlock( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns an allocated block to the free list.  Must be called with the
+ * scheduler suspended.
+ */
+static void prvFreeBlock( BlockLink_t * pxLink ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_HEAP_TASK_CACHE == 1 )
+
+/*
+ * Serves a small allocation from the calling task's cache, refilling the
+ * cache from the heap if it holds no block of the right size class.  Returns
+ * NULL if the request is not small enough to be cached, if the scheduler has
+ * not been started, or if the heap is exhausted.
+ */
+    static void * prvTaskCacheAllocate( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Places a block that is being freed into the calling task's cache if the
+ * task has a cache and the block's size matches a size class.  Returns pdTRUE
+ * if the block was cached, or pdFALSE if it must be returned to the heap.
+ */
+    static BaseType_t prvTaskCacheFree( BlockLink_t * pxLink ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns every block held in a cache to the heap.  Must be called with the
+ * scheduler suspended.
+ */
+    static void prvEmptyTaskCache( HeapTaskCache_t * pxCache ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the blocks held in the caches that are not in use to the heap, so an
+ * allocation the free list alone cannot meet can be tried again.  Must be
+ * called with the scheduler suspended.  Returns pdTRUE if any block was
+ * returned.
+ */
+    static BaseType_t prvFlushTaskCaches( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_TASK_CACHE */
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -133,9 +221,75 @@ PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
 
+#if ( configUSE_HEAP_TASK_CACHE == 1 )
+
+/* All the task caches, and the totals of those that have been released, so
+ * vPortGetHeapTaskCacheStats() can report on every cache. */
+    PRIVILEGED_DATA static HeapTaskCache_t * pxTaskCaches = NULL;
+    PRIVILEGED_DATA static size_t xReleasedCacheHits = 0;
+    PRIVILEGED_DATA static size_t xReleasedCacheMisses = 0;
+
+#endif /* configUSE_HEAP_TASK_CACHE */
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
+{
+    void * pvReturn = NULL;
+
+    #if ( configUSE_HEAP_TASK_CACHE == 1 )
+    {
+        pvReturn = prvTaskCacheAllocate( xWantedSize );
+    }
+    #endif
+
+    if( pvReturn == NULL )
+    {
+        vTaskSuspendAll();
+        {
+            pvReturn = prvAllocateBlock( xWantedSize );
+
+            #if ( configUSE_HEAP_TASK_CACHE == 1 )
+            {
+                /* Blocks held in the task caches are free in all but name, so
+                 * return them to the heap before failing the allocation. */
+                if( ( pvReturn == NULL ) && ( prvFlushTaskCaches() != pdFALSE ) )
+                {
+                    pvReturn = prvAllocateBlock( xWantedSize );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+        }
+        ( void ) xTaskResumeAll();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvAllocateBlock( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
 {
     BlockLink_t * pxBlock;
     BlockLink_t * pxPreviousBlock;
@@ -143,116 +297,109 @@ void * pvPortMalloc( size_t xWantedSize )
     void * pvReturn = NULL;
     size_t xAdditionalRequiredSize;
 
-    vTaskSuspendAll();
+    /* If this is the first call to malloc then the heap will require
+     * initialisation to setup the list of free blocks. */
+    if( pxEnd == NULL )
+    {
+        prvHeapInit();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xWantedSize > 0 )
     {
-        /* If this is the first call to malloc then the heap will require
-         * initialisation to setup the list of free blocks. */
-        if( pxEnd == NULL )
+        /* The wanted size must be increased so it can contain a BlockLink_t
+         * structure in addition to the requested amount of bytes. Some
+         * additional increment may also be needed for alignment. */
+        xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+        if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
         {
-            prvHeapInit();
+            xWantedSize += xAdditionalRequiredSize;
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            xWantedSize = 0;
         }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-        if( xWantedSize > 0 )
+    /* Check the block size we are trying to allocate is not so large that the
+     * top bit is set.  The top bit of the block size member of the BlockLink_t
+     * structure is used to determine who owns the block - the application or
+     * the kernel, so it must be free. */
+    if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+    {
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
         {
-            /* The wanted size must be increased so it can contain a BlockLink_t
-             * structure in addition to the requested amount of bytes. Some
-             * additional increment may also be needed for alignment. */
-            xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+            /* Traverse the list from the start (lowest address) block until
+             * one of adequate size is found. */
+            pxPreviousBlock = &xStart;
+            pxBlock = xStart.pxNextFreeBlock;
 
-            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
             {
-                xWantedSize += xAdditionalRequiredSize;
-            }
-            else
-            {
-                xWantedSize = 0;
+                pxPreviousBlock = pxBlock;
+                pxBlock = pxBlock->pxNextFreeBlock;
             }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
 
-        /* Check the block size we are trying to allocate is not so large that the
-         * top bit is set.  The top bit of the block size member of the BlockLink_t
-         * structure is used to determine who owns the block - the application or
-         * the kernel, so it must be free. */
-        if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
-        {
-            if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            /* If the end marker was reached then a block of adequate size
+             * was not found. */
+            if( pxBlock != pxEnd )
             {
-                /* Traverse the list from the start (lowest address) block until
-                 * one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = xStart.pxNextFreeBlock;
+                /* Return the memory space pointed to - jumping over the
+                 * BlockLink_t structure at its start. */
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxPreviousBlock->pxNextFreeBlock ) + xHeapStructSize );
 
-                while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+                /* This block is being returned for use so must be taken out
+                 * of the list of free blocks. */
+                pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+                /* If the block is larger than required it can be split into
+                 * two. */
+                if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
                 {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = pxBlock->pxNextFreeBlock;
+                    /* This block is to be split into two.  Create a new
+                     * block following the number of bytes requested. The void
+                     * cast is used to prevent byte alignment warnings from the
+                     * compiler. */
+                    pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                    configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                    /* Calculate the sizes of two blocks split from the
+                     * single block. */
+                    pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* Insert the new block into the list of free blocks. */
+                    prvInsertBlockIntoFreeList( pxNewBlockLink );
                 }
-
-                /* If the end marker was reached then a block of adequate size
-                 * was not found. */
-                if( pxBlock != pxEnd )
+                else
                 {
-                    /* Return the memory space pointed to - jumping over the
-                     * BlockLink_t structure at its start. */
-                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxPreviousBlock->pxNextFreeBlock ) + xHeapStructSize );
-
-                    /* This block is being returned for use so must be taken out
-                     * of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-                    /* If the block is larger than required it can be split into
-                     * two. */
-                    if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
-                    {
-                        /* This block is to be split into two.  Create a new
-                         * block following the number of bytes requested. The void
-                         * cast is used to prevent byte alignment warnings from the
-                         * compiler. */
-                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
-                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
-
-                        /* Calculate the sizes of two blocks split from the
-                         * single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        prvInsertBlockIntoFreeList( pxNewBlockLink );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    xFreeBytesRemaining -= pxBlock->xBlockSize;
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
-                    {
-                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
 
-                    /* The block is being returned - it is allocated and owned
-                     * by the application and has no "next" block. */
-                    heapALLOCATE_BLOCK( pxBlock );
-                    pxBlock->pxNextFreeBlock = NULL;
-                    xNumberOfSuccessfulAllocations++;
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                /* The block is being returned - it is allocated and owned
+                 * by the application and has no "next" block. */
+                heapALLOCATE_BLOCK( pxBlock );
+                pxBlock->pxNextFreeBlock = NULL;
+                xNumberOfSuccessfulAllocations++;
             }
             else
             {
@@ -263,25 +410,14 @@ void * pvPortMalloc( size_t xWantedSize )
         {
             mtCOVERAGE_TEST_MARKER();
         }
-
-        traceMALLOC( pvReturn, xWantedSize );
     }
-    ( void ) xTaskResumeAll();
-
-    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    else
     {
-        if( pvReturn == NULL )
-        {
-            vApplicationMallocFailedHook();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        mtCOVERAGE_TEST_MARKER();
     }
-    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
 
-    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    traceMALLOC( pvReturn, xWantedSize );
+
     return pvReturn;
 }
 /*-----------------------------------------------------------*/
@@ -290,6 +426,7 @@ void vPortFree( void * pv )
 {
     uint8_t * puc = ( uint8_t * ) pv;
     BlockLink_t * pxLink;
+    BaseType_t xCached = pdFALSE;
 
     if( pv != NULL )
     {
@@ -307,24 +444,30 @@ void vPortFree( void * pv )
         {
             if( pxLink->pxNextFreeBlock == NULL )
             {
-                /* The block is being returned to the heap - it is no longer
-                 * allocated. */
-                heapFREE_BLOCK( pxLink );
                 #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
                 {
-                    ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
+                    ( void ) memset( puc + xHeapStructSize, 0, ( pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK ) - xHeapStructSize );
                 }
                 #endif
 
-                vTaskSuspendAll();
+                #if ( configUSE_HEAP_TASK_CACHE == 1 )
                 {
-                    /* Add this block to the list of free blocks. */
-                    xFreeBytesRemaining += pxLink->xBlockSize;
-                    traceFREE( pv, pxLink->xBlockSize );
-                    prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
-                    xNumberOfSuccessfulFrees++;
+                    xCached = prvTaskCacheFree( pxLink );
+                }
+                #endif
+
+                if( xCached == pdFALSE )
+                {
+                    vTaskSuspendAll();
+                    {
+                        prvFreeBlock( pxLink );
+                    }
+                    ( void ) xTaskResumeAll();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                ( void ) xTaskResumeAll();
             }
             else
             {
@@ -339,6 +482,19 @@ void vPortFree( void * pv )
 }
 /*-----------------------------------------------------------*/
 
+static void prvFreeBlock( BlockLink_t * pxLink ) /* PRIVILEGED_FUNCTION */
+{
+    /* The block is being returned to the heap - it is no longer allocated. */
+    heapFREE_BLOCK( pxLink );
+
+    /* Add this block to the list of free blocks. */
+    xFreeBytesRemaining += pxLink->xBlockSize;
+    traceFREE( ( ( uint8_t * ) pxLink ) + xHeapStructSize, pxLink->xBlockSize );
+    prvInsertBlockIntoFreeList( pxLink );
+    xNumberOfSuccessfulFrees++;
+}
+/*-----------------------------------------------------------*/
+
 size_t xPortGetFreeHeapSize( void )
 {
     return xFreeBytesRemaining;
@@ -535,3 +691,389 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_TASK_CACHE == 1 )
+
+    static void * prvTaskCacheAllocate( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTaskCache_t * pxCache;
+        HeapCacheMagazine_t * pxMagazine;
+        BlockLink_t * pxBlock;
+        void * pvReturn = NULL;
+        void * pvBlock;
+        size_t xClassSize = heapCACHE_SMALLEST_CLASS;
+        UBaseType_t uxClass = 0;
+        UBaseType_t uxMagazine;
+        UBaseType_t uxBlocks;
+
+        /* Before the scheduler starts there is no calling task to own a
+         * cache. */
+        if( ( xWantedSize > 0 ) &&
+            ( xWantedSize <= heapCACHE_LARGEST_CLASS ) &&
+            ( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) )
+        {
+            while( xClassSize < xWantedSize )
+            {
+                xClassSize <<= 1;
+                uxClass++;
+            }
+
+            pxCache = ( HeapTaskCache_t * ) pvTaskGetThreadLocalStoragePointer( NULL, configHEAP_TASK_CACHE_TLS_INDEX );
+
+            if( pxCache != NULL )
+            {
+                /* The fast path - take the most recently cached block.  xInUse
+                 * stops the magazine being flushed by another task part way
+                 * through. */
+                pxCache->xInUse = pdTRUE;
+                portMEMORY_BARRIER();
+
+                pxMagazine = &( pxCache->xMagazines[ uxClass ] );
+
+                if( pxMagazine->xNumberOfBlocks > 0U )
+                {
+                    pxBlock = pxMagazine->pxFirstBlock;
+                    pxMagazine->pxFirstBlock = pxBlock->pxNextFreeBlock;
+                    pxMagazine->xNumberOfBlocks--;
+                    pxCache->xCacheHits++;
+
+                    pxBlock->pxNextFreeBlock = NULL;
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                portMEMORY_BARRIER();
+                pxCache->xInUse = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pvReturn == NULL )
+            {
+                vTaskSuspendAll();
+                {
+                    if( pxCache == NULL )
+                    {
+                        /* This is the task's first small allocation, so
+                         * create its cache. */
+                        pxCache = ( HeapTaskCache_t * ) prvAllocateBlock( sizeof( HeapTaskCache_t ) );
+
+                        if( pxCache != NULL )
+                        {
+                            for( uxMagazine = 0; uxMagazine < ( UBaseType_t ) configHEAP_TASK_CACHE_SIZE_CLASSES; uxMagazine++ )
+                            {
+                                pxCache->xMagazines[ uxMagazine ].pxFirstBlock = heapCACHE_LIST_END;
+                                pxCache->xMagazines[ uxMagazine ].xNumberOfBlocks = 0;
+                            }
+
+                            pxCache->xInUse = pdFALSE;
+                            pxCache->xCacheHits = 0;
+                            pxCache->xCacheMisses = 0;
+                            pxCache->pxNext = pxTaskCaches;
+                            pxTaskCaches = pxCache;
+
+                            #if ( configNUMBER_OF_CORES > 1 )
+                            {
+                                pxCache->xOwner = xTaskGetCurrentTaskHandle();
+                            }
+                            #endif
+
+                            vTaskSetThreadLocalStoragePointer( NULL, configHEAP_TASK_CACHE_TLS_INDEX, ( void * ) pxCache );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( pxCache != NULL )
+                    {
+                        /* Refill the magazine with a batch of blocks taken
+                         * from the heap in one go, returning one of them. */
+                        pxCache->xCacheMisses++;
+                        pxMagazine = &( pxCache->xMagazines[ uxClass ] );
+                        pvReturn = prvAllocateBlock( xClassSize );
+                        pvBlock = pvReturn;
+
+                        for( uxBlocks = 1; ( uxBlocks < ( UBaseType_t ) configHEAP_TASK_CACHE_BATCH_SIZE ) && ( pvBlock != NULL ); uxBlocks++ )
+                        {
+                            pvBlock = prvAllocateBlock( xClassSize );
+
+                            if( pvBlock != NULL )
+                            {
+                                pxBlock = ( BlockLink_t * ) ( ( ( uint8_t * ) pvBlock ) - xHeapStructSize );
+                                pxBlock->pxNextFreeBlock = pxMagazine->pxFirstBlock;
+                                pxMagazine->pxFirstBlock = pxBlock;
+                                pxMagazine->xNumberOfBlocks++;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvTaskCacheFree( BlockLink_t * pxLink ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTaskCache_t * pxCache = NULL;
+        HeapCacheMagazine_t * pxMagazine;
+        BlockLink_t * pxBlock;
+        BaseType_t xReturn = pdFALSE;
+        size_t xBlockSize = pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+        size_t xClassSize = heapCACHE_SMALLEST_CLASS;
+        UBaseType_t uxClass = 0;
+        UBaseType_t uxBlocks;
+
+        if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+        {
+            pxCache = ( HeapTaskCache_t * ) pvTaskGetThreadLocalStoragePointer( NULL, configHEAP_TASK_CACHE_TLS_INDEX );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( pxCache != NULL ) && ( xBlockSize <= heapCACHE_BLOCK_SIZE( heapCACHE_LARGEST_CLASS ) ) )
+        {
+            /* Only blocks that are exactly the size allocated for a size class
+             * are cached.  A block that was not split when it was allocated is
+             * larger, so goes back to the heap. */
+            while( ( uxClass < ( UBaseType_t ) configHEAP_TASK_CACHE_SIZE_CLASSES ) && ( heapCACHE_BLOCK_SIZE( xClassSize ) != xBlockSize ) )
+            {
+                xClassSize <<= 1;
+                uxClass++;
+            }
+
+            if( uxClass < ( UBaseType_t ) configHEAP_TASK_CACHE_SIZE_CLASSES )
+            {
+                pxCache->xInUse = pdTRUE;
+                portMEMORY_BARRIER();
+
+                pxMagazine = &( pxCache->xMagazines[ uxClass ] );
+
+                if( pxMagazine->xNumberOfBlocks >= ( size_t ) configHEAP_TASK_CACHE_MAGAZINE_SIZE )
+                {
+                    /* The magazine is full, so return a batch of blocks to
+                     * the heap in one go to make room. */
+                    vTaskSuspendAll();
+                    {
+                        for( uxBlocks = 0; uxBlocks < ( UBaseType_t ) configHEAP_TASK_CACHE_BATCH_SIZE; uxBlocks++ )
+                        {
+                            pxBlock = pxMagazine->pxFirstBlock;
+                            pxMagazine->pxFirstBlock = pxBlock->pxNextFreeBlock;
+                            pxBlock->pxNextFreeBlock = NULL;
+                            prvFreeBlock( pxBlock );
+                        }
+
+                        pxMagazine->xNumberOfBlocks -= ( size_t ) configHEAP_TASK_CACHE_BATCH_SIZE;
+                    }
+                    ( void ) xTaskResumeAll();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxLink->pxNextFreeBlock = pxMagazine->pxFirstBlock;
+                pxMagazine->pxFirstBlock = pxLink;
+                pxMagazine->xNumberOfBlocks++;
+                xReturn = pdTRUE;
+
+                portMEMORY_BARRIER();
+                pxCache->xInUse = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortReleaseTaskCache( void * pvTaskCache ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTaskCache_t * pxCache = ( HeapTaskCache_t * ) pvTaskCache;
+        HeapTaskCache_t ** ppxLink;
+
+        if( pxCache != NULL )
+        {
+            vTaskSuspendAll();
+            {
+                prvEmptyTaskCache( pxCache );
+
+                /* Keep the cache's counts in the totals, then remove it from
+                 * the list of caches and free it. */
+                xReleasedCacheHits += pxCache->xCacheHits;
+                xReleasedCacheMisses += pxCache->xCacheMisses;
+
+                for( ppxLink = &pxTaskCaches; *ppxLink != pxCache; ppxLink = &( ( *ppxLink )->pxNext ) )
+                {
+                    configASSERT( *ppxLink != NULL );
+                }
+
+                *ppxLink = pxCache->pxNext;
+
+                prvFreeBlock( ( BlockLink_t * ) ( ( ( uint8_t * ) pxCache ) - xHeapStructSize ) );
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvEmptyTaskCache( HeapTaskCache_t * pxCache ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxBlock;
+        UBaseType_t uxClass;
+
+        for( uxClass = 0; uxClass < ( UBaseType_t ) configHEAP_TASK_CACHE_SIZE_CLASSES; uxClass++ )
+        {
+            while( pxCache->xMagazines[ uxClass ].pxFirstBlock != heapCACHE_LIST_END )
+            {
+                pxBlock = pxCache->xMagazines[ uxClass ].pxFirstBlock;
+                pxCache->xMagazines[ uxClass ].pxFirstBlock = pxBlock->pxNextFreeBlock;
+                pxBlock->pxNextFreeBlock = NULL;
+                prvFreeBlock( pxBlock );
+            }
+
+            pxCache->xMagazines[ uxClass ].xNumberOfBlocks = 0;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvFlushTaskCaches( void ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTaskCache_t * pxCache;
+        BaseType_t xFlushed = pdFALSE;
+        BaseType_t xSkip;
+        UBaseType_t uxClass;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+            TaskHandle_t xCallingTask = xTaskGetCurrentTaskHandle();
+            BaseType_t xCoreID;
+        #endif
+
+        for( pxCache = pxTaskCaches; pxCache != NULL; pxCache = pxCache->pxNext )
+        {
+            /* A task that was switched out part way through taking a block
+             * from or returning a block to its cache cannot run again until
+             * the scheduler is resumed, and has xInUse set. */
+            xSkip = pxCache->xInUse;
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* A task running on another core can set xInUse at any time,
+                 * so its cache is left alone. */
+                if( pxCache->xOwner != xCallingTask )
+                {
+                    for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                    {
+                        if( xTaskGetCurrentTaskHandleForCore( xCoreID ) == pxCache->xOwner )
+                        {
+                            xSkip = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configNUMBER_OF_CORES > 1 */
+
+            if( xSkip == pdFALSE )
+            {
+                for( uxClass = 0; uxClass < ( UBaseType_t ) configHEAP_TASK_CACHE_SIZE_CLASSES; uxClass++ )
+                {
+                    if( pxCache->xMagazines[ uxClass ].xNumberOfBlocks > 0U )
+                    {
+                        xFlushed = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                prvEmptyTaskCache( pxCache );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xFlushed;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapTaskCacheStats( HeapTaskCacheStats_t * pxCacheStats )
+    {
+        HeapTaskCache_t * pxCache;
+        UBaseType_t uxClass;
+
+        pxCacheStats->xNumberOfTaskCaches = 0;
+        pxCacheStats->xNumberOfCachedBlocks = 0;
+
+        vTaskSuspendAll();
+        {
+            pxCacheStats->xNumberOfCacheHits = xReleasedCacheHits;
+            pxCacheStats->xNumberOfCacheMisses = xReleasedCacheMisses;
+
+            /* The counts of each cache are only written by its own task, so
+             * they may be a little behind when read from another task. */
+            for( pxCache = pxTaskCaches; pxCache != NULL; pxCache = pxCache->pxNext )
+            {
+                pxCacheStats->xNumberOfTaskCaches++;
+                pxCacheStats->xNumberOfCacheHits += pxCache->xCacheHits;
+                pxCacheStats->xNumberOfCacheMisses += pxCache->xCacheMisses;
+
+                for( uxClass = 0; uxClass < ( UBaseType_t ) configHEAP_TASK_CACHE_SIZE_CLASSES; uxClass++ )
+                {
+                    pxCacheStats->xNumberOfCachedBlocks += pxCache->xMagazines[ uxClass ].xNumberOfBlocks;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* configUSE_HEAP_TASK_CACHE */
+/*-----------------------------------------------------------*/
@@ -0,0 +1,897 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that uses a two
+ * level segregated fit (TLSF) allocator, so both functions execute in constant
+ * time however fragmented the heap becomes.  As with heap_5.c the heap can be
+ * defined across multiple non-contiguous blocks of memory, and adjacent memory
+ * blocks are combined (coalesced) as they are freed.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ *
+ * Free blocks are held in one of a matrix of lists.  The first level index is
+ * the power of two size class of the block, and the second level index divides
+ * each power of two range into 2^configHEAP_TLSF_SECOND_LEVEL_BITS linear
+ * steps.  A bitmap records which lists are not empty, so the list holding a
+ * block that is large enough for a request is found with two find first set
+ * bit operations rather than by walking the free list as heap_4.c and heap_5.c
+ * do.  Each block also records the block in front of it in memory, so a block
+ * being freed is merged with its neighbours without searching.
+ *
+ * The price is a larger fixed data structure - one list head per first and
+ * second level combination - and allocations being rounded up to the next
+ * second level step when the free lists are searched.
+ *
+ * configHEAP_TLSF_SECOND_LEVEL_BITS sets the number of second level lists per
+ * power of two (default 4, so 16 lists).  configHEAP_TLSF_MAX_BLOCK_SIZE_BITS
+ * sets the largest block that can be managed to 2^n bytes (default 24, so
+ * 16MB).  Lower values reduce the size of the list head matrix.  Only the
+ * first 2^n bytes of a larger heap region are used.
+ *
+ * Usage notes:
+ *
+ * vPortDefineHeapRegions() ***must*** be called before pvPortMalloc().
+ * pvPortMalloc() will be called if any task objects (tasks, queues, event
+ * groups, etc.) are created, therefore vPortDefineHeapRegions() ***must*** be
+ * called before any other objects are defined.
+ *
+ * vPortDefineHeapRegions() takes a single parameter.  The parameter is an array
+ * of HeapRegion_t structures.  HeapRegion_t is defined in portable.h as
+ *
+ * typedef struct HeapRegion
+ * {
+ *  uint8_t *pucStartAddress; << Start address of a block of memory that will be part of the heap.
+ *  size_t xSizeInBytes;      << Size of the block of memory.
+ * } HeapRegion_t;
+ *
+ * The array is terminated using a NULL zero sized region definition, and the
+ * memory regions defined in the array ***must*** appear in address order from
+ * low address to high address.  So the following is a valid example of how
+ * to use the function.
+ *
+ * HeapRegion_t xHeapRegions[] =
+ * {
+ *  { ( uint8_t * ) 0x80000000UL, 0x10000 }, << Defines a block of 0x10000 bytes starting at address 0x80000000
+ *  { ( uint8_t * ) 0x90000000UL, 0xa0000 }, << Defines a block of 0xa0000 bytes starting at address of 0x90000000
+ *  { NULL, 0 }                << Terminates the array.
+ * };
+ *
+ * vPortDefineHeapRegions( xHeapRegions ); << Pass the array into vPortDefineHeapRegions().
+ *
+ * Note 0x80000000 is the lower address so appears in the array first.
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+#ifndef configHEAP_TLSF_SECOND_LEVEL_BITS
+    #define configHEAP_TLSF_SECOND_LEVEL_BITS    4
+#endif
+
+#ifndef configHEAP_TLSF_MAX_BLOCK_SIZE_BITS
+    #define configHEAP_TLSF_MAX_BLOCK_SIZE_BITS    24
+#endif
+
+/* The number of low address bits that are always zero in a block size. */
+#if portBYTE_ALIGNMENT == 32
+    #define heapALIGNMENT_BITS    ( 5 )
+#elif portBYTE_ALIGNMENT == 16
+    #define heapALIGNMENT_BITS    ( 4 )
+#elif portBYTE_ALIGNMENT == 8
+    #define heapALIGNMENT_BITS    ( 3 )
+#elif portBYTE_ALIGNMENT == 4
+    #define heapALIGNMENT_BITS    ( 2 )
+#elif portBYTE_ALIGNMENT == 2
+    #define heapALIGNMENT_BITS    ( 1 )
+#elif portBYTE_ALIGNMENT == 1
+    #define heapALIGNMENT_BITS    ( 0 )
+#else
+    #error "Invalid portBYTE_ALIGNMENT definition"
+#endif
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE all have a first level index of 0
+ * and are spread linearly across its second level lists, one list per
+ * portBYTE_ALIGNMENT bytes.  Larger blocks have a first level index of one more
+ * than the position of their most significant bit above heapFIRST_LEVEL_SHIFT. */
+#define heapSECOND_LEVEL_COUNT    ( 1U << configHEAP_TLSF_SECOND_LEVEL_BITS )
+#define heapFIRST_LEVEL_SHIFT     ( configHEAP_TLSF_SECOND_LEVEL_BITS + heapALIGNMENT_BITS )
+#define heapFIRST_LEVEL_COUNT     ( configHEAP_TLSF_MAX_BLOCK_SIZE_BITS - heapFIRST_LEVEL_SHIFT + 1 )
+#define heapSMALL_BLOCK_SIZE      ( ( size_t ) 1 << heapFIRST_LEVEL_SHIFT )
+#define heapMAXIMUM_BLOCK_SIZE    ( ( ( size_t ) 1 << configHEAP_TLSF_MAX_BLOCK_SIZE_BITS ) - ( size_t ) portBYTE_ALIGNMENT )
+
+#if ( configHEAP_TLSF_SECOND_LEVEL_BITS < 1 ) || ( configHEAP_TLSF_SECOND_LEVEL_BITS > 5 )
+    #error configHEAP_TLSF_SECOND_LEVEL_BITS must be between 1 and 5
+#endif
+
+#if ( heapFIRST_LEVEL_COUNT < 2 ) || ( heapFIRST_LEVEL_COUNT > 31 )
+    #error configHEAP_TLSF_MAX_BLOCK_SIZE_BITS is out of range for the configured second level bits and alignment
+#endif
+
+#if ( configHEAP_TLSF_MAX_BLOCK_SIZE_BITS > 31 )
+    #error configHEAP_TLSF_MAX_BLOCK_SIZE_BITS must not be greater than 31
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE( pxBlock )                ( ( pxBlock->xBlockSize ) & ~heapBLOCK_ALLOCATED_BITMASK )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* The block that follows pxBlock in memory. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )       ( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/* Use the compiler's count leading and trailing zeros builtins to search the
+ * bitmaps where they are known to be available, otherwise fall back to a table
+ * based search. */
+#if defined( __GNUC__ ) && defined( __SIZEOF_INT__ ) && ( __SIZEOF_INT__ == 4 )
+    #define heapHIGHEST_SET_BIT( ulBitmap )    ( ( UBaseType_t ) 31U - ( UBaseType_t ) __builtin_clz( ( unsigned int ) ( ulBitmap ) ) )
+    #define heapLOWEST_SET_BIT( ulBitmap )     ( ( UBaseType_t ) __builtin_ctz( ( unsigned int ) ( ulBitmap ) ) )
+#else
+    #define heapHIGHEST_SET_BIT( ulBitmap )    prvHighestSetBit( ulBitmap )
+    #define heapLOWEST_SET_BIT( ulBitmap )     prvHighestSetBit( ( ulBitmap ) & ( ~( ulBitmap ) + 1UL ) )
+    #define heapUSE_HIGHEST_SET_BIT_TABLE    1
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Every block, allocated or free, starts with the pxPreviousPhysicalBlock and
+ * xBlockSize members.  The free list links are only valid while the block is
+ * free, and occupy the start of the memory returned to the application while
+ * it is allocated. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPreviousPhysicalBlock; /*<< The block immediately before this one in memory, or NULL if this is the first block in its region. */
+    size_t xBlockSize;                             /*<< The size of the block, including this header. */
+    struct A_BLOCK_LINK * pxNextFreeBlock;         /*<< The next block in the same free list. */
+    struct A_BLOCK_LINK * pxPreviousFreeBlock;     /*<< The previous block in the same free list. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Calculates the first and second level indexes of the free list that holds
+ * blocks of size xBlockSize.
+ */
+static void prvMapBlockSize( size_t xBlockSize,
+                             UBaseType_t * puxFirstLevel,
+                             UBaseType_t * puxSecondLevel );
+
+/*
+ * Adds pxBlock to the head of the free list for its size.
+ */
+static void prvInsertFreeBlock( BlockLink_t * pxBlock );
+
+/*
+ * Removes pxBlock from the free list for its size.
+ */
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock );
+
+/*
+ * Returns a free block of at least xWantedSize bytes, or NULL if there is not
+ * one, without removing it from its free list.
+ */
+static BlockLink_t * prvFindFreeBlock( size_t xWantedSize );
+
+#if defined( heapUSE_HIGHEST_SET_BIT_TABLE )
+
+/*
+ * Returns the index of the most significant set bit in ulBitmap, which must not
+ * be zero.
+ */
+    static UBaseType_t prvHighestSetBit( uint32_t ulBitmap );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The space at the start of each block used by the pxPreviousPhysicalBlock and
+ * xBlockSize members, which must be correctly byte aligned. */
+static const size_t xHeapBlockOverhead = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Block sizes must not get too small - a free block has to hold the whole
+ * BlockLink_t structure. */
+static const size_t xHeapMinimumBlockSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The heads of the free lists, and the bitmaps that record which are not
+ * empty.  Bit n of ulFirstLevelBitmap is set while bit map
+ * ulSecondLevelBitmaps[ n ] is not zero, and bit m of ulSecondLevelBitmaps[ n ]
+ * is set while pxFreeLists[ n ][ m ] is not empty. */
+static BlockLink_t * pxFreeLists[ heapFIRST_LEVEL_COUNT ][ heapSECOND_LEVEL_COUNT ];
+static uint32_t ulSecondLevelBitmaps[ heapFIRST_LEVEL_COUNT ];
+static uint32_t ulFirstLevelBitmap = 0U;
+
+/* Set once the heap regions have been defined. */
+static BaseType_t xHeapDefined = pdFALSE;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+
+    /* The heap must be initialised before the first call to
+     * pvPortMalloc(). */
+    configASSERT( xHeapDefined != pdFALSE );
+
+    vTaskSuspendAll();
+    {
+        if( xWantedSize > 0 )
+        {
+            /* The wanted size must be increased so it can contain the block
+             * header in addition to the requested amount of bytes, and rounded
+             * up so the following block is correctly byte aligned. */
+            xAdditionalRequiredSize = xHeapBlockOverhead;
+
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                xAdditionalRequiredSize += portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xWantedSize += xAdditionalRequiredSize;
+
+                /* The block must also be big enough to hold the free list links
+                 * once it is freed. */
+                if( xWantedSize < xHeapMinimumBlockSize )
+                {
+                    xWantedSize = xHeapMinimumBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Blocks larger than heapMAXIMUM_BLOCK_SIZE cannot exist, and limiting
+         * the size here also ensures the top bit of the block size, which
+         * records who owns the block, is free. */
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= heapMAXIMUM_BLOCK_SIZE ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            pxBlock = prvFindFreeBlock( xWantedSize );
+
+            if( pxBlock != NULL )
+            {
+                /* This block is being returned for use so must be taken out
+                 * of the list of free blocks. */
+                prvRemoveFreeBlock( pxBlock );
+
+                /* If the block is larger than required it can be split into
+                 * two. */
+                if( ( heapBLOCK_SIZE( pxBlock ) - xWantedSize ) >= xHeapMinimumBlockSize )
+                {
+                    /* This block is to be split into two.  Create a new
+                     * block following the number of bytes requested. The void
+                     * cast is used to prevent byte alignment warnings from the
+                     * compiler. */
+                    pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+
+                    /* Calculate the sizes of two blocks split from the
+                     * single block, and keep the physical links up to date. */
+                    pxNewBlockLink->xBlockSize = heapBLOCK_SIZE( pxBlock ) - xWantedSize;
+                    pxNewBlockLink->pxPreviousPhysicalBlock = pxBlock;
+                    heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPreviousPhysicalBlock = pxNewBlockLink;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* Insert the new block into the list of free blocks. */
+                    prvInsertFreeBlock( pxNewBlockLink );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xFreeBytesRemaining -= heapBLOCK_SIZE( pxBlock );
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block is being returned - it is allocated and owned
+                 * by the application. */
+                heapALLOCATE_BLOCK( pxBlock );
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapBlockOverhead );
+                xNumberOfSuccessfulAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BlockLink_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have the block header immediately
+         * before it. */
+        puc -= xHeapBlockOverhead;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            /* The block is being returned to the heap - it is no longer
+             * allocated. */
+            heapFREE_BLOCK( pxLink );
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( puc + xHeapBlockOverhead, 0, heapBLOCK_SIZE( pxLink ) - xHeapBlockOverhead );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += heapBLOCK_SIZE( pxLink );
+                traceFREE( pv, heapBLOCK_SIZE( pxLink ) );
+
+                /* Merge the block with the block after it if that block is
+                 * also free.  The end of each region is marked by a zero sized
+                 * block that is never free. */
+                pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxLink );
+
+                if( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxLink->xBlockSize += pxNeighbour->xBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge the block with the block before it if that block is
+                 * also free. */
+                pxNeighbour = pxLink->pxPreviousPhysicalBlock;
+
+                if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 ) )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxNeighbour->xBlockSize += pxLink->xBlockSize;
+                    pxLink = pxNeighbour;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                heapNEXT_PHYSICAL_BLOCK( pxLink )->pxPreviousPhysicalBlock = pxLink;
+
+                /* Add the merged block to the list of free blocks. */
+                prvInsertFreeBlock( pxLink );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapBlockSize( size_t xBlockSize,
+                             UBaseType_t * puxFirstLevel,
+                             UBaseType_t * puxSecondLevel )
+{
+    UBaseType_t uxBit;
+
+    if( xBlockSize < heapSMALL_BLOCK_SIZE )
+    {
+        *puxFirstLevel = 0;
+        *puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> heapALIGNMENT_BITS );
+    }
+    else
+    {
+        /* Block sizes are limited to heapMAXIMUM_BLOCK_SIZE, so always fit in
+         * 32 bits. */
+        uxBit = heapHIGHEST_SET_BIT( ( uint32_t ) xBlockSize );
+        *puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> ( uxBit - configHEAP_TLSF_SECOND_LEVEL_BITS ) ) ^ heapSECOND_LEVEL_COUNT;
+        *puxFirstLevel = uxBit - ( heapFIRST_LEVEL_SHIFT - 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockLink_t * pxBlock )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    BlockLink_t * pxHead;
+
+    prvMapBlockSize( heapBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+
+    pxHead = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+    pxBlock->pxNextFreeBlock = pxHead;
+    pxBlock->pxPreviousFreeBlock = NULL;
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPreviousFreeBlock = pxBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+    ulFirstLevelBitmap |= ( 1UL << uxFirstLevel );
+    ulSecondLevelBitmaps[ uxFirstLevel ] |= ( 1UL << uxSecondLevel );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock->pxPreviousFreeBlock != NULL )
+    {
+        pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block is at the head of its list, so the list head must be
+         * updated, and the bitmaps too if the list is now empty. */
+        prvMapBlockSize( heapBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+        configASSERT( pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] == pxBlock );
+
+        pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+        if( pxBlock->pxNextFreeBlock == NULL )
+        {
+            ulSecondLevelBitmaps[ uxFirstLevel ] &= ~( 1UL << uxSecondLevel );
+
+            if( ulSecondLevelBitmaps[ uxFirstLevel ] == 0U )
+            {
+                ulFirstLevelBitmap &= ~( 1UL << uxFirstLevel );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvFindFreeBlock( size_t xWantedSize )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    uint32_t ulBitmap;
+    BlockLink_t * pxBlock = NULL;
+
+    /* Round the size up to the start of the next second level list so every
+     * block in the list that is found is large enough - the blocks within a
+     * list are not sorted. */
+    if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xWantedSize += ( ( size_t ) 1 << ( heapHIGHEST_SET_BIT( ( uint32_t ) xWantedSize ) - configHEAP_TLSF_SECOND_LEVEL_BITS ) ) - ( size_t ) 1;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xWantedSize <= heapMAXIMUM_BLOCK_SIZE )
+    {
+        prvMapBlockSize( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+        /* Look for a non-empty list in the same power of two range first, then
+         * in the smallest larger range that has one. */
+        ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ] & ( ~0UL << uxSecondLevel );
+
+        if( ulBitmap == 0U )
+        {
+            ulBitmap = ulFirstLevelBitmap & ( ~0UL << ( uxFirstLevel + 1U ) );
+
+            if( ulBitmap != 0U )
+            {
+                uxFirstLevel = heapLOWEST_SET_BIT( ulBitmap );
+                ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulBitmap != 0U )
+        {
+            uxSecondLevel = heapLOWEST_SET_BIT( ulBitmap );
+            pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+#if defined( heapUSE_HIGHEST_SET_BIT_TABLE )
+
+    static UBaseType_t prvHighestSetBit( uint32_t ulBitmap )
+    {
+        /* The index of the most significant set bit in each value 0 to 15. */
+        static const uint8_t ucHighestSetBitInNibble[ 16 ] = { 0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3 };
+        UBaseType_t uxBit = 0;
+
+        configASSERT( ulBitmap != 0UL );
+
+        /* Halve the range being searched until only four bits remain. */
+        if( ( ulBitmap & 0xFFFF0000UL ) != 0UL )
+        {
+            ulBitmap >>= 16;
+            uxBit += 16U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( ulBitmap & 0x0000FF00UL ) != 0UL )
+        {
+            ulBitmap >>= 8;
+            uxBit += 8U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( ulBitmap & 0x000000F0UL ) != 0UL )
+        {
+            ulBitmap >>= 4;
+            uxBit += 4U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxBit + ( UBaseType_t ) ucHighestSetBitInNibble[ ulBitmap ];
+    }
+
+#endif /* heapUSE_HIGHEST_SET_BIT_TABLE */
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+    BlockLink_t * pxFirstFreeBlockInRegion;
+    BlockLink_t * pxEndOfRegion;
+    BlockLink_t * pxPreviousEndOfRegion = NULL;
+    portPOINTER_SIZE_TYPE xAlignedHeap;
+    size_t xTotalRegionSize, xTotalHeapSize = 0;
+    BaseType_t xDefinedRegions = 0;
+    portPOINTER_SIZE_TYPE xAddress;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( xHeapDefined == pdFALSE );
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
+        if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            xAddress += ( portBYTE_ALIGNMENT - 1 );
+            xAddress &= ~portBYTE_ALIGNMENT_MASK;
+
+            /* Adjust the size for the bytes lost to alignment. */
+            xTotalRegionSize -= ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
+        }
+
+        xAlignedHeap = xAddress;
+
+        /* Check blocks are passed in with increasing start addresses. */
+        configASSERT( ( pxPreviousEndOfRegion == NULL ) || ( xAddress > ( portPOINTER_SIZE_TYPE ) pxPreviousEndOfRegion ) );
+
+        /* The end of the region is marked by a zero sized block that is
+         * permanently allocated, so blocks are never merged across the end of
+         * a region.  Only the block header is needed. */
+        xAddress = xAlignedHeap + xTotalRegionSize;
+        xAddress -= xHeapBlockOverhead;
+        xAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+        /* To start with there is a single free block in this region that is
+         * sized to take up the entire region minus the end marker.  A region
+         * larger than the largest block that can be managed is only partially
+         * used. */
+        xTotalRegionSize = ( size_t ) ( xAddress - xAlignedHeap );
+
+        if( xTotalRegionSize > heapMAXIMUM_BLOCK_SIZE )
+        {
+            xTotalRegionSize = heapMAXIMUM_BLOCK_SIZE;
+            xAddress = xAlignedHeap + xTotalRegionSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xTotalRegionSize >= xHeapMinimumBlockSize )
+        {
+            pxFirstFreeBlockInRegion = ( BlockLink_t * ) xAlignedHeap;
+            pxFirstFreeBlockInRegion->xBlockSize = xTotalRegionSize;
+            pxFirstFreeBlockInRegion->pxPreviousPhysicalBlock = NULL;
+
+            pxEndOfRegion = ( BlockLink_t * ) xAddress;
+            pxEndOfRegion->xBlockSize = 0;
+            pxEndOfRegion->pxPreviousPhysicalBlock = pxFirstFreeBlockInRegion;
+            heapALLOCATE_BLOCK( pxEndOfRegion );
+
+            prvInsertFreeBlock( pxFirstFreeBlockInRegion );
+
+            xTotalHeapSize += xTotalRegionSize;
+            pxPreviousEndOfRegion = pxEndOfRegion;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Move onto the next HeapRegion_t structure. */
+        xDefinedRegions++;
+        pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+    }
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+    xFreeBytesRemaining = xTotalHeapSize;
+    xHeapDefined = pdTRUE;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xTotalHeapSize );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    uint32_t ulFirstLevelBits, ulSecondLevelBits;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* Only the lists marked as not empty in the bitmaps are visited. */
+        ulFirstLevelBits = ulFirstLevelBitmap;
+
+        while( ulFirstLevelBits != 0U )
+        {
+            uxFirstLevel = heapLOWEST_SET_BIT( ulFirstLevelBits );
+            ulFirstLevelBits &= ~( 1UL << uxFirstLevel );
+            ulSecondLevelBits = ulSecondLevelBitmaps[ uxFirstLevel ];
+
+            while( ulSecondLevelBits != 0U )
+            {
+                uxSecondLevel = heapLOWEST_SET_BIT( ulSecondLevelBits );
+                ulSecondLevelBits &= ~( 1UL << uxSecondLevel );
+
+                for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    /* Increment the number of blocks and record the largest
+                     * and smallest blocks seen so far. */
+                    xBlocks++;
+
+                    if( pxBlock->xBlockSize > xMaxSize )
+                    {
+                        xMaxSize = pxBlock->xBlockSize;
+                    }
+
+                    if( pxBlock->xBlockSize < xMinSize )
+                    {
+                        xMinSize = pxBlock->xBlockSize;
+                    }
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_TASK_CACHE == 1 )
+
+/* Only heap_4.c implements the task caches, so a task never has one to
+ * release. */
+    void vPortReleaseTaskCache( void * pvTaskCache ) /* PRIVILEGED_FUNCTION */
+    {
+        ( void ) pvTaskCache;
+    }
+
+#endif /* configUSE_HEAP_TASK_CACHE */
+/*-----------------------------------------------------------*/
@@ -37,6 +37,12 @@
 * signaling the condition variable and then waiting on a condition variable
 * with the current thread.
 *
+* When configUSE_POSIX_FUTEX_HANDOFF is 1 (Linux only) each thread instead
+* waits on a futex word of its own.  Resuming a thread is a single atomic
+* exchange, plus one FUTEX_WAKE only if that thread is already asleep, so a
+* task switch costs one wake and one wait rather than the mutex traffic of a
+* condition variable.
+*
 * The timer interrupt uses SIGALRM and care is taken to ensure that
 * the signal handler runs only on the thread for the current task.
 *
@@ -48,11 +54,33 @@
 * stdio (printf() and friends) should be called from a single task
 * only or serialized with a FreeRTOS primitive such as a binary
 * semaphore or mutex.
+*
+* When configNUMBER_OF_CORES is greater than 1 one task thread runs for
+* each simulated core.  A core is asked to yield by sending SIG_YIELD to
+* the thread currently running on it, and the tick is handled by
+* whichever running thread receives SIGALRM.
+*
+* When configUSE_TICKLESS_IDLE is 1 the idle task stops the periodic timer
+* and sleeps in sigsuspend() until a one shot timer expires at the next
+* unblock time, or another signal (interrupt) arrives, so an idle system
+* does not wake the host on every tick.
+*
+* When configUSE_VIRTUAL_TIME is also 1 the periodic timer still runs while
+* any task can run, but a tick is only counted once the process has used a
+* tick period of CPU time since the last one, so a task is not ticked while
+* the host runs something else.  When every task is blocked the tick count
+* jumps straight to the time the next task unblocks instead of the idle task
+* sleeping until then, so a simulation that spends most of its time blocked
+* runs as fast as the host allows.  Tasks that do not block, such as idle
+* priority background tasks, keep the idle task from sleeping, so time then
+* passes as fast as the tasks use the host CPU.  Threads outside the simulation that can ready a task,
+* such as network interface threads, register with
+* vPortAddExternalEventSource().  While any are registered the idle task
+* waits for them in real time instead.
 *----------------------------------------------------------*/
-#include "portmacro.h"
-
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -65,10 +93,28 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
-#include "utils/wait_for_event.h"
+#if ( configUSE_POSIX_FUTEX_HANDOFF == 1 )
+    #ifndef __linux__
+        #error configUSE_POSIX_FUTEX_HANDOFF requires Linux
+    #endif
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#else
+    #include "utils/wait_for_event.h"
+#endif
 /*-----------------------------------------------------------*/
 
 #define SIG_RESUME    SIGUSR1
+#define SIG_YIELD     SIGUSR2
+#define SIG_WAKE      SIGURG
+
+#if ( configUSE_POSIX_FUTEX_HANDOFF == 1 )
+    /* States of a thread's handoff word. */
+    #define portHANDOFF_IDLE         ( 0U ) /* Not resumed since it last ran. */
+    #define portHANDOFF_RESUMED      ( 1U ) /* Resumed, may run when it next suspends. */
+    #define portHANDOFF_SLEEPING     ( 2U ) /* Asleep in FUTEX_WAIT, must be woken. */
+#endif
 
 typedef struct THREAD
 {
@@ -76,7 +122,14 @@ typedef struct THREAD
     pdTASK_CODE pxCode;
     void * pvParams;
     BaseType_t xDying;
-    struct event * ev;
+    #if ( configUSE_POSIX_FUTEX_HANDOFF == 1 )
+        uint32_t ulHandoff;
+    #else
+        struct event * ev;
+    #endif
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xCoreID; /* The core the thread runs on, set by the thread that resumes it. */
+    #endif
 } Thread_t;
 
 /*
@@ -96,20 +149,68 @@ static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
 static sigset_t xAllSignals;
 static sigset_t xSchedulerOriginalSignalMask;
 static pthread_t hMainThread = ( pthread_t ) NULL;
-static volatile portBASE_TYPE uxCriticalNesting;
+
+#if ( configNUMBER_OF_CORES == 1 )
+    static volatile portBASE_TYPE uxCriticalNesting;
+#else
+    volatile UBaseType_t uxPortCriticalNestings[ configNUMBER_OF_CORES ] = { 0 };
+
+/* The thread data of the calling thread, NULL for the main thread. */
+    static __thread Thread_t * pxThisThread = NULL;
+
+/* Set while the calling thread is running a signal handler. */
+    static __thread BaseType_t xInSignalHandler = pdFALSE;
+
+/* Owner core and recursion count of the task and ISR locks. */
+    static BaseType_t xLockOwners[ 2 ] = { -1, -1 };
+    static UBaseType_t uxLockCounts[ 2 ] = { 0 };
+#endif
 /*-----------------------------------------------------------*/
 
 static portBASE_TYPE xSchedulerEnd = pdFALSE;
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    /* The time of the last tick counted, and set while the idle task sleeps
+     * so the timer signal only wakes it rather than incrementing the tick. */
+    static uint64_t ullLastTickNs;
+    static volatile BaseType_t xInTicklessIdle = pdFALSE;
+    static pthread_t hSleepingThread;
+
+/* The number of threads outside the simulation that can ready a task. */
+    static volatile UBaseType_t uxExternalEventSources = 0U;
+#endif
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    #if ( configUSE_TICKLESS_IDLE != 1 )
+        #error configUSE_VIRTUAL_TIME requires configUSE_TICKLESS_IDLE to be 1
+    #endif
+    #if ( configEXPECTED_IDLE_TIME_BEFORE_SLEEP != 1 )
+        #error configUSE_VIRTUAL_TIME requires configEXPECTED_IDLE_TIME_BEFORE_SLEEP to be 1, so time advances when a task unblocks on the next tick
+    #endif
+
+/* The CPU time used by the process at the last tick counted. */
+    static uint64_t ullLastTickCpuNs;
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void );
 static void prvSetupTimerInterrupt( void );
 static void * prvWaitForStart( void * pvParams );
-static void prvSwitchThread( Thread_t * xThreadToResume,
-                             Thread_t * xThreadToSuspend );
+#if ( configNUMBER_OF_CORES == 1 )
+    static void prvSwitchThread( Thread_t * xThreadToResume,
+                                 Thread_t * xThreadToSuspend );
+#else
+    static void prvSwitchThread( Thread_t * xThreadToResume,
+                                 Thread_t * xThreadToSuspend,
+                                 BaseType_t xCoreID );
+    static void vPortYieldHandler( int sig );
+#endif
 static void prvSuspendSelf( Thread_t * thread );
 static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    static void prvWakeHandler( int sig );
+#endif
 static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
 /*-----------------------------------------------------------*/
@@ -155,19 +256,45 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
         fprintf( stderr, "[WARN] Increase the stack size to PTHREAD_STACK_MIN.\n" );
     }
 
-    thread->ev = event_create();
+    #if ( configUSE_POSIX_FUTEX_HANDOFF == 1 )
+        thread->ulHandoff = portHANDOFF_IDLE;
+    #else
+        thread->ev = event_create();
+    #endif
+
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        vPortEnterCritical();
 
-    vPortEnterCritical();
+        iRet = pthread_create( &thread->pthread, &xThreadAttributes,
+                               prvWaitForStart, thread );
 
-    iRet = pthread_create( &thread->pthread, &xThreadAttributes,
-                           prvWaitForStart, thread );
+        if( iRet != 0 )
+        {
+            prvFatalError( "pthread_create", iRet );
+        }
 
-    if( iRet != 0 )
-    {
-        prvFatalError( "pthread_create", iRet );
+        vPortExitCritical();
     }
+    #else
+    {
+        /* The new thread inherits the signal mask, so must be created with
+         * all signals blocked. */
+        portBASE_TYPE xMask = xPortSetInterruptMask();
 
-    vPortExitCritical();
+        thread->xCoreID = 0;
+
+        iRet = pthread_create( &thread->pthread, &xThreadAttributes,
+                               prvWaitForStart, thread );
+
+        if( iRet != 0 )
+        {
+            prvFatalError( "pthread_create", iRet );
+        }
+
+        vPortClearInterruptMask( xMask );
+    }
+    #endif
 
     return pxTopOfStack;
 }
@@ -175,10 +302,27 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
 
 void vPortStartFirstTask( void )
 {
-    Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-    /* Start the first task. */
-    prvResumeThread( pxFirstThread );
+        /* Start the first task. */
+        prvResumeThread( pxFirstThread );
+    }
+    #else
+    {
+        Thread_t * pxFirstThread;
+        BaseType_t xCoreID;
+
+        /* Start the first task on each core - the core's idle task. */
+        for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+        {
+            pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+            pxFirstThread->xCoreID = xCoreID;
+            prvResumeThread( pxFirstThread );
+        }
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -214,15 +358,23 @@ portBASE_TYPE xPortStartScheduler( void )
         sigwait( &xSignals, &iSignal );
     }
 
-    /* Cancel the Idle task and free its resources */
-    #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
-        vPortCancelThread( xTaskGetIdleTaskHandle() );
-    #endif
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* Cancel the Idle task and free its resources */
+        #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+            vPortCancelThread( xTaskGetIdleTaskHandle() );
+        #endif
+
+        #if ( configUSE_TIMERS == 1 )
+            /* Cancel the Timer task and free its resources */
+            vPortCancelThread( xTimerGetTimerDaemonTaskHandle() );
+        #endif /* configUSE_TIMERS */
+    }
+    #endif /* configNUMBER_OF_CORES == 1 */
 
-    #if ( configUSE_TIMERS == 1 )
-        /* Cancel the Timer task and free its resources */
-        vPortCancelThread( xTimerGetTimerDaemonTaskHandle() );
-    #endif /* configUSE_TIMERS */
+    /* With more than one core, tasks may still be running on the other
+     * cores, so their threads are left to be cleaned up when the process
+     * exits. */
 
     /* Restore original signal mask. */
     ( void ) pthread_sigmask( SIG_SETMASK, &xSchedulerOriginalSignalMask, NULL );
@@ -260,52 +412,195 @@ void vPortEndScheduler( void )
 }
 /*-----------------------------------------------------------*/
 
-void vPortEnterCritical( void )
-{
-    if( uxCriticalNesting == 0 )
+#if ( configNUMBER_OF_CORES == 1 )
+
+    void vPortEnterCritical( void )
     {
-        vPortDisableInterrupts();
+        if( uxCriticalNesting == 0 )
+        {
+            vPortDisableInterrupts();
+
+            #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+            {
+                vTaskRunTimeEnterCritical();
+            }
+            #endif
+
+            #if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+            {
+                vTaskCriticalSectionHistogramEnter( portGET_CALL_SITE() );
+            }
+            #endif
+        }
+
+        uxCriticalNesting++;
     }
+/*-----------------------------------------------------------*/
 
-    uxCriticalNesting++;
-}
+    void vPortExitCritical( void )
+    {
+        uxCriticalNesting--;
+
+        /* If we have reached 0 then re-enable the interrupts. */
+        if( uxCriticalNesting == 0 )
+        {
+            #if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+            {
+                vTaskCriticalSectionHistogramExit();
+            }
+            #endif
+
+            #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+            {
+                vTaskRunTimeExitCritical();
+            }
+            #endif
+
+            vPortEnableInterrupts();
+        }
+    }
 /*-----------------------------------------------------------*/
 
-void vPortExitCritical( void )
-{
-    uxCriticalNesting--;
+    static void prvPortYieldFromISR( void )
+    {
+        Thread_t * xThreadToSuspend;
+        Thread_t * xThreadToResume;
 
-    /* If we have reached 0 then re-enable the interrupts. */
-    if( uxCriticalNesting == 0 )
+        xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        vTaskSwitchContext();
+
+        xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        prvSwitchThread( xThreadToResume, xThreadToSuspend );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortYield( void )
     {
-        vPortEnableInterrupts();
+        vPortEnterCritical();
+
+        prvPortYieldFromISR();
+
+        vPortExitCritical();
+    }
+
+#else /* configNUMBER_OF_CORES */
+
+    static void prvPortYieldFromISR( void )
+    {
+        Thread_t * xThreadToResume;
+        BaseType_t xCoreID;
+
+        /* Signals are blocked, so the calling thread stays on this core until
+         * it switches away. */
+        xCoreID = xPortGetCoreID();
+
+        vTaskSwitchContext( xCoreID );
+
+        xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+
+        prvSwitchThread( xThreadToResume, pxThisThread, xCoreID );
     }
-}
 /*-----------------------------------------------------------*/
 
-static void prvPortYieldFromISR( void )
-{
-    Thread_t * xThreadToSuspend;
-    Thread_t * xThreadToResume;
+    void vPortYield( void )
+    {
+        portBASE_TYPE xMask = xPortSetInterruptMask();
+
+        prvPortYieldFromISR();
+
+        vPortClearInterruptMask( xMask );
+    }
+/*-----------------------------------------------------------*/
 
-    xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    static void vPortYieldHandler( int sig )
+    {
+        ( void ) sig;
 
-    vTaskSwitchContext();
+        /* Another core has asked this one to yield. */
+        xInSignalHandler = pdTRUE;
 
-    xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        prvPortYieldFromISR();
 
-    prvSwitchThread( xThreadToResume, xThreadToSuspend );
-}
+        xInSignalHandler = pdFALSE;
+    }
 /*-----------------------------------------------------------*/
 
-void vPortYield( void )
-{
-    vPortEnterCritical();
+    void vPortYieldCore( BaseType_t xCoreID )
+    {
+        Thread_t * pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
 
-    prvPortYieldFromISR();
+        /* Called with the ISR lock held, so the thread running on xCoreID
+         * cannot change before the signal is sent.  If that thread has not
+         * yet been resumed the signal stays pending until it runs. */
+        ( void ) pthread_kill( pxThread->pthread, SIG_YIELD );
+    }
+/*-----------------------------------------------------------*/
 
-    vPortExitCritical();
-}
+    BaseType_t xPortGetCoreID( void )
+    {
+        BaseType_t xCoreID = 0;
+
+        if( pxThisThread != NULL )
+        {
+            xCoreID = pxThisThread->xCoreID;
+        }
+
+        return xCoreID;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPortCheckIfInISR( void )
+    {
+        return xInSignalHandler;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetLock( BaseType_t xLock )
+    {
+        BaseType_t xCoreID = xPortGetCoreID();
+        BaseType_t xUnowned;
+
+        if( __atomic_load_n( &xLockOwners[ xLock ], __ATOMIC_RELAXED ) == xCoreID )
+        {
+            /* Already held by this core. */
+            uxLockCounts[ xLock ]++;
+        }
+        else
+        {
+            for( ; ; )
+            {
+                xUnowned = -1;
+
+                if( __atomic_compare_exchange_n( &xLockOwners[ xLock ], &xUnowned, xCoreID, pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+                {
+                    break;
+                }
+
+                /* The core holding the lock is simulated by a thread that may
+                 * need this host CPU to release it. */
+                ( void ) sched_yield();
+            }
+
+            uxLockCounts[ xLock ] = 1;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortReleaseLock( BaseType_t xLock )
+    {
+        configASSERT( xLockOwners[ xLock ] == xPortGetCoreID() );
+
+        uxLockCounts[ xLock ]--;
+
+        if( uxLockCounts[ xLock ] == 0U )
+        {
+            __atomic_store_n( &xLockOwners[ xLock ], -1, __ATOMIC_RELEASE );
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 void vPortDisableInterrupts( void )
@@ -320,17 +615,51 @@ void vPortEnableInterrupts( void )
 }
 /*-----------------------------------------------------------*/
 
+/* Interrupts are always disabled inside ISRs (signal handlers), so a single
+ * core build only has to mask signals here when a task uses the interrupt mask
+ * as well.  Within the kernel that is only the object pools, which claim slots
+ * with atomic.h.  Other builds skip the two pthread_sigmask() calls on every
+ * FromISR API call. */
+#if ( configNUMBER_OF_CORES > 1 ) || ( ( configTASK_POOL_LENGTH + configQUEUE_POOL_LENGTH + configTIMER_POOL_LENGTH + configEVENT_GROUP_POOL_LENGTH + configSTREAM_BUFFER_POOL_LENGTH ) > 0 )
+    #define portMASK_SIGNALS_FROM_ISR    1
+#else
+    #define portMASK_SIGNALS_FROM_ISR    0
+#endif
+
 portBASE_TYPE xPortSetInterruptMask( void )
 {
-    /* Interrupts are always disabled inside ISRs (signals
-     * handlers). */
-    return pdTRUE;
+    #if ( portMASK_SIGNALS_FROM_ISR == 1 )
+    {
+        sigset_t xPreviousSignals;
+
+        /* Mask the signals and return the previous state for it to be
+         * restored. */
+        ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+
+        return sigismember( &xPreviousSignals, SIGALRM ) ? pdTRUE : pdFALSE;
+    }
+    #else
+    {
+        return pdTRUE;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
 void vPortClearInterruptMask( portBASE_TYPE xMask )
 {
-    ( void ) xMask;
+    #if ( portMASK_SIGNALS_FROM_ISR == 1 )
+    {
+        if( xMask == pdFALSE )
+        {
+            vPortEnableInterrupts();
+        }
+    }
+    #else
+    {
+        ( void ) xMask;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -345,6 +674,17 @@ static uint64_t prvGetTimeNs( void )
 
 static uint64_t prvStartTimeNs;
 
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    static uint64_t prvGetCpuTimeNs( void )
+    {
+        struct timespec t;
+
+        clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &t );
+
+        return t.tv_sec * 1000000000ULL + t.tv_nsec;
+    }
+#endif
+
 /* commented as part of the code below in vPortSystemTickHandler,
  * to adjust timing according to full demo requirements */
 /* static uint64_t prvTickCount; */
@@ -383,20 +723,306 @@ void prvSetupTimerInterrupt( void )
     }
 
     prvStartTimeNs = prvGetTimeNs();
+
+    #if ( configUSE_TICKLESS_IDLE == 1 )
+        ullLastTickNs = prvStartTimeNs;
+    #endif
+
+    #if ( configUSE_VIRTUAL_TIME == 1 )
+        ullLastTickCpuNs = prvGetCpuTimeNs();
+    #endif
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/*
+ * Start the timer so it first expires ullFirstNs from now, then every
+ * ullIntervalNs - or stop it if ullFirstNs is 0.
+ */
+    static void prvArmTimer( uint64_t ullFirstNs,
+                             uint64_t ullIntervalNs )
+    {
+        struct itimerval itimer;
+        uint64_t ullFirstUs;
+
+        /* Round up, so the timer never expires before the time requested. */
+        ullFirstUs = ( ullFirstNs + 999ULL ) / 1000ULL;
+
+        itimer.it_value.tv_sec = ( time_t ) ( ullFirstUs / 1000000ULL );
+        itimer.it_value.tv_usec = ( suseconds_t ) ( ullFirstUs % 1000000ULL );
+        itimer.it_interval.tv_sec = ( time_t ) ( ullIntervalNs / 1000000000ULL );
+        itimer.it_interval.tv_usec = ( suseconds_t ) ( ( ullIntervalNs % 1000000000ULL ) / 1000ULL );
+
+        if( setitimer( ITIMER_REAL, &itimer, NULL ) == -1 )
+        {
+            prvFatalError( "setitimer", errno );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/*
+ * Stop the timer, and discard its signal if it expired while signals were
+ * blocked.  Called with signals blocked.
+ */
+    static void prvStopTimer( void )
+    {
+        const struct timespec xNoWait = { 0, 0 };
+        sigset_t xPendingSignals, xTimerSignal;
+
+        prvArmTimer( 0ULL, 0ULL );
+
+        sigemptyset( &xTimerSignal );
+        sigaddset( &xTimerSignal, SIGALRM );
+        ( void ) sigpending( &xPendingSignals );
+
+        if( sigismember( &xPendingSignals, SIGALRM ) )
+        {
+            ( void ) sigtimedwait( &xTimerSignal, NULL, &xNoWait );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/*
+ * Sleep until xExpectedIdleTime tick periods after ullFromNs, or until another
+ * signal arrives, and return the number of whole tick periods after ullFromNs
+ * that passed - never more than xExpectedIdleTime, as a
+ * task would then unblock late.  Called with signals blocked.
+ */
+    static TickType_t prvSleep( TickType_t xExpectedIdleTime,
+                                uint64_t ullFromNs,
+                                const sigset_t * pxWakeSignals )
+    {
+        const uint64_t ullTickPeriodNs = ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL;
+        uint64_t ullNowNs, ullWakeNs;
+        TickType_t xCompleteTickPeriods;
+
+        /* The timer signal only wakes this thread while it sleeps. */
+        xInTicklessIdle = pdTRUE;
+        hSleepingThread = pthread_self();
+
+        ullNowNs = prvGetTimeNs();
+        ullWakeNs = ullFromNs + ( ( uint64_t ) xExpectedIdleTime * ullTickPeriodNs );
+
+        if( ullWakeNs > ullNowNs )
+        {
+            prvArmTimer( ullWakeNs - ullNowNs, 0ULL );
+        }
+        else
+        {
+            prvArmTimer( 1ULL, 0ULL );
+        }
+
+        configPRE_SLEEP_PROCESSING( xExpectedIdleTime );
+
+        if( xExpectedIdleTime > 0 )
+        {
+            /* Returns once the timer, or any other signal, has been
+             * handled. */
+            ( void ) sigsuspend( pxWakeSignals );
+        }
+
+        configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+        /* The timer may have expired after a different signal ended the
+         * sleep. */
+        prvStopTimer();
+
+        xInTicklessIdle = pdFALSE;
+
+        xCompleteTickPeriods = ( TickType_t ) ( ( prvGetTimeNs() - ullFromNs ) / ullTickPeriodNs );
+
+        if( xCompleteTickPeriods > xExpectedIdleTime )
+        {
+            xCompleteTickPeriods = xExpectedIdleTime;
+        }
+
+        return xCompleteTickPeriods;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+        sigset_t xWakeSignals;
+        eSleepModeStatus eSleepStatus;
+        TickType_t xCompleteTickPeriods;
+
+        /* Called by the idle task with the scheduler suspended.  Keep the
+         * signal mask the task runs with, which leaves interrupts enabled, to
+         * sleep with. */
+        ( void ) pthread_sigmask( SIG_SETMASK, NULL, &xWakeSignals );
+
+        vPortEnterCritical();
+
+        if( xExpectedIdleTime > portMAX_SUPPRESSED_TICKS )
+        {
+            xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+        }
+
+        eSleepStatus = eTaskConfirmSleepModeStatus();
+
+        if( eSleepStatus == eAbortSleep )
+        {
+            /* A task was readied, or a tick pended, since the idle time was
+             * calculated, so don't sleep. */
+            vPortExitCritical();
+        }
+        else
+        {
+            const uint64_t ullTickPeriodNs = ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL;
+            uint64_t ullNowNs;
+
+            #if ( configUSE_VIRTUAL_TIME == 1 )
+                if( ( uxExternalEventSources == 0U ) && ( eSleepStatus == eStandardSleep ) )
+                {
+                    /* Every task is blocked and only a task can ready another
+                     * task, so jump straight to the time the next task
+                     * unblocks.  The next periodic tick is a whole period from
+                     * now, so the task that unblocks starts at the beginning
+                     * of its tick whatever the host was doing. */
+                    prvStopTimer();
+                    xCompleteTickPeriods = xExpectedIdleTime;
+                    ullLastTickNs = prvGetTimeNs();
+                    ullLastTickCpuNs = prvGetCpuTimeNs();
+
+                    if( ( xTaskGetTickCount() + xCompleteTickPeriods ) == portMAX_DELAY )
+                    {
+                        /* Tasks waiting for a time after the tick count
+                         * overflows are not counted in the expected idle time,
+                         * so add the tick that overflows it rather than waiting
+                         * a real tick period for it. */
+                        vTaskStepTick( xCompleteTickPeriods );
+                        ( void ) xTaskIncrementTick();
+                    }
+                    else
+                    {
+                        vTaskStepTick( xCompleteTickPeriods );
+                    }
+                }
+                else
+            #endif /* configUSE_VIRTUAL_TIME */
+            {
+                /* Replace the periodic tick with a single timer signal at the
+                 * time the next task unblocks.  With virtual time this waits
+                 * in real time for a thread outside the simulation to signal
+                 * an event, so time does not race past a timeout that is
+                 * waiting for it. */
+                xCompleteTickPeriods = prvSleep( xExpectedIdleTime, ullLastTickNs, &xWakeSignals );
+
+                ullLastTickNs += ( uint64_t ) xCompleteTickPeriods * ullTickPeriodNs;
+                vTaskStepTick( xCompleteTickPeriods );
+
+                #if ( configUSE_VIRTUAL_TIME == 1 )
+                    ullLastTickCpuNs = prvGetCpuTimeNs();
+                #endif
+            }
+
+            /* Restart the periodic tick in phase with the ticks counted. */
+            ullNowNs = prvGetTimeNs();
+
+            if( ( ullLastTickNs + ullTickPeriodNs ) > ullNowNs )
+            {
+                prvArmTimer( ullLastTickNs + ullTickPeriodNs - ullNowNs, ullTickPeriodNs );
+            }
+            else
+            {
+                prvArmTimer( 1ULL, ullTickPeriodNs );
+            }
+
+            vPortExitCritical();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWakeHandler( int sig )
+    {
+        /* Only ends sigsuspend() in prvSleep(). */
+        ( void ) sig;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortAddExternalEventSource( void )
+    {
+        ( void ) __atomic_add_fetch( &uxExternalEventSources, 1U, __ATOMIC_SEQ_CST );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortRemoveExternalEventSource( void )
+    {
+        configASSERT( uxExternalEventSources > 0U );
+        ( void ) __atomic_sub_fetch( &uxExternalEventSources, 1U, __ATOMIC_SEQ_CST );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortSignalExternalEvent( void )
+    {
+        /* If the signal arrives after the idle task stopped sleeping it is
+         * ignored, or at worst ends the next sleep early. */
+        if( xInTicklessIdle != pdFALSE )
+        {
+            ( void ) pthread_kill( hSleepingThread, SIG_WAKE );
+        }
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES == 1 )
+
 static void vPortSystemTickHandler( int sig )
 {
     Thread_t * pxThreadToSuspend;
     Thread_t * pxThreadToResume;
 
+    #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        UBaseType_t uxPreviousRunTimeContext;
+    #endif
+
     ( void ) sig;
 
 /* uint64_t xExpectedTicks; */
 
+    #if ( configUSE_TICKLESS_IDLE == 1 )
+    {
+        if( xInTicklessIdle != pdFALSE )
+        {
+            /* The one shot timer ending a tickless sleep.  The ticks that
+             * passed are stepped by vPortSuppressTicksAndSleep(). */
+            return;
+        }
+
+        /* Keep the time of the last tick on the tick period grid, however late
+         * the signal was handled. */
+        uint64_t ullNowNs = prvGetTimeNs();
+
+        ullLastTickNs = ullNowNs - ( ( ullNowNs - ullLastTickNs ) % ( ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL ) );
+    }
+    #endif
+
+    #if ( configUSE_VIRTUAL_TIME == 1 )
+    {
+        /* Only count the tick once the tasks have run for a tick period, so
+         * ticks do not land in a different place in a burst of task activity
+         * each run because the host ran something else in the middle of it. */
+        uint64_t ullCpuNs = prvGetCpuTimeNs();
+
+        if( ( ullCpuNs - ullLastTickCpuNs ) < ( ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL ) )
+        {
+            return;
+        }
+
+        ullLastTickCpuNs = ullCpuNs - ( ( ullCpuNs - ullLastTickCpuNs ) % ( ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL ) );
+    }
+    #endif
+
     uxCriticalNesting++; /* Signals are blocked in this signal handler. */
 
+    #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        /* The tick is reported as interrupt 0.  If the tick switches tasks the
+         * task switched out resumes here and exits the interrupt below. */
+        uxPreviousRunTimeContext = uxTaskRunTimeEnterISR( 0 );
+    #endif
+
     #if ( configUSE_PREEMPTION == 1 )
         pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
     #endif
@@ -424,8 +1050,41 @@ static void vPortSystemTickHandler( int sig )
         prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
     #endif
 
+    #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        vTaskRunTimeExitISR( uxPreviousRunTimeContext );
+    #endif
+
     uxCriticalNesting--;
 }
+
+#else /* configNUMBER_OF_CORES */
+
+static void vPortSystemTickHandler( int sig )
+{
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xSwitchRequired;
+
+    ( void ) sig;
+
+    /* The tick is handled by whichever core's thread received the signal.
+     * xTaskIncrementTick() asks the other cores to yield if it needs to. */
+    xInSignalHandler = pdTRUE;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        xSwitchRequired = xTaskIncrementTick();
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    if( xSwitchRequired != pdFALSE )
+    {
+        prvPortYieldFromISR();
+    }
+
+    xInSignalHandler = pdFALSE;
+}
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 void vPortThreadDying( void * pxTaskToDelete,
@@ -446,8 +1105,13 @@ void vPortCancelThread( void * pxTaskToDelete )
      * The thread has already been suspended so it can be safely cancelled.
      */
     pthread_cancel( pxThreadToCancel->pthread );
+    #if ( configUSE_POSIX_FUTEX_HANDOFF == 1 )
+        prvResumeThread( pxThreadToCancel );
+    #endif
     pthread_join( pxThreadToCancel->pthread, NULL );
-    event_delete( pxThreadToCancel->ev );
+    #if ( configUSE_POSIX_FUTEX_HANDOFF == 0 )
+        event_delete( pxThreadToCancel->ev );
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -455,10 +1119,16 @@ static void * prvWaitForStart( void * pvParams )
 {
     Thread_t * pxThread = pvParams;
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        pxThisThread = pxThread;
+    #endif
+
     prvSuspendSelf( pxThread );
 
     /* Resumed for the first time, unblocks all signals. */
-    uxCriticalNesting = 0;
+    #if ( configNUMBER_OF_CORES == 1 )
+        uxCriticalNesting = 0;
+    #endif
     vPortEnableInterrupts();
 
     /* Call the task's entry point. */
@@ -475,6 +1145,8 @@ static void * prvWaitForStart( void * pvParams )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 static void prvSwitchThread( Thread_t * pxThreadToResume,
                              Thread_t * pxThreadToSuspend )
 {
@@ -503,6 +1175,37 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
         uxCriticalNesting = uxSavedCriticalNesting;
     }
 }
+
+#else /* configNUMBER_OF_CORES */
+
+static void prvSwitchThread( Thread_t * pxThreadToResume,
+                             Thread_t * pxThreadToSuspend,
+                             BaseType_t xCoreID )
+{
+    if( pxThreadToSuspend != pxThreadToResume )
+    {
+        /*
+         * Switch tasks.
+         *
+         * The scheduler locks have been released, so another core may select
+         * the suspending thread and resume it before it has suspended itself
+         * - in which case prvSuspendSelf() returns straight away.  Only the
+         * thread being resumed and the suspending thread's own event are
+         * touched from here on.
+         */
+        pxThreadToResume->xCoreID = xCoreID;
+        prvResumeThread( pxThreadToResume );
+
+        if( pxThreadToSuspend->xDying == pdTRUE )
+        {
+            pthread_exit( NULL );
+        }
+
+        prvSuspendSelf( pxThreadToSuspend );
+    }
+}
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 static void prvSuspendSelf( Thread_t * thread )
@@ -520,7 +1223,41 @@ static void prvSuspendSelf( Thread_t * thread )
      *
      * - A thread with all signals blocked with pthread_sigmask().
      */
-    event_wait( thread->ev );
+    #if ( configUSE_POSIX_FUTEX_HANDOFF == 1 )
+    {
+        uint32_t ulState;
+
+        for( ; ; )
+        {
+            /* Consume a resume that arrived before, or while, sleeping. */
+            ulState = __atomic_exchange_n( &thread->ulHandoff, portHANDOFF_IDLE, __ATOMIC_ACQUIRE );
+
+            /* A futex wait is not a cancellation point, so vPortCancelThread()
+             * resumes the thread after cancelling it. */
+            pthread_testcancel();
+
+            if( ulState == portHANDOFF_RESUMED )
+            {
+                break;
+            }
+
+            /* Only sleep if nobody resumed the thread since the exchange.  The
+             * wait returns at once if the word is no longer SLEEPING. */
+            ulState = portHANDOFF_IDLE;
+
+            if( __atomic_compare_exchange_n( &thread->ulHandoff, &ulState, portHANDOFF_SLEEPING,
+                                             pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE ) != pdFALSE )
+            {
+                ( void ) syscall( SYS_futex, &thread->ulHandoff, FUTEX_WAIT_PRIVATE,
+                                  portHANDOFF_SLEEPING, NULL, NULL, 0 );
+            }
+        }
+    }
+    #else
+    {
+        event_wait( thread->ev );
+    }
+    #endif
 }
 
 /*-----------------------------------------------------------*/
@@ -529,7 +1266,19 @@ static void prvResumeThread( Thread_t * xThreadId )
 {
     if( pthread_self() != xThreadId->pthread )
     {
-        event_signal( xThreadId->ev );
+        #if ( configUSE_POSIX_FUTEX_HANDOFF == 1 )
+        {
+            if( __atomic_exchange_n( &xThreadId->ulHandoff, portHANDOFF_RESUMED, __ATOMIC_RELEASE ) == portHANDOFF_SLEEPING )
+            {
+                ( void ) syscall( SYS_futex, &xThreadId->ulHandoff, FUTEX_WAKE_PRIVATE,
+                                  1, NULL, NULL, 0 );
+            }
+        }
+        #else
+        {
+            event_signal( xThreadId->ev );
+        }
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -569,6 +1318,40 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
     {
         prvFatalError( "sigaction", errno );
     }
+
+    #if ( configUSE_TICKLESS_IDLE == 1 )
+    {
+        struct sigaction sigwake;
+
+        sigwake.sa_flags = 0;
+        sigwake.sa_handler = prvWakeHandler;
+        sigfillset( &sigwake.sa_mask );
+
+        iRet = sigaction( SIG_WAKE, &sigwake, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        struct sigaction sigyield;
+
+        sigyield.sa_flags = 0;
+        sigyield.sa_handler = vPortYieldHandler;
+        sigfillset( &sigyield.sa_mask );
+
+        iRet = sigaction( SIG_YIELD, &sigyield, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -581,3 +1364,15 @@ unsigned long ulPortGetRunTime( void )
     return ( unsigned long ) xTimes.tms_utime;
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+
+    uint32_t ulPortGetCriticalSectionTimestamp( void )
+    {
+        /* Wraps every four seconds, which only limits the longest section
+         * that can be measured. */
+        return ( uint32_t ) prvGetTimeNs();
+    }
+
+#endif
+/*-----------------------------------------------------------*/
@@ -73,6 +73,7 @@ typedef unsigned long TickType_t;
 #define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
 #define portTICK_RATE_MICROSECONDS	( ( portTickType ) 1000000 / configTICK_RATE_HZ )
 #define portBYTE_ALIGNMENT			8
+#define portFORCE_INLINE			inline __attribute__( ( always_inline ) )
 /*-----------------------------------------------------------*/
 
 /* Scheduler utilities. */
@@ -99,8 +100,58 @@ extern void vPortExitCritical( void );
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
 #define portDISABLE_INTERRUPTS()				portSET_INTERRUPT_MASK()
 #define portENABLE_INTERRUPTS()					portCLEAR_INTERRUPT_MASK()
-#define portENTER_CRITICAL()					vPortEnterCritical()
-#define portEXIT_CRITICAL()						vPortExitCritical()
+#if ( configNUMBER_OF_CORES == 1 )
+	#define portENTER_CRITICAL()				vPortEnterCritical()
+	#define portEXIT_CRITICAL()					vPortExitCritical()
+#else
+	extern void vTaskEnterCritical( void );
+	extern void vTaskExitCritical( void );
+	#define portENTER_CRITICAL()				vTaskEnterCritical()
+	#define portEXIT_CRITICAL()					vTaskExitCritical()
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* Multiple core support.  Each core is simulated by whichever task thread is
+ * currently running on it, so the core ID is a property of the running
+ * thread. */
+extern BaseType_t xPortGetCoreID( void );
+extern void vPortYieldCore( BaseType_t xCoreID );
+extern BaseType_t xPortCheckIfInISR( void );
+
+#define portGET_CORE_ID()						xPortGetCoreID()
+#define portYIELD_CORE( xCoreID )				vPortYieldCore( xCoreID )
+#define portCHECK_IF_IN_ISR()					xPortCheckIfInISR()
+
+/* The task and ISR locks are recursive spin locks owned by a core. */
+#define portTASK_LOCK							( 0 )
+#define portISR_LOCK							( 1 )
+
+extern void vPortGetLock( BaseType_t xLock );
+extern void vPortReleaseLock( BaseType_t xLock );
+
+#define portGET_TASK_LOCK()						vPortGetLock( portTASK_LOCK )
+#define portRELEASE_TASK_LOCK()					vPortReleaseLock( portTASK_LOCK )
+#define portGET_ISR_LOCK()						vPortGetLock( portISR_LOCK )
+#define portRELEASE_ISR_LOCK()					vPortReleaseLock( portISR_LOCK )
+
+extern UBaseType_t vTaskEnterCriticalFromISR( void );
+extern void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
+
+#define portENTER_CRITICAL_FROM_ISR()			vTaskEnterCriticalFromISR()
+#define portEXIT_CRITICAL_FROM_ISR( x )			vTaskExitCriticalFromISR( x )
+
+/* The critical nesting count is kept per core rather than per thread. */
+extern volatile UBaseType_t uxPortCriticalNestings[ configNUMBER_OF_CORES ];
+
+#define portGET_CRITICAL_NESTING_COUNT()		( uxPortCriticalNestings[ xPortGetCoreID() ] )
+#define portSET_CRITICAL_NESTING_COUNT( x )		( uxPortCriticalNestings[ xPortGetCoreID() ] = ( x ) )
+#define portINCREMENT_CRITICAL_NESTING_COUNT()	( uxPortCriticalNestings[ xPortGetCoreID() ]++ )
+#define portDECREMENT_CRITICAL_NESTING_COUNT()	( uxPortCriticalNestings[ xPortGetCoreID() ]-- )
+
+#endif /* configNUMBER_OF_CORES > 1 */
 
 /*-----------------------------------------------------------*/
 
@@ -124,9 +175,60 @@ extern void vPortCancelThread( void *pxTaskToDelete );
  */
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
 
+#ifndef configUSE_VIRTUAL_TIME
+	#define configUSE_VIRTUAL_TIME				0
+#endif
+
+/* Hand the host CPU from one task thread to the next with a futex instead of a
+ * mutex and condition variable.  Linux only. */
+#ifndef configUSE_POSIX_FUTEX_HANDOFF
+	#define configUSE_POSIX_FUTEX_HANDOFF		0
+#endif
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/* Tickless idle.  The longest sleep is limited so the timer values stay in
+ * range. */
+#define portMAX_SUPPRESSED_TICKS				( ( TickType_t ) 3600 * configTICK_RATE_HZ )
+
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+
+/* With virtual time the tick count jumps as soon as every task is blocked,
+ * including when the next task unblocks on the next tick. */
+#if ( configUSE_VIRTUAL_TIME == 1 )
+	#define portMIN_EXPECTED_IDLE_TIME_BEFORE_SLEEP		1
+#endif
+
+/* Threads that are not tasks, but can ready a task - for example by calling
+ * xMessageBufferSendFromISR() - register as external event sources while they
+ * run, and signal an external event after readying a task so the idle task
+ * stops sleeping. */
+extern void vPortAddExternalEventSource( void );
+extern void vPortRemoveExternalEventSource( void );
+extern void vPortSignalExternalEvent( void );
+#define portADD_EXTERNAL_EVENT_SOURCE()			vPortAddExternalEventSource()
+#define portREMOVE_EXTERNAL_EVENT_SOURCE()		vPortRemoveExternalEventSource()
+#define portSIGNAL_EXTERNAL_EVENT()				vPortSignalExternalEvent()
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+/* The default run time clock is the process's user time, in clock ticks.  It
+ * is coarse, so FreeRTOSConfig.h can provide a finer grained clock instead. */
 extern unsigned long ulPortGetRunTime( void );
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() /* no-op */
-#define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTime()
+#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() /* no-op */
+#endif
+#ifndef portGET_RUN_TIME_COUNTER_VALUE
+	#define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTime()
+#endif
+
+/* Critical section histograms are timed in nanoseconds, and call sites are
+ * identified by return address. */
+extern uint32_t ulPortGetCriticalSectionTimestamp( void );
+#define portCRITICAL_SECTION_TIMESTAMP()         ulPortGetCriticalSectionTimestamp()
+#define portGET_CALL_SITE()                      __builtin_return_address( 0 )
 
 #ifdef __cplusplus
 }
@@ -122,10 +122,55 @@
     extern void vPortEnableInterrupts();
     #define portENABLE_INTERRUPTS()                   vPortEnableInterrupts()
 
-    extern void vPortEnterCritical( void );
-    extern void vPortExitCritical( void );
-    #define portENTER_CRITICAL()                      vPortEnterCritical()
-    #define portEXIT_CRITICAL()                       vPortExitCritical()
+    #if ( configNUMBER_OF_CORES == 1 )
+        extern void vPortEnterCritical( void );
+        extern void vPortExitCritical( void );
+        #define portENTER_CRITICAL()                  vPortEnterCritical()
+        #define portEXIT_CRITICAL()                   vPortExitCritical()
+    #else
+        extern void vTaskEnterCritical( void );
+        extern void vTaskExitCritical( void );
+        #define portENTER_CRITICAL()                  vTaskEnterCritical()
+        #define portEXIT_CRITICAL()                   vTaskExitCritical()
+    #endif
+
+/*-----------------------------------------------------------*/
+
+/* Multiple core support.  Both RP2040 cores run tasks; a core is asked to
+ * reschedule by writing to its inter-core FIFO. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        extern void vPortYieldCore( BaseType_t xCoreID );
+
+        #define portGET_CORE_ID()                     ( ( BaseType_t ) get_core_num() )
+        #define portYIELD_CORE( xCoreID )             vPortYieldCore( xCoreID )
+
+/* The task and ISR locks are recursive locks built on two of the RP2040
+ * hardware spin locks - see configSMP_SPINLOCK_0 and configSMP_SPINLOCK_1. */
+        #define portTASK_LOCK                         ( 0 )
+        #define portISR_LOCK                          ( 1 )
+
+        extern void vPortGetLock( BaseType_t xLock );
+        extern void vPortReleaseLock( BaseType_t xLock );
+
+        #define portGET_TASK_LOCK()                   vPortGetLock( portTASK_LOCK )
+        #define portRELEASE_TASK_LOCK()               vPortReleaseLock( portTASK_LOCK )
+        #define portGET_ISR_LOCK()                    vPortGetLock( portISR_LOCK )
+        #define portRELEASE_ISR_LOCK()                vPortReleaseLock( portISR_LOCK )
+
+        extern UBaseType_t vTaskEnterCriticalFromISR( void );
+        extern void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
+
+        #define portENTER_CRITICAL_FROM_ISR()         vTaskEnterCriticalFromISR()
+        #define portEXIT_CRITICAL_FROM_ISR( x )       vTaskExitCriticalFromISR( x )
+
+/* The critical nesting count is kept per core. */
+        extern volatile UBaseType_t uxPortCriticalNestings[ configNUMBER_OF_CORES ];
+
+        #define portGET_CRITICAL_NESTING_COUNT()          ( uxPortCriticalNestings[ get_core_num() ] )
+        #define portSET_CRITICAL_NESTING_COUNT( x )       ( uxPortCriticalNestings[ get_core_num() ] = ( x ) )
+        #define portINCREMENT_CRITICAL_NESTING_COUNT()    ( uxPortCriticalNestings[ get_core_num() ]++ )
+        #define portDECREMENT_CRITICAL_NESTING_COUNT()    ( uxPortCriticalNestings[ get_core_num() ]-- )
+    #endif /* configNUMBER_OF_CORES > 1 */
 
 /*-----------------------------------------------------------*/
 
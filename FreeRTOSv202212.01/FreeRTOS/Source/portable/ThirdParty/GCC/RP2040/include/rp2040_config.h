@@ -63,6 +63,17 @@ extern "C" {
     #endif
 #endif
 
+/* configSMP_SPINLOCK_0 and configSMP_SPINLOCK_1 are the hardware spin locks
+ * that back the kernel task and ISR locks when configNUMBER_OF_CORES is 2
+ */
+#ifndef configSMP_SPINLOCK_0
+    #define configSMP_SPINLOCK_0 PICO_SPINLOCK_ID_OS1
+#endif
+
+#ifndef configSMP_SPINLOCK_1
+    #define configSMP_SPINLOCK_1 PICO_SPINLOCK_ID_OS2
+#endif
+
 #ifdef __cplusplus
 };
 #endif
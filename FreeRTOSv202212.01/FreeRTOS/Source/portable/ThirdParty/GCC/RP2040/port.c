@@ -46,6 +46,22 @@
     #include "pico/multicore.h"
 #endif /* LIB_PICO_MULTICORE */
 
+#if ( configNUMBER_OF_CORES > 1 )
+    #if ( LIB_PICO_MULTICORE != 1 )
+        #error The application must link with pico_multicore when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configNUMBER_OF_CORES != 2 )
+        #error The RP2040 has two cores, so configNUMBER_OF_CORES must be 1 or 2.
+    #endif
+
+    #if ( configSUPPORT_PICO_SYNC_INTEROP == 1 ) || ( configSUPPORT_PICO_TIME_INTEROP == 1 )
+        #error configSUPPORT_PICO_SYNC_INTEROP and configSUPPORT_PICO_TIME_INTEROP must be 0 when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #include "hardware/sync.h"
+#endif /* configNUMBER_OF_CORES */
+
 /* Constants required to manipulate the NVIC. */
 #define portNVIC_SYSTICK_CTRL_REG             ( *( ( volatile uint32_t * ) 0xe000e010 ) )
 #define portNVIC_SYSTICK_LOAD_REG             ( *( ( volatile uint32_t * ) 0xe000e014 ) )
@@ -109,10 +125,23 @@ static void prvTaskExitError( void );
 
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 /* Each task maintains its own interrupt status in the critical nesting
  * variable. This is initialized to 0 to allow vPortEnter/ExitCritical
  * to be called before the scheduler is started */
-static UBaseType_t uxCriticalNesting;
+    static UBaseType_t uxCriticalNesting;
+#else
+
+/* The kernel keeps the critical nesting count of each core here, see
+ * portGET_CRITICAL_NESTING_COUNT(). */
+    volatile UBaseType_t uxPortCriticalNestings[ configNUMBER_OF_CORES ] = { 0 };
+
+/* The core that holds each of the task and ISR locks, or -1 if the lock is
+ * free, and how many times the owning core has taken it. */
+    static volatile BaseType_t xLockOwners[ 2 ] = { -1, -1 };
+    static UBaseType_t uxLockCounts[ 2 ];
+#endif /* configNUMBER_OF_CORES */
 
 /*-----------------------------------------------------------*/
 
@@ -206,7 +235,15 @@ void vPortStartFirstTask( void )
 {
     __asm volatile (
         "   .syntax unified             \n"
+        #if ( configNUMBER_OF_CORES == 1 )
         "   ldr  r2, pxCurrentTCBConst1 \n"/* Obtain location of pxCurrentTCB. */
+        #else
+        "   ldr  r1, ulCoreIDConst1     \n"/* Read this core's ID from SIO_CPUID. */
+        "   ldr  r1, [r1]               \n"
+        "   lsls r1, r1, #2             \n"
+        "   ldr  r2, pxCurrentTCBConst1 \n"/* Obtain location of pxCurrentTCBs[ core ]. */
+        "   adds r2, r2, r1             \n"
+        #endif /* configNUMBER_OF_CORES */
         "   ldr  r3, [r2]               \n"
         "   ldr  r0, [r3]               \n"/* The first item in pxCurrentTCB is the task top of stack. */
         "   adds r0, #32                \n"/* Discard everything up to r0. */
@@ -221,7 +258,12 @@ void vPortStartFirstTask( void )
         "   cpsie i                     \n"/* The first task has its context and interrupts can be enabled. */
         "   bx   r3                     \n"/* Finally, jump to the user defined task code. */
 	"   .align 4                       \n"
+        #if ( configNUMBER_OF_CORES == 1 )
 	"pxCurrentTCBConst1: .word pxCurrentTCB\n"
+        #else
+	"pxCurrentTCBConst1: .word pxCurrentTCBs\n"
+	"ulCoreIDConst1: .word 0xd0000000\n"/* SIO_BASE + SIO_CPUID_OFFSET */
+        #endif /* configNUMBER_OF_CORES */
     );
 }
 /*-----------------------------------------------------------*/
@@ -243,42 +285,108 @@ void vPortStartFirstTask( void )
     }
 #endif
 
+#if ( configNUMBER_OF_CORES > 1 )
+    static void prvCoreYieldInterruptHandler( void )
+    {
+        /* The FIFO contents carry no information - a write from the other
+         * core is only a request for this core to reschedule. */
+        multicore_fifo_drain();
+        multicore_fifo_clear_irq();
+        portYIELD_FROM_ISR( pdTRUE );
+    }
+
+    static void prvStartSchedulerOnCore( void )
+    {
+        uint32_t irq_num;
+
+        /* Make PendSV, CallSV and SysTick the same priority as the kernel. */
+        portNVIC_SHPR3_REG |= portNVIC_PENDSV_PRI;
+        portNVIC_SHPR3_REG |= portNVIC_SYSTICK_PRI;
+
+        #if (configUSE_DYNAMIC_EXCEPTION_HANDLERS == 1)
+            exception_set_exclusive_handler( PENDSV_EXCEPTION, xPortPendSVHandler );
+            exception_set_exclusive_handler( SYSTICK_EXCEPTION, xPortSysTickHandler );
+            exception_set_exclusive_handler( SVCALL_EXCEPTION, vPortSVCHandler );
+        #endif
+
+        /* Only one core takes the tick interrupt, the kernel time slices the
+         * tasks running on the other core from it. */
+        if( portIS_FREE_RTOS_CORE() )
+        {
+            vPortSetupTimerInterrupt();
+        }
+
+        /* Writes to this core's FIFO by the other core request a context
+         * switch.  The FIFO is not drained here as a request may already be
+         * waiting in it. */
+        multicore_fifo_clear_irq();
+        irq_num = 15 + get_core_num();
+        irq_set_priority( irq_num, portMIN_INTERRUPT_PRIORITY );
+        irq_set_exclusive_handler( irq_num, prvCoreYieldInterruptHandler );
+        irq_set_enabled( irq_num, 1 );
+
+        /* Start the first task. */
+        vPortStartFirstTask();
+    }
+
+    static void prvLaunchCore1( void )
+    {
+        portDISABLE_INTERRUPTS();
+        prvStartSchedulerOnCore();
+    }
+#endif /* configNUMBER_OF_CORES > 1 */
+
 /*
  * See header file for description.
  */
 BaseType_t xPortStartScheduler( void )
 {
-    /* Make PendSV, CallSV and SysTick the same priority as the kernel. */
-    portNVIC_SHPR3_REG |= portNVIC_PENDSV_PRI;
-    portNVIC_SHPR3_REG |= portNVIC_SYSTICK_PRI;
-
-    #if (configUSE_DYNAMIC_EXCEPTION_HANDLERS == 1)
-        exception_set_exclusive_handler( PENDSV_EXCEPTION, xPortPendSVHandler );
-        exception_set_exclusive_handler( SYSTICK_EXCEPTION, xPortSysTickHandler );
-        exception_set_exclusive_handler( SVCALL_EXCEPTION, vPortSVCHandler );
-    #endif
+    #if ( configNUMBER_OF_CORES == 1 )
+        /* Make PendSV, CallSV and SysTick the same priority as the kernel. */
+        portNVIC_SHPR3_REG |= portNVIC_PENDSV_PRI;
+        portNVIC_SHPR3_REG |= portNVIC_SYSTICK_PRI;
+
+        #if (configUSE_DYNAMIC_EXCEPTION_HANDLERS == 1)
+            exception_set_exclusive_handler( PENDSV_EXCEPTION, xPortPendSVHandler );
+            exception_set_exclusive_handler( SYSTICK_EXCEPTION, xPortSysTickHandler );
+            exception_set_exclusive_handler( SVCALL_EXCEPTION, vPortSVCHandler );
+        #endif
 
-    /* Start the timer that generates the tick ISR.  Interrupts are disabled
-     * here already. */
-    vPortSetupTimerInterrupt();
-
-    /* Initialise the critical nesting count ready for the first task. */
-    uxCriticalNesting = 0;
-
-    ucLaunchCoreNum = get_core_num();
-    #if (LIB_PICO_MULTICORE == 1)
-        #if ( configSUPPORT_PICO_SYNC_INTEROP == 1)
-            multicore_fifo_clear_irq();
-            multicore_fifo_drain();
-            uint32_t irq_num = 15 + get_core_num();
-            irq_set_priority( irq_num, portMIN_INTERRUPT_PRIORITY );
-            irq_set_exclusive_handler( irq_num, prvFIFOInterruptHandler );
-            irq_set_enabled( irq_num, 1 );
+        /* Start the timer that generates the tick ISR.  Interrupts are disabled
+         * here already. */
+        vPortSetupTimerInterrupt();
+
+        /* Initialise the critical nesting count ready for the first task. */
+        uxCriticalNesting = 0;
+
+        ucLaunchCoreNum = get_core_num();
+        #if (LIB_PICO_MULTICORE == 1)
+            #if ( configSUPPORT_PICO_SYNC_INTEROP == 1)
+                multicore_fifo_clear_irq();
+                multicore_fifo_drain();
+                uint32_t irq_num = 15 + get_core_num();
+                irq_set_priority( irq_num, portMIN_INTERRUPT_PRIORITY );
+                irq_set_exclusive_handler( irq_num, prvFIFOInterruptHandler );
+                irq_set_enabled( irq_num, 1 );
+            #endif
         #endif
-    #endif
 
-    /* Start the first task. */
-    vPortStartFirstTask();
+        /* Start the first task. */
+        vPortStartFirstTask();
+    #else
+        /* The scheduler is started from core 0, which then launches core 1.
+         * Both cores already have a task selected by vTaskStartScheduler(). */
+        configASSERT( get_core_num() == 0 );
+        ucLaunchCoreNum = get_core_num();
+
+        /* No one else may use the spin locks behind the kernel locks. */
+        spin_lock_claim( configSMP_SPINLOCK_0 );
+        spin_lock_claim( configSMP_SPINLOCK_1 );
+
+        multicore_reset_core1();
+        multicore_launch_core1( prvLaunchCore1 );
+        prvStartSchedulerOnCore();
+    #endif /* configNUMBER_OF_CORES */
 
     /* Should never get here as the tasks will now be executing!  Call the task
      * exit error function to prevent compiler warnings about a static function
@@ -286,7 +394,11 @@ BaseType_t xPortStartScheduler( void )
      * functionality by defining configTASK_RETURN_ADDRESS.  Call
      * vTaskSwitchContext() so link time optimisation does not remove the
      * symbol. */
-    vTaskSwitchContext();
+    #if ( configNUMBER_OF_CORES == 1 )
+        vTaskSwitchContext();
+    #else
+        vTaskSwitchContext( portGET_CORE_ID() );
+    #endif
     prvTaskExitError();
 
     /* Should not get here! */
@@ -320,24 +432,81 @@ void vPortYield( void )
 
 /*-----------------------------------------------------------*/
 
-void vPortEnterCritical( void )
-{
-    portDISABLE_INTERRUPTS();
-    uxCriticalNesting++;
-    __asm volatile ( "dsb" ::: "memory" );
-    __asm volatile ( "isb" );
-}
+#if ( configNUMBER_OF_CORES == 1 )
+    void vPortEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+        uxCriticalNesting++;
+        __asm volatile ( "dsb" ::: "memory" );
+        __asm volatile ( "isb" );
+    }
 /*-----------------------------------------------------------*/
 
-void vPortExitCritical( void )
-{
-    configASSERT( uxCriticalNesting );
-    uxCriticalNesting--;
-    if( uxCriticalNesting == 0 )
+    void vPortExitCritical( void )
+    {
+        configASSERT( uxCriticalNesting );
+        uxCriticalNesting--;
+        if( uxCriticalNesting == 0 )
+        {
+            portENABLE_INTERRUPTS();
+        }
+    }
+#else /* configNUMBER_OF_CORES == 1 */
+    void vPortYieldCore( BaseType_t xCoreID )
     {
-        portENABLE_INTERRUPTS();
+        /* The kernel only asks the other core to yield, this core yields
+         * directly. */
+        configASSERT( xCoreID != portGET_CORE_ID() );
+
+        /* Any write to the FIFO raises the SIO interrupt on the other core.  If
+         * the FIFO is full then a request is already pending, and waiting for
+         * space could deadlock with a core spinning on a kernel lock. */
+        if( multicore_fifo_wready() )
+        {
+            multicore_fifo_push_blocking( 0 );
+        }
     }
-}
+/*-----------------------------------------------------------*/
+
+    void vPortGetLock( BaseType_t xLock )
+    {
+        BaseType_t xCoreID = portGET_CORE_ID();
+        spin_lock_t * pxSpinLock = spin_lock_instance( ( xLock == portTASK_LOCK ) ? configSMP_SPINLOCK_0 : configSMP_SPINLOCK_1 );
+
+        /* Interrupts are disabled, so only this core can set xLockOwners to its
+         * own ID. */
+        if( xLockOwners[ xLock ] == xCoreID )
+        {
+            uxLockCounts[ xLock ]++;
+        }
+        else
+        {
+            /* Reading a hardware spin lock claims it if it was free. */
+            while( *pxSpinLock == 0U )
+            {
+            }
+
+            __mem_fence_acquire();
+            xLockOwners[ xLock ] = xCoreID;
+            uxLockCounts[ xLock ] = 1U;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortReleaseLock( BaseType_t xLock )
+    {
+        configASSERT( xLockOwners[ xLock ] == portGET_CORE_ID() );
+        configASSERT( uxLockCounts[ xLock ] > 0U );
+
+        uxLockCounts[ xLock ]--;
+
+        if( uxLockCounts[ xLock ] == 0U )
+        {
+            xLockOwners[ xLock ] = -1;
+            spin_unlock_unsafe( spin_lock_instance( ( xLock == portTASK_LOCK ) ? configSMP_SPINLOCK_0 : configSMP_SPINLOCK_1 ) );
+        }
+    }
+#endif /* configNUMBER_OF_CORES == 1 */
 
 void vPortEnableInterrupts() {
     #if ( configSUPPORT_PICO_SYNC_INTEROP == 1 )
@@ -382,7 +551,15 @@ void xPortPendSVHandler( void )
         "   .syntax unified                     \n"
         "   mrs r0, psp                         \n"
         "                                       \n"
+        #if ( configNUMBER_OF_CORES == 1 )
         "   ldr r3, pxCurrentTCBConst2          \n"/* Get the location of the current TCB. */
+        #else
+        "   ldr r1, ulCoreIDConst2              \n"/* Read this core's ID from SIO_CPUID. */
+        "   ldr r1, [r1]                        \n"
+        "   lsls r1, r1, #2                     \n"
+        "   ldr r3, pxCurrentTCBConst2          \n"/* Get the location of pxCurrentTCBs[ core ]. */
+        "   adds r3, r3, r1                     \n"
+        #endif /* configNUMBER_OF_CORES */
         "   ldr r2, [r3]                        \n"
         "                                       \n"
         "   subs r0, r0, #32                    \n"/* Make space for the remaining low registers. */
@@ -418,6 +595,10 @@ void xPortPendSVHandler( void )
         #endif /* portUSE_DIVIDER_SAVE_RESTORE */
         "   push {r3, r14}                      \n"
         "   cpsid i                             \n"
+        #if ( configNUMBER_OF_CORES > 1 )
+        "   ldr r0, ulCoreIDConst2              \n"/* vTaskSwitchContext() takes the core ID. */
+        "   ldr r0, [r0]                        \n"
+        #endif /* configNUMBER_OF_CORES */
         "   bl vTaskSwitchContext               \n"
         "   cpsie i                             \n"
         "   pop {r2, r3}                        \n"/* lr goes in r3. r2 now holds tcb pointer. */
@@ -453,7 +634,12 @@ void xPortPendSVHandler( void )
         "                                       \n"
         "   bx r3                               \n"
 	"   .align 4                            \n"
+        #if ( configNUMBER_OF_CORES == 1 )
 	"pxCurrentTCBConst2: .word pxCurrentTCB \n"
+        #else
+	"pxCurrentTCBConst2: .word pxCurrentTCBs \n"
+	"ulCoreIDConst2: .word 0xd0000000       \n"/* SIO_BASE + SIO_CPUID_OFFSET */
+        #endif /* configNUMBER_OF_CORES */
     );
 }
 /*-----------------------------------------------------------*/
@@ -462,7 +648,8 @@ void xPortSysTickHandler( void )
 {
     uint32_t ulPreviousMask;
 
-    ulPreviousMask = portSET_INTERRUPT_MASK_FROM_ISR();
+    /* With more than one core the tick must also hold off the other core. */
+    ulPreviousMask = taskENTER_CRITICAL_FROM_ISR();
     {
         /* Increment the RTOS tick. */
         if( xTaskIncrementTick() != pdFALSE )
@@ -471,7 +658,7 @@ void xPortSysTickHandler( void )
             portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( ulPreviousMask );
+    taskEXIT_CRITICAL_FROM_ISR( ulPreviousMask );
 }
 /*-----------------------------------------------------------*/
 
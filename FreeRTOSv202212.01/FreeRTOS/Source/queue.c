@@ -42,6 +42,10 @@
     #include "croutine.h"
 #endif
 
+#if ( configQUEUE_POOL_LENGTH > 0 )
+    #include "object_pool.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -130,6 +134,18 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucSlotsLent; /*< Records which of the send and receive slots are currently lent to a task by the zero copy API. */
+    #endif
+
+    #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+        ListItem_t xMutexHeldListItem; /*< References the mutex from the list of mutexes held by its holder.  Owned by xTasksWaitingToReceive. */
+    #endif
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxCeilingPriority; /*< The priority a task that takes the mutex is raised to, or queueNO_CEILING_PRIORITY if the mutex uses priority inheritance. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -138,6 +154,62 @@ typedef xQUEUE Queue_t;
 
 /*-----------------------------------------------------------*/
 
+/*
+ * Admission tests for sends and receives.  When the zero copy API is in use a
+ * slot that is lent to a task is neither free nor readable until it is
+ * committed or released.  The lent send slot is always the slot at pcWriteTo,
+ * so no other item can be sent to the back of the queue until it is committed.
+ * The lent receive slot is always the slot at pcReadFrom, so no other item can
+ * be received, or sent to the front of the queue, until it is released.  An
+ * overwrite can only take place while no slot is lent.
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    #define queueSEND_SLOT_LENT       ( ( uint8_t ) 0x01U )
+    #define queueRECEIVE_SLOT_LENT    ( ( uint8_t ) 0x02U )
+
+    #define queueSLOTS_LENT( pxQueue )                                                 \
+    ( ( UBaseType_t ) ( ( ( pxQueue )->ucSlotsLent & queueSEND_SLOT_LENT ) +          \
+                        ( ( ( pxQueue )->ucSlotsLent & queueRECEIVE_SLOT_LENT ) >> 1U ) ) )
+
+    #define queueHAS_FREE_SLOT( pxQueue ) \
+    ( ( ( pxQueue )->uxMessagesWaiting + queueSLOTS_LENT( pxQueue ) ) < ( pxQueue )->uxLength )
+
+/* The lent slot that would be overwritten by a send to the given position. */
+    #define queueSLOT_IN_THE_WAY( xCopyPosition ) \
+    ( ( ( xCopyPosition ) == queueSEND_TO_FRONT ) ? queueRECEIVE_SLOT_LENT : queueSEND_SLOT_LENT )
+
+    #define queueCAN_SEND( pxQueue, xCopyPosition )                                             \
+    ( ( ( xCopyPosition ) == queueOVERWRITE ) ? ( ( pxQueue )->ucSlotsLent == ( uint8_t ) 0U ) : \
+      ( ( ( ( pxQueue )->ucSlotsLent & queueSLOT_IN_THE_WAY( xCopyPosition ) ) == ( uint8_t ) 0U ) && queueHAS_FREE_SLOT( pxQueue ) ) )
+
+    #define queueCAN_RECEIVE( pxQueue, uxMessagesWaiting ) \
+    ( ( ( uxMessagesWaiting ) > ( UBaseType_t ) 0 ) && ( ( ( pxQueue )->ucSlotsLent & queueRECEIVE_SLOT_LENT ) == ( uint8_t ) 0U ) )
+
+    #define queueIS_FULL_FOR_SEND( pxQueue, xCopyPosition )    prvIsSendSlotUnavailable( ( pxQueue ), ( xCopyPosition ) )
+    #define queueIS_EMPTY_FOR_RECEIVE( pxQueue )               prvIsReceiveSlotUnavailable( pxQueue )
+#else
+    #define queueSLOTS_LENT( pxQueue )                         ( ( UBaseType_t ) 0U )
+    #define queueCAN_SEND( pxQueue, xCopyPosition )            ( ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength ) || ( ( xCopyPosition ) == queueOVERWRITE ) )
+    #define queueCAN_RECEIVE( pxQueue, uxMessagesWaiting )     ( ( uxMessagesWaiting ) > ( UBaseType_t ) 0 )
+    #define queueIS_FULL_FOR_SEND( pxQueue, xCopyPosition )    prvIsQueueFull( pxQueue )
+    #define queueIS_EMPTY_FOR_RECEIVE( pxQueue )               prvIsQueueEmpty( pxQueue )
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
+/*
+ * A mutex that has a ceiling priority raises the task that takes it to the
+ * ceiling straight away.  No task that uses the mutex has a priority above the
+ * ceiling, so a task that has to wait for the mutex has no priority to pass on
+ * to the holder.
+ */
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+    #define queueNO_CEILING_PRIORITY                     ( ( UBaseType_t ) configMAX_PRIORITIES )
+    #define queueUSES_PRIORITY_INHERITANCE( pxQueue )    ( ( pxQueue )->uxCeilingPriority == queueNO_CEILING_PRIORITY )
+#else
+    #define queueUSES_PRIORITY_INHERITANCE( pxQueue )    ( pdTRUE )
+#endif
+
+/*-----------------------------------------------------------*/
+
 /*
  * The queue registry is just a means for kernel aware debuggers to locate
  * queue structures.  It has no other purpose so is an optional component.
@@ -165,6 +237,26 @@ typedef xQUEUE Queue_t;
 
 #endif /* configQUEUE_REGISTRY_SIZE */
 
+/*
+ * Queues that are created dynamically, and whose storage area is no larger
+ * than configQUEUE_POOL_STORAGE_SIZE bytes, are taken from a fixed pool of
+ * configQUEUE_POOL_LENGTH queues before falling back to the heap.
+ */
+#if ( configQUEUE_POOL_LENGTH > 0 )
+
+    #define queuePOOL_OBJECT_SIZE    ( sizeof( Queue_t ) + ( size_t ) configQUEUE_POOL_STORAGE_SIZE )
+
+    PRIVILEGED_DATA static uint8_t ucQueuePoolStorage[ poolSTORAGE_SIZE( configQUEUE_POOL_LENGTH, queuePOOL_OBJECT_SIZE ) ];
+    PRIVILEGED_DATA static uint32_t ulQueuePoolSlotsInUse[ poolBITMAP_WORDS( configQUEUE_POOL_LENGTH ) ];
+    PRIVILEGED_DATA static ObjectPool_t xQueuePool = { ucQueuePoolStorage, poolSLOT_SIZE( queuePOOL_OBJECT_SIZE ), configQUEUE_POOL_LENGTH, ulQueuePoolSlotsInUse };
+
+    #define queueMALLOC( xSize )    pvObjectPoolMalloc( &xQueuePool, ( xSize ) )
+    #define queueFREE( pv )         vObjectPoolFree( &xQueuePool, ( pv ) )
+#else
+    #define queueMALLOC( xSize )    pvPortMalloc( xSize )
+    #define queueFREE( pv )         vPortFree( pv )
+#endif /* configQUEUE_POOL_LENGTH */
+
 /*
  * Unlocks a queue locked by a call to prvLockQueue.  Locking a queue does not
  * prevent an ISR from adding or removing items to the queue, but does prevent
@@ -187,7 +279,36 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION
  *
  * @return pdTRUE if there is no space, otherwise pdFALSE;
  */
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+#if ( ( configUSE_QUEUE_ZERO_COPY == 0 ) || ( configUSE_CO_ROUTINES == 1 ) )
+    static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/*
+ * Uses a critical section to determine if an item could be sent to, or
+ * received from, a queue while taking lent slots into account.
+ *
+ * @return pdTRUE if the send or receive cannot take place, otherwise pdFALSE.
+ */
+    static BaseType_t prvIsSendSlotUnavailable( const Queue_t * pxQueue,
+                                                const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvIsReceiveSlotUnavailable( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Unblock the tasks that can proceed now a number of items have been added to,
+ * or removed from, a queue that is not locked - one blocked receiver (or one
+ * queue set notification) per item added and one blocked sender per item
+ * removed.
+ *
+ * @return pdTRUE if a task with a higher priority than the calling task was
+ * unblocked, otherwise pdFALSE.
+ */
+static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue,
+                                       UBaseType_t uxItemsAdded ) PRIVILEGED_FUNCTION;
+static BaseType_t prvUnblockSenders( Queue_t * const pxQueue,
+                                     UBaseType_t uxItemsRemoved ) PRIVILEGED_FUNCTION;
 
 /*
  * Copies an item into the queue, either at the front of the queue or the
@@ -231,7 +352,15 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     static void prvInitialiseMutex( Queue_t * pxNewQueue ) PRIVILEGED_FUNCTION;
 #endif
 
-#if ( configUSE_MUTEXES == 1 )
+/*
+ * Gives a newly created mutex the ceiling priority uxCeilingPriority.
+ */
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+    static void prvSetMutexCeiling( Queue_t * pxNewQueue,
+                                    const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_PRIORITY_INHERITANCE_CHAINS == 0 ) )
 
 /*
  * If a task waiting for a mutex causes the mutex holder to inherit a
@@ -315,6 +444,12 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                pxQueue->ucSlotsLent = ( uint8_t ) 0U;
+            }
+            #endif
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -453,7 +588,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
              * are greater than or equal to the pointer to char requirements the cast
              * is safe.  In other cases alignment requirements are not strict (one or
              * two bytes). */
-            pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+            pxNewQueue = ( Queue_t * ) queueMALLOC( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
 
             if( pxNewQueue != NULL )
             {
@@ -553,6 +688,29 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             /* In case this is a recursive mutex. */
             pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+            #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+            {
+                /* Mutexes use priority inheritance unless they are given a
+                 * ceiling once created. */
+                pxNewQueue->uxCeilingPriority = queueNO_CEILING_PRIORITY;
+            }
+            #endif
+
+            #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+            {
+                /* The holder's priority is calculated from the tasks waiting
+                 * for the mutexes it holds, so the list item that references
+                 * the mutex from the holder leads to those tasks. */
+                vListInitialiseItem( &( pxNewQueue->xMutexHeldListItem ) );
+                listSET_LIST_ITEM_OWNER( &( pxNewQueue->xMutexHeldListItem ), &( pxNewQueue->xTasksWaitingToReceive ) );
+
+                /* The item value is the lowest priority the holder can run at
+                 * while it holds the mutex, which is only raised above the idle
+                 * priority for a mutex that has a ceiling. */
+                listSET_LIST_ITEM_VALUE( &( pxNewQueue->xMutexHeldListItem ), ( TickType_t ) tskIDLE_PRIORITY );
+            }
+            #endif
+
             traceCREATE_MUTEX( pxNewQueue );
 
             /* Start with the semaphore in the expected state. */
@@ -604,6 +762,68 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+    static void prvSetMutexCeiling( Queue_t * pxNewQueue,
+                                    const UBaseType_t uxCeilingPriority )
+    {
+        /* The ceiling is the priority of the highest priority task that will
+         * ever take the mutex, so must be a valid priority. */
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        if( pxNewQueue != NULL )
+        {
+            pxNewQueue->uxCeilingPriority = uxCeilingPriority;
+
+            #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+            {
+                /* The holder's priority is recalculated from the mutexes it
+                 * holds, so the list item that references the mutex from the
+                 * holder also carries the ceiling. */
+                listSET_LIST_ITEM_VALUE( &( pxNewQueue->xMutexHeldListItem ), ( TickType_t ) uxCeilingPriority );
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+
+        xNewQueue = xQueueCreateMutex( queueQUEUE_TYPE_MUTEX );
+        prvSetMutexCeiling( ( Queue_t * ) xNewQueue, uxCeilingPriority );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeilingStatic( const UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+
+        xNewQueue = xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, pxStaticQueue );
+        prvSetMutexCeiling( ( Queue_t * ) xNewQueue, uxCeilingPriority );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -861,7 +1081,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
              * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+            if( queueCAN_SEND( pxQueue, xCopyPosition ) )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -1002,7 +1222,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( queueIS_FULL_FOR_SEND( pxQueue, xCopyPosition ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_SEND( pxQueue );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
@@ -1078,9 +1298,9 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
      * read, instead return a flag to say whether a context switch is required or
      * not (i.e. has a task with a higher priority than us been woken by this
      * post). */
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( queueCAN_SEND( pxQueue, xCopyPosition ) )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1203,7 +1423,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
             xReturn = errQUEUE_FULL;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1249,7 +1469,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1369,7 +1589,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
             xReturn = errQUEUE_FULL;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1408,7 +1628,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 
             /* Is there data in the queue now?  To be running the calling task
              * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            if( queueCAN_RECEIVE( pxQueue, uxMessagesWaiting ) )
             {
                 /* Data available, remove one item. */
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
@@ -1474,7 +1694,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
         {
             /* The timeout has not expired.  If the queue is still empty place
              * the task on the list of tasks waiting to receive from the queue. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            if( queueIS_EMPTY_FOR_RECEIVE( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
@@ -1504,7 +1724,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             prvUnlockQueue( pxQueue );
             ( void ) xTaskResumeAll();
 
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            if( queueIS_EMPTY_FOR_RECEIVE( pxQueue ) != pdFALSE )
             {
                 traceQUEUE_RECEIVE_FAILED( pxQueue );
                 return errQUEUE_EMPTY;
@@ -1570,7 +1790,26 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                     {
                         /* Record the information required to implement
                          * priority inheritance should it become necessary. */
-                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+                        #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+                            pxQueue->u.xSemaphore.xMutexHolder = pvTaskAddHeldMutex( &( pxQueue->xMutexHeldListItem ) );
+                        #else
+                            pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+                        #endif
+
+                        #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+                        {
+                            if( pxQueue->uxCeilingPriority != queueNO_CEILING_PRIORITY )
+                            {
+                                /* The new holder runs at the ceiling priority
+                                 * until it gives the mutex back. */
+                                vTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif
                     }
                     else
                     {
@@ -1645,11 +1884,15 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 
                 #if ( configUSE_MUTEXES == 1 )
                 {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && queueUSES_PRIORITY_INHERITANCE( pxQueue ) )
                     {
                         taskENTER_CRITICAL();
                         {
-                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                            #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+                                xInheritanceOccurred = xTaskPriorityInheritChain( &( pxQueue->u.xSemaphore.xMutexHolder ) );
+                            #else
+                                xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                            #endif
                         }
                         taskEXIT_CRITICAL();
                     }
@@ -1701,15 +1944,27 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                     {
                         taskENTER_CRITICAL();
                         {
-                            UBaseType_t uxHighestWaitingPriority;
-
-                            /* This task blocking on the mutex caused another
-                             * task to inherit this task's priority.  Now this task
-                             * has timed out the priority should be disinherited
-                             * again, but only as low as the next highest priority
-                             * task that is waiting for the same mutex. */
-                            uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
-                            vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+                            #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+                            {
+                                /* This task blocking on the mutex caused other
+                                 * tasks to inherit this task's priority.  Now this
+                                 * task has timed out their priorities are
+                                 * recalculated without it. */
+                                vTaskPriorityDisinheritChainAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder );
+                            }
+                            #else
+                            {
+                                UBaseType_t uxHighestWaitingPriority;
+
+                                /* This task blocking on the mutex caused another
+                                 * task to inherit this task's priority.  Now this task
+                                 * has timed out the priority should be disinherited
+                                 * again, but only as low as the next highest priority
+                                 * task that is waiting for the same mutex. */
+                                uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
+                                vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+                            }
+                            #endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
                         }
                         taskEXIT_CRITICAL();
                     }
@@ -1906,12 +2161,12 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
         /* Cannot block in an ISR, so check there is data available. */
-        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        if( queueCAN_RECEIVE( pxQueue, uxMessagesWaiting ) )
         {
             const int8_t cRxLock = pxQueue->cRxLock;
 
@@ -1966,7 +2221,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
             traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -2000,7 +2255,7 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         /* Cannot block in an ISR, so check there is data available. */
         if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
@@ -2021,93 +2276,922 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
             traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                const void * const pvItems,
+                                UBaseType_t uxItemCount,
+                                TickType_t xTicksToWait )
 {
-    UBaseType_t uxReturn;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+    const int8_t * pcItem = ( const int8_t * ) pvItems;
+    UBaseType_t uxItemsToSend, x;
+    const BaseType_t xCopyPosition = queueSEND_TO_BACK;
 
-    configASSERT( xQueue );
+    configASSERT( pxQueue );
+    configASSERT( pvItems );
 
-    taskENTER_CRITICAL();
+    /* Semaphores are given one at a time. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
     }
-    taskEXIT_CRITICAL();
+    #endif
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+    if( uxItemCount == ( UBaseType_t ) 0 )
+    {
+        /* There is nothing to send, so don't wait for space. */
+        xTicksToWait = ( TickType_t ) 0;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            /* Is there room for at least one item?  If so send as many items
+             * as will fit in one go. */
+            if( ( uxItemCount > ( UBaseType_t ) 0 ) && ( queueCAN_SEND( pxQueue, xCopyPosition ) ) )
+            {
+                uxItemsToSend = pxQueue->uxLength - pxQueue->uxMessagesWaiting - queueSLOTS_LENT( pxQueue );
+                uxItemsToSend = configMIN( uxItemsToSend, uxItemCount );
 
-    configASSERT( pxQueue );
+                for( x = ( UBaseType_t ) 0; x < uxItemsToSend; x++ )
+                {
+                    traceQUEUE_SEND( pxQueue );
+                    ( void ) prvCopyDataToQueue( pxQueue, pcItem, xCopyPosition );
+                    pcItem += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+                }
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
+                if( prvUnblockReceivers( pxQueue, uxItemsToSend ) != pdFALSE )
+                {
+                    /* The unblocked task has a priority higher than our own so
+                     * yield immediately. */
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+                taskEXIT_CRITICAL();
+                return uxItemsToSend;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was full and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    return ( UBaseType_t ) 0;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( queueIS_FULL_FOR_SEND( pxQueue, xCopyPosition ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            traceQUEUE_SEND_FAILED( pxQueue );
+            return ( UBaseType_t ) 0;
+        }
+    } /*lint -restore */
+}
 /*-----------------------------------------------------------*/
 
-void vQueueDelete( QueueHandle_t xQueue )
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                       const void * const pvItems,
+                                       UBaseType_t uxItemCount,
+                                       BaseType_t * const pxHigherPriorityTaskWoken )
 {
+    UBaseType_t uxItemsToSend = 0, x;
+    UBaseType_t uxSavedInterruptStatus;
     Queue_t * const pxQueue = xQueue;
+    const int8_t * pcItem = ( const int8_t * ) pvItems;
+    const BaseType_t xCopyPosition = queueSEND_TO_BACK;
 
     configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+    configASSERT( pvItems );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
-    {
-        vQueueUnregisterQueue( pxQueue );
-    }
-    #endif
+    /* See the comments in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-    {
-        /* The queue can only have been allocated dynamically - free it
-         * again. */
-        vPortFree( pxQueue );
-    }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
-        /* The queue could have been allocated statically or dynamically, so
-         * check before attempting to free the memory. */
-        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
-        {
-            vPortFree( pxQueue );
-        }
-        else
+        if( ( uxItemCount > ( UBaseType_t ) 0 ) && ( queueCAN_SEND( pxQueue, xCopyPosition ) ) )
         {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
-    {
-        /* The queue must have been statically allocated, so is not going to be
-         * deleted.  Avoid compiler warnings about the unused parameter. */
+            int8_t cTxLock = pxQueue->cTxLock;
+
+            uxItemsToSend = pxQueue->uxLength - pxQueue->uxMessagesWaiting - queueSLOTS_LENT( pxQueue );
+            uxItemsToSend = configMIN( uxItemsToSend, uxItemCount );
+
+            for( x = ( UBaseType_t ) 0; x < uxItemsToSend; x++ )
+            {
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+                ( void ) prvCopyDataToQueue( pxQueue, pcItem, xCopyPosition );
+                pcItem += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+            }
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                if( prvUnblockReceivers( pxQueue, uxItemsToSend ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Increment the lock count once per item so the task that
+                 * unlocks the queue knows how much data was posted while it was
+                 * locked. */
+                for( x = ( UBaseType_t ) 0; x < uxItemsToSend; x++ )
+                {
+                    prvIncrementQueueTxLock( pxQueue, cTxLock );
+                    cTxLock = pxQueue->cTxLock;
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxItemsToSend;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                   void * const pvBuffer,
+                                   UBaseType_t uxMaxItems,
+                                   TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+    int8_t * pcItem = ( int8_t * ) pvBuffer;
+    UBaseType_t uxItemsToReceive, x;
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+
+    /* Semaphores are taken one at a time. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    if( uxMaxItems == ( UBaseType_t ) 0 )
+    {
+        /* There is no room to receive anything, so don't wait for data. */
+        xTicksToWait = ( TickType_t ) 0;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  If so remove as many items as
+             * the buffer will hold in one go. */
+            if( ( uxMaxItems > ( UBaseType_t ) 0 ) && ( queueCAN_RECEIVE( pxQueue, uxMessagesWaiting ) ) )
+            {
+                uxItemsToReceive = configMIN( uxMessagesWaiting, uxMaxItems );
+
+                for( x = ( UBaseType_t ) 0; x < uxItemsToReceive; x++ )
+                {
+                    prvCopyDataFromQueue( pxQueue, pcItem );
+                    traceQUEUE_RECEIVE( pxQueue );
+                    pcItem += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+                }
+
+                pxQueue->uxMessagesWaiting = uxMessagesWaiting - uxItemsToReceive;
+
+                if( prvUnblockSenders( pxQueue, uxItemsToReceive ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return uxItemsToReceive;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return ( UBaseType_t ) 0;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( queueIS_EMPTY_FOR_RECEIVE( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( queueIS_EMPTY_FOR_RECEIVE( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                return ( UBaseType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                          void * const pvBuffer,
+                                          UBaseType_t uxMaxItems,
+                                          BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxItemsToReceive = 0, x;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+    int8_t * pcItem = ( int8_t * ) pvBuffer;
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* See the comments in xQueueReceiveFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        if( ( uxMaxItems > ( UBaseType_t ) 0 ) && ( queueCAN_RECEIVE( pxQueue, uxMessagesWaiting ) ) )
+        {
+            int8_t cRxLock = pxQueue->cRxLock;
+
+            uxItemsToReceive = configMIN( uxMessagesWaiting, uxMaxItems );
+
+            for( x = ( UBaseType_t ) 0; x < uxItemsToReceive; x++ )
+            {
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+                prvCopyDataFromQueue( pxQueue, pcItem );
+                pcItem += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+            }
+
+            pxQueue->uxMessagesWaiting = uxMessagesWaiting - uxItemsToReceive;
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know that an ISR has removed data while the queue was
+             * locked. */
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( prvUnblockSenders( pxQueue, uxItemsToReceive ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                for( x = ( UBaseType_t ) 0; x < uxItemsToReceive; x++ )
+                {
+                    prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    cRxLock = pxQueue->cRxLock;
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxItemsToReceive;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    void * pvQueueAcquireSendSlot( QueueHandle_t xQueue,
+                                   TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+        void * pvSlot;
+
+        /* The lent slot is always committed to the back of the queue. */
+        const BaseType_t xCopyPosition = queueSEND_TO_BACK;
+
+        configASSERT( pxQueue );
+
+        /* Semaphores have no storage area to lend. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* The slot at pcWriteTo is lent to the caller, and only becomes
+                 * part of the queue when it is committed. */
+                if( queueCAN_SEND( pxQueue, xCopyPosition ) )
+                {
+                    pxQueue->ucSlotsLent |= queueSEND_SLOT_LENT;
+                    pvSlot = pxQueue->pcWriteTo;
+
+                    taskEXIT_CRITICAL();
+                    return pvSlot;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        return NULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsSendSlotUnavailable( pxQueue, xCopyPosition ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                return NULL;
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    void vQueueCommitSendSlot( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        /* Only referenced by the trace macros. */
+        const BaseType_t xCopyPosition = queueSEND_TO_BACK;
+
+        ( void ) xCopyPosition;
+
+        configASSERT( pxQueue );
+        configASSERT( ( pxQueue->ucSlotsLent & queueSEND_SLOT_LENT ) != ( uint8_t ) 0U );
+
+        taskENTER_CRITICAL();
+        {
+            traceQUEUE_SEND( pxQueue );
+
+            /* The item was written in place, so committing it only has to
+             * move the write position on as prvCopyDataToQueue() would. */
+            pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+            if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->pcWriteTo = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxQueue->ucSlotsLent &= ( uint8_t ) ~queueSEND_SLOT_LENT;
+            pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1;
+
+            #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                if( pxQueue->pxQueueSetContainer != NULL )
+                {
+                    xYieldRequired = prvNotifyQueueSetContainer( pxQueue );
+                }
+                else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    /* If there was a task waiting for data to arrive on the
+                     * queue then unblock it now. */
+                    xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* configUSE_QUEUE_SETS */
+            {
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_QUEUE_SETS */
+
+            /* A sender may have blocked only because the send slot was lent,
+             * in which case it can now proceed if there is still space. */
+            if( ( queueHAS_FREE_SLOT( pxQueue ) ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xYieldRequired != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    void * pvQueueBorrowReceiveSlot( QueueHandle_t xQueue,
+                                     TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+        void * pvSlot;
+
+        configASSERT( pxQueue );
+
+        /* Semaphores have no storage area to lend. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904  This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+                if( queueCAN_RECEIVE( pxQueue, uxMessagesWaiting ) )
+                {
+                    /* Remove the item from the queue as prvCopyDataFromQueue()
+                     * would, but lend the slot it occupies to the caller rather
+                     * than copying out of it.  The slot cannot be reused until
+                     * it is released, so no sender is woken here. */
+                    pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                    if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+                    {
+                        pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceQUEUE_RECEIVE( pxQueue );
+                    pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+                    pxQueue->ucSlotsLent |= queueRECEIVE_SLOT_LENT;
+                    pvSlot = pxQueue->u.xQueue.pcReadFrom;
+
+                    taskEXIT_CRITICAL();
+                    return pvSlot;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        return NULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsReceiveSlotUnavailable( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsReceiveSlotUnavailable( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    void vQueueReleaseReceiveSlot( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        configASSERT( pxQueue );
+        configASSERT( ( pxQueue->ucSlotsLent & queueRECEIVE_SLOT_LENT ) != ( uint8_t ) 0U );
+
+        taskENTER_CRITICAL();
+        {
+            pxQueue->ucSlotsLent &= ( uint8_t ) ~queueRECEIVE_SLOT_LENT;
+
+            /* The slot is free again, so a task waiting to send can proceed. */
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* A receiver may have blocked only because the receive slot was
+             * lent, in which case it can now proceed if there is data. */
+            if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xYieldRequired != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    configASSERT( xQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting - queueSLOTS_LENT( pxQueue );
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    {
+        vQueueUnregisterQueue( pxQueue );
+    }
+    #endif
+
+    #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+    {
+        /* Deleting a mutex that is still held must not leave the holder's list
+         * of mutexes held referencing freed memory. */
+        if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( listLIST_ITEM_CONTAINER( &( pxQueue->xMutexHeldListItem ) ) != NULL ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                ( void ) uxListRemove( &( pxQueue->xMutexHeldListItem ) );
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The queue can only have been allocated dynamically - free it
+         * again. */
+        queueFREE( pxQueue );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        /* The queue could have been allocated statically or dynamically, so
+         * check before attempting to free the memory. */
+        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            queueFREE( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+    {
+        /* The queue must have been statically allocated, so is not going to be
+         * deleted.  Avoid compiler warnings about the unused parameter. */
         ( void ) pxQueue;
     }
     #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
@@ -2145,7 +3229,7 @@ void vQueueDelete( QueueHandle_t xQueue )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_PRIORITY_INHERITANCE_CHAINS == 0 ) )
 
     static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
     {
@@ -2190,7 +3274,11 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
             if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
             {
                 /* The mutex is no longer being held. */
-                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+                    xReturn = xTaskRemoveHeldMutex( &( pxQueue->xMutexHeldListItem ) );
+                #else
+                    xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                #endif
                 pxQueue->u.xSemaphore.xMutexHolder = NULL;
             }
             else
@@ -2276,6 +3364,81 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 }
 /*-----------------------------------------------------------*/
 
+static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue,
+                                       UBaseType_t uxItemsAdded )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+    {
+        if( pxQueue->pxQueueSetContainer != NULL )
+        {
+            /* A queue set holds one handle for each item in its member
+             * queues, and it is the queue set that receivers block on. */
+            while( uxItemsAdded > ( UBaseType_t ) 0 )
+            {
+                if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxItemsAdded--;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_QUEUE_SETS */
+
+    /* Each item added can satisfy one blocked receiver. */
+    while( ( uxItemsAdded > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+    {
+        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+        {
+            xHigherPriorityTaskWoken = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxItemsAdded--;
+    }
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockSenders( Queue_t * const pxQueue,
+                                     UBaseType_t uxItemsRemoved )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    /* Each item removed frees a space for one blocked sender. */
+    while( ( uxItemsRemoved > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+    {
+        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+        {
+            xHigherPriorityTaskWoken = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxItemsRemoved--;
+    }
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2437,25 +3600,29 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
 } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
-{
-    BaseType_t xReturn;
+#if ( ( configUSE_QUEUE_ZERO_COPY == 0 ) || ( configUSE_CO_ROUTINES == 1 ) )
 
-    taskENTER_CRITICAL();
+    static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
     {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
-        {
-            xReturn = pdTRUE;
-        }
-        else
+        BaseType_t xReturn;
+
+        taskENTER_CRITICAL();
         {
-            xReturn = pdFALSE;
+            if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
         }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
     }
-    taskEXIT_CRITICAL();
 
-    return xReturn;
-}
+#endif /* if ( ( configUSE_QUEUE_ZERO_COPY == 0 ) || ( configUSE_CO_ROUTINES == 1 ) ) */
 /*-----------------------------------------------------------*/
 
 BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
@@ -2465,7 +3632,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+    if( ( pxQueue->uxMessagesWaiting + queueSLOTS_LENT( pxQueue ) ) == pxQueue->uxLength )
     {
         xReturn = pdTRUE;
     }
@@ -2478,6 +3645,57 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static BaseType_t prvIsSendSlotUnavailable( const Queue_t * pxQueue,
+                                                const BaseType_t xCopyPosition )
+    {
+        BaseType_t xReturn;
+
+        taskENTER_CRITICAL();
+        {
+            if( queueCAN_SEND( pxQueue, xCopyPosition ) )
+            {
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static BaseType_t prvIsReceiveSlotUnavailable( const Queue_t * pxQueue )
+    {
+        BaseType_t xReturn;
+
+        taskENTER_CRITICAL();
+        {
+            if( queueCAN_RECEIVE( pxQueue, pxQueue->uxMessagesWaiting ) )
+            {
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_CO_ROUTINES == 1 )
 
     BaseType_t xQueueCRSend( QueueHandle_t xQueue,
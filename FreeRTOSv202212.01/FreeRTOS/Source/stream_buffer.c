@@ -40,6 +40,10 @@
 #include "task.h"
 #include "stream_buffer.h"
 
+#if ( configSTREAM_BUFFER_POOL_LENGTH > 0 )
+    #include "object_pool.h"
+#endif
+
 #if ( configUSE_TASK_NOTIFICATIONS != 1 )
     #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
 #endif
@@ -54,10 +58,52 @@
  * correct privileged Vs unprivileged linkage and placement. */
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
 
+/* A stream buffer has a single writer, which alone updates xHead, and a single
+ * reader, which alone updates xTail.  When configUSE_STREAM_BUFFER_LOCK_FREE is
+ * 1 the index updated by one side is read by the other with acquire semantics
+ * and written with release semantics, so the data is visible before the index
+ * that covers it - even when the writer and reader execute on different cores.
+ * Tasks register to block, and are woken, using atomic operations on the
+ * xTaskWaitingToSend and xTaskWaitingToReceive handles, rather than inside
+ * critical sections.  The macros can be defined in FreeRTOSConfig.h for
+ * compilers that do not provide the GCC __atomic builtins. */
+#if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    #ifndef sbLOAD_ACQUIRE
+        #define sbLOAD_ACQUIRE( xIndex )             __atomic_load_n( &( xIndex ), __ATOMIC_ACQUIRE )
+    #endif
+    #ifndef sbSTORE_RELEASE
+        #define sbSTORE_RELEASE( xIndex, xValue )    __atomic_store_n( &( xIndex ), ( xValue ), __ATOMIC_RELEASE )
+    #endif
+    #ifndef sbFULL_BARRIER
+        #define sbFULL_BARRIER()                     __atomic_thread_fence( __ATOMIC_SEQ_CST )
+    #endif
+    #ifndef sbEXCHANGE_TASK_HANDLE
+        #define sbEXCHANGE_TASK_HANDLE( xHandle, xNewHandle ) \
+    __atomic_exchange_n( &( xHandle ), ( xNewHandle ), __ATOMIC_SEQ_CST )
+    #endif
+#else
+    #define sbLOAD_ACQUIRE( xIndex )             ( xIndex )
+    #define sbSTORE_RELEASE( xIndex, xValue )    ( xIndex ) = ( xValue )
+#endif /* configUSE_STREAM_BUFFER_LOCK_FREE */
+
 /* If the user has not provided application specific Rx notification macros,
  * or #defined the notification macros away, then provide default implementations
  * that uses task notifications. */
 /*lint -save -e9026 Function like macros allowed and needed here so they can be overridden. */
+#if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    #ifndef sbRECEIVE_COMPLETED
+        #define sbRECEIVE_COMPLETED( pxStreamBuffer )                                                 \
+    {                                                                                                 \
+        TaskHandle_t xTaskToNotify = prvTakeWaitingTask( &( ( pxStreamBuffer )->xTaskWaitingToSend ) ); \
+                                                                                                      \
+        if( xTaskToNotify != NULL )                                                                   \
+        {                                                                                             \
+            ( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );                         \
+        }                                                                                             \
+    }
+    #endif /* sbRECEIVE_COMPLETED */
+#endif /* configUSE_STREAM_BUFFER_LOCK_FREE */
+
 #ifndef sbRECEIVE_COMPLETED
     #define sbRECEIVE_COMPLETED( pxStreamBuffer )                         \
     vTaskSuspendAll();                                                    \
@@ -92,13 +138,20 @@
     #define prvRECEIVE_COMPLETED( pxStreamBuffer )    sbRECEIVE_COMPLETED( ( pxStreamBuffer ) )
 #endif /* if ( configUSE_SB_COMPLETED_CALLBACK == 1 ) */
 
+#if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    #ifndef sbRECEIVE_COMPLETED_FROM_ISR
+        #define sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken ) \
+    ( void ) xStreamBufferReceiveCompletedFromISR( ( pxStreamBuffer ), ( pxHigherPriorityTaskWoken ) )
+    #endif
+#endif /* configUSE_STREAM_BUFFER_LOCK_FREE */
+
 #ifndef sbRECEIVE_COMPLETED_FROM_ISR
     #define sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer,                            \
                                           pxHigherPriorityTaskWoken )                \
     {                                                                                \
         UBaseType_t uxSavedInterruptStatus;                                          \
                                                                                      \
-        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();  \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();      \
         {                                                                            \
             if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                     \
             {                                                                        \
@@ -109,7 +162,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                       \
             }                                                                        \
         }                                                                            \
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                 \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                        \
     }
 #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -135,6 +188,20 @@
  * or #defined the notification macro away, then provide a default
  * implementation that uses task notifications.
  */
+#if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    #ifndef sbSEND_COMPLETED
+        #define sbSEND_COMPLETED( pxStreamBuffer )                                                       \
+    {                                                                                                    \
+        TaskHandle_t xTaskToNotify = prvTakeWaitingTask( &( ( pxStreamBuffer )->xTaskWaitingToReceive ) ); \
+                                                                                                         \
+        if( xTaskToNotify != NULL )                                                                      \
+        {                                                                                                \
+            ( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );                            \
+        }                                                                                                \
+    }
+    #endif /* sbSEND_COMPLETED */
+#endif /* configUSE_STREAM_BUFFER_LOCK_FREE */
+
 #ifndef sbSEND_COMPLETED
     #define sbSEND_COMPLETED( pxStreamBuffer )                               \
     vTaskSuspendAll();                                                       \
@@ -170,12 +237,19 @@
 #endif /* if ( configUSE_SB_COMPLETED_CALLBACK == 1 ) */
 
 
+#if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    #ifndef sbSEND_COMPLETE_FROM_ISR
+        #define sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken ) \
+    ( void ) xStreamBufferSendCompletedFromISR( ( pxStreamBuffer ), ( pxHigherPriorityTaskWoken ) )
+    #endif
+#endif /* configUSE_STREAM_BUFFER_LOCK_FREE */
+
 #ifndef sbSEND_COMPLETE_FROM_ISR
     #define sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )       \
     {                                                                                   \
         UBaseType_t uxSavedInterruptStatus;                                             \
                                                                                         \
-        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();     \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();         \
         {                                                                               \
             if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                     \
             {                                                                           \
@@ -186,7 +260,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                       \
             }                                                                           \
         }                                                                               \
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                    \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                           \
     }
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 
@@ -241,6 +315,26 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
     #endif
 } StreamBuffer_t;
 
+/* Stream buffers that are allocated dynamically, and whose storage area is no
+ * larger than configSTREAM_BUFFER_POOL_STORAGE_SIZE bytes, are taken from a
+ * fixed pool of configSTREAM_BUFFER_POOL_LENGTH stream buffers before falling
+ * back to the heap.  The storage area is one byte larger than the requested
+ * size - see xStreamBufferGenericCreate(). */
+#if ( configSTREAM_BUFFER_POOL_LENGTH > 0 )
+
+    #define sbPOOL_OBJECT_SIZE    ( sizeof( StreamBuffer_t ) + ( size_t ) configSTREAM_BUFFER_POOL_STORAGE_SIZE + ( size_t ) 1 )
+
+    PRIVILEGED_DATA static uint8_t ucStreamBufferPoolStorage[ poolSTORAGE_SIZE( configSTREAM_BUFFER_POOL_LENGTH, sbPOOL_OBJECT_SIZE ) ];
+    PRIVILEGED_DATA static uint32_t ulStreamBufferPoolSlotsInUse[ poolBITMAP_WORDS( configSTREAM_BUFFER_POOL_LENGTH ) ];
+    PRIVILEGED_DATA static ObjectPool_t xStreamBufferPool = { ucStreamBufferPoolStorage, poolSLOT_SIZE( sbPOOL_OBJECT_SIZE ), configSTREAM_BUFFER_POOL_LENGTH, ulStreamBufferPoolSlotsInUse };
+
+    #define sbMALLOC( xSize )    pvObjectPoolMalloc( &xStreamBufferPool, ( xSize ) )
+    #define sbFREE( pv )         vObjectPoolFree( &xStreamBufferPool, ( pv ) )
+#else
+    #define sbMALLOC( xSize )    pvPortMalloc( xSize )
+    #define sbFREE( pv )         vPortFree( pv )
+#endif /* configSTREAM_BUFFER_POOL_LENGTH */
+
 /*
  * The number of bytes available to be read from the buffer.
  */
@@ -287,6 +381,78 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                        size_t xSpace,
                                        size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
 
+/*
+ * Write as many of the xMessageCount messages as fit in xSpace bytes to a
+ * message buffer, or read as many messages as fit in the xBufferLengthBytes
+ * byte buffer pointed to by pvRxData, up to a maximum of xMaxMessages.  The
+ * buffer's head (or tail) is only updated once, after all the messages have
+ * been copied.  The number of messages is returned and the number of message
+ * bytes is added to *pxBytesWritten (or *pxBytesRead).
+ */
+static size_t prvWriteMessagesToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                        const void * const * ppvTxMessages,
+                                        const size_t * pxMessageLengths,
+                                        size_t xMessageCount,
+                                        size_t xSpace,
+                                        size_t * pxBytesWritten ) PRIVILEGED_FUNCTION;
+static size_t prvReadMessagesFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                         void * pvRxData,
+                                         size_t xBufferLengthBytes,
+                                         size_t * pxMessageLengths,
+                                         size_t xMaxMessages,
+                                         size_t xBytesAvailable,
+                                         size_t * pxBytesRead ) PRIVILEGED_FUNCTION;
+
+/*
+ * Describe, as up to two contiguous spans, the xCount bytes of the storage
+ * area that start at index xStart, wrapping back to the start of the storage
+ * area if necessary.  Returns xCount.
+ */
+static size_t prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+                           size_t xStart,
+                           size_t xCount,
+                           StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+/*
+ * Describe the free space (for the writer) or the data (for the reader) of a
+ * stream buffer.  For a message buffer the free space excludes the bytes
+ * needed to store the length of a message, and the data is just the next
+ * message.
+ */
+static size_t prvGetFreeSpans( StreamBuffer_t * const pxStreamBuffer,
+                               StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+static size_t prvGetDataSpans( StreamBuffer_t * const pxStreamBuffer,
+                               StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add xBytesWritten bytes written in place to the stream buffer, or remove
+ * xBytesRead bytes read in place from it, by moving the head or tail.
+ */
+static void prvCommitBytes( StreamBuffer_t * const pxStreamBuffer,
+                            size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+static void prvReleaseBytes( StreamBuffer_t * const pxStreamBuffer,
+                             size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+/*
+ * Register the calling task as the task waiting for space (or data), unless
+ * xRequiredSpace bytes are already free (or more than xBytesToStoreMessageLength
+ * bytes are already available).  Returns the space (or data) available, so the
+ * caller knows whether to block.
+ */
+static size_t prvRegisterToWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+                                         size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
+static size_t prvRegisterToWaitForData( StreamBuffer_t * const pxStreamBuffer,
+                                        size_t xBytesToStoreMessageLength ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+
+/*
+ * Atomically take the handle of the task waiting to send (or receive), if any,
+ * so it is notified exactly once.
+ */
+    static TaskHandle_t prvTakeWaitingTask( volatile TaskHandle_t * const pxWaitingTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Copies xCount bytes from the pxStreamBuffer's data storage area to pucData.
  * This function does not update the buffer's xTail pointer, so multiple reads
@@ -364,7 +530,7 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
         if( xBufferSizeBytes < ( xBufferSizeBytes + 1 + sizeof( StreamBuffer_t ) ) )
         {
             xBufferSizeBytes++;
-            pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( xBufferSizeBytes + sizeof( StreamBuffer_t ) ); /*lint !e9079 malloc() only returns void*. */
+            pucAllocatedMemory = ( uint8_t * ) sbMALLOC( xBufferSizeBytes + sizeof( StreamBuffer_t ) ); /*lint !e9079 malloc() only returns void*. */
         }
         else
         {
@@ -488,7 +654,7 @@ void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer )
         {
             /* Both the structure and the buffer were allocated using a single call
             * to pvPortMalloc(), hence only one call to vPortFree() is required. */
-            vPortFree( ( void * ) pxStreamBuffer ); /*lint !e9087 Standard free() semantics require void *, plus pxStreamBuffer was allocated by pvPortMalloc(). */
+            sbFREE( ( void * ) pxStreamBuffer ); /*lint !e9087 Standard free() semantics require void *, plus pxStreamBuffer was allocated by pvPortMalloc(). */
         }
         #else
         {
@@ -607,10 +773,10 @@ size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
      * is updated more than once between the two reads - hence the loop. */
     do
     {
-        xOriginalTail = pxStreamBuffer->xTail;
-        xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
-        xSpace -= pxStreamBuffer->xHead;
-    } while( xOriginalTail != pxStreamBuffer->xTail );
+        xOriginalTail = sbLOAD_ACQUIRE( pxStreamBuffer->xTail );
+        xSpace = pxStreamBuffer->xLength + sbLOAD_ACQUIRE( pxStreamBuffer->xTail );
+        xSpace -= sbLOAD_ACQUIRE( pxStreamBuffer->xHead );
+    } while( xOriginalTail != sbLOAD_ACQUIRE( pxStreamBuffer->xTail ) );
 
     xSpace -= ( size_t ) 1;
 
@@ -704,26 +870,16 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         {
             /* Wait until the required number of bytes are free in the message
              * buffer. */
-            taskENTER_CRITICAL();
+            xSpace = prvRegisterToWaitForSpace( pxStreamBuffer, xRequiredSpace );
+
+            if( xSpace >= xRequiredSpace )
+            {
+                break;
+            }
+            else
             {
-                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-
-                if( xSpace < xRequiredSpace )
-                {
-                    /* Clear notification state as going to wait for space. */
-                    ( void ) xTaskNotifyStateClear( NULL );
-
-                    /* Should only be one writer. */
-                    configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
-                    pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
-                }
-                else
-                {
-                    taskEXIT_CRITICAL();
-                    break;
-                }
+                mtCOVERAGE_TEST_MARKER();
             }
-            taskEXIT_CRITICAL();
 
             traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
             ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
@@ -864,7 +1020,7 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
     if( xDataLengthBytes != ( size_t ) 0 )
     {
         /* Write the data to the buffer. */
-        pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+        sbSTORE_RELEASE( pxStreamBuffer->xHead, prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead ) ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
     }
 
     return xDataLengthBytes;
@@ -898,32 +1054,8 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
 
     if( xTicksToWait != ( TickType_t ) 0 )
     {
-        /* Checking if there is data and clearing the notification state must be
-         * performed atomically. */
-        taskENTER_CRITICAL();
-        {
-            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-
-            /* If this function was invoked by a message buffer read then
-             * xBytesToStoreMessageLength holds the number of bytes used to hold
-             * the length of the next discrete message.  If this function was
-             * invoked by a stream buffer read then xBytesToStoreMessageLength will
-             * be 0. */
-            if( xBytesAvailable <= xBytesToStoreMessageLength )
-            {
-                /* Clear notification state as going to wait for data. */
-                ( void ) xTaskNotifyStateClear( NULL );
-
-                /* Should only be one reader. */
-                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
-                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        taskEXIT_CRITICAL();
+        /* Register to wait for data, unless there is already data to read. */
+        xBytesAvailable = prvRegisterToWaitForData( pxStreamBuffer, xBytesToStoreMessageLength );
 
         if( xBytesAvailable <= xBytesToStoreMessageLength )
         {
@@ -1072,32 +1204,38 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
-                                        void * pvRxData,
-                                        size_t xBufferLengthBytes,
-                                        size_t xBytesAvailable )
+size_t xStreamBufferSendMessages( StreamBufferHandle_t xStreamBuffer,
+                                  const void * const * ppvTxMessages,
+                                  const size_t * pxMessageLengths,
+                                  size_t xMessageCount,
+                                  TickType_t xTicksToWait )
 {
-    size_t xCount, xNextMessageLength;
-    configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
-    size_t xNextTail = pxStreamBuffer->xTail;
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xBytesSent = 0, xSpace = 0;
+    size_t xRequiredSpace = 0;
+    TimeOut_t xTimeOut;
 
-    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    configASSERT( ppvTxMessages );
+    configASSERT( pxMessageLengths );
+    configASSERT( pxStreamBuffer );
+
+    /* Only message buffers hold discrete messages. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+    if( xMessageCount > ( size_t ) 0 )
     {
-        /* A discrete message is being received.  First receive the length
-         * of the message. */
-        xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
-        xNextMessageLength = ( size_t ) xTempNextMessageLength;
+        /* Only wait for space for the first message - as many of the following
+         * messages as also fit are sent with it. */
+        xRequiredSpace = pxMessageLengths[ 0 ] + sbBYTES_TO_STORE_MESSAGE_LENGTH;
 
-        /* Reduce the number of bytes available by the number of bytes just
-         * read out. */
-        xBytesAvailable -= sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        /* Overflow? */
+        configASSERT( xRequiredSpace > pxMessageLengths[ 0 ] );
 
-        /* Check there is enough space in the buffer provided by the
-         * user. */
-        if( xNextMessageLength > xBufferLengthBytes )
+        if( xRequiredSpace > ( pxStreamBuffer->xLength - ( size_t ) 1 ) )
         {
-            /* The user has provided insufficient space to read the message. */
-            xNextMessageLength = 0;
+            /* The message would not fit even if the entire buffer was empty,
+             * so don't wait for space. */
+            xTicksToWait = ( TickType_t ) 0;
         }
         else
         {
@@ -1106,145 +1244,1093 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
     }
     else
     {
-        /* A stream of bytes is being received (as opposed to a discrete
-         * message), so read as many bytes as possible. */
-        xNextMessageLength = xBufferLengthBytes;
+        /* Nothing to send. */
+        xTicksToWait = ( TickType_t ) 0;
     }
 
-    /* Use the minimum of the wanted bytes and the available bytes. */
-    xCount = configMIN( xNextMessageLength, xBytesAvailable );
-
-    if( xCount != ( size_t ) 0 )
+    if( xTicksToWait != ( TickType_t ) 0 )
     {
-        /* Read the actual data and update the tail to mark the data as officially consumed. */
-        pxStreamBuffer->xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
-    }
+        vTaskSetTimeOutState( &xTimeOut );
 
-    return xCount;
-}
-/*-----------------------------------------------------------*/
+        do
+        {
+            /* Wait until the first message fits in the message buffer. */
+            xSpace = prvRegisterToWaitForSpace( pxStreamBuffer, xRequiredSpace );
 
-BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
-{
-    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    BaseType_t xReturn;
-    size_t xTail;
+            if( xSpace >= xRequiredSpace )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    configASSERT( pxStreamBuffer );
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToSend = NULL;
+        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-    /* True if no bytes are available. */
-    xTail = pxStreamBuffer->xTail;
+    if( xSpace == ( size_t ) 0 )
+    {
+        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xReturn = prvWriteMessagesToBuffer( pxStreamBuffer, ppvTxMessages, pxMessageLengths, xMessageCount, xSpace, &xBytesSent );
 
-    if( pxStreamBuffer->xHead == xTail )
+    if( xReturn > ( size_t ) 0 )
     {
-        xReturn = pdTRUE;
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent );
+
+        /* Was a task waiting for the data?  It is notified once for the whole
+         * batch. */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
     else
     {
-        xReturn = pdFALSE;
+        mtCOVERAGE_TEST_MARKER();
+        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
     }
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
+size_t xStreamBufferSendMessagesFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         const void * const * ppvTxMessages,
+                                         const size_t * pxMessageLengths,
+                                         size_t xMessageCount,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
 {
-    BaseType_t xReturn;
-    size_t xBytesToStoreMessageLength;
-    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xBytesSent = 0, xSpace;
 
+    configASSERT( ppvTxMessages );
+    configASSERT( pxMessageLengths );
     configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
 
-    /* This generic version of the receive function is used by both message
-     * buffers, which store discrete messages, and stream buffers, which store a
-     * continuous stream of bytes.  Discrete messages include an additional
-     * sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the message. */
-    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
-    {
-        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
-    }
-    else
-    {
-        xBytesToStoreMessageLength = 0;
-    }
+    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+    xReturn = prvWriteMessagesToBuffer( pxStreamBuffer, ppvTxMessages, pxMessageLengths, xMessageCount, xSpace, &xBytesSent );
 
-    /* True if the available space equals zero. */
-    if( xStreamBufferSpacesAvailable( xStreamBuffer ) <= xBytesToStoreMessageLength )
+    if( xReturn > ( size_t ) 0 )
     {
-        xReturn = pdTRUE;
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
     else
     {
-        xReturn = pdFALSE;
+        mtCOVERAGE_TEST_MARKER();
     }
 
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent );
+
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
-                                              BaseType_t * pxHigherPriorityTaskWoken )
+static size_t prvWriteMessagesToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                        const void * const * ppvTxMessages,
+                                        const size_t * pxMessageLengths,
+                                        size_t xMessageCount,
+                                        size_t xSpace,
+                                        size_t * pxBytesWritten )
 {
-    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-
-    configASSERT( pxStreamBuffer );
+    size_t xNextHead = pxStreamBuffer->xHead;
+    size_t xMessagesWritten = 0, xRequiredSpace;
+    configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    while( xMessagesWritten < xMessageCount )
     {
-        if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
+        xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) pxMessageLengths[ xMessagesWritten ];
+
+        /* Ensure the data length given fits within configMESSAGE_BUFFER_LENGTH_TYPE. */
+        configASSERT( ( size_t ) xMessageLength == pxMessageLengths[ xMessagesWritten ] );
+
+        xRequiredSpace = pxMessageLengths[ xMessagesWritten ] + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+        /* Messages are written in order, so stop at the first one that does
+         * not fit.  Zero length messages are not written, as by
+         * prvWriteMessageToBuffer(). */
+        if( ( xMessageLength == ( configMESSAGE_BUFFER_LENGTH_TYPE ) 0 ) || ( xSpace < xRequiredSpace ) )
         {
-            ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,
-                                         ( uint32_t ) 0,
-                                         eNoAction,
-                                         pxHigherPriorityTaskWoken );
-            ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;
-            xReturn = pdTRUE;
+            break;
         }
         else
         {
-            xReturn = pdFALSE;
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+        xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) ppvTxMessages[ xMessagesWritten ], pxMessageLengths[ xMessagesWritten ], xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+
+        xSpace -= xRequiredSpace;
+        *pxBytesWritten += pxMessageLengths[ xMessagesWritten ];
+        xMessagesWritten++;
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-    return xReturn;
+    /* Only move the head once all the messages have been written, so the
+     * reader sees the whole batch appear at once. */
+    sbSTORE_RELEASE( pxStreamBuffer->xHead, xNextHead );
+
+    return xMessagesWritten;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
-                                                 BaseType_t * pxHigherPriorityTaskWoken )
+size_t xStreamBufferReceiveMessages( StreamBufferHandle_t xStreamBuffer,
+                                     void * pvRxData,
+                                     size_t xBufferLengthBytes,
+                                     size_t * pxMessageLengths,
+                                     size_t xMaxMessages,
+                                     TickType_t xTicksToWait )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
+    size_t xReceivedMessages = 0, xBytesReceived = 0, xBytesAvailable;
 
+    configASSERT( pvRxData );
+    configASSERT( pxMessageLengths );
     configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+    if( xMaxMessages == ( size_t ) 0 )
+    {
+        /* There is no room to receive anything, so don't wait for data. */
+        xTicksToWait = ( TickType_t ) 0;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    if( xTicksToWait != ( TickType_t ) 0 )
     {
-        if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
+        /* Register to wait for data, unless there is already data to read. */
+        xBytesAvailable = prvRegisterToWaitForData( pxStreamBuffer, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+
+        if( xBytesAvailable <= sbBYTES_TO_STORE_MESSAGE_LENGTH )
         {
-            ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,
-                                         ( uint32_t ) 0,
-                                         eNoAction,
-                                         pxHigherPriorityTaskWoken );
-            ( pxStreamBuffer )->xTaskWaitingToSend = NULL;
-            xReturn = pdTRUE;
+            /* Wait for data to be available. */
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+            /* Recheck the data available after blocking. */
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
         }
         else
         {
-            xReturn = pdFALSE;
+            mtCOVERAGE_TEST_MARKER();
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    else
+    {
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+    }
 
-    return xReturn;
+    xReceivedMessages = prvReadMessagesFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, pxMessageLengths, xMaxMessages, xBytesAvailable, &xBytesReceived );
+
+    if( xReceivedMessages != ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesReceived );
+
+        /* Was a task waiting for space in the buffer?  It is notified once
+         * for the whole batch. */
+        prvRECEIVE_COMPLETED( xStreamBuffer );
+    }
+    else
+    {
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReceivedMessages;
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferReceiveMessagesFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            void * pvRxData,
+                                            size_t xBufferLengthBytes,
+                                            size_t * pxMessageLengths,
+                                            size_t xMaxMessages,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReceivedMessages, xBytesReceived = 0;
+
+    configASSERT( pvRxData );
+    configASSERT( pxMessageLengths );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+    xReceivedMessages = prvReadMessagesFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, pxMessageLengths, xMaxMessages, prvBytesInBuffer( pxStreamBuffer ), &xBytesReceived );
+
+    if( xReceivedMessages != ( size_t ) 0 )
+    {
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xBytesReceived );
+
+    return xReceivedMessages;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadMessagesFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                         void * pvRxData,
+                                         size_t xBufferLengthBytes,
+                                         size_t * pxMessageLengths,
+                                         size_t xMaxMessages,
+                                         size_t xBytesAvailable,
+                                         size_t * pxBytesRead )
+{
+    size_t xMessagesRead = 0, xNextMessageLength, xMessageTail;
+    size_t xNextTail = pxStreamBuffer->xTail;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+    uint8_t * pucRxData = ( uint8_t * ) pvRxData; /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+
+    while( ( xMessagesRead < xMaxMessages ) && ( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
+    {
+        xMessageTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+        xNextMessageLength = ( size_t ) xTempNextMessageLength;
+
+        /* Messages are placed one after another in the buffer provided, so
+         * stop at the first one that does not fit in the space left. */
+        if( xNextMessageLength > ( xBufferLengthBytes - *pxBytesRead ) )
+        {
+            break;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, &( pucRxData[ *pxBytesRead ] ), xNextMessageLength, xMessageTail );
+
+        pxMessageLengths[ xMessagesRead ] = xNextMessageLength;
+        *pxBytesRead += xNextMessageLength;
+        xBytesAvailable -= xNextMessageLength + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xMessagesRead++;
+    }
+
+    /* Only move the tail once all the messages have been read, so the writer
+     * sees the space they occupied freed at once. */
+    sbSTORE_RELEASE( pxStreamBuffer->xTail, xNextTail );
+
+    return xMessagesRead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                        void * pvRxData,
+                                        size_t xBufferLengthBytes,
+                                        size_t xBytesAvailable )
+{
+    size_t xCount, xNextMessageLength;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+    size_t xNextTail = pxStreamBuffer->xTail;
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        /* A discrete message is being received.  First receive the length
+         * of the message. */
+        xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+        xNextMessageLength = ( size_t ) xTempNextMessageLength;
+
+        /* Reduce the number of bytes available by the number of bytes just
+         * read out. */
+        xBytesAvailable -= sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+        /* Check there is enough space in the buffer provided by the
+         * user. */
+        if( xNextMessageLength > xBufferLengthBytes )
+        {
+            /* The user has provided insufficient space to read the message. */
+            xNextMessageLength = 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        /* A stream of bytes is being received (as opposed to a discrete
+         * message), so read as many bytes as possible. */
+        xNextMessageLength = xBufferLengthBytes;
+    }
+
+    /* Use the minimum of the wanted bytes and the available bytes. */
+    xCount = configMIN( xNextMessageLength, xBytesAvailable );
+
+    if( xCount != ( size_t ) 0 )
+    {
+        /* Read the actual data and update the tail to mark the data as officially consumed. */
+        sbSTORE_RELEASE( pxStreamBuffer->xTail, prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail ) ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+    }
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferSpans_t * const pxSpans,
+                                 TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xRequiredSpace = 1, xSpace = 0;
+    TimeOut_t xTimeOut;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxSpans );
+
+    /* A message buffer needs room for the length of the message as well as at
+     * least one byte of the message itself. */
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* Wait until there is space to reserve. */
+            xSpace = prvRegisterToWaitForSpace( pxStreamBuffer, xRequiredSpace );
+
+            if( xSpace >= xRequiredSpace )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToSend = NULL;
+        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return prvGetFreeSpans( pxStreamBuffer, pxSpans );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        StreamBufferSpans_t * const pxSpans )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxSpans );
+
+    return prvGetFreeSpans( pxStreamBuffer, pxSpans );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+                                size_t xBytesWritten )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+
+    if( xBytesWritten > ( size_t ) 0 )
+    {
+        prvCommitBytes( pxStreamBuffer, xBytesWritten );
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesWritten );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xBytesWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                       size_t xBytesWritten,
+                                       BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+
+    if( xBytesWritten > ( size_t ) 0 )
+    {
+        prvCommitBytes( pxStreamBuffer, xBytesWritten );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesWritten );
+
+    return xBytesWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+                                    StreamBufferSpans_t * const pxSpans,
+                                    TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xBytesAvailable, xBytesToStoreMessageLength;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxSpans );
+
+    /* As in xStreamBufferReceive(), a message buffer holds a message only if
+     * it holds more than the message's length. */
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+    }
+    else
+    {
+        xBytesToStoreMessageLength = 0;
+    }
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        /* Register to wait for data, unless there is already data to read. */
+        xBytesAvailable = prvRegisterToWaitForData( pxStreamBuffer, xBytesToStoreMessageLength );
+
+        if( xBytesAvailable <= xBytesToStoreMessageLength )
+        {
+            /* Wait for data to be available. */
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return prvGetDataSpans( pxStreamBuffer, pxSpans );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           StreamBufferSpans_t * const pxSpans )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxSpans );
+
+    return prvGetDataSpans( pxStreamBuffer, pxSpans );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xBytesRead )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+
+    if( xBytesRead > ( size_t ) 0 )
+    {
+        prvReleaseBytes( pxStreamBuffer, xBytesRead );
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesRead );
+        prvRECEIVE_COMPLETED( xStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xBytesRead;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           size_t xBytesRead,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+
+    if( xBytesRead > ( size_t ) 0 )
+    {
+        prvReleaseBytes( pxStreamBuffer, xBytesRead );
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xBytesRead );
+
+    return xBytesRead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+                           size_t xStart,
+                           size_t xCount,
+                           StreamBufferSpans_t * const pxSpans )
+{
+    size_t xFirstLength;
+
+    if( xStart >= pxStreamBuffer->xLength )
+    {
+        xStart -= pxStreamBuffer->xLength;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* The first span runs from xStart towards the end of the storage area,
+     * and the second, if needed, from the start of the storage area. */
+    xFirstLength = configMIN( pxStreamBuffer->xLength - xStart, xCount );
+
+    pxSpans->pucSpan[ 0 ] = &( pxStreamBuffer->pucBuffer[ xStart ] );
+    pxSpans->xSpanLength[ 0 ] = xFirstLength;
+    pxSpans->pucSpan[ 1 ] = pxStreamBuffer->pucBuffer;
+    pxSpans->xSpanLength[ 1 ] = xCount - xFirstLength;
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvGetFreeSpans( StreamBuffer_t * const pxStreamBuffer,
+                               StreamBufferSpans_t * const pxSpans )
+{
+    size_t xSpace, xStart = pxStreamBuffer->xHead;
+
+    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        /* Leave room in front of the message for its length, which is written
+         * when the message is committed. */
+        if( xSpace > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+        {
+            xSpace -= sbBYTES_TO_STORE_MESSAGE_LENGTH;
+            xStart += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            xSpace = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return prvGetSpans( pxStreamBuffer, xStart, xSpace, pxSpans );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvGetDataSpans( StreamBuffer_t * const pxStreamBuffer,
+                               StreamBufferSpans_t * const pxSpans )
+{
+    size_t xCount, xStart = pxStreamBuffer->xTail;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+
+    xCount = prvBytesInBuffer( pxStreamBuffer );
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        /* Only the next message is made available, not including its
+         * length. */
+        if( xCount > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+        {
+            xStart = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xStart );
+            xCount = ( size_t ) xTempMessageLength;
+        }
+        else
+        {
+            xCount = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return prvGetSpans( pxStreamBuffer, xStart, xCount, pxSpans );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCommitBytes( StreamBuffer_t * const pxStreamBuffer,
+                            size_t xBytesWritten )
+{
+    size_t xNextHead = pxStreamBuffer->xHead;
+    configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        /* The data was written after the space left for the message length,
+         * so write the length in front of it. */
+        xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xBytesWritten;
+        configASSERT( ( size_t ) xMessageLength == xBytesWritten );
+        configASSERT( ( xBytesWritten + sbBYTES_TO_STORE_MESSAGE_LENGTH ) <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+        xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+    }
+    else
+    {
+        /* Can't commit more than was reserved, and the free space cannot
+         * shrink while it is reserved. */
+        configASSERT( xBytesWritten <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+    }
+
+    xNextHead += xBytesWritten;
+
+    if( xNextHead >= pxStreamBuffer->xLength )
+    {
+        xNextHead -= pxStreamBuffer->xLength;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    sbSTORE_RELEASE( pxStreamBuffer->xHead, xNextHead );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseBytes( StreamBuffer_t * const pxStreamBuffer,
+                             size_t xBytesRead )
+{
+    size_t xNextTail = pxStreamBuffer->xTail;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+
+    configASSERT( xBytesRead <= prvBytesInBuffer( pxStreamBuffer ) );
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        /* Messages are released whole, together with their length. */
+        xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+        configASSERT( xBytesRead == ( size_t ) xTempMessageLength );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xNextTail += xBytesRead;
+
+    if( xNextTail >= pxStreamBuffer->xLength )
+    {
+        xNextTail -= pxStreamBuffer->xLength;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    sbSTORE_RELEASE( pxStreamBuffer->xTail, xNextTail );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
+{
+    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+    size_t xTail;
+
+    configASSERT( pxStreamBuffer );
+
+    /* True if no bytes are available. */
+    xTail = sbLOAD_ACQUIRE( pxStreamBuffer->xTail );
+
+    if( sbLOAD_ACQUIRE( pxStreamBuffer->xHead ) == xTail )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
+{
+    BaseType_t xReturn;
+    size_t xBytesToStoreMessageLength;
+    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+
+    /* This generic version of the receive function is used by both message
+     * buffers, which store discrete messages, and stream buffers, which store a
+     * continuous stream of bytes.  Discrete messages include an additional
+     * sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the message. */
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+    }
+    else
+    {
+        xBytesToStoreMessageLength = 0;
+    }
+
+    /* True if the available space equals zero. */
+    if( xStreamBufferSpacesAvailable( xStreamBuffer ) <= xBytesToStoreMessageLength )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
+                                              BaseType_t * pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    #if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    {
+        TaskHandle_t xTaskToNotify = prvTakeWaitingTask( &( pxStreamBuffer->xTaskWaitingToReceive ) );
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyFromISR( xTaskToNotify,
+                                         ( uint32_t ) 0,
+                                         eNoAction,
+                                         pxHigherPriorityTaskWoken );
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    #else /* if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 ) */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
+            {
+                ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,
+                                             ( uint32_t ) 0,
+                                             eNoAction,
+                                             pxHigherPriorityTaskWoken );
+                ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+    #endif /* if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 ) */
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
+                                                 BaseType_t * pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    #if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    {
+        TaskHandle_t xTaskToNotify = prvTakeWaitingTask( &( pxStreamBuffer->xTaskWaitingToSend ) );
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyFromISR( xTaskToNotify,
+                                         ( uint32_t ) 0,
+                                         eNoAction,
+                                         pxHigherPriorityTaskWoken );
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    #else /* if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 ) */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
+            {
+                ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,
+                                             ( uint32_t ) 0,
+                                             eNoAction,
+                                             pxHigherPriorityTaskWoken );
+                ( pxStreamBuffer )->xTaskWaitingToSend = NULL;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+    #endif /* if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 ) */
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvRegisterToWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+                                         size_t xRequiredSpace )
+{
+    size_t xSpace;
+
+    #if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    {
+        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+        if( xSpace < xRequiredSpace )
+        {
+            /* Clear notification state as going to wait for space. */
+            ( void ) xTaskNotifyStateClear( NULL );
+
+            /* Should only be one writer. */
+            configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+            ( void ) sbEXCHANGE_TASK_HANDLE( pxStreamBuffer->xTaskWaitingToSend, xTaskGetCurrentTaskHandle() );
+            sbFULL_BARRIER();
+
+            /* The reader may have freed space after it was checked above but
+             * before this task was registered as waiting, in which case it would
+             * not have notified this task, so check again. */
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+            if( xSpace >= xRequiredSpace )
+            {
+                ( void ) sbEXCHANGE_TASK_HANDLE( pxStreamBuffer->xTaskWaitingToSend, NULL );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 ) */
+    {
+        /* Checking for space and clearing the notification state must be
+         * performed atomically. */
+        taskENTER_CRITICAL();
+        {
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+            if( xSpace < xRequiredSpace )
+            {
+                /* Clear notification state as going to wait for space. */
+                ( void ) xTaskNotifyStateClear( NULL );
+
+                /* Should only be one writer. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+    #endif /* if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 ) */
+
+    return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvRegisterToWaitForData( StreamBuffer_t * const pxStreamBuffer,
+                                        size_t xBytesToStoreMessageLength )
+{
+    size_t xBytesAvailable;
+
+    #if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    {
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+        if( xBytesAvailable <= xBytesToStoreMessageLength )
+        {
+            /* Clear notification state as going to wait for data. */
+            ( void ) xTaskNotifyStateClear( NULL );
+
+            /* Should only be one reader. */
+            configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+            ( void ) sbEXCHANGE_TASK_HANDLE( pxStreamBuffer->xTaskWaitingToReceive, xTaskGetCurrentTaskHandle() );
+            sbFULL_BARRIER();
+
+            /* The writer may have added data after it was checked above but
+             * before this task was registered as waiting, so check again. */
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+            if( xBytesAvailable > xBytesToStoreMessageLength )
+            {
+                ( void ) sbEXCHANGE_TASK_HANDLE( pxStreamBuffer->xTaskWaitingToReceive, NULL );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 ) */
+    {
+        /* Checking if there is data and clearing the notification state must be
+         * performed atomically. */
+        taskENTER_CRITICAL();
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+            /* If this function was invoked by a message buffer read then
+             * xBytesToStoreMessageLength holds the number of bytes used to hold
+             * the length of the next discrete message.  If this function was
+             * invoked by a stream buffer read then xBytesToStoreMessageLength will
+             * be 0. */
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                /* Clear notification state as going to wait for data. */
+                ( void ) xTaskNotifyStateClear( NULL );
+
+                /* Should only be one reader. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+    #endif /* if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 ) */
+
+    return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+
+    static TaskHandle_t prvTakeWaitingTask( volatile TaskHandle_t * const pxWaitingTask )
+    {
+        TaskHandle_t xWaitingTask;
+
+        /* Order the update of xHead or xTail that preceded this call before the
+         * check for a waiting task.  Pairs with the exchange in
+         * prvRegisterToWaitForSpace() and prvRegisterToWaitForData(), so either
+         * the waiting task sees the update or this call sees the waiting task. */
+        sbFULL_BARRIER();
+        xWaitingTask = *pxWaitingTask;
+
+        if( xWaitingTask != NULL )
+        {
+            /* The waiting task may have timed out and cleared the handle
+             * itself, so only notify the task if this call clears it. */
+            xWaitingTask = sbEXCHANGE_TASK_HANDLE( *pxWaitingTask, NULL );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xWaitingTask;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_LOCK_FREE */
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                      const uint8_t * pucData,
                                      size_t xCount,
@@ -1340,8 +2426,8 @@ static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
 /* Returns the distance between xTail and xHead. */
     size_t xCount;
 
-    xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
-    xCount -= pxStreamBuffer->xTail;
+    xCount = pxStreamBuffer->xLength + sbLOAD_ACQUIRE( pxStreamBuffer->xHead );
+    xCount -= sbLOAD_ACQUIRE( pxStreamBuffer->xTail );
 
     if( xCount >= pxStreamBuffer->xLength )
     {
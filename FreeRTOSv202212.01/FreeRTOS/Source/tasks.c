@@ -41,6 +41,14 @@
 #include "timers.h"
 #include "stack_macros.h"
 
+#if ( configTASK_POOL_LENGTH > 0 )
+    #include "object_pool.h"
+#endif
+
+#if ( configUSE_DEFERRED_WORK == 1 )
+    #include "deferred_work.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -67,6 +75,36 @@
     #define taskYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* Values that can be assigned to the xTaskRunState member of the TCB.  A task
+ * that is running holds the ID of the core it is running on, so the values
+ * below must be negative. */
+    #define taskTASK_NOT_RUNNING           ( ( BaseType_t ) ( -1 ) )
+    #define taskTASK_SCHEDULED_TO_YIELD    ( ( BaseType_t ) ( -2 ) )
+
+/* Returns pdTRUE if the task is running on a core.  A task that has been asked
+ * to yield its core but has not yet done so is only matched by
+ * taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD(). */
+    #define taskTASK_IS_RUNNING( pxTCB )                          ( ( ( ( pxTCB )->xTaskRunState >= ( BaseType_t ) 0 ) && ( ( pxTCB )->xTaskRunState < ( BaseType_t ) configNUMBER_OF_CORES ) ) ? pdTRUE : pdFALSE )
+    #define taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB )    ( ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING ) ? pdTRUE : pdFALSE )
+
+/* Returns pdTRUE if xCoreID is the ID of a core. */
+    #define taskVALID_CORE_ID( xCoreID )                          ( ( ( ( xCoreID ) >= ( BaseType_t ) 0 ) && ( ( xCoreID ) < ( BaseType_t ) configNUMBER_OF_CORES ) ) ? pdTRUE : pdFALSE )
+
+/* Bits used in the uxTaskAttributes member of the TCB. */
+    #define taskATTRIBUTE_IS_IDLE    ( ( UBaseType_t ) ( 1U << 0U ) )
+
+/* A task that has just been made ready may be of a higher priority than a task
+ * running on any of the cores, not only the core that readied it. */
+    #if ( configUSE_PREEMPTION == 0 )
+        #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )
+    #else
+        #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )    prvYieldForTask( pxTCB )
+    #endif
+
+#endif /* configNUMBER_OF_CORES > 1 */
+
 /* Values that can be assigned to the ucNotifyState member of the TCB. */
 #define taskNOT_WAITING_NOTIFICATION              ( ( uint8_t ) 0 ) /* Must be zero as it is the initialised value. */
 #define taskWAITING_NOTIFICATION                  ( ( uint8_t ) 1 )
@@ -78,6 +116,10 @@
  */
 #define tskSTACK_FILL_BYTE                        ( 0xa5U )
 
+/* tskSTACK_FILL_BYTE repeated across a whole StackType_t, so the high water
+ * mark can be found by comparing a stack word at a time. */
+#define tskSTACK_FILL_WORD                        ( ( StackType_t ) ( ( ( StackType_t ) ~( StackType_t ) 0U / ( StackType_t ) 0xffU ) * ( StackType_t ) tskSTACK_FILL_BYTE ) )
+
 /* Bits used to record how a task's stack and TCB were allocated. */
 #define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB    ( ( uint8_t ) 0 )
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY        ( ( uint8_t ) 1 )
@@ -115,7 +157,7 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
  * performed in a generic way that is not optimised to any particular
@@ -158,6 +200,74 @@
     #define taskRESET_READY_PRIORITY( uxPriority )
     #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+
+/* If configUSE_READY_PRIORITY_BITMAP is 1 then the generic task selection
+ * mechanism keeps one bit per priority in ulReadyPriorities[], set while the
+ * ready list for that priority is not empty, and one bit per word of
+ * ulReadyPriorities[] in ulReadyPriorityGroups, set while that word is not
+ * zero.  The highest priority ready task is then found with two highest set
+ * bit searches, however many priorities are in use. */
+
+/* The number of 32 bit words needed to hold one bit per priority. */
+    #define taskREADY_PRIORITY_WORDS    ( ( ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 31U ) >> 5 )
+
+/* Use the compiler's count leading zeros builtin to find the highest set bit
+ * where one is known to be available, otherwise fall back to a table based
+ * search. */
+    #if defined( __GNUC__ ) && defined( __SIZEOF_INT__ ) && ( __SIZEOF_INT__ == 4 )
+        #define taskHIGHEST_SET_BIT( ulBitmap )    ( ( UBaseType_t ) 31U - ( UBaseType_t ) __builtin_clz( ( unsigned int ) ( ulBitmap ) ) )
+    #else
+        #define taskHIGHEST_SET_BIT( ulBitmap )    prvHighestSetBit( ulBitmap )
+        #define taskUSE_HIGHEST_SET_BIT_TABLE    1
+    #endif
+
+    #define taskRECORD_READY_PRIORITY( uxPriority )                                      \
+    {                                                                                    \
+        ulReadyPriorities[ ( uxPriority ) >> 5 ] |= ( 1UL << ( ( uxPriority ) & 31U ) ); \
+        ulReadyPriorityGroups |= ( 1UL << ( ( uxPriority ) >> 5 ) );                     \
+    } /* taskRECORD_READY_PRIORITY */
+
+/*-----------------------------------------------------------*/
+
+    #define taskSELECT_HIGHEST_PRIORITY_TASK()                                                      \
+    {                                                                                               \
+        UBaseType_t uxTopWord, uxTopPriority;                                                       \
+                                                                                                    \
+        /* Find the highest priority list that contains ready tasks. */                             \
+        uxTopWord = taskHIGHEST_SET_BIT( ulReadyPriorityGroups );                                   \
+        uxTopPriority = ( uxTopWord << 5 ) + taskHIGHEST_SET_BIT( ulReadyPriorities[ uxTopWord ] ); \
+        configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );     \
+        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );       \
+    } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
+
+/*-----------------------------------------------------------*/
+
+/* Clear the bit for a priority whose ready list has become empty, and the
+ * bit for its word if no other priority in that word remains ready.  The
+ * second parameter is not used, but is retained so the calls made for the
+ * port optimised method of task selection can be used unchanged. */
+    #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )                    \
+    {                                                                                     \
+        ulReadyPriorities[ ( uxPriority ) >> 5 ] &= ~( 1UL << ( ( uxPriority ) & 31U ) ); \
+                                                                                          \
+        if( ulReadyPriorities[ ( uxPriority ) >> 5 ] == 0UL )                             \
+        {                                                                                 \
+            ulReadyPriorityGroups &= ~( 1UL << ( ( uxPriority ) >> 5 ) );                 \
+        }                                                                                 \
+    }
+
+/* Only clear the ready bit if the TCB being reset is referenced from a
+ * ready list that is now empty.  If it is referenced from a delayed or
+ * suspended list then it won't be in a ready list. */
+    #define taskRESET_READY_PRIORITY( uxPriority )                                                     \
+    {                                                                                                  \
+        if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 ) \
+        {                                                                                              \
+            portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );                        \
+        }                                                                                              \
+    }
+
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
@@ -196,9 +306,11 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
-#define taskSWITCH_DELAYED_LISTS()                                                \
+    #define taskSWITCH_DELAYED_LISTS()                                                \
     {                                                                             \
         List_t * pxTemp;                                                          \
                                                                                   \
@@ -212,6 +324,47 @@
         prvResetNextTaskUnblockTime();                                            \
     }
 
+/* Delayed tasks are only ever referenced from the two delayed lists. */
+    #define taskLIST_IS_DELAYED_TASK_WHEEL_SLOT( pxList )    ( pdFALSE )
+
+#else /* configUSE_DELAYED_TASK_WHEEL */
+
+/* When the delayed task wheel is used pxDelayedTaskList and
+ * pxOverflowDelayedTaskList only hold tasks whose wake time is too far in the
+ * future to be placed in the wheel, and are not sorted.  They are still switched
+ * when the tick count overflows, after which xNextTaskUnblockTime is set to the
+ * new tick count so the tasks that were waiting for the overflow are moved into
+ * the wheel on this same tick. */
+    #define taskSWITCH_DELAYED_LISTS()                                                \
+    {                                                                             \
+        List_t * pxTemp;                                                          \
+                                                                                  \
+        /* The delayed tasks list should be empty when the lists are switched. */ \
+        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );               \
+                                                                                  \
+        pxTemp = pxDelayedTaskList;                                               \
+        pxDelayedTaskList = pxOverflowDelayedTaskList;                            \
+        pxOverflowDelayedTaskList = pxTemp;                                       \
+        xNumOfOverflows++;                                                        \
+        xNextTaskUnblockTime = xTickCount;                                        \
+    }
+
+/* The number of slots on each level of the wheel, the mask used to obtain a
+ * slot index from a shifted tick count, and the shift that gives the slot index
+ * on a given level. */
+    #define taskWHEEL_SLOTS                                  ( ( UBaseType_t ) 1U << configDELAYED_TASK_WHEEL_SLOT_BITS )
+    #define taskWHEEL_SLOT_MASK                              ( ( TickType_t ) taskWHEEL_SLOTS - ( TickType_t ) 1U )
+    #define taskWHEEL_SHIFT( uxLevel )                       ( ( UBaseType_t ) ( uxLevel ) * ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS )
+
+/* Delayed tasks are referenced from the slots of the wheel as well as from the
+ * two delayed lists. */
+    #define taskLIST_IS_DELAYED_TASK_WHEEL_SLOT( pxList )                                                         \
+    ( ( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ][ 0 ] ) ) &&                                                     \
+        ( ( pxList ) <= &( xDelayedTaskWheel[ configDELAYED_TASK_WHEEL_LEVELS - 1 ][ taskWHEEL_SLOTS - 1U ] ) ) ) \
+      ? pdTRUE : pdFALSE )
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -243,6 +396,8 @@
  * to its original value when it is released. */
 #if ( configUSE_16_BIT_TICKS == 1 )
     #define taskEVENT_LIST_ITEM_VALUE_IN_USE    0x8000U
+#elif ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+    #define taskEVENT_LIST_ITEM_VALUE_IN_USE    ( ( TickType_t ) 0x80U << 56 ) /* C89 has no 64-bit integer constants. */
 #else
     #define taskEVENT_LIST_ITEM_VALUE_IN_USE    0x80000000UL
 #endif
@@ -318,6 +473,24 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        volatile BaseType_t xTaskRunState; /*< The ID of the core the task is running on, or taskTASK_NOT_RUNNING or taskTASK_SCHEDULED_TO_YIELD. */
+        UBaseType_t uxTaskAttributes;      /*< Task attributes, such as taskATTRIBUTE_IS_IDLE. */
+    #endif
+
+    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+        UBaseType_t uxCoreAffinityMask; /*< Bit N is set if the task is allowed to run on core N. */
+    #endif
+
+    #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        UBaseType_t uxRunTimeContext; /*< Where run time was being charged when the task was switched out, restored when it is switched back in. */
+    #endif
+
+    #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+        List_t xMutexesHeld;                   /*< The mutexes held by the task, each referenced by a list item in the mutex. */
+        TaskHandle_t * pxBlockedOnMutexHolder; /*< Points to the holder of the mutex the task is waiting for, or NULL if the task is not waiting for a mutex. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -326,7 +499,16 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
-portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#else
+
+/* One task runs on each core.  pxCurrentTCB is kept as the name of the task
+ * running on the calling core so code shared with the single core build reads
+ * the same. */
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ];
+    #define pxCurrentTCB    xTaskGetCurrentTaskHandle()
+#endif
 
 /* Lists for ready and blocked tasks. --------------------
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
@@ -339,6 +521,20 @@ PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Poi
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/* Delayed tasks are held in a hierarchical timing wheel.  Level 0 has one slot
+ * per tick, and each slot on level N covers all the slots of level N - 1.  A
+ * task is placed on the lowest level on which its wake time only differs from
+ * the current tick count within that level's own slot index, so placing a task
+ * and removing it are both constant time operations.  When the tick count
+ * enters the range covered by a slot on a level above 0 the tasks in that slot
+ * are redistributed (cascaded) to the levels below. */
+    PRIVILEGED_DATA static List_t xDelayedTaskWheel[ configDELAYED_TASK_WHEEL_LEVELS ][ taskWHEEL_SLOTS ]; /*< Delayed tasks, indexed by wake time. */
+    PRIVILEGED_DATA static uint32_t ulDelayedTaskWheelOccupied[ configDELAYED_TASK_WHEEL_LEVELS ];      /*< A bit per slot, set when a task is placed in the slot.  Tasks can leave a slot without the bit being cleared, so a set bit only means the slot might not be empty. */
+
+#endif
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     PRIVILEGED_DATA static List_t xTasksWaitingTermination; /*< Tasks that have been deleted - but their memory not yet freed. */
@@ -361,14 +557,27 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#if ( configUSE_READY_PRIORITY_BITMAP == 0 )
+    PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#else
+    PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityGroups = 0UL;
+    PRIVILEGED_DATA static volatile uint32_t ulReadyPriorities[ taskREADY_PRIORITY_WORDS ] = { 0UL };
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#else
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows = ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#else
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ] = { NULL };           /*< Holds the handles of the idle tasks, one per core.  The idle tasks are created automatically when the scheduler is started. */
+#endif
 
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
@@ -389,11 +598,68 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 /* Do not move these variables to function scope as doing so prevents the
  * code working with debuggers that need to remove the static qualifier. */
-    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;    /*< Holds the value of a timer/counter the last time a task was switched in. */
+    #if ( ( configNUMBER_OF_CORES == 1 ) && ( configUSE_RUN_TIME_ACCOUNTING == 0 ) )
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;                                   /*< Holds the value of a timer/counter the last time a task was switched in. */
+    #elif ( configNUMBER_OF_CORES > 1 )
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ configNUMBER_OF_CORES ] = { 0UL };   /*< Holds the value of a timer/counter the last time a task was switched in on each core. */
+    #endif
     PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL; /*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
+#if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+
+/* Where the run time that passes is being charged - to the running task, to
+ * task level critical sections, or to the interrupt with the given number.
+ * The task context is zero so a newly created task starts in it. */
+    #define taskRUN_TIME_IN_TASK             ( ( UBaseType_t ) 0U )
+    #define taskRUN_TIME_IN_KERNEL           ( ( UBaseType_t ) 1U )
+    #define taskRUN_TIME_IN_ISR( uxISR )     ( ( UBaseType_t ) 2U + ( UBaseType_t ) ( uxISR ) )
+
+/* With accounting ulTotalRunTime is extended from the port's counter each
+ * time run time is charged, so it does not wrap with the counter. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulLastRunTimeCounterValue = 0UL;                         /*< The port's counter value when run time was last charged. */
+    PRIVILEGED_DATA static UBaseType_t uxRunTimeContext = taskRUN_TIME_IN_TASK;                                 /*< Where run time is currently being charged. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulKernelRunTime = 0UL;                                   /*< Run time spent in task level critical sections. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulISRRunTime[ configRUN_TIME_ISR_COUNT ] = { 0UL };     /*< Run time spent in each interrupt that reports its run time. */
+
+#endif
+
+#if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+
+/* The histogram table entries that collect the critical sections and the
+ * scheduler suspensions whose call site is unknown or did not fit in the
+ * table.  The other entries are found by hashing the call site. */
+    #define taskHISTOGRAM_OTHER_CRITICAL     ( ( UBaseType_t ) 0U )
+    #define taskHISTOGRAM_OTHER_SUSPENDED    ( ( UBaseType_t ) 1U )
+    #define taskHISTOGRAM_FIRST_SITE         ( ( UBaseType_t ) 2U )
+    #define taskHISTOGRAM_HASHED_SITES       ( ( UBaseType_t ) configCRITICAL_SECTION_HISTOGRAM_SITES - taskHISTOGRAM_FIRST_SITE )
+
+    PRIVILEGED_DATA static CriticalSectionHistogram_t xCriticalSectionHistograms[ configCRITICAL_SECTION_HISTOGRAM_SITES ]; /*< The histogram of each call site recorded so far. */
+    PRIVILEGED_DATA static BaseType_t xCriticalSectionTimed = pdFALSE;                                                     /*< pdTRUE while an outermost critical section is being timed. */
+    PRIVILEGED_DATA static uint32_t ulCriticalSectionStart = 0UL;                                                          /*< When the critical section being timed was entered. */
+    PRIVILEGED_DATA static const void * pvCriticalSectionSite = NULL;                                                      /*< Where the critical section being timed was entered from. */
+    PRIVILEGED_DATA static BaseType_t xSchedulerSuspensionTimed = pdFALSE;                                                 /*< pdTRUE while an outermost scheduler suspension is being timed. */
+    PRIVILEGED_DATA static uint32_t ulSchedulerSuspensionStart = 0UL;                                                      /*< When the scheduler suspension being timed started. */
+    PRIVILEGED_DATA static const void * pvSchedulerSuspensionSite = NULL;                                                  /*< Where the scheduler suspension being timed started from. */
+
+#endif
+
+/* TCBs that are allocated dynamically are taken from a fixed pool of
+ * configTASK_POOL_LENGTH TCBs before falling back to the heap.  Stacks are
+ * always allocated from the heap. */
+#if ( configTASK_POOL_LENGTH > 0 )
+    PRIVILEGED_DATA static uint8_t ucTaskPoolStorage[ poolSTORAGE_SIZE( configTASK_POOL_LENGTH, sizeof( TCB_t ) ) ];
+    PRIVILEGED_DATA static uint32_t ulTaskPoolSlotsInUse[ poolBITMAP_WORDS( configTASK_POOL_LENGTH ) ];
+    PRIVILEGED_DATA static ObjectPool_t xTaskPool = { ucTaskPoolStorage, poolSLOT_SIZE( sizeof( TCB_t ) ), configTASK_POOL_LENGTH, ulTaskPoolSlotsInUse };
+
+    #define taskMALLOC_TCB()         ( ( TCB_t * ) pvObjectPoolMalloc( &xTaskPool, sizeof( TCB_t ) ) )
+    #define taskFREE_TCB( pxTCB )    vObjectPoolFree( &xTaskPool, ( pxTCB ) )
+#else
+    #define taskMALLOC_TCB()         ( ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ) )
+    #define taskFREE_TCB( pxTCB )    vPortFree( pxTCB )
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -430,6 +696,52 @@ static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
  */
 static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * The idle task of every core other than core 0.  The idle task of core 0 does
+ * the housekeeping (freeing deleted tasks, calling the idle hook), the others
+ * just yield - and call the passive idle hook if configUSE_PASSIVE_IDLE_HOOK is
+ * 1.
+ */
+    static portTASK_FUNCTION_PROTO( prvPassiveIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Selects the task to run on core xCoreID and sets pxCurrentTCBs[ xCoreID ] to
+ * it.  Must be called with the task and ISR locks held.
+ */
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Requests the core xCoreID to yield.  If xCoreID is the calling core the
+ * yield is held pending until the calling core leaves its critical section,
+ * otherwise the port is asked to interrupt the other core.  Must be called
+ * from a critical section.
+ */
+    static void prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when pxTCB has been made ready, or had its priority raised, to make
+ * the core running the lowest priority task that pxTCB can preempt yield.
+ * Must be called from a critical section.
+ */
+    static void prvYieldForTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the calling core has just taken the task lock.  If another core
+ * asked the calling task to yield while it was waiting for the lock, the locks
+ * are released again for long enough for that yield to happen.
+ */
+    static void prvCheckForRunStateChange( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Creates the idle task of each core, and makes it the task running on that
+ * core when the scheduler starts.
+ */
+    static BaseType_t prvCreateIdleTasks( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES > 1 */
+
 /*
  * Utility to free all memory allocated by the scheduler to hold a TCB,
  * including the stack pointed to by the TCB.
@@ -516,6 +828,109 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/*
+ * Place the list item pxListItem, the value of which must already be set to
+ * the wake time of its owner, into the delayed task wheel - or into
+ * pxDelayedTaskList if the wake time is beyond the span of the wheel.  Returns
+ * the tick count at which the wheel next needs to act on the item, which is
+ * never later than the item's wake time.
+ */
+    static TickType_t prvDelayedWheelInsert( ListItem_t * const pxListItem,
+                                             const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Cascade the tasks held on the levels of the wheel that xTimeNow has just
+ * entered to the levels below, and return the level 0 slot holding the tasks
+ * that must be unblocked at xTimeNow.
+ */
+    static List_t * prvDelayedWheelAdvance( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the earliest tick count after xTimeNow at which the wheel needs to
+ * either unblock a task or cascade a slot, or portMAX_DELAY if there is none.
+ */
+    static TickType_t prvDelayedWheelNextEventTime( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
+/*
+ * Returns the index of the most significant set bit in ulBitmap, which must
+ * not be zero.  Used to search the ready priority bitmap when the compiler
+ * does not provide a count leading zeros builtin.
+ */
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 ) && defined( taskUSE_HIGHEST_SET_BIT_TABLE )
+
+    static UBaseType_t prvHighestSetBit( uint32_t ulBitmap ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+
+/*
+ * Reads the port's run time counter.
+ */
+    static configRUN_TIME_COUNTER_TYPE prvGetRunTimeCounterValue( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Charges the run time that has passed since run time was last charged to the
+ * running task, to task level critical sections or to an interrupt, depending
+ * on uxRunTimeContext.  Must be called with interrupts masked.
+ */
+    static void prvChargeRunTime( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fills in a TaskRunTime_t structure for each task referenced from pxList,
+ * returning the number of structures filled in.  Used by
+ * uxTaskGetRunTimeSnapshot().
+ */
+    static UBaseType_t prvListRunTimesWithinSingleList( TaskRunTime_t * pxRunTimeArray,
+                                                        List_t * pxList,
+                                                        eTaskState eState ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+
+/*
+ * Counts a critical section, or a scheduler suspension if xSchedulerSuspended
+ * is pdTRUE, that lasted ulLength timestamp units in the histogram for
+ * pvCallSite.  Must be called with interrupts masked.
+ */
+    static void prvRecordSectionLength( const void * pvCallSite,
+                                        BaseType_t xSchedulerSuspended,
+                                        uint32_t ulLength ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+/*
+ * Returns the priority pxTCB should run at - the higher of its base priority
+ * and the priority of the highest priority task waiting for any of the mutexes
+ * it holds.
+ */
+    static UBaseType_t prvGetInheritedPriority( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Changes the priority pxTCB is running at, moving the task to its new
+ * position in its ready list or in the list of tasks waiting for a mutex.  If
+ * the task is waiting for a mutex then the holder of that mutex is returned,
+ * as its priority might have to change in turn, otherwise NULL is returned.
+ */
+    static TCB_t * prvSetInheritedPriority( TCB_t * const pxTCB,
+                                            UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * Recalculates the priority of pxTCB, then of the holder of the mutex pxTCB is
+ * waiting for, and so on along the chain of mutex holders until a priority does
+ * not change.  Returns pdTRUE if the priority of the running task was lowered.
+ */
+    static BaseType_t prvUpdateInheritedPriorities( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -679,7 +1094,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* Allocate space for the TCB.  Where the memory comes from depends
              * on the implementation of the port malloc function and whether or
              * not static allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = taskMALLOC_TCB();
 
             if( pxNewTCB != NULL )
             {
@@ -736,7 +1151,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* Allocate space for the TCB.  Where the memory comes from depends on
              * the implementation of the port malloc function and whether or not static
              * allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = taskMALLOC_TCB();
 
             if( pxNewTCB != NULL )
             {
@@ -750,7 +1165,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 if( pxNewTCB->pxStack == NULL )
                 {
                     /* Could not allocate the stack.  Delete the allocated TCB. */
-                    vPortFree( pxNewTCB );
+                    taskFREE_TCB( pxNewTCB );
                     pxNewTCB = NULL;
                 }
             }
@@ -765,7 +1180,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             if( pxStack != NULL )
             {
                 /* Allocate space for the TCB. */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+                pxNewTCB = taskMALLOC_TCB(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
                 if( pxNewTCB != NULL )
                 {
@@ -932,6 +1347,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
     vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
+    #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+    {
+        vListInitialise( &( pxNewTCB->xMutexesHeld ) );
+        pxNewTCB->pxBlockedOnMutexHolder = NULL;
+    }
+    #endif
+
     /* Set the pxNewTCB as a link back from the ListItem_t.  This is so we can get
      * back to  the containing TCB from a generic item in a list. */
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
@@ -940,6 +1362,28 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+
+        /* The idle tasks are recognised by their task function. */
+        if( ( pxTaskCode == prvIdleTask ) || ( pxTaskCode == prvPassiveIdleTask ) )
+        {
+            pxNewTCB->uxTaskAttributes = taskATTRIBUTE_IS_IDLE;
+        }
+        else
+        {
+            pxNewTCB->uxTaskAttributes = ( UBaseType_t ) 0U;
+        }
+
+        #if ( configUSE_CORE_AFFINITY == 1 )
+        {
+            pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+        }
+        #endif
+    }
+    #endif /* configNUMBER_OF_CORES > 1 */
+
     #if ( portUSING_MPU_WRAPPERS == 1 )
     {
         vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1023,6 +1467,8 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 {
     /* Ensure interrupts don't access the task lists while the lists are being
@@ -1105,6 +1551,61 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         mtCOVERAGE_TEST_MARKER();
     }
 }
+
+#else /* configNUMBER_OF_CORES */
+
+static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+{
+    /* Ensure interrupts don't access the task lists while the lists are being
+     * updated. */
+    taskENTER_CRITICAL();
+    {
+        uxCurrentNumberOfTasks++;
+
+        if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+        {
+            /* This is the first task to be created so do the preliminary
+             * initialisation required. */
+            prvInitialiseTaskLists();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Unlike the single core build pxCurrentTCBs[] is not updated here -
+         * every core starts the scheduler running its own idle task, and the
+         * first yield of the idle tasks gets the application tasks running. */
+
+        uxTaskNumber++;
+
+        #if ( configUSE_TRACE_FACILITY == 1 )
+        {
+            /* Add a counter into the TCB for tracing only. */
+            pxNewTCB->uxTCBNumber = uxTaskNumber;
+        }
+        #endif /* configUSE_TRACE_FACILITY */
+        traceTASK_CREATE( pxNewTCB );
+
+        prvAddTaskToReadyList( pxNewTCB );
+
+        portSETUP_TCB( pxNewTCB );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If the created task is of a higher priority than a task running
+             * on any of the cores then it should run now. */
+            taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -1113,6 +1614,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         TCB_t * pxTCB;
 
+        #if ( configNUMBER_OF_CORES > 1 )
+            BaseType_t xDeleteTCBInIdleTask = pdFALSE;
+        #endif
+
         taskENTER_CRITICAL();
         {
             /* If null is passed in here then it is the calling task that is
@@ -1145,7 +1650,15 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
              * not return. */
             uxTaskNumber++;
 
-            if( pxTCB == pxCurrentTCB )
+            #if ( configNUMBER_OF_CORES == 1 )
+                if( pxTCB == pxCurrentTCB )
+            #else
+
+                /* The task might be running on any of the cores, or about to
+                 * yield a core, in which case it cannot be freed until it has
+                 * been switched out. */
+                if( taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB ) != pdFALSE )
+            #endif
             {
                 /* A task is deleting itself.  This cannot complete within the
                  * task itself, as a context switch to another task is required.
@@ -1168,7 +1681,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * after which it is not possible to yield away from this task -
                  * hence xYieldPending is used to latch that a context switch is
                  * required. */
-                portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+                #if ( configNUMBER_OF_CORES == 1 )
+                    portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+                #else
+                    portPRE_TASK_DELETE_HOOK( pxTCB, &( xYieldPendings[ portGET_CORE_ID() ] ) );
+                    xDeleteTCBInIdleTask = pdTRUE;
+                #endif
             }
             else
             {
@@ -1179,31 +1697,63 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * the task that has just been deleted. */
                 prvResetNextTaskUnblockTime();
             }
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* Force the core running the deleted task to reschedule.  If
+                 * that is the calling core the yield is held pending until the
+                 * critical section is exited. */
+                if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                {
+                    if( pxTCB->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )
+                    {
+                        configASSERT( uxSchedulerSuspended == 0 );
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configNUMBER_OF_CORES > 1 */
         }
         taskEXIT_CRITICAL();
 
         /* If the task is not deleting itself, call prvDeleteTCB from outside of
          * critical section. If a task deletes itself, prvDeleteTCB is called
          * from prvCheckTasksWaitingTermination which is called from Idle task. */
-        if( pxTCB != pxCurrentTCB )
+        #if ( configNUMBER_OF_CORES == 1 )
+            if( pxTCB != pxCurrentTCB )
+        #else
+            if( xDeleteTCBInIdleTask == pdFALSE )
+        #endif
         {
             prvDeleteTCB( pxTCB );
         }
 
         /* Force a reschedule if it is the currently running task that has just
          * been deleted. */
-        if( xSchedulerRunning != pdFALSE )
+        #if ( configNUMBER_OF_CORES == 1 )
         {
-            if( pxTCB == pxCurrentTCB )
+            if( xSchedulerRunning != pdFALSE )
             {
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
+                if( pxTCB == pxCurrentTCB )
+                {
+                    configASSERT( uxSchedulerSuspended == 0 );
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
+        #endif /* configNUMBER_OF_CORES == 1 */
     }
 
 #endif /* INCLUDE_vTaskDelete */
@@ -1219,10 +1769,21 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
         configASSERT( pxPreviousWakeTime );
         configASSERT( ( xTimeIncrement > 0U ) );
-        configASSERT( uxSchedulerSuspended == 0 );
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            configASSERT( uxSchedulerSuspended == 0 );
+        #endif
 
         vTaskSuspendAll();
         {
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* Another core may have had the scheduler suspended until
+                 * this task suspended it, so the check is made here. */
+                configASSERT( uxSchedulerSuspended == 1U );
+            }
+            #endif
+
             /* Minor optimisation.  The tick count cannot change in this
              * block. */
             const TickType_t xConstTickCount = xTickCount;
@@ -1305,9 +1866,20 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         /* A delay time of zero just forces a reschedule. */
         if( xTicksToDelay > ( TickType_t ) 0U )
         {
-            configASSERT( uxSchedulerSuspended == 0 );
+            #if ( configNUMBER_OF_CORES == 1 )
+                configASSERT( uxSchedulerSuspended == 0 );
+            #endif
+
             vTaskSuspendAll();
             {
+                #if ( configNUMBER_OF_CORES > 1 )
+                {
+                    /* Another core may have had the scheduler suspended until
+                     * this task suspended it, so the check is made here. */
+                    configASSERT( uxSchedulerSuspended == 1U );
+                }
+                #endif
+
                 traceTASK_DELAY();
 
                 /* A task that is removed from the event list while the
@@ -1368,7 +1940,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             }
             taskEXIT_CRITICAL();
 
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) ||
+                ( taskLIST_IS_DELAYED_TASK_WHEEL_SLOT( pxStateList ) != pdFALSE ) )
             {
                 /* The task being queried is referenced from one of the Blocked
                  * lists. */
@@ -1428,9 +2001,27 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
             else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
             {
-                /* If the task is not in any other state, it must be in the
-                 * Ready (including pending ready) state. */
-                eReturn = eReady;
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    /* If the task is not in any other state, it must be in the
+                     * Ready (including pending ready) state. */
+                    eReturn = eReady;
+                }
+                #else
+                {
+                    if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                    {
+                        /* The task is running on another core. */
+                        eReturn = eRunning;
+                    }
+                    else
+                    {
+                        /* If the task is not in any other state, it must be in
+                         * the Ready (including pending ready) state. */
+                        eReturn = eReady;
+                    }
+                }
+                #endif /* configNUMBER_OF_CORES */
             }
         }
 
@@ -1487,14 +2078,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
         {
             /* If null is passed in here then it is the priority of the calling
              * task that is being queried. */
             pxTCB = prvGetTCBFromHandle( xTask );
             uxReturn = pxTCB->uxPriority;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
 
         return uxReturn;
     }
@@ -1511,6 +2102,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
         BaseType_t xYieldRequired = pdFALSE;
 
+        #if ( configNUMBER_OF_CORES > 1 )
+            BaseType_t xYieldForTask = pdFALSE;
+        #endif
+
         configASSERT( uxNewPriority < configMAX_PRIORITIES );
 
         /* Ensure the new priority is valid. */
@@ -1547,28 +2142,43 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * priority than the calling task. */
                 if( uxNewPriority > uxCurrentBasePriority )
                 {
-                    if( pxTCB != pxCurrentTCB )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        /* The priority of a task other than the currently
-                         * running task is being raised.  Is the priority being
-                         * raised above that of the running task? */
-                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                        if( pxTCB != pxCurrentTCB )
                         {
-                            xYieldRequired = pdTRUE;
+                            /* The priority of a task other than the currently
+                             * running task is being raised.  Is the priority being
+                             * raised above that of the running task? */
+                            if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                            {
+                                xYieldRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
                         else
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            /* The priority of the running task is being raised,
+                             * but the running task must already be the highest
+                             * priority task able to run so no yield is required. */
                         }
                     }
-                    else
+                    #else /* configNUMBER_OF_CORES */
                     {
-                        /* The priority of the running task is being raised,
-                         * but the running task must already be the highest
-                         * priority task able to run so no yield is required. */
+                        /* The task might now be able to preempt a task running
+                         * on any of the cores, which is checked once its
+                         * priority has been changed. */
+                        xYieldForTask = pdTRUE;
                     }
+                    #endif /* configNUMBER_OF_CORES */
                 }
-                else if( pxTCB == pxCurrentTCB )
+                #if ( configNUMBER_OF_CORES == 1 )
+                    else if( pxTCB == pxCurrentTCB )
+                #else
+                    else if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                #endif
                 {
                     /* Setting the priority of the running task down means
                      * there may now be another task of higher priority that
@@ -1587,6 +2197,17 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * taskRESET_READY_PRIORITY() macro can function correctly. */
                 uxPriorityUsedOnEntry = pxTCB->uxPriority;
 
+                #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+                {
+                    /* The priority being used is the higher of the new base
+                     * priority and the priorities of the tasks waiting for
+                     * mutexes the task holds.  Changing it moves the task within
+                     * its ready list or within the list of tasks waiting for a
+                     * mutex, and is passed on to the holder of that mutex. */
+                    pxTCB->uxBasePriority = uxNewPriority;
+                    ( void ) prvUpdateInheritedPriorities( pxTCB );
+                }
+                #else /* configUSE_PRIORITY_INHERITANCE_CHAINS */
                 #if ( configUSE_MUTEXES == 1 )
                 {
                     /* Only change the priority being used if the task is not
@@ -1647,14 +2268,32 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+                #endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
 
                 if( xYieldRequired != pdFALSE )
                 {
-                    taskYIELD_IF_USING_PREEMPTION();
+                    #if ( configNUMBER_OF_CORES == 1 )
+                        taskYIELD_IF_USING_PREEMPTION();
+                    #else
+                        /* The task having its priority lowered is running,
+                         * possibly on another core. */
+                        #if ( configUSE_PREEMPTION == 1 )
+                            prvYieldCore( pxTCB->xTaskRunState );
+                        #endif
+                    #endif
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    #if ( configNUMBER_OF_CORES > 1 )
+                        if( xYieldForTask != pdFALSE )
+                        {
+                            taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                        }
+                        else
+                    #endif
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
 
                 /* Remove compiler warning about unused variables when the port
@@ -1720,6 +2359,30 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 }
             }
             #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* Force the core running the suspended task to reschedule.  If
+                 * that is the calling core the yield is held pending until the
+                 * critical section is exited. */
+                if( ( xSchedulerRunning != pdFALSE ) && ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE ) )
+                {
+                    if( pxTCB->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )
+                    {
+                        configASSERT( uxSchedulerSuspended == 0 );
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        prvYieldCore( pxTCB->xTaskRunState );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configNUMBER_OF_CORES > 1 */
         }
         taskEXIT_CRITICAL();
 
@@ -1738,6 +2401,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configNUMBER_OF_CORES == 1 )
         if( pxTCB == pxCurrentTCB )
         {
             if( xSchedulerRunning != pdFALSE )
@@ -1769,6 +2433,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         {
             mtCOVERAGE_TEST_MARKER();
         }
+        #endif /* configNUMBER_OF_CORES == 1 */
     }
 
 #endif /* INCLUDE_vTaskSuspend */
@@ -1845,17 +2510,25 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     prvAddTaskToReadyList( pxTCB );
 
                     /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        /* This yield may not cause the task just resumed to run,
-                         * but will leave the lists in the correct state for the
-                         * next yield. */
-                        taskYIELD_IF_USING_PREEMPTION();
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            /* This yield may not cause the task just resumed to run,
+                             * but will leave the lists in the correct state for the
+                             * next yield. */
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                    else
+                    #else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
                     }
+                    #endif /* configNUMBER_OF_CORES */
                 }
                 else
                 {
@@ -1902,7 +2575,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
             {
@@ -1913,22 +2586,43 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 {
                     /* Ready lists can be accessed so move the task from the
                      * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        xYieldRequired = pdTRUE;
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            xYieldRequired = pdTRUE;
 
-                        /* Mark that a yield is pending in case the user is not
-                         * using the return value to initiate a context switch
-                         * from the ISR using portYIELD_FROM_ISR. */
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
+                            /* Mark that a yield is pending in case the user is not
+                             * using the return value to initiate a context switch
+                             * from the ISR using portYIELD_FROM_ISR. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
+                    #endif /* configNUMBER_OF_CORES == 1 */
 
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
+
+                    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+                    {
+                        /* Other cores are made to yield directly.  A yield is
+                         * only reported if the interrupted core has to yield. */
+                        prvYieldForTask( pxTCB );
+
+                        if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) */
                 }
                 else
                 {
@@ -1943,7 +2637,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xYieldRequired;
     }
@@ -1951,12 +2645,135 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static BaseType_t prvCreateIdleTasks( void )
+    {
+        BaseType_t xReturn = pdPASS;
+        BaseType_t xCoreID;
+        UBaseType_t x;
+        char cIdleName[ configMAX_TASK_NAME_LEN ];
+        TaskFunction_t pxIdleTaskFunction;
+
+        for( xCoreID = ( BaseType_t ) 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+        {
+            /* The idle tasks of the cores other than core 0 have the core
+             * number appended to their name.  Space is left for two digits and
+             * the terminator. */
+            for( x = ( UBaseType_t ) 0; x < ( ( UBaseType_t ) configMAX_TASK_NAME_LEN - ( UBaseType_t ) 3U ); x++ )
+            {
+                cIdleName[ x ] = configIDLE_TASK_NAME[ x ];
+
+                if( cIdleName[ x ] == ( char ) 0x00 )
+                {
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( xCoreID > ( BaseType_t ) 0 )
+            {
+                if( xCoreID >= ( BaseType_t ) 10 )
+                {
+                    cIdleName[ x ] = ( char ) ( ( xCoreID / ( BaseType_t ) 10 ) + ( BaseType_t ) '0' );
+                    x++;
+                }
+
+                cIdleName[ x ] = ( char ) ( ( xCoreID % ( BaseType_t ) 10 ) + ( BaseType_t ) '0' );
+                x++;
+            }
+
+            cIdleName[ x ] = ( char ) 0x00;
+
+            /* Core 0 runs the idle task that does the housekeeping. */
+            if( xCoreID == ( BaseType_t ) 0 )
+            {
+                pxIdleTaskFunction = prvIdleTask;
+            }
+            else
+            {
+                pxIdleTaskFunction = prvPassiveIdleTask;
+            }
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+                StackType_t * pxIdleTaskStackBuffer = NULL;
+                uint32_t ulIdleTaskStackSize;
+
+                /* The idle tasks are created using user provided RAM - obtain
+                 * the address of the RAM then create the idle task. */
+                if( xCoreID == ( BaseType_t ) 0 )
+                {
+                    vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+                }
+                else
+                {
+                    vApplicationGetPassiveIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID - ( BaseType_t ) 1 );
+                }
+
+                xIdleTaskHandles[ xCoreID ] = xTaskCreateStatic( pxIdleTaskFunction,
+                                                                 cIdleName,
+                                                                 ulIdleTaskStackSize,
+                                                                 ( void * ) NULL,
+                                                                 portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                                 pxIdleTaskStackBuffer,
+                                                                 pxIdleTaskTCBBuffer );
+
+                if( xIdleTaskHandles[ xCoreID ] != NULL )
+                {
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+            }
+            #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+            {
+                /* The idle tasks are being created using dynamically allocated
+                 * RAM. */
+                xReturn = xTaskCreate( pxIdleTaskFunction,
+                                       cIdleName,
+                                       configMINIMAL_STACK_SIZE,
+                                       ( void * ) NULL,
+                                       portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                       &xIdleTaskHandles[ xCoreID ] );
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+            if( xReturn == pdPASS )
+            {
+                /* Every core starts the scheduler running its own idle task. */
+                xIdleTaskHandles[ xCoreID ]->xTaskRunState = xCoreID;
+                pxCurrentTCBs[ xCoreID ] = xIdleTaskHandles[ xCoreID ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* configNUMBER_OF_CORES > 1 */
+/*-----------------------------------------------------------*/
+
 void vTaskStartScheduler( void )
 {
     BaseType_t xReturn;
 
     /* Add the idle task at the lowest priority. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* One idle task is created for each core. */
+        xReturn = prvCreateIdleTasks();
+    }
+    #elif ( configSUPPORT_STATIC_ALLOCATION == 1 )
     {
         StaticTask_t * pxIdleTaskTCBBuffer = NULL;
         StackType_t * pxIdleTaskStackBuffer = NULL;
@@ -2007,6 +2824,19 @@ void vTaskStartScheduler( void )
     }
     #endif /* configUSE_TIMERS */
 
+    #if ( configUSE_DEFERRED_WORK == 1 )
+    {
+        if( xReturn == pdPASS )
+        {
+            xReturn = xDeferredWorkCreateLanes();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_DEFERRED_WORK */
+
     if( xReturn == pdPASS )
     {
         /* freertos_tasks_c_additions_init() should only be called if the user
@@ -2045,6 +2875,14 @@ void vTaskStartScheduler( void )
          * FreeRTOSConfig.h file. */
         portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+        #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        {
+            /* Run time is accounted from here, starting with the first task. */
+            ulLastRunTimeCounterValue = prvGetRunTimeCounterValue();
+            uxRunTimeContext = taskRUN_TIME_IN_TASK;
+        }
+        #endif
+
         traceTASK_SWITCHED_IN();
 
         /* Setting up the timer tick is hardware specific and thus in the
@@ -2068,7 +2906,11 @@ void vTaskStartScheduler( void )
 
     /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
      * meaning xIdleTaskHandle is not used anywhere else. */
-    ( void ) xIdleTaskHandle;
+    #if ( configNUMBER_OF_CORES == 1 )
+        ( void ) xIdleTaskHandle;
+    #else
+        ( void ) xIdleTaskHandles;
+    #endif
 
     /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
      * from getting optimized out as it is no longer used by the kernel. */
@@ -2087,6 +2929,8 @@ void vTaskEndScheduler( void )
 }
 /*----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 void vTaskSuspendAll( void )
 {
     /* A critical section is not required as the variable is of type
@@ -2105,7 +2949,81 @@ void vTaskSuspendAll( void )
     /* Enforces ordering for ports and optimised compilers that may otherwise place
      * the above increment elsewhere. */
     portMEMORY_BARRIER();
+
+    #if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+    {
+        /* Interrupts do not use the timing variables, and this task cannot be
+         * switched out now the scheduler is suspended. */
+        if( ( uxSchedulerSuspended == ( UBaseType_t ) 1U ) && ( xSchedulerRunning != pdFALSE ) )
+        {
+            pvSchedulerSuspensionSite = portGET_CALL_SITE();
+            ulSchedulerSuspensionStart = portCRITICAL_SECTION_TIMESTAMP();
+            xSchedulerSuspensionTimed = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif
 }
+
+#else /* configNUMBER_OF_CORES */
+
+void vTaskSuspendAll( void )
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    /* This must only be called from within a task. */
+    portASSERT_IF_IN_ISR();
+
+    if( xSchedulerRunning != pdFALSE )
+    {
+        /* The task lock is held for as long as the scheduler is suspended, so
+         * the other cores cannot enter a critical section or switch context
+         * until it is resumed.  Interrupts are masked while the locks are taken
+         * so the calling task cannot be switched out before
+         * uxSchedulerSuspended has been incremented - after that point a
+         * context switch is held pending instead. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+        /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
+         * do not otherwise exhibit real time behaviour. */
+        portSOFTWARE_BARRIER();
+
+        portGET_TASK_LOCK();
+
+        /* If another core asked this task to yield while the lock was being
+         * waited for then let it do so before suspending the scheduler. */
+        if( ( uxSchedulerSuspended == ( UBaseType_t ) 0U ) && ( portGET_CRITICAL_NESTING_COUNT() == 0U ) )
+        {
+            prvCheckForRunStateChange();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* uxSchedulerSuspended is read by interrupts, which only take the ISR
+         * lock. */
+        portGET_ISR_LOCK();
+
+        /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+         * is used to allow calls to vTaskSuspendAll() to nest. */
+        ++uxSchedulerSuspended;
+
+        portRELEASE_ISR_LOCK();
+
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+    else
+    {
+        /* Only the calling core is running, so no locks are needed. */
+        ++uxSchedulerSuspended;
+    }
+}
+
+#endif /* configNUMBER_OF_CORES */
 /*----------------------------------------------------------*/
 
 #if ( configUSE_TICKLESS_IDLE != 0 )
@@ -2119,7 +3037,19 @@ void vTaskSuspendAll( void )
          * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
          * task that are in the Ready state, even though the idle task is
          * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        #if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+        {
+            const uint32_t ulIdlePriorityBit = 1UL << tskIDLE_PRIORITY;
+
+            /* tskIDLE_PRIORITY is in the first word of the bitmap, so if any
+             * other bit of the bitmap is set there are tasks that have a
+             * priority above the idle priority that are in the Ready state. */
+            if( ( ulReadyPriorityGroups > 1UL ) || ( ulReadyPriorities[ 0 ] > ulIdlePriorityBit ) )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
+        #elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
         {
             if( uxTopReadyPriority > tskIDLE_PRIORITY )
             {
@@ -2140,7 +3070,7 @@ void vTaskSuspendAll( void )
                 uxHigherPriorityReadyTasks = pdTRUE;
             }
         }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
+        #endif /* if ( configUSE_READY_PRIORITY_BITMAP == 1 ) */
 
         if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
         {
@@ -2189,6 +3119,35 @@ BaseType_t xTaskResumeAll( void )
     {
         --uxSchedulerSuspended;
 
+        #if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+        {
+            if( ( uxSchedulerSuspended == ( UBaseType_t ) 0U ) && ( xSchedulerSuspensionTimed != pdFALSE ) )
+            {
+                prvRecordSectionLength( pvSchedulerSuspensionSite, pdTRUE, portCRITICAL_SECTION_TIMESTAMP() - ulSchedulerSuspensionStart );
+                xSchedulerSuspensionTimed = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* Drop the hold vTaskSuspendAll() had on the task lock.  The lock
+             * is still held by the critical section. */
+            if( xSchedulerRunning != pdFALSE )
+            {
+                portRELEASE_TASK_LOCK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
         if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
         {
             if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
@@ -2205,14 +3164,23 @@ BaseType_t xTaskResumeAll( void )
 
                     /* If the moved task has a priority higher than or equal to
                      * the current task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        xYieldPending = pdTRUE;
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                    else
+                    #else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The task may be able to preempt any of the cores. */
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
                     }
+                    #endif /* configNUMBER_OF_CORES */
                 }
 
                 if( pxTCB != NULL )
@@ -2239,7 +3207,11 @@ BaseType_t xTaskResumeAll( void )
                         {
                             if( xTaskIncrementTick() != pdFALSE )
                             {
-                                xYieldPending = pdTRUE;
+                                #if ( configNUMBER_OF_CORES == 1 )
+                                    xYieldPending = pdTRUE;
+                                #else
+                                    xYieldPendings[ portGET_CORE_ID() ] = pdTRUE;
+                                #endif
                             }
                             else
                             {
@@ -2257,7 +3229,11 @@ BaseType_t xTaskResumeAll( void )
                     }
                 }
 
-                if( xYieldPending != pdFALSE )
+                #if ( configNUMBER_OF_CORES == 1 )
+                    if( xYieldPending != pdFALSE )
+                #else
+                    if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                #endif
                 {
                     #if ( configUSE_PREEMPTION != 0 )
                     {
@@ -2355,21 +3331,23 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                                                      const char pcNameToQuery[] )
     {
         TCB_t * pxNextTCB;
-        TCB_t * pxFirstTCB;
         TCB_t * pxReturn = NULL;
+        const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+        ListItem_t * pxIterator;
         UBaseType_t x;
         char cNextChar;
         BaseType_t xBreakLoop;
 
-        /* This function is called with the scheduler suspended. */
+        /* This function is called with the scheduler suspended.  The list is
+         * walked from its head rather than with listGET_OWNER_OF_NEXT_ENTRY(),
+         * which would move the list's index - and so change the order in which
+         * the scheduler shares the processor between tasks of equal priority. */
 
         if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
         {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-            do
+            for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
             {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                pxNextTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
                 /* Check each character in the name looking for a match or
                  * mismatch. */
@@ -2407,7 +3385,7 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                     /* The handle has been found. */
                     break;
                 }
-            } while( pxNextTCB != pxFirstTCB );
+            }
         }
         else
         {
@@ -2456,6 +3434,20 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                 pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
             }
 
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                UBaseType_t uxLevel, uxSlot;
+
+                for( uxLevel = 0; ( uxLevel < ( UBaseType_t ) configDELAYED_TASK_WHEEL_LEVELS ) && ( pxTCB == NULL ); uxLevel++ )
+                {
+                    for( uxSlot = 0; ( uxSlot < taskWHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ), pcNameToQuery );
+                    }
+                }
+            }
+            #endif
+
             #if ( INCLUDE_vTaskSuspend == 1 )
             {
                 if( pxTCB == NULL )
@@ -2510,6 +3502,20 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                 uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
                 uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
 
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    UBaseType_t uxLevel, uxSlot;
+
+                    for( uxLevel = 0; uxLevel < ( UBaseType_t ) configDELAYED_TASK_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0; uxSlot < taskWHEEL_SLOTS; uxSlot++ )
+                        {
+                            uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ), eBlocked );
+                        }
+                    }
+                }
+                #endif
+
                 #if ( INCLUDE_vTaskDelete == 1 )
                 {
                     /* Fill in an TaskStatus_t structure with information on
@@ -2526,7 +3532,20 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                 }
                 #endif
 
-                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+                {
+                    if( pulTotalRunTime != NULL )
+                    {
+                        /* Entering the critical section charges the run time
+                         * that has passed, bringing ulTotalRunTime up to date. */
+                        taskENTER_CRITICAL();
+                        {
+                            *pulTotalRunTime = ulTotalRunTime;
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                }
+                #elif ( configGENERATE_RUN_TIME_STATS == 1 )
                 {
                     if( pulTotalRunTime != NULL )
                     {
@@ -2561,13 +3580,37 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
-    TaskHandle_t xTaskGetIdleTaskHandle( void )
-    {
-        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-         * started, then xIdleTaskHandle will be NULL. */
-        configASSERT( ( xIdleTaskHandle != NULL ) );
-        return xIdleTaskHandle;
-    }
+    #if ( configNUMBER_OF_CORES == 1 )
+
+        TaskHandle_t xTaskGetIdleTaskHandle( void )
+        {
+            /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+             * started, then xIdleTaskHandle will be NULL. */
+            configASSERT( ( xIdleTaskHandle != NULL ) );
+            return xIdleTaskHandle;
+        }
+
+    #else /* configNUMBER_OF_CORES */
+
+        TaskHandle_t xTaskGetIdleTaskHandle( void )
+        {
+            /* The handle of the task running prvIdleTask(), which is the one
+             * that cleans up after deleted tasks. */
+            return xTaskGetIdleTaskHandleForCore( 0 );
+        }
+/*-----------------------------------------------------------*/
+
+        TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
+        {
+            configASSERT( taskVALID_CORE_ID( xCoreID ) == pdTRUE );
+
+            /* If xTaskGetIdleTaskHandleForCore() is called before the scheduler
+             * has been started, then xIdleTaskHandles[] will be NULL. */
+            configASSERT( ( xIdleTaskHandles[ xCoreID ] != NULL ) );
+            return xIdleTaskHandles[ xCoreID ];
+        }
+
+    #endif /* configNUMBER_OF_CORES */
 
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
@@ -2619,12 +3662,22 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 
     /* Must not be called with the scheduler suspended as the implementation
      * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == 0 );
+    #if ( configNUMBER_OF_CORES == 1 )
+        configASSERT( uxSchedulerSuspended == 0 );
+    #endif
 
     /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
      * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
     vTaskSuspendAll();
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* Another core may have had the scheduler suspended until this task
+         * suspended it, so the check is made here. */
+        configASSERT( uxSchedulerSuspended == 1U );
+    }
+    #endif
+
     /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
     taskENTER_CRITICAL();
     {
@@ -2688,19 +3741,34 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                  * switch if preemption is turned off. */
                 #if ( configUSE_PREEMPTION == 1 )
                 {
-                    /* Preemption is on, but a context switch should only be
-                     * performed if the unblocked task has a priority that is
-                     * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        /* Pend the yield to be performed when the scheduler
-                         * is unsuspended. */
-                        xYieldPending = pdTRUE;
+                        /* Preemption is on, but a context switch should only be
+                         * performed if the unblocked task has a priority that is
+                         * higher than the currently executing task. */
+                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        {
+                            /* Pend the yield to be performed when the scheduler
+                             * is unsuspended. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-                    else
+                    #else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The unblocked task may be able to preempt any of the
+                         * cores.  prvYieldForTask() must be called from a
+                         * critical section. */
+                        taskENTER_CRITICAL();
+                        {
+                            prvYieldForTask( pxTCB );
+                        }
+                        taskEXIT_CRITICAL();
                     }
+                    #endif /* configNUMBER_OF_CORES */
                 }
                 #endif /* configUSE_PREEMPTION */
             }
@@ -2721,8 +3789,19 @@ BaseType_t xTaskIncrementTick( void )
 {
     TCB_t * pxTCB;
     TickType_t xItemValue;
+    List_t * volatile pxExpiredList;
     BaseType_t xSwitchRequired = pdFALSE;
 
+    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+        BaseType_t xCoreID;
+        BaseType_t xYieldRequiredForCore[ configNUMBER_OF_CORES ] = { pdFALSE };
+
+        #if ( configUSE_TIME_SLICING == 1 )
+            BaseType_t x;
+            UBaseType_t uxRunningAtPriority;
+        #endif
+    #endif
+
     /* Called by the portable layer each time a tick interrupt occurs.
      * Increments the tick then checks to see if the new tick value will cause any
      * tasks to be unblocked. */
@@ -2753,16 +3832,40 @@ BaseType_t xTaskIncrementTick( void )
          * look any further down the list. */
         if( xConstTickCount >= xNextTaskUnblockTime )
         {
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                /* Every task in the wheel slot for this tick has a wake time
+                 * equal to this tick, so the loop below unblocks all of
+                 * them. */
+                pxExpiredList = prvDelayedWheelAdvance( xConstTickCount );
+            }
+            #else
+            {
+                pxExpiredList = pxDelayedTaskList;
+            }
+            #endif
+
             for( ; ; )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                if( listLIST_IS_EMPTY( pxExpiredList ) != pdFALSE )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                    {
+                        /* There are no more tasks to unblock on this tick,
+                         * find the next tick on which the wheel needs
+                         * attention. */
+                        xNextTaskUnblockTime = prvDelayedWheelNextEventTime( xConstTickCount );
+                    }
+                    #else
+                    {
+                        /* The delayed list is empty.  Set xNextTaskUnblockTime
+                         * to the maximum possible value so it is extremely
+                         * unlikely that the
+                         * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                         * next time through. */
+                        xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                    #endif
                     break;
                 }
                 else
@@ -2771,7 +3874,7 @@ BaseType_t xTaskIncrementTick( void )
                      * item at the head of the delayed list.  This is the time
                      * at which the task at the head of the delayed list must
                      * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxExpiredList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
                     xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
 
                     if( xConstTickCount < xItemValue )
@@ -2819,14 +3922,25 @@ BaseType_t xTaskIncrementTick( void )
                          * processing time (which happens when both
                          * preemption and time slicing are on) is
                          * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        #if ( configNUMBER_OF_CORES == 1 )
                         {
-                            xSwitchRequired = pdTRUE;
+                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
-                        else
+                        #else
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            /* The core to preempt, if any, is asked to yield
+                             * directly.  If that is the calling core
+                             * xYieldPendings[] is set and picked up below. */
+                            prvYieldForTask( pxTCB );
                         }
+                        #endif /* configNUMBER_OF_CORES */
                     }
                     #endif /* configUSE_PREEMPTION */
                 }
@@ -2838,14 +3952,50 @@ BaseType_t xTaskIncrementTick( void )
          * writer has not explicitly turned time slicing off. */
         #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                xSwitchRequired = pdTRUE;
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* The running tasks remain referenced from their ready lists,
+                 * so a core only needs to give up its time slice if the ready
+                 * list of its task holds more tasks than are running at that
+                 * priority. */
+                for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    uxRunningAtPriority = ( UBaseType_t ) 0U;
+
+                    for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+                    {
+                        if( pxCurrentTCBs[ x ]->uxPriority == pxCurrentTCBs[ xCoreID ]->uxPriority )
+                        {
+                            uxRunningAtPriority++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ) ) > uxRunningAtPriority )
+                    {
+                        xYieldRequiredForCore[ xCoreID ] = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
+            #endif /* configNUMBER_OF_CORES */
         }
         #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
@@ -2866,14 +4016,41 @@ BaseType_t xTaskIncrementTick( void )
 
         #if ( configUSE_PREEMPTION == 1 )
         {
-            if( xYieldPending != pdFALSE )
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                xSwitchRequired = pdTRUE;
+                if( xYieldPending != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* Only the calling core switches context on return from the
+                 * tick interrupt, the other cores are interrupted. */
+                for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( ( xYieldRequiredForCore[ xCoreID ] != pdFALSE ) || ( xYieldPendings[ xCoreID ] != pdFALSE ) )
+                    {
+                        if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            prvYieldCore( xCoreID );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
+            #endif /* configNUMBER_OF_CORES */
         }
         #endif /* configUSE_PREEMPTION */
     }
@@ -2961,11 +4138,11 @@ BaseType_t xTaskIncrementTick( void )
 
         /* Save the hook function in the TCB.  A critical section is required as
          * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
             xReturn = pxTCB->pxTaskTag;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
@@ -3006,6 +4183,8 @@ BaseType_t xTaskIncrementTick( void )
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 void vTaskSwitchContext( void )
 {
     if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
@@ -3019,7 +4198,15 @@ void vTaskSwitchContext( void )
         xYieldPending = pdFALSE;
         traceTASK_SWITCHED_OUT();
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        {
+            /* Charge the task being switched out.  Ports can switch tasks from
+             * within an interrupt or a critical section, so remember where run
+             * time was being charged to restore it when the task runs again. */
+            prvChargeRunTime();
+            pxCurrentTCB->uxRunTimeContext = uxRunTimeContext;
+        }
+        #elif ( configGENERATE_RUN_TIME_STATS == 1 )
         {
             #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
                 portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
@@ -3047,6 +4234,15 @@ void vTaskSwitchContext( void )
         }
         #endif /* configGENERATE_RUN_TIME_STATS */
 
+        #if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+        {
+            /* Ports that switch tasks with interrupts masked leave the task
+             * switched in to exit the critical section, so time it up to the
+             * switch. */
+            vTaskCriticalSectionHistogramExit();
+        }
+        #endif
+
         /* Check for stack overflow, if configured. */
         taskCHECK_FOR_STACK_OVERFLOW();
 
@@ -3062,6 +4258,12 @@ void vTaskSwitchContext( void )
         taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
         traceTASK_SWITCHED_IN();
 
+        #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        {
+            uxRunTimeContext = pxCurrentTCB->uxRunTimeContext;
+        }
+        #endif
+
         /* After the new task is switched in, update the global errno. */
         #if ( configUSE_POSIX_ERRNO == 1 )
         {
@@ -3078,2220 +4280,4348 @@ void vTaskSwitchContext( void )
         #endif
     }
 }
-/*-----------------------------------------------------------*/
-
-void vTaskPlaceOnEventList( List_t * const pxEventList,
-                            const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
 
-    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
-
-    /* Place the event list item of the TCB in the appropriate event list.
-     * This is placed in the list in priority order so the highest priority task
-     * is the first to be woken by the event.
-     *
-     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
-     * Normally, the xItemValue of a TCB's ListItem_t members is:
-     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
-     * Therefore, the event list is sorted in descending priority order.
-     *
-     * The queue that contains the event list is locked, preventing
-     * simultaneous access from interrupts. */
-    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+#else /* configNUMBER_OF_CORES */
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+static void prvYieldCore( BaseType_t xCoreID )
+{
+    /* This must be called with the ISR lock held, either from a critical
+     * section or from vTaskSwitchContext(). */
+    if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+    {
+        /* The calling core is in a critical section, so the yield is held
+         * pending until the critical section is exited. */
+        xYieldPendings[ xCoreID ] = pdTRUE;
+    }
+    else if( pxCurrentTCBs[ xCoreID ]->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD )
+    {
+        /* Interrupt the other core, unless it has already been asked to yield
+         * and not yet done so. */
+        portYIELD_CORE( xCoreID );
+        pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_SCHEDULED_TO_YIELD;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 }
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
-                                     const TickType_t xItemValue,
-                                     const TickType_t xTicksToWait )
+static void prvYieldForTask( const TCB_t * pxTCB )
 {
-    configASSERT( pxEventList );
-
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event groups implementation. */
-    configASSERT( uxSchedulerSuspended != 0 );
-
-    /* Store the item value in the event list item.  It is safe to access the
-     * event list item here as interrupts won't access the event list item of a
-     * task that is not in the Blocked state. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+    BaseType_t xLowestPriorityToPreempt;
+    BaseType_t xCurrentCoreTaskPriority;
+    BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+    BaseType_t xCoreID;
 
-    /* Place the event list item of the TCB at the end of the appropriate event
-     * list.  It is safe to access the event list here because it is part of an
-     * event group implementation - and interrupts don't access event groups
-     * directly (instead they access them indirectly by pending function calls to
-     * the task level). */
-    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+        BaseType_t xYieldCount = 0;
+    #endif
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
-/*-----------------------------------------------------------*/
+    /* This must be called from a critical section. */
+    configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
 
-#if ( configUSE_TIMERS == 1 )
+    #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
 
-    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
-                                          TickType_t xTicksToWait,
-                                          const BaseType_t xWaitIndefinitely )
+        /* No task should yield for this one if it is of a lower priority than
+         * the tasks that are already allowed to run. */
+        if( pxTCB->uxPriority >= uxTopReadyPriority )
+    #else
+        /* A task that is already running does not need a core. */
+        if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
+    #endif
     {
-        configASSERT( pxEventList );
-
-        /* This function should not be called by application code hence the
-         * 'Restricted' in its name.  It is not part of the public API.  It is
-         * designed for use by kernel code, and has special calling requirements -
-         * it should be called with the scheduler suspended. */
+        /* Only a core running a task of a lower priority than pxTCB can be
+         * preempted.  The idle tasks are treated as having a priority one below
+         * tskIDLE_PRIORITY, so a core running an idle task is preempted in
+         * preference to a core running an application task of the idle
+         * priority - hence xLowestPriorityToPreempt can go down to -1. */
+        xLowestPriorityToPreempt = ( BaseType_t ) pxTCB->uxPriority;
+        --xLowestPriorityToPreempt;
 
-
-        /* Place the event list item of the TCB in the appropriate event list.
-         * In this case it is assume that this is the only task that is going to
-         * be waiting on this event list, so the faster vListInsertEnd() function
-         * can be used in place of vListInsert. */
-        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
-
-        /* If the task should block indefinitely then set the block time to a
-         * value that will be recognised as an indefinite delay inside the
-         * prvAddCurrentTaskToDelayedList() function. */
-        if( xWaitIndefinitely != pdFALSE )
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
         {
-            xTicksToWait = portMAX_DELAY;
-        }
-
-        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
-        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
-    }
-
-#endif /* configUSE_TIMERS */
-/*-----------------------------------------------------------*/
-
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
-{
-    TCB_t * pxUnblockedTCB;
-    BaseType_t xReturn;
+            xCurrentCoreTaskPriority = ( BaseType_t ) pxCurrentTCBs[ xCoreID ]->uxPriority;
 
-    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
-     * called from a critical section within an ISR. */
+            if( ( pxCurrentTCBs[ xCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+            {
+                xCurrentCoreTaskPriority = xCurrentCoreTaskPriority - ( BaseType_t ) 1;
+            }
 
-    /* The event list is sorted in priority order, so the first in the list can
-     * be removed as it is known to be the highest priority.  Remove the TCB from
-     * the delayed list, and add it to the ready list.
-     *
-     * If an event is for a queue that is locked then this function will never
-     * get called - the lock count on the queue will get modified instead.  This
-     * means exclusive access to the event list is guaranteed here.
-     *
-     * This function assumes that a check has already been made to ensure that
-     * pxEventList is not empty. */
-    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+            /* Cores that are already going to reschedule are skipped. */
+            if( ( taskTASK_IS_RUNNING( pxCurrentTCBs[ xCoreID ] ) != pdFALSE ) && ( xYieldPendings[ xCoreID ] == pdFALSE ) )
+            {
+                #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                    if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
+                #endif
+                {
+                    if( xCurrentCoreTaskPriority <= xLowestPriorityToPreempt )
+                    {
+                        #if ( configUSE_CORE_AFFINITY == 1 )
+                            if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                        #endif
+                        {
+                            xLowestPriorityToPreempt = xCurrentCoreTaskPriority;
+                            xLowestPriorityCore = xCoreID;
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-    {
-        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-        prvAddTaskToReadyList( pxUnblockedTCB );
+                #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                {
+                    /* Only tasks of one priority can run at a time, so every
+                     * core running an application task of a lower priority
+                     * than pxTCB must yield. */
+                    if( ( xCurrentCoreTaskPriority > ( ( BaseType_t ) tskIDLE_PRIORITY - 1 ) ) &&
+                        ( xCurrentCoreTaskPriority < ( BaseType_t ) pxTCB->uxPriority ) )
+                    {
+                        prvYieldCore( xCoreID );
+                        xYieldCount++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configRUN_MULTIPLE_PRIORITIES == 0 */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+            if( ( xYieldCount == 0 ) && ( xLowestPriorityCore >= 0 ) )
+        #else
+            if( xLowestPriorityCore >= 0 )
+        #endif
         {
-            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-             * might be set to the blocked task's time out time.  If the task is
-             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-             * normally left unchanged, because it is automatically reset to a new
-             * value when the tick count equals xNextTaskUnblockTime.  However if
-             * tickless idling is used it might be more important to enter sleep mode
-             * at the earliest possible time - so reset xNextTaskUnblockTime here to
-             * ensure it is updated at the earliest possible time. */
-            prvResetNextTaskUnblockTime();
+            prvYieldCore( xLowestPriorityCore );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif
-    }
-    else
-    {
-        /* The delayed and ready lists cannot be accessed, so hold this task
-         * pending until the scheduler is resumed. */
-        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
-    }
-
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
-    {
-        /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
-        xReturn = pdTRUE;
-
-        /* Mark that a yield is pending in case the user is not using the
-         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-        xYieldPending = pdTRUE;
     }
     else
     {
-        xReturn = pdFALSE;
+        mtCOVERAGE_TEST_MARKER();
     }
-
-    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
-                                        const TickType_t xItemValue )
+static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
 {
-    TCB_t * pxUnblockedTCB;
-
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event flags implementation. */
-    configASSERT( uxSchedulerSuspended != pdFALSE );
+    UBaseType_t uxCurrentPriority = uxTopReadyPriority;
+    BaseType_t xTaskScheduled = pdFALSE;
+    BaseType_t xDecrementTopPriority = pdTRUE;
+    TCB_t * pxTCB;
+    const ListItem_t * pxEndMarker;
+    ListItem_t * pxIterator;
 
-    /* Store the new item value in the event list. */
-    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        TCB_t * pxPreviousTCB = NULL;
+    #endif
 
-    /* Remove the event list form the event flag.  Interrupts do not access
-     * event flags. */
-    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( pxEventListItem );
+    #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+        BaseType_t xPriorityDropped = pdFALSE;
+        BaseType_t x;
+    #endif
 
-    #if ( configUSE_TICKLESS_IDLE != 0 )
+    /* The task running on this core is still referenced from its ready list
+     * if it is yielding rather than blocking.  Move it to the end of that list
+     * so the other tasks of the same priority are considered first, in the
+     * same way listGET_OWNER_OF_NEXT_ENTRY() shares the processor between
+     * tasks of equal priority in the single core build. */
+    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ), &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) ) != pdFALSE )
     {
-        /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-         * might be set to the blocked task's time out time.  If the task is
-         * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-         * normally left unchanged, because it is automatically reset to a new
-         * value when the tick count equals xNextTaskUnblockTime.  However if
-         * tickless idling is used it might be more important to enter sleep mode
-         * at the earliest possible time - so reset xNextTaskUnblockTime here to
-         * ensure it is updated at the earliest possible time. */
-        prvResetNextTaskUnblockTime();
+        ( void ) uxListRemove( &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) );
+        vListInsertEnd( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ), &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) );
     }
-    #endif
-
-    /* Remove the task from the delayed list and add it to the ready list.  The
-     * scheduler is suspended so interrupts will not be accessing the ready
-     * lists. */
-    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-    prvAddTaskToReadyList( pxUnblockedTCB );
-
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    else
     {
-        /* The unblocked task has a priority above that of the calling task, so
-         * a context switch is required.  This function is called with the
-         * scheduler suspended so xYieldPending is set so the context switch
-         * occurs immediately that the scheduler is resumed (unsuspended). */
-        xYieldPending = pdTRUE;
+        mtCOVERAGE_TEST_MARKER();
     }
-}
-/*-----------------------------------------------------------*/
 
-void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    configASSERT( pxTimeOut );
-    taskENTER_CRITICAL();
+    while( xTaskScheduled == pdFALSE )
     {
-        pxTimeOut->xOverflowCount = xNumOfOverflows;
-        pxTimeOut->xTimeOnEntering = xTickCount;
-    }
-    taskEXIT_CRITICAL();
-}
-/*-----------------------------------------------------------*/
+        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+        {
+            if( uxCurrentPriority < uxTopReadyPriority )
+            {
+                /* No task other than an idle task can run at a priority below
+                 * that of the tasks already running on the other cores. */
+                uxCurrentPriority = tskIDLE_PRIORITY;
+            }
+        }
+        #endif
 
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    /* For internal use only as it does not use a critical section. */
-    pxTimeOut->xOverflowCount = xNumOfOverflows;
-    pxTimeOut->xTimeOnEntering = xTickCount;
-}
-/*-----------------------------------------------------------*/
+        if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxCurrentPriority ] ) ) == pdFALSE )
+        {
+            /* There is a ready task at this priority, so uxTopReadyPriority
+             * must not be lowered any further. */
+            xDecrementTopPriority = pdFALSE;
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                 TickType_t * const pxTicksToWait )
-{
-    BaseType_t xReturn;
+            pxEndMarker = listGET_END_MARKER( &( pxReadyTasksLists[ uxCurrentPriority ] ) );
 
-    configASSERT( pxTimeOut );
-    configASSERT( pxTicksToWait );
+            for( pxIterator = listGET_HEAD_ENTRY( &( pxReadyTasksLists[ uxCurrentPriority ] ) ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-    taskENTER_CRITICAL();
-    {
-        /* Minor optimisation.  The tick count cannot change in this block. */
-        const TickType_t xConstTickCount = xTickCount;
-        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+                #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                {
+                    /* When falling back to the idle priority only the idle
+                     * tasks themselves can be selected. */
+                    if( ( uxCurrentPriority < uxTopReadyPriority ) && ( ( pxTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0U ) )
+                    {
+                        continue;
+                    }
+                }
+                #endif
 
-        #if ( INCLUDE_xTaskAbortDelay == 1 )
-            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+                if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                {
+                    #if ( configUSE_CORE_AFFINITY == 1 )
+                        if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                    #endif
+                    {
+                        /* The task is not running on any core, so swap it in. */
+                        pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+
+                        #if ( configUSE_CORE_AFFINITY == 1 )
+                        {
+                            pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                        }
+                        #endif
+
+                        pxTCB->xTaskRunState = xCoreID;
+                        pxCurrentTCBs[ xCoreID ] = pxTCB;
+                        xTaskScheduled = pdTRUE;
+                    }
+                }
+                else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+                {
+                    configASSERT( ( pxTCB->xTaskRunState == xCoreID ) || ( pxTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) );
+
+                    #if ( configUSE_CORE_AFFINITY == 1 )
+                        if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                    #endif
+                    {
+                        /* The task is already running on this core and is
+                         * still the one that should be. */
+                        pxTCB->xTaskRunState = xCoreID;
+                        xTaskScheduled = pdTRUE;
+                    }
+                }
+                else
+                {
+                    /* The task is running on another core. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xTaskScheduled != pdFALSE )
+                {
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            if( xDecrementTopPriority != pdFALSE )
             {
-                /* The delay was aborted, which is not the same as a time out,
-                 * but has the same result. */
-                pxCurrentTCB->ucDelayAborted = pdFALSE;
-                xReturn = pdTRUE;
+                uxTopReadyPriority--;
+
+                #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                {
+                    xPriorityDropped = pdTRUE;
+                }
+                #endif
             }
             else
-        #endif
-
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            if( *pxTicksToWait == portMAX_DELAY )
             {
-                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
-                 * specified is the maximum block time then the task should block
-                 * indefinitely, and therefore never time out. */
-                xReturn = pdFALSE;
+                mtCOVERAGE_TEST_MARKER();
             }
-            else
-        #endif
-
-        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
-        {
-            /* The tick count is greater than the time at which
-             * vTaskSetTimeout() was called, but has also overflowed since
-             * vTaskSetTimeOut() was called.  It must have wrapped all the way
-             * around and gone past again. This passed since vTaskSetTimeout()
-             * was called. */
-            xReturn = pdTRUE;
-            *pxTicksToWait = ( TickType_t ) 0;
         }
-        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+
+        /* An idle task is always available to be selected at the idle
+         * priority, so the loop ends there at the latest. */
+        if( uxCurrentPriority > tskIDLE_PRIORITY )
         {
-            /* Not a genuine timeout. Adjust parameters for time remaining. */
-            *pxTicksToWait -= xElapsedTime;
-            vTaskInternalSetTimeOutState( pxTimeOut );
-            xReturn = pdFALSE;
+            uxCurrentPriority--;
         }
         else
         {
-            *pxTicksToWait = ( TickType_t ) 0;
-            xReturn = pdTRUE;
+            break;
         }
     }
-    taskEXIT_CRITICAL();
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
-
-void vTaskMissedYield( void )
-{
-    xYieldPending = pdTRUE;
-}
-/*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+    configASSERT( xTaskScheduled != pdFALSE );
 
-    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
     {
-        UBaseType_t uxReturn;
-        TCB_t const * pxTCB;
-
-        if( xTask != NULL )
+        if( xPriorityDropped != pdFALSE )
         {
-            pxTCB = xTask;
-            uxReturn = pxTCB->uxTaskNumber;
+            /* The last of the higher priority tasks has stopped running, so the
+             * ready tasks it was keeping off the other cores can now run.  Make
+             * the other cores that are running idle tasks reschedule. */
+            for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+            {
+                if( ( x != xCoreID ) && ( ( pxCurrentTCBs[ x ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U ) )
+                {
+                    prvYieldCore( x );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
         }
         else
         {
-            uxReturn = 0U;
+            mtCOVERAGE_TEST_MARKER();
         }
-
-        return uxReturn;
     }
+    #endif /* configRUN_MULTIPLE_PRIORITIES == 0 */
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    void vTaskSetTaskNumber( TaskHandle_t xTask,
-                             const UBaseType_t uxHandle )
-    {
-        TCB_t * pxTCB;
-
-        if( xTask != NULL )
-        {
-            pxTCB = xTask;
-            pxTCB->uxTaskNumber = uxHandle;
-        }
-    }
-
-#endif /* configUSE_TRACE_FACILITY */
-
-/*
- * -----------------------------------------------------------
- * The Idle task.
- * ----------------------------------------------------------
- *
- * The portTASK_FUNCTION() macro is used to allow port/compiler specific
- * language extensions.  The equivalent prototype for this function is:
- *
- * void prvIdleTask( void *pvParameters );
- *
- */
-static portTASK_FUNCTION( prvIdleTask, pvParameters )
-{
-    /* Stop warnings. */
-    ( void ) pvParameters;
-
-    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
-     * SCHEDULER IS STARTED. **/
-
-    /* In case a task that has a secure context deletes itself, in which case
-     * the idle task is responsible for deleting the task's secure context, if
-     * any. */
-    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
-
-    for( ; ; )
+    #if ( configUSE_CORE_AFFINITY == 1 )
     {
-        /* See if any tasks have deleted themselves - if so then the idle task
-         * is responsible for freeing the deleted task's TCB and stack. */
-        prvCheckTasksWaitingTermination();
-
-        #if ( configUSE_PREEMPTION == 0 )
-        {
-            /* If we are not using preemption we keep forcing a task switch to
-             * see if any other task has become available.  If we are using
-             * preemption we don't need to do this as any task becoming available
-             * will automatically get the processor anyway. */
-            taskYIELD();
-        }
-        #endif /* configUSE_PREEMPTION */
+        if( ( pxPreviousTCB != NULL ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+        {
+            /* A ready task was just moved off this core.  See if it can preempt
+             * a lower priority task on one of the other cores it is allowed to
+             * run on. */
+            UBaseType_t uxCoreMap = pxPreviousTCB->uxCoreAffinityMask;
+            BaseType_t xLowestPriority = ( BaseType_t ) pxPreviousTCB->uxPriority;
+            BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+            BaseType_t xTaskPriority;
+            BaseType_t x;
+
+            if( ( pxPreviousTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+            {
+                xLowestPriority = xLowestPriority - ( BaseType_t ) 1;
+            }
 
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
-        {
-            /* When using preemption tasks of equal priority will be
-             * timesliced.  If a task that is sharing the idle priority is ready
-             * to run then the idle task should yield before the end of the
-             * timeslice.
-             *
-             * A critical region is not required here as we are just reading from
-             * the list, and an occasional incorrect value will not matter.  If
-             * the ready list at the idle priority contains more than one task
-             * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+            if( ( uxCoreMap & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
             {
-                taskYIELD();
+                /* The task was preempted rather than moved off this core by an
+                 * affinity change.  The new task of this core would already
+                 * have preempted a lower priority task on any of the cores it
+                 * is allowed to run on, so only the cores the new task is not
+                 * allowed to run on need to be looked at. */
+                uxCoreMap &= ~( pxCurrentTCBs[ xCoreID ]->uxCoreAffinityMask );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
-
-        #if ( configUSE_IDLE_HOOK == 1 )
-        {
-            extern void vApplicationIdleHook( void );
-
-            /* Call the user defined function from within the idle task.  This
-             * allows the application designer to add background functionality
-             * without the overhead of a separate task.
-             * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
-             * CALL A FUNCTION THAT MIGHT BLOCK. */
-            vApplicationIdleHook();
-        }
-        #endif /* configUSE_IDLE_HOOK */
-
-        /* This conditional compilation should use inequality to 0, not equality
-         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
-         * user defined low power mode  implementations require
-         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
-        #if ( configUSE_TICKLESS_IDLE != 0 )
-        {
-            TickType_t xExpectedIdleTime;
-
-            /* It is not desirable to suspend then resume the scheduler on
-             * each iteration of the idle task.  Therefore, a preliminary
-             * test of the expected idle time is performed without the
-             * scheduler suspended.  The result here is not necessarily
-             * valid. */
-            xExpectedIdleTime = prvGetExpectedIdleTime();
 
-            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+            for( x = ( ( BaseType_t ) configNUMBER_OF_CORES - 1 ); x >= ( BaseType_t ) 0; x-- )
             {
-                vTaskSuspendAll();
+                if( ( uxCoreMap & ( ( UBaseType_t ) 1U << ( UBaseType_t ) x ) ) != 0U )
                 {
-                    /* Now the scheduler is suspended, the expected idle
-                     * time can be sampled again, and this time its value can
-                     * be used. */
-                    configASSERT( xNextTaskUnblockTime >= xTickCount );
-                    xExpectedIdleTime = prvGetExpectedIdleTime();
+                    xTaskPriority = ( BaseType_t ) pxCurrentTCBs[ x ]->uxPriority;
 
-                    /* Define the following macro to set xExpectedIdleTime to 0
-                     * if the application does not want
-                     * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
-                    configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+                    if( ( pxCurrentTCBs[ x ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+                    {
+                        xTaskPriority = xTaskPriority - ( BaseType_t ) 1;
+                    }
 
-                    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                    if( ( xTaskPriority < xLowestPriority ) &&
+                        ( taskTASK_IS_RUNNING( pxCurrentTCBs[ x ] ) != pdFALSE ) &&
+                        ( xYieldPendings[ x ] == pdFALSE ) )
                     {
-                        traceLOW_POWER_IDLE_BEGIN();
-                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
-                        traceLOW_POWER_IDLE_END();
+                        xLowestPriority = xTaskPriority;
+                        xLowestPriorityCore = x;
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                ( void ) xTaskResumeAll();
+            }
+
+            if( xLowestPriorityCore >= 0 )
+            {
+                prvYieldCore( xLowestPriorityCore );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configUSE_TICKLESS_IDLE */
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
+    #endif /* configUSE_CORE_AFFINITY == 1 */
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
-
-    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+void vTaskSwitchContext( BaseType_t xCoreID )
+{
+    /* The task lock is taken first, as it is always taken before the ISR
+     * lock.  Taking the task lock means this core waits here if another core
+     * has suspended the scheduler, rather than selecting a task while the
+     * other core still expects the task lists to be left alone.  Only if this
+     * core suspended the scheduler itself is the switch held pending. */
+    portGET_TASK_LOCK();
+    portGET_ISR_LOCK();
     {
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            /* The idle task exists in addition to the application tasks. */
-            const UBaseType_t uxNonApplicationTasks = 1;
-        #endif /* INCLUDE_vTaskSuspend */
-
-        eSleepModeStatus eReturn = eStandardSleep;
-
-        /* This function must be called from a critical section. */
+        /* Unlike the single core build, a context switch is never performed
+         * from within a critical section. */
+        configASSERT( portGET_CRITICAL_NESTING_COUNT() == 0U );
 
-        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
-        {
-            /* A task was made ready while the scheduler was suspended. */
-            eReturn = eAbortSleep;
-        }
-        else if( xYieldPending != pdFALSE )
+        if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
         {
-            /* A yield was pended while the scheduler was suspended. */
-            eReturn = eAbortSleep;
+            /* The scheduler is currently suspended - do not allow a context
+             * switch. */
+            xYieldPendings[ xCoreID ] = pdTRUE;
         }
-        else if( xPendedTicks != 0 )
+        else
         {
-            /* A tick interrupt has already occurred but was held pending
-             * because the scheduler is suspended. */
-            eReturn = eAbortSleep;
-        }
+            xYieldPendings[ xCoreID ] = pdFALSE;
+            traceTASK_SWITCHED_OUT();
 
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            else if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
             {
-                /* If all the tasks are in the suspended list (which might mean they
-                 * have an infinite block time rather than actually being suspended)
-                 * then it is safe to turn all clocks off and just wait for external
-                 * interrupts. */
-                eReturn = eNoTasksWaitingTimeout;
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                #else
+                    ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                /* Add the amount of time the task has been running to the
+                 * accumulated time so far.  The time the task started running
+                 * was stored in ulTaskSwitchedInTime[] for this core. */
+                if( ulTotalRunTime > ulTaskSwitchedInTime[ xCoreID ] )
+                {
+                    pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime[ xCoreID ] );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulTaskSwitchedInTime[ xCoreID ] = ulTotalRunTime;
             }
-        #endif /* INCLUDE_vTaskSuspend */
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+            #endif /* configGENERATE_RUN_TIME_STATS */
 
-        return eReturn;
-    }
+            /* Check for stack overflow, if configured. */
+            taskCHECK_FOR_STACK_OVERFLOW();
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*-----------------------------------------------------------*/
+            /* Before the currently running task is switched out, save its errno. */
+            #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                pxCurrentTCBs[ xCoreID ]->iTaskErrno = FreeRTOS_errno;
+            }
+            #endif
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+            prvSelectHighestPriorityTask( xCoreID );
+            traceTASK_SWITCHED_IN();
 
-    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
-                                            BaseType_t xIndex,
-                                            void * pvValue )
-    {
-        TCB_t * pxTCB;
+            /* After the new task is switched in, update the global errno. */
+            #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                FreeRTOS_errno = pxCurrentTCBs[ xCoreID ]->iTaskErrno;
+            }
+            #endif
 
-        if( ( xIndex >= 0 ) &&
-            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
-        {
-            pxTCB = prvGetTCBFromHandle( xTaskToSet );
-            configASSERT( pxTCB != NULL );
-            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+            #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
+            {
+                /* Switch C-Runtime's TLS Block to point to the TLS
+                 * Block specific to this task. */
+                configSET_TLS_BLOCK( pxCurrentTCBs[ xCoreID ]->xTLSBlock );
+            }
+            #endif
         }
     }
+    portRELEASE_ISR_LOCK();
+    portRELEASE_TASK_LOCK();
+}
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
-
-    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
-                                               BaseType_t xIndex )
-    {
-        void * pvReturn = NULL;
-        TCB_t * pxTCB;
+void vTaskPlaceOnEventList( List_t * const pxEventList,
+                            const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
 
-        if( ( xIndex >= 0 ) &&
-            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
-        {
-            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
-        }
-        else
-        {
-            pvReturn = NULL;
-        }
+    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
 
-        return pvReturn;
-    }
+    /* Place the event list item of the TCB in the appropriate event list.
+     * This is placed in the list in priority order so the highest priority task
+     * is the first to be woken by the event.
+     *
+     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
+     * Normally, the xItemValue of a TCB's ListItem_t members is:
+     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
+     * Therefore, the event list is sorted in descending priority order.
+     *
+     * The queue that contains the event list is locked, preventing
+     * simultaneous access from interrupts. */
+    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
 /*-----------------------------------------------------------*/
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
-
-    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
-                                  const MemoryRegion_t * const xRegions )
-    {
-        TCB_t * pxTCB;
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
+                                     const TickType_t xItemValue,
+                                     const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
 
-        /* If null is passed in here then we are modifying the MPU settings of
-         * the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event groups implementation. */
+    configASSERT( uxSchedulerSuspended != 0 );
 
-        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
-    }
+    /* Store the item value in the event list item.  It is safe to access the
+     * event list item here as interrupts won't access the event list item of a
+     * task that is not in the Blocked state. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
 
-#endif /* portUSING_MPU_WRAPPERS */
+    /* Place the event list item of the TCB at the end of the appropriate event
+     * list.  It is safe to access the event list here because it is part of an
+     * event group implementation - and interrupts don't access event groups
+     * directly (instead they access them indirectly by pending function calls to
+     * the task level). */
+    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseTaskLists( void )
-{
-    UBaseType_t uxPriority;
+#if ( configUSE_TIMERS == 1 )
 
-    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
+                                          TickType_t xTicksToWait,
+                                          const BaseType_t xWaitIndefinitely )
     {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+        configASSERT( pxEventList );
+
+        /* This function should not be called by application code hence the
+         * 'Restricted' in its name.  It is not part of the public API.  It is
+         * designed for use by kernel code, and has special calling requirements -
+         * it should be called with the scheduler suspended. */
+
+
+        /* Place the event list item of the TCB in the appropriate event list.
+         * In this case it is assume that this is the only task that is going to
+         * be waiting on this event list, so the faster vListInsertEnd() function
+         * can be used in place of vListInsert. */
+        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+        /* If the task should block indefinitely then set the block time to a
+         * value that will be recognised as an indefinite delay inside the
+         * prvAddCurrentTaskToDelayedList() function. */
+        if( xWaitIndefinitely != pdFALSE )
+        {
+            xTicksToWait = portMAX_DELAY;
+        }
+
+        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
     }
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
-    vListInitialise( &xPendingReadyList );
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
 
-    #if ( INCLUDE_vTaskDelete == 1 )
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+    TCB_t * pxUnblockedTCB;
+    BaseType_t xReturn;
+
+    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+     * called from a critical section within an ISR. */
+
+    /* The event list is sorted in priority order, so the first in the list can
+     * be removed as it is known to be the highest priority.  Remove the TCB from
+     * the delayed list, and add it to the ready list.
+     *
+     * If an event is for a queue that is locked then this function will never
+     * get called - the lock count on the queue will get modified instead.  This
+     * means exclusive access to the event list is guaranteed here.
+     *
+     * This function assumes that a check has already been made to ensure that
+     * pxEventList is not empty. */
+    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
     {
-        vListInitialise( &xTasksWaitingTermination );
+        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+        prvAddTaskToReadyList( pxUnblockedTCB );
+
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+             * might be set to the blocked task's time out time.  If the task is
+             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+             * normally left unchanged, because it is automatically reset to a new
+             * value when the tick count equals xNextTaskUnblockTime.  However if
+             * tickless idling is used it might be more important to enter sleep mode
+             * at the earliest possible time - so reset xNextTaskUnblockTime here to
+             * ensure it is updated at the earliest possible time. */
+            prvResetNextTaskUnblockTime();
+        }
+        #endif
+    }
+    else
+    {
+        /* The delayed and ready lists cannot be accessed, so hold this task
+         * pending until the scheduler is resumed. */
+        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
-    #endif /* INCLUDE_vTaskDelete */
 
-    #if ( INCLUDE_vTaskSuspend == 1 )
+    #if ( configNUMBER_OF_CORES == 1 )
     {
-        vListInitialise( &xSuspendedTaskList );
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            /* Return true if the task removed from the event list has a higher
+             * priority than the calling task.  This allows the calling task to know if
+             * it should force a context switch now. */
+            xReturn = pdTRUE;
+
+            /* Mark that a yield is pending in case the user is not using the
+             * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
     }
-    #endif /* INCLUDE_vTaskSuspend */
+    #else /* configNUMBER_OF_CORES */
+    {
+        xReturn = pdFALSE;
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            /* Another core may be the one to run the unblocked task.  Only
+             * report that a context switch is required if it is this one. */
+            prvYieldForTask( pxUnblockedTCB );
+
+            if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        #endif
+    }
+    #endif /* configNUMBER_OF_CORES */
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static void prvCheckTasksWaitingTermination( void )
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
+                                        const TickType_t xItemValue )
 {
-    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+    TCB_t * pxUnblockedTCB;
 
-    #if ( INCLUDE_vTaskDelete == 1 )
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event flags implementation. */
+    configASSERT( uxSchedulerSuspended != pdFALSE );
+
+    /* Store the new item value in the event list. */
+    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Remove the event list form the event flag.  Interrupts do not access
+     * event flags. */
+    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( pxEventListItem );
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
     {
-        TCB_t * pxTCB;
+        /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+         * might be set to the blocked task's time out time.  If the task is
+         * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+         * normally left unchanged, because it is automatically reset to a new
+         * value when the tick count equals xNextTaskUnblockTime.  However if
+         * tickless idling is used it might be more important to enter sleep mode
+         * at the earliest possible time - so reset xNextTaskUnblockTime here to
+         * ensure it is updated at the earliest possible time. */
+        prvResetNextTaskUnblockTime();
+    }
+    #endif
 
-        /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
-         * being called too often in the idle task. */
-        while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+    /* Remove the task from the delayed list and add it to the ready list.  The
+     * scheduler is suspended so interrupts will not be accessing the ready
+     * lists. */
+    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+    prvAddTaskToReadyList( pxUnblockedTCB );
+
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            /* The unblocked task has a priority above that of the calling task, so
+             * a context switch is required.  This function is called with the
+             * scheduler suspended so xYieldPending is set so the context switch
+             * occurs immediately that the scheduler is resumed (unsuspended). */
+            xYieldPending = pdTRUE;
+        }
+    }
+    #else /* configNUMBER_OF_CORES */
+    {
+        #if ( configUSE_PREEMPTION == 1 )
         {
+            /* Suspending the scheduler does not mask interrupts, so a
+             * critical section is needed to select the core to yield. */
             taskENTER_CRITICAL();
             {
-                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                --uxCurrentNumberOfTasks;
-                --uxDeletedTasksWaitingCleanUp;
+                prvYieldForTask( pxUnblockedTCB );
             }
             taskEXIT_CRITICAL();
-
-            prvDeleteTCB( pxTCB );
         }
+        #endif
     }
-    #endif /* INCLUDE_vTaskDelete */
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    void vTaskGetInfo( TaskHandle_t xTask,
-                       TaskStatus_t * pxTaskStatus,
-                       BaseType_t xGetFreeStackSpace,
-                       eTaskState eState )
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    configASSERT( pxTimeOut );
+    taskENTER_CRITICAL();
     {
-        TCB_t * pxTCB;
+        pxTimeOut->xOverflowCount = xNumOfOverflows;
+        pxTimeOut->xTimeOnEntering = xTickCount;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
 
-        /* xTask is NULL then get the state of the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    /* For internal use only as it does not use a critical section. */
+    pxTimeOut->xOverflowCount = xNumOfOverflows;
+    pxTimeOut->xTimeOnEntering = xTickCount;
+}
+/*-----------------------------------------------------------*/
 
-        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
-        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
-        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
-        pxTaskStatus->pxStackBase = pxTCB->pxStack;
-        #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
-            pxTaskStatus->pxTopOfStack = pxTCB->pxTopOfStack;
-            pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
-        #endif
-        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    BaseType_t xReturn;
 
-        #if ( configUSE_MUTEXES == 1 )
-        {
-            pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
-        }
-        #else
-        {
-            pxTaskStatus->uxBasePriority = 0;
-        }
-        #endif
+    configASSERT( pxTimeOut );
+    configASSERT( pxTicksToWait );
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
-        {
-            pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
-        }
-        #else
+    taskENTER_CRITICAL();
+    {
+        /* Minor optimisation.  The tick count cannot change in this block. */
+        const TickType_t xConstTickCount = xTickCount;
+        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+
+        #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
         {
-            pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+            /* Whatever the task was blocked on it is no longer waiting for a
+             * mutex.  It is recorded again if the task blocks on a mutex
+             * again. */
+            pxCurrentTCB->pxBlockedOnMutexHolder = NULL;
         }
         #endif
 
-        /* Obtaining the task state is a little fiddly, so is only done if the
-         * value of eState passed into this function is eInvalid - otherwise the
-         * state is just set to whatever is passed in. */
-        if( eState != eInvalid )
-        {
-            if( pxTCB == pxCurrentTCB )
+        #if ( INCLUDE_xTaskAbortDelay == 1 )
+            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
             {
-                pxTaskStatus->eCurrentState = eRunning;
+                /* The delay was aborted, which is not the same as a time out,
+                 * but has the same result. */
+                pxCurrentTCB->ucDelayAborted = pdFALSE;
+                xReturn = pdTRUE;
             }
             else
-            {
-                pxTaskStatus->eCurrentState = eState;
+        #endif
 
-                #if ( INCLUDE_vTaskSuspend == 1 )
-                {
-                    /* If the task is in the suspended list then there is a
-                     *  chance it is actually just blocked indefinitely - so really
-                     *  it should be reported as being in the Blocked state. */
-                    if( eState == eSuspended )
-                    {
-                        vTaskSuspendAll();
-                        {
-                            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                            {
-                                pxTaskStatus->eCurrentState = eBlocked;
-                            }
-                        }
-                        ( void ) xTaskResumeAll();
-                    }
-                }
-                #endif /* INCLUDE_vTaskSuspend */
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            if( *pxTicksToWait == portMAX_DELAY )
+            {
+                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
+                 * specified is the maximum block time then the task should block
+                 * indefinitely, and therefore never time out. */
+                xReturn = pdFALSE;
             }
-        }
-        else
+            else
+        #endif
+
+        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
         {
-            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+            /* The tick count is greater than the time at which
+             * vTaskSetTimeout() was called, but has also overflowed since
+             * vTaskSetTimeOut() was called.  It must have wrapped all the way
+             * around and gone past again. This passed since vTaskSetTimeout()
+             * was called. */
+            xReturn = pdTRUE;
+            *pxTicksToWait = ( TickType_t ) 0;
         }
-
-        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
-         * parameter is provided to allow it to be skipped. */
-        if( xGetFreeStackSpace != pdFALSE )
+        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
         {
-            #if ( portSTACK_GROWTH > 0 )
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
-            }
-            #else
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
-            }
-            #endif
+            /* Not a genuine timeout. Adjust parameters for time remaining. */
+            *pxTicksToWait -= xElapsedTime;
+            vTaskInternalSetTimeOutState( pxTimeOut );
+            xReturn = pdFALSE;
         }
         else
         {
-            pxTaskStatus->usStackHighWaterMark = 0;
+            *pxTicksToWait = ( TickType_t ) 0;
+            xReturn = pdTRUE;
         }
     }
+    taskEXIT_CRITICAL();
 
-#endif /* configUSE_TRACE_FACILITY */
+    return xReturn;
+}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
-                                                     List_t * pxList,
-                                                     eTaskState eState )
+void vTaskMissedYield( void )
+{
+    #if ( configNUMBER_OF_CORES == 1 )
     {
-        configLIST_VOLATILE TCB_t * pxNextTCB;
-        configLIST_VOLATILE TCB_t * pxFirstTCB;
-        UBaseType_t uxTask = 0;
-
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
-        {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-            /* Populate an TaskStatus_t structure within the
-             * pxTaskStatusArray array for each task that is referenced from
-             * pxList.  See the definition of TaskStatus_t in task.h for the
-             * meaning of each TaskStatus_t structure member. */
-            do
-            {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
-                uxTask++;
-            } while( pxNextTCB != pxFirstTCB );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        return uxTask;
+        xYieldPending = pdTRUE;
     }
-
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
-
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    #else
     {
-        uint32_t ulCount = 0U;
-
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
-        {
-            pucStackByte -= portSTACK_GROWTH;
-            ulCount++;
-        }
-
-        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
-
-        return ( configSTACK_DEPTH_TYPE ) ulCount;
+        /* Only called from within a critical section, so the core cannot
+         * change. */
+        xYieldPendings[ portGET_CORE_ID() ] = pdTRUE;
     }
-
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+    #endif
+}
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
- * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
- * user to determine the return type.  It gets around the problem of the value
- * overflowing on 8-bit types without breaking backward compatibility for
- * applications that expect an 8-bit return type. */
-    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
     {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        configSTACK_DEPTH_TYPE uxReturn;
-
-        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
-         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
-         * allows the user to determine the return type.  It gets around the
-         * problem of the value overflowing on 8-bit types without breaking
-         * backward compatibility for applications that expect an 8-bit return
-         * type. */
-
-        pxTCB = prvGetTCBFromHandle( xTask );
+        UBaseType_t uxReturn;
+        TCB_t const * pxTCB;
 
-        #if portSTACK_GROWTH < 0
+        if( xTask != NULL )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            pxTCB = xTask;
+            uxReturn = pxTCB->uxTaskNumber;
         }
-        #else
+        else
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            uxReturn = 0U;
         }
-        #endif
-
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
 
         return uxReturn;
     }
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    void vTaskSetTaskNumber( TaskHandle_t xTask,
+                             const UBaseType_t uxHandle )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        UBaseType_t uxReturn;
-
-        pxTCB = prvGetTCBFromHandle( xTask );
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-        }
-        #else
+        if( xTask != NULL )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            pxTCB = xTask;
+            pxTCB->uxTaskNumber = uxHandle;
         }
-        #endif
+    }
 
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+#endif /* configUSE_TRACE_FACILITY */
 
-        return uxReturn;
-    }
+/*
+ * -----------------------------------------------------------
+ * The Idle task.
+ * ----------------------------------------------------------
+ *
+ * The portTASK_FUNCTION() macro is used to allow port/compiler specific
+ * language extensions.  The equivalent prototype for this function is:
+ *
+ * void prvIdleTask( void *pvParameters );
+ *
+ */
+static portTASK_FUNCTION( prvIdleTask, pvParameters )
+{
+    /* Stop warnings. */
+    ( void ) pvParameters;
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
-/*-----------------------------------------------------------*/
+    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
+     * SCHEDULER IS STARTED. **/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+    /* In case a task that has a secure context deletes itself, in which case
+     * the idle task is responsible for deleting the task's secure context, if
+     * any. */
+    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
 
-    static void prvDeleteTCB( TCB_t * pxTCB )
+    #if ( configNUMBER_OF_CORES > 1 )
     {
-        /* This call is required specifically for the TriCore port.  It must be
-         * above the vPortFree() calls.  The call is also used by ports/demos that
-         * want to allocate and clean RAM statically. */
-        portCLEAN_UP_TCB( pxTCB );
+        /* Every core starts the scheduler in an idle task.  This first yield
+         * gets the application tasks running. */
+        taskYIELD();
+    }
+    #endif
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
-        {
-            /* Free up the memory allocated for the task's TLS Block. */
-            configDEINIT_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
-        }
-        #endif
+    for( ; ; )
+    {
+        /* See if any tasks have deleted themselves - if so then the idle task
+         * is responsible for freeing the deleted task's TCB and stack. */
+        prvCheckTasksWaitingTermination();
 
-        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+        #if ( configUSE_PREEMPTION == 0 )
         {
-            /* The task can only have been allocated dynamically - free both
-             * the stack and TCB. */
-            vPortFreeStack( pxTCB->pxStack );
-            vPortFree( pxTCB );
+            /* If we are not using preemption we keep forcing a task switch to
+             * see if any other task has become available.  If we are using
+             * preemption we don't need to do this as any task becoming available
+             * will automatically get the processor anyway. */
+            taskYIELD();
         }
-        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+        #endif /* configUSE_PREEMPTION */
+
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
         {
-            /* The task could have been allocated statically or dynamically, so
-             * check what was statically allocated before trying to free the
-             * memory. */
-            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
-            {
-                /* Both the stack and TCB were allocated dynamically, so both
-                 * must be freed. */
-                vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
-            }
-            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+            /* When using preemption tasks of equal priority will be
+             * timesliced.  If a task that is sharing the idle priority is ready
+             * to run then the idle task should yield before the end of the
+             * timeslice.
+             *
+             * A critical region is not required here as we are just reading from
+             * the list, and an occasional incorrect value will not matter.  If
+             * the ready list at the idle priority contains more than one task
+             * then a task other than the idle task is ready to execute.  With
+             * more than one core there is one idle task per core in the list. */
+            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
             {
-                /* Only the stack was statically allocated, so the TCB is the
-                 * only memory that must be freed. */
-                vPortFree( pxTCB );
+                taskYIELD();
             }
             else
             {
-                /* Neither the stack nor the TCB were allocated dynamically, so
-                 * nothing needs to be freed. */
-                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-    }
-
-#endif /* INCLUDE_vTaskDelete */
-/*-----------------------------------------------------------*/
-
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-    {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
-    }
-    else
-    {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
-    }
-}
-/*-----------------------------------------------------------*/
-
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
-
-    TaskHandle_t xTaskGetCurrentTaskHandle( void )
-    {
-        TaskHandle_t xReturn;
-
-        /* A critical section is not required as this is not called from
-         * an interrupt and the current TCB will always be the same for any
-         * individual execution thread. */
-        xReturn = pxCurrentTCB;
-
-        return xReturn;
-    }
-
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
-/*-----------------------------------------------------------*/
-
-#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
-
-    BaseType_t xTaskGetSchedulerState( void )
-    {
-        BaseType_t xReturn;
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
 
-        if( xSchedulerRunning == pdFALSE )
-        {
-            xReturn = taskSCHEDULER_NOT_STARTED;
-        }
-        else
+        #if ( configUSE_IDLE_HOOK == 1 )
         {
-            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-            {
-                xReturn = taskSCHEDULER_RUNNING;
-            }
-            else
-            {
-                xReturn = taskSCHEDULER_SUSPENDED;
-            }
-        }
-
-        return xReturn;
-    }
+            extern void vApplicationIdleHook( void );
 
-#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
-/*-----------------------------------------------------------*/
+            /* Call the user defined function from within the idle task.  This
+             * allows the application designer to add background functionality
+             * without the overhead of a separate task.
+             * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
+             * CALL A FUNCTION THAT MIGHT BLOCK. */
+            vApplicationIdleHook();
+        }
+        #endif /* configUSE_IDLE_HOOK */
 
-#if ( configUSE_MUTEXES == 1 )
+        /* This conditional compilation should use inequality to 0, not equality
+         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+         * user defined low power mode  implementations require
+         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            TickType_t xExpectedIdleTime;
 
-    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
-    {
-        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
-        BaseType_t xReturn = pdFALSE;
+            /* It is not desirable to suspend then resume the scheduler on
+             * each iteration of the idle task.  Therefore, a preliminary
+             * test of the expected idle time is performed without the
+             * scheduler suspended.  The result here is not necessarily
+             * valid. */
+            xExpectedIdleTime = prvGetExpectedIdleTime();
 
-        /* If the mutex was given back by an interrupt while the queue was
-         * locked then the mutex holder might now be NULL.  _RB_ Is this still
-         * needed as interrupts can no longer use mutexes? */
-        if( pxMutexHolder != NULL )
-        {
-            /* If the holder of the mutex has a priority below the priority of
-             * the task attempting to obtain the mutex then it will temporarily
-             * inherit the priority of the task attempting to obtain the mutex. */
-            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
             {
-                /* Adjust the mutex holder state to account for its new
-                 * priority.  Only reset the event list item value if the value is
-                 * not being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                }
-                else
+                vTaskSuspendAll();
                 {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                    /* Now the scheduler is suspended, the expected idle
+                     * time can be sampled again, and this time its value can
+                     * be used. */
+                    configASSERT( xNextTaskUnblockTime >= xTickCount );
+                    xExpectedIdleTime = prvGetExpectedIdleTime();
 
-                /* If the task being modified is in the ready state it will need
-                 * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
-                {
-                    if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                    /* Define the following macro to set xExpectedIdleTime to 0
+                     * if the application does not want
+                     * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
+                    configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+
+                    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
                     {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
+                        traceLOW_POWER_IDLE_BEGIN();
+                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+                        traceLOW_POWER_IDLE_END();
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-
-                    /* Inherit the priority before being moved into the new list. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-                    prvAddTaskToReadyList( pxMutexHolderTCB );
-                }
-                else
-                {
-                    /* Just inherit the priority. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
                 }
-
-                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
-
-                /* Inheritance occurred. */
-                xReturn = pdTRUE;
+                ( void ) xTaskResumeAll();
             }
             else
             {
-                if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
-                {
-                    /* The base priority of the mutex holder is lower than the
-                     * priority of the task attempting to take the mutex, but the
-                     * current priority of the mutex holder is not lower than the
-                     * priority of the task attempting to take the mutex.
-                     * Therefore the mutex holder must have already inherited a
-                     * priority, but inheritance would have occurred if that had
-                     * not been the case. */
-                    xReturn = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        return xReturn;
+        #endif /* configUSE_TICKLESS_IDLE */
     }
-
-#endif /* configUSE_MUTEXES */
+}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+/*
+ * The passive idle tasks run on the cores other than the one running
+ * prvIdleTask().  They do not clean up deleted tasks - that is left to
+ * prvIdleTask() - so only yield and call the optional passive idle hook.
+ */
+    static portTASK_FUNCTION( prvPassiveIdleTask, pvParameters )
     {
-        TCB_t * const pxTCB = pxMutexHolder;
-        BaseType_t xReturn = pdFALSE;
+        ( void ) pvParameters;
 
-        if( pxMutexHolder != NULL )
+        taskYIELD();
+
+        for( ; ; )
         {
-            /* A task can only have an inherited priority if it holds the mutex.
-             * If the mutex is held by a task then it cannot be given from an
-             * interrupt, and if a mutex is given by the holding task then it must
-             * be the running state task. */
-            configASSERT( pxTCB == pxCurrentTCB );
-            configASSERT( pxTCB->uxMutexesHeld );
-            ( pxTCB->uxMutexesHeld )--;
+            #if ( configUSE_PREEMPTION == 0 )
+            {
+                /* See the comment in prvIdleTask(). */
+                taskYIELD();
+            }
+            #endif /* configUSE_PREEMPTION */
 
-            /* Has the holder of the mutex inherited the priority of another
-             * task? */
-            if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+            #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
             {
-                /* Only disinherit if no other mutexes are held. */
-                if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+                /* See the comment in prvIdleTask(). */
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
                 {
-                    /* A task can only have an inherited priority if it holds
-                     * the mutex.  If the mutex is held by a task then it cannot be
-                     * given from an interrupt, and if a mutex is given by the
-                     * holding task then it must be the running state task.  Remove
-                     * the holding task from the ready list. */
-                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Disinherit the priority before adding the task into the
-                     * new  ready list. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-                    pxTCB->uxPriority = pxTCB->uxBasePriority;
-
-                    /* Reset the event list item value.  It cannot be in use for
-                     * any other purpose if this task is running, and it must be
-                     * running to give back the mutex. */
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    prvAddTaskToReadyList( pxTCB );
-
-                    /* Return true to indicate that a context switch is required.
-                     * This is only actually required in the corner case whereby
-                     * multiple mutexes were held and the mutexes were given back
-                     * in an order different to that in which they were taken.
-                     * If a context switch did not occur when the first mutex was
-                     * returned, even if a task was waiting on it, then a context
-                     * switch should occur when the last mutex is returned whether
-                     * a task is waiting on it or not. */
-                    xReturn = pdTRUE;
+                    taskYIELD();
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else
+            #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+            #if ( configUSE_PASSIVE_IDLE_HOOK == 1 )
             {
-                mtCOVERAGE_TEST_MARKER();
+                extern void vApplicationPassiveIdleHook( void );
+
+                /* NOTE: vApplicationPassiveIdleHook() MUST NOT, UNDER ANY
+                 * CIRCUMSTANCES, CALL A FUNCTION THAT MIGHT BLOCK. */
+                vApplicationPassiveIdleHook();
             }
+            #endif /* configUSE_PASSIVE_IDLE_HOOK */
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        return xReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configNUMBER_OF_CORES > 1 */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_TICKLESS_IDLE != 0 )
 
-    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
-                                              UBaseType_t uxHighestPriorityWaitingTask )
+    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
     {
-        TCB_t * const pxTCB = pxMutexHolder;
-        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
-        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            /* The idle task exists in addition to the application tasks. */
+            const UBaseType_t uxNonApplicationTasks = 1;
+        #endif /* INCLUDE_vTaskSuspend */
 
-        if( pxMutexHolder != NULL )
-        {
-            /* If pxMutexHolder is not NULL then the holder must hold at least
-             * one mutex. */
-            configASSERT( pxTCB->uxMutexesHeld );
+        eSleepModeStatus eReturn = eStandardSleep;
 
-            /* Determine the priority to which the priority of the task that
-             * holds the mutex should be set.  This will be the greater of the
-             * holding task's base priority and the priority of the highest
-             * priority task that is waiting to obtain the mutex. */
-            if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
-            {
-                uxPriorityToUse = uxHighestPriorityWaitingTask;
-            }
-            else
-            {
-                uxPriorityToUse = pxTCB->uxBasePriority;
-            }
-
-            /* Does the priority need to change? */
-            if( pxTCB->uxPriority != uxPriorityToUse )
-            {
-                /* Only disinherit if no other mutexes are held.  This is a
-                 * simplification in the priority inheritance implementation.  If
-                 * the task that holds the mutex is also holding other mutexes then
-                 * the other mutexes may have caused the priority inheritance. */
-                if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
-                {
-                    /* If a task has timed out because it already holds the
-                     * mutex it was trying to obtain then it cannot of inherited
-                     * its own priority. */
-                    configASSERT( pxTCB != pxCurrentTCB );
-
-                    /* Disinherit the priority, remembering the previous
-                     * priority to facilitate determining the subject task's
-                     * state. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
-                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
-                    pxTCB->uxPriority = uxPriorityToUse;
-
-                    /* Only reset the event list item value if the value is not
-                     * being used for anything else. */
-                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                    {
-                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+        /* This function must be called from a critical section. */
 
-                    /* If the running task is not the task that holds the mutex
-                     * then the task that holds the mutex could be in either the
-                     * Ready, Blocked or Suspended states.  Only remove the task
-                     * from its current state list if it is in the Ready state as
-                     * the task's priority is going to change and there is one
-                     * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                    {
-                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                        {
-                            /* It is known that the task is in its ready list so
-                             * there is no need to check again and the port level
-                             * reset macro can be called directly. */
-                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+        {
+            /* A task was made ready while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+        else if( xYieldPending != pdFALSE )
+        {
+            /* A yield was pended while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+        else if( xPendedTicks != 0 )
+        {
+            /* A tick interrupt has already occurred but was held pending
+             * because the scheduler is suspended. */
+            eReturn = eAbortSleep;
+        }
 
-                        prvAddTaskToReadyList( pxTCB );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            else if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* If all the tasks are in the suspended list (which might mean they
+                 * have an infinite block time rather than actually being suspended)
+                 * then it is safe to turn all clocks off and just wait for external
+                 * interrupts. */
+                eReturn = eNoTasksWaitingTimeout;
             }
-        }
+        #endif /* INCLUDE_vTaskSuspend */
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        return eReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
 
-    void vTaskEnterCritical( void )
+    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
+                                            BaseType_t xIndex,
+                                            void * pvValue )
     {
-        portDISABLE_INTERRUPTS();
-
-        if( xSchedulerRunning != pdFALSE )
-        {
-            ( pxCurrentTCB->uxCriticalNesting )++;
+        TCB_t * pxTCB;
 
-            /* This is not the interrupt safe version of the enter critical
-             * function so  assert() if it is being called from an interrupt
-             * context.  Only API functions that end in "FromISR" can be used in an
-             * interrupt.  Only assert if the critical nesting count is 1 to
-             * protect against recursive calls if the assert function also uses a
-             * critical section. */
-            if( pxCurrentTCB->uxCriticalNesting == 1 )
-            {
-                portASSERT_IF_IN_ISR();
-            }
-        }
-        else
+        if( ( xIndex >= 0 ) &&
+            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
         {
-            mtCOVERAGE_TEST_MARKER();
+            pxTCB = prvGetTCBFromHandle( xTaskToSet );
+            configASSERT( pxTCB != NULL );
+            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
         }
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
 
-    void vTaskExitCritical( void )
+    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
+                                               BaseType_t xIndex )
     {
-        if( xSchedulerRunning != pdFALSE )
-        {
-            if( pxCurrentTCB->uxCriticalNesting > 0U )
-            {
-                ( pxCurrentTCB->uxCriticalNesting )--;
+        void * pvReturn = NULL;
+        TCB_t * pxTCB;
 
-                if( pxCurrentTCB->uxCriticalNesting == 0U )
-                {
-                    portENABLE_INTERRUPTS();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+        if( ( xIndex >= 0 ) &&
+            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            pvReturn = NULL;
         }
+
+        return pvReturn;
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+#if ( portUSING_MPU_WRAPPERS == 1 )
 
-    static char * prvWriteNameToBuffer( char * pcBuffer,
-                                        const char * pcTaskName )
+    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
+                                  const MemoryRegion_t * const xRegions )
     {
-        size_t x;
-
-        /* Start by copying the entire string. */
-        strcpy( pcBuffer, pcTaskName );
-
-        /* Pad the end of the string with spaces to ensure columns line up when
-         * printed out. */
-        for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
-        {
-            pcBuffer[ x ] = ' ';
-        }
+        TCB_t * pxTCB;
 
-        /* Terminate. */
-        pcBuffer[ x ] = ( char ) 0x00;
+        /* If null is passed in here then we are modifying the MPU settings of
+         * the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTaskToModify );
 
-        /* Return the new end of string. */
-        return &( pcBuffer[ x ] );
+        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
     }
 
-#endif /* ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
+#endif /* portUSING_MPU_WRAPPERS */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+static void prvInitialiseTaskLists( void )
+{
+    UBaseType_t uxPriority;
 
-    void vTaskList( char * pcWriteBuffer )
+    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
     {
-        TaskStatus_t * pxTaskStatusArray;
-        UBaseType_t uxArraySize, x;
-        char cStatus;
-
-        /*
-         * PLEASE NOTE:
-         *
-         * This function is provided for convenience only, and is used by many
-         * of the demo applications.  Do not consider it to be part of the
-         * scheduler.
-         *
-         * vTaskList() calls uxTaskGetSystemState(), then formats part of the
-         * uxTaskGetSystemState() output into a human readable table that
-         * displays task: names, states, priority, stack usage and task number.
-         * Stack usage specified as the number of unused StackType_t words stack can hold
-         * on top of stack - not the number of bytes.
-         *
-         * vTaskList() has a dependency on the sprintf() C library function that
-         * might bloat the code size, use a lot of stack, and provide different
-         * results on different platforms.  An alternative, tiny, third party,
-         * and limited functionality implementation of sprintf() is provided in
-         * many of the FreeRTOS/Demo sub-directories in a file called
-         * printf-stdarg.c (note printf-stdarg.c does not provide a full
-         * snprintf() implementation!).
-         *
-         * It is recommended that production systems call uxTaskGetSystemState()
-         * directly to get access to raw stats data, rather than indirectly
-         * through a call to vTaskList().
-         */
-
-
-        /* Make sure the write buffer does not contain a string. */
-        *pcWriteBuffer = ( char ) 0x00;
+        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+    }
 
-        /* Take a snapshot of the number of tasks in case it changes while this
-         * function is executing. */
-        uxArraySize = uxCurrentNumberOfTasks;
+    vListInitialise( &xDelayedTaskList1 );
+    vListInitialise( &xDelayedTaskList2 );
+    vListInitialise( &xPendingReadyList );
 
-        /* Allocate an array index for each task.  NOTE!  if
-         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-         * equate to NULL. */
-        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+    {
+        UBaseType_t uxLevel, uxSlot;
 
-        if( pxTaskStatusArray != NULL )
+        for( uxLevel = 0; uxLevel < ( UBaseType_t ) configDELAYED_TASK_WHEEL_LEVELS; uxLevel++ )
         {
-            /* Generate the (binary) data. */
-            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+            for( uxSlot = 0; uxSlot < taskWHEEL_SLOTS; uxSlot++ )
+            {
+                vListInitialise( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ) );
+            }
 
-            /* Create a human readable table from the binary data. */
-            for( x = 0; x < uxArraySize; x++ )
+            ulDelayedTaskWheelOccupied[ uxLevel ] = 0U;
+        }
+    }
+    #endif /* configUSE_DELAYED_TASK_WHEEL */
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+    {
+        vListInitialise( &xTasksWaitingTermination );
+    }
+    #endif /* INCLUDE_vTaskDelete */
+
+    #if ( INCLUDE_vTaskSuspend == 1 )
+    {
+        vListInitialise( &xSuspendedTaskList );
+    }
+    #endif /* INCLUDE_vTaskSuspend */
+
+    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+     * using list2. */
+    pxDelayedTaskList = &xDelayedTaskList1;
+    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTasksWaitingTermination( void )
+{
+    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+    {
+        TCB_t * pxTCB;
+
+        /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
+         * being called too often in the idle task. */
+        while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+        {
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                switch( pxTaskStatusArray[ x ].eCurrentState )
+                taskENTER_CRITICAL();
                 {
-                    case eRunning:
-                        cStatus = tskRUNNING_CHAR;
-                        break;
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    --uxCurrentNumberOfTasks;
+                    --uxDeletedTasksWaitingCleanUp;
+                }
+                taskEXIT_CRITICAL();
+            }
+            #else /* configNUMBER_OF_CORES */
+            {
+                pxTCB = NULL;
 
-                    case eReady:
-                        cStatus = tskREADY_CHAR;
-                        break;
+                taskENTER_CRITICAL();
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-                    case eBlocked:
-                        cStatus = tskBLOCKED_CHAR;
-                        break;
+                    if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                    {
+                        ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                        --uxCurrentNumberOfTasks;
+                        --uxDeletedTasksWaitingCleanUp;
+                    }
+                    else
+                    {
+                        /* The task deleted itself but the core it was running
+                         * on has not yet switched away from it.  Try again on
+                         * the next iteration of the idle task. */
+                        pxTCB = NULL;
+                    }
+                }
+                taskEXIT_CRITICAL();
 
-                    case eSuspended:
-                        cStatus = tskSUSPENDED_CHAR;
-                        break;
+                if( pxTCB == NULL )
+                {
+                    break;
+                }
+            }
+            #endif /* configNUMBER_OF_CORES */
 
-                    case eDeleted:
-                        cStatus = tskDELETED_CHAR;
-                        break;
+            prvDeleteTCB( pxTCB );
+        }
+    }
+    #endif /* INCLUDE_vTaskDelete */
+}
+/*-----------------------------------------------------------*/
 
-                    case eInvalid: /* Fall through. */
-                    default:       /* Should not get here, but it is included
-                                    * to prevent static checking errors. */
-                        cStatus = ( char ) 0x00;
-                        break;
-                }
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-                /* Write the task name to the string, padding with spaces so it
-                 * can be printed in tabular form more easily. */
-                pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+    void vTaskGetInfo( TaskHandle_t xTask,
+                       TaskStatus_t * pxTaskStatus,
+                       BaseType_t xGetFreeStackSpace,
+                       eTaskState eState )
+    {
+        TCB_t * pxTCB;
 
-                /* Write the rest of the string. */
-                sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-                pcWriteBuffer += strlen( pcWriteBuffer );                                                                                                                                                                                                /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+        /* xTask is NULL then get the state of the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
+        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+        pxTaskStatus->pxStackBase = pxTCB->pxStack;
+        #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+            pxTaskStatus->pxTopOfStack = pxTCB->pxTopOfStack;
+            pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
+        #endif
+        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+        }
+        #else
+        {
+            pxTaskStatus->uxBasePriority = 0;
+        }
+        #endif
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+        }
+        #else
+        {
+            pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+        }
+        #endif
+
+        /* Obtaining the task state is a little fiddly, so is only done if the
+         * value of eState passed into this function is eInvalid - otherwise the
+         * state is just set to whatever is passed in. */
+        if( eState != eInvalid )
+        {
+            #if ( configNUMBER_OF_CORES == 1 )
+                if( pxTCB == pxCurrentTCB )
+            #else
+                if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+            #endif
+            {
+                pxTaskStatus->eCurrentState = eRunning;
             }
+            else
+            {
+                pxTaskStatus->eCurrentState = eState;
 
-            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-             * is 0 then vPortFree() will be #defined to nothing. */
-            vPortFree( pxTaskStatusArray );
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    /* If the task is in the suspended list then there is a
+                     *  chance it is actually just blocked indefinitely - so really
+                     *  it should be reported as being in the Blocked state. */
+                    if( eState == eSuspended )
+                    {
+                        vTaskSuspendAll();
+                        {
+                            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                            {
+                                pxTaskStatus->eCurrentState = eBlocked;
+                            }
+                        }
+                        ( void ) xTaskResumeAll();
+                    }
+                }
+                #endif /* INCLUDE_vTaskSuspend */
+            }
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+        }
+
+        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
+         * parameter is provided to allow it to be skipped. */
+        if( xGetFreeStackSpace != pdFALSE )
+        {
+            #if ( portSTACK_GROWTH > 0 )
+            {
+                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+            }
+            #else
+            {
+                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+            }
+            #endif
+        }
+        else
+        {
+            pxTaskStatus->usStackHighWaterMark = 0;
         }
     }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
-/*----------------------------------------------------------*/
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configUSE_TRACE_FACILITY == 1 ) )
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-    void vTaskGetRunTimeStats( char * pcWriteBuffer )
+    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                     List_t * pxList,
+                                                     eTaskState eState )
     {
-        TaskStatus_t * pxTaskStatusArray;
-        UBaseType_t uxArraySize, x;
-        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
+        configLIST_VOLATILE TCB_t * pxNextTCB;
+        const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+        ListItem_t * pxIterator;
+        UBaseType_t uxTask = 0;
 
-        /*
-         * PLEASE NOTE:
-         *
-         * This function is provided for convenience only, and is used by many
-         * of the demo applications.  Do not consider it to be part of the
-         * scheduler.
-         *
-         * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
-         * of the uxTaskGetSystemState() output into a human readable table that
-         * displays the amount of time each task has spent in the Running state
-         * in both absolute and percentage terms.
-         *
-         * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
-         * function that might bloat the code size, use a lot of stack, and
-         * provide different results on different platforms.  An alternative,
-         * tiny, third party, and limited functionality implementation of
-         * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
-         * a file called printf-stdarg.c (note printf-stdarg.c does not provide
-         * a full snprintf() implementation!).
-         *
-         * It is recommended that production systems call uxTaskGetSystemState()
-         * directly to get access to raw stats data, rather than indirectly
-         * through a call to vTaskGetRunTimeStats().
-         */
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            /* Populate an TaskStatus_t structure within the
+             * pxTaskStatusArray array for each task that is referenced from
+             * pxList.  See the definition of TaskStatus_t in task.h for the
+             * meaning of each TaskStatus_t structure member.  The list's index
+             * is left where the scheduler put it. */
+            for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                pxNextTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+                uxTask++;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        /* Make sure the write buffer does not contain a string. */
-        *pcWriteBuffer = ( char ) 0x00;
+        return uxTask;
+    }
 
-        /* Take a snapshot of the number of tasks in case it changes while this
-         * function is executing. */
-        uxArraySize = uxCurrentNumberOfTasks;
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
 
-        /* Allocate an array index for each task.  NOTE!  If
-         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-         * equate to NULL. */
-        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-        if( pxTaskStatusArray != NULL )
-        {
-            /* Generate the (binary) data. */
-            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    {
+        uint32_t ulCount = 0U;
+        const StackType_t * pxStackWord;
+
+        /* Skip whole stack words that still hold the fill value, then count
+         * the fill bytes in the first word that does not one byte at a time.
+         * The result is the same as counting every byte individually. */
+        #if ( portSTACK_GROWTH < 0 )
+        {
+            /* pucStackByte is pxStack, so is aligned to a StackType_t. */
+            pxStackWord = ( const StackType_t * ) pucStackByte;
+
+            while( *pxStackWord == tskSTACK_FILL_WORD )
+            {
+                pxStackWord++;
+            }
+
+            ulCount = ( uint32_t ) ( pxStackWord - ( const StackType_t * ) pucStackByte ) * ( uint32_t ) sizeof( StackType_t );
+            pucStackByte = ( const uint8_t * ) pxStackWord;
+        }
+        #else /* if ( portSTACK_GROWTH < 0 ) */
+        {
+            /* pucStackByte is the first byte of pxEndOfStack.  Counting moves
+             * from that byte straight down to the last byte of the word below,
+             * so that byte is checked on its own before comparing words. */
+            if( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+            {
+                pxStackWord = ( ( const StackType_t * ) pucStackByte ) - 1;
+
+                while( *pxStackWord == tskSTACK_FILL_WORD )
+                {
+                    pxStackWord--;
+                }
+
+                ulCount = 1U + ( ( uint32_t ) ( ( ( ( const StackType_t * ) pucStackByte ) - 1 ) - pxStackWord ) * ( uint32_t ) sizeof( StackType_t ) );
+                pucStackByte = ( ( const uint8_t * ) ( pxStackWord + 1 ) ) - 1;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( portSTACK_GROWTH < 0 ) */
+
+        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        {
+            pucStackByte -= portSTACK_GROWTH;
+            ulCount++;
+        }
+
+        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+
+        return ( configSTACK_DEPTH_TYPE ) ulCount;
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+
+/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
+ * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
+ * user to determine the return type.  It gets around the problem of the value
+ * overflowing on 8-bit types without breaking backward compatibility for
+ * applications that expect an 8-bit return type. */
+    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        configSTACK_DEPTH_TYPE uxReturn;
+
+        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
+         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
+         * allows the user to determine the return type.  It gets around the
+         * problem of the value overflowing on 8-bit types without breaking
+         * backward compatibility for applications that expect an 8-bit return
+         * type. */
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        #if portSTACK_GROWTH < 0
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+        }
+        #else
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+
+    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        UBaseType_t uxReturn;
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        #if portSTACK_GROWTH < 0
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+        }
+        #else
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+    static void prvDeleteTCB( TCB_t * pxTCB )
+    {
+        /* This call is required specifically for the TriCore port.  It must be
+         * above the vPortFree() calls.  The call is also used by ports/demos that
+         * want to allocate and clean RAM statically. */
+        portCLEAN_UP_TCB( pxTCB );
+
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Free up the memory allocated for the task's TLS Block. */
+            configDEINIT_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
+
+        #if ( configUSE_HEAP_TASK_CACHE == 1 )
+        {
+            /* Return the blocks held in the task's heap cache to the heap. */
+            vPortReleaseTaskCache( pxTCB->pvThreadLocalStoragePointers[ configHEAP_TASK_CACHE_TLS_INDEX ] );
+        }
+        #endif
+
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+        {
+            /* The task can only have been allocated dynamically - free both
+             * the stack and TCB. */
+            vPortFreeStack( pxTCB->pxStack );
+            taskFREE_TCB( pxTCB );
+        }
+        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+        {
+            /* The task could have been allocated statically or dynamically, so
+             * check what was statically allocated before trying to free the
+             * memory. */
+            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+            {
+                /* Both the stack and TCB were allocated dynamically, so both
+                 * must be freed. */
+                vPortFreeStack( pxTCB->pxStack );
+                taskFREE_TCB( pxTCB );
+            }
+            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+            {
+                /* Only the stack was statically allocated, so the TCB is the
+                 * only memory that must be freed. */
+                taskFREE_TCB( pxTCB );
+            }
+            else
+            {
+                /* Neither the stack nor the TCB were allocated dynamically, so
+                 * nothing needs to be freed. */
+                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+    }
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+static void prvResetNextTaskUnblockTime( void )
+{
+    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+    {
+        /* The wheel is not sorted, so the time at which it next needs
+         * attention is found from the occupied slots. */
+        xNextTaskUnblockTime = prvDelayedWheelNextEventTime( xTickCount );
+    }
+    #else
+    {
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+        {
+            /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+             * the maximum possible value so it is  extremely unlikely that the
+             * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+             * there is an item in the delayed list. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            /* The new current delayed list is not empty, get the value of
+             * the item at the head of the delayed list.  This is the time at
+             * which the task at the head of the delayed list should be removed
+             * from the Blocked state. */
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
+    }
+    #endif /* configUSE_DELAYED_TASK_WHEEL */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+    static TickType_t prvDelayedWheelInsert( ListItem_t * const pxListItem,
+                                             const TickType_t xTimeNow )
+    {
+        const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxListItem );
+        const TickType_t xDifference = xTimeToWake ^ xTimeNow;
+        UBaseType_t uxLevel = 0;
+        UBaseType_t uxSlot;
+        TickType_t xEventTime;
+
+        /* Find the lowest level on which the wake time and the current time
+         * only differ within the level's own slot index.  The shift is split in
+         * two so it never equals the width of TickType_t. */
+        while( ( uxLevel < ( UBaseType_t ) configDELAYED_TASK_WHEEL_LEVELS ) &&
+               ( ( ( xDifference >> taskWHEEL_SHIFT( uxLevel ) ) >> configDELAYED_TASK_WHEEL_SLOT_BITS ) != ( TickType_t ) 0 ) )
+        {
+            uxLevel++;
+        }
+
+        if( uxLevel < ( UBaseType_t ) configDELAYED_TASK_WHEEL_LEVELS )
+        {
+            uxSlot = ( UBaseType_t ) ( ( xTimeToWake >> taskWHEEL_SHIFT( uxLevel ) ) & taskWHEEL_SLOT_MASK );
+            listINSERT_END( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ), pxListItem );
+            ulDelayedTaskWheelOccupied[ uxLevel ] |= ( ( uint32_t ) 1U << uxSlot );
+
+            /* A task on level 0 is acted on at its wake time.  A task on a
+             * higher level is acted on when its slot is cascaded, which is when
+             * the tick count reaches the start of the range covered by the
+             * slot. */
+            xEventTime = ( xTimeToWake >> taskWHEEL_SHIFT( uxLevel ) ) << taskWHEEL_SHIFT( uxLevel );
+        }
+        else
+        {
+            /* The wake time is beyond the span of the wheel.  The list is
+             * checked each time the top level of the wheel wraps. */
+            listINSERT_END( pxDelayedTaskList, pxListItem );
+            xEventTime = prvDelayedWheelNextEventTime( xTimeNow );
+        }
+
+        return xEventTime;
+    }
+/*-----------------------------------------------------------*/
+
+    static List_t * prvDelayedWheelAdvance( const TickType_t xTimeNow )
+    {
+        UBaseType_t uxLevel = 0;
+        UBaseType_t uxSlot;
+        List_t * volatile pxSlot;
+        ListItem_t * pxIterator;
+        ListItem_t * pxNext;
+        ListItem_t const * pxEnd;
+
+        /* Count the levels whose slot index has just wrapped to zero.  The
+         * slots of all the levels above those have just been entered. */
+        while( ( uxLevel < ( UBaseType_t ) configDELAYED_TASK_WHEEL_LEVELS ) &&
+               ( ( ( xTimeNow >> taskWHEEL_SHIFT( uxLevel ) ) & taskWHEEL_SLOT_MASK ) == ( TickType_t ) 0 ) )
+        {
+            uxLevel++;
+        }
+
+        if( uxLevel == ( UBaseType_t ) configDELAYED_TASK_WHEEL_LEVELS )
+        {
+            /* The top level of the wheel has wrapped, so move the tasks that
+             * are now within the span of the wheel out of pxDelayedTaskList. */
+            pxEnd = listGET_END_MARKER( pxDelayedTaskList );
+            pxIterator = listGET_HEAD_ENTRY( pxDelayedTaskList );
+
+            while( pxIterator != pxEnd )
+            {
+                pxNext = listGET_NEXT( pxIterator );
+
+                if( ( ( ( listGET_LIST_ITEM_VALUE( pxIterator ) ^ xTimeNow ) >> taskWHEEL_SHIFT( configDELAYED_TASK_WHEEL_LEVELS - 1 ) ) >> configDELAYED_TASK_WHEEL_SLOT_BITS ) == ( TickType_t ) 0 )
+                {
+                    listREMOVE_ITEM( pxIterator );
+                    ( void ) prvDelayedWheelInsert( pxIterator, xTimeNow );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxIterator = pxNext;
+            }
+
+            uxLevel--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Cascade the slots that have been entered, from the highest level
+         * down, so tasks cascaded from one level can be cascaded again from the
+         * level below on the same tick. */
+        for( ; uxLevel > ( UBaseType_t ) 0; uxLevel-- )
+        {
+            uxSlot = ( UBaseType_t ) ( ( xTimeNow >> taskWHEEL_SHIFT( uxLevel ) ) & taskWHEEL_SLOT_MASK );
+            pxSlot = &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] );
+
+            while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+            {
+                pxIterator = listGET_HEAD_ENTRY( pxSlot );
+                listREMOVE_ITEM( pxIterator );
+                ( void ) prvDelayedWheelInsert( pxIterator, xTimeNow );
+            }
+
+            ulDelayedTaskWheelOccupied[ uxLevel ] &= ~( ( uint32_t ) 1U << uxSlot );
+        }
+
+        /* The caller empties the level 0 slot, so its bit can be cleared
+         * now. */
+        uxSlot = ( UBaseType_t ) ( xTimeNow & taskWHEEL_SLOT_MASK );
+        ulDelayedTaskWheelOccupied[ 0 ] &= ~( ( uint32_t ) 1U << uxSlot );
+
+        return &( xDelayedTaskWheel[ 0 ][ uxSlot ] );
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvDelayedWheelNextEventTime( const TickType_t xTimeNow )
+    {
+        UBaseType_t uxLevel, uxIndex, uxSlot;
+        uint32_t ulCandidates;
+        TickType_t xEventTime = portMAX_DELAY;
+        BaseType_t xFound = pdFALSE;
+
+        /* A task is always placed in a slot after the current slot index of
+         * its level, and every slot on a level is acted on before any slot on
+         * the level above, so the first occupied slot found after the current
+         * index, searching from level 0 upwards, is the next to be acted on.
+         * Levels that have never been occupied are skipped before their shift
+         * is used, as the shift for such levels might exceed the width of
+         * TickType_t. */
+        for( uxLevel = 0; ( uxLevel < ( UBaseType_t ) configDELAYED_TASK_WHEEL_LEVELS ) && ( xFound == pdFALSE ); uxLevel++ )
+        {
+            if( ulDelayedTaskWheelOccupied[ uxLevel ] != 0U )
+            {
+                uxIndex = ( UBaseType_t ) ( ( xTimeNow >> taskWHEEL_SHIFT( uxLevel ) ) & taskWHEEL_SLOT_MASK );
+
+                /* Discard the bits of this slot and those below it.  The
+                 * shift wraps to zero when uxIndex is the last slot of a 32
+                 * slot level, leaving no candidates, which is as required. */
+                ulCandidates = ulDelayedTaskWheelOccupied[ uxLevel ] & ~( ( ( uint32_t ) 2U << uxIndex ) - 1U );
+
+                while( ulCandidates != 0U )
+                {
+                    uxSlot = uxIndex + 1U;
+
+                    while( ( ulCandidates & ( ( uint32_t ) 1U << uxSlot ) ) == 0U )
+                    {
+                        uxSlot++;
+                    }
+
+                    if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ) ) == pdFALSE )
+                    {
+                        xEventTime = ( ( ( xTimeNow >> taskWHEEL_SHIFT( uxLevel ) ) & ~taskWHEEL_SLOT_MASK ) | ( TickType_t ) uxSlot ) << taskWHEEL_SHIFT( uxLevel );
+                        xFound = pdTRUE;
+                        break;
+                    }
+                    else
+                    {
+                        /* All the tasks have left the slot since the bit was
+                         * set. */
+                        ulDelayedTaskWheelOccupied[ uxLevel ] &= ~( ( uint32_t ) 1U << uxSlot );
+                        ulCandidates &= ~( ( uint32_t ) 1U << uxSlot );
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( ( xFound == pdFALSE ) && ( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE ) )
+        {
+            /* Only tasks beyond the span of the wheel remain, so the next
+             * event is the next time the top level of the wheel wraps.  If that
+             * would overflow the tick count then the tasks are moved into the
+             * wheel when the delayed lists are switched instead. */
+            xEventTime = ( ( ( xTimeNow >> taskWHEEL_SHIFT( configDELAYED_TASK_WHEEL_LEVELS - 1 ) ) | taskWHEEL_SLOT_MASK ) + ( TickType_t ) 1 ) << taskWHEEL_SHIFT( configDELAYED_TASK_WHEEL_LEVELS - 1 );
+
+            if( xEventTime <= xTimeNow )
+            {
+                xEventTime = portMAX_DELAY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xEventTime;
+    }
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 ) && defined( taskUSE_HIGHEST_SET_BIT_TABLE )
+
+    static UBaseType_t prvHighestSetBit( uint32_t ulBitmap )
+    {
+        /* The index of the most significant set bit in each value 0 to 15. */
+        static const uint8_t ucHighestSetBitInNibble[ 16 ] = { 0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3 };
+        UBaseType_t uxBit = 0;
+
+        configASSERT( ulBitmap != 0UL );
+
+        /* Halve the range being searched until only four bits remain. */
+        if( ( ulBitmap & 0xFFFF0000UL ) != 0UL )
+        {
+            ulBitmap >>= 16;
+            uxBit += 16U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( ulBitmap & 0x0000FF00UL ) != 0UL )
+        {
+            ulBitmap >>= 8;
+            uxBit += 8U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( ulBitmap & 0x000000F0UL ) != 0UL )
+        {
+            ulBitmap >>= 4;
+            uxBit += 4U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxBit + ( UBaseType_t ) ucHighestSetBitInNibble[ ulBitmap ];
+    }
+
+#endif /* ( configUSE_READY_PRIORITY_BITMAP == 1 ) && defined( taskUSE_HIGHEST_SET_BIT_TABLE ) */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+    #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+
+        TaskHandle_t xTaskGetCurrentTaskHandle( void )
+        {
+            TaskHandle_t xReturn;
+
+            /* A critical section is not required as this is not called from
+             * an interrupt and the current TCB will always be the same for any
+             * individual execution thread. */
+            xReturn = pxCurrentTCB;
+
+            return xReturn;
+        }
+
+    #endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+
+#else /* configNUMBER_OF_CORES */
+
+/* Always built with more than one core, as pxCurrentTCB is defined to call
+ * it. */
+    TaskHandle_t xTaskGetCurrentTaskHandle( void )
+    {
+        TaskHandle_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* Interrupts are masked so the task cannot be moved to another core
+         * between reading the core ID and reading pxCurrentTCBs[]. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+    {
+        TaskHandle_t xReturn = NULL;
+
+        if( taskVALID_CORE_ID( xCoreID ) != pdFALSE )
+        {
+            xReturn = pxCurrentTCBs[ xCoreID ];
+        }
+
+        return xReturn;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+
+    BaseType_t xTaskGetSchedulerState( void )
+    {
+        BaseType_t xReturn;
+
+        if( xSchedulerRunning == pdFALSE )
+        {
+            xReturn = taskSCHEDULER_NOT_STARTED;
+        }
+        else
+        {
+            /* With more than one core the critical section stops another
+             * core suspending or resuming the scheduler, so the state
+             * returned is that seen by the calling task. */
+            #if ( configNUMBER_OF_CORES > 1 )
+                taskENTER_CRITICAL();
+            #endif
+            {
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    xReturn = taskSCHEDULER_RUNNING;
+                }
+                else
+                {
+                    xReturn = taskSCHEDULER_SUSPENDED;
+                }
+            }
+            #if ( configNUMBER_OF_CORES > 1 )
+                taskEXIT_CRITICAL();
+            #endif
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+    {
+        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
+        BaseType_t xReturn = pdFALSE;
+
+        /* If the mutex was given back by an interrupt while the queue was
+         * locked then the mutex holder might now be NULL.  _RB_ Is this still
+         * needed as interrupts can no longer use mutexes? */
+        if( pxMutexHolder != NULL )
+        {
+            /* If the holder of the mutex has a priority below the priority of
+             * the task attempting to obtain the mutex then it will temporarily
+             * inherit the priority of the task attempting to obtain the mutex. */
+            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+            {
+                /* Adjust the mutex holder state to account for its new
+                 * priority.  Only reset the event list item value if the value is
+                 * not being used for anything else. */
+                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                {
+                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* If the task being modified is in the ready state it will need
+                 * to be moved into a new list. */
+                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                {
+                    if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                    {
+                        /* It is known that the task is in its ready list so
+                         * there is no need to check again and the port level
+                         * reset macro can be called directly. */
+                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Inherit the priority before being moved into the new list. */
+                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+                    prvAddTaskToReadyList( pxMutexHolderTCB );
+                }
+                else
+                {
+                    /* Just inherit the priority. */
+                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+                }
+
+                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+
+                /* Inheritance occurred. */
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+                {
+                    /* The base priority of the mutex holder is lower than the
+                     * priority of the task attempting to take the mutex, but the
+                     * current priority of the mutex holder is not lower than the
+                     * priority of the task attempting to take the mutex.
+                     * Therefore the mutex holder must have already inherited a
+                     * priority, but inheritance would have occurred if that had
+                     * not been the case. */
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxMutexHolder != NULL )
+        {
+            /* A task can only have an inherited priority if it holds the mutex.
+             * If the mutex is held by a task then it cannot be given from an
+             * interrupt, and if a mutex is given by the holding task then it must
+             * be the running state task. */
+            configASSERT( pxTCB == pxCurrentTCB );
+            configASSERT( pxTCB->uxMutexesHeld );
+            ( pxTCB->uxMutexesHeld )--;
+
+            /* Has the holder of the mutex inherited the priority of another
+             * task? */
+            if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+            {
+                /* Only disinherit if no other mutexes are held. */
+                if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+                {
+                    /* A task can only have an inherited priority if it holds
+                     * the mutex.  If the mutex is held by a task then it cannot be
+                     * given from an interrupt, and if a mutex is given by the
+                     * holding task then it must be the running state task.  Remove
+                     * the holding task from the ready list. */
+                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                    {
+                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Disinherit the priority before adding the task into the
+                     * new  ready list. */
+                    traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
+                    pxTCB->uxPriority = pxTCB->uxBasePriority;
+
+                    /* Reset the event list item value.  It cannot be in use for
+                     * any other purpose if this task is running, and it must be
+                     * running to give back the mutex. */
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* Return true to indicate that a context switch is required.
+                     * This is only actually required in the corner case whereby
+                     * multiple mutexes were held and the mutexes were given back
+                     * in an order different to that in which they were taken.
+                     * If a context switch did not occur when the first mutex was
+                     * returned, even if a task was waiting on it, then a context
+                     * switch should occur when the last mutex is returned whether
+                     * a task is waiting on it or not. */
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
+                                              UBaseType_t uxHighestPriorityWaitingTask )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
+        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+
+        if( pxMutexHolder != NULL )
+        {
+            /* If pxMutexHolder is not NULL then the holder must hold at least
+             * one mutex. */
+            configASSERT( pxTCB->uxMutexesHeld );
+
+            /* Determine the priority to which the priority of the task that
+             * holds the mutex should be set.  This will be the greater of the
+             * holding task's base priority and the priority of the highest
+             * priority task that is waiting to obtain the mutex. */
+            if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+            {
+                uxPriorityToUse = uxHighestPriorityWaitingTask;
+            }
+            else
+            {
+                uxPriorityToUse = pxTCB->uxBasePriority;
+            }
+
+            /* Does the priority need to change? */
+            if( pxTCB->uxPriority != uxPriorityToUse )
+            {
+                /* Only disinherit if no other mutexes are held.  This is a
+                 * simplification in the priority inheritance implementation.  If
+                 * the task that holds the mutex is also holding other mutexes then
+                 * the other mutexes may have caused the priority inheritance. */
+                if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
+                {
+                    /* If a task has timed out because it already holds the
+                     * mutex it was trying to obtain then it cannot of inherited
+                     * its own priority. */
+                    configASSERT( pxTCB != pxCurrentTCB );
+
+                    /* Disinherit the priority, remembering the previous
+                     * priority to facilitate determining the subject task's
+                     * state. */
+                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
+                    pxTCB->uxPriority = uxPriorityToUse;
+
+                    /* Only reset the event list item value if the value is not
+                     * being used for anything else. */
+                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                    {
+                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* If the running task is not the task that holds the mutex
+                     * then the task that holds the mutex could be in either the
+                     * Ready, Blocked or Suspended states.  Only remove the task
+                     * from its current state list if it is in the Ready state as
+                     * the task's priority is going to change and there is one
+                     * Ready list per priority. */
+                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    {
+                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                        {
+                            /* It is known that the task is in its ready list so
+                             * there is no need to check again and the port level
+                             * reset macro can be called directly. */
+                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        prvAddTaskToReadyList( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+    static UBaseType_t prvGetInheritedPriority( const TCB_t * const pxTCB )
+    {
+        UBaseType_t uxPriority = pxTCB->uxBasePriority;
+        const ListItem_t * pxMutexItem;
+        const ListItem_t * const pxEndMarker = listGET_END_MARKER( &( pxTCB->xMutexesHeld ) );
+        const List_t * pxWaitingTasks;
+        const TCB_t * pxWaitingTCB;
+
+        /* The owner of the list item a mutex uses to reference itself from the
+         * list of mutexes held is the list of tasks waiting for the mutex,
+         * which is stored in priority order. */
+        for( pxMutexItem = listGET_HEAD_ENTRY( &( pxTCB->xMutexesHeld ) ); pxMutexItem != pxEndMarker; pxMutexItem = listGET_NEXT( pxMutexItem ) )
+        {
+            /* The item value is the ceiling priority of a mutex that has one,
+             * otherwise the idle priority. */
+            if( ( UBaseType_t ) listGET_LIST_ITEM_VALUE( pxMutexItem ) > uxPriority )
+            {
+                uxPriority = ( UBaseType_t ) listGET_LIST_ITEM_VALUE( pxMutexItem );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxWaitingTasks = ( const List_t * ) listGET_LIST_ITEM_OWNER( pxMutexItem );
+
+            if( listLIST_IS_EMPTY( pxWaitingTasks ) == pdFALSE )
+            {
+                pxWaitingTCB = listGET_OWNER_OF_HEAD_ENTRY( pxWaitingTasks );
+
+                if( pxWaitingTCB->uxPriority > uxPriority )
+                {
+                    uxPriority = pxWaitingTCB->uxPriority;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return uxPriority;
+    }
+    /*-----------------------------------------------------------*/
+
+    static TCB_t * prvSetInheritedPriority( TCB_t * const pxTCB,
+                                            UBaseType_t uxNewPriority )
+    {
+        const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+        List_t * pxEventList;
+        TCB_t * pxNextHolderTCB = NULL;
+
+        if( uxNewPriority > uxPriorityUsedOnEntry )
+        {
+            traceTASK_PRIORITY_INHERIT( pxTCB, uxNewPriority );
+        }
+        else
+        {
+            traceTASK_PRIORITY_DISINHERIT( pxTCB, uxNewPriority );
+        }
+
+        pxTCB->uxPriority = uxNewPriority;
+
+        /* Only reset the event list item value if the value is not being used
+         * for anything else. */
+        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+            /* A task waiting for a mutex is held in priority order in the list
+             * of tasks waiting for the mutex, so must be moved to its new
+             * position in that list.  A task that has been readied while the
+             * scheduler was suspended is no longer waiting. */
+            pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+            if( ( pxTCB->pxBlockedOnMutexHolder != NULL ) && ( pxEventList != NULL ) && ( pxEventList != &xPendingReadyList ) )
+            {
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+                pxNextHolderTCB = *( pxTCB->pxBlockedOnMutexHolder );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* If the task is in the ready state it will need to be moved into a
+         * new list. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+        {
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                /* It is known that the task is in its ready list so there is
+                 * no need to check again and the port level reset macro can be
+                 * called directly. */
+                portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvAddTaskToReadyList( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNextHolderTCB;
+    }
+    /*-----------------------------------------------------------*/
+
+    static BaseType_t prvUpdateInheritedPriorities( TCB_t * pxTCB )
+    {
+        UBaseType_t uxNewPriority;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        /* Each step moves a priority towards the value it is calculated from,
+         * so the walk ends even if the mutex holders have deadlocked. */
+        while( pxTCB != NULL )
+        {
+            uxNewPriority = prvGetInheritedPriority( pxTCB );
+
+            if( uxNewPriority != pxTCB->uxPriority )
+            {
+                if( ( pxTCB == pxCurrentTCB ) && ( uxNewPriority < pxTCB->uxPriority ) )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxTCB = prvSetInheritedPriority( pxTCB, uxNewPriority );
+            }
+            else
+            {
+                /* The rest of the chain is unaffected. */
+                pxTCB = NULL;
+            }
+        }
+
+        return xYieldRequired;
+    }
+    /*-----------------------------------------------------------*/
+
+    TaskHandle_t pvTaskAddHeldMutex( ListItem_t * const pxMutexListItem )
+    {
+        /* If xSemaphoreCreateMutex() is called before any tasks have been created
+         * then pxCurrentTCB will be NULL. */
+        if( pxCurrentTCB != NULL )
+        {
+            ( pxCurrentTCB->uxMutexesHeld )++;
+            vListInsertEnd( &( pxCurrentTCB->xMutexesHeld ), pxMutexListItem );
+
+            /* The task has obtained the mutex it might have been waiting
+             * for. */
+            pxCurrentTCB->pxBlockedOnMutexHolder = NULL;
+        }
+
+        return pxCurrentTCB;
+    }
+    /*-----------------------------------------------------------*/
+
+    BaseType_t xTaskRemoveHeldMutex( ListItem_t * const pxMutexListItem )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* The mutex is not referenced from a list of mutexes held if it was
+         * given back by an interrupt or taken before any tasks were created. */
+        if( listLIST_ITEM_CONTAINER( pxMutexListItem ) != NULL )
+        {
+            /* A mutex that is held by a task can only be given by that task,
+             * which must be the running state task. */
+            configASSERT( listIS_CONTAINED_WITHIN( &( pxCurrentTCB->xMutexesHeld ), pxMutexListItem ) );
+            configASSERT( pxCurrentTCB->uxMutexesHeld );
+
+            ( void ) uxListRemove( pxMutexListItem );
+            ( pxCurrentTCB->uxMutexesHeld )--;
+
+            /* Only the tasks waiting for the mutexes that are still held can
+             * keep the priority raised.  Return true if the priority was
+             * lowered, as a higher priority task might now be able to run. */
+            xReturn = prvUpdateInheritedPriorities( pxCurrentTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    BaseType_t xTaskPriorityInheritChain( TaskHandle_t * const pxMutexHolder )
+    {
+        const UBaseType_t uxPriority = pxCurrentTCB->uxPriority;
+        TCB_t * pxTCB = *pxMutexHolder;
+        BaseType_t xReturn = pdFALSE;
+
+        /* Remember which mutex the calling task is about to wait for so a
+         * priority inherited by the calling task while it waits can be passed
+         * on to the mutex holder. */
+        pxCurrentTCB->pxBlockedOnMutexHolder = pxMutexHolder;
+
+        /* If the mutex was given back by an interrupt while the queue was
+         * locked then the mutex holder might now be NULL. */
+        if( pxTCB != NULL )
+        {
+            /* Inheritance occurs, or has already occurred, if the holder's base
+             * priority is below the priority of the calling task. */
+            if( pxTCB->uxBasePriority < uxPriority )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Raise the holder, then the holder of the mutex the holder is
+             * waiting for, and so on, stopping at the first task in the chain
+             * that is already running at the calling task's priority or above.
+             * A task in a chain that leads back to the calling task stops the
+             * walk as the calling task is running at its own priority. */
+            while( ( pxTCB != NULL ) && ( pxTCB->uxPriority < uxPriority ) )
+            {
+                pxTCB = prvSetInheritedPriority( pxTCB, uxPriority );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    void vTaskPriorityDisinheritChainAfterTimeout( TaskHandle_t const pxMutexHolder )
+    {
+        /* The task that timed out is no longer in the list of tasks waiting for
+         * the mutex, so recalculating the priority of the mutex holder, and of
+         * the tasks the holder passed the priority on to, drops anything that
+         * was inherited from it. */
+        ( void ) prvUpdateInheritedPriorities( pxMutexHolder );
+    }
+
+#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+    void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+        UBaseType_t uxPriorityUsedOnEntry;
+
+        /* If the mutex is taken before any tasks have been created then
+         * pxCurrentTCB will be NULL. */
+        if( pxTCB != NULL )
+        {
+            /* A task whose own priority is above the ceiling would make the
+             * ceiling meaningless. */
+            configASSERT( pxTCB->uxBasePriority <= uxCeilingPriority );
+
+            uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+            /* Only raise the priority.  A task already running above the ceiling
+             * has inherited that priority through another mutex. */
+            if( uxPriorityUsedOnEntry < uxCeilingPriority )
+            {
+                traceTASK_PRIORITY_INHERIT( pxTCB, uxCeilingPriority );
+
+                /* Only reset the event list item value if the value is not
+                 * being used for anything else. */
+                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                {
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The calling task is running, so is in the ready list for its
+                 * current priority.  Raising the priority of the running task
+                 * cannot require a context switch. */
+                if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                {
+                    portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxTCB->uxPriority = uxCeilingPriority;
+                prvAddTaskToReadyList( pxTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+    void vTaskEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            ( pxCurrentTCB->uxCriticalNesting )++;
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( pxCurrentTCB->uxCriticalNesting == 1 )
+            {
+                portASSERT_IF_IN_ISR();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+    void vTaskExitCritical( void )
+    {
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            {
+                ( pxCurrentTCB->uxCriticalNesting )--;
+
+                if( pxCurrentTCB->uxCriticalNesting == 0U )
+                {
+                    portENABLE_INTERRUPTS();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void prvCheckForRunStateChange( void )
+    {
+        UBaseType_t uxPrevCriticalNesting;
+        const TCB_t * pxThisTCB;
+
+        /* This must only be called from within a task, with interrupts
+         * disabled and the task lock held, so the calling task cannot move to
+         * another core. */
+        portASSERT_IF_IN_ISR();
+        pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+
+        while( pxThisTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD )
+        {
+            /* Another core asked this one to yield after the calling task
+             * disabled interrupts but before it obtained the task lock.  The
+             * locks must be released and interrupts enabled so the yield can
+             * be serviced, after which the locks are taken again and the state
+             * checked again, as it may have changed while they were released. */
+            uxPrevCriticalNesting = portGET_CRITICAL_NESTING_COUNT();
+
+            if( uxPrevCriticalNesting > 0U )
+            {
+                portSET_CRITICAL_NESTING_COUNT( 0U );
+                portRELEASE_ISR_LOCK();
+            }
+            else
+            {
+                /* Called from vTaskSuspendAll(), which only holds the task
+                 * lock at this point. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            portRELEASE_TASK_LOCK();
+            portMEMORY_BARRIER();
+            configASSERT( pxThisTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD );
+
+            /* The pending yield is serviced as soon as interrupts are enabled,
+             * so by the time this task runs again it is no longer scheduled to
+             * yield. */
+            portENABLE_INTERRUPTS();
+            configASSERT( pxThisTCB->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD );
+
+            portDISABLE_INTERRUPTS();
+            portGET_TASK_LOCK();
+            portGET_ISR_LOCK();
+
+            portSET_CRITICAL_NESTING_COUNT( uxPrevCriticalNesting );
+
+            if( uxPrevCriticalNesting == 0U )
+            {
+                portRELEASE_ISR_LOCK();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            {
+                /* The task lock is always taken before the ISR lock. */
+                portGET_TASK_LOCK();
+                portGET_ISR_LOCK();
+            }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( portGET_CRITICAL_NESTING_COUNT() == 1U )
+            {
+                portASSERT_IF_IN_ISR();
+
+                if( uxSchedulerSuspended == 0U )
+                {
+                    /* The only time the calling task can be scheduled to
+                     * yield here is if another core asked it to before it
+                     * disabled interrupts, in which case it must yield before
+                     * entering the critical section. */
+                    prvCheckForRunStateChange();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskExitCritical( void )
+    {
+        BaseType_t xYieldCurrentTask;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If the critical nesting count is 0 then this function was
+             * called more times than vTaskEnterCritical(). */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+            portASSERT_IF_IN_ISR();
+
+            if( portGET_CRITICAL_NESTING_COUNT() > 0U )
+            {
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    /* A yield requested of this core while it was in the
+                     * critical section is performed now. */
+                    xYieldCurrentTask = xYieldPendings[ portGET_CORE_ID() ];
+
+                    portRELEASE_ISR_LOCK();
+                    portRELEASE_TASK_LOCK();
+                    portENABLE_INTERRUPTS();
+
+                    if( xYieldCurrentTask != pdFALSE )
+                    {
+                        portYIELD();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t vTaskEnterCriticalFromISR( void )
+    {
+        UBaseType_t uxSavedInterruptStatus = 0;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+            /* Only the ISR lock is taken, so an interrupt cannot be held off
+             * by a core that has suspended the scheduler. */
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            {
+                portGET_ISR_LOCK();
+            }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxSavedInterruptStatus;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
+    {
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If the critical nesting count is 0 then this function was
+             * called more times than vTaskEnterCriticalFromISR(). */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+            if( portGET_CRITICAL_NESTING_COUNT() > 0U )
+            {
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    portRELEASE_ISR_LOCK();
+                    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskYieldWithinAPI( void )
+    {
+        if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+        {
+            portYIELD();
+        }
+        else
+        {
+            /* Yielding from within a critical section is held pending until
+             * the critical section is exited. */
+            xYieldPendings[ portGET_CORE_ID() ] = pdTRUE;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_CORE_AFFINITY == 1 )
+
+        void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                                   UBaseType_t uxCoreAffinityMask )
+        {
+            TCB_t * pxTCB;
+            BaseType_t xCoreID;
+
+            taskENTER_CRITICAL();
+            {
+                pxTCB = prvGetTCBFromHandle( xTask );
+
+                pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                    {
+                        xCoreID = pxTCB->xTaskRunState;
+
+                        /* The task is running on a core it is no longer
+                         * allowed to run on, so that core must yield. */
+                        if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) == 0U )
+                        {
+                            prvYieldCore( xCoreID );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        /* The task may now be allowed to run on a core it
+                         * could not run on before. */
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+/*-----------------------------------------------------------*/
+
+        UBaseType_t vTaskCoreAffinityGet( const TaskHandle_t xTask )
+        {
+            const TCB_t * pxTCB;
+            UBaseType_t uxCoreAffinityMask;
+
+            taskENTER_CRITICAL();
+            {
+                pxTCB = prvGetTCBFromHandle( xTask );
+                uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+            }
+            taskEXIT_CRITICAL();
+
+            return uxCoreAffinityMask;
+        }
+
+    #endif /* configUSE_CORE_AFFINITY == 1 */
+
+#endif /* configNUMBER_OF_CORES > 1 */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+
+    static char * prvWriteNameToBuffer( char * pcBuffer,
+                                        const char * pcTaskName )
+    {
+        size_t x;
+
+        /* Start by copying the entire string. */
+        strcpy( pcBuffer, pcTaskName );
+
+        /* Pad the end of the string with spaces to ensure columns line up when
+         * printed out. */
+        for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
+        {
+            pcBuffer[ x ] = ' ';
+        }
+
+        /* Terminate. */
+        pcBuffer[ x ] = ( char ) 0x00;
+
+        /* Return the new end of string. */
+        return &( pcBuffer[ x ] );
+    }
+
+#endif /* ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+    void vTaskList( char * pcWriteBuffer )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        char cStatus;
+
+        /*
+         * PLEASE NOTE:
+         *
+         * This function is provided for convenience only, and is used by many
+         * of the demo applications.  Do not consider it to be part of the
+         * scheduler.
+         *
+         * vTaskList() calls uxTaskGetSystemState(), then formats part of the
+         * uxTaskGetSystemState() output into a human readable table that
+         * displays task: names, states, priority, stack usage and task number.
+         * Stack usage specified as the number of unused StackType_t words stack can hold
+         * on top of stack - not the number of bytes.
+         *
+         * vTaskList() has a dependency on the sprintf() C library function that
+         * might bloat the code size, use a lot of stack, and provide different
+         * results on different platforms.  An alternative, tiny, third party,
+         * and limited functionality implementation of sprintf() is provided in
+         * many of the FreeRTOS/Demo sub-directories in a file called
+         * printf-stdarg.c (note printf-stdarg.c does not provide a full
+         * snprintf() implementation!).
+         *
+         * It is recommended that production systems call uxTaskGetSystemState()
+         * directly to get access to raw stats data, rather than indirectly
+         * through a call to vTaskList().
+         */
+
+
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        /* Take a snapshot of the number of tasks in case it changes while this
+         * function is executing. */
+        uxArraySize = uxCurrentNumberOfTasks;
+
+        /* Allocate an array index for each task.  NOTE!  if
+         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+         * equate to NULL. */
+        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+        if( pxTaskStatusArray != NULL )
+        {
+            /* Generate the (binary) data. */
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+
+            /* Create a human readable table from the binary data. */
+            for( x = 0; x < uxArraySize; x++ )
+            {
+                switch( pxTaskStatusArray[ x ].eCurrentState )
+                {
+                    case eRunning:
+                        cStatus = tskRUNNING_CHAR;
+                        break;
+
+                    case eReady:
+                        cStatus = tskREADY_CHAR;
+                        break;
+
+                    case eBlocked:
+                        cStatus = tskBLOCKED_CHAR;
+                        break;
+
+                    case eSuspended:
+                        cStatus = tskSUSPENDED_CHAR;
+                        break;
+
+                    case eDeleted:
+                        cStatus = tskDELETED_CHAR;
+                        break;
+
+                    case eInvalid: /* Fall through. */
+                    default:       /* Should not get here, but it is included
+                                    * to prevent static checking errors. */
+                        cStatus = ( char ) 0x00;
+                        break;
+                }
+
+                /* Write the task name to the string, padding with spaces so it
+                 * can be printed in tabular form more easily. */
+                pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+                /* Write the rest of the string. */
+                sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                pcWriteBuffer += strlen( pcWriteBuffer );                                                                                                                                                                                                /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+            }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+/*----------------------------------------------------------*/
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configUSE_TRACE_FACILITY == 1 ) )
+
+    void vTaskGetRunTimeStats( char * pcWriteBuffer )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
+
+        /*
+         * PLEASE NOTE:
+         *
+         * This function is provided for convenience only, and is used by many
+         * of the demo applications.  Do not consider it to be part of the
+         * scheduler.
+         *
+         * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
+         * of the uxTaskGetSystemState() output into a human readable table that
+         * displays the amount of time each task has spent in the Running state
+         * in both absolute and percentage terms.
+         *
+         * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
+         * function that might bloat the code size, use a lot of stack, and
+         * provide different results on different platforms.  An alternative,
+         * tiny, third party, and limited functionality implementation of
+         * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
+         * a file called printf-stdarg.c (note printf-stdarg.c does not provide
+         * a full snprintf() implementation!).
+         *
+         * It is recommended that production systems call uxTaskGetSystemState()
+         * directly to get access to raw stats data, rather than indirectly
+         * through a call to vTaskGetRunTimeStats().
+         */
+
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        /* Take a snapshot of the number of tasks in case it changes while this
+         * function is executing. */
+        uxArraySize = uxCurrentNumberOfTasks;
+
+        /* Allocate an array index for each task.  NOTE!  If
+         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+         * equate to NULL. */
+        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+        if( pxTaskStatusArray != NULL )
+        {
+            /* Generate the (binary) data. */
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+
+            /* For percentage calculations. */
+            ulTotalTime /= 100UL;
+
+            /* Avoid divide by zero errors. */
+            if( ulTotalTime > 0UL )
+            {
+                /* Create a human readable table from the binary data. */
+                for( x = 0; x < uxArraySize; x++ )
+                {
+                    /* What percentage of the total run time has the task used?
+                     * This will always be rounded down to the nearest integer.
+                     * ulTotalRunTime has already been divided by 100. */
+                    ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+
+                    /* Write the task name to the string, padding with
+                     * spaces so it can be printed in tabular form more
+                     * easily. */
+                    pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+                    if( ulStatsAsPercentage > 0UL )
+                    {
+                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                        {
+                            sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+                        }
+                        #else
+                        {
+                            /* sizeof( int ) == sizeof( long ) so a smaller
+                             * printf() library can be used. */
+                            sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        /* If the percentage is zero here then the task has
+                         * consumed less than 1% of the total run time. */
+                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                        {
+                            sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+                        }
+                        #else
+                        {
+                            /* sizeof( int ) == sizeof( long ) so a smaller
+                             * printf() library can be used. */
+                            sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                        }
+                        #endif
+                    }
+
+                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+/*-----------------------------------------------------------*/
+
+TickType_t uxTaskResetEventItemValue( void )
+{
+    TickType_t uxReturn;
+
+    uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+
+    /* Reset the event list item to its normal value - so it can be used with
+     * queues and semaphores. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    TaskHandle_t pvTaskIncrementMutexHeldCount( void )
+    {
+        /* If xSemaphoreCreateMutex() is called before any tasks have been created
+         * then pxCurrentTCB will be NULL. */
+        if( pxCurrentTCB != NULL )
+        {
+            ( pxCurrentTCB->uxMutexesHeld )++;
+        }
+
+        return pxCurrentTCB;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
+                                      BaseType_t xClearCountOnExit,
+                                      TickType_t xTicksToWait )
+    {
+        uint32_t ulReturn;
+
+        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        taskENTER_CRITICAL();
+        {
+            /* Only block if the notification count is not already non-zero. */
+            if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
+            {
+                /* Mark this task as waiting for a notification. */
+                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
+
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+                    traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait );
+
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until the
+                     * critical section exits) - but it is not something that
+                     * application code should ever do. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        taskENTER_CRITICAL();
+        {
+            traceTASK_NOTIFY_TAKE( uxIndexToWait );
+            ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+
+            if( ulReturn != 0UL )
+            {
+                if( xClearCountOnExit != pdFALSE )
+                {
+                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
+                }
+                else
+                {
+                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
+        }
+        taskEXIT_CRITICAL();
+
+        return ulReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait,
+                                       uint32_t ulBitsToClearOnEntry,
+                                       uint32_t ulBitsToClearOnExit,
+                                       uint32_t * pulNotificationValue,
+                                       TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+
+        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        taskENTER_CRITICAL();
+        {
+            /* Only block if a notification is not already pending. */
+            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
+            {
+                /* Clear bits in the task's notification value as bits may get
+                 * set  by the notifying task or interrupt.  This can be used to
+                 * clear the value to zero. */
+                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
+
+                /* Mark this task as waiting for a notification. */
+                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
+
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+                    traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait );
+
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until the
+                     * critical section exits) - but it is not something that
+                     * application code should ever do. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        taskENTER_CRITICAL();
+        {
+            traceTASK_NOTIFY_WAIT( uxIndexToWait );
+
+            if( pulNotificationValue != NULL )
+            {
+                /* Output the current notification value, which may or may not
+                 * have changed. */
+                *pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+            }
+
+            /* If ucNotifyValue is set then either the task never entered the
+             * blocked state (because a notification was already pending) or the
+             * task unblocked because of a notification.  Otherwise the task
+             * unblocked because of a timeout. */
+            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
+            {
+                /* A notification was not received. */
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                /* A notification was already pending or a notification was
+                 * received while the task was waiting. */
+                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
+                xReturn = pdTRUE;
+            }
+
+            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
+                                   UBaseType_t uxIndexToNotify,
+                                   uint32_t ulValue,
+                                   eNotifyAction eAction,
+                                   uint32_t * pulPreviousNotificationValue )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn = pdPASS;
+        uint8_t ucOriginalNotifyState;
+
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configASSERT( xTaskToNotify );
+        pxTCB = xTaskToNotify;
+
+        taskENTER_CRITICAL();
+        {
+            if( pulPreviousNotificationValue != NULL )
+            {
+                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
+            }
+
+            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+
+            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+
+            switch( eAction )
+            {
+                case eSetBits:
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+                    break;
+
+                case eIncrement:
+                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+                    break;
+
+                case eSetValueWithOverwrite:
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                    break;
+
+                case eSetValueWithoutOverwrite:
+
+                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+                    {
+                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                    }
+                    else
+                    {
+                        /* The value could not be written to the task. */
+                        xReturn = pdFAIL;
+                    }
+
+                    break;
+
+                case eNoAction:
+
+                    /* The task is being notified without its notify value being
+                     * updated. */
+                    break;
+
+                default:
+
+                    /* Should not get here if all enums are handled.
+                     * Artificially force an assert by testing a value the
+                     * compiler can't assume is const. */
+                    configASSERT( xTickCount == ( TickType_t ) 0 );
 
-            /* For percentage calculations. */
-            ulTotalTime /= 100UL;
+                    break;
+            }
 
-            /* Avoid divide by zero errors. */
-            if( ulTotalTime > 0UL )
+            traceTASK_NOTIFY( uxIndexToNotify );
+
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
-                /* Create a human readable table from the binary data. */
-                for( x = 0; x < uxArraySize; x++ )
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                prvAddTaskToReadyList( pxTCB );
+
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                #if ( configUSE_TICKLESS_IDLE != 0 )
                 {
-                    /* What percentage of the total run time has the task used?
-                     * This will always be rounded down to the nearest integer.
-                     * ulTotalRunTime has already been divided by 100. */
-                    ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+                    /* If a task is blocked waiting for a notification then
+                     * xNextTaskUnblockTime might be set to the blocked task's time
+                     * out time.  If the task is unblocked for a reason other than
+                     * a timeout xNextTaskUnblockTime is normally left unchanged,
+                     * because it will automatically get reset to a new value when
+                     * the tick count equals xNextTaskUnblockTime.  However if
+                     * tickless idling is used it might be more important to enter
+                     * sleep mode at the earliest possible time - so reset
+                     * xNextTaskUnblockTime here to ensure it is updated at the
+                     * earliest possible time. */
+                    prvResetNextTaskUnblockTime();
+                }
+                #endif
+
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else
+                {
+                    /* The notified task may be able to preempt any of the
+                     * cores. */
+                    taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                }
+                #endif /* configNUMBER_OF_CORES */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
+                                          UBaseType_t uxIndexToNotify,
+                                          uint32_t ulValue,
+                                          eNotifyAction eAction,
+                                          uint32_t * pulPreviousNotificationValue,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        TCB_t * pxTCB;
+        uint8_t ucOriginalNotifyState;
+        BaseType_t xReturn = pdPASS;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTaskToNotify );
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        pxTCB = xTaskToNotify;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( pulPreviousNotificationValue != NULL )
+            {
+                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
+            }
+
+            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+
+            switch( eAction )
+            {
+                case eSetBits:
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+                    break;
+
+                case eIncrement:
+                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+                    break;
+
+                case eSetValueWithOverwrite:
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                    break;
+
+                case eSetValueWithoutOverwrite:
+
+                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+                    {
+                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                    }
+                    else
+                    {
+                        /* The value could not be written to the task. */
+                        xReturn = pdFAIL;
+                    }
+
+                    break;
+
+                case eNoAction:
+
+                    /* The task is being notified without its notify value being
+                     * updated. */
+                    break;
+
+                default:
+
+                    /* Should not get here if all enums are handled.
+                     * Artificially force an assert by testing a value the
+                     * compiler can't assume is const. */
+                    configASSERT( xTickCount == ( TickType_t ) 0 );
+                    break;
+            }
+
+            traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
+
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            {
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    /* The delayed and ready lists cannot be accessed, so hold
+                     * this task pending until the scheduler is resumed. */
+                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
+
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter to an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* configNUMBER_OF_CORES */
+                {
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        prvYieldForTask( pxTCB );
+
+                        if( xYieldPendings[ portGET_CORE_ID() ] == pdTRUE )
+                        {
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                        }
+                    }
+                    #endif /* configUSE_PREEMPTION */
+                }
+                #endif /* configNUMBER_OF_CORES */
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify,
+                                        UBaseType_t uxIndexToNotify,
+                                        BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        TCB_t * pxTCB;
+        uint8_t ucOriginalNotifyState;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTaskToNotify );
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        pxTCB = xTaskToNotify;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+
+            /* 'Giving' is equivalent to incrementing a count in a counting
+             * semaphore. */
+            ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+
+            traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
+
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            {
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
-                    /* Write the task name to the string, padding with
-                     * spaces so it can be printed in tabular form more
-                     * easily. */
-                    pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    /* The delayed and ready lists cannot be accessed, so hold
+                     * this task pending until the scheduler is resumed. */
+                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
 
-                    if( ulStatsAsPercentage > 0UL )
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
                     {
-                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-                        {
-                            sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
-                        }
-                        #else
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
                         {
-                            /* sizeof( int ) == sizeof( long ) so a smaller
-                             * printf() library can be used. */
-                            sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                            *pxHigherPriorityTaskWoken = pdTRUE;
                         }
-                        #endif
+
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter in an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPending = pdTRUE;
                     }
                     else
                     {
-                        /* If the percentage is zero here then the task has
-                         * consumed less than 1% of the total run time. */
-                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-                        {
-                            sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
-                        }
-                        #else
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* configNUMBER_OF_CORES */
+                {
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        prvYieldForTask( pxTCB );
+
+                        if( xYieldPendings[ portGET_CORE_ID() ] == pdTRUE )
                         {
-                            /* sizeof( int ) == sizeof( long ) so a smaller
-                             * printf() library can be used. */
-                            sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
                         }
-                        #endif
                     }
-
-                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                    #endif /* configUSE_PREEMPTION */
                 }
+                #endif /* configNUMBER_OF_CORES */
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-
-            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-             * is 0 then vPortFree() will be #defined to nothing. */
-            vPortFree( pxTaskStatusArray );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
         }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
     }
 
-#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-TickType_t uxTaskResetEventItemValue( void )
-{
-    TickType_t uxReturn;
-
-    uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    /* Reset the event list item to its normal value - so it can be used with
-     * queues and semaphores. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+    BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask,
+                                             UBaseType_t uxIndexToClear )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
 
-    return uxReturn;
-}
-/*-----------------------------------------------------------*/
+        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-#if ( configUSE_MUTEXES == 1 )
+        /* If null is passed in here then it is the calling task that is having
+         * its notification state cleared. */
+        pxTCB = prvGetTCBFromHandle( xTask );
 
-    TaskHandle_t pvTaskIncrementMutexHeldCount( void )
-    {
-        /* If xSemaphoreCreateMutex() is called before any tasks have been created
-         * then pxCurrentTCB will be NULL. */
-        if( pxCurrentTCB != NULL )
+        taskENTER_CRITICAL();
         {
-            ( pxCurrentTCB->uxMutexesHeld )++;
+            if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
+            {
+                pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
         }
+        taskEXIT_CRITICAL();
 
-        return pxCurrentTCB;
+        return xReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
-                                      BaseType_t xClearCountOnExit,
-                                      TickType_t xTicksToWait )
+    uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
+                                            UBaseType_t uxIndexToClear,
+                                            uint32_t ulBitsToClear )
     {
+        TCB_t * pxTCB;
         uint32_t ulReturn;
 
-        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        /* If null is passed in here then it is the calling task that is having
+         * its notification state cleared. */
+        pxTCB = prvGetTCBFromHandle( xTask );
 
         taskENTER_CRITICAL();
         {
-            /* Only block if the notification count is not already non-zero. */
-            if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
-            {
-                /* Mark this task as waiting for a notification. */
-                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
-
-                if( xTicksToWait > ( TickType_t ) 0 )
-                {
-                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-                    traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait );
-
-                    /* All ports are written to allow a yield in a critical
-                     * section (some will yield immediately, others wait until the
-                     * critical section exits) - but it is not something that
-                     * application code should ever do. */
-                    portYIELD_WITHIN_API();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            /* Return the notification as it was before the bits were cleared,
+             * then clear the bit mask. */
+            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
+            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
         }
         taskEXIT_CRITICAL();
 
-        taskENTER_CRITICAL();
+        return ulReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    {
+        #if ( configNUMBER_OF_CORES == 1 )
         {
-            traceTASK_NOTIFY_TAKE( uxIndexToWait );
-            ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+            return xIdleTaskHandle->ulRunTimeCounter;
+        }
+        #else
+        {
+            configRUN_TIME_COUNTER_TYPE ulReturn = 0;
+            BaseType_t i;
 
-            if( ulReturn != 0UL )
+            /* The total time spent idle across all the cores. */
+            for( i = 0; i < ( BaseType_t ) configNUMBER_OF_CORES; i++ )
             {
-                if( xClearCountOnExit != pdFALSE )
-                {
-                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
-                }
-                else
-                {
-                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
-                }
+                ulReturn += xIdleTaskHandles[ i ]->ulRunTimeCounter;
             }
-            else
+
+            return ulReturn;
+        }
+        #endif /* configNUMBER_OF_CORES */
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
+
+        #if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+        {
+            taskENTER_CRITICAL();
             {
-                mtCOVERAGE_TEST_MARKER();
+                ulTotalTime = ulTotalRunTime;
             }
+            taskEXIT_CRITICAL();
+        }
+        #else
+        {
+            ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+        }
+        #endif
 
-            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
+        /* For percentage calculations. */
+        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+
+        /* With more than one core the idle time is summed across the cores,
+         * so is compared against the time available on all of them. */
+        ulTotalTime *= ( configRUN_TIME_COUNTER_TYPE ) configNUMBER_OF_CORES;
+
+        /* Avoid divide by zero errors. */
+        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+        {
+            ulReturn = ulTaskGetIdleRunTimeCounter() / ulTotalTime;
+        }
+        else
+        {
+            ulReturn = 0;
         }
-        taskEXIT_CRITICAL();
 
         return ulReturn;
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
 
-    BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait,
-                                       uint32_t ulBitsToClearOnEntry,
-                                       uint32_t ulBitsToClearOnExit,
-                                       uint32_t * pulNotificationValue,
-                                       TickType_t xTicksToWait )
+    static configRUN_TIME_COUNTER_TYPE prvGetRunTimeCounterValue( void )
     {
-        BaseType_t xReturn;
-
-        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configRUN_TIME_COUNTER_TYPE ulCounterValue;
 
-        taskENTER_CRITICAL();
-        {
-            /* Only block if a notification is not already pending. */
-            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
-            {
-                /* Clear bits in the task's notification value as bits may get
-                 * set  by the notifying task or interrupt.  This can be used to
-                 * clear the value to zero. */
-                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulCounterValue );
+        #else
+            ulCounterValue = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
 
-                /* Mark this task as waiting for a notification. */
-                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
+        return ulCounterValue;
+    }
+/*-----------------------------------------------------------*/
 
-                if( xTicksToWait > ( TickType_t ) 0 )
-                {
-                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-                    traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait );
+    static void prvChargeRunTime( void )
+    {
+        const configRUN_TIME_COUNTER_TYPE ulCounterValue = prvGetRunTimeCounterValue();
+        configRUN_TIME_COUNTER_TYPE ulElapsed = ulCounterValue - ulLastRunTimeCounterValue;
 
-                    /* All ports are written to allow a yield in a critical
-                     * section (some will yield immediately, others wait until the
-                     * critical section exits) - but it is not something that
-                     * application code should ever do. */
-                    portYIELD_WITHIN_API();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+        #ifndef portALT_GET_RUN_TIME_COUNTER_VALUE
+        {
+            /* A counter narrower than configRUN_TIME_COUNTER_TYPE, such as a 32
+             * bit cycle counter, wraps, so the difference is taken modulo its
+             * width.  Run time must be charged at least once per counter
+             * period, which the tick interrupt does if the port reports it. */
+            if( sizeof( portGET_RUN_TIME_COUNTER_VALUE() ) < sizeof( configRUN_TIME_COUNTER_TYPE ) )
+            {
+                ulElapsed = ( configRUN_TIME_COUNTER_TYPE ) ( uint32_t ) ulElapsed;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        taskEXIT_CRITICAL();
+        #endif
 
-        taskENTER_CRITICAL();
+        ulLastRunTimeCounterValue = ulCounterValue;
+
+        if( xSchedulerRunning != pdFALSE )
         {
-            traceTASK_NOTIFY_WAIT( uxIndexToWait );
+            ulTotalRunTime += ulElapsed;
 
-            if( pulNotificationValue != NULL )
+            if( uxRunTimeContext == taskRUN_TIME_IN_TASK )
             {
-                /* Output the current notification value, which may or may not
-                 * have changed. */
-                *pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+                pxCurrentTCB->ulRunTimeCounter += ulElapsed;
             }
-
-            /* If ucNotifyValue is set then either the task never entered the
-             * blocked state (because a notification was already pending) or the
-             * task unblocked because of a notification.  Otherwise the task
-             * unblocked because of a timeout. */
-            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
+            else if( uxRunTimeContext == taskRUN_TIME_IN_KERNEL )
             {
-                /* A notification was not received. */
-                xReturn = pdFALSE;
+                ulKernelRunTime += ulElapsed;
             }
             else
             {
-                /* A notification was already pending or a notification was
-                 * received while the task was waiting. */
-                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
-                xReturn = pdTRUE;
+                ulISRRunTime[ uxRunTimeContext - taskRUN_TIME_IN_ISR( 0 ) ] += ulElapsed;
             }
-
-            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
         }
-        taskEXIT_CRITICAL();
-
-        return xReturn;
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-
-    BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
-                                   UBaseType_t uxIndexToNotify,
-                                   uint32_t ulValue,
-                                   eNotifyAction eAction,
-                                   uint32_t * pulPreviousNotificationValue )
+    UBaseType_t uxTaskRunTimeEnterISR( UBaseType_t uxISR )
     {
-        TCB_t * pxTCB;
-        BaseType_t xReturn = pdPASS;
-        uint8_t ucOriginalNotifyState;
+        UBaseType_t uxSavedInterruptStatus, uxPreviousContext;
 
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
-        configASSERT( xTaskToNotify );
-        pxTCB = xTaskToNotify;
+        configASSERT( uxISR < ( UBaseType_t ) configRUN_TIME_ISR_COUNT );
 
-        taskENTER_CRITICAL();
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
         {
-            if( pulPreviousNotificationValue != NULL )
-            {
-                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
-            }
-
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
-
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
-
-            switch( eAction )
-            {
-                case eSetBits:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
-                    break;
-
-                case eIncrement:
-                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-                    break;
-
-                case eSetValueWithOverwrite:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    break;
-
-                case eSetValueWithoutOverwrite:
+            prvChargeRunTime();
+            uxPreviousContext = uxRunTimeContext;
+            uxRunTimeContext = taskRUN_TIME_IN_ISR( uxISR );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
-                    {
-                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    }
-                    else
-                    {
-                        /* The value could not be written to the task. */
-                        xReturn = pdFAIL;
-                    }
+        return uxPreviousContext;
+    }
+/*-----------------------------------------------------------*/
 
-                    break;
+    void vTaskRunTimeExitISR( UBaseType_t uxPreviousContext )
+    {
+        UBaseType_t uxSavedInterruptStatus;
 
-                case eNoAction:
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            prvChargeRunTime();
+            uxRunTimeContext = uxPreviousContext;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
 
-                    /* The task is being notified without its notify value being
-                     * updated. */
-                    break;
+    void vTaskRunTimeEnterCritical( void )
+    {
+        /* Called by the port, with interrupts masked, as the critical nesting
+         * count goes from zero to one.  Critical sections entered from an
+         * interrupt stay charged to the interrupt. */
+        prvChargeRunTime();
 
-                default:
+        if( uxRunTimeContext == taskRUN_TIME_IN_TASK )
+        {
+            uxRunTimeContext = taskRUN_TIME_IN_KERNEL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
 
-                    /* Should not get here if all enums are handled.
-                     * Artificially force an assert by testing a value the
-                     * compiler can't assume is const. */
-                    configASSERT( xTickCount == ( TickType_t ) 0 );
+    void vTaskRunTimeExitCritical( void )
+    {
+        /* Called by the port, with interrupts still masked, as the critical
+         * nesting count returns to zero. */
+        prvChargeRunTime();
 
-                    break;
-            }
+        if( uxRunTimeContext == taskRUN_TIME_IN_KERNEL )
+        {
+            uxRunTimeContext = taskRUN_TIME_IN_TASK;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
 
-            traceTASK_NOTIFY( uxIndexToNotify );
+    static UBaseType_t prvListRunTimesWithinSingleList( TaskRunTime_t * pxRunTimeArray,
+                                                        List_t * pxList,
+                                                        eTaskState eState )
+    {
+        configLIST_VOLATILE TCB_t * pxNextTCB;
+        const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+        ListItem_t * pxIterator;
+        UBaseType_t uxTask = 0;
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
             {
-                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                prvAddTaskToReadyList( pxTCB );
+                pxNextTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+                pxRunTimeArray[ uxTask ].xHandle = ( TaskHandle_t ) pxNextTCB;
+                pxRunTimeArray[ uxTask ].uxCurrentPriority = pxNextTCB->uxPriority;
+                pxRunTimeArray[ uxTask ].ulRunTimeCounter = pxNextTCB->ulRunTimeCounter;
 
-                #if ( configUSE_TICKLESS_IDLE != 0 )
+                #if ( configNUMBER_OF_CORES == 1 )
+                    if( pxNextTCB == pxCurrentTCB )
+                #else
+                    if( taskTASK_IS_RUNNING( pxNextTCB ) == pdTRUE )
+                #endif
                 {
-                    /* If a task is blocked waiting for a notification then
-                     * xNextTaskUnblockTime might be set to the blocked task's time
-                     * out time.  If the task is unblocked for a reason other than
-                     * a timeout xNextTaskUnblockTime is normally left unchanged,
-                     * because it will automatically get reset to a new value when
-                     * the tick count equals xNextTaskUnblockTime.  However if
-                     * tickless idling is used it might be more important to enter
-                     * sleep mode at the earliest possible time - so reset
-                     * xNextTaskUnblockTime here to ensure it is updated at the
-                     * earliest possible time. */
-                    prvResetNextTaskUnblockTime();
+                    pxRunTimeArray[ uxTask ].eCurrentState = eRunning;
                 }
-                #endif
-
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                else if( ( eState == eSuspended ) && ( listLIST_ITEM_CONTAINER( &( pxNextTCB->xEventListItem ) ) != NULL ) )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    taskYIELD_IF_USING_PREEMPTION();
+                    /* Blocked indefinitely rather than suspended. */
+                    pxRunTimeArray[ uxTask ].eCurrentState = eBlocked;
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    pxRunTimeArray[ uxTask ].eCurrentState = eState;
                 }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
+
+                uxTask++;
             }
         }
-        taskEXIT_CRITICAL();
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        return xReturn;
+        return uxTask;
     }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-
-    BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
-                                          UBaseType_t uxIndexToNotify,
-                                          uint32_t ulValue,
-                                          eNotifyAction eAction,
-                                          uint32_t * pulPreviousNotificationValue,
-                                          BaseType_t * pxHigherPriorityTaskWoken )
+    UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTime_t * const pxRunTimeArray,
+                                          const UBaseType_t uxArraySize,
+                                          RunTimeTotals_t * const pxTotals )
     {
-        TCB_t * pxTCB;
-        uint8_t ucOriginalNotifyState;
-        BaseType_t xReturn = pdPASS;
-        UBaseType_t uxSavedInterruptStatus;
-
-        configASSERT( xTaskToNotify );
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
-
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
-
-        pxTCB = xTaskToNotify;
+        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES, uxISR;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        vTaskSuspendAll();
         {
-            if( pulPreviousNotificationValue != NULL )
-            {
-                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
-            }
-
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
-
-            switch( eAction )
+            /* Is there a space in the array for each task in the system? */
+            if( ( pxRunTimeArray != NULL ) && ( uxArraySize >= uxCurrentNumberOfTasks ) )
             {
-                case eSetBits:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
-                    break;
-
-                case eIncrement:
-                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-                    break;
-
-                case eSetValueWithOverwrite:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    break;
-
-                case eSetValueWithoutOverwrite:
-
-                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
-                    {
-                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    }
-                    else
-                    {
-                        /* The value could not be written to the task. */
-                        xReturn = pdFAIL;
-                    }
-
-                    break;
-
-                case eNoAction:
-
-                    /* The task is being notified without its notify value being
-                     * updated. */
-                    break;
-
-                default:
-
-                    /* Should not get here if all enums are handled.
-                     * Artificially force an assert by testing a value the
-                     * compiler can't assume is const. */
-                    configASSERT( xTickCount == ( TickType_t ) 0 );
-                    break;
-            }
+                do
+                {
+                    uxQueue--;
+                    uxTask += prvListRunTimesWithinSingleList( &( pxRunTimeArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
+                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
-            traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
+                uxTask += prvListRunTimesWithinSingleList( &( pxRunTimeArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+                uxTask += prvListRunTimesWithinSingleList( &( pxRunTimeArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
-            {
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    UBaseType_t uxLevel, uxSlot;
 
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                    for( uxLevel = 0; uxLevel < ( UBaseType_t ) configDELAYED_TASK_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0; uxSlot < taskWHEEL_SLOTS; uxSlot++ )
+                        {
+                            uxTask += prvListRunTimesWithinSingleList( &( pxRunTimeArray[ uxTask ] ), &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ), eBlocked );
+                        }
+                    }
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskDelete == 1 )
                 {
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    uxTask += prvListRunTimesWithinSingleList( &( pxRunTimeArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
                 }
-                else
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
                 {
-                    /* The delayed and ready lists cannot be accessed, so hold
-                     * this task pending until the scheduler is resumed. */
-                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    uxTask += prvListRunTimesWithinSingleList( &( pxRunTimeArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
                 }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Other tasks cannot run while the scheduler is suspended, but
+             * interrupts still charge the calling task, so its record and the
+             * totals are read together once the run time that has passed has
+             * been charged by entering the critical section. */
+            taskENTER_CRITICAL();
+            {
+                UBaseType_t uxIndex;
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                for( uxIndex = 0; uxIndex < uxTask; uxIndex++ )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
+                    if( pxRunTimeArray[ uxIndex ].xHandle == ( TaskHandle_t ) pxCurrentTCB )
+                    {
+                        pxRunTimeArray[ uxIndex ].ulRunTimeCounter = pxCurrentTCB->ulRunTimeCounter;
+                    }
+                    else
                     {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
+                        mtCOVERAGE_TEST_MARKER();
                     }
+                }
+
+                if( pxTotals != NULL )
+                {
+                    pxTotals->ulTotalRunTime = ulTotalRunTime;
+                    pxTotals->ulIdleRunTime = ( xIdleTaskHandle != NULL ) ? xIdleTaskHandle->ulRunTimeCounter : 0UL;
+                    pxTotals->ulKernelRunTime = ulKernelRunTime;
 
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter to an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
+                    for( uxISR = 0; uxISR < ( UBaseType_t ) configRUN_TIME_ISR_COUNT; uxISR++ )
+                    {
+                        pxTotals->ulISRRunTime[ uxISR ] = ulISRRunTime[ uxISR ];
+                    }
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+            taskEXIT_CRITICAL();
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        ( void ) xTaskResumeAll();
 
-        return xReturn;
+        return uxTask;
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_RUN_TIME_ACCOUNTING */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
 
-    void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify,
-                                        UBaseType_t uxIndexToNotify,
-                                        BaseType_t * pxHigherPriorityTaskWoken )
+    static void prvRecordSectionLength( const void * pvCallSite,
+                                        BaseType_t xSchedulerSuspended,
+                                        uint32_t ulLength )
     {
-        TCB_t * pxTCB;
-        uint8_t ucOriginalNotifyState;
-        UBaseType_t uxSavedInterruptStatus;
-
-        configASSERT( xTaskToNotify );
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
-
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
-
-        pxTCB = xTaskToNotify;
+        CriticalSectionHistogram_t * pxHistogram = NULL;
+        UBaseType_t uxIndex, uxProbe, uxBucket;
+        uint32_t ulShifted;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        if( pvCallSite != NULL )
         {
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
-
-            /* 'Giving' is equivalent to incrementing a count in a counting
-             * semaphore. */
-            ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-
-            traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
+            /* Linear probing from the call site's hash.  An entry is never
+             * freed, other than by vTaskResetCriticalSectionHistograms(), so
+             * the first unused entry ends the search. */
+            uxIndex = ( UBaseType_t ) ( ( ( ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pvCallSite ) * ( uint32_t ) 0x9E3779B1UL ) >> 16 ) % taskHISTOGRAM_HASHED_SITES;
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            for( uxProbe = 0; uxProbe < taskHISTOGRAM_HASHED_SITES; uxProbe++ )
             {
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+                CriticalSectionHistogram_t * pxEntry = &( xCriticalSectionHistograms[ taskHISTOGRAM_FIRST_SITE + uxIndex ] );
 
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                if( pxEntry->ulCount == 0UL )
                 {
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    pxEntry->pvCallSite = pvCallSite;
+                    pxEntry->xSchedulerSuspended = xSchedulerSuspended;
+                    pxHistogram = pxEntry;
+                    break;
                 }
-                else
+                else if( ( pxEntry->pvCallSite == pvCallSite ) && ( pxEntry->xSchedulerSuspended == xSchedulerSuspended ) )
                 {
-                    /* The delayed and ready lists cannot be accessed, so hold
-                     * this task pending until the scheduler is resumed. */
-                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    pxHistogram = pxEntry;
+                    break;
                 }
-
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                else
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
+                    uxIndex++;
+
+                    if( uxIndex == taskHISTOGRAM_HASHED_SITES )
                     {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
+                        uxIndex = 0;
                     }
-
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter in an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
                 }
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-    }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
-/*-----------------------------------------------------------*/
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        if( pxHistogram == NULL )
+        {
+            /* The call site is unknown or the table is full. */
+            pxHistogram = &( xCriticalSectionHistograms[ ( xSchedulerSuspended != pdFALSE ) ? taskHISTOGRAM_OTHER_SUSPENDED : taskHISTOGRAM_OTHER_CRITICAL ] );
+            pxHistogram->xSchedulerSuspended = xSchedulerSuspended;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask,
-                                             UBaseType_t uxIndexToClear )
-    {
-        TCB_t * pxTCB;
-        BaseType_t xReturn;
+        /* The bucket is the index of the most significant set bit. */
+        uxBucket = 0;
+        ulShifted = ulLength;
 
-        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        while( ( ulShifted > 1UL ) && ( uxBucket < ( ( UBaseType_t ) configCRITICAL_SECTION_HISTOGRAM_BUCKETS - 1U ) ) )
+        {
+            ulShifted >>= 1;
+            uxBucket++;
+        }
 
-        /* If null is passed in here then it is the calling task that is having
-         * its notification state cleared. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        pxHistogram->ulBuckets[ uxBucket ]++;
+        pxHistogram->ulCount++;
 
-        taskENTER_CRITICAL();
+        if( ulLength > pxHistogram->ulLongest )
         {
-            if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
-            {
-                pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
-                xReturn = pdPASS;
-            }
-            else
-            {
-                xReturn = pdFAIL;
-            }
+            pxHistogram->ulLongest = ulLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        taskEXIT_CRITICAL();
-
-        return xReturn;
     }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-
-    uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
-                                            UBaseType_t uxIndexToClear,
-                                            uint32_t ulBitsToClear )
+    void vTaskCriticalSectionHistogramEnter( const void * pvCallSite )
     {
-        TCB_t * pxTCB;
-        uint32_t ulReturn;
-
-        /* If null is passed in here then it is the calling task that is having
-         * its notification state cleared. */
-        pxTCB = prvGetTCBFromHandle( xTask );
-
-        taskENTER_CRITICAL();
+        if( xSchedulerRunning != pdFALSE )
         {
-            /* Return the notification as it was before the bits were cleared,
-             * then clear the bit mask. */
-            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
-            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
+            pvCriticalSectionSite = pvCallSite;
+            ulCriticalSectionStart = portCRITICAL_SECTION_TIMESTAMP();
+            xCriticalSectionTimed = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        taskEXIT_CRITICAL();
-
-        return ulReturn;
     }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
-
-    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    void vTaskCriticalSectionHistogramExit( void )
     {
-        return xIdleTaskHandle->ulRunTimeCounter;
+        if( xCriticalSectionTimed != pdFALSE )
+        {
+            prvRecordSectionLength( pvCriticalSectionSite, pdFALSE, portCRITICAL_SECTION_TIMESTAMP() - ulCriticalSectionStart );
+            xCriticalSectionTimed = pdFALSE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
-
-#endif
 /*-----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
-
-    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
+    UBaseType_t uxTaskGetCriticalSectionHistograms( CriticalSectionHistogram_t * const pxHistogramArray,
+                                                    const UBaseType_t uxArraySize )
     {
-        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
-
-        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
-
-        /* For percentage calculations. */
-        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+        UBaseType_t uxEntry, uxFilled = 0;
 
-        /* Avoid divide by zero errors. */
-        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+        for( uxEntry = 0; ( uxEntry < ( UBaseType_t ) configCRITICAL_SECTION_HISTOGRAM_SITES ) && ( uxFilled < uxArraySize ); uxEntry++ )
         {
-            ulReturn = xIdleTaskHandle->ulRunTimeCounter / ulTotalTime;
+            /* Each entry is copied in its own critical section so reading the
+             * histograms does not itself mask interrupts for long. */
+            taskENTER_CRITICAL();
+            {
+                if( xCriticalSectionHistograms[ uxEntry ].ulCount != 0UL )
+                {
+                    pxHistogramArray[ uxFilled ] = xCriticalSectionHistograms[ uxEntry ];
+                    uxFilled++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
         }
-        else
+
+        return uxFilled;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskResetCriticalSectionHistograms( void )
+    {
+        taskENTER_CRITICAL();
         {
-            ulReturn = 0;
+            ( void ) memset( xCriticalSectionHistograms, 0x00, sizeof( xCriticalSectionHistograms ) );
         }
-
-        return ulReturn;
+        taskEXIT_CRITICAL();
     }
 
-#endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
+#endif /* configUSE_CRITICAL_SECTION_HISTOGRAMS */
 /*-----------------------------------------------------------*/
 
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
@@ -5345,13 +8675,34 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             {
                 /* Wake time has overflowed.  Place this item in the overflow
                  * list. */
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    /* The list is not sorted as its items are placed in the
+                     * wheel when the tick count overflows. */
+                    listINSERT_END( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                }
+                #else
+                {
+                    vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                }
+                #endif
             }
             else
             {
                 /* The wake time has not overflowed, so the current block list
                  * is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    /* The wheel might need to act on the task before its wake
+                     * time, in which case the time it does so is what has to be
+                     * compared with xNextTaskUnblockTime. */
+                    xTimeToWake = prvDelayedWheelInsert( &( pxCurrentTCB->xStateListItem ), xConstTickCount );
+                }
+                #else
+                {
+                    vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                }
+                #endif
 
                 /* If the task entering the blocked state was placed at the
                  * head of the list of blocked tasks then xNextTaskUnblockTime
@@ -5380,12 +8731,33 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         if( xTimeToWake < xConstTickCount )
         {
             /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                /* The list is not sorted as its items are placed in the wheel
+                 * when the tick count overflows. */
+                listINSERT_END( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            }
+            #else
+            {
+                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            }
+            #endif
         }
         else
         {
             /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                /* The wheel might need to act on the task before its wake time,
+                 * in which case the time it does so is what has to be compared
+                 * with xNextTaskUnblockTime. */
+                xTimeToWake = prvDelayedWheelInsert( &( pxCurrentTCB->xStateListItem ), xConstTickCount );
+            }
+            #else
+            {
+                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            }
+            #endif
 
             /* If the task entering the blocked state was placed at the head of the
              * list of blocked tasks then xNextTaskUnblockTime needs to be updated
@@ -39,6 +39,10 @@
 #include "queue.h"
 #include "timers.h"
 
+#if ( ( configUSE_TIMERS == 1 ) && ( configTIMER_POOL_LENGTH > 0 ) )
+    #include "object_pool.h"
+#endif
+
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
     #error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
 #endif
@@ -71,6 +75,38 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
 
+/* The number of slots on each level of the timer wheel, the mask used to obtain
+ * a slot index from a shifted tick count, and the shift that gives the slot
+ * index on a given level. */
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        #define tmrWHEEL_SLOTS                   ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_MASK               ( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+        #define tmrWHEEL_SHIFT( uxLevel )        ( ( UBaseType_t ) ( uxLevel ) * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS )
+
+/* pdTRUE if the tick counts xTime1 and xTime2 only differ within the slot index
+ * of level uxLevel and the levels below it.  The shift is split in two so it
+ * never equals the width of TickType_t. */
+        #define tmrWHEEL_SAME_SPAN( xTime1, xTime2, uxLevel ) \
+    ( ( ( ( ( ( xTime1 ) ^ ( xTime2 ) ) >> tmrWHEEL_SHIFT( uxLevel ) ) >> configTIMER_WHEEL_SLOT_BITS ) == ( TickType_t ) 0 ) ? pdTRUE : pdFALSE )
+    #endif
+
+/* Commands sent by the timer service task to itself can be applied without
+ * going through the timer queue, and commands are received from the timer queue
+ * a batch at a time, when the corresponding options are enabled. */
+    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+        #define tmrPROCESS_COMMAND_DIRECTLY( pxTimer, xCommandID, xOptionalValue )    prvProcessCommandDirectly( ( pxTimer ), ( xCommandID ), ( xOptionalValue ) )
+    #else
+        #define tmrPROCESS_COMMAND_DIRECTLY( pxTimer, xCommandID, xOptionalValue )    ( pdFALSE )
+    #endif
+
+    #if ( configTIMER_COMMAND_BATCH_SIZE > 1 )
+        #define tmrRECEIVE_COMMAND( pxMessage )    prvReceiveCommand( pxMessage )
+        #define tmrCOMMAND_BATCH_IS_EMPTY()        ( ( uxNextCommandInBatch == uxCommandsInBatch ) ? pdTRUE : pdFALSE )
+    #else
+        #define tmrRECEIVE_COMMAND( pxMessage )    xQueueReceive( xTimerQueue, ( pxMessage ), tmrNO_DELAY )
+        #define tmrCOMMAND_BATCH_IS_EMPTY()        ( pdTRUE )
+    #endif
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -139,10 +175,50 @@
     PRIVILEGED_DATA static List_t * pxCurrentTimerList;
     PRIVILEGED_DATA static List_t * pxOverflowTimerList;
 
+/* The tick count when the timer service task last sampled it. */
+    PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+
+/* When configUSE_TIMER_WHEEL is 1 active timers are held in a hierarchical
+ * timing wheel.  Level 0 has one slot per tick, and each slot on level N covers
+ * all the slots of level N - 1.  A timer is placed on the lowest level on which
+ * its expiry time only differs from xTimerWheelTime within that level's own slot
+ * index, so starting, resetting and stopping a timer are all constant time
+ * operations.  When xTimerWheelTime enters the range covered by a slot on a
+ * level above 0 the timers in that slot are redistributed (cascaded) to the
+ * levels below.  pxCurrentTimerList then only holds the timers whose expiry time
+ * is beyond the span of the wheel, still sorted, and pxOverflowTimerList is used
+ * as before. */
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        PRIVILEGED_DATA static List_t xTimerWheel[ configTIMER_WHEEL_LEVELS ][ tmrWHEEL_SLOTS ]; /*< Active timers, indexed by expiry time. */
+        PRIVILEGED_DATA static uint32_t ulTimerWheelOccupied[ configTIMER_WHEEL_LEVELS ];       /*< A bit per slot, set when a timer is placed in the slot.  Timers can leave a slot without the bit being cleared, so a set bit only means the slot might not be empty. */
+        PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;                  /*< The time the wheel is positioned at.  No active timer in the wheel expires before it, and it is never ahead of xLastTime. */
+    #endif
+
+/* Commands received from the timer queue but not yet processed. */
+    #if ( configTIMER_COMMAND_BATCH_SIZE > 1 )
+        PRIVILEGED_DATA static DaemonTaskMessage_t xCommandBatch[ configTIMER_COMMAND_BATCH_SIZE ];
+        PRIVILEGED_DATA static UBaseType_t uxCommandsInBatch = 0U;
+        PRIVILEGED_DATA static UBaseType_t uxNextCommandInBatch = 0U;
+    #endif
+
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
     PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 
+/* Timers that are allocated dynamically are taken from a fixed pool of
+ * configTIMER_POOL_LENGTH timers before falling back to the heap. */
+    #if ( configTIMER_POOL_LENGTH > 0 )
+        PRIVILEGED_DATA static uint8_t ucTimerPoolStorage[ poolSTORAGE_SIZE( configTIMER_POOL_LENGTH, sizeof( Timer_t ) ) ];
+        PRIVILEGED_DATA static uint32_t ulTimerPoolSlotsInUse[ poolBITMAP_WORDS( configTIMER_POOL_LENGTH ) ];
+        PRIVILEGED_DATA static ObjectPool_t xTimerPool = { ucTimerPoolStorage, poolSLOT_SIZE( sizeof( Timer_t ) ), configTIMER_POOL_LENGTH, ulTimerPoolSlotsInUse };
+
+        #define tmrMALLOC_TIMER()           ( ( Timer_t * ) pvObjectPoolMalloc( &xTimerPool, sizeof( Timer_t ) ) )
+        #define tmrFREE_TIMER( pxTimer )    vObjectPoolFree( &xTimerPool, ( pxTimer ) )
+    #else
+        #define tmrMALLOC_TIMER()           ( ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ) )
+        #define tmrFREE_TIMER( pxTimer )    vPortFree( pxTimer )
+    #endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -166,6 +242,69 @@
  */
     static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Apply a command that manipulates a software timer.  The timer must already
+ * have been removed from the active timer lists.
+ */
+    static void prvProcessTimerCommand( Timer_t * const pxTimer,
+                                        const BaseType_t xCommandID,
+                                        const TickType_t xMessageValue,
+                                        const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+    #if ( configTIMER_COMMAND_BATCH_SIZE > 1 )
+
+/*
+ * Obtain the next command for the timer service task, receiving all the
+ * commands waiting on the timer queue, up to configTIMER_COMMAND_BATCH_SIZE of
+ * them, in a single queue operation when the previous batch has been used up.
+ */
+        static BaseType_t prvReceiveCommand( DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+
+    #endif
+
+    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+/*
+ * If called from the timer service task, when no command sent earlier is still
+ * waiting to be processed, apply the command straight away and return pdTRUE.
+ * Otherwise return pdFALSE so the command is sent on the timer queue.
+ */
+        static BaseType_t prvProcessCommandDirectly( Timer_t * const pxTimer,
+                                                     const BaseType_t xCommandID,
+                                                     const TickType_t xOptionalValue ) PRIVILEGED_FUNCTION;
+
+    #endif
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Place the timer, the list item value of which must already be set to its
+ * expiry time, into the timer wheel - or into pxCurrentTimerList if the expiry
+ * time is beyond the span of the wheel.
+ */
+        static void prvTimerWheelInsert( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the timers in pxCurrentTimerList that are now within the span of the
+ * wheel into the wheel.
+ */
+        static void prvTimerWheelPlaceDistantTimers( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the wheel forward to xTime, which must not be later than the expiry time
+ * of any active timer, cascading the slots that are entered on the way.
+ */
+        static void prvTimerWheelAdvance( const TickType_t xTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * If any timer in the wheel or in pxCurrentTimerList is active then set
+ * *pxNextExpireTime to the earliest expiry time and return pdTRUE, otherwise
+ * return pdFALSE.
+ */
+        static BaseType_t prvTimerWheelNextExpireTime( TickType_t * const pxNextExpireTime ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_WHEEL */
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
@@ -293,7 +432,7 @@
         {
             Timer_t * pxNewTimer;
 
-            pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
+            pxNewTimer = tmrMALLOC_TIMER(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
 
             if( pxNewTimer != NULL )
             {
@@ -405,7 +544,13 @@
 
             if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
             {
-                if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+                if( tmrPROCESS_COMMAND_DIRECTLY( xTimer, xCommandID, xOptionalValue ) != pdFALSE )
+                {
+                    /* The timer service task sent the command to itself, so it
+                     * has already been applied. */
+                    xReturn = pdPASS;
+                }
+                else if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
                 {
                     xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
                 }
@@ -534,6 +679,23 @@
             /* Call the timer callback. */
             traceTIMER_EXPIRED( pxTimer );
             pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+
+            #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+            {
+                /* The callback may have restarted, stopped or changed the
+                 * period of this timer directly, in which case the command
+                 * takes precedence over the remaining expirations. */
+                if( ( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) ||
+                    ( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0 ) )
+                {
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_TIMER_DIRECT_COMMANDS */
         }
     }
 /*-----------------------------------------------------------*/
@@ -541,7 +703,20 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        Timer_t * pxTimer;
+
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            /* Moving the wheel to the expiry time cascades the timer down to the
+             * level 0 slot for that time. */
+            prvTimerWheelAdvance( xNextExpireTime );
+            pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xTimerWheel[ 0 ][ xNextExpireTime & tmrWHEEL_SLOT_MASK ] ) ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        }
+        #else
+        {
+            pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        }
+        #endif /* configUSE_TIMER_WHEEL */
 
         /* Remove the timer from the list of active timers.  A check has already
          * been performed to ensure the list is not empty. */
@@ -674,17 +849,34 @@
          * this task to unblock when the tick count overflows, at which point the
          * timer lists will be switched and the next expiry time can be
          * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-
-        if( *pxListWasEmpty == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            if( prvTimerWheelNextExpireTime( &xNextExpireTime ) != pdFALSE )
+            {
+                *pxListWasEmpty = pdFALSE;
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                *pxListWasEmpty = pdTRUE;
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
         }
-        else
+        #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
         }
+        #endif /* configUSE_TIMER_WHEEL */
 
         return xNextExpireTime;
     }
@@ -693,7 +885,6 @@
     static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
     {
         TickType_t xTimeNow;
-        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
         xTimeNow = xTaskGetTickCount();
 
@@ -749,7 +940,15 @@
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    prvTimerWheelInsert( pxTimer );
+                }
+                #else
+                {
+                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #endif
             }
         }
 
@@ -764,7 +963,7 @@
         BaseType_t xTimerListsWereSwitched;
         TickType_t xTimeNow;
 
-        while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+        while( tmrRECEIVE_COMMAND( &xMessage ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
         {
             #if ( INCLUDE_xTimerPendFunctionCall == 1 )
             {
@@ -816,93 +1015,216 @@
                  *  pre-empted the timer daemon task after the xTimeNow value was set). */
                 xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 
-                switch( xMessage.xMessageID )
+                #if ( configUSE_TIMER_WHEEL == 1 )
                 {
-                    case tmrCOMMAND_START:
-                    case tmrCOMMAND_START_FROM_ISR:
-                    case tmrCOMMAND_RESET:
-                    case tmrCOMMAND_RESET_FROM_ISR:
-                        /* Start or restart a timer. */
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-
-                        if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-                        {
-                            /* The timer expired before it was added to the active
-                             * timer list.  Process it now. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-                            {
-                                prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
-                            }
-                            else
-                            {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
+                    /* Keep the wheel close to the current time so the timer is
+                     * placed on as low a level as possible. */
+                    TickType_t xNextExpireTime;
 
-                            /* Call the timer callback. */
-                            traceTIMER_EXPIRED( pxTimer );
-                            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                    if( ( prvTimerWheelNextExpireTime( &xNextExpireTime ) == pdFALSE ) || ( xNextExpireTime > xTimeNow ) )
+                    {
+                        xNextExpireTime = xTimeNow;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-                        break;
+                    prvTimerWheelAdvance( xNextExpireTime );
+                }
+                #endif /* configUSE_TIMER_WHEEL */
 
-                    case tmrCOMMAND_STOP:
-                    case tmrCOMMAND_STOP_FROM_ISR:
-                        /* The timer has already been removed from the active list. */
+                prvProcessTimerCommand( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue, xTimeNow );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessTimerCommand( Timer_t * const pxTimer,
+                                        const BaseType_t xCommandID,
+                                        const TickType_t xMessageValue,
+                                        const TickType_t xTimeNow )
+    {
+        switch( xCommandID )
+        {
+            case tmrCOMMAND_START:
+            case tmrCOMMAND_START_FROM_ISR:
+            case tmrCOMMAND_RESET:
+            case tmrCOMMAND_RESET_FROM_ISR:
+                /* Start or restart a timer. */
+                pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+
+                if( prvInsertTimerInActiveList( pxTimer, xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessageValue ) != pdFALSE )
+                {
+                    /* The timer expired before it was added to the active
+                     * timer list.  Process it now. */
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                    {
+                        prvReloadTimer( pxTimer, xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                    }
+                    else
+                    {
                         pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        break;
+                    }
 
-                    case tmrCOMMAND_CHANGE_PERIOD:
-                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-                        pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-                        /* The new period does not really have a reference, and can
-                         * be longer or shorter than the old one.  The command time is
-                         * therefore set to the current time, and as the period cannot
-                         * be zero the next expiry time can only be in the future,
-                         * meaning (unlike for the xTimerStart() case above) there is
-                         * no fail case that needs to be handled here. */
-                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-                        break;
+                    /* Call the timer callback. */
+                    traceTIMER_EXPIRED( pxTimer );
+                    pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-                    case tmrCOMMAND_DELETE:
-                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-                        {
-                            /* The timer has already been removed from the active list,
-                             * just free up the memory if the memory was dynamically
-                             * allocated. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
-                            {
-                                vPortFree( pxTimer );
-                            }
-                            else
-                            {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
-                        }
-                        #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
-                        {
-                            /* If dynamic allocation is not enabled, the memory
-                             * could not have been dynamically allocated. So there is
-                             * no need to free the memory - just mark the timer as
-                             * "not active". */
-                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        }
-                        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                        break;
+                break;
+
+            case tmrCOMMAND_STOP:
+            case tmrCOMMAND_STOP_FROM_ISR:
+                /* The timer has already been removed from the active list. */
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                break;
+
+            case tmrCOMMAND_CHANGE_PERIOD:
+            case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                pxTimer->xTimerPeriodInTicks = xMessageValue;
+                configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+                /* The new period does not really have a reference, and can
+                 * be longer or shorter than the old one.  The command time is
+                 * therefore set to the current time, and as the period cannot
+                 * be zero the next expiry time can only be in the future,
+                 * meaning (unlike for the xTimerStart() case above) there is
+                 * no fail case that needs to be handled here. */
+                ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                break;
+
+            case tmrCOMMAND_DELETE:
+                #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                {
+                    /* The timer has already been removed from the active list,
+                     * just free up the memory if the memory was dynamically
+                     * allocated. */
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                    {
+                        tmrFREE_TIMER( pxTimer );
+                    }
+                    else
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+                }
+                #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                {
+                    /* If dynamic allocation is not enabled, the memory
+                     * could not have been dynamically allocated. So there is
+                     * no need to free the memory - just mark the timer as
+                     * "not active". */
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                }
+                #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                break;
 
-                    default:
-                        /* Don't expect to get here. */
-                        break;
+            default:
+                /* Don't expect to get here. */
+                break;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configTIMER_COMMAND_BATCH_SIZE > 1 )
+
+        static BaseType_t prvReceiveCommand( DaemonTaskMessage_t * const pxMessage )
+        {
+            BaseType_t xReturn = pdFAIL;
+
+            if( uxNextCommandInBatch == uxCommandsInBatch )
+            {
+                /* The previous batch has been processed, so take every command
+                 * waiting on the queue, up to the size of the batch, in one
+                 * queue operation. */
+                uxCommandsInBatch = xQueueReceiveMultiple( xTimerQueue, xCommandBatch, ( UBaseType_t ) configTIMER_COMMAND_BATCH_SIZE, tmrNO_DELAY );
+                uxNextCommandInBatch = 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( uxNextCommandInBatch < uxCommandsInBatch )
+            {
+                *pxMessage = xCommandBatch[ uxNextCommandInBatch ];
+                uxNextCommandInBatch++;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configTIMER_COMMAND_BATCH_SIZE */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+        static BaseType_t prvProcessCommandDirectly( Timer_t * const pxTimer,
+                                                     const BaseType_t xCommandID,
+                                                     const TickType_t xOptionalValue )
+        {
+            BaseType_t xReturn = pdFALSE;
+            TickType_t xTimeNow;
+
+            /* Deleting a timer is always left to the queue as the timer service
+             * task may still reference the timer after its callback returns. */
+            if( ( xCommandID != tmrCOMMAND_DELETE ) &&
+                ( xTimerTaskHandle != NULL ) &&
+                ( xTaskGetCurrentTaskHandle() == xTimerTaskHandle ) )
+            {
+                xTimeNow = xTaskGetTickCount();
+
+                /* Commands must still be applied in the order they were sent,
+                 * and the timer lists must not be switched while the timer
+                 * service task is part way through processing a timer, so the
+                 * command can only be applied now if nothing is waiting to be
+                 * processed and the tick count has not overflowed since the
+                 * timer service task last sampled it.  The queue is only read
+                 * once, so a critical section is not needed - a command that
+                 * arrives after the read is not ordered with respect to this
+                 * one anyway. */
+                if( ( xTimeNow >= xLastTime ) &&
+                    ( tmrCOMMAND_BATCH_IS_EMPTY() != pdFALSE ) &&
+                    ( uxQueueMessagesWaitingFromISR( xTimerQueue ) == ( UBaseType_t ) 0 ) )
+                {
+                    if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+                    {
+                        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
+                    prvProcessTimerCommand( pxTimer, xCommandID, xOptionalValue, xTimeNow );
+                    xReturn = pdTRUE;
                 }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
+
+            return xReturn;
         }
-    }
+
+    #endif /* configUSE_TIMER_DIRECT_COMMANDS */
 /*-----------------------------------------------------------*/
 
     static void prvSwitchTimerLists( void )
@@ -914,22 +1236,246 @@
          * If there are any timers still referenced from the current timer list
          * then they must have expired and should be processed before the lists
          * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            while( prvTimerWheelNextExpireTime( &xNextExpireTime ) != pdFALSE )
+            {
+                /* As below, only expirations that occur before the overflow are
+                 * processed. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
+        }
+        #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
+        {
+            while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-            /* Process the expired timer.  For auto-reload timers, be careful to
-             * process only expirations that occur on the current list.  Further
-             * expirations must wait until after the lists are switched. */
-            prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+                /* Process the expired timer.  For auto-reload timers, be careful to
+                 * process only expirations that occur on the current list.  Further
+                 * expirations must wait until after the lists are switched. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
         }
+        #endif /* configUSE_TIMER_WHEEL */
 
         pxTemp = pxCurrentTimerList;
         pxCurrentTimerList = pxOverflowTimerList;
         pxOverflowTimerList = pxTemp;
+
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            /* The wheel is empty.  Restart it from time zero, and move in the
+             * timers that were waiting for the overflow. */
+            xTimerWheelTime = ( TickType_t ) 0U;
+            prvTimerWheelPlaceDistantTimers();
+        }
+        #endif /* configUSE_TIMER_WHEEL */
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvTimerWheelInsert( Timer_t * const pxTimer )
+        {
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+            UBaseType_t uxLevel;
+            UBaseType_t uxSlot;
+
+            /* Use the lowest level on which the expiry time only differs from
+             * the wheel time within the level's own slot index.  As the expiry
+             * time is not before the wheel time the slot is never behind the
+             * wheel's position on that level. */
+            for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+            {
+                if( tmrWHEEL_SAME_SPAN( xExpiryTime, xTimerWheelTime, uxLevel ) != pdFALSE )
+                {
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS )
+            {
+                uxSlot = ( UBaseType_t ) ( ( xExpiryTime >> tmrWHEEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK );
+                vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+                ulTimerWheelOccupied[ uxLevel ] |= ( uint32_t ) 1U << uxSlot;
+            }
+            else
+            {
+                /* Beyond the span of the wheel. */
+                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvTimerWheelPlaceDistantTimers( void )
+        {
+            Timer_t * pxTimer;
+
+            /* pxCurrentTimerList is sorted, so stop at the first timer that is
+             * still beyond the span of the wheel. */
+            while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+            {
+                if( tmrWHEEL_SAME_SPAN( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList ), xTimerWheelTime, ( configTIMER_WHEEL_LEVELS - 1 ) ) == pdFALSE )
+                {
+                    break;
+                }
+                else
+                {
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    prvTimerWheelInsert( pxTimer );
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvTimerWheelAdvance( const TickType_t xTime )
+        {
+            const TickType_t xDifference = xTime ^ xTimerWheelTime;
+            UBaseType_t uxLevel;
+            UBaseType_t uxSlot;
+            List_t * pxSlot;
+            Timer_t * pxTimer;
+
+            xTimerWheelTime = xTime;
+
+            /* If the wheel has moved into the next span of the top level then
+             * some of the distant timers may now fit in the wheel. */
+            if( tmrWHEEL_SAME_SPAN( xDifference, ( TickType_t ) 0U, ( configTIMER_WHEEL_LEVELS - 1 ) ) == pdFALSE )
+            {
+                prvTimerWheelPlaceDistantTimers();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Cascade the slot the wheel has entered on each level on which
+             * its position changed, highest level first so timers can cascade
+             * more than one level. */
+            for( uxLevel = ( UBaseType_t ) configTIMER_WHEEL_LEVELS - 1U; uxLevel > 0U; uxLevel-- )
+            {
+                if( ( xDifference >> tmrWHEEL_SHIFT( uxLevel ) ) != ( TickType_t ) 0U )
+                {
+                    uxSlot = ( UBaseType_t ) ( ( xTime >> tmrWHEEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK );
+                    pxSlot = &( xTimerWheel[ uxLevel ][ uxSlot ] );
+
+                    while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                    {
+                        pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                        prvTimerWheelInsert( pxTimer );
+                    }
+
+                    ulTimerWheelOccupied[ uxLevel ] &= ~( ( uint32_t ) 1U << uxSlot );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvTimerWheelNextExpireTime( TickType_t * const pxNextExpireTime )
+        {
+            BaseType_t xFound = pdFALSE;
+            UBaseType_t uxLevel;
+            UBaseType_t uxSlot;
+            uint32_t ulCandidates;
+            List_t * pxSlot;
+            ListItem_t * pxItem;
+            ListItem_t const * pxEnd;
+            TickType_t xValue;
+
+            /* The slots of a level are ordered by time from the wheel's
+             * position on that level, and every timer on a level expires before
+             * any timer on the levels above, so the first occupied slot found
+             * searching upwards holds the next timer to expire. */
+            for( uxLevel = 0U; ( uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS ) && ( xFound == pdFALSE ); uxLevel++ )
+            {
+                if( ulTimerWheelOccupied[ uxLevel ] == 0U )
+                {
+                    continue;
+                }
+
+                uxSlot = ( UBaseType_t ) ( ( xTimerWheelTime >> tmrWHEEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK );
+
+                /* On level 0 the current slot holds timers that expire now.
+                 * Above level 0 the current slot has already been cascaded. */
+                if( uxLevel == 0U )
+                {
+                    ulCandidates = ulTimerWheelOccupied[ 0 ] & ~( ( ( uint32_t ) 1U << uxSlot ) - 1U );
+                }
+                else
+                {
+                    ulCandidates = ulTimerWheelOccupied[ uxLevel ] & ~( ( ( uint32_t ) 2U << uxSlot ) - 1U );
+                }
+
+                for( uxSlot = 0U; ulCandidates != 0U; uxSlot++, ulCandidates >>= 1 )
+                {
+                    if( ( ulCandidates & 1U ) == 0U )
+                    {
+                        continue;
+                    }
+
+                    pxSlot = &( xTimerWheel[ uxLevel ][ uxSlot ] );
+
+                    if( listLIST_IS_EMPTY( pxSlot ) != pdFALSE )
+                    {
+                        /* Every timer has left the slot. */
+                        ulTimerWheelOccupied[ uxLevel ] &= ~( ( uint32_t ) 1U << uxSlot );
+                    }
+                    else if( uxLevel == 0U )
+                    {
+                        /* All the timers in a level 0 slot expire together. */
+                        *pxNextExpireTime = ( xTimerWheelTime & ~tmrWHEEL_SLOT_MASK ) | ( TickType_t ) uxSlot;
+                        xFound = pdTRUE;
+                        break;
+                    }
+                    else
+                    {
+                        /* Timers in a higher level slot are not sorted. */
+                        pxEnd = listGET_END_MARKER( pxSlot );
+                        *pxNextExpireTime = listGET_LIST_ITEM_VALUE( listGET_HEAD_ENTRY( pxSlot ) );
+
+                        for( pxItem = listGET_HEAD_ENTRY( pxSlot ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+                        {
+                            xValue = listGET_LIST_ITEM_VALUE( pxItem );
+
+                            if( xValue < *pxNextExpireTime )
+                            {
+                                *pxNextExpireTime = xValue;
+                            }
+                        }
+
+                        xFound = pdTRUE;
+                        break;
+                    }
+                }
+            }
+
+            if( ( xFound == pdFALSE ) && ( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE ) )
+            {
+                *pxNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+                xFound = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xFound;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
     static void prvCheckForValidListAndQueue( void )
     {
         /* Check that the list from which active timers are referenced, and the
@@ -944,6 +1490,23 @@
                 pxCurrentTimerList = &xActiveTimerList1;
                 pxOverflowTimerList = &xActiveTimerList2;
 
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    UBaseType_t uxLevel;
+                    UBaseType_t uxSlot;
+
+                    for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                        {
+                            vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                        }
+
+                        ulTimerWheelOccupied[ uxLevel ] = 0U;
+                    }
+                }
+                #endif /* configUSE_TIMER_WHEEL */
+
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
                     /* The timer queue is allocated statically in case
@@ -0,0 +1,361 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of passing small items through a queue and through a
+ * message buffer one at a time, and in batches using xQueueSendMultiple(),
+ * xQueueReceiveMultiple(), xMessageBufferSendMultiple() and
+ * xMessageBufferReceiveMultiple().
+ *
+ * Usage: batch_bench <queue|message_buffer> <batch size>
+ *
+ * A task is created and selected as the running task, and on its behalf
+ * batches of items are repeatedly sent to, then received from, the object.  A
+ * batch size of 1 uses xQueueSend()/xQueueReceive() or
+ * xMessageBufferSend()/xMessageBufferReceive().  The time reported is per item.
+ *
+ * The batch functions are first checked to move items in order, to move
+ * partial batches when the object does not have room for a whole batch, and
+ * (for queues) to notify a queue set once per item.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "message_buffer.h"
+
+#define benchITEMS              ( 4000000UL )
+#define benchITEM_SIZE          ( 16 )
+#define benchMAX_BATCH_SIZE     ( 64UL )
+#define benchQUEUE_LENGTH       ( benchMAX_BATCH_SIZE )
+#define benchMESSAGE_BUFFER_SIZE \
+    ( benchMAX_BATCH_SIZE * ( benchITEM_SIZE + sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) ) )
+
+/*-----------------------------------------------------------*/
+
+static uint8_t ucSendItems[ benchMAX_BATCH_SIZE ][ benchITEM_SIZE ];
+static uint8_t ucReceiveItems[ benchMAX_BATCH_SIZE ][ benchITEM_SIZE ];
+static const void * pvSendItems[ benchMAX_BATCH_SIZE ];
+static size_t xItemLengths[ benchMAX_BATCH_SIZE ];
+static size_t xReceivedLengths[ benchMAX_BATCH_SIZE ];
+
+/* The number of items that were not received in the order they were sent. */
+static uint32_t ulOutOfOrder = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    /* Never executes. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProduce( unsigned long ulBatchSize,
+                        uint32_t ulSequence )
+{
+    unsigned long x;
+
+    for( x = 0; x < ulBatchSize; x++ )
+    {
+        memcpy( ucSendItems[ x ], &ulSequence, sizeof( ulSequence ) );
+        ulSequence++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsume( unsigned long ulBatchSize,
+                        uint32_t ulSequence )
+{
+    unsigned long x;
+    uint32_t ulReceived;
+
+    for( x = 0; x < ulBatchSize; x++ )
+    {
+        memcpy( &ulReceived, ucReceiveItems[ x ], sizeof( ulReceived ) );
+
+        if( ulReceived != ulSequence )
+        {
+            ulOutOfOrder++;
+        }
+
+        ulSequence++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckQueueBatches( void )
+{
+    QueueHandle_t xQueue;
+    QueueSetHandle_t xQueueSet;
+    uint32_t ulItems[ 10 ], ulReceived[ 10 ], x;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    for( x = 0; x < 10; x++ )
+    {
+        ulItems[ x ] = x;
+    }
+
+    xQueue = xQueueCreate( 8, sizeof( uint32_t ) );
+    configASSERT( xQueue != NULL );
+
+    /* Nothing is moved when nothing is asked for. */
+    configASSERT( xQueueSendMultiple( xQueue, ulItems, 0, 0 ) == 0 );
+    configASSERT( xQueueReceiveMultiple( xQueue, ulReceived, 0, 0 ) == 0 );
+    configASSERT( xQueueReceiveMultiple( xQueue, ulReceived, 4, 0 ) == 0 );
+
+    /* A batch larger than the free space is sent in part. */
+    configASSERT( xQueueSendMultiple( xQueue, ulItems, 10, 0 ) == 8 );
+    configASSERT( xQueueSendMultiple( xQueue, &ulItems[ 8 ], 2, 0 ) == 0 );
+    configASSERT( uxQueueMessagesWaiting( xQueue ) == 8 );
+
+    /* Items are received in the order they were sent, mixing single item and
+     * batch calls. */
+    configASSERT( xQueueReceiveMultiple( xQueue, ulReceived, 3, 0 ) == 3 );
+    configASSERT( ( ulReceived[ 0 ] == 0 ) && ( ulReceived[ 1 ] == 1 ) && ( ulReceived[ 2 ] == 2 ) );
+    configASSERT( xQueueReceive( xQueue, ulReceived, 0 ) == pdPASS );
+    configASSERT( ulReceived[ 0 ] == 3 );
+
+    configASSERT( xQueueSendMultipleFromISR( xQueue, &ulItems[ 8 ], 2, &xHigherPriorityTaskWoken ) == 2 );
+    configASSERT( xQueueSend( xQueue, &ulItems[ 0 ], 0 ) == pdPASS );
+    configASSERT( xQueueSendMultipleFromISR( xQueue, &ulItems[ 1 ], 2, &xHigherPriorityTaskWoken ) == 1 );
+    configASSERT( uxQueueSpacesAvailable( xQueue ) == 0 );
+
+    configASSERT( xQueueReceiveMultipleFromISR( xQueue, ulReceived, 10, &xHigherPriorityTaskWoken ) == 8 );
+
+    for( x = 0; x < 8; x++ )
+    {
+        configASSERT( ulReceived[ x ] == ( ( x < 6 ) ? ( x + 4 ) : ( x - 6 ) ) );
+    }
+
+    configASSERT( xQueueReceiveMultipleFromISR( xQueue, ulReceived, 10, &xHigherPriorityTaskWoken ) == 0 );
+    configASSERT( xHigherPriorityTaskWoken == pdFALSE );
+
+    /* A queue set is notified once per item, so each item is selected. */
+    xQueueSet = xQueueCreateSet( 8 );
+    configASSERT( xQueueSet != NULL );
+    configASSERT( xQueueAddToSet( xQueue, xQueueSet ) == pdPASS );
+
+    configASSERT( xQueueSendMultiple( xQueue, ulItems, 3, 0 ) == 3 );
+    configASSERT( xQueueSendMultipleFromISR( xQueue, &ulItems[ 3 ], 2, &xHigherPriorityTaskWoken ) == 2 );
+
+    for( x = 0; x < 5; x++ )
+    {
+        configASSERT( xQueueSelectFromSet( xQueueSet, 0 ) == xQueue );
+        configASSERT( xQueueReceive( xQueue, ulReceived, 0 ) == pdPASS );
+        configASSERT( ulReceived[ 0 ] == x );
+    }
+
+    configASSERT( xQueueSelectFromSet( xQueueSet, 0 ) == NULL );
+
+    configASSERT( xQueueRemoveFromSet( xQueue, xQueueSet ) == pdPASS );
+    vQueueDelete( xQueueSet );
+    vQueueDelete( xQueue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckMessageBufferBatches( void )
+{
+    MessageBufferHandle_t xMessageBuffer;
+    const size_t xLengthSize = sizeof( configMESSAGE_BUFFER_LENGTH_TYPE );
+    uint8_t ucMessages[ 3 ][ 30 ], ucReceived[ 64 ];
+    const void * pvMessages[ 3 ] = { ucMessages[ 0 ], ucMessages[ 1 ], ucMessages[ 2 ] };
+    size_t xLengths[ 3 ] = { 10, 20, 30 }, xReceivedLengths[ 3 ];
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    memset( ucMessages[ 0 ], 'a', sizeof( ucMessages[ 0 ] ) );
+    memset( ucMessages[ 1 ], 'b', sizeof( ucMessages[ 1 ] ) );
+    memset( ucMessages[ 2 ], 'c', sizeof( ucMessages[ 2 ] ) );
+
+    /* Room for the first two messages only. */
+    xMessageBuffer = xMessageBufferCreate( 10 + 20 + ( 2 * xLengthSize ) );
+    configASSERT( xMessageBuffer != NULL );
+
+    configASSERT( xMessageBufferSendMultiple( xMessageBuffer, pvMessages, xLengths, 0, 0 ) == 0 );
+    configASSERT( xMessageBufferSendMultiple( xMessageBuffer, pvMessages, xLengths, 3, 0 ) == 2 );
+    configASSERT( xMessageBufferSpacesAvailable( xMessageBuffer ) == 0 );
+    configASSERT( xMessageBufferSendMultipleFromISR( xMessageBuffer, &pvMessages[ 2 ], &xLengths[ 2 ], 1, &xHigherPriorityTaskWoken ) == 0 );
+
+    /* Messages are received back to back until one does not fit. */
+    configASSERT( xMessageBufferReceiveMultiple( xMessageBuffer, ucReceived, 25, xReceivedLengths, 3, 0 ) == 1 );
+    configASSERT( ( xReceivedLengths[ 0 ] == 10 ) && ( ucReceived[ 9 ] == 'a' ) );
+
+    /* A message longer than the buffer provided is left in the message
+     * buffer. */
+    configASSERT( xMessageBufferReceiveMultiple( xMessageBuffer, ucReceived, 19, xReceivedLengths, 3, 0 ) == 0 );
+    configASSERT( xStreamBufferNextMessageLengthBytes( xMessageBuffer ) == 20 );
+
+    /* Messages sent singly and in batches are received in order, and the
+     * receive stops when no messages remain. */
+    configASSERT( xMessageBufferSend( xMessageBuffer, ucMessages[ 0 ], 10, 0 ) == 10 );
+    configASSERT( xMessageBufferReceiveMultipleFromISR( xMessageBuffer, ucReceived, sizeof( ucReceived ), xReceivedLengths, 3, &xHigherPriorityTaskWoken ) == 2 );
+    configASSERT( ( xReceivedLengths[ 0 ] == 20 ) && ( xReceivedLengths[ 1 ] == 10 ) );
+    configASSERT( ( ucReceived[ 0 ] == 'b' ) && ( ucReceived[ 19 ] == 'b' ) && ( ucReceived[ 20 ] == 'a' ) && ( ucReceived[ 29 ] == 'a' ) );
+    configASSERT( xMessageBufferIsEmpty( xMessageBuffer ) == pdTRUE );
+
+    /* Sending stops at a zero length message. */
+    xLengths[ 1 ] = 0;
+    configASSERT( xMessageBufferSendMultipleFromISR( xMessageBuffer, pvMessages, xLengths, 3, &xHigherPriorityTaskWoken ) == 1 );
+    configASSERT( xMessageBufferReceiveMultiple( xMessageBuffer, ucReceived, sizeof( ucReceived ), xReceivedLengths, 3, 0 ) == 1 );
+    configASSERT( xHigherPriorityTaskWoken == pdFALSE );
+
+    vMessageBufferDelete( xMessageBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchQueue( unsigned long ulBatchSize )
+{
+    QueueHandle_t xQueue;
+    unsigned long ulItem;
+
+    xQueue = xQueueCreate( benchQUEUE_LENGTH, benchITEM_SIZE );
+    configASSERT( xQueue != NULL );
+
+    for( ulItem = 0; ulItem < benchITEMS; ulItem += ulBatchSize )
+    {
+        prvProduce( ulBatchSize, ulItem );
+
+        if( ulBatchSize == 1 )
+        {
+            configASSERT( xQueueSend( xQueue, ucSendItems, 0 ) == pdPASS );
+            configASSERT( xQueueReceive( xQueue, ucReceiveItems, 0 ) == pdPASS );
+        }
+        else
+        {
+            configASSERT( xQueueSendMultiple( xQueue, ucSendItems, ulBatchSize, 0 ) == ulBatchSize );
+            configASSERT( xQueueReceiveMultiple( xQueue, ucReceiveItems, ulBatchSize, 0 ) == ulBatchSize );
+        }
+
+        prvConsume( ulBatchSize, ulItem );
+    }
+
+    vQueueDelete( xQueue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchMessageBuffer( unsigned long ulBatchSize )
+{
+    MessageBufferHandle_t xMessageBuffer;
+    unsigned long ulItem, x;
+
+    xMessageBuffer = xMessageBufferCreate( benchMESSAGE_BUFFER_SIZE );
+    configASSERT( xMessageBuffer != NULL );
+
+    for( x = 0; x < benchMAX_BATCH_SIZE; x++ )
+    {
+        pvSendItems[ x ] = ucSendItems[ x ];
+        xItemLengths[ x ] = benchITEM_SIZE;
+    }
+
+    for( ulItem = 0; ulItem < benchITEMS; ulItem += ulBatchSize )
+    {
+        prvProduce( ulBatchSize, ulItem );
+
+        if( ulBatchSize == 1 )
+        {
+            configASSERT( xMessageBufferSend( xMessageBuffer, ucSendItems, benchITEM_SIZE, 0 ) == benchITEM_SIZE );
+            configASSERT( xMessageBufferReceive( xMessageBuffer, ucReceiveItems, benchITEM_SIZE, 0 ) == benchITEM_SIZE );
+        }
+        else
+        {
+            configASSERT( xMessageBufferSendMultiple( xMessageBuffer, pvSendItems, xItemLengths, ulBatchSize, 0 ) == ulBatchSize );
+            configASSERT( xMessageBufferReceiveMultiple( xMessageBuffer, ucReceiveItems, sizeof( ucReceiveItems ), xReceivedLengths, ulBatchSize, 0 ) == ulBatchSize );
+        }
+
+        prvConsume( ulBatchSize, ulItem );
+    }
+
+    vMessageBufferDelete( xMessageBuffer );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    TaskHandle_t xTask;
+    const char * pcObject;
+    unsigned long ulBatchSize;
+    uint64_t ullStart, ullTime;
+
+    pcObject = ( argc > 1 ) ? argv[ 1 ] : "queue";
+    ulBatchSize = ( argc > 2 ) ? strtoul( argv[ 2 ], NULL, 10 ) : 8;
+    configASSERT( ( ulBatchSize > 0 ) && ( ulBatchSize <= benchMAX_BATCH_SIZE ) );
+    configASSERT( ( benchITEMS % ulBatchSize ) == 0 );
+    configASSERT( ( strcmp( pcObject, "queue" ) == 0 ) || ( strcmp( pcObject, "message_buffer" ) == 0 ) );
+
+    /* Returns with the idle task selected as the running task. */
+    vTaskStartScheduler();
+
+    /* Creating a task with a priority above the idle task selects it as the
+     * running task, so the objects are used on its behalf. */
+    configASSERT( xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTask ) == pdPASS );
+    configASSERT( xTaskGetCurrentTaskHandle() == xTask );
+
+    prvCheckQueueBatches();
+    prvCheckMessageBufferBatches();
+
+    ullStart = prvNanoseconds();
+
+    if( strcmp( pcObject, "queue" ) == 0 )
+    {
+        prvBenchQueue( ulBatchSize );
+    }
+    else
+    {
+        prvBenchMessageBuffer( ulBatchSize );
+    }
+
+    ullTime = prvNanoseconds() - ullStart;
+
+    printf( "%-14s batch %2lu  send+receive %6.1f ns per item\r\n", pcObject, ulBatchSize, ( double ) ullTime / ( double ) benchITEMS );
+
+    if( ulOutOfOrder != 0 )
+    {
+        printf( "FAIL: items were corrupted or reordered\r\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
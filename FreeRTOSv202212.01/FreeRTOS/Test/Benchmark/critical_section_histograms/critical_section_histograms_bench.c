@@ -0,0 +1,349 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the overhead of configUSE_CRITICAL_SECTION_HISTOGRAMS on the Posix
+ * port, and checks the histograms it records.
+ *
+ * Usage: critical_section_histograms_bench_<method> <operations>
+ *
+ * critical: taskENTER_CRITICAL()/taskEXIT_CRITICAL() pairs.
+ * suspend:  vTaskSuspendAll()/xTaskResumeAll() pairs.
+ * queue:    a task sends to a higher priority task blocked on a queue, so each
+ *           send costs two task switches and several critical sections.
+ *
+ * With the histograms a task then spins inside critical sections of up to
+ * benchLONGEST_SPIN_NS, the histograms are printed through the FreeRTOS+CLI
+ * critical-sections command, and once the scheduler has ended the sites with
+ * the longest sections are resolved to source lines with addr2line.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard includes. */
+#include <dlfcn.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+    #include "FreeRTOS_CLI.h"
+    #define benchMETHOD_NAME    "histograms"
+#else
+    #define benchMETHOD_NAME    "off"
+#endif
+
+/* The spinning task's critical sections last from 1 us up to this long. */
+#define benchLONGEST_SPIN_NS    ( 64000ULL )
+
+/* The number of critical sections the spinning task enters. */
+#define benchSPINS              ( 1000UL )
+
+/* The number of sites resolved to source lines. */
+#define benchSITES_TO_RESOLVE   ( 5 )
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulOperations;
+static TaskHandle_t xControlTask;
+static QueueHandle_t xQueue;
+
+#if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+    static CriticalSectionHistogram_t xHistograms[ configCRITICAL_SECTION_HISTOGRAM_SITES ];
+    static UBaseType_t uxHistograms;
+#endif
+
+/*-----------------------------------------------------------*/
+
+static unsigned long long prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( unsigned long long ) xTime.tv_sec * 1000000000ULL ) + ( unsigned long long ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( const char * pcTest,
+                       unsigned long long ullWallNs )
+{
+    printf( "%-10s %-8s %8lu ops  %8.1f ns/op\r\n",
+            benchMETHOD_NAME, pcTest, ulOperations,
+            ( double ) ullWallNs / ( double ) ulOperations );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiveTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xQueueReceive( xQueue, &ulValue, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    for( ulValue = 0; ulValue < ulOperations; ulValue++ )
+    {
+        ( void ) xQueueSend( xQueue, &ulValue, portMAX_DELAY );
+    }
+
+    xTaskNotifyGive( xControlTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+
+    static void prvSpinTask( void * pvParameters )
+    {
+        unsigned long ulSpin;
+        unsigned long long ullStart, ullLength;
+
+        ( void ) pvParameters;
+
+        for( ulSpin = 0; ulSpin < benchSPINS; ulSpin++ )
+        {
+            /* Lengths spread over the buckets from 1 us up. */
+            ullLength = 1000ULL << ( ulSpin % 7UL );
+
+            taskENTER_CRITICAL();
+            {
+                ullStart = prvNanoseconds();
+
+                while( ( prvNanoseconds() - ullStart ) < ullLength )
+                {
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        xTaskNotifyGive( xControlTask );
+        vTaskSuspend( NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvResolve( const CriticalSectionHistogram_t * pxHistogram )
+    {
+        Dl_info xInfo;
+        char cCommand[ 128 ], cLine[ 256 ];
+        FILE * pxPipe = NULL;
+        uintptr_t uxOffset = 0;
+
+        /* addr2line wants the offset into the executable, which is loaded at
+         * a random address. */
+        if( ( pxHistogram->pvCallSite != NULL ) && ( dladdr( pxHistogram->pvCallSite, &xInfo ) != 0 ) )
+        {
+            uxOffset = ( uintptr_t ) pxHistogram->pvCallSite - ( uintptr_t ) xInfo.dli_fbase;
+            snprintf( cCommand, sizeof( cCommand ), "addr2line -f -s -p -e /proc/%d/exe 0x%lx 2>/dev/null", ( int ) getpid(), ( unsigned long ) ( uxOffset - 1U ) );
+            pxPipe = popen( cCommand, "r" );
+        }
+
+        if( ( pxPipe != NULL ) && ( fgets( cLine, sizeof( cLine ), pxPipe ) != NULL ) )
+        {
+            cLine[ strcspn( cLine, "\r\n" ) ] = '\0';
+        }
+        else
+        {
+            snprintf( cLine, sizeof( cLine ), "offset 0x%lx", ( unsigned long ) uxOffset );
+        }
+
+        if( pxPipe != NULL )
+        {
+            ( void ) pclose( pxPipe );
+        }
+
+        printf( "%-10s %-9s longest %8lu ns  %7lu sections  %s\r\n", benchMETHOD_NAME,
+                ( pxHistogram->xSchedulerSuspended != pdFALSE ) ? "suspended" : "critical",
+                ( unsigned long ) pxHistogram->ulLongest, ( unsigned long ) pxHistogram->ulCount, cLine );
+    }
+/*-----------------------------------------------------------*/
+
+    static int prvCompareLongest( const void * pvA,
+                                  const void * pvB )
+    {
+        const CriticalSectionHistogram_t * pxA = pvA;
+        const CriticalSectionHistogram_t * pxB = pvB;
+
+        return ( pxA->ulLongest < pxB->ulLongest ) ? 1 : ( ( pxA->ulLongest > pxB->ulLongest ) ? -1 : 0 );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvHistograms( void )
+    {
+        static char cOutput[ configCOMMAND_INT_MAX_OUTPUT_SIZE ];
+        UBaseType_t ux, uxBucket;
+        BaseType_t xMore, xFoundSpins = pdFALSE;
+        uint32_t ulBucketSum;
+
+        configASSERT( xTaskCreate( prvSpinTask, "Spin", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        /* The histograms as the CLI command shows them. */
+        do
+        {
+            xMore = FreeRTOS_CLIProcessCommand( "critical-sections", cOutput, sizeof( cOutput ) );
+            printf( "%s", cOutput );
+        } while( xMore != pdFALSE );
+
+        uxHistograms = uxTaskGetCriticalSectionHistograms( xHistograms, configCRITICAL_SECTION_HISTOGRAM_SITES );
+
+        for( ux = 0; ux < uxHistograms; ux++ )
+        {
+            ulBucketSum = 0;
+
+            for( uxBucket = 0; uxBucket < configCRITICAL_SECTION_HISTOGRAM_BUCKETS; uxBucket++ )
+            {
+                ulBucketSum += xHistograms[ ux ].ulBuckets[ uxBucket ];
+            }
+
+            if( ulBucketSum != xHistograms[ ux ].ulCount )
+            {
+                printf( "FAILED: histogram %p counts %lu sections but its buckets hold %lu\r\n",
+                        xHistograms[ ux ].pvCallSite, ( unsigned long ) xHistograms[ ux ].ulCount, ( unsigned long ) ulBucketSum );
+                exit( EXIT_FAILURE );
+            }
+
+            if( ( xHistograms[ ux ].xSchedulerSuspended == pdFALSE ) &&
+                ( xHistograms[ ux ].ulCount == benchSPINS ) &&
+                ( xHistograms[ ux ].ulLongest >= ( uint32_t ) benchLONGEST_SPIN_NS ) )
+            {
+                xFoundSpins = pdTRUE;
+            }
+        }
+
+        if( xFoundSpins == pdFALSE )
+        {
+            printf( "FAILED: the spinning task's critical sections were not recorded\r\n" );
+            exit( EXIT_FAILURE );
+        }
+
+        qsort( xHistograms, uxHistograms, sizeof( xHistograms[ 0 ] ), prvCompareLongest );
+    }
+
+#endif /* configUSE_CRITICAL_SECTION_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    unsigned long long ullStart;
+    unsigned long ulOperation;
+
+    ( void ) pvParameters;
+
+    /* Critical sections entered and exited from a task. */
+    ullStart = prvNanoseconds();
+
+    for( ulOperation = 0; ulOperation < ulOperations; ulOperation++ )
+    {
+        taskENTER_CRITICAL();
+        taskEXIT_CRITICAL();
+    }
+
+    prvReport( "critical", prvNanoseconds() - ullStart );
+
+    /* Scheduler suspensions. */
+    ullStart = prvNanoseconds();
+
+    for( ulOperation = 0; ulOperation < ulOperations; ulOperation++ )
+    {
+        vTaskSuspendAll();
+        ( void ) xTaskResumeAll();
+    }
+
+    prvReport( "suspend", prvNanoseconds() - ullStart );
+
+    /* Sends that each wake a higher priority receiver. */
+    xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    configASSERT( xQueue != NULL );
+    configASSERT( xTaskCreate( prvReceiveTask, "Recv", configMINIMAL_STACK_SIZE, NULL, 2, NULL ) == pdPASS );
+    ullStart = prvNanoseconds();
+    configASSERT( xTaskCreate( prvSendTask, "Send", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    prvReport( "queue", prvNanoseconds() - ullStart );
+
+    #if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+    {
+        prvHistograms();
+    }
+    #endif
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    ulOperations = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 200000UL;
+    configASSERT( ulOperations > 1 );
+
+    #if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+    {
+        extern void vRegisterSampleCLICommands( void );
+
+        vRegisterSampleCLICommands();
+    }
+    #endif
+
+    configASSERT( xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControlTask ) == pdPASS );
+
+    /* Returns once the control task ends the scheduler. */
+    vTaskStartScheduler();
+
+    #if ( configUSE_CRITICAL_SECTION_HISTOGRAMS == 1 )
+    {
+        UBaseType_t ux;
+
+        /* Resolved now the tick no longer interrupts reading from addr2line. */
+        for( ux = 0; ( ux < uxHistograms ) && ( ux < benchSITES_TO_RESOLVE ); ux++ )
+        {
+            prvResolve( &( xHistograms[ ux ] ) );
+        }
+    }
+    #endif
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
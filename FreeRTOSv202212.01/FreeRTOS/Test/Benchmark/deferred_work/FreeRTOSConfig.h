@@ -0,0 +1,78 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+* Configuration for the deferred work benchmark, which runs the real Posix port
+* and uses the tick hook as the interrupt that hands work to tasks.
+* configUSE_TIMERS and configUSE_DEFERRED_WORK are set on the command line.
+*----------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define configUSE_PREEMPTION                       1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#define configUSE_IDLE_HOOK                        0
+#define configUSE_TICK_HOOK                        1
+#define configTICK_RATE_HZ                         ( 1000 )
+#define configMINIMAL_STACK_SIZE                   ( ( unsigned short ) 4096 )
+#define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( 4 * 1024 * 1024 ) )
+#define configMAX_TASK_NAME_LEN                    ( 8 )
+#define configUSE_TRACE_FACILITY                   0
+#define configUSE_16_BIT_TICKS                     0
+#define configIDLE_SHOULD_YIELD                    1
+#define configUSE_MUTEXES                          1
+#define configCHECK_FOR_STACK_OVERFLOW             0
+#define configUSE_MALLOC_FAILED_HOOK               0
+#define configSUPPORT_DYNAMIC_ALLOCATION           1
+#define configSUPPORT_STATIC_ALLOCATION            0
+#define configMAX_PRIORITIES                       ( 6 )
+
+/* The timer service task, used by xTimerPendFunctionCallFromISR(), and the
+ * deferred work lane run at the same priority as the handler tasks. */
+#define configTIMER_TASK_PRIORITY                  ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                   ( 16 )
+#define configTIMER_TASK_STACK_DEPTH               configMINIMAL_STACK_SIZE
+#define configDEFERRED_WORK_LANES                  1
+#define configDEFERRED_WORK_LANE_PRIORITIES        { configMAX_PRIORITIES - 1 }
+
+#define INCLUDE_vTaskDelay                         1
+#define INCLUDE_vTaskDelete                        0
+#define INCLUDE_vTaskSuspend                       1
+#define INCLUDE_xTimerPendFunctionCall             configUSE_TIMERS
+
+#define configASSERT( x )                                                       \
+    if( ( x ) == 0 )                                                            \
+    {                                                                           \
+        printf( "ASSERT FAILED: %s:%d %s\r\n", __FILE__, __LINE__, #x );        \
+        abort();                                                                \
+    }
+
+#endif /* FREERTOS_CONFIG_H */
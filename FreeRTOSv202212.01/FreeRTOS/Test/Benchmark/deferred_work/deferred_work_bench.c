@@ -0,0 +1,250 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Compares ways of handing work from interrupts to tasks.
+ *
+ * Usage: deferred_work_bench_<method> <ticks>
+ *
+ * For <ticks> ticks the tick hook, standing in for an interrupt, hands work
+ * from each of benchSOURCES sources to that source's handler:
+ *
+ * task:  Each source has a handler task blocked on a binary semaphore, which
+ *        the interrupt gives.
+ * pend:  The interrupt pends the handler to the timer service task with
+ *        xTimerPendFunctionCallFromISR().
+ * lanes: Each source has a deferred work item on a single lane, which the
+ *        interrupt submits with xDeferredWorkSubmitFromISR().
+ *
+ * Every handler runs at the same priority.  Reports the time from each
+ * submission to the start of its handler, how many submissions did not queue
+ * a handler run of their own, the number of tasks, and the heap
+ * used by all the tasks (including the idle and control tasks, which every
+ * method has) and kernel objects.  Stacks are configMINIMAL_STACK_SIZE words,
+ * so the heap figures scale with the stack size of a real target.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "timers.h"
+#include "deferred_work.h"
+
+#if ( configUSE_DEFERRED_WORK == 1 )
+    #define benchMETHOD_NAME    "lanes"
+#elif ( configUSE_TIMERS == 1 )
+    #define benchMETHOD_NAME    "pend"
+#else
+    #define benchMETHOD_NAME    "task"
+#endif
+
+/* The number of interrupt sources. */
+#define benchSOURCES             ( 8UL )
+
+/* Task priorities. */
+#define benchHANDLER_PRIORITY    ( configMAX_PRIORITIES - 1 )
+#define benchCONTROL_PRIORITY    ( configMAX_PRIORITIES - 2 )
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulTicks;
+
+/* Set while the tick hook hands work to the handlers. */
+static volatile BaseType_t xSampling = pdFALSE;
+
+/* The time each source last handed off work. */
+static volatile uint64_t ullSubmitNs[ benchSOURCES ];
+
+/* Latencies of the handled submissions. */
+static uint64_t ullTotalNs, ullMaxNs;
+static unsigned long ulSubmitted, ulHandled;
+
+/* Submissions that did not queue a handler run of their own, because one was
+ * already pending for the source, or the timer command queue was full. */
+static unsigned long ulNotQueued;
+
+#if ( configUSE_DEFERRED_WORK == 1 )
+    static DeferredWorkHandle_t xWork[ benchSOURCES ];
+#elif ( configUSE_TIMERS == 0 )
+    static SemaphoreHandle_t xHandlerSemaphores[ benchSOURCES ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHandle( uint32_t ulSource )
+{
+    const uint64_t ullLatencyNs = prvNanoseconds() - ullSubmitNs[ ulSource ];
+
+    taskENTER_CRITICAL();
+    {
+        ullTotalNs += ullLatencyNs;
+
+        if( ullLatencyNs > ullMaxNs )
+        {
+            ullMaxNs = ullLatencyNs;
+        }
+
+        ulHandled++;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEFERRED_WORK == 1 )
+
+    static void prvWorkFunction( void * pvParameter,
+                                 uint32_t ulEvents )
+    {
+        ( void ) ulEvents;
+
+        prvHandle( ( uint32_t ) ( uintptr_t ) pvParameter );
+    }
+
+#elif ( configUSE_TIMERS == 1 )
+
+    static void prvPendedFunction( void * pvParameter1,
+                                   uint32_t ulParameter2 )
+    {
+        ( void ) pvParameter1;
+
+        prvHandle( ulParameter2 );
+    }
+
+#else
+
+    static void prvHandlerTask( void * pvParameters )
+    {
+        const uint32_t ulSource = ( uint32_t ) ( uintptr_t ) pvParameters;
+
+        for( ; ; )
+        {
+            ( void ) xSemaphoreTake( xHandlerSemaphores[ ulSource ], portMAX_DELAY );
+            prvHandle( ulSource );
+        }
+    }
+
+#endif /* if ( configUSE_DEFERRED_WORK == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+    uint32_t ulSource;
+    BaseType_t xQueued;
+
+    if( xSampling != pdFALSE )
+    {
+        for( ulSource = 0; ulSource < benchSOURCES; ulSource++ )
+        {
+            ullSubmitNs[ ulSource ] = prvNanoseconds();
+
+            /* The tick performs any context switch needed. */
+            #if ( configUSE_DEFERRED_WORK == 1 )
+                xQueued = xDeferredWorkSubmitFromISR( xWork[ ulSource ], 1UL, NULL );
+            #elif ( configUSE_TIMERS == 1 )
+                xQueued = xTimerPendFunctionCallFromISR( prvPendedFunction, NULL, ulSource, NULL );
+            #else
+                xQueued = xSemaphoreGiveFromISR( xHandlerSemaphores[ ulSource ], NULL );
+            #endif
+
+            if( xQueued == pdFALSE )
+            {
+                ulNotQueued++;
+            }
+
+            ulSubmitted++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    uint32_t ulSource;
+
+    ( void ) pvParameters;
+
+    for( ulSource = 0; ulSource < benchSOURCES; ulSource++ )
+    {
+        #if ( configUSE_DEFERRED_WORK == 1 )
+            xWork[ ulSource ] = xDeferredWorkCreate( prvWorkFunction, ( void * ) ( uintptr_t ) ulSource, 0 );
+            configASSERT( xWork[ ulSource ] != NULL );
+        #elif ( configUSE_TIMERS == 0 )
+            xHandlerSemaphores[ ulSource ] = xSemaphoreCreateBinary();
+            configASSERT( xHandlerSemaphores[ ulSource ] != NULL );
+            configASSERT( xTaskCreate( prvHandlerTask, "Handler", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) ulSource, benchHANDLER_PRIORITY, NULL ) == pdPASS );
+        #endif
+    }
+
+    xSampling = pdTRUE;
+    vTaskDelay( ( TickType_t ) ulTicks );
+    xSampling = pdFALSE;
+
+    /* Let the last handlers run. */
+    vTaskDelay( 10 );
+
+    printf( "%-5s %2lu sources  %2lu tasks  heap %7.1f KB  latency avg %7.2f us  max %8.2f us  handled %lu/%lu  not queued %lu\r\n",
+            benchMETHOD_NAME, benchSOURCES, ( unsigned long ) uxTaskGetNumberOfTasks(),
+            ( double ) ( configTOTAL_HEAP_SIZE - xPortGetFreeHeapSize() ) / 1024.0,
+            ( ulHandled > 0UL ) ? ( double ) ullTotalNs / ( double ) ulHandled / 1000.0 : 0.0,
+            ( double ) ullMaxNs / 1000.0,
+            ulHandled, ulSubmitted, ulNotQueued );
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    ulTicks = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 2000UL;
+    configASSERT( ulTicks > 0 );
+
+    configASSERT( xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL ) == pdPASS );
+
+    /* Returns once the control task ends the scheduler. */
+    vTaskStartScheduler();
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
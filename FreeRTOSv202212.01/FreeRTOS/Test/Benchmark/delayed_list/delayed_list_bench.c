@@ -0,0 +1,230 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of blocking a task with a timeout, and of the tick
+ * interrupt unblocking it again, with a given number of tasks in the Blocked
+ * state.  The same source is built once with the sorted delayed lists and once
+ * with the delayed task wheel (configUSE_DELAYED_TASK_WHEEL).
+ *
+ * Usage: delayed_list_bench_<backend> <number of blocked tasks>
+ *
+ * No task executes.  Every task is blocked from main() using vTaskDelay() with
+ * a pseudo random delay, then the tick interrupt is simulated by calling
+ * xTaskIncrementTick().  Each task that the tick unblocks is checked to have
+ * been unblocked on exactly the tick it asked for, then blocked again.  Most
+ * delays are short, as per protocol retransmission timeouts, but some are long
+ * enough to be beyond the span of the wheel.  The run crosses a tick count
+ * overflow (see configINITIAL_TICK_COUNT).
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchMAX_TASKS           ( 1000 )
+#define benchTICKS_TO_RUN        ( 70000UL )
+#define benchMAX_SHORT_DELAY     ( 5000UL )
+#define benchMAX_LONG_DELAY      ( 100000UL )
+#define benchLONG_DELAY_RATIO    ( 16UL ) /* One delay in this many is long. */
+
+#ifndef configUSE_DELAYED_TASK_WHEEL
+    #error configUSE_DELAYED_TASK_WHEEL must be set on the command line
+#endif
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+    #define benchBACKEND_NAME    "wheel"
+#else
+    #define benchBACKEND_NAME    "list"
+#endif
+
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xTasks[ benchMAX_TASKS ];
+static TickType_t xExpectedWakeTime[ benchMAX_TASKS ];
+static uint32_t ulRandomState = 0x1234567UL;
+
+static uint64_t ullBlockTime = 0, ullBlocks = 0;
+static uint64_t ullTickTime = 0, ullWorstTickTime = 0, ullWakes = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    /* Never executes. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvNextDelay( void )
+{
+    uint32_t ulRandom;
+
+    /* Fixed seed linear congruential generator so every backend sees exactly
+     * the same sequence of delays. */
+    ulRandomState = ( ulRandomState * 1103515245UL ) + 12345UL;
+    ulRandom = ulRandomState >> 8;
+
+    if( ( ulRandom % benchLONG_DELAY_RATIO ) == 0UL )
+    {
+        return ( TickType_t ) ( 1UL + ( ( ulRandom >> 4 ) % benchMAX_LONG_DELAY ) );
+    }
+
+    return ( TickType_t ) ( 1UL + ( ( ulRandom >> 4 ) % benchMAX_SHORT_DELAY ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlockRunningTask( void )
+{
+    UBaseType_t uxIndex = ( UBaseType_t ) ( uintptr_t ) pvTaskGetThreadLocalStoragePointer( NULL, 0 );
+    TickType_t xDelay = prvNextDelay();
+    uint64_t ullStart;
+
+    xExpectedWakeTime[ uxIndex ] = xTaskGetTickCount() + xDelay;
+
+    /* vTaskDelay() selects the next task to run before it returns. */
+    ullStart = prvNanoseconds();
+    vTaskDelay( xDelay );
+    ullBlockTime += prvNanoseconds() - ullStart;
+    ullBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckAllTasksBlocked( UBaseType_t uxNumberOfTasks )
+{
+    UBaseType_t x;
+    static TaskStatus_t xStatus[ benchMAX_TASKS + 1 ];
+    UBaseType_t uxReported, uxBlocked = 0;
+
+    for( x = 0; x < uxNumberOfTasks; x++ )
+    {
+        configASSERT( eTaskGetState( xTasks[ x ] ) == eBlocked );
+    }
+
+    uxReported = uxTaskGetSystemState( xStatus, benchMAX_TASKS + 1, NULL );
+
+    for( x = 0; x < uxReported; x++ )
+    {
+        if( xStatus[ x ].eCurrentState == eBlocked )
+        {
+            uxBlocked++;
+        }
+    }
+
+    configASSERT( uxBlocked == uxNumberOfTasks );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    UBaseType_t x, uxNumberOfTasks;
+    unsigned long ulTick;
+    uint64_t ullStart, ullElapsed;
+    TaskHandle_t xIdleTask;
+
+    uxNumberOfTasks = ( argc > 1 ) ? ( UBaseType_t ) strtoul( argv[ 1 ], NULL, 10 ) : 100;
+    configASSERT( ( uxNumberOfTasks > 0 ) && ( uxNumberOfTasks <= benchMAX_TASKS ) );
+
+    for( x = 0; x < uxNumberOfTasks; x++ )
+    {
+        configASSERT( xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &( xTasks[ x ] ) ) == pdPASS );
+        vTaskSetThreadLocalStoragePointer( xTasks[ x ], 0, ( void * ) ( uintptr_t ) x );
+    }
+
+    /* Returns with the first benchmark task selected as the running task. */
+    vTaskStartScheduler();
+    xIdleTask = xTaskGetIdleTaskHandle();
+
+    while( xTaskGetCurrentTaskHandle() != xIdleTask )
+    {
+        prvBlockRunningTask();
+    }
+
+    prvCheckAllTasksBlocked( uxNumberOfTasks );
+
+    for( ulTick = 0; ulTick < benchTICKS_TO_RUN; ulTick++ )
+    {
+        ullStart = prvNanoseconds();
+
+        if( xTaskIncrementTick() != pdFALSE )
+        {
+            vTaskSwitchContext();
+        }
+
+        ullElapsed = prvNanoseconds() - ullStart;
+        ullTickTime += ullElapsed;
+
+        if( ullElapsed > ullWorstTickTime )
+        {
+            ullWorstTickTime = ullElapsed;
+        }
+
+        while( xTaskGetCurrentTaskHandle() != xIdleTask )
+        {
+            x = ( UBaseType_t ) ( uintptr_t ) pvTaskGetThreadLocalStoragePointer( NULL, 0 );
+
+            if( xExpectedWakeTime[ x ] != xTaskGetTickCount() )
+            {
+                printf( "FAIL: %s task %lu woke at %lu, expected %lu\r\n", benchBACKEND_NAME,
+                        ( unsigned long ) x, ( unsigned long ) xTaskGetTickCount(), ( unsigned long ) xExpectedWakeTime[ x ] );
+                return EXIT_FAILURE;
+            }
+
+            ullWakes++;
+            prvBlockRunningTask();
+        }
+    }
+
+    prvCheckAllTasksBlocked( uxNumberOfTasks );
+
+    printf( "%-6s tasks %5lu  wakes %7llu  block %7.1f ns  tick %7.1f ns  worst tick %8llu ns\r\n",
+            benchBACKEND_NAME,
+            ( unsigned long ) uxNumberOfTasks,
+            ( unsigned long long ) ullWakes,
+            ( double ) ullBlockTime / ( double ) ullBlocks,
+            ( double ) ullTickTime / ( double ) benchTICKS_TO_RUN,
+            ( unsigned long long ) ullWorstTickTime );
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,282 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Measures the cost of xEventGroupSetBits() when many tasks are blocked on an
+ * event group but none of them are waiting for the bit being set, with the
+ * single waiting list and with configEVENT_GROUP_INDEXED_BITS.
+ *
+ * Usage: event_groups_bench_<method> <sets>
+ *
+ * Each test blocks a number of tasks on bits 1 and up of a new event group.  A
+ * third wait for one bit, a third wait for all of two neighbouring bits and a
+ * third wait for either of two neighbouring bits.  The control task then sets
+ * and clears bit 0, which no task waits for.
+ *
+ * The even bits and then the odd bits are then set, checking exactly the tasks
+ * that should unblock do so at each step.  The test is repeated with the event
+ * group being deleted after the even bits are set, which must unblock every
+ * task that is still waiting.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+#if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+    #define benchMETHOD_NAME    "index64"
+    #define benchUSABLE_BITS    56U
+#elif ( configEVENT_GROUP_INDEXED_BITS > 0 )
+    #define benchMETHOD_NAME    "index"
+    #define benchUSABLE_BITS    24U
+#else
+    #define benchMETHOD_NAME    "list"
+    #define benchUSABLE_BITS    24U
+#endif
+
+#define benchMAX_WAITERS        256U
+#define benchBIT( x )           ( ( ( EventBits_t ) 1 ) << ( x ) )
+#define benchEVEN_BITS          ( ( EventBits_t ) 0x5555555555555555ULL & ( benchBIT( benchUSABLE_BITS ) - 1U ) & ~benchBIT( 0 ) )
+#define benchODD_BITS           ( ( EventBits_t ) 0xaaaaaaaaaaaaaaaaULL & ( benchBIT( benchUSABLE_BITS ) - 1U ) )
+
+/* Long enough for every waiting task to run at the lower priority. */
+#define benchSETTLE_TICKS       pdMS_TO_TICKS( 50 )
+
+/*-----------------------------------------------------------*/
+
+typedef struct WaiterParameters
+{
+    EventBits_t uxBits;
+    BaseType_t xWaitForAll;
+} WaiterParameters_t;
+
+static unsigned long ulSets;
+static EventGroupHandle_t xEventGroup;
+static WaiterParameters_t xWaiterParameters[ benchMAX_WAITERS ];
+static volatile unsigned long ulUnblocked;
+static volatile unsigned long ulUnblockedByDelete;
+static volatile unsigned long ulWrongBits;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void * pvParameters )
+{
+    const WaiterParameters_t * pxParameters = ( const WaiterParameters_t * ) pvParameters;
+    EventBits_t uxBits;
+
+    uxBits = xEventGroupWaitBits( xEventGroup, pxParameters->uxBits, pdFALSE, pxParameters->xWaitForAll, portMAX_DELAY );
+
+    if( uxBits == 0 )
+    {
+        /* The event group was deleted. */
+        ulUnblockedByDelete++;
+    }
+    else
+    {
+        if( pxParameters->xWaitForAll != pdFALSE )
+        {
+            if( ( uxBits & pxParameters->uxBits ) != pxParameters->uxBits )
+            {
+                ulWrongBits++;
+            }
+        }
+        else if( ( uxBits & pxParameters->uxBits ) == 0 )
+        {
+            ulWrongBits++;
+        }
+
+        ulUnblocked++;
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCreateWaiters( uint32_t ulWaiters )
+{
+    uint32_t ulWaiter, ulBit;
+    unsigned long ulUnblockedByEvenBits = 0;
+
+    for( ulWaiter = 0; ulWaiter < ulWaiters; ulWaiter++ )
+    {
+        ulBit = 1U + ( ( ulWaiter / 3U ) % ( benchUSABLE_BITS - 2U ) );
+
+        switch( ulWaiter % 3U )
+        {
+            case 0:
+                xWaiterParameters[ ulWaiter ].uxBits = benchBIT( ulBit );
+                xWaiterParameters[ ulWaiter ].xWaitForAll = pdFALSE;
+                ulUnblockedByEvenBits += ( ( ulBit & 1U ) == 0U ) ? 1UL : 0UL;
+                break;
+
+            case 1:
+                xWaiterParameters[ ulWaiter ].uxBits = benchBIT( ulBit ) | benchBIT( ulBit + 1U );
+                xWaiterParameters[ ulWaiter ].xWaitForAll = pdTRUE;
+                break;
+
+            default:
+                xWaiterParameters[ ulWaiter ].uxBits = benchBIT( ulBit ) | benchBIT( ulBit + 1U );
+                xWaiterParameters[ ulWaiter ].xWaitForAll = pdFALSE;
+                ulUnblockedByEvenBits++;
+                break;
+        }
+
+        configASSERT( xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, &( xWaiterParameters[ ulWaiter ] ), tskIDLE_PRIORITY + 1, NULL ) == pdPASS );
+    }
+
+    /* Let every waiting task block on the event group. */
+    vTaskDelay( benchSETTLE_TICKS );
+
+    return ulUnblockedByEvenBits;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFail( const char * pcWhat,
+                     uint32_t ulWaiters,
+                     unsigned long ulExpected,
+                     unsigned long ulActual )
+{
+    printf( "%-7s FAILED: %lu waiters, %s unblocked %lu tasks, expected %lu (%lu with wrong bits)\r\n",
+            benchMETHOD_NAME, ( unsigned long ) ulWaiters, pcWhat, ulActual, ulExpected, ulWrongBits );
+    exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTest( uint32_t ulWaiters )
+{
+    unsigned long ulSet, ulExpected;
+    uint64_t ullStartNs, ullNs;
+
+    /* Measure setting a bit nobody waits for. */
+    xEventGroup = xEventGroupCreate();
+    configASSERT( xEventGroup != NULL );
+    ulUnblocked = 0;
+    ulExpected = prvCreateWaiters( ulWaiters );
+
+    ullStartNs = prvNanoseconds();
+
+    for( ulSet = 0; ulSet < ulSets; ulSet++ )
+    {
+        ( void ) xEventGroupSetBits( xEventGroup, benchBIT( 0 ) );
+        ( void ) xEventGroupClearBits( xEventGroup, benchBIT( 0 ) );
+    }
+
+    ullNs = prvNanoseconds() - ullStartNs;
+
+    printf( "%-7s %4lu waiters  %8lu sets  %8.1f ns/set\r\n",
+            benchMETHOD_NAME, ( unsigned long ) ulWaiters, ulSets, ( double ) ullNs / ( double ) ulSets );
+
+    if( ulUnblocked != 0 )
+    {
+        prvFail( "bit 0", ulWaiters, 0, ulUnblocked );
+    }
+
+    /* Only the tasks waiting for an even bit unblock, then the rest. */
+    ( void ) xEventGroupSetBits( xEventGroup, benchEVEN_BITS );
+    vTaskDelay( benchSETTLE_TICKS );
+
+    if( ( ulUnblocked != ulExpected ) || ( ulWrongBits != 0 ) )
+    {
+        prvFail( "even bits", ulWaiters, ulExpected, ulUnblocked );
+    }
+
+    ( void ) xEventGroupSetBits( xEventGroup, benchODD_BITS );
+    vTaskDelay( benchSETTLE_TICKS );
+
+    if( ( ulUnblocked != ulWaiters ) || ( ulWrongBits != 0 ) )
+    {
+        prvFail( "odd bits", ulWaiters, ulWaiters, ulUnblocked );
+    }
+
+    vEventGroupDelete( xEventGroup );
+
+    /* Deleting the event group unblocks the tasks still waiting. */
+    xEventGroup = xEventGroupCreate();
+    configASSERT( xEventGroup != NULL );
+    ulUnblocked = 0;
+    ulUnblockedByDelete = 0;
+    ulExpected = prvCreateWaiters( ulWaiters );
+
+    ( void ) xEventGroupSetBits( xEventGroup, benchEVEN_BITS );
+    vTaskDelay( benchSETTLE_TICKS );
+
+    vEventGroupDelete( xEventGroup );
+    vTaskDelay( benchSETTLE_TICKS );
+
+    if( ( ulUnblocked != ulExpected ) || ( ulUnblockedByDelete != ( ulWaiters - ulExpected ) ) )
+    {
+        prvFail( "delete", ulWaiters, ulWaiters - ulExpected, ulUnblockedByDelete );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    static const uint32_t ulWaiterCounts[] = { 8, 64, benchMAX_WAITERS };
+    uint32_t ulTest;
+
+    ( void ) pvParameters;
+
+    for( ulTest = 0; ulTest < ( sizeof( ulWaiterCounts ) / sizeof( ulWaiterCounts[ 0 ] ) ); ulTest++ )
+    {
+        prvTest( ulWaiterCounts[ ulTest ] );
+    }
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    ulSets = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 100000UL;
+
+    configASSERT( xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL ) == pdPASS );
+
+    /* Returns once the control task ends the scheduler. */
+    vTaskStartScheduler();
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
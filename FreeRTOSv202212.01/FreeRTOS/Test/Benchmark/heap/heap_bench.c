@@ -0,0 +1,266 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of pvPortMalloc() and vPortFree() as the heap fragments.
+ * The same source is built once for each memory manager that supports
+ * multiple heap regions - heap_5.c, which searches a single address ordered
+ * free list, and heap_6.c, which indexes its free blocks by size.
+ *
+ * Usage: heap_bench_<heap> <number of live blocks>
+ *
+ * The heap is defined as two regions.  The requested number of blocks of
+ * pseudo random size are allocated, then a pseudo random block is repeatedly
+ * freed and replaced by a new block of pseudo random size, so free blocks of
+ * many sizes are left scattered through the heap.  Every block is filled when
+ * it is allocated and checked when it is freed.  Once all the blocks have been
+ * freed again the heap must have coalesced back to one free block per region.
+ *
+ * The mean and the worst case time of each call are reported.  Allocations
+ * that fail because the heap is too fragmented are counted rather than
+ * treated as an error.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchITERATIONS         ( 200000UL )
+#define benchMAX_LIVE_BLOCKS    ( 4096UL )
+#define benchREGION_0_SIZE      ( 3UL * 1024UL * 1024UL )
+#define benchREGION_1_SIZE      ( 1UL * 1024UL * 1024UL )
+
+#ifndef benchHEAP_NAME
+    #error benchHEAP_NAME must be set on the command line
+#endif
+
+/*-----------------------------------------------------------*/
+
+typedef struct BENCH_BLOCK
+{
+    uint8_t * pucData;
+    size_t xSize;
+} BenchBlock_t;
+
+static uint8_t ucRegion0[ benchREGION_0_SIZE ];
+static uint8_t ucRegion1[ benchREGION_1_SIZE ];
+static BenchBlock_t xBlocks[ benchMAX_LIVE_BLOCKS ];
+static uint32_t ulRandomState = 0x1234567UL;
+static uint64_t ullMallocTime = 0, ullMallocWorst = 0, ullFreeTime = 0, ullFreeWorst = 0;
+static unsigned long ulMallocs = 0, ulFrees = 0, ulFailures = 0;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    /* Fixed seed linear congruential generator so both heaps see exactly the
+     * same sequence of operations. */
+    ulRandomState = ( ulRandomState * 1103515245UL ) + 12345UL;
+
+    return ulRandomState >> 8;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvRandomSize( void )
+{
+    /* Mostly small blocks with a long tail of larger ones - between 8 bytes
+     * and 2K bytes, spread evenly over each power of two. */
+    uint32_t ulShift = prvRandom() % 9U;
+
+    return ( size_t ) ( 8U << ulShift ) + ( size_t ) ( prvRandom() % ( 8U << ulShift ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAllocate( BenchBlock_t * pxBlock,
+                         uint8_t ucFill )
+{
+    uint64_t ullStart, ullTime;
+
+    pxBlock->xSize = prvRandomSize();
+
+    ullStart = prvNanoseconds();
+    pxBlock->pucData = pvPortMalloc( pxBlock->xSize );
+    ullTime = prvNanoseconds() - ullStart;
+
+    ullMallocTime += ullTime;
+    ulMallocs++;
+
+    if( ullTime > ullMallocWorst )
+    {
+        ullMallocWorst = ullTime;
+    }
+
+    if( pxBlock->pucData != NULL )
+    {
+        memset( pxBlock->pucData, ucFill, pxBlock->xSize );
+    }
+    else
+    {
+        ulFailures++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFree( BenchBlock_t * pxBlock,
+                           uint8_t ucFill )
+{
+    uint64_t ullStart, ullTime;
+    size_t x;
+
+    if( pxBlock->pucData == NULL )
+    {
+        return pdPASS;
+    }
+
+    for( x = 0; x < pxBlock->xSize; x++ )
+    {
+        if( pxBlock->pucData[ x ] != ucFill )
+        {
+            printf( "FAIL: %s block of %lu bytes corrupted at offset %lu\r\n", benchHEAP_NAME,
+                    ( unsigned long ) pxBlock->xSize, ( unsigned long ) x );
+            return pdFAIL;
+        }
+    }
+
+    ullStart = prvNanoseconds();
+    vPortFree( pxBlock->pucData );
+    ullTime = prvNanoseconds() - ullStart;
+
+    ullFreeTime += ullTime;
+    ulFrees++;
+
+    if( ullTime > ullFreeWorst )
+    {
+        ullFreeWorst = ullTime;
+    }
+
+    pxBlock->pucData = NULL;
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    HeapRegion_t xHeapRegions[ 3 ];
+    HeapStats_t xStats;
+    unsigned long ulIteration, x, ulLiveBlocks;
+    size_t xInitialFreeBytes;
+
+    ulLiveBlocks = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 512;
+    configASSERT( ( ulLiveBlocks > 0 ) && ( ulLiveBlocks <= benchMAX_LIVE_BLOCKS ) );
+
+    /* heap_5.c requires the regions in address order.  The first region
+     * starts on an odd address to exercise the alignment of regions. */
+    if( ( uintptr_t ) ucRegion0 < ( uintptr_t ) ucRegion1 )
+    {
+        xHeapRegions[ 0 ] = ( HeapRegion_t ) { ucRegion0 + 1, benchREGION_0_SIZE - 1 };
+        xHeapRegions[ 1 ] = ( HeapRegion_t ) { ucRegion1, benchREGION_1_SIZE };
+    }
+    else
+    {
+        xHeapRegions[ 0 ] = ( HeapRegion_t ) { ucRegion1, benchREGION_1_SIZE };
+        xHeapRegions[ 1 ] = ( HeapRegion_t ) { ucRegion0 + 1, benchREGION_0_SIZE - 1 };
+    }
+
+    xHeapRegions[ 2 ] = ( HeapRegion_t ) { NULL, 0 };
+    vPortDefineHeapRegions( xHeapRegions );
+    xInitialFreeBytes = xPortGetFreeHeapSize();
+
+    for( x = 0; x < ulLiveBlocks; x++ )
+    {
+        prvAllocate( &( xBlocks[ x ] ), ( uint8_t ) x );
+    }
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        x = prvRandom() % ulLiveBlocks;
+
+        if( prvFree( &( xBlocks[ x ] ), ( uint8_t ) x ) != pdPASS )
+        {
+            return EXIT_FAILURE;
+        }
+
+        prvAllocate( &( xBlocks[ x ] ), ( uint8_t ) x );
+    }
+
+    vPortGetHeapStats( &xStats );
+
+    printf( "%-6s live %4lu  malloc %6.1f ns (worst %6lu)  free %6.1f ns (worst %6lu)  free blocks %5lu  failed %lu\r\n",
+            benchHEAP_NAME,
+            ulLiveBlocks,
+            ( double ) ullMallocTime / ( double ) ulMallocs,
+            ( unsigned long ) ullMallocWorst,
+            ( double ) ullFreeTime / ( double ) ulFrees,
+            ( unsigned long ) ullFreeWorst,
+            ( unsigned long ) xStats.xNumberOfFreeBlocks,
+            ulFailures );
+
+    for( x = 0; x < ulLiveBlocks; x++ )
+    {
+        if( prvFree( &( xBlocks[ x ] ), ( uint8_t ) x ) != pdPASS )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Everything has been freed, so each region should be one free block
+     * again. */
+    vPortGetHeapStats( &xStats );
+
+    if( ( xPortGetFreeHeapSize() != xInitialFreeBytes ) ||
+        ( xStats.xAvailableHeapSpaceInBytes != xInitialFreeBytes ) ||
+        ( xStats.xNumberOfFreeBlocks != 2 ) ||
+        ( xStats.xNumberOfSuccessfulAllocations != ( ulMallocs - ulFailures ) ) ||
+        ( xStats.xNumberOfSuccessfulFrees != ulFrees ) )
+    {
+        printf( "FAIL: %s heap did not return to its initial state - %lu of %lu bytes free in %lu blocks\r\n", benchHEAP_NAME,
+                ( unsigned long ) xStats.xAvailableHeapSpaceInBytes, ( unsigned long ) xInitialFreeBytes,
+                ( unsigned long ) xStats.xNumberOfFreeBlocks );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
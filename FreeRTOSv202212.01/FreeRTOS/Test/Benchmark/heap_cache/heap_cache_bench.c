@@ -0,0 +1,208 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of small pvPortMalloc() and vPortFree() calls made by a
+ * task, with and without the heap_4 task caches (configUSE_HEAP_TASK_CACHE).
+ *
+ * Usage: heap_cache_bench_<method> <number of fragments>
+ *
+ * Before the scheduler starts, the requested number of small blocks are
+ * allocated and every other one is freed again, leaving a free list that a
+ * first fit search has to walk past.  A task is then created and selected as
+ * the running task, and on its behalf a pseudo random one of a set of live
+ * blocks is repeatedly freed and replaced by a new block of pseudo random
+ * size between 1 and 256 bytes.
+ *
+ * Afterwards the task is deleted, which must return the blocks held in its
+ * cache, and the idle task's cache is released, after which the free heap
+ * space must be back to what it was when the scheduler started.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchITERATIONS       ( 1000000UL )
+#define benchLIVE_BLOCKS      ( 32UL )
+#define benchMAX_FRAGMENTS    ( 2000UL )
+
+#if ( configUSE_HEAP_TASK_CACHE == 1 )
+    #define benchMETHOD_NAME    "cache"
+#else
+    #define benchMETHOD_NAME    "heap"
+#endif
+
+/*-----------------------------------------------------------*/
+
+static void * pvFragments[ benchMAX_FRAGMENTS ];
+static void * pvLiveBlocks[ benchLIVE_BLOCKS ];
+static uint32_t ulRandomState = 0x1234567UL;
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    /* Never executes. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    /* xorshift32. */
+    ulRandomState ^= ulRandomState << 13;
+    ulRandomState ^= ulRandomState >> 17;
+    ulRandomState ^= ulRandomState << 5;
+
+    return ulRandomState;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    TaskHandle_t xTask;
+    unsigned long ulIteration, x, ulFragments;
+    uint32_t ulBlock;
+    uint64_t ullStart, ullTime;
+    size_t xFreeBytes;
+
+    ulFragments = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 100;
+    configASSERT( ulFragments <= benchMAX_FRAGMENTS );
+
+    for( x = 0; x < ulFragments; x++ )
+    {
+        pvFragments[ x ] = pvPortMalloc( 16 );
+        configASSERT( pvFragments[ x ] != NULL );
+    }
+
+    for( x = 0; x < ulFragments; x += 2 )
+    {
+        vPortFree( pvFragments[ x ] );
+    }
+
+    /* Returns with the idle task selected as the running task. */
+    vTaskStartScheduler();
+    xFreeBytes = xPortGetFreeHeapSize();
+
+    /* Creating a task with a priority above the idle task selects it as the
+     * running task, so the following allocations are made on its behalf. */
+    configASSERT( xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTask ) == pdPASS );
+    configASSERT( xTaskGetCurrentTaskHandle() == xTask );
+
+    for( x = 0; x < benchLIVE_BLOCKS; x++ )
+    {
+        pvLiveBlocks[ x ] = pvPortMalloc( ( prvRandom() & 0xffUL ) + 1UL );
+        configASSERT( pvLiveBlocks[ x ] != NULL );
+    }
+
+    ullStart = prvNanoseconds();
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ulBlock = prvRandom() % benchLIVE_BLOCKS;
+        vPortFree( pvLiveBlocks[ ulBlock ] );
+        pvLiveBlocks[ ulBlock ] = pvPortMalloc( ( prvRandom() & 0xffUL ) + 1UL );
+        configASSERT( pvLiveBlocks[ ulBlock ] != NULL );
+    }
+
+    ullTime = prvNanoseconds() - ullStart;
+
+    for( x = 0; x < benchLIVE_BLOCKS; x++ )
+    {
+        vPortFree( pvLiveBlocks[ x ] );
+    }
+
+    printf( "%-5s fragments %4lu  free+malloc %6.1f ns", benchMETHOD_NAME, ulFragments, ( double ) ullTime / ( double ) benchITERATIONS );
+
+    #if ( configUSE_HEAP_TASK_CACHE == 1 )
+    {
+        HeapTaskCacheStats_t xStats;
+
+        vPortGetHeapTaskCacheStats( &xStats );
+        printf( "  hit rate %5.1f%%  cached blocks %u",
+                ( 100.0 * ( double ) xStats.xNumberOfCacheHits ) / ( double ) ( xStats.xNumberOfCacheHits + xStats.xNumberOfCacheMisses ),
+                ( unsigned ) xStats.xNumberOfCachedBlocks );
+    }
+    #endif
+
+    printf( "\r\n" );
+
+    /* Select the idle task again, so the task can be deleted without waiting
+     * for the idle task to clean up after it. */
+    vTaskPrioritySet( NULL, tskIDLE_PRIORITY );
+
+    while( xTaskGetCurrentTaskHandle() != xTaskGetIdleTaskHandle() )
+    {
+        taskYIELD();
+    }
+
+    vTaskDelete( xTask );
+
+    #if ( configUSE_HEAP_TASK_CACHE == 1 )
+    {
+        HeapTaskCacheStats_t xStats;
+
+        /* Only the idle task's cache, created when it allocated the task,
+         * remains.  It is never released by the kernel as the idle task is
+         * never deleted, so release it here. */
+        vPortGetHeapTaskCacheStats( &xStats );
+        configASSERT( xStats.xNumberOfTaskCaches == 1 );
+
+        vPortReleaseTaskCache( pvTaskGetThreadLocalStoragePointer( NULL, configHEAP_TASK_CACHE_TLS_INDEX ) );
+        vTaskSetThreadLocalStoragePointer( NULL, configHEAP_TASK_CACHE_TLS_INDEX, NULL );
+
+        vPortGetHeapTaskCacheStats( &xStats );
+        configASSERT( ( xStats.xNumberOfTaskCaches == 0 ) && ( xStats.xNumberOfCachedBlocks == 0 ) );
+    }
+    #endif
+
+    if( xPortGetFreeHeapSize() != xFreeBytes )
+    {
+        printf( "FAIL: %u bytes were not returned to the heap\r\n", ( unsigned ) ( xFreeBytes - xPortGetFreeHeapSize() ) );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,773 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Kernel microbenchmark suite.  Measures the time taken by the kernel's hot
+ * paths and writes the results as a single JSON document, so they can be
+ * compared between releases:
+ *
+ * {
+ *   "suite": "kernel",
+ *   "kernel": "V10.5.1",
+ *   "platform": "posix",
+ *   "unit": "ns",
+ *   "results": [
+ *     { "name": "context_switch.yield", "operations": 200000, "total": 123456789, "per_operation": 617.28 },
+ *     ...
+ *   ]
+ * }
+ *
+ * "total" is the time taken by all the operations, and "per_operation" the
+ * time taken by one, both in "unit".  An operation is:
+ *
+ * context_switch.yield           - one switch between two tasks of equal
+ *                                  priority that call taskYIELD().
+ * context_switch.yield_fpu       - as context_switch.yield, but both tasks
+ *                                  also do a floating point multiply between
+ *                                  yields, so ports that save the floating
+ *                                  point registers only for tasks that use
+ *                                  them have to save them.
+ * context_switch.notify          - one switch to or from a task that is
+ *                                  unblocked by xTaskNotifyGive().
+ * context_switch.semaphore       - one switch between two tasks of equal
+ *                                  priority passing binary semaphores.
+ * queue.send_receive.<size>      - xQueueSend() then xQueueReceive() of an
+ *                                  item of <size> bytes, without blocking.
+ * stream_buffer.throughput.<size> - one byte passed from a task sending
+ *                                  <size> byte chunks to a task receiving
+ *                                  them.
+ * timer.start                    - xTimerStart() and the timer service task
+ *                                  processing the command.
+ * timer.expire                   - one timer expiring and its callback being
+ *                                  called, when many expire on the same tick.
+ * heap.malloc_free.fragmented    - one pvPortMalloc() or vPortFree() of a
+ *                                  random size in a fragmented heap.
+ *
+ * Platforms that can raise an interrupt from a task also measure:
+ *
+ * interrupt.notify_running       - an interrupt that notifies the task that
+ *                                  raised it, and that task taking the
+ *                                  notification, without a context switch.
+ * interrupt.notify_task          - an interrupt that unblocks a higher
+ *                                  priority task, the switch to that task,
+ *                                  and the switch back once it blocks again.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "timers.h"
+
+#include "kernel_suite.h"
+
+#define suiteCONTROL_PRIORITY           ( configMAX_PRIORITIES - 1 )
+#define suiteLOW_PRIORITY               ( tskIDLE_PRIORITY + 1 )
+#define suiteHIGH_PRIORITY              ( tskIDLE_PRIORITY + 2 )
+
+#define suiteQUEUE_LENGTH               8U
+#define suiteMAX_ITEM_SIZE              256U
+#define suiteSTREAM_BUFFER_SIZE         1024U
+#define suiteSTREAM_BYTES_PER_ITERATION 16U
+#define suiteTIMERS                     16U
+#define suiteEXPIRE_ROUNDS              32U
+#define suiteHEAP_SLOTS                 256U
+#define suiteHEAP_MIN_BLOCK             16U
+#define suiteHEAP_MAX_BLOCK             1024U
+
+/*-----------------------------------------------------------*/
+
+static uint32_t ulIterations;
+static TaskHandle_t xControlTask;
+static BaseType_t xFirstResult = pdTRUE;
+static char cLine[ 256 ];
+static size_t xLineLength;
+static uint32_t ulRandom = 0x12345678UL;
+
+/* Written by the tasks being measured. */
+static volatile uint64_t ullStart;
+static volatile uint64_t ullEnd;
+static SemaphoreHandle_t xPing;
+static SemaphoreHandle_t xPong;
+static TaskHandle_t xFirstWorker;
+static StreamBufferHandle_t xStreamBuffer;
+static uint32_t ulChunkSize;
+static uint64_t ullStreamBytes;
+static TimerHandle_t xTimers[ suiteTIMERS ];
+static volatile uint32_t ulUnexpectedExpiries;
+static volatile uint32_t ulExpired;
+static volatile uint64_t ullFirstExpiry;
+static volatile uint64_t ullLastExpiry;
+static volatile TickType_t xFirstExpiryTick;
+static volatile BaseType_t xExpiredOnDifferentTicks;
+
+#if ( suiteHAS_SOFTWARE_INTERRUPT == 1 )
+    static TaskHandle_t volatile xInterruptTarget;
+#endif
+
+/*-----------------------------------------------------------*/
+
+static void prvAppend( const char * pcString )
+{
+    size_t xLength = strlen( pcString );
+
+    configASSERT( ( xLineLength + xLength ) < sizeof( cLine ) );
+    memcpy( &( cLine[ xLineLength ] ), pcString, xLength + 1U );
+    xLineLength += xLength;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAppendUnsigned( uint64_t ullValue,
+                               uint32_t ulMinimumDigits )
+{
+    /* Formatted here rather than with printf() as 64-bit conversions are not
+     * supported by every C library the suite is linked with. */
+    char cDigits[ 21 ];
+    size_t xDigit = sizeof( cDigits ) - 1U;
+
+    cDigits[ xDigit ] = '\0';
+
+    do
+    {
+        xDigit--;
+        cDigits[ xDigit ] = ( char ) ( '0' + ( ullValue % 10U ) );
+        ullValue /= 10U;
+
+        if( ulMinimumDigits > 0U )
+        {
+            ulMinimumDigits--;
+        }
+    } while( ( ullValue != 0U ) || ( ulMinimumDigits > 0U ) );
+
+    prvAppend( &( cDigits[ xDigit ] ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEmitResult( const char * pcName,
+                           uint32_t ulParameter,
+                           uint64_t ullOperations,
+                           uint64_t ullTotal )
+{
+    uint64_t ullHundredths;
+
+    configASSERT( ullOperations > 0U );
+    ullHundredths = ( ( ullTotal * 100U ) + ( ullOperations / 2U ) ) / ullOperations;
+
+    xLineLength = 0;
+    prvAppend( ( xFirstResult != pdFALSE ) ? "    { \"name\": \"" : ",\n    { \"name\": \"" );
+    prvAppend( pcName );
+
+    if( ulParameter != 0U )
+    {
+        prvAppend( "." );
+        prvAppendUnsigned( ulParameter, 1U );
+    }
+
+    prvAppend( "\", \"operations\": " );
+    prvAppendUnsigned( ullOperations, 1U );
+    prvAppend( ", \"total\": " );
+    prvAppendUnsigned( ullTotal, 1U );
+    prvAppend( ", \"per_operation\": " );
+    prvAppendUnsigned( ullHundredths / 100U, 1U );
+    prvAppend( "." );
+    prvAppendUnsigned( ullHundredths % 100U, 2U );
+    prvAppend( " }" );
+
+    vSuiteOutput( cLine );
+    xFirstResult = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    /* xorshift32, so every run sees the same sequence. */
+    ulRandom ^= ulRandom << 13;
+    ulRandom ^= ulRandom >> 17;
+    ulRandom ^= ulRandom << 5;
+
+    return ulRandom;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartWorkers( TaskFunction_t pxFirst,
+                             UBaseType_t uxFirstPriority,
+                             TaskFunction_t pxSecond,
+                             UBaseType_t uxSecondPriority )
+{
+    /* Both workers notify the control task when they finish, then delete
+     * themselves. */
+    ullStart = 0;
+    ullEnd = 0;
+    configASSERT( xTaskCreate( pxFirst, "First", configMINIMAL_STACK_SIZE, NULL, uxFirstPriority, &xFirstWorker ) == pdPASS );
+    configASSERT( xTaskCreate( pxSecond, "Second", configMINIMAL_STACK_SIZE, NULL, uxSecondPriority, NULL ) == pdPASS );
+
+    ( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+    ( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+
+    /* Let the idle task free the workers. */
+    vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFinishWorker( void )
+{
+    xTaskNotifyGive( xControlTask );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void * pvParameters )
+{
+    uint32_t ulIteration;
+
+    ( void ) pvParameters;
+
+    if( ullStart == 0U )
+    {
+        ullStart = ullSuiteTimestamp();
+    }
+
+    for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+    {
+        taskYIELD();
+    }
+
+    if( ullEnd == 0U )
+    {
+        ullEnd = ullSuiteTimestamp();
+    }
+
+    prvFinishWorker();
+}
+/*-----------------------------------------------------------*/
+
+static void prvFloatingPointYieldTask( void * pvParameters )
+{
+    uint32_t ulIteration;
+    volatile float fValue = 1.0F;
+
+    ( void ) pvParameters;
+
+    if( ullStart == 0U )
+    {
+        ullStart = ullSuiteTimestamp();
+    }
+
+    for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+    {
+        fValue = fValue * 1.0001F;
+        taskYIELD();
+    }
+
+    if( ullEnd == 0U )
+    {
+        ullEnd = ullSuiteTimestamp();
+    }
+
+    prvFinishWorker();
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyingTask( void * pvParameters )
+{
+    uint32_t ulIteration;
+
+    ( void ) pvParameters;
+
+    /* The notified task is the first worker.  It has the higher priority, so
+     * is already blocked. */
+    ullStart = ullSuiteTimestamp();
+
+    for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+    {
+        xTaskNotifyGive( xFirstWorker );
+    }
+
+    prvFinishWorker();
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifiedTask( void * pvParameters )
+{
+    uint32_t ulIteration;
+
+    ( void ) pvParameters;
+
+    for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+
+    ullEnd = ullSuiteTimestamp();
+    prvFinishWorker();
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingTask( void * pvParameters )
+{
+    uint32_t ulIteration;
+
+    ( void ) pvParameters;
+
+    ullStart = ullSuiteTimestamp();
+
+    for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+    {
+        configASSERT( xSemaphoreGive( xPing ) == pdPASS );
+        configASSERT( xSemaphoreTake( xPong, portMAX_DELAY ) == pdPASS );
+    }
+
+    ullEnd = ullSuiteTimestamp();
+    prvFinishWorker();
+}
+/*-----------------------------------------------------------*/
+
+static void prvPongTask( void * pvParameters )
+{
+    uint32_t ulIteration;
+
+    ( void ) pvParameters;
+
+    for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+    {
+        configASSERT( xSemaphoreTake( xPing, portMAX_DELAY ) == pdPASS );
+        configASSERT( xSemaphoreGive( xPong ) == pdPASS );
+    }
+
+    prvFinishWorker();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureContextSwitches( void )
+{
+    prvStartWorkers( prvYieldTask, suiteLOW_PRIORITY, prvYieldTask, suiteLOW_PRIORITY );
+    prvEmitResult( "context_switch.yield", 0, 2ULL * ulIterations, ullEnd - ullStart );
+
+    prvStartWorkers( prvFloatingPointYieldTask, suiteLOW_PRIORITY, prvFloatingPointYieldTask, suiteLOW_PRIORITY );
+    prvEmitResult( "context_switch.yield_fpu", 0, 2ULL * ulIterations, ullEnd - ullStart );
+
+    /* Every notification switches to the receiver and back, apart from the
+     * last, after which the receiver takes the end time. */
+    prvStartWorkers( prvNotifiedTask, suiteHIGH_PRIORITY, prvNotifyingTask, suiteLOW_PRIORITY );
+    prvEmitResult( "context_switch.notify", 0, ( 2ULL * ulIterations ) - 1U, ullEnd - ullStart );
+
+    xPing = xSemaphoreCreateBinary();
+    xPong = xSemaphoreCreateBinary();
+    configASSERT( ( xPing != NULL ) && ( xPong != NULL ) );
+    prvStartWorkers( prvPingTask, suiteLOW_PRIORITY, prvPongTask, suiteLOW_PRIORITY );
+    prvEmitResult( "context_switch.semaphore", 0, 2ULL * ulIterations, ullEnd - ullStart );
+    vSemaphoreDelete( xPing );
+    vSemaphoreDelete( xPong );
+}
+/*-----------------------------------------------------------*/
+
+#if ( suiteHAS_SOFTWARE_INTERRUPT == 1 )
+
+    void vSuiteInterruptHandler( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        vTaskNotifyGiveFromISR( xInterruptTarget, &xHigherPriorityTaskWoken );
+        portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInterruptedTask( void * pvParameters )
+    {
+        uint32_t ulIteration;
+
+        ( void ) pvParameters;
+
+        for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        }
+
+        ullEnd = ullSuiteTimestamp();
+        prvFinishWorker();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInterruptingTask( void * pvParameters )
+    {
+        uint32_t ulIteration;
+
+        ( void ) pvParameters;
+
+        /* The interrupted task is the first worker.  It has the higher
+         * priority, so is already blocked. */
+        xInterruptTarget = xFirstWorker;
+        ullStart = ullSuiteTimestamp();
+
+        for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+        {
+            vSuiteTriggerInterrupt();
+        }
+
+        prvFinishWorker();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvMeasureInterrupts( void )
+    {
+        uint64_t ullInterruptStart;
+        uint32_t ulIteration;
+
+        /* The control task is the highest priority task, so the notification
+         * does not cause a context switch. */
+        xInterruptTarget = xControlTask;
+        ullInterruptStart = ullSuiteTimestamp();
+
+        for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+        {
+            vSuiteTriggerInterrupt();
+            configASSERT( ulTaskNotifyTake( pdTRUE, 0 ) == 1UL );
+        }
+
+        prvEmitResult( "interrupt.notify_running", 0, ulIterations, ullSuiteTimestamp() - ullInterruptStart );
+
+        prvStartWorkers( prvInterruptedTask, suiteHIGH_PRIORITY, prvInterruptingTask, suiteLOW_PRIORITY );
+        prvEmitResult( "interrupt.notify_task", 0, ulIterations, ullEnd - ullStart );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* suiteHAS_SOFTWARE_INTERRUPT */
+
+static void prvMeasureQueues( void )
+{
+    static const uint32_t ulItemSizes[] = { 4U, 16U, 64U, suiteMAX_ITEM_SIZE };
+    static uint8_t ucItem[ suiteMAX_ITEM_SIZE ];
+    QueueHandle_t xQueue;
+    uint32_t ulSize, ulIteration;
+    uint64_t ullQueueStart;
+
+    for( ulSize = 0; ulSize < ( sizeof( ulItemSizes ) / sizeof( ulItemSizes[ 0 ] ) ); ulSize++ )
+    {
+        xQueue = xQueueCreate( suiteQUEUE_LENGTH, ulItemSizes[ ulSize ] );
+        configASSERT( xQueue != NULL );
+
+        ullQueueStart = ullSuiteTimestamp();
+
+        for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+        {
+            configASSERT( xQueueSend( xQueue, ucItem, 0 ) == pdPASS );
+            configASSERT( xQueueReceive( xQueue, ucItem, 0 ) == pdPASS );
+        }
+
+        prvEmitResult( "queue.send_receive", ulItemSizes[ ulSize ], ulIterations, ullSuiteTimestamp() - ullQueueStart );
+        vQueueDelete( xQueue );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamSendingTask( void * pvParameters )
+{
+    static uint8_t ucChunk[ suiteMAX_ITEM_SIZE ];
+    uint64_t ullBytes = ullStreamBytes;
+
+    ( void ) pvParameters;
+
+    ullStart = ullSuiteTimestamp();
+
+    while( ullBytes > 0U )
+    {
+        configASSERT( xStreamBufferSend( xStreamBuffer, ucChunk, ulChunkSize, portMAX_DELAY ) == ulChunkSize );
+        ullBytes -= ulChunkSize;
+    }
+
+    prvFinishWorker();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamReceivingTask( void * pvParameters )
+{
+    static uint8_t ucBuffer[ suiteMAX_ITEM_SIZE ];
+    uint64_t ullBytes = ullStreamBytes;
+
+    ( void ) pvParameters;
+
+    while( ullBytes > 0U )
+    {
+        ullBytes -= xStreamBufferReceive( xStreamBuffer, ucBuffer, sizeof( ucBuffer ), portMAX_DELAY );
+    }
+
+    ullEnd = ullSuiteTimestamp();
+    prvFinishWorker();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureStreamBuffers( void )
+{
+    static const uint32_t ulChunkSizes[] = { 16U, suiteMAX_ITEM_SIZE };
+    uint32_t ulSize;
+
+    for( ulSize = 0; ulSize < ( sizeof( ulChunkSizes ) / sizeof( ulChunkSizes[ 0 ] ) ); ulSize++ )
+    {
+        ulChunkSize = ulChunkSizes[ ulSize ];
+        ullStreamBytes = ( ( ( uint64_t ) ulIterations * suiteSTREAM_BYTES_PER_ITERATION ) / ulChunkSize ) * ulChunkSize;
+        xStreamBuffer = xStreamBufferCreate( suiteSTREAM_BUFFER_SIZE, 1 );
+        configASSERT( xStreamBuffer != NULL );
+
+        prvStartWorkers( prvStreamReceivingTask, suiteLOW_PRIORITY, prvStreamSendingTask, suiteLOW_PRIORITY );
+        prvEmitResult( "stream_buffer.throughput", ulChunkSize, ullStreamBytes, ullEnd - ullStart );
+
+        vStreamBufferDelete( xStreamBuffer );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBarrier( void * pvParameter1,
+                        uint32_t ulParameter2 )
+{
+    ( void ) pvParameter1;
+    ( void ) ulParameter2;
+
+    xTaskNotifyGive( xControlTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForTimerService( void )
+{
+    /* Queued behind every command already sent. */
+    configASSERT( xTimerPendFunctionCall( prvBarrier, NULL, 0, portMAX_DELAY ) == pdPASS );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+
+    /* The timers used to measure xTimerStart() should never expire. */
+    ulUnexpectedExpiries++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvExpiringTimerCallback( TimerHandle_t xTimer )
+{
+    const uint64_t ullNow = ullSuiteTimestamp();
+
+    ( void ) xTimer;
+
+    if( ulExpired == 0U )
+    {
+        ullFirstExpiry = ullNow;
+        xFirstExpiryTick = xTaskGetTickCount();
+    }
+    else if( xTaskGetTickCount() != xFirstExpiryTick )
+    {
+        xExpiredOnDifferentTicks = pdTRUE;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    ullLastExpiry = ullNow;
+    ulExpired++;
+
+    if( ulExpired == suiteTIMERS )
+    {
+        xTaskNotifyGive( xControlTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureTimers( void )
+{
+    uint32_t ulTimer, ulRound, ulRounds, ulMeasuredRounds = 0;
+    uint64_t ullTimerStart, ullTotal;
+
+    /* The control task has a higher priority than the timer service task, so
+     * each round of commands is processed when the control task blocks. */
+    for( ulTimer = 0; ulTimer < suiteTIMERS; ulTimer++ )
+    {
+        xTimers[ ulTimer ] = xTimerCreate( "Idle", portMAX_DELAY / 2U, pdFALSE, NULL, prvIdleTimerCallback );
+        configASSERT( xTimers[ ulTimer ] != NULL );
+    }
+
+    ulRounds = ( ulIterations + suiteTIMERS - 1U ) / suiteTIMERS;
+    ullTimerStart = ullSuiteTimestamp();
+
+    for( ulRound = 0; ulRound < ulRounds; ulRound++ )
+    {
+        for( ulTimer = 0; ulTimer < suiteTIMERS; ulTimer++ )
+        {
+            configASSERT( xTimerStart( xTimers[ ulTimer ], portMAX_DELAY ) == pdPASS );
+        }
+
+        prvWaitForTimerService();
+    }
+
+    prvEmitResult( "timer.start", 0, ( uint64_t ) ulRounds * suiteTIMERS, ullSuiteTimestamp() - ullTimerStart );
+    configASSERT( ulUnexpectedExpiries == 0U );
+
+    /* All the timers in a round are started on the same tick, so expire
+     * together.  Rounds in which the tick count changed while the timers were
+     * being started are not counted. */
+    for( ulTimer = 0; ulTimer < suiteTIMERS; ulTimer++ )
+    {
+        configASSERT( xTimerDelete( xTimers[ ulTimer ], portMAX_DELAY ) == pdPASS );
+        xTimers[ ulTimer ] = xTimerCreate( "Expire", 2, pdFALSE, NULL, prvExpiringTimerCallback );
+        configASSERT( xTimers[ ulTimer ] != NULL );
+    }
+
+    ullTotal = 0;
+
+    for( ulRound = 0; ulRound < suiteEXPIRE_ROUNDS; ulRound++ )
+    {
+        ulExpired = 0;
+        xExpiredOnDifferentTicks = pdFALSE;
+
+        /* Start at the beginning of a tick period. */
+        vTaskDelay( 1 );
+
+        for( ulTimer = 0; ulTimer < suiteTIMERS; ulTimer++ )
+        {
+            configASSERT( xTimerStart( xTimers[ ulTimer ], portMAX_DELAY ) == pdPASS );
+        }
+
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        if( xExpiredOnDifferentTicks == pdFALSE )
+        {
+            ullTotal += ullLastExpiry - ullFirstExpiry;
+            ulMeasuredRounds++;
+        }
+    }
+
+    configASSERT( ulMeasuredRounds > 0U );
+    prvEmitResult( "timer.expire", 0, ( uint64_t ) ulMeasuredRounds * ( suiteTIMERS - 1U ), ullTotal );
+
+    for( ulTimer = 0; ulTimer < suiteTIMERS; ulTimer++ )
+    {
+        configASSERT( xTimerDelete( xTimers[ ulTimer ], portMAX_DELAY ) == pdPASS );
+    }
+
+    prvWaitForTimerService();
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvRandomBlockSize( void )
+{
+    return ( size_t ) ( suiteHEAP_MIN_BLOCK + ( prvRandom() % ( suiteHEAP_MAX_BLOCK - suiteHEAP_MIN_BLOCK + 1U ) ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureHeap( void )
+{
+    static void * pvBlocks[ suiteHEAP_SLOTS ];
+    uint32_t ulSlot, ulIteration;
+    uint64_t ullHeapStart;
+
+    /* Fill every slot, then free every other one, so the free space is split
+     * between blocks of random sizes before the measurement starts. */
+    for( ulSlot = 0; ulSlot < suiteHEAP_SLOTS; ulSlot++ )
+    {
+        pvBlocks[ ulSlot ] = pvPortMalloc( prvRandomBlockSize() );
+        configASSERT( pvBlocks[ ulSlot ] != NULL );
+    }
+
+    for( ulSlot = 0; ulSlot < suiteHEAP_SLOTS; ulSlot += 2U )
+    {
+        vPortFree( pvBlocks[ ulSlot ] );
+        pvBlocks[ ulSlot ] = NULL;
+    }
+
+    ullHeapStart = ullSuiteTimestamp();
+
+    for( ulIteration = 0; ulIteration < ulIterations; ulIteration++ )
+    {
+        ulSlot = prvRandom() % suiteHEAP_SLOTS;
+
+        if( pvBlocks[ ulSlot ] == NULL )
+        {
+            pvBlocks[ ulSlot ] = pvPortMalloc( prvRandomBlockSize() );
+            configASSERT( pvBlocks[ ulSlot ] != NULL );
+        }
+        else
+        {
+            vPortFree( pvBlocks[ ulSlot ] );
+            pvBlocks[ ulSlot ] = NULL;
+        }
+    }
+
+    prvEmitResult( "heap.malloc_free.fragmented", 0, ulIterations, ullSuiteTimestamp() - ullHeapStart );
+
+    for( ulSlot = 0; ulSlot < suiteHEAP_SLOTS; ulSlot++ )
+    {
+        vPortFree( pvBlocks[ ulSlot ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    xLineLength = 0;
+    prvAppend( "{\n  \"suite\": \"kernel\",\n  \"kernel\": \"" tskKERNEL_VERSION_NUMBER "\",\n  \"platform\": \"" );
+    prvAppend( pcSuitePlatform );
+    prvAppend( "\",\n  \"unit\": \"" );
+    prvAppend( pcSuiteTimestampUnit );
+    prvAppend( "\",\n  \"results\": [\n" );
+    vSuiteOutput( cLine );
+
+    prvMeasureContextSwitches();
+
+    #if ( suiteHAS_SOFTWARE_INTERRUPT == 1 )
+    {
+        prvMeasureInterrupts();
+    }
+    #endif
+
+    prvMeasureQueues();
+    prvMeasureStreamBuffers();
+    prvMeasureTimers();
+    prvMeasureHeap();
+
+    vSuiteOutput( "\n  ]\n}\n" );
+    vSuiteExit( 0 );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vSuiteCreateTasks( uint32_t ulIterationsPerTest )
+{
+    ulIterations = ulIterationsPerTest;
+    configASSERT( ulIterations > 0U );
+
+    configASSERT( xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, suiteCONTROL_PRIORITY, &xControlTask ) == pdPASS );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,79 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+#ifndef KERNEL_SUITE_H
+#define KERNEL_SUITE_H
+
+#include <stdint.h>
+
+/*
+ * The kernel microbenchmark suite.  kernel_suite.c holds the measurements and
+ * is the same on every platform.  Each platform directory provides the
+ * FreeRTOSConfig.h, the functions below and a main() that calls
+ * vSuiteCreateTasks() then starts the scheduler.
+ */
+
+/*-----------------------------------------------------------*/
+
+/* Provided by the platform. */
+
+/* Name of the platform and of the timestamp unit, as reported in the JSON. */
+extern const char * const pcSuitePlatform;
+extern const char * const pcSuiteTimestampUnit;
+
+/* A monotonic timestamp, in pcSuiteTimestampUnit.  Called from tasks only. */
+uint64_t ullSuiteTimestamp( void );
+
+/* Write a null terminated string to the results stream. */
+void vSuiteOutput( const char * pcString );
+
+/* Called by the suite once every result has been output.  iStatus is 0 if the
+ * suite passed. */
+void vSuiteExit( int iStatus );
+
+/* A platform that can raise an interrupt from a task sets
+ * suiteHAS_SOFTWARE_INTERRUPT to 1 in its FreeRTOSConfig.h, and provides
+ * vSuiteTriggerInterrupt(), which returns once the interrupt has been taken.
+ * The interrupt handler must call vSuiteInterruptHandler(). */
+#ifndef suiteHAS_SOFTWARE_INTERRUPT
+    #define suiteHAS_SOFTWARE_INTERRUPT    0
+#endif
+
+void vSuiteTriggerInterrupt( void );
+
+/*-----------------------------------------------------------*/
+
+/* Provided by kernel_suite.c.  Creates the task that runs every measurement,
+ * each of which repeats the operation it measures ulIterations times. */
+void vSuiteCreateTasks( uint32_t ulIterations );
+
+/* Provided by kernel_suite.c for platforms that set
+ * suiteHAS_SOFTWARE_INTERRUPT to 1.  Called from the interrupt raised by
+ * vSuiteTriggerInterrupt(). */
+void vSuiteInterruptHandler( void );
+
+#endif /* KERNEL_SUITE_H */
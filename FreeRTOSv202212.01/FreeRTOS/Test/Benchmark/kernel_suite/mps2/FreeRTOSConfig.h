@@ -0,0 +1,79 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+* Configuration for the kernel microbenchmark suite on the MPS2 AN385 (Cortex-M3)
+* and AN500 (Cortex-M7) as emulated by QEMU.  The results are written through
+* semihosting, and the timestamps count SysTick clocks, which are processor
+* cycles.
+*----------------------------------------------------------*/
+
+#define configUSE_PREEMPTION                       1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#define configUSE_IDLE_HOOK                        0
+#define configUSE_TICK_HOOK                        0
+#define configCPU_CLOCK_HZ                         ( ( unsigned long ) 25000000 )
+#define configTICK_RATE_HZ                         ( ( TickType_t ) 1000 )
+#define configMINIMAL_STACK_SIZE                   ( ( unsigned short ) 256 )
+#define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( 512 * 1024 ) )
+#define configMAX_TASK_NAME_LEN                    ( 8 )
+#define configUSE_TRACE_FACILITY                   0
+#define configUSE_16_BIT_TICKS                     0
+#define configIDLE_SHOULD_YIELD                    1
+#define configUSE_MUTEXES                          0
+#define configCHECK_FOR_STACK_OVERFLOW             0
+#define configUSE_MALLOC_FAILED_HOOK               0
+#define configSUPPORT_DYNAMIC_ALLOCATION           1
+#define configSUPPORT_STATIC_ALLOCATION            0
+#define configMAX_PRIORITIES                       ( 5 )
+#define configUSE_TIMERS                           1
+#define configTIMER_TASK_PRIORITY                  ( configMAX_PRIORITIES - 2 )
+#define configTIMER_QUEUE_LENGTH                   ( 32 )
+#define configTIMER_TASK_STACK_DEPTH               configMINIMAL_STACK_SIZE
+
+#define INCLUDE_vTaskDelay                         1
+#define INCLUDE_vTaskDelete                        1
+#define INCLUDE_xTimerPendFunctionCall             1
+#define INCLUDE_vTaskSuspend                       1
+
+/* The lowest interrupt priority for the kernel, and the highest priority from
+ * which interrupt safe API functions can be called. */
+#define configKERNEL_INTERRUPT_PRIORITY            255
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY       191
+
+/* main_mps2.c pends an otherwise unused interrupt, at the kernel's priority,
+ * for the interrupt measurements. */
+#define suiteHAS_SOFTWARE_INTERRUPT                1
+
+void vSuiteAssertCalled( const char * pcFile,
+                         int iLine );
+#define configASSERT( x )    if( ( x ) == 0 ) vSuiteAssertCalled( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,218 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Runs the kernel microbenchmark suite on the MPS2 AN385 (Cortex-M3) or AN500
+ * (Cortex-M7) as emulated by QEMU.  The results are written to the host's
+ * stdout through semihosting, and QEMU exits when the suite ends:
+ *
+ * qemu-system-arm -machine mps2-an385 -nographic -monitor null \
+ *     -semihosting-config enable=on,target=native -kernel kernel_suite_mps2.axf
+ *
+ * Timestamps are in cycles of the 25MHz SysTick clock.  QEMU does not model
+ * instruction timing, so add "-icount shift=0" for results that are
+ * repeatable between hosts, in which case a cycle is one instruction.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "kernel_suite.h"
+
+#ifndef suiteITERATIONS
+    #define suiteITERATIONS    10000UL
+#endif
+
+/* Reported in the results, so the Makefile names the machine, port and
+ * profile the suite was built for. */
+#ifndef suitePLATFORM_NAME
+    #define suitePLATFORM_NAME    "mps2-an385"
+#endif
+
+/* The SysTick registers, which the Cortex-M ports use to generate the tick.
+ * The cycle counter in the DWT is not modelled by QEMU. */
+#define suiteSYSTICK_LOAD     ( *( ( volatile uint32_t * ) 0xe000e014 ) )
+#define suiteSYSTICK_VALUE    ( *( ( volatile uint32_t * ) 0xe000e018 ) )
+
+/* System control and NVIC registers. */
+#define suiteSCB_VTOR         ( *( ( volatile uint32_t * ) 0xe000ed08 ) )
+#define suiteSCB_CPACR        ( *( ( volatile uint32_t * ) 0xe000ed88 ) )
+#define suiteNVIC_ISER        ( ( volatile uint32_t * ) 0xe000e100 )
+#define suiteNVIC_ISPR        ( ( volatile uint32_t * ) 0xe000e200 )
+#define suiteNVIC_IPR         ( ( volatile uint8_t * ) 0xe000e400 )
+
+/* The interrupt vSuiteTriggerInterrupt() pends.  Nothing the suite uses
+ * raises it. */
+#define suiteSOFTWARE_IRQ     ( 31UL )
+
+/* Entries in the vector table of the MPS2 demo's startup code, and in the
+ * copy of it in RAM that also holds the handler for suiteSOFTWARE_IRQ. */
+#define suiteROM_VECTORS      ( 16UL + 14UL )
+#define suiteRAM_VECTORS      ( 16UL + 32UL )
+
+/* Semihosting operations. */
+#define suiteSYS_WRITE0       0x04UL
+
+const char * const pcSuitePlatform = suitePLATFORM_NAME;
+const char * const pcSuiteTimestampUnit = "cycles";
+
+/* VTOR needs the table aligned to its size rounded up to a power of two. */
+static uint32_t ulVectors[ suiteRAM_VECTORS ] __attribute__( ( aligned( 256 ) ) );
+
+/* Called by the startup code before main(), which also provides exit(). */
+void uart_init( void );
+
+/*-----------------------------------------------------------*/
+
+uint64_t ullSuiteTimestamp( void )
+{
+    const uint64_t ullTickPeriod = ( uint64_t ) suiteSYSTICK_LOAD + 1ULL;
+    TickType_t xTicks;
+    uint32_t ulCountDown;
+
+    /* Timestamps are only taken with interrupts enabled, so the tick count is
+     * incremented as soon as SysTick wraps.  Read it on both sides of the
+     * SysTick value so the two are from the same tick period. */
+    do
+    {
+        xTicks = xTaskGetTickCount();
+        ulCountDown = suiteSYSTICK_VALUE;
+    } while( xTicks != xTaskGetTickCount() );
+
+    return ( ( uint64_t ) xTicks * ullTickPeriod ) + ( ullTickPeriod - 1ULL - ( uint64_t ) ulCountDown );
+}
+/*-----------------------------------------------------------*/
+
+void vSuiteOutput( const char * pcString )
+{
+    __asm volatile
+    (
+        "   mov r0, %0      \n"
+        "   mov r1, %1      \n"
+        "   bkpt 0xab       \n"
+        ::"r" ( suiteSYS_WRITE0 ), "r" ( pcString ) : "r0", "r1", "memory"
+    );
+}
+/*-----------------------------------------------------------*/
+
+void vSuiteExit( int iStatus )
+{
+    exit( iStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vSuiteAssertCalled( const char * pcFile,
+                         int iLine )
+{
+    char cLine[ 12 ];
+    size_t xDigit = sizeof( cLine ) - 1U;
+
+    taskDISABLE_INTERRUPTS();
+
+    cLine[ xDigit ] = '\0';
+
+    do
+    {
+        xDigit--;
+        cLine[ xDigit ] = ( char ) ( '0' + ( iLine % 10 ) );
+        iLine /= 10;
+    } while( ( iLine > 0 ) && ( xDigit > 1U ) );
+
+    xDigit--;
+    cLine[ xDigit ] = ':';
+
+    vSuiteOutput( "ASSERT FAILED: " );
+    vSuiteOutput( pcFile );
+    vSuiteOutput( &( cLine[ xDigit ] ) );
+    vSuiteOutput( "\n" );
+
+    exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+void vSuiteTriggerInterrupt( void )
+{
+    suiteNVIC_ISPR[ suiteSOFTWARE_IRQ / 32UL ] = 1UL << ( suiteSOFTWARE_IRQ % 32UL );
+
+    /* The interrupt is taken before the barriers complete. */
+    __asm volatile ( "dsb \n isb" ::: "memory" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInstallSoftwareInterrupt( void )
+{
+    const uint32_t * const pulRomVectors = ( const uint32_t * ) suiteSCB_VTOR;
+    uint32_t ulVector;
+
+    for( ulVector = 0; ulVector < suiteRAM_VECTORS; ulVector++ )
+    {
+        ulVectors[ ulVector ] = ( ulVector < suiteROM_VECTORS ) ? pulRomVectors[ ulVector ] : 0UL;
+    }
+
+    ulVectors[ 16UL + suiteSOFTWARE_IRQ ] = ( uint32_t ) vSuiteInterruptHandler;
+    suiteSCB_VTOR = ( uint32_t ) ulVectors;
+    __asm volatile ( "dsb \n isb" ::: "memory" );
+
+    /* The handler uses the interrupt safe API, so runs at the kernel's
+     * priority. */
+    suiteNVIC_IPR[ suiteSOFTWARE_IRQ ] = ( uint8_t ) configKERNEL_INTERRUPT_PRIORITY;
+    suiteNVIC_ISER[ suiteSOFTWARE_IRQ / 32UL ] = 1UL << ( suiteSOFTWARE_IRQ % 32UL );
+}
+/*-----------------------------------------------------------*/
+
+void uart_init( void )
+{
+    /* Output is through semihosting rather than the UART. */
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    #if defined( __ARM_FP )
+    {
+        /* Built for the CM4F or CM7 port.  The startup code leaves the FPU
+         * disabled, and the compiler may use it before the port enables it
+         * when the scheduler starts. */
+        suiteSCB_CPACR |= ( 0xfUL << 20 );
+        __asm volatile ( "dsb \n isb" ::: "memory" );
+    }
+    #endif
+
+    prvInstallSoftwareInterrupt();
+    vSuiteCreateTasks( suiteITERATIONS );
+
+    vTaskStartScheduler();
+
+    /* Only reached if there was not enough heap to start the scheduler. */
+    exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
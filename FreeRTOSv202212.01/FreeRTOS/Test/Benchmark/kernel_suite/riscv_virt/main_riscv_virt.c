@@ -0,0 +1,182 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Runs the kernel microbenchmark suite on QEMU's RISC-V virt machine.  The
+ * results are written to the NS16550 UART, and QEMU exits through the virt
+ * machine's test device when the suite ends:
+ *
+ * qemu-system-riscv32 -machine virt -nographic -bios none -net none \
+ *     -kernel kernel_suite_riscv_virt.elf
+ *
+ * Timestamps are in nanoseconds, read from the CLINT's 10MHz mtime counter.
+ * QEMU does not model instruction timing, so add "-icount shift=0" for
+ * results that are repeatable between hosts, in which case a nanosecond is one
+ * instruction.
+ *
+ * Built for a core with the F or D extension, the context_switch.yield_fpu
+ * result includes saving and restoring the floating point registers, which
+ * context_switch.yield does not.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "kernel_suite.h"
+
+#ifndef suiteITERATIONS
+    #define suiteITERATIONS    10000UL
+#endif
+
+/* Reported in the results, so the Makefile names the floating point extension
+ * the suite was built for. */
+#ifndef suitePLATFORM_NAME
+    #define suitePLATFORM_NAME    "riscv-virt"
+#endif
+
+/* The CLINT's mtime counter, which the port also uses to generate the tick. */
+#define suiteMTIME_LOW        ( *( ( volatile uint32_t * ) ( configMTIME_BASE_ADDRESS ) ) )
+#define suiteMTIME_HIGH       ( *( ( volatile uint32_t * ) ( configMTIME_BASE_ADDRESS + 4UL ) ) )
+#define suiteNS_PER_MTIME     ( 100ULL )
+
+/* The NS16550 UART's transmit holding and line status registers. */
+#define suiteUART_THR         ( *( ( volatile uint8_t * ) 0x10000000UL ) )
+#define suiteUART_LSR         ( *( ( volatile uint8_t * ) 0x10000005UL ) )
+#define suiteUART_LSR_THRE    ( 0x20U )
+
+/* Writing to the test device ends the simulation, with an exit status of 0 for
+ * suiteTEST_PASS, or of the upper 16 bits for suiteTEST_FAIL. */
+#define suiteTEST_DEVICE      ( *( ( volatile uint32_t * ) 0x00100000UL ) )
+#define suiteTEST_PASS        ( 0x5555UL )
+#define suiteTEST_FAIL        ( 0x3333UL )
+
+const char * const pcSuitePlatform = suitePLATFORM_NAME;
+const char * const pcSuiteTimestampUnit = "ns";
+
+extern void freertos_risc_v_trap_handler( void );
+
+/*-----------------------------------------------------------*/
+
+uint64_t ullSuiteTimestamp( void )
+{
+    uint32_t ulHigh, ulLow;
+
+    /* Read the high word on both sides of the low word so both are from the
+     * same count. */
+    do
+    {
+        ulHigh = suiteMTIME_HIGH;
+        ulLow = suiteMTIME_LOW;
+    } while( ulHigh != suiteMTIME_HIGH );
+
+    return ( ( ( uint64_t ) ulHigh << 32 ) | ( uint64_t ) ulLow ) * suiteNS_PER_MTIME;
+}
+/*-----------------------------------------------------------*/
+
+void vSuiteOutput( const char * pcString )
+{
+    while( *pcString != '\0' )
+    {
+        while( ( suiteUART_LSR & suiteUART_LSR_THRE ) == 0U )
+        {
+        }
+
+        suiteUART_THR = ( uint8_t ) *pcString;
+        pcString++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vSuiteExit( int iStatus )
+{
+    taskDISABLE_INTERRUPTS();
+
+    if( iStatus == 0 )
+    {
+        suiteTEST_DEVICE = suiteTEST_PASS;
+    }
+    else
+    {
+        suiteTEST_DEVICE = ( ( uint32_t ) iStatus << 16 ) | suiteTEST_FAIL;
+    }
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vSuiteAssertCalled( const char * pcFile,
+                         int iLine )
+{
+    char cLine[ 12 ];
+    size_t xDigit = sizeof( cLine ) - 1U;
+
+    taskDISABLE_INTERRUPTS();
+
+    cLine[ xDigit ] = '\0';
+
+    do
+    {
+        xDigit--;
+        cLine[ xDigit ] = ( char ) ( '0' + ( iLine % 10 ) );
+        iLine /= 10;
+    } while( ( iLine > 0 ) && ( xDigit > 1U ) );
+
+    xDigit--;
+    cLine[ xDigit ] = ':';
+
+    vSuiteOutput( "ASSERT FAILED: " );
+    vSuiteOutput( pcFile );
+    vSuiteOutput( &( cLine[ xDigit ] ) );
+    vSuiteOutput( "\n" );
+
+    vSuiteExit( 1 );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    /* The startup code is that of the RISC-V virt demo, which turns the
+     * floating point unit on when built for the F or D extension.  Every trap
+     * goes to the port's handler. */
+    __asm volatile ( "csrw mtvec, %0" ::"r" ( freertos_risc_v_trap_handler ) );
+
+    vSuiteCreateTasks( suiteITERATIONS );
+
+    vTaskStartScheduler();
+
+    /* Only reached if there was not enough heap to start the scheduler. */
+    vSuiteExit( 2 );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,247 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of creating and deleting kernel objects with and without
+ * the kernel object pools (configTASK_POOL_LENGTH, configQUEUE_POOL_LENGTH,
+ * configEVENT_GROUP_POOL_LENGTH and configSTREAM_BUFFER_POOL_LENGTH).
+ *
+ * Usage: object_pool_bench_<method> <number of fragments>
+ *
+ * Before measuring, the requested number of small blocks are allocated from
+ * the heap_4 heap and every other one is freed again, leaving a free list that
+ * a first fit search has to walk past.  Each type of object is then created
+ * and immediately deleted repeatedly.  Task stacks always come from the heap,
+ * so the pools only remove the TCB allocation from task creation.
+ *
+ * The build that uses the pools also checks that creating each type of
+ * object, other than a task, leaves the free heap space unchanged.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+
+#define benchITERATIONS       ( 100000UL )
+#define benchMAX_FRAGMENTS    ( 2000UL )
+
+#ifndef configUSE_OBJECT_POOLS_IN_BENCHMARK
+    #error configUSE_OBJECT_POOLS_IN_BENCHMARK must be set on the command line
+#endif
+
+#if ( configUSE_OBJECT_POOLS_IN_BENCHMARK == 1 )
+    #define benchMETHOD_NAME    "pool"
+#else
+    #define benchMETHOD_NAME    "heap"
+#endif
+
+/* The types of object measured. */
+typedef enum
+{
+    eBenchSemaphore = 0,
+    eBenchMutex,
+    eBenchQueue,
+    eBenchEventGroup,
+    eBenchStreamBuffer,
+    eBenchTask,
+    eBenchNumberOfObjects
+} BenchObject_t;
+
+/*-----------------------------------------------------------*/
+
+static const char * const pcObjectNames[ eBenchNumberOfObjects ] = { "semaphore", "mutex", "queue", "event", "stream", "task" };
+static void * pvFragments[ benchMAX_FRAGMENTS ];
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    /* Never executes. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvCreate( BenchObject_t eObject )
+{
+    void * pvObject = NULL;
+    TaskHandle_t xTask = NULL;
+
+    switch( eObject )
+    {
+        case eBenchSemaphore:
+            pvObject = xSemaphoreCreateBinary();
+            break;
+
+        case eBenchMutex:
+            pvObject = xSemaphoreCreateMutex();
+            break;
+
+        case eBenchQueue:
+            pvObject = xQueueCreate( 8, sizeof( uint32_t ) );
+            break;
+
+        case eBenchEventGroup:
+            pvObject = xEventGroupCreate();
+            break;
+
+        case eBenchStreamBuffer:
+            pvObject = xStreamBufferCreate( 100, 1 );
+            break;
+
+        case eBenchTask:
+
+            /* Created at the idle priority so the idle task remains the
+             * running task, and the new task can be deleted immediately. */
+            if( xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, &xTask ) == pdPASS )
+            {
+                pvObject = xTask;
+            }
+
+            break;
+
+        default:
+            break;
+    }
+
+    configASSERT( pvObject != NULL );
+
+    return pvObject;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDelete( BenchObject_t eObject,
+                       void * pvObject )
+{
+    switch( eObject )
+    {
+        case eBenchSemaphore:
+        case eBenchMutex:
+        case eBenchQueue:
+            vQueueDelete( pvObject );
+            break;
+
+        case eBenchEventGroup:
+            vEventGroupDelete( pvObject );
+            break;
+
+        case eBenchStreamBuffer:
+            vStreamBufferDelete( pvObject );
+            break;
+
+        case eBenchTask:
+            vTaskDelete( pvObject );
+            break;
+
+        default:
+            break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    BenchObject_t eObject;
+    unsigned long ulIteration, x, ulFragments;
+    uint64_t ullStart, ullTime;
+    size_t xFreeBytes;
+    void * pvObject;
+
+    ulFragments = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 100;
+    configASSERT( ulFragments <= benchMAX_FRAGMENTS );
+
+    /* Returns with the idle task selected as the running task. */
+    vTaskStartScheduler();
+
+    for( x = 0; x < ulFragments; x++ )
+    {
+        pvFragments[ x ] = pvPortMalloc( 16 );
+        configASSERT( pvFragments[ x ] != NULL );
+    }
+
+    for( x = 0; x < ulFragments; x += 2 )
+    {
+        vPortFree( pvFragments[ x ] );
+    }
+
+    printf( "%-4s fragments %4lu ", benchMETHOD_NAME, ulFragments );
+
+    for( eObject = eBenchSemaphore; eObject < eBenchNumberOfObjects; eObject++ )
+    {
+        xFreeBytes = xPortGetFreeHeapSize();
+        pvObject = prvCreate( eObject );
+
+        if( ( configUSE_OBJECT_POOLS_IN_BENCHMARK == 1 ) && ( eObject != eBenchTask ) && ( xPortGetFreeHeapSize() != xFreeBytes ) )
+        {
+            printf( "\r\nFAIL: %s was not allocated from its pool\r\n", pcObjectNames[ eObject ] );
+            return EXIT_FAILURE;
+        }
+
+        prvDelete( eObject, pvObject );
+
+        if( xPortGetFreeHeapSize() != xFreeBytes )
+        {
+            printf( "\r\nFAIL: deleting a %s did not free its memory\r\n", pcObjectNames[ eObject ] );
+            return EXIT_FAILURE;
+        }
+
+        ullStart = prvNanoseconds();
+
+        for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+        {
+            prvDelete( eObject, prvCreate( eObject ) );
+        }
+
+        ullTime = prvNanoseconds() - ullStart;
+
+        printf( " %s %6.1f ns", pcObjectNames[ eObject ], ( double ) ullTime / ( double ) benchITERATIONS );
+    }
+
+    printf( "\r\n" );
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
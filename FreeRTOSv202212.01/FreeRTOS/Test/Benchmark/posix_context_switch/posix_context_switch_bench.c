@@ -0,0 +1,184 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of a task switch on the Posix port, with the default
+ * condition variable handoff and with configUSE_POSIX_FUTEX_HANDOFF.
+ *
+ * Usage: posix_context_switch_bench_<method> <switches>
+ *
+ * yield:  two tasks of the same priority call taskYIELD() in turn.
+ * notify: a task gives a notification to a higher priority task, which runs
+ *         straight away and blocks again, so every give costs two switches.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configUSE_POSIX_FUTEX_HANDOFF == 1 )
+    #define benchMETHOD_NAME    "futex"
+#else
+    #define benchMETHOD_NAME    "condvar"
+#endif
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulSwitches;
+static volatile unsigned long ulYieldsDone;
+static TaskHandle_t xControlTask;
+static TaskHandle_t xTakeTask;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvMicroseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000ULL ) + ( ( uint64_t ) xTime.tv_nsec / 1000ULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( const char * pcTest,
+                       uint64_t ullWallUs,
+                       const struct rusage * pxBefore,
+                       const struct rusage * pxAfter )
+{
+    uint64_t ullCpuUs;
+    long lHostSwitches;
+
+    ullCpuUs = ( ( uint64_t ) ( pxAfter->ru_utime.tv_sec - pxBefore->ru_utime.tv_sec ) * 1000000ULL ) +
+               ( uint64_t ) ( pxAfter->ru_utime.tv_usec - pxBefore->ru_utime.tv_usec ) +
+               ( ( uint64_t ) ( pxAfter->ru_stime.tv_sec - pxBefore->ru_stime.tv_sec ) * 1000000ULL ) +
+               ( uint64_t ) ( pxAfter->ru_stime.tv_usec - pxBefore->ru_stime.tv_usec );
+    lHostSwitches = ( pxAfter->ru_nvcsw - pxBefore->ru_nvcsw ) + ( pxAfter->ru_nivcsw - pxBefore->ru_nivcsw );
+
+    printf( "%-7s %-6s %8lu switches  %7.2f us/switch  %9.0f switches/s  cpu %7.2f us/switch  host switches %5.2f/switch\r\n",
+            benchMETHOD_NAME, pcTest, ulSwitches,
+            ( double ) ullWallUs / ( double ) ulSwitches,
+            ( double ) ulSwitches * 1000000.0 / ( double ) ullWallUs,
+            ( double ) ullCpuUs / ( double ) ulSwitches,
+            ( double ) lHostSwitches / ( double ) ulSwitches );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    /* The two tasks take turns, so between them they yield ulSwitches
+     * times. */
+    while( ulYieldsDone < ulSwitches )
+    {
+        ulYieldsDone++;
+        taskYIELD();
+    }
+
+    xTaskNotifyGive( xControlTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTakeTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvGiveTask( void * pvParameters )
+{
+    unsigned long ulGive;
+
+    ( void ) pvParameters;
+
+    for( ulGive = 0; ulGive < ulSwitches / 2UL; ulGive++ )
+    {
+        xTaskNotifyGive( xTakeTask );
+    }
+
+    xTaskNotifyGive( xControlTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    struct rusage xBefore, xAfter;
+    uint64_t ullStartUs;
+
+    ( void ) pvParameters;
+
+    /* Two tasks of the same priority yielding to each other. */
+    getrusage( RUSAGE_SELF, &xBefore );
+    ullStartUs = prvMicroseconds();
+    configASSERT( xTaskCreate( prvYieldTask, "YieldA", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+    configASSERT( xTaskCreate( prvYieldTask, "YieldB", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    getrusage( RUSAGE_SELF, &xAfter );
+    prvReport( "yield", prvMicroseconds() - ullStartUs, &xBefore, &xAfter );
+
+    /* A task waking a higher priority task that blocks again. */
+    getrusage( RUSAGE_SELF, &xBefore );
+    ullStartUs = prvMicroseconds();
+    configASSERT( xTaskCreate( prvTakeTask, "Take", configMINIMAL_STACK_SIZE, NULL, 2, &xTakeTask ) == pdPASS );
+    configASSERT( xTaskCreate( prvGiveTask, "Give", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    getrusage( RUSAGE_SELF, &xAfter );
+    prvReport( "notify", prvMicroseconds() - ullStartUs, &xBefore, &xAfter );
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    ulSwitches = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 200000UL;
+    configASSERT( ulSwitches > 1 );
+
+    configASSERT( xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControlTask ) == pdPASS );
+
+    /* Returns once the control task ends the scheduler. */
+    vTaskStartScheduler();
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,147 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the host CPU time and context switches used by an otherwise idle
+ * Posix port simulation, with and without configUSE_TICKLESS_IDLE.
+ *
+ * Usage: posix_tickless_bench_<method> <sleep time in milliseconds>
+ *
+ * A single task repeatedly sleeps for the given time, for about two seconds in
+ * total, so the idle task runs for nearly all of that time.  With the periodic
+ * tick the host is woken on every tick regardless.  With tickless idle it is
+ * only woken when the task is due to unblock.
+ *
+ * The benchmark fails if the tick count gets ahead of the wall clock time,
+ * which would mean the task was unblocked early.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchRUN_TIME_MS    ( 2000UL )
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    #define benchMETHOD_NAME    "tickless"
+#else
+    #define benchMETHOD_NAME    "ticking"
+#endif
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulSleepTimeMs;
+static int iResult = EXIT_FAILURE;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvMicroseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000ULL ) + ( ( uint64_t ) xTime.tv_nsec / 1000ULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvCpuMicroseconds( const struct rusage * pxUsage )
+{
+    return ( ( uint64_t ) pxUsage->ru_utime.tv_sec * 1000000ULL ) + ( uint64_t ) pxUsage->ru_utime.tv_usec +
+           ( ( uint64_t ) pxUsage->ru_stime.tv_sec * 1000000ULL ) + ( uint64_t ) pxUsage->ru_stime.tv_usec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSleepTask( void * pvParameters )
+{
+    struct rusage xStartUsage, xEndUsage;
+    uint64_t ullStartUs, ullWallUs, ullCpuUs;
+    TickType_t xStartTicks, xTicks;
+    unsigned long ulSleep, ulSwitches;
+
+    ( void ) pvParameters;
+
+    /* Let the scheduler settle before starting to measure. */
+    vTaskDelay( pdMS_TO_TICKS( 10 ) );
+
+    getrusage( RUSAGE_SELF, &xStartUsage );
+    ullStartUs = prvMicroseconds();
+    xStartTicks = xTaskGetTickCount();
+
+    for( ulSleep = 0; ulSleep < ( benchRUN_TIME_MS / ulSleepTimeMs ); ulSleep++ )
+    {
+        vTaskDelay( pdMS_TO_TICKS( ulSleepTimeMs ) );
+    }
+
+    xTicks = xTaskGetTickCount() - xStartTicks;
+    ullWallUs = prvMicroseconds() - ullStartUs;
+    getrusage( RUSAGE_SELF, &xEndUsage );
+
+    ullCpuUs = prvCpuMicroseconds( &xEndUsage ) - prvCpuMicroseconds( &xStartUsage );
+    ulSwitches = ( unsigned long ) ( ( xEndUsage.ru_nvcsw - xStartUsage.ru_nvcsw ) + ( xEndUsage.ru_nivcsw - xStartUsage.ru_nivcsw ) );
+
+    printf( "%-8s sleep %3lu ms  cpu %6.1f ms/s  context switches %7.1f /s  ticks %5lu in %7.1f ms\r\n",
+            benchMETHOD_NAME, ulSleepTimeMs,
+            ( double ) ullCpuUs * 1000.0 / ( double ) ullWallUs,
+            ( double ) ulSwitches * 1000000.0 / ( double ) ullWallUs,
+            ( unsigned long ) xTicks, ( double ) ullWallUs / 1000.0 );
+
+    /* The tick count may fall behind the wall clock if the host delays the
+     * timer signal, but must never get ahead of it. */
+    if( ( uint64_t ) xTicks * portTICK_PERIOD_MS <= ( ullWallUs / 1000ULL ) + 1ULL )
+    {
+        iResult = EXIT_SUCCESS;
+    }
+    else
+    {
+        printf( "FAIL: the tick count got ahead of the wall clock time\r\n" );
+    }
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    ulSleepTimeMs = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 10;
+    configASSERT( ( ulSleepTimeMs > 0 ) && ( ulSleepTimeMs <= benchRUN_TIME_MS ) );
+
+    configASSERT( xTaskCreate( prvSleepTask, "Sleep", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL ) == pdPASS );
+
+    /* Returns once the task ends the scheduler. */
+    vTaskStartScheduler();
+
+    return iResult;
+}
+/*-----------------------------------------------------------*/
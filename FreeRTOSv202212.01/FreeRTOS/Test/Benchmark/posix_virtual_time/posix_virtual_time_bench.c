@@ -0,0 +1,161 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures how fast a simulation runs on the Posix port with and without
+ * configUSE_VIRTUAL_TIME, and checks the order the tasks run in.
+ *
+ * Usage: posix_virtual_time_bench_<method> <simulated seconds>
+ *
+ * Three tasks, two of which share a priority, wake periodically and send the
+ * tick count to a higher priority task that folds every item it receives into
+ * a hash.  With virtual time the hash must be the same on every run.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#define benchNUMBER_OF_SENDERS    ( 3 )
+#define benchQUEUE_LENGTH         ( 8 )
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    #define benchMETHOD_NAME    "virtual"
+#else
+    #define benchMETHOD_NAME    "real"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The period and priority of each sending task. */
+static const TickType_t xSenderPeriods[ benchNUMBER_OF_SENDERS ] = { 3, 7, 10 };
+static const UBaseType_t uxSenderPriorities[ benchNUMBER_OF_SENDERS ] = { 1, 1, 2 };
+
+static QueueHandle_t xQueue;
+static unsigned long ulSimulatedSeconds;
+static uint64_t ullOrderHash = 14695981039346656037ULL;
+static unsigned long ulItemsReceived = 0;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvMicroseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000ULL ) + ( ( uint64_t ) xTime.tv_nsec / 1000ULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSenderTask( void * pvParameters )
+{
+    const uint32_t ulSender = ( uint32_t ) ( uintptr_t ) pvParameters;
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint32_t ulItem;
+
+    for( ; ; )
+    {
+        vTaskDelayUntil( &xLastWakeTime, xSenderPeriods[ ulSender ] );
+
+        ulItem = ( ulSender << 24 ) | ( ( uint32_t ) xTaskGetTickCount() & 0xffffffUL );
+        configASSERT( xQueueSend( xQueue, &ulItem, portMAX_DELAY ) == pdPASS );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiverTask( void * pvParameters )
+{
+    uint32_t ulItem;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        configASSERT( xQueueReceive( xQueue, &ulItem, portMAX_DELAY ) == pdPASS );
+
+        /* FNV-1a, so a difference in the order of any two items changes the
+         * hash. */
+        ullOrderHash = ( ullOrderHash ^ ulItem ) * 1099511628211ULL;
+        ulItemsReceived++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    uint64_t ullStartUs, ullWallUs;
+
+    ( void ) pvParameters;
+
+    ullStartUs = prvMicroseconds();
+
+    vTaskDelay( pdMS_TO_TICKS( ulSimulatedSeconds * 1000UL ) );
+
+    ullWallUs = prvMicroseconds() - ullStartUs;
+
+    printf( "%-7s %4lu s simulated in %8.3f s (%7.1fx)  items %8lu  order hash %016llx\r\n",
+            benchMETHOD_NAME, ulSimulatedSeconds,
+            ( double ) ullWallUs / 1000000.0,
+            ( double ) ulSimulatedSeconds * 1000000.0 / ( double ) ullWallUs,
+            ulItemsReceived, ( unsigned long long ) ullOrderHash );
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    uint32_t ulSender;
+
+    ulSimulatedSeconds = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 2;
+    configASSERT( ulSimulatedSeconds > 0 );
+
+    xQueue = xQueueCreate( benchQUEUE_LENGTH, sizeof( uint32_t ) );
+    configASSERT( xQueue != NULL );
+
+    for( ulSender = 0; ulSender < benchNUMBER_OF_SENDERS; ulSender++ )
+    {
+        configASSERT( xTaskCreate( prvSenderTask, "Send", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) ulSender, uxSenderPriorities[ ulSender ], NULL ) == pdPASS );
+    }
+
+    configASSERT( xTaskCreate( prvReceiverTask, "Receive", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 2, NULL ) == pdPASS );
+    configASSERT( xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL ) == pdPASS );
+
+    /* Returns once the control task ends the scheduler. */
+    vTaskStartScheduler();
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
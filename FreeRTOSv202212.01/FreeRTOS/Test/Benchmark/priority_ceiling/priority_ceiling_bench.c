@@ -0,0 +1,323 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Compares priority ceiling mutexes with priority inheritance mutexes.
+ *
+ * Usage: priority_ceiling_bench_<method> <rounds>
+ *
+ * chain:    Low holds mutex A.  Mid takes mutex B then A.  High takes B then A
+ *           while Hog, a CPU bound task with a priority between Mid and High,
+ *           becomes ready.  Reports how long High waits for both mutexes.
+ *           With inheritance High can be blocked behind Mid and Low in turn,
+ *           and without chains Low only inherits Mid's priority, so Hog runs
+ *           first.  With ceiling mutexes Low runs at High's priority as soon
+ *           as it takes A, so Mid cannot take B before Low is done and High
+ *           only waits for the rest of Low's critical section.
+ * overhead: Low takes and gives A when no other task wants it.  Reports the
+ *           CPU time of each take and give pair, which for a ceiling mutex
+ *           includes moving Low to the ceiling priority and back.
+ *
+ * Every mutex is used by High, so every ceiling is High's priority.  Work is
+ * measured in thread CPU time, so a task that is preempted does not make
+ * progress.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+    #define benchMETHOD_NAME    "ceiling"
+#elif ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+    #define benchMETHOD_NAME    "chains"
+#else
+    #define benchMETHOD_NAME    "inherit"
+#endif
+
+/* Task priorities. */
+#define benchLOW_PRIORITY        ( 1 )
+#define benchMID_PRIORITY        ( 2 )
+#define benchHOG_PRIORITY        ( 3 )
+#define benchHIGH_PRIORITY       ( 4 )
+#define benchCONTROL_PRIORITY    ( 5 )
+
+/* CPU time each task spends working, in microseconds. */
+#define benchLOW_WORK_US         ( 5000ULL )
+#define benchMID_WORK_US         ( 200ULL )
+#define benchHOG_WORK_US         ( 20000ULL )
+
+/* Take and give pairs timed by the overhead scenario. */
+#define benchOVERHEAD_PAIRS      ( 200000UL )
+
+/*-----------------------------------------------------------*/
+
+typedef struct BenchLatency
+{
+    uint64_t ullMinUs;
+    uint64_t ullMaxUs;
+    uint64_t ullTotalUs;
+} BenchLatency_t;
+
+static unsigned long ulRounds;
+static SemaphoreHandle_t xMutexA;
+static SemaphoreHandle_t xMutexB;
+static TaskHandle_t xControlTask;
+static TaskHandle_t xLowTask;
+static TaskHandle_t xMidTask;
+static TaskHandle_t xHogTask;
+static TaskHandle_t xHighTask;
+
+/* The time the measured wait started, and the measured waits. */
+static volatile uint64_t ullWaitStartUs;
+static BenchLatency_t xLatency;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvMicroseconds( clockid_t xClock )
+{
+    struct timespec xTime;
+
+    clock_gettime( xClock, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000ULL ) + ( ( uint64_t ) xTime.tv_nsec / 1000ULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWork( uint64_t ullMicroseconds )
+{
+    const uint64_t ullEnd = prvMicroseconds( CLOCK_THREAD_CPUTIME_ID ) + ullMicroseconds;
+
+    while( prvMicroseconds( CLOCK_THREAD_CPUTIME_ID ) < ullEnd )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static SemaphoreHandle_t prvCreateMutex( void )
+{
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        return xSemaphoreCreateMutexWithCeiling( benchHIGH_PRIORITY );
+    #else
+        return xSemaphoreCreateMutex();
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordWait( void )
+{
+    const uint64_t ullWaitUs = prvMicroseconds( CLOCK_MONOTONIC ) - ullWaitStartUs;
+
+    if( ullWaitUs < xLatency.ullMinUs )
+    {
+        xLatency.ullMinUs = ullWaitUs;
+    }
+
+    if( ullWaitUs > xLatency.ullMaxUs )
+    {
+        xLatency.ullMaxUs = ullWaitUs;
+    }
+
+    xLatency.ullTotalUs += ullWaitUs;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLowTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        configASSERT( xSemaphoreTake( xMutexA, portMAX_DELAY ) == pdPASS );
+        xTaskNotifyGive( xControlTask );
+        prvWork( benchLOW_WORK_US );
+        configASSERT( xSemaphoreGive( xMutexA ) == pdPASS );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMidTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        configASSERT( xSemaphoreTake( xMutexB, portMAX_DELAY ) == pdPASS );
+        configASSERT( xSemaphoreTake( xMutexA, portMAX_DELAY ) == pdPASS );
+        prvWork( benchMID_WORK_US );
+        configASSERT( xSemaphoreGive( xMutexA ) == pdPASS );
+        configASSERT( xSemaphoreGive( xMutexB ) == pdPASS );
+        xTaskNotifyGive( xControlTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvHighTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        configASSERT( xSemaphoreTake( xMutexB, portMAX_DELAY ) == pdPASS );
+        configASSERT( xSemaphoreTake( xMutexA, portMAX_DELAY ) == pdPASS );
+        prvRecordWait();
+        configASSERT( xSemaphoreGive( xMutexA ) == pdPASS );
+        configASSERT( xSemaphoreGive( xMutexB ) == pdPASS );
+        xTaskNotifyGive( xControlTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvHogTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        prvWork( benchHOG_WORK_US );
+        xTaskNotifyGive( xControlTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvOverheadTask( void * pvParameters )
+{
+    uint64_t ullStartUs;
+    unsigned long ulPair;
+
+    ( void ) pvParameters;
+
+    ullStartUs = prvMicroseconds( CLOCK_THREAD_CPUTIME_ID );
+
+    for( ulPair = 0; ulPair < benchOVERHEAD_PAIRS; ulPair++ )
+    {
+        configASSERT( xSemaphoreTake( xMutexA, portMAX_DELAY ) == pdPASS );
+        configASSERT( xSemaphoreGive( xMutexA ) == pdPASS );
+    }
+
+    printf( "%-7s %-8s %6lu pairs  take+give  %8.1f ns\r\n",
+            benchMETHOD_NAME, "overhead", benchOVERHEAD_PAIRS,
+            ( double ) ( prvMicroseconds( CLOCK_THREAD_CPUTIME_ID ) - ullStartUs ) * 1000.0 / ( double ) benchOVERHEAD_PAIRS );
+
+    xTaskNotifyGive( xControlTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForNotifications( uint32_t ulCount )
+{
+    while( ulCount > 0UL )
+    {
+        ulCount -= ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    unsigned long ulRound;
+
+    ( void ) pvParameters;
+
+    xMutexA = prvCreateMutex();
+    xMutexB = prvCreateMutex();
+    configASSERT( ( xMutexA != NULL ) && ( xMutexB != NULL ) );
+
+    configASSERT( xTaskCreate( prvLowTask, "Low", configMINIMAL_STACK_SIZE, NULL, benchLOW_PRIORITY, &xLowTask ) == pdPASS );
+    configASSERT( xTaskCreate( prvMidTask, "Mid", configMINIMAL_STACK_SIZE, NULL, benchMID_PRIORITY, &xMidTask ) == pdPASS );
+    configASSERT( xTaskCreate( prvHogTask, "Hog", configMINIMAL_STACK_SIZE, NULL, benchHOG_PRIORITY, &xHogTask ) == pdPASS );
+    configASSERT( xTaskCreate( prvHighTask, "High", configMINIMAL_STACK_SIZE, NULL, benchHIGH_PRIORITY, &xHighTask ) == pdPASS );
+
+    xLatency.ullMinUs = UINT64_MAX;
+
+    for( ulRound = 0; ulRound < ulRounds; ulRound++ )
+    {
+        /* Low takes A and starts working. */
+        xTaskNotifyGive( xLowTask );
+        prvWaitForNotifications( 1 );
+
+        /* Mid gets the chance to take B and block on A, which it only can
+         * if Low is not running at a ceiling priority. */
+        xTaskNotifyGive( xMidTask );
+        vTaskDelay( 2 );
+
+        /* High wants B and A, and Hog becomes ready. */
+        ullWaitStartUs = prvMicroseconds( CLOCK_MONOTONIC );
+        xTaskNotifyGive( xHogTask );
+        xTaskNotifyGive( xHighTask );
+
+        /* High, Hog and Mid finishing. */
+        prvWaitForNotifications( 3 );
+    }
+
+    printf( "%-7s %-8s %6lu rounds  High waits  min %8.2f ms  avg %8.2f ms  max %8.2f ms\r\n",
+            benchMETHOD_NAME, "chain", ulRounds,
+            ( double ) xLatency.ullMinUs / 1000.0,
+            ( double ) xLatency.ullTotalUs / ( double ) ulRounds / 1000.0,
+            ( double ) xLatency.ullMaxUs / 1000.0 );
+
+    vTaskSuspend( xLowTask );
+    vTaskSuspend( xMidTask );
+    vTaskSuspend( xHogTask );
+    vTaskSuspend( xHighTask );
+
+    configASSERT( xTaskCreate( prvOverheadTask, "Over", configMINIMAL_STACK_SIZE, NULL, benchLOW_PRIORITY, NULL ) == pdPASS );
+    prvWaitForNotifications( 1 );
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    ulRounds = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 50UL;
+    configASSERT( ulRounds > 0 );
+
+    configASSERT( xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, &xControlTask ) == pdPASS );
+
+    /* Returns once the control task ends the scheduler. */
+    vTaskStartScheduler();
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
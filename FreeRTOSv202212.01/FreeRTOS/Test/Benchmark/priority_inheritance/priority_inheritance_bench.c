@@ -0,0 +1,353 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures how long tasks wait behind lower priority mutex holders, with the
+ * default priority inheritance and with configUSE_PRIORITY_INHERITANCE_CHAINS.
+ *
+ * Usage: priority_inheritance_bench_<method> <rounds>
+ *
+ * chain:  Low holds mutex A.  Mid holds mutex B and waits for A.  High waits
+ *         for B while Hog, a CPU bound task with a priority between Mid and
+ *         High, becomes ready.  Reports how long High waits for B.  Without
+ *         chains Low only inherits Mid's priority, so Hog runs first.
+ * nested: Low holds mutexes A and B and High waits for B.  Once Low gives B
+ *         back, and High has run, Hog becomes ready while Low still holds A.
+ *         Reports how long Hog waits to run.  Without chains Low keeps High's
+ *         priority until it has given A back too.
+ *
+ * Work is measured in thread CPU time, so a task that is preempted does not
+ * make progress.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+    #define benchMETHOD_NAME    "chains"
+#else
+    #define benchMETHOD_NAME    "flat"
+#endif
+
+/* Task priorities. */
+#define benchLOW_PRIORITY        ( 1 )
+#define benchMID_PRIORITY        ( 2 )
+#define benchHOG_PRIORITY        ( 3 )
+#define benchHIGH_PRIORITY       ( 4 )
+#define benchCONTROL_PRIORITY    ( 5 )
+
+/* CPU time each task spends working, in microseconds. */
+#define benchLOW_WORK_US         ( 5000ULL )
+#define benchLOW_TAIL_WORK_US    ( 10000ULL )
+#define benchMID_WORK_US         ( 200ULL )
+#define benchHOG_WORK_US         ( 20000ULL )
+
+/*-----------------------------------------------------------*/
+
+typedef struct BenchLatency
+{
+    uint64_t ullMinUs;
+    uint64_t ullMaxUs;
+    uint64_t ullTotalUs;
+} BenchLatency_t;
+
+static unsigned long ulRounds;
+static SemaphoreHandle_t xMutexA;
+static SemaphoreHandle_t xMutexB;
+static TaskHandle_t xControlTask;
+static TaskHandle_t xLowTask;
+static TaskHandle_t xMidTask;
+static TaskHandle_t xHogTask;
+static TaskHandle_t xHighTask;
+
+/* The time the measured wait started, and the measured waits. */
+static volatile uint64_t ullWaitStartUs;
+static BenchLatency_t xLatency;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvMicroseconds( clockid_t xClock )
+{
+    struct timespec xTime;
+
+    clock_gettime( xClock, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000ULL ) + ( ( uint64_t ) xTime.tv_nsec / 1000ULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWork( uint64_t ullMicroseconds )
+{
+    const uint64_t ullEnd = prvMicroseconds( CLOCK_THREAD_CPUTIME_ID ) + ullMicroseconds;
+
+    while( prvMicroseconds( CLOCK_THREAD_CPUTIME_ID ) < ullEnd )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordWait( void )
+{
+    const uint64_t ullWaitUs = prvMicroseconds( CLOCK_MONOTONIC ) - ullWaitStartUs;
+
+    if( ullWaitUs < xLatency.ullMinUs )
+    {
+        xLatency.ullMinUs = ullWaitUs;
+    }
+
+    if( ullWaitUs > xLatency.ullMaxUs )
+    {
+        xLatency.ullMaxUs = ullWaitUs;
+    }
+
+    xLatency.ullTotalUs += ullWaitUs;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( const char * pcTest,
+                       const char * pcWaiter )
+{
+    printf( "%-7s %-7s %5lu rounds  %-4s waits  min %8.2f ms  avg %8.2f ms  max %8.2f ms\r\n",
+            benchMETHOD_NAME, pcTest, ulRounds, pcWaiter,
+            ( double ) xLatency.ullMinUs / 1000.0,
+            ( double ) xLatency.ullTotalUs / ( double ) ulRounds / 1000.0,
+            ( double ) xLatency.ullMaxUs / 1000.0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetLatency( void )
+{
+    xLatency.ullMinUs = UINT64_MAX;
+    xLatency.ullMaxUs = 0;
+    xLatency.ullTotalUs = 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainLowTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        configASSERT( xSemaphoreTake( xMutexA, portMAX_DELAY ) == pdPASS );
+        xTaskNotifyGive( xControlTask );
+        prvWork( benchLOW_WORK_US );
+        configASSERT( xSemaphoreGive( xMutexA ) == pdPASS );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainMidTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        configASSERT( xSemaphoreTake( xMutexB, portMAX_DELAY ) == pdPASS );
+        configASSERT( xSemaphoreTake( xMutexA, portMAX_DELAY ) == pdPASS );
+        prvWork( benchMID_WORK_US );
+        configASSERT( xSemaphoreGive( xMutexA ) == pdPASS );
+        configASSERT( xSemaphoreGive( xMutexB ) == pdPASS );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainHighTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        configASSERT( xSemaphoreTake( xMutexB, portMAX_DELAY ) == pdPASS );
+        prvRecordWait();
+        configASSERT( xSemaphoreGive( xMutexB ) == pdPASS );
+        xTaskNotifyGive( xControlTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvNestedLowTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        configASSERT( xSemaphoreTake( xMutexA, portMAX_DELAY ) == pdPASS );
+        configASSERT( xSemaphoreTake( xMutexB, portMAX_DELAY ) == pdPASS );
+        xTaskNotifyGive( xControlTask );
+        prvWork( benchLOW_WORK_US );
+        configASSERT( xSemaphoreGive( xMutexB ) == pdPASS );
+        prvWork( benchLOW_TAIL_WORK_US );
+        configASSERT( xSemaphoreGive( xMutexA ) == pdPASS );
+        xTaskNotifyGive( xControlTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvNestedHighTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        configASSERT( xSemaphoreTake( xMutexB, portMAX_DELAY ) == pdPASS );
+        configASSERT( xSemaphoreGive( xMutexB ) == pdPASS );
+
+        /* The hog's wait starts now it is ready to run. */
+        ullWaitStartUs = prvMicroseconds( CLOCK_MONOTONIC );
+        xTaskNotifyGive( xHogTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvHogTask( void * pvParameters )
+{
+    const BaseType_t xMeasured = ( BaseType_t ) ( uintptr_t ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        if( xMeasured != pdFALSE )
+        {
+            prvRecordWait();
+        }
+
+        prvWork( benchHOG_WORK_US );
+        xTaskNotifyGive( xControlTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForNotifications( uint32_t ulCount )
+{
+    while( ulCount > 0UL )
+    {
+        ulCount -= ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    unsigned long ulRound;
+
+    ( void ) pvParameters;
+
+    xMutexA = xSemaphoreCreateMutex();
+    xMutexB = xSemaphoreCreateMutex();
+    configASSERT( ( xMutexA != NULL ) && ( xMutexB != NULL ) );
+
+    /* High waits for Mid, which waits for Low, while Hog is ready. */
+    configASSERT( xTaskCreate( prvChainLowTask, "Low", configMINIMAL_STACK_SIZE, NULL, benchLOW_PRIORITY, &xLowTask ) == pdPASS );
+    configASSERT( xTaskCreate( prvChainMidTask, "Mid", configMINIMAL_STACK_SIZE, NULL, benchMID_PRIORITY, &xMidTask ) == pdPASS );
+    configASSERT( xTaskCreate( prvHogTask, "Hog", configMINIMAL_STACK_SIZE, ( void * ) pdFALSE, benchHOG_PRIORITY, &xHogTask ) == pdPASS );
+    configASSERT( xTaskCreate( prvChainHighTask, "High", configMINIMAL_STACK_SIZE, NULL, benchHIGH_PRIORITY, &xHighTask ) == pdPASS );
+    prvResetLatency();
+
+    for( ulRound = 0; ulRound < ulRounds; ulRound++ )
+    {
+        /* Low takes A and starts working. */
+        xTaskNotifyGive( xLowTask );
+        prvWaitForNotifications( 1 );
+
+        /* Mid takes B and blocks on A. */
+        xTaskNotifyGive( xMidTask );
+
+        while( xSemaphoreGetMutexHolder( xMutexB ) != xMidTask )
+        {
+            vTaskDelay( 1 );
+        }
+
+        /* High blocks on B, and Hog becomes ready. */
+        ullWaitStartUs = prvMicroseconds( CLOCK_MONOTONIC );
+        xTaskNotifyGive( xHogTask );
+        xTaskNotifyGive( xHighTask );
+        prvWaitForNotifications( 2 );
+    }
+
+    prvReport( "chain", "High" );
+
+    vTaskSuspend( xLowTask );
+    vTaskSuspend( xMidTask );
+    vTaskSuspend( xHogTask );
+    vTaskSuspend( xHighTask );
+
+    /* Low holds A and B, High waits for B, then Hog becomes ready. */
+    configASSERT( xTaskCreate( prvNestedLowTask, "Low", configMINIMAL_STACK_SIZE, NULL, benchLOW_PRIORITY, &xLowTask ) == pdPASS );
+    configASSERT( xTaskCreate( prvHogTask, "Hog", configMINIMAL_STACK_SIZE, ( void * ) pdTRUE, benchHOG_PRIORITY, &xHogTask ) == pdPASS );
+    configASSERT( xTaskCreate( prvNestedHighTask, "High", configMINIMAL_STACK_SIZE, NULL, benchHIGH_PRIORITY, &xHighTask ) == pdPASS );
+    prvResetLatency();
+
+    for( ulRound = 0; ulRound < ulRounds; ulRound++ )
+    {
+        /* Low takes A and B and starts working, then High blocks on B. */
+        xTaskNotifyGive( xLowTask );
+        prvWaitForNotifications( 1 );
+        xTaskNotifyGive( xHighTask );
+
+        /* Hog finishing, and Low giving back A. */
+        prvWaitForNotifications( 2 );
+    }
+
+    prvReport( "nested", "Hog" );
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    ulRounds = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 50UL;
+    configASSERT( ulRounds > 0 );
+
+    configASSERT( xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, &xControlTask ) == pdPASS );
+
+    /* Returns once the control task ends the scheduler. */
+    vTaskStartScheduler();
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
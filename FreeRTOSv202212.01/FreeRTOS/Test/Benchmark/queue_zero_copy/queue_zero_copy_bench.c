@@ -0,0 +1,293 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of passing an item through a queue, with and without the
+ * zero copy API (configUSE_QUEUE_ZERO_COPY).
+ *
+ * Usage: queue_zero_copy_bench_<method> <item size in bytes>
+ *
+ * A task is created and selected as the running task, and on its behalf items
+ * are repeatedly produced into, and consumed from, a short queue.  Producing
+ * an item fills every byte of it and consuming it sums every byte.  The copy
+ * method writes the item into a local buffer that xQueueSend() copies into the
+ * queue, and xQueueReceive() copies it out into a second local buffer before
+ * it is summed.  The zero_copy method writes the item directly into a slot
+ * acquired from the queue and sums it directly from a borrowed slot.
+ *
+ * The zero_copy method first checks the lent slots are kept in order with
+ * items sent and received by copy, that the queue refuses sends and receives
+ * that would use a lent slot, and that committing a slot notifies a queue set.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#define benchITERATIONS       ( 1000000UL )
+#define benchQUEUE_LENGTH     ( 4 )
+#define benchMAX_ITEM_SIZE    ( 8192UL )
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    #define benchMETHOD_NAME    "zero_copy"
+#else
+    #define benchMETHOD_NAME    "copy"
+#endif
+
+/*-----------------------------------------------------------*/
+
+static uint8_t ucSendBuffer[ benchMAX_ITEM_SIZE ];
+
+#if ( configUSE_QUEUE_ZERO_COPY == 0 )
+    static uint8_t ucReceiveBuffer[ benchMAX_ITEM_SIZE ];
+#endif
+
+/* Sum of every byte consumed, so consuming cannot be optimised away, and the
+ * number of items that were not received in the order they were sent. */
+static uint32_t ulSum = 0, ulOutOfOrder = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    /* Never executes. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProduce( uint8_t * pucItem,
+                        size_t xItemSize,
+                        uint32_t ulSequence )
+{
+    /* Stands in for the application building a message. */
+    memset( pucItem, ( int ) ( ulSequence & 0xffUL ), xItemSize );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsume( const uint8_t * pucItem,
+                        size_t xItemSize,
+                        uint32_t ulSequence )
+{
+    if( pucItem[ 0 ] != ( uint8_t ) ulSequence )
+    {
+        ulOutOfOrder++;
+    }
+
+    for( size_t x = 0; x < xItemSize; x++ )
+    {
+        ulSum += pucItem[ x ];
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static void prvCheckLentSlots( void )
+    {
+        QueueHandle_t xQueue;
+        QueueSetHandle_t xQueueSet;
+        uint32_t *pulSlot, ulValue;
+
+        xQueue = xQueueCreate( 3, sizeof( uint32_t ) );
+        configASSERT( xQueue != NULL );
+
+        /* Items written in place are received in order with items sent by
+         * copy, whichever way they are received. */
+        ulValue = 1;
+        configASSERT( xQueueSend( xQueue, &ulValue, 0 ) == pdPASS );
+        pulSlot = pvQueueAcquireSendSlot( xQueue, 0 );
+        configASSERT( pulSlot != NULL );
+        *pulSlot = 2;
+
+        /* Only one send slot can be lent, and while it is lent a send to the
+         * back of the queue would overwrite it. */
+        configASSERT( pvQueueAcquireSendSlot( xQueue, 0 ) == NULL );
+        configASSERT( xQueueSend( xQueue, &ulValue, 0 ) == errQUEUE_FULL );
+        configASSERT( uxQueueSpacesAvailable( xQueue ) == 1 );
+        configASSERT( uxQueueMessagesWaiting( xQueue ) == 1 );
+
+        /* A send to the front does not touch the lent slot. */
+        ulValue = 0;
+        configASSERT( xQueueSendToFront( xQueue, &ulValue, 0 ) == pdPASS );
+        configASSERT( xQueueIsQueueFullFromISR( xQueue ) == pdTRUE );
+        vQueueCommitSendSlot( xQueue );
+        configASSERT( uxQueueMessagesWaiting( xQueue ) == 3 );
+
+        configASSERT( xQueueReceive( xQueue, &ulValue, 0 ) == pdPASS );
+        configASSERT( ulValue == 0 );
+        pulSlot = pvQueueBorrowReceiveSlot( xQueue, 0 );
+        configASSERT( ( pulSlot != NULL ) && ( *pulSlot == 1 ) );
+
+        /* While the slot is borrowed the queue appears empty to receivers and
+         * the borrowed slot cannot be reused. */
+        configASSERT( pvQueueBorrowReceiveSlot( xQueue, 0 ) == NULL );
+        configASSERT( xQueueReceive( xQueue, &ulValue, 0 ) == errQUEUE_EMPTY );
+        configASSERT( xQueuePeek( xQueue, &ulValue, 0 ) == pdPASS );
+        configASSERT( ulValue == 2 );
+        configASSERT( xQueueSendToFront( xQueue, &ulValue, 0 ) == errQUEUE_FULL );
+        configASSERT( uxQueueSpacesAvailable( xQueue ) == 1 );
+
+        /* Both a send slot and a receive slot can be lent at once. */
+        pulSlot = pvQueueAcquireSendSlot( xQueue, 0 );
+        configASSERT( pulSlot != NULL );
+        *pulSlot = 3;
+        configASSERT( uxQueueSpacesAvailable( xQueue ) == 0 );
+        vQueueReleaseReceiveSlot( xQueue );
+        vQueueCommitSendSlot( xQueue );
+
+        pulSlot = pvQueueBorrowReceiveSlot( xQueue, 0 );
+        configASSERT( ( pulSlot != NULL ) && ( *pulSlot == 2 ) );
+        vQueueReleaseReceiveSlot( xQueue );
+        configASSERT( xQueueReceive( xQueue, &ulValue, 0 ) == pdPASS );
+        configASSERT( ulValue == 3 );
+        configASSERT( pvQueueBorrowReceiveSlot( xQueue, 0 ) == NULL );
+        configASSERT( uxQueueSpacesAvailable( xQueue ) == 3 );
+
+        /* Committing a slot notifies a queue set the queue is a member of. */
+        xQueueSet = xQueueCreateSet( 3 );
+        configASSERT( xQueueSet != NULL );
+        configASSERT( xQueueAddToSet( xQueue, xQueueSet ) == pdPASS );
+        configASSERT( xQueueSelectFromSet( xQueueSet, 0 ) == NULL );
+
+        pulSlot = pvQueueAcquireSendSlot( xQueue, 0 );
+        configASSERT( pulSlot != NULL );
+        *pulSlot = 4;
+        configASSERT( xQueueSelectFromSet( xQueueSet, 0 ) == NULL );
+        vQueueCommitSendSlot( xQueue );
+        configASSERT( xQueueSelectFromSet( xQueueSet, 0 ) == xQueue );
+
+        pulSlot = pvQueueBorrowReceiveSlot( xQueue, 0 );
+        configASSERT( ( pulSlot != NULL ) && ( *pulSlot == 4 ) );
+        vQueueReleaseReceiveSlot( xQueue );
+
+        configASSERT( xQueueRemoveFromSet( xQueue, xQueueSet ) == pdPASS );
+        vQueueDelete( xQueueSet );
+        vQueueDelete( xQueue );
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    TaskHandle_t xTask;
+    QueueHandle_t xQueue;
+    unsigned long ulIteration, ulItemSize, ulReceived;
+    uint64_t ullStart, ullTime;
+
+    ulItemSize = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 256;
+    configASSERT( ( ulItemSize > 0 ) && ( ulItemSize <= benchMAX_ITEM_SIZE ) );
+
+    /* Returns with the idle task selected as the running task. */
+    vTaskStartScheduler();
+
+    /* Creating a task with a priority above the idle task selects it as the
+     * running task, so the queue is used on its behalf. */
+    configASSERT( xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTask ) == pdPASS );
+    configASSERT( xTaskGetCurrentTaskHandle() == xTask );
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    {
+        prvCheckLentSlots();
+    }
+    #endif
+
+    xQueue = xQueueCreate( benchQUEUE_LENGTH, ulItemSize );
+    configASSERT( xQueue != NULL );
+
+    /* Keep the queue partly full so the read and write positions wrap, and
+     * so each item received was sent a number of iterations earlier. */
+    for( ulIteration = 0; ulIteration < ( benchQUEUE_LENGTH / 2 ); ulIteration++ )
+    {
+        prvProduce( ucSendBuffer, ulItemSize, ulIteration );
+        configASSERT( xQueueSend( xQueue, ucSendBuffer, 0 ) == pdPASS );
+    }
+
+    ulReceived = 0;
+
+    ullStart = prvNanoseconds();
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        {
+            uint8_t * pucSlot;
+
+            pucSlot = pvQueueAcquireSendSlot( xQueue, 0 );
+            configASSERT( pucSlot != NULL );
+            prvProduce( pucSlot, ulItemSize, ulIteration + ( benchQUEUE_LENGTH / 2 ) );
+            vQueueCommitSendSlot( xQueue );
+
+            pucSlot = pvQueueBorrowReceiveSlot( xQueue, 0 );
+            configASSERT( pucSlot != NULL );
+            prvConsume( pucSlot, ulItemSize, ulReceived++ );
+            vQueueReleaseReceiveSlot( xQueue );
+        }
+        #else
+        {
+            prvProduce( ucSendBuffer, ulItemSize, ulIteration + ( benchQUEUE_LENGTH / 2 ) );
+            configASSERT( xQueueSend( xQueue, ucSendBuffer, 0 ) == pdPASS );
+
+            configASSERT( xQueueReceive( xQueue, ucReceiveBuffer, 0 ) == pdPASS );
+            prvConsume( ucReceiveBuffer, ulItemSize, ulReceived++ );
+        }
+        #endif
+    }
+
+    ullTime = prvNanoseconds() - ullStart;
+
+    printf( "%-9s item %5lu bytes  send+receive %8.1f ns  (checksum %08lx)\r\n", benchMETHOD_NAME, ulItemSize, ( double ) ullTime / ( double ) benchITERATIONS, ( unsigned long ) ulSum );
+
+    if( ulOutOfOrder != 0 )
+    {
+        printf( "FAIL: items were corrupted or reordered in the queue\r\n" );
+        return EXIT_FAILURE;
+    }
+
+    vQueueDelete( xQueue );
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,287 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the overhead of configUSE_RUN_TIME_ACCOUNTING on the Posix port,
+ * and checks that the run time it reports adds up.
+ *
+ * Usage: run_time_accounting_bench_<method> <operations>
+ *
+ * critical:  taskENTER_CRITICAL()/taskEXIT_CRITICAL() pairs, which sample the
+ *            run time clock twice each with accounting.
+ * yield:     two tasks of the same priority call taskYIELD() in turn.
+ * breakdown: a task that spins and a task that spins inside critical sections
+ *            run for half a second.  With accounting the critical sections are
+ *            charged to the kernel and the tick to interrupt 0, and the task,
+ *            kernel and interrupt run times must sum exactly to the total.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+    #define benchMETHOD_NAME    "accounting"
+#else
+    #define benchMETHOD_NAME    "stats"
+#endif
+
+/* The number of tasks the breakdown reports on: control, two workers, two
+ * yield tasks and idle. */
+#define benchMAX_TASKS        ( 8 )
+
+/* How long the breakdown workers run. */
+#define benchBREAKDOWN_MS     ( 500 )
+
+/* How long the critical worker spins inside each critical section. */
+#define benchCRITICAL_NS      ( 2000ULL )
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulOperations;
+static volatile unsigned long ulYieldsDone;
+static TaskHandle_t xControlTask;
+static TaskHandle_t xSpinTask;
+static TaskHandle_t xCriticalTask;
+static volatile uint32_t ulSpinLoops;
+static unsigned long long ullClockOrigin;
+
+/*-----------------------------------------------------------*/
+
+/* The run time clock, in nanoseconds since main() started as the plain run
+ * time stats expect the clock to start from zero. */
+unsigned long long ullBenchGetRunTime( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( unsigned long long ) xTime.tv_sec * 1000000000ULL ) + ( unsigned long long ) xTime.tv_nsec - ullClockOrigin;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( const char * pcTest,
+                       unsigned long long ullWallNs )
+{
+    printf( "%-10s %-9s %8lu ops  %8.1f ns/op\r\n",
+            benchMETHOD_NAME, pcTest, ulOperations,
+            ( double ) ullWallNs / ( double ) ulOperations );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    /* The two tasks take turns, so between them they yield ulOperations
+     * times. */
+    while( ulYieldsDone < ulOperations )
+    {
+        ulYieldsDone++;
+        taskYIELD();
+    }
+
+    xTaskNotifyGive( xControlTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpinTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ulSpinLoops++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCriticalTask( void * pvParameters )
+{
+    unsigned long long ullStart;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            ullStart = ullBenchGetRunTime();
+
+            while( ( ullBenchGetRunTime() - ullStart ) < benchCRITICAL_NS )
+            {
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static double prvMs( configRUN_TIME_COUNTER_TYPE ulNs )
+{
+    return ( double ) ulNs / 1000000.0;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RUN_TIME_ACCOUNTING == 1 )
+
+    static void prvBreakdown( void )
+    {
+        static TaskRunTime_t xRunTimes[ benchMAX_TASKS ];
+        RunTimeTotals_t xBefore, xAfter;
+        configRUN_TIME_COUNTER_TYPE ulTaskSum = 0;
+        TickType_t xStartTicks;
+        UBaseType_t uxTasks, ux;
+        unsigned long long ullStart, ullSnapshotNs;
+
+        ( void ) uxTaskGetRunTimeSnapshot( NULL, 0, &xBefore );
+        xStartTicks = xTaskGetTickCount();
+
+        vTaskResume( xSpinTask );
+        vTaskResume( xCriticalTask );
+        vTaskDelay( pdMS_TO_TICKS( benchBREAKDOWN_MS ) );
+        vTaskSuspend( xSpinTask );
+        vTaskSuspend( xCriticalTask );
+
+        ullStart = ullBenchGetRunTime();
+        uxTasks = uxTaskGetRunTimeSnapshot( xRunTimes, benchMAX_TASKS, &xAfter );
+        ullSnapshotNs = ullBenchGetRunTime() - ullStart;
+        configASSERT( uxTasks == uxTaskGetNumberOfTasks() );
+
+        for( ux = 0; ux < uxTasks; ux++ )
+        {
+            ulTaskSum += xRunTimes[ ux ].ulRunTimeCounter;
+            printf( "%-10s task %-7s %9.2f ms\r\n", benchMETHOD_NAME,
+                    pcTaskGetName( xRunTimes[ ux ].xHandle ),
+                    prvMs( xRunTimes[ ux ].ulRunTimeCounter ) );
+        }
+
+        printf( "%-10s kernel       %9.2f ms (%.2f ms in the last %d ms)\r\n", benchMETHOD_NAME,
+                prvMs( xAfter.ulKernelRunTime ), prvMs( xAfter.ulKernelRunTime - xBefore.ulKernelRunTime ), benchBREAKDOWN_MS );
+        printf( "%-10s tick ISR     %9.2f ms (%.0f ns/tick)\r\n", benchMETHOD_NAME,
+                prvMs( xAfter.ulISRRunTime[ 0 ] ),
+                ( double ) ( xAfter.ulISRRunTime[ 0 ] - xBefore.ulISRRunTime[ 0 ] ) / ( double ) ( xTaskGetTickCount() - xStartTicks ) );
+        printf( "%-10s idle         %9.2f ms\r\n", benchMETHOD_NAME, prvMs( xAfter.ulIdleRunTime ) );
+        printf( "%-10s total        %9.2f ms, tasks + kernel + ISR %9.2f ms, snapshot %llu ns\r\n", benchMETHOD_NAME,
+                prvMs( xAfter.ulTotalRunTime ),
+                prvMs( ulTaskSum + xAfter.ulKernelRunTime + xAfter.ulISRRunTime[ 0 ] ),
+                ullSnapshotNs );
+
+        /* Every nanosecond is charged to exactly one place. */
+        if( ( ulTaskSum + xAfter.ulKernelRunTime + xAfter.ulISRRunTime[ 0 ] ) != xAfter.ulTotalRunTime )
+        {
+            printf( "FAILED: run times do not sum to the total\r\n" );
+            exit( EXIT_FAILURE );
+        }
+    }
+
+#else /* if ( configUSE_RUN_TIME_ACCOUNTING == 1 ) */
+
+    static void prvBreakdown( void )
+    {
+        static TaskStatus_t xStatus[ benchMAX_TASKS ];
+        UBaseType_t uxTasks, ux;
+
+        vTaskResume( xSpinTask );
+        vTaskResume( xCriticalTask );
+        vTaskDelay( pdMS_TO_TICKS( benchBREAKDOWN_MS ) );
+        vTaskSuspend( xSpinTask );
+        vTaskSuspend( xCriticalTask );
+
+        /* Without accounting critical sections and the tick are charged to
+         * whichever task they interrupted. */
+        uxTasks = uxTaskGetSystemState( xStatus, benchMAX_TASKS, NULL );
+
+        for( ux = 0; ux < uxTasks; ux++ )
+        {
+            printf( "%-10s task %-7s %9.2f ms\r\n", benchMETHOD_NAME,
+                    xStatus[ ux ].pcTaskName, prvMs( xStatus[ ux ].ulRunTimeCounter ) );
+        }
+    }
+
+#endif /* if ( configUSE_RUN_TIME_ACCOUNTING == 1 ) */
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    unsigned long long ullStart;
+    unsigned long ulOperation;
+
+    ( void ) pvParameters;
+
+    /* Critical sections entered and exited from a task. */
+    ullStart = ullBenchGetRunTime();
+
+    for( ulOperation = 0; ulOperation < ulOperations; ulOperation++ )
+    {
+        taskENTER_CRITICAL();
+        taskEXIT_CRITICAL();
+    }
+
+    prvReport( "critical", ullBenchGetRunTime() - ullStart );
+
+    /* Two tasks of the same priority yielding to each other. */
+    ullStart = ullBenchGetRunTime();
+    configASSERT( xTaskCreate( prvYieldTask, "YieldA", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+    configASSERT( xTaskCreate( prvYieldTask, "YieldB", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    prvReport( "yield", ullBenchGetRunTime() - ullStart );
+
+    /* Where the run time goes while one task spins and another spins inside
+     * critical sections. */
+    configASSERT( xTaskCreate( prvSpinTask, "Spin", configMINIMAL_STACK_SIZE, NULL, 1, &xSpinTask ) == pdPASS );
+    configASSERT( xTaskCreate( prvCriticalTask, "Crit", configMINIMAL_STACK_SIZE, NULL, 1, &xCriticalTask ) == pdPASS );
+    vTaskSuspend( xSpinTask );
+    vTaskSuspend( xCriticalTask );
+    prvBreakdown();
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    ullClockOrigin = ullBenchGetRunTime();
+    ulOperations = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 200000UL;
+    configASSERT( ulOperations > 1 );
+
+    configASSERT( xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControlTask ) == pdPASS );
+
+    /* Returns once the control task ends the scheduler. */
+    vTaskStartScheduler();
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
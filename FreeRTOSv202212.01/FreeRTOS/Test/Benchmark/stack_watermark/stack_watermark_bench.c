@@ -0,0 +1,157 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Measures the cost of uxTaskGetStackHighWaterMark2() on stacks of different
+ * depths and with different amounts of the stack used.
+ *
+ * Usage: stack_watermark_bench <stack depth in words> <percentage used>
+ *
+ * A task is created but never runs, so the bench marks the given percentage of
+ * the top of its stack as used by overwriting the fill value.  The time taken by
+ * uxTaskGetStackHighWaterMark2() is compared with counting the unused stack a
+ * byte at a time, as the kernel did before it compared whole stack words, and
+ * the two results are checked to be the same.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchITERATIONS      ( 2000UL )
+#define benchMAX_DEPTH       ( 1024UL * 1024UL )
+
+/* The value the kernel fills new stacks with. */
+#define benchSTACK_FILL_BYTE ( 0xa5U )
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    /* Never executes. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static configSTACK_DEPTH_TYPE prvCountFreeStackBytewise( const StackType_t * pxStackBase )
+{
+    const uint8_t * pucStackByte = ( const uint8_t * ) pxStackBase;
+    uint32_t ulCount = 0U;
+
+    /* The stack grows down on this port, so the unused part of the stack
+     * starts at the lowest address. */
+    while( *pucStackByte == ( uint8_t ) benchSTACK_FILL_BYTE )
+    {
+        pucStackByte++;
+        ulCount++;
+    }
+
+    return ( configSTACK_DEPTH_TYPE ) ( ulCount / sizeof( StackType_t ) );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    TaskHandle_t xTask = NULL;
+    TaskStatus_t xStatus;
+    unsigned long ulDepth, ulUsedPercent, ulUsedWords, ulIteration;
+    configSTACK_DEPTH_TYPE uxByteResult = 0, uxWordResult = 0;
+    uint64_t ullStart, ullByteTime, ullWordTime;
+
+    ulDepth = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 4096;
+    ulUsedPercent = ( argc > 2 ) ? strtoul( argv[ 2 ], NULL, 10 ) : 50;
+    configASSERT( ( ulDepth >= configMINIMAL_STACK_SIZE ) && ( ulDepth <= benchMAX_DEPTH ) );
+    configASSERT( ulUsedPercent < 100 );
+
+    /* Returns with the idle task selected as the running task. */
+    vTaskStartScheduler();
+
+    configASSERT( xTaskCreate( prvBenchTask, "Bench", ( configSTACK_DEPTH_TYPE ) ulDepth, NULL, tskIDLE_PRIORITY, &xTask ) == pdPASS );
+    vTaskGetInfo( xTask, &xStatus, pdFALSE, eReady );
+
+    /* Mark the top of the stack as used.  The word that ends the used part
+     * only has its top byte changed, so the count has to finish a byte at a
+     * time. */
+    ulUsedWords = ( ulDepth * ulUsedPercent ) / 100UL;
+
+    if( ulUsedWords > 0UL )
+    {
+        memset( &( xStatus.pxStackBase[ ulDepth - ulUsedWords ] ), 0, ( size_t ) ulUsedWords * sizeof( StackType_t ) );
+        ( ( uint8_t * ) &( xStatus.pxStackBase[ ulDepth - ulUsedWords - 1UL ] ) )[ sizeof( StackType_t ) - 1U ] = 0;
+    }
+
+    ullStart = prvNanoseconds();
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        uxByteResult = prvCountFreeStackBytewise( xStatus.pxStackBase );
+
+        /* Stop the compiler calling the function once for all iterations. */
+        __asm volatile ( "" ::: "memory" );
+    }
+
+    ullByteTime = prvNanoseconds() - ullStart;
+    ullStart = prvNanoseconds();
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        uxWordResult = uxTaskGetStackHighWaterMark2( xTask );
+    }
+
+    ullWordTime = prvNanoseconds() - ullStart;
+
+    configASSERT( uxByteResult == uxWordResult );
+
+    printf( "stack %7lu words  used %2lu%%  high water mark %7lu  byte scan %9.2f us  word scan %9.2f us  (%.1fx)\r\n",
+            ulDepth, ulUsedPercent, ( unsigned long ) uxWordResult,
+            ( double ) ullByteTime / ( double ) benchITERATIONS / 1000.0,
+            ( double ) ullWordTime / ( double ) benchITERATIONS / 1000.0,
+            ( double ) ullByteTime / ( double ) ullWordTime );
+
+    vTaskDelete( xTask );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
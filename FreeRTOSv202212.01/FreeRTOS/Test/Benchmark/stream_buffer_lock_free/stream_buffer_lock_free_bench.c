@@ -0,0 +1,264 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of sending to and receiving from a stream buffer with and
+ * without configUSE_STREAM_BUFFER_LOCK_FREE.
+ *
+ * Usage: stream_buffer_lock_free_bench_<method> <chunk size in bytes>
+ *
+ * A task is created and selected as the running task, and on its behalf
+ * chunks are repeatedly sent to, then received from, a stream buffer.  Without
+ * the lock free mode each send and receive suspends and resumes the scheduler
+ * to check for a task to notify, and resuming the scheduler enters a critical
+ * section.  The critical sections entered per send+receive are counted, as the
+ * benchmark port's critical sections cost nothing on the host but would each
+ * mask interrupts on a real port.
+ *
+ * The lock_free method then streams a sequence of bytes from one thread to
+ * another through a stream buffer, as a writer and a reader on different cores
+ * would, and checks every byte arrives in order.
+ */
+
+/* Standard includes. */
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#define benchITERATIONS          ( 10000000UL )
+#define benchMAX_CHUNK_SIZE      ( 1024UL )
+#define benchSTREAM_BYTES        ( 4UL * 1024UL * 1024UL )
+#define benchSTREAM_BUFFER_SIZE  ( 4096UL )
+
+#if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    #define benchMETHOD_NAME    "lock_free"
+#else
+    #define benchMETHOD_NAME    "locked"
+#endif
+
+/*-----------------------------------------------------------*/
+
+volatile unsigned long ulCriticalSections = 0;
+
+static uint8_t ucSendBuffer[ benchMAX_CHUNK_SIZE ];
+static uint8_t ucReceiveBuffer[ benchMAX_CHUNK_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    /* Never executes. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+
+    typedef struct StreamParameters
+    {
+        StreamBufferHandle_t xStreamBuffer;
+        size_t xChunkSize;
+        unsigned long ulErrors;
+    } StreamParameters_t;
+
+    static void * prvWriterThread( void * pvParameters )
+    {
+        StreamParameters_t * pxParameters = pvParameters;
+        uint8_t ucChunk[ benchMAX_CHUNK_SIZE ];
+        unsigned long ulSent = 0, ulSentThisTime;
+        size_t x, xChunk;
+
+        while( ulSent < benchSTREAM_BYTES )
+        {
+            xChunk = configMIN( pxParameters->xChunkSize, benchSTREAM_BYTES - ulSent );
+
+            for( x = 0; x < xChunk; x++ )
+            {
+                ucChunk[ x ] = ( uint8_t ) ( ulSent + x );
+            }
+
+            /* Spin until all of the chunk is sent. */
+            x = 0;
+
+            while( x < xChunk )
+            {
+                ulSentThisTime = xStreamBufferSend( pxParameters->xStreamBuffer, &( ucChunk[ x ] ), xChunk - x, 0 );
+                x += ulSentThisTime;
+
+                if( ulSentThisTime == 0 )
+                {
+                    /* Let the reader run if both threads share a core. */
+                    sched_yield();
+                }
+            }
+
+            ulSent += xChunk;
+        }
+
+        return NULL;
+    }
+
+    static void * prvReaderThread( void * pvParameters )
+    {
+        StreamParameters_t * pxParameters = pvParameters;
+        uint8_t ucChunk[ benchMAX_CHUNK_SIZE ];
+        unsigned long ulReceived = 0;
+        size_t x, xReceived;
+
+        while( ulReceived < benchSTREAM_BYTES )
+        {
+            xReceived = xStreamBufferReceive( pxParameters->xStreamBuffer, ucChunk, pxParameters->xChunkSize, 0 );
+
+            if( xReceived == 0 )
+            {
+                /* Let the writer run if both threads share a core. */
+                sched_yield();
+            }
+
+            for( x = 0; x < xReceived; x++ )
+            {
+                if( ucChunk[ x ] != ( uint8_t ) ( ulReceived + x ) )
+                {
+                    pxParameters->ulErrors++;
+                }
+            }
+
+            ulReceived += xReceived;
+        }
+
+        return NULL;
+    }
+
+    static BaseType_t prvStreamBetweenThreads( size_t xChunkSize )
+    {
+        StreamParameters_t xParameters;
+        pthread_t xWriter, xReader;
+        uint64_t ullStart, ullTime;
+
+        xParameters.xStreamBuffer = xStreamBufferCreate( benchSTREAM_BUFFER_SIZE, 1 );
+        xParameters.xChunkSize = xChunkSize;
+        xParameters.ulErrors = 0;
+        configASSERT( xParameters.xStreamBuffer != NULL );
+
+        ullStart = prvNanoseconds();
+
+        configASSERT( pthread_create( &xReader, NULL, prvReaderThread, &xParameters ) == 0 );
+        configASSERT( pthread_create( &xWriter, NULL, prvWriterThread, &xParameters ) == 0 );
+        configASSERT( pthread_join( xWriter, NULL ) == 0 );
+        configASSERT( pthread_join( xReader, NULL ) == 0 );
+
+        ullTime = prvNanoseconds() - ullStart;
+
+        printf( "%-9s chunk %4lu bytes  two threads %8.1f MB/s\r\n", benchMETHOD_NAME, ( unsigned long ) xChunkSize, ( double ) benchSTREAM_BYTES * 1000.0 / ( double ) ullTime );
+
+        vStreamBufferDelete( xParameters.xStreamBuffer );
+
+        return ( xParameters.ulErrors == 0 ) ? pdPASS : pdFAIL;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_LOCK_FREE */
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    TaskHandle_t xTask;
+    StreamBufferHandle_t xStreamBuffer;
+    unsigned long ulIteration, ulChunkSize, ulErrors = 0;
+    uint64_t ullStart, ullTime;
+
+    ulChunkSize = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 16;
+    configASSERT( ( ulChunkSize > 0 ) && ( ulChunkSize <= benchMAX_CHUNK_SIZE ) );
+
+    /* Returns with the idle task selected as the running task. */
+    vTaskStartScheduler();
+
+    /* Creating a task with a priority above the idle task selects it as the
+     * running task, so the stream buffer is used on its behalf. */
+    configASSERT( xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTask ) == pdPASS );
+    configASSERT( xTaskGetCurrentTaskHandle() == xTask );
+
+    xStreamBuffer = xStreamBufferCreate( benchSTREAM_BUFFER_SIZE, 1 );
+    configASSERT( xStreamBuffer != NULL );
+
+    ulCriticalSections = 0;
+    ullStart = prvNanoseconds();
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ucSendBuffer[ 0 ] = ( uint8_t ) ulIteration;
+        configASSERT( xStreamBufferSend( xStreamBuffer, ucSendBuffer, ulChunkSize, 0 ) == ulChunkSize );
+        configASSERT( xStreamBufferReceive( xStreamBuffer, ucReceiveBuffer, ulChunkSize, 0 ) == ulChunkSize );
+
+        if( ucReceiveBuffer[ 0 ] != ( uint8_t ) ulIteration )
+        {
+            ulErrors++;
+        }
+    }
+
+    ullTime = prvNanoseconds() - ullStart;
+
+    printf( "%-9s chunk %4lu bytes  send+receive %6.1f ns  critical sections %.1f\r\n", benchMETHOD_NAME, ulChunkSize, ( double ) ullTime / ( double ) benchITERATIONS, ( double ) ulCriticalSections / ( double ) benchITERATIONS );
+
+    vStreamBufferDelete( xStreamBuffer );
+
+    #if ( configUSE_STREAM_BUFFER_LOCK_FREE == 1 )
+    {
+        if( prvStreamBetweenThreads( ulChunkSize ) != pdPASS )
+        {
+            ulErrors++;
+        }
+    }
+    #endif
+
+    if( ulErrors != 0 )
+    {
+        printf( "FAIL: bytes were corrupted or reordered in the stream buffer\r\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,335 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of passing data through a stream buffer when the data is
+ * copied in and out with xStreamBufferSend()/xStreamBufferReceive(), and when
+ * it is written and read in place using xStreamBufferSendReserve(),
+ * xStreamBufferSendCommit(), xStreamBufferReceiveAcquire() and
+ * xStreamBufferReceiveRelease().
+ *
+ * Usage: stream_buffer_spans_bench <copy|in_place> <chunk size in bytes>
+ *
+ * A task is created and selected as the running task, and on its behalf
+ * chunks of data are repeatedly produced into, and consumed from, a stream
+ * buffer that is not a multiple of the chunk size, so chunks regularly wrap
+ * around the end of the storage area.  Producing a chunk fills every byte of
+ * it, as a DMA transfer into the buffer would, and consuming it checks its
+ * first and last bytes.  The copy method produces into, and
+ * consumes from, local buffers - as a driver without the span API would need
+ * to - and the in_place method produces into, and consumes from, the spans.
+ *
+ * The span API is first checked to describe wrapped free space and data
+ * correctly, and to interleave with messages sent and received by copy in a
+ * message buffer.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+
+#define benchBYTES              ( 256UL * 1024UL * 1024UL )
+#define benchMAX_CHUNK_SIZE     ( 8192UL )
+
+/*-----------------------------------------------------------*/
+
+static uint8_t ucSendBuffer[ benchMAX_CHUNK_SIZE ];
+static uint8_t ucReceiveBuffer[ benchMAX_CHUNK_SIZE ];
+
+/* Sum of the bytes consumed, so consuming cannot be optimised away, and the
+ * number of chunks that were not received in the order they were sent. */
+static uint32_t ulSum = 0, ulOutOfOrder = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    /* Never executes. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsume( uint8_t ucFirst,
+                        uint8_t ucLast,
+                        uint32_t ulSequence )
+{
+    /* Stands in for handing the data on, for example to a DMA transfer, so
+     * only the first and last bytes are touched. */
+    if( ( ucFirst != ( uint8_t ) ulSequence ) || ( ucLast != ( uint8_t ) ulSequence ) )
+    {
+        ulOutOfOrder++;
+    }
+
+    ulSum += ( uint32_t ) ucFirst + ( uint32_t ) ucLast;
+}
+/*-----------------------------------------------------------*/
+
+/* Copy xLength bytes into, or out of, the spans, span 0 first. */
+static void prvCopyToSpans( const StreamBufferSpans_t * pxSpans,
+                            const uint8_t * pucData,
+                            size_t xLength )
+{
+    size_t xFirst = configMIN( xLength, pxSpans->xSpanLength[ 0 ] );
+
+    memcpy( pxSpans->pucSpan[ 0 ], pucData, xFirst );
+    configASSERT( ( xLength - xFirst ) <= pxSpans->xSpanLength[ 1 ] );
+    memcpy( pxSpans->pucSpan[ 1 ], &( pucData[ xFirst ] ), xLength - xFirst );
+}
+
+static void prvCopyFromSpans( const StreamBufferSpans_t * pxSpans,
+                              uint8_t * pucData,
+                              size_t xLength )
+{
+    size_t xFirst = configMIN( xLength, pxSpans->xSpanLength[ 0 ] );
+
+    memcpy( pucData, pxSpans->pucSpan[ 0 ], xFirst );
+    configASSERT( ( xLength - xFirst ) <= pxSpans->xSpanLength[ 1 ] );
+    memcpy( &( pucData[ xFirst ] ), pxSpans->pucSpan[ 1 ], xLength - xFirst );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckStreamBufferSpans( void )
+{
+    StreamBufferHandle_t xStreamBuffer;
+    StreamBufferSpans_t xSpans;
+    uint8_t ucData[ 10 ];
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    xStreamBuffer = xStreamBufferCreate( 10, 1 );
+    configASSERT( xStreamBuffer != NULL );
+
+    /* Nothing to acquire from an empty stream buffer. */
+    configASSERT( xStreamBufferReceiveAcquire( xStreamBuffer, &xSpans, 0 ) == 0 );
+    configASSERT( ( xSpans.xSpanLength[ 0 ] == 0 ) && ( xSpans.xSpanLength[ 1 ] == 0 ) );
+
+    /* Move the head and tail part way through the storage area. */
+    configASSERT( xStreamBufferSend( xStreamBuffer, "0123456", 7, 0 ) == 7 );
+    configASSERT( xStreamBufferReceive( xStreamBuffer, ucData, 7, 0 ) == 7 );
+
+    /* The free space wraps.  The storage area is one byte larger than the
+     * size of the stream buffer, so the first span is 11 - 7 bytes long. */
+    configASSERT( xStreamBufferSendReserve( xStreamBuffer, &xSpans, 0 ) == 10 );
+    configASSERT( ( xSpans.xSpanLength[ 0 ] == 4 ) && ( xSpans.xSpanLength[ 1 ] == 6 ) );
+    configASSERT( xSpans.pucSpan[ 1 ] + 7 == xSpans.pucSpan[ 0 ] );
+
+    /* Nothing is added until it is committed. */
+    prvCopyToSpans( &xSpans, ( const uint8_t * ) "abcdefgh", 8 );
+    configASSERT( xStreamBufferIsEmpty( xStreamBuffer ) == pdTRUE );
+    configASSERT( xStreamBufferSendCommit( xStreamBuffer, 0 ) == 0 );
+    configASSERT( xStreamBufferIsEmpty( xStreamBuffer ) == pdTRUE );
+    configASSERT( xStreamBufferSendCommit( xStreamBuffer, 8 ) == 8 );
+    configASSERT( xStreamBufferBytesAvailable( xStreamBuffer ) == 8 );
+
+    configASSERT( xStreamBufferSendReserveFromISR( xStreamBuffer, &xSpans ) == 2 );
+    configASSERT( ( xSpans.xSpanLength[ 0 ] == 2 ) && ( xSpans.xSpanLength[ 1 ] == 0 ) );
+    prvCopyToSpans( &xSpans, ( const uint8_t * ) "ij", 2 );
+    configASSERT( xStreamBufferSendCommitFromISR( xStreamBuffer, 2, &xHigherPriorityTaskWoken ) == 2 );
+    configASSERT( xStreamBufferIsFull( xStreamBuffer ) == pdTRUE );
+    configASSERT( xStreamBufferSendReserve( xStreamBuffer, &xSpans, 0 ) == 0 );
+
+    /* The data wraps, and is read in place, partly, then by copy. */
+    configASSERT( xStreamBufferReceiveAcquire( xStreamBuffer, &xSpans, 0 ) == 10 );
+    configASSERT( ( xSpans.xSpanLength[ 0 ] == 4 ) && ( xSpans.xSpanLength[ 1 ] == 6 ) );
+    prvCopyFromSpans( &xSpans, ucData, 10 );
+    configASSERT( memcmp( ucData, "abcdefghij", 10 ) == 0 );
+    configASSERT( xStreamBufferReceiveRelease( xStreamBuffer, 3 ) == 3 );
+    configASSERT( xStreamBufferReceive( xStreamBuffer, ucData, 3, 0 ) == 3 );
+    configASSERT( memcmp( ucData, "def", 3 ) == 0 );
+
+    configASSERT( xStreamBufferReceiveAcquireFromISR( xStreamBuffer, &xSpans ) == 4 );
+    configASSERT( ( xSpans.xSpanLength[ 0 ] == 4 ) && ( xSpans.pucSpan[ 0 ][ 0 ] == 'g' ) );
+    configASSERT( xStreamBufferReceiveReleaseFromISR( xStreamBuffer, 4, &xHigherPriorityTaskWoken ) == 4 );
+    configASSERT( xStreamBufferIsEmpty( xStreamBuffer ) == pdTRUE );
+    configASSERT( xHigherPriorityTaskWoken == pdFALSE );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckMessageBufferSpans( void )
+{
+    MessageBufferHandle_t xMessageBuffer;
+    StreamBufferSpans_t xSpans;
+    const size_t xLengthSize = sizeof( configMESSAGE_BUFFER_LENGTH_TYPE );
+    uint8_t ucMessage[ 20 ], ucReceived[ 20 ];
+    size_t xLength, xIteration, x;
+
+    xMessageBuffer = xMessageBufferCreate( 30 + xLengthSize );
+    configASSERT( xMessageBuffer != NULL );
+
+    /* The space reserved leaves room for the message length. */
+    configASSERT( xMessageBufferSendReserve( xMessageBuffer, &xSpans, 0 ) == 30 );
+    configASSERT( xMessageBufferReceiveAcquire( xMessageBuffer, &xSpans, 0 ) == 0 );
+
+    /* Messages of varying lengths are sent and received alternately in
+     * place and by copy, so they wrap at every position. */
+    for( xIteration = 0; xIteration < 100; xIteration++ )
+    {
+        xLength = ( xIteration % 20 ) + 1;
+
+        for( x = 0; x < xLength; x++ )
+        {
+            ucMessage[ x ] = ( uint8_t ) ( xIteration + x );
+        }
+
+        if( ( xIteration & 1 ) == 0 )
+        {
+            configASSERT( xMessageBufferSendReserve( xMessageBuffer, &xSpans, 0 ) >= xLength );
+            prvCopyToSpans( &xSpans, ucMessage, xLength );
+            configASSERT( xMessageBufferSendCommit( xMessageBuffer, xLength ) == xLength );
+        }
+        else
+        {
+            configASSERT( xMessageBufferSend( xMessageBuffer, ucMessage, xLength, 0 ) == xLength );
+        }
+
+        if( ( xIteration & 2 ) == 0 )
+        {
+            configASSERT( xMessageBufferReceiveAcquire( xMessageBuffer, &xSpans, 0 ) == xLength );
+            prvCopyFromSpans( &xSpans, ucReceived, xLength );
+
+            /* Releasing nothing leaves the message in the buffer. */
+            configASSERT( xMessageBufferReceiveRelease( xMessageBuffer, 0 ) == 0 );
+            configASSERT( xMessageBufferReceiveAcquire( xMessageBuffer, &xSpans, 0 ) == xLength );
+            configASSERT( xMessageBufferReceiveRelease( xMessageBuffer, xLength ) == xLength );
+        }
+        else
+        {
+            configASSERT( xMessageBufferReceive( xMessageBuffer, ucReceived, sizeof( ucReceived ), 0 ) == xLength );
+        }
+
+        configASSERT( memcmp( ucMessage, ucReceived, xLength ) == 0 );
+        configASSERT( xMessageBufferIsEmpty( xMessageBuffer ) == pdTRUE );
+    }
+
+    vMessageBufferDelete( xMessageBuffer );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    TaskHandle_t xTask;
+    StreamBufferHandle_t xStreamBuffer;
+    StreamBufferSpans_t xSpans;
+    const char * pcMethod;
+    unsigned long ulChunkSize, ulChunk, ulChunks;
+    uint64_t ullStart, ullTime;
+    size_t xFirst;
+    BaseType_t xInPlace;
+
+    pcMethod = ( argc > 1 ) ? argv[ 1 ] : "in_place";
+    ulChunkSize = ( argc > 2 ) ? strtoul( argv[ 2 ], NULL, 10 ) : 256;
+    configASSERT( ( ulChunkSize > 0 ) && ( ulChunkSize <= benchMAX_CHUNK_SIZE ) );
+    configASSERT( ( strcmp( pcMethod, "copy" ) == 0 ) || ( strcmp( pcMethod, "in_place" ) == 0 ) );
+    xInPlace = ( strcmp( pcMethod, "in_place" ) == 0 ) ? pdTRUE : pdFALSE;
+    ulChunks = benchBYTES / ulChunkSize;
+
+    /* Returns with the idle task selected as the running task. */
+    vTaskStartScheduler();
+
+    /* Creating a task with a priority above the idle task selects it as the
+     * running task, so the stream buffers are used on its behalf. */
+    configASSERT( xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTask ) == pdPASS );
+    configASSERT( xTaskGetCurrentTaskHandle() == xTask );
+
+    prvCheckStreamBufferSpans();
+    prvCheckMessageBufferSpans();
+
+    /* Two and a half chunks, so chunks start at different offsets and one in
+     * every few wraps. */
+    xStreamBuffer = xStreamBufferCreate( ( ulChunkSize * 5 ) / 2, 1 );
+    configASSERT( xStreamBuffer != NULL );
+
+    ullStart = prvNanoseconds();
+
+    for( ulChunk = 0; ulChunk < ulChunks; ulChunk++ )
+    {
+        if( xInPlace != pdFALSE )
+        {
+            configASSERT( xStreamBufferSendReserve( xStreamBuffer, &xSpans, 0 ) >= ulChunkSize );
+            xFirst = configMIN( ulChunkSize, xSpans.xSpanLength[ 0 ] );
+            memset( xSpans.pucSpan[ 0 ], ( int ) ( ulChunk & 0xffUL ), xFirst );
+            memset( xSpans.pucSpan[ 1 ], ( int ) ( ulChunk & 0xffUL ), ulChunkSize - xFirst );
+            configASSERT( xStreamBufferSendCommit( xStreamBuffer, ulChunkSize ) == ulChunkSize );
+
+            configASSERT( xStreamBufferReceiveAcquire( xStreamBuffer, &xSpans, 0 ) == ulChunkSize );
+
+            if( xSpans.xSpanLength[ 1 ] == 0 )
+            {
+                prvConsume( xSpans.pucSpan[ 0 ][ 0 ], xSpans.pucSpan[ 0 ][ ulChunkSize - 1 ], ulChunk );
+            }
+            else
+            {
+                prvConsume( xSpans.pucSpan[ 0 ][ 0 ], xSpans.pucSpan[ 1 ][ xSpans.xSpanLength[ 1 ] - 1 ], ulChunk );
+            }
+
+            configASSERT( xStreamBufferReceiveRelease( xStreamBuffer, ulChunkSize ) == ulChunkSize );
+        }
+        else
+        {
+            memset( ucSendBuffer, ( int ) ( ulChunk & 0xffUL ), ulChunkSize );
+            configASSERT( xStreamBufferSend( xStreamBuffer, ucSendBuffer, ulChunkSize, 0 ) == ulChunkSize );
+
+            configASSERT( xStreamBufferReceive( xStreamBuffer, ucReceiveBuffer, ulChunkSize, 0 ) == ulChunkSize );
+            prvConsume( ucReceiveBuffer[ 0 ], ucReceiveBuffer[ ulChunkSize - 1 ], ulChunk );
+        }
+    }
+
+    ullTime = prvNanoseconds() - ullStart;
+
+    printf( "%-8s chunk %5lu bytes  send+receive %8.1f ns  %6.2f GB/s  (checksum %08lx)\r\n", pcMethod, ulChunkSize, ( double ) ullTime / ( double ) ulChunks, ( double ) ( ulChunks * ulChunkSize ) / ( double ) ullTime, ( unsigned long ) ulSum );
+
+    vStreamBufferDelete( xStreamBuffer );
+
+    if( ulOutOfOrder != 0 )
+    {
+        printf( "FAIL: data was corrupted or reordered in the stream buffer\r\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,218 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of a context switch selecting the highest priority ready
+ * task with a given number of priorities in use.  The same source is built
+ * once with the generic task selection that searches down through the ready
+ * lists and once with the ready priority bitmap
+ * (configUSE_READY_PRIORITY_BITMAP).
+ *
+ * Usage: task_select_bench_<method> <number of priorities>
+ *
+ * No task executes.  One task is created at each priority above the idle
+ * priority, then tasks are suspended and resumed from main() by calling
+ * vTaskSuspend() and vTaskResume(), each of which selects the task to run
+ * next.  After every call the task selected is checked to be the highest
+ * priority task that is not suspended.  Two patterns are measured:
+ *
+ * "random" suspends or resumes a pseudo random task, so about half the tasks
+ * are ready at any time.
+ *
+ * "top" repeatedly suspends and resumes the highest priority task while all
+ * the other tasks are suspended, so every suspend falls back to the idle task.
+ * This is the worst case for searching down through the ready lists.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchITERATIONS    ( 200000UL )
+
+#ifndef configUSE_READY_PRIORITY_BITMAP
+    #error configUSE_READY_PRIORITY_BITMAP must be set on the command line
+#endif
+
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+    #define benchMETHOD_NAME    "bitmap"
+#else
+    #define benchMETHOD_NAME    "search"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* xTasks[ x ] has priority x.  xTasks[ 0 ] is the idle task. */
+static TaskHandle_t xTasks[ configMAX_PRIORITIES ];
+static BaseType_t xSuspended[ configMAX_PRIORITIES ];
+static uint32_t ulRandomState = 0x1234567UL;
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    /* Never executes. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    /* Fixed seed linear congruential generator so both methods see exactly
+     * the same sequence of operations. */
+    ulRandomState = ( ulRandomState * 1103515245UL ) + 12345UL;
+
+    return ulRandomState >> 8;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetSuspended( UBaseType_t uxPriority,
+                             BaseType_t xSuspend )
+{
+    if( xSuspend != pdFALSE )
+    {
+        vTaskSuspend( xTasks[ uxPriority ] );
+    }
+    else
+    {
+        vTaskResume( xTasks[ uxPriority ] );
+    }
+
+    xSuspended[ uxPriority ] = xSuspend;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckRunningTask( UBaseType_t uxNumberOfPriorities )
+{
+    UBaseType_t uxExpected = uxNumberOfPriorities - 1;
+
+    while( ( uxExpected > tskIDLE_PRIORITY ) && ( xSuspended[ uxExpected ] != pdFALSE ) )
+    {
+        uxExpected--;
+    }
+
+    if( xTaskGetCurrentTaskHandle() != xTasks[ uxExpected ] )
+    {
+        printf( "FAIL: %s selected priority %lu, expected %lu\r\n", benchMETHOD_NAME,
+                ( unsigned long ) uxTaskPriorityGet( NULL ), ( unsigned long ) uxExpected );
+        return pdFAIL;
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    UBaseType_t x, uxPriority, uxNumberOfPriorities;
+    unsigned long ulIteration;
+    uint64_t ullStart, ullRandomTime = 0, ullTopTime = 0;
+
+    uxNumberOfPriorities = ( argc > 1 ) ? ( UBaseType_t ) strtoul( argv[ 1 ], NULL, 10 ) : 32;
+    configASSERT( ( uxNumberOfPriorities > 1 ) && ( uxNumberOfPriorities <= configMAX_PRIORITIES ) );
+
+    for( x = tskIDLE_PRIORITY + 1; x < uxNumberOfPriorities; x++ )
+    {
+        configASSERT( xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, x, &( xTasks[ x ] ) ) == pdPASS );
+    }
+
+    /* Returns with the highest priority task selected as the running task. */
+    vTaskStartScheduler();
+    xTasks[ tskIDLE_PRIORITY ] = xTaskGetIdleTaskHandle();
+
+    if( prvCheckRunningTask( uxNumberOfPriorities ) != pdPASS )
+    {
+        return EXIT_FAILURE;
+    }
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        uxPriority = tskIDLE_PRIORITY + 1 + ( prvRandom() % ( uxNumberOfPriorities - 1 ) );
+
+        ullStart = prvNanoseconds();
+        prvSetSuspended( uxPriority, ( xSuspended[ uxPriority ] == pdFALSE ) ? pdTRUE : pdFALSE );
+        ullRandomTime += prvNanoseconds() - ullStart;
+
+        if( prvCheckRunningTask( uxNumberOfPriorities ) != pdPASS )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Leave only the highest priority task and the idle task ready. */
+    for( x = tskIDLE_PRIORITY + 1; x < uxNumberOfPriorities - 1; x++ )
+    {
+        if( xSuspended[ x ] == pdFALSE )
+        {
+            prvSetSuspended( x, pdTRUE );
+        }
+    }
+
+    uxPriority = uxNumberOfPriorities - 1;
+
+    if( xSuspended[ uxPriority ] != pdFALSE )
+    {
+        prvSetSuspended( uxPriority, pdFALSE );
+    }
+
+    for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+    {
+        ullStart = prvNanoseconds();
+        prvSetSuspended( uxPriority, ( xSuspended[ uxPriority ] == pdFALSE ) ? pdTRUE : pdFALSE );
+        ullTopTime += prvNanoseconds() - ullStart;
+
+        if( prvCheckRunningTask( uxNumberOfPriorities ) != pdPASS )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf( "%-6s priorities %3lu  random %6.1f ns  top %6.1f ns\r\n",
+            benchMETHOD_NAME,
+            ( unsigned long ) uxNumberOfPriorities,
+            ( double ) ullRandomTime / ( double ) benchITERATIONS,
+            ( double ) ullTopTime / ( double ) benchITERATIONS );
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
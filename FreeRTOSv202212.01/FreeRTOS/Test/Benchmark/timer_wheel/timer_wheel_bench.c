@@ -0,0 +1,289 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures the cost of the timer service processing timer commands with the
+ * sorted active timer list, with configUSE_TIMER_WHEEL, with
+ * configTIMER_COMMAND_BATCH_SIZE and with configUSE_TIMER_DIRECT_COMMANDS.
+ *
+ * Usage: timer_wheel_bench_<method> <commands>
+ *
+ * task:   a task with a higher priority than the timer service task resets
+ *         every timer in a set, then waits for the timer service task to
+ *         process the commands.
+ * daemon: a function pended to the timer service task resets every timer in a
+ *         set, as a timer callback would.
+ *
+ * Both are repeated with sets of 10, 100 and 1000 timers, the periods of which
+ * are long enough that none expire.  Finally one-shot timers with periods
+ * spread over several levels of the wheel are started, and the tick count at
+ * which each callback runs is checked against the timer's expiry time.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+    #define benchMETHOD_NAME    "direct"
+#elif ( configTIMER_COMMAND_BATCH_SIZE > 1 )
+    #define benchMETHOD_NAME    "batch"
+#elif ( configUSE_TIMER_WHEEL == 1 )
+    #define benchMETHOD_NAME    "wheel"
+#else
+    #define benchMETHOD_NAME    "list"
+#endif
+
+#define benchMAX_TIMERS      1000
+#define benchCHECK_TIMERS    200
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulCommands;
+static TimerHandle_t xTimers[ benchMAX_TIMERS ];
+static volatile unsigned long ulUnexpectedExpiries;
+static volatile unsigned long ulChecked;
+static volatile unsigned long ulEarly;
+static volatile TickType_t xMaxLateness;
+static TaskHandle_t xControlTask;
+static uint32_t ulRandom = 0x12345678UL;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    /* xorshift32, so every method sees the same periods. */
+    ulRandom ^= ulRandom << 13;
+    ulRandom ^= ulRandom >> 17;
+    ulRandom ^= ulRandom << 5;
+
+    return ulRandom;
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+
+    ulUnexpectedExpiries++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTimerCallback( TimerHandle_t xTimer )
+{
+    const TickType_t xNow = xTaskGetTickCount();
+    const TickType_t xExpected = xTimerGetExpiryTime( xTimer );
+
+    if( xNow < xExpected )
+    {
+        ulEarly++;
+    }
+    else if( ( xNow - xExpected ) > xMaxLateness )
+    {
+        xMaxLateness = xNow - xExpected;
+    }
+
+    ulChecked++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBarrier( void * pvParameter1,
+                        uint32_t ulParameter2 )
+{
+    ( void ) pvParameter1;
+    ( void ) ulParameter2;
+
+    xTaskNotifyGive( xControlTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetFromDaemon( void * pvParameter1,
+                                uint32_t ulParameter2 )
+{
+    uint32_t ulTimer;
+
+    ( void ) pvParameter1;
+
+    for( ulTimer = 0; ulTimer < ulParameter2; ulTimer++ )
+    {
+        configASSERT( xTimerReset( xTimers[ ulTimer ], 0 ) == pdPASS );
+    }
+
+    /* Queued behind any resets that were not applied directly. */
+    configASSERT( xTimerPendFunctionCall( prvBarrier, NULL, 0, 0 ) == pdPASS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasure( const char * pcTest,
+                        uint32_t ulTimers )
+{
+    unsigned long ulRounds = ulCommands / ulTimers;
+    unsigned long ulRound;
+    uint32_t ulTimer;
+    uint64_t ullStartNs, ullNs;
+
+    ullStartNs = prvNanoseconds();
+
+    for( ulRound = 0; ulRound < ulRounds; ulRound++ )
+    {
+        if( pcTest[ 0 ] == 't' )
+        {
+            for( ulTimer = 0; ulTimer < ulTimers; ulTimer++ )
+            {
+                configASSERT( xTimerReset( xTimers[ ulTimer ], 0 ) == pdPASS );
+            }
+
+            configASSERT( xTimerPendFunctionCall( prvBarrier, NULL, 0, 0 ) == pdPASS );
+        }
+        else
+        {
+            configASSERT( xTimerPendFunctionCall( prvResetFromDaemon, NULL, ulTimers, 0 ) == pdPASS );
+        }
+
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+
+    ullNs = prvNanoseconds() - ullStartNs;
+
+    printf( "%-6s %-6s %4lu timers  %8lu commands  %8.1f ns/command\r\n",
+            benchMETHOD_NAME, pcTest, ( unsigned long ) ulTimers, ulRounds * ulTimers,
+            ( double ) ullNs / ( double ) ( ulRounds * ulTimers ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckExpiryTimes( void )
+{
+    TimerHandle_t xCheckTimers[ benchCHECK_TIMERS ];
+    uint32_t ulTimer;
+
+    /* Periods from 1 tick to 2 seconds cover the first three levels of the
+     * default wheel.  The control task has a higher priority than the timer
+     * service task, so all the commands are processed together. */
+    for( ulTimer = 0; ulTimer < benchCHECK_TIMERS; ulTimer++ )
+    {
+        xCheckTimers[ ulTimer ] = xTimerCreate( "Check", ( TickType_t ) ( 1U + ( prvRandom() % 2000U ) ), pdFALSE, NULL, prvCheckTimerCallback );
+        configASSERT( xCheckTimers[ ulTimer ] != NULL );
+    }
+
+    for( ulTimer = 0; ulTimer < benchCHECK_TIMERS; ulTimer++ )
+    {
+        configASSERT( xTimerStart( xCheckTimers[ ulTimer ], 0 ) == pdPASS );
+    }
+
+    while( ulChecked < benchCHECK_TIMERS )
+    {
+        vTaskDelay( pdMS_TO_TICKS( 100 ) );
+    }
+
+    printf( "%-6s check  %4lu timers  %lu early  max %lu ticks late\r\n",
+            benchMETHOD_NAME, ulChecked, ulEarly, ( unsigned long ) xMaxLateness );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    static const uint32_t ulSetSizes[] = { 10, 100, benchMAX_TIMERS };
+    uint32_t ulSet;
+    uint32_t ulTimer;
+    BaseType_t xFailed;
+
+    ( void ) pvParameters;
+
+    /* Periods of 100 to 400 seconds, so no timer expires during the test. */
+    for( ulTimer = 0; ulTimer < benchMAX_TIMERS; ulTimer++ )
+    {
+        xTimers[ ulTimer ] = xTimerCreate( "Idle", ( TickType_t ) ( 100000U + ( prvRandom() % 300000U ) ), pdTRUE, NULL, prvIdleTimerCallback );
+        configASSERT( xTimers[ ulTimer ] != NULL );
+    }
+
+    for( ulSet = 0; ulSet < ( sizeof( ulSetSizes ) / sizeof( ulSetSizes[ 0 ] ) ); ulSet++ )
+    {
+        /* Every timer in the set is active during the measurement. */
+        for( ulTimer = 0; ulTimer < ulSetSizes[ ulSet ]; ulTimer++ )
+        {
+            configASSERT( xTimerStart( xTimers[ ulTimer ], 0 ) == pdPASS );
+        }
+
+        configASSERT( xTimerPendFunctionCall( prvBarrier, NULL, 0, 0 ) == pdPASS );
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        prvMeasure( "task", ulSetSizes[ ulSet ] );
+        prvMeasure( "daemon", ulSetSizes[ ulSet ] );
+    }
+
+    for( ulTimer = 0; ulTimer < benchMAX_TIMERS; ulTimer++ )
+    {
+        configASSERT( xTimerStop( xTimers[ ulTimer ], 0 ) == pdPASS );
+    }
+
+    configASSERT( xTimerPendFunctionCall( prvBarrier, NULL, 0, 0 ) == pdPASS );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+    prvCheckExpiryTimes();
+
+    xFailed = ( ( ulUnexpectedExpiries != 0 ) || ( ulEarly != 0 ) ) ? pdTRUE : pdFALSE;
+
+    if( xFailed != pdFALSE )
+    {
+        printf( "%-6s FAILED: %lu unexpected expiries, %lu early\r\n", benchMETHOD_NAME, ulUnexpectedExpiries, ulEarly );
+        exit( EXIT_FAILURE );
+    }
+
+    vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    ulCommands = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 10 ) : 200000UL;
+    configASSERT( ulCommands >= benchMAX_TIMERS );
+
+    configASSERT( xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControlTask ) == pdPASS );
+
+    /* Returns once the control task ends the scheduler. */
+    vTaskStartScheduler();
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
@@ -84,6 +84,10 @@ typedef unsigned long    UBaseType_t;
 #if ( configUSE_16_BIT_TICKS == 1 )
     typedef uint16_t     TickType_t;
     #define portMAX_DELAY        ( TickType_t ) 0xffff
+#elif defined( configTEST_64_BIT_TICKS ) && ( configTEST_64_BIT_TICKS == 1 )
+    /* As the Posix port on a 64-bit host. */
+    typedef uint64_t     TickType_t;
+    #define portMAX_DELAY        ( ( TickType_t ) ~( ( TickType_t ) 0 ) )
 #else
     typedef uint32_t     TickType_t;
     #define portMAX_DELAY        ( TickType_t ) 0xffffffffUL
@@ -0,0 +1,798 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file deferred_work_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Deferred work includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "deferred_work.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "unity_memory.h"
+#include "CException.h"
+
+/* Mock includes. */
+#include "mock_task.h"
+#include "mock_fake_assert.h"
+#include "mock_fake_port.h"
+
+/**
+ * @brief Lane on which the test work items run unless a test says otherwise.
+ */
+#define TEST_LANE                  ( 1U )
+
+/**
+ * @brief Event bits passed to the submit functions.
+ */
+#define TEST_EVENT_A               ( 0x01UL )
+#define TEST_EVENT_B               ( 0x10UL )
+
+/**
+ * @brief Maximum number of work function calls recorded by a test.
+ */
+#define TEST_MAX_CALLS             ( 8U )
+
+/**
+ * @brief CException code for when a configASSERT should be intercepted.
+ */
+#define configASSERT_E             0xAA101
+
+/**
+ * @brief CException code used to leave the worker task's infinite loop.
+ */
+#define WORKER_BLOCKED_E           0xAA102
+
+/**
+ * @brief Expect a configASSERT from the function called.
+ *  Break out of the called function when this occurs.
+ * @details Use this macro when the call passed in as a parameter is expected
+ * to cause invalid memory access.
+ */
+#define EXPECT_ASSERT_BREAK( call )                  \
+    do                                               \
+    {                                                \
+        shouldAbortOnAssertion = true;               \
+        CEXCEPTION_T e = CEXCEPTION_NONE;            \
+        Try                                          \
+        {                                            \
+            call;                                    \
+            TEST_FAIL_MESSAGE( "Expected Assert!" ); \
+        }                                            \
+        Catch( e )                                   \
+        {                                            \
+            TEST_ASSERT_EQUAL( configASSERT_E, e );  \
+        }                                            \
+    } while( 0 )
+
+/* ===========================  DEFINES CONSTANTS  ========================== */
+
+/* Mirrors the lane structure in deferred_work.c so each test can start from
+ * idle lanes. */
+typedef struct
+{
+    DeferredWorkHandle_t xQueued;
+    TaskHandle_t xWorkerTask;
+} DeferredWorkLane_t;
+
+/* Records one call to a work function. */
+typedef struct
+{
+    void * pvParameter;
+    uint32_t ulEvents;
+} WorkCall_t;
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/**
+ * @brief Global counter for the number of assertions in code.
+ */
+static int assertionFailed = 0;
+
+/**
+ * @brief Flag which denotes if test need to abort on assertion.
+ */
+static BaseType_t shouldAbortOnAssertion;
+
+/**
+ * @brief Dummy worker task handles returned for each lane.
+ */
+static TaskHandle_t laneTasks[ configDEFERRED_WORK_LANES ] =
+{
+    ( TaskHandle_t ) 0xAABBCC00,
+    ( TaskHandle_t ) 0xAABBCC01
+};
+
+/**
+ * @brief The worker task function, and the parameter of each lane's worker
+ * task, as passed to xTaskCreate().
+ */
+static TaskFunction_t workerFunction;
+static DeferredWorkLane_t * laneParameters[ configDEFERRED_WORK_LANES ];
+
+/**
+ * @brief Name, stack depth and priority of each worker task created.
+ */
+static const char * laneTaskNames[ configDEFERRED_WORK_LANES ];
+static configSTACK_DEPTH_TYPE laneStackDepths[ configDEFERRED_WORK_LANES ];
+static UBaseType_t lanePriorities[ configDEFERRED_WORK_LANES ];
+
+/**
+ * @brief Number of tasks xTaskCreate() creates before failing.
+ */
+static int tasksBeforeFailure;
+
+/**
+ * @brief Number of calls to xTaskCreate() and ulTaskGenericNotifyTake().
+ */
+static int taskCreateCalls;
+static int notifyTakeCalls;
+
+/**
+ * @brief Calls made to the test work functions, in order.
+ */
+static WorkCall_t workCalls[ TEST_MAX_CALLS ];
+static UBaseType_t workCallCount;
+
+/**
+ * @brief Work items used by the tests.
+ */
+static StaticDeferredWork_t workBufferA;
+static StaticDeferredWork_t workBufferB;
+static DeferredWorkHandle_t xWorkA;
+static DeferredWorkHandle_t xWorkB;
+
+/**
+ * @brief Item submitted again from within a work function, and the events
+ * passed.
+ */
+static DeferredWorkHandle_t xResubmitWork;
+static uint32_t ulResubmitEvents;
+static BaseType_t xResubmitQueued;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+void * pvPortMalloc( size_t xSize )
+{
+    return unity_malloc( xSize );
+}
+void vPortFree( void * pv )
+{
+    return unity_free( pv );
+}
+
+static void vFakeAssertStub( bool x,
+                             char * file,
+                             int line,
+                             int cmock_num_calls )
+{
+    if( !x )
+    {
+        assertionFailed++;
+
+        if( shouldAbortOnAssertion == pdTRUE )
+        {
+            Throw( configASSERT_E );
+        }
+    }
+}
+
+static BaseType_t xTaskCreateStub( TaskFunction_t pxTaskCode,
+                                   const char * const pcName,
+                                   const configSTACK_DEPTH_TYPE usStackDepth,
+                                   void * const pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t * const pxCreatedTask,
+                                   int cmock_num_calls )
+{
+    const int lane = taskCreateCalls++;
+
+    if( lane >= tasksBeforeFailure )
+    {
+        return pdFAIL;
+    }
+
+    workerFunction = pxTaskCode;
+    laneParameters[ lane ] = ( DeferredWorkLane_t * ) pvParameters;
+    laneTaskNames[ lane ] = pcName;
+    laneStackDepths[ lane ] = usStackDepth;
+    lanePriorities[ lane ] = uxPriority;
+    *pxCreatedTask = laneTasks[ lane ];
+
+    return pdPASS;
+}
+
+/* Leaves the worker task's loop when it blocks with nothing to do. */
+static uint32_t ulTaskGenericNotifyTakeStub( UBaseType_t uxIndexToWaitOn,
+                                             BaseType_t xClearCountOnExit,
+                                             TickType_t xTicksToWait,
+                                             int cmock_num_calls )
+{
+    notifyTakeCalls++;
+
+    TEST_ASSERT_EQUAL( tskDEFAULT_INDEX_TO_NOTIFY, uxIndexToWaitOn );
+    TEST_ASSERT_EQUAL( pdTRUE, xClearCountOnExit );
+    TEST_ASSERT_EQUAL( portMAX_DELAY, xTicksToWait );
+
+    Throw( WORKER_BLOCKED_E );
+
+    return 0;
+}
+
+/* As ulTaskGenericNotifyTakeStub(), but the first wait returns without a
+ * notification, as it would if the wait timed out. */
+static uint32_t ulTaskGenericNotifyTakeTimeoutStub( UBaseType_t uxIndexToWaitOn,
+                                                    BaseType_t xClearCountOnExit,
+                                                    TickType_t xTicksToWait,
+                                                    int cmock_num_calls )
+{
+    if( cmock_num_calls == 0 )
+    {
+        notifyTakeCalls++;
+        return 0;
+    }
+
+    return ulTaskGenericNotifyTakeStub( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait, cmock_num_calls );
+}
+
+static void vRecordWork( void * pvParameter,
+                         uint32_t ulEvents )
+{
+    TEST_ASSERT_LESS_THAN( TEST_MAX_CALLS, workCallCount );
+    workCalls[ workCallCount ].pvParameter = pvParameter;
+    workCalls[ workCallCount ].ulEvents = ulEvents;
+    workCallCount++;
+}
+
+/* Records the call, then submits xResubmitWork from within the work function
+ * as an interrupt might. */
+static void vResubmitWork( void * pvParameter,
+                           uint32_t ulEvents )
+{
+    vRecordWork( pvParameter, ulEvents );
+
+    if( xResubmitWork != NULL )
+    {
+        xResubmitQueued = xDeferredWorkSubmitFromISR( xResubmitWork, ulResubmitEvents, NULL );
+        xResubmitWork = NULL;
+    }
+}
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    UBaseType_t uxLane;
+
+    assertionFailed = 0;
+    shouldAbortOnAssertion = pdFALSE;
+    tasksBeforeFailure = configDEFERRED_WORK_LANES;
+    taskCreateCalls = 0;
+    notifyTakeCalls = 0;
+    workerFunction = NULL;
+    memset( laneParameters, 0x00, sizeof( laneParameters ) );
+    memset( workCalls, 0x00, sizeof( workCalls ) );
+    workCallCount = 0;
+    xResubmitWork = NULL;
+    ulResubmitEvents = 0;
+    xResubmitQueued = pdFALSE;
+
+    mock_task_Init();
+    mock_fake_assert_Init();
+    mock_fake_port_Init();
+
+    vFakeAssert_StubWithCallback( vFakeAssertStub );
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+
+    /* Create the lanes as vTaskStartScheduler() would. */
+    xTaskCreate_Stub( xTaskCreateStub );
+    TEST_ASSERT_EQUAL( pdPASS, xDeferredWorkCreateLanes() );
+    xTaskCreate_Stub( NULL );
+
+    /* A failed test can leave items queued. */
+    for( uxLane = 0; uxLane < configDEFERRED_WORK_LANES; uxLane++ )
+    {
+        laneParameters[ uxLane ]->xQueued = NULL;
+    }
+
+    xWorkA = xDeferredWorkCreateStatic( vRecordWork, &workBufferA, TEST_LANE, &workBufferA );
+    xWorkB = xDeferredWorkCreateStatic( vRecordWork, &workBufferB, TEST_LANE, &workBufferB );
+}
+
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL_MESSAGE( 0, assertionFailed, "Assertion check failed in code." );
+    UnityMalloc_EndTest();
+    mock_task_Verify();
+    mock_task_Destroy();
+    mock_fake_assert_Verify();
+    mock_fake_assert_Destroy();
+    mock_fake_port_Verify();
+    mock_fake_port_Destroy();
+}
+
+void suiteSetUp()
+{
+}
+
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ==========================  Helper functions =========================== */
+
+/* Runs the worker task of TEST_LANE until it blocks with no work queued. */
+static void runWorker( void )
+{
+    CEXCEPTION_T e = CEXCEPTION_NONE;
+
+    Try
+    {
+        workerFunction( laneParameters[ TEST_LANE ] );
+        TEST_FAIL_MESSAGE( "The worker task returned." );
+    }
+    Catch( e )
+    {
+        TEST_ASSERT_EQUAL( WORKER_BLOCKED_E, e );
+    }
+}
+
+static void validateWorkCall( UBaseType_t uxCall,
+                              void * pvParameter,
+                              uint32_t ulEvents )
+{
+    TEST_ASSERT_EQUAL_PTR( pvParameter, workCalls[ uxCall ].pvParameter );
+    TEST_ASSERT_EQUAL_HEX32( ulEvents, workCalls[ uxCall ].ulEvents );
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief One worker task is created for each lane, at the priority configured
+ * for the lane.
+ * @coverage xDeferredWorkCreateLanes xDeferredWorkGetLaneTaskHandle
+ */
+void test_xDeferredWorkCreateLanes_success( void )
+{
+    const UBaseType_t uxExpectedPriorities[ configDEFERRED_WORK_LANES ] = configDEFERRED_WORK_LANE_PRIORITIES;
+    UBaseType_t uxLane;
+
+    for( uxLane = 0; uxLane < configDEFERRED_WORK_LANES; uxLane++ )
+    {
+        TEST_ASSERT_NOT_NULL( laneParameters[ uxLane ] );
+        TEST_ASSERT_EQUAL_STRING( "DWork", laneTaskNames[ uxLane ] );
+        TEST_ASSERT_EQUAL( configDEFERRED_WORK_STACK_DEPTH, laneStackDepths[ uxLane ] );
+        TEST_ASSERT_EQUAL( uxExpectedPriorities[ uxLane ] | portPRIVILEGE_BIT, lanePriorities[ uxLane ] );
+        TEST_ASSERT_EQUAL_PTR( laneTasks[ uxLane ], xDeferredWorkGetLaneTaskHandle( uxLane ) );
+    }
+
+    TEST_ASSERT_NOT_EQUAL( laneParameters[ 0 ], laneParameters[ 1 ] );
+}
+
+/**
+ * @brief Lane creation stops at the first worker task that cannot be created.
+ * @coverage xDeferredWorkCreateLanes
+ */
+void test_xDeferredWorkCreateLanes_fail( void )
+{
+    tasksBeforeFailure = 1;
+    taskCreateCalls = 0;
+    xTaskCreate_Stub( xTaskCreateStub );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xDeferredWorkCreateLanes() );
+
+    /* The failure is asserted. */
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+    TEST_ASSERT_EQUAL( 2, taskCreateCalls );
+}
+
+/**
+ * @brief Getting the worker task of a lane that does not exist is asserted.
+ * @coverage xDeferredWorkGetLaneTaskHandle
+ */
+void test_xDeferredWorkGetLaneTaskHandle_invalid_lane( void )
+{
+    EXPECT_ASSERT_BREAK( ( void ) xDeferredWorkGetLaneTaskHandle( configDEFERRED_WORK_LANES ) );
+
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+}
+
+/**
+ * @brief A work item is created idle.
+ * @coverage xDeferredWorkCreate prvInitialiseNewWork
+ */
+void test_xDeferredWorkCreate_success( void )
+{
+    DeferredWorkHandle_t xWork;
+
+    xWork = xDeferredWorkCreate( vRecordWork, NULL, TEST_LANE );
+    TEST_ASSERT_NOT_NULL( xWork );
+
+    /* Idle, so the first submission queues the item. */
+    vTaskGenericNotifyGiveFromISR_Expect( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, NULL );
+    TEST_ASSERT_EQUAL( pdTRUE, xDeferredWorkSubmitFromISR( xWork, TEST_EVENT_A, NULL ) );
+
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeStub );
+    runWorker();
+    TEST_ASSERT_EQUAL( 1, workCallCount );
+    validateWorkCall( 0, NULL, TEST_EVENT_A );
+
+    vPortFree( xWork );
+}
+
+/**
+ * @brief Creating a work item fails when there is no memory for it.
+ * @coverage xDeferredWorkCreate
+ */
+void test_xDeferredWorkCreate_malloc_fail( void )
+{
+    UnityMalloc_MakeMallocFailAfterCount( 0 );
+
+    TEST_ASSERT_NULL( xDeferredWorkCreate( vRecordWork, NULL, TEST_LANE ) );
+}
+
+/**
+ * @brief A work item must have a function and a lane that exists.
+ * @coverage xDeferredWorkCreate prvInitialiseNewWork
+ */
+void test_xDeferredWorkCreate_invalid_params( void )
+{
+    DeferredWorkHandle_t xWork;
+
+    xWork = xDeferredWorkCreate( NULL, NULL, TEST_LANE );
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    vPortFree( xWork );
+
+    xWork = xDeferredWorkCreate( vRecordWork, NULL, configDEFERRED_WORK_LANES );
+    TEST_ASSERT_EQUAL( 2, assertionFailed );
+    vPortFree( xWork );
+
+    assertionFailed = 0;
+}
+
+/**
+ * @brief A statically allocated work item uses the buffer passed in.
+ * @coverage xDeferredWorkCreateStatic prvInitialiseNewWork
+ */
+void test_xDeferredWorkCreateStatic_success( void )
+{
+    StaticDeferredWork_t xWorkBuffer;
+
+    memset( &xWorkBuffer, 0xA5, sizeof( xWorkBuffer ) );
+
+    TEST_ASSERT_EQUAL_PTR( &xWorkBuffer, xDeferredWorkCreateStatic( vRecordWork, NULL, TEST_LANE, &xWorkBuffer ) );
+}
+
+/**
+ * @brief Creating a statically allocated work item without a buffer returns
+ * NULL.
+ * @coverage xDeferredWorkCreateStatic
+ */
+void test_xDeferredWorkCreateStatic_null_buffer( void )
+{
+    TEST_ASSERT_NULL( xDeferredWorkCreateStatic( vRecordWork, NULL, TEST_LANE, NULL ) );
+
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+}
+
+/**
+ * @brief Submitting an item to an idle lane from an interrupt queues it and
+ * wakes the lane's worker task.
+ * @coverage xDeferredWorkSubmitFromISR prvQueueWork
+ */
+void test_xDeferredWorkSubmitFromISR_idle_lane( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    BaseType_t xWoken = pdTRUE;
+
+    vTaskGenericNotifyGiveFromISR_Expect( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, &xHigherPriorityTaskWoken );
+    vTaskGenericNotifyGiveFromISR_ReturnThruPtr_pxHigherPriorityTaskWoken( &xWoken );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xDeferredWorkSubmitFromISR( xWorkA, TEST_EVENT_A, &xHigherPriorityTaskWoken ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xHigherPriorityTaskWoken );
+    TEST_ASSERT_EQUAL_PTR( xWorkA, laneParameters[ TEST_LANE ]->xQueued );
+    TEST_ASSERT_NULL( laneParameters[ 0 ]->xQueued );
+}
+
+/**
+ * @brief Only the submission to an idle lane wakes the worker task.
+ * @coverage xDeferredWorkSubmitFromISR prvQueueWork
+ */
+void test_xDeferredWorkSubmitFromISR_busy_lane( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    vTaskGenericNotifyGiveFromISR_Expect( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, &xHigherPriorityTaskWoken );
+    TEST_ASSERT_EQUAL( pdTRUE, xDeferredWorkSubmitFromISR( xWorkA, TEST_EVENT_A, &xHigherPriorityTaskWoken ) );
+
+    /* No further notification is expected. */
+    TEST_ASSERT_EQUAL( pdTRUE, xDeferredWorkSubmitFromISR( xWorkB, TEST_EVENT_B, &xHigherPriorityTaskWoken ) );
+
+    TEST_ASSERT_EQUAL_PTR( xWorkB, laneParameters[ TEST_LANE ]->xQueued );
+}
+
+/**
+ * @brief Submitting an item that is already queued merges the events into
+ * the pending submission.
+ * @coverage xDeferredWorkSubmitFromISR prvQueueWork
+ */
+void test_xDeferredWorkSubmitFromISR_coalesced( void )
+{
+    vTaskGenericNotifyGiveFromISR_Expect( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, NULL );
+    TEST_ASSERT_EQUAL( pdTRUE, xDeferredWorkSubmitFromISR( xWorkA, TEST_EVENT_A, NULL ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xDeferredWorkSubmitFromISR( xWorkA, TEST_EVENT_B, NULL ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xDeferredWorkSubmitFromISR( xWorkA, TEST_EVENT_A, NULL ) );
+
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeStub );
+    runWorker();
+
+    /* The function runs once with the events of every submission. */
+    TEST_ASSERT_EQUAL( 1, workCallCount );
+    validateWorkCall( 0, &workBufferA, TEST_EVENT_A | TEST_EVENT_B );
+}
+
+/**
+ * @brief Submitting without any events is asserted.
+ * @coverage xDeferredWorkSubmitFromISR prvQueueWork
+ */
+void test_xDeferredWorkSubmitFromISR_no_events( void )
+{
+    EXPECT_ASSERT_BREAK( ( void ) xDeferredWorkSubmitFromISR( xWorkA, 0, NULL ) );
+
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+}
+
+/**
+ * @brief Submitting a NULL handle is asserted.
+ * @coverage xDeferredWorkSubmitFromISR
+ */
+void test_xDeferredWorkSubmitFromISR_null_handle( void )
+{
+    EXPECT_ASSERT_BREAK( ( void ) xDeferredWorkSubmitFromISR( NULL, TEST_EVENT_A, NULL ) );
+
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+}
+
+/**
+ * @brief Submitting an item before the scheduler starts queues it without
+ * notifying a worker task, which runs it once created.
+ * @coverage xDeferredWorkSubmitFromISR prvQueueWork
+ */
+void test_xDeferredWorkSubmitFromISR_before_scheduler_start( void )
+{
+    laneParameters[ TEST_LANE ]->xWorkerTask = NULL;
+
+    TEST_ASSERT_EQUAL( pdTRUE, xDeferredWorkSubmitFromISR( xWorkA, TEST_EVENT_A, NULL ) );
+
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeStub );
+    runWorker();
+    TEST_ASSERT_EQUAL( 1, workCallCount );
+}
+
+/**
+ * @brief Submitting an item to an idle lane from a task notifies the lane's
+ * worker task.
+ * @coverage xDeferredWorkSubmit prvQueueWork
+ */
+void test_xDeferredWorkSubmit_idle_lane( void )
+{
+    xTaskGenericNotify_ExpectAndReturn( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, 0, eIncrement, NULL, pdPASS );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xDeferredWorkSubmit( xWorkA, TEST_EVENT_A ) );
+}
+
+/**
+ * @brief Submitting an item that is already queued from a task neither queues
+ * it again nor notifies the worker task.
+ * @coverage xDeferredWorkSubmit prvQueueWork
+ */
+void test_xDeferredWorkSubmit_coalesced( void )
+{
+    xTaskGenericNotify_ExpectAndReturn( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, 0, eIncrement, NULL, pdPASS );
+    TEST_ASSERT_EQUAL( pdTRUE, xDeferredWorkSubmit( xWorkA, TEST_EVENT_A ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xDeferredWorkSubmit( xWorkB, TEST_EVENT_A ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xDeferredWorkSubmit( xWorkA, TEST_EVENT_B ) );
+
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeStub );
+    runWorker();
+
+    TEST_ASSERT_EQUAL( 2, workCallCount );
+    validateWorkCall( 0, &workBufferA, TEST_EVENT_A | TEST_EVENT_B );
+    validateWorkCall( 1, &workBufferB, TEST_EVENT_A );
+}
+
+/**
+ * @brief Submitting a NULL handle from a task is asserted.
+ * @coverage xDeferredWorkSubmit
+ */
+void test_xDeferredWorkSubmit_null_handle( void )
+{
+    EXPECT_ASSERT_BREAK( ( void ) xDeferredWorkSubmit( NULL, TEST_EVENT_A ) );
+
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+}
+
+/**
+ * @brief A worker task with nothing queued blocks on its notification without
+ * a timeout.
+ * @coverage prvDeferredWorkTask
+ */
+void test_prvDeferredWorkTask_blocks_when_idle( void )
+{
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeStub );
+
+    runWorker();
+
+    TEST_ASSERT_EQUAL( 1, notifyTakeCalls );
+    TEST_ASSERT_EQUAL( 0, workCallCount );
+}
+
+/**
+ * @brief A worker task that returns from its wait without a notification
+ * checks the lane again before blocking again.
+ * @coverage prvDeferredWorkTask
+ */
+void test_prvDeferredWorkTask_wait_timeout( void )
+{
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeTimeoutStub );
+
+    runWorker();
+
+    TEST_ASSERT_EQUAL( 2, notifyTakeCalls );
+    TEST_ASSERT_EQUAL( 0, workCallCount );
+}
+
+/**
+ * @brief The worker task runs the items on its lane in the order they were
+ * submitted.
+ * @coverage prvDeferredWorkTask
+ */
+void test_prvDeferredWorkTask_submission_order( void )
+{
+    StaticDeferredWork_t xWorkBufferC;
+    DeferredWorkHandle_t xWorkC;
+
+    xWorkC = xDeferredWorkCreateStatic( vRecordWork, &xWorkBufferC, TEST_LANE, &xWorkBufferC );
+
+    vTaskGenericNotifyGiveFromISR_Expect( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, NULL );
+    ( void ) xDeferredWorkSubmitFromISR( xWorkB, TEST_EVENT_A, NULL );
+    ( void ) xDeferredWorkSubmitFromISR( xWorkC, TEST_EVENT_B, NULL );
+    ( void ) xDeferredWorkSubmitFromISR( xWorkA, TEST_EVENT_A, NULL );
+
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeStub );
+    runWorker();
+
+    TEST_ASSERT_EQUAL( 3, workCallCount );
+    validateWorkCall( 0, &workBufferB, TEST_EVENT_A );
+    validateWorkCall( 1, &xWorkBufferC, TEST_EVENT_B );
+    validateWorkCall( 2, &workBufferA, TEST_EVENT_A );
+    TEST_ASSERT_NULL( laneParameters[ TEST_LANE ]->xQueued );
+}
+
+/**
+ * @brief An item can be submitted again as soon as its function starts, and
+ * runs again on the next pass of the worker task.
+ * @coverage prvDeferredWorkTask xDeferredWorkSubmitFromISR
+ */
+void test_prvDeferredWorkTask_resubmit_while_running( void )
+{
+    StaticDeferredWork_t xWorkBuffer;
+    DeferredWorkHandle_t xWork;
+
+    xWork = xDeferredWorkCreateStatic( vResubmitWork, &xWorkBuffer, TEST_LANE, &xWorkBuffer );
+    xResubmitWork = xWork;
+    ulResubmitEvents = TEST_EVENT_B;
+
+    vTaskGenericNotifyGiveFromISR_Expect( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, NULL );
+    ( void ) xDeferredWorkSubmitFromISR( xWork, TEST_EVENT_A, NULL );
+
+    /* The lane is idle while the function runs, so the resubmission notifies
+     * the worker task again. */
+    vTaskGenericNotifyGiveFromISR_Expect( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, NULL );
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeStub );
+    runWorker();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xResubmitQueued );
+    TEST_ASSERT_EQUAL( 2, workCallCount );
+    validateWorkCall( 0, &xWorkBuffer, TEST_EVENT_A );
+    validateWorkCall( 1, &xWorkBuffer, TEST_EVENT_B );
+}
+
+/**
+ * @brief An item submitted while the worker task runs the items it has taken
+ * from the lane runs before the worker task blocks.
+ * @coverage prvDeferredWorkTask xDeferredWorkSubmitFromISR
+ */
+void test_prvDeferredWorkTask_submit_other_while_running( void )
+{
+    StaticDeferredWork_t xWorkBuffer;
+    DeferredWorkHandle_t xWork;
+
+    xWork = xDeferredWorkCreateStatic( vResubmitWork, &xWorkBuffer, TEST_LANE, &xWorkBuffer );
+    xResubmitWork = xWorkB;
+    ulResubmitEvents = TEST_EVENT_B;
+
+    vTaskGenericNotifyGiveFromISR_Expect( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, NULL );
+    ( void ) xDeferredWorkSubmitFromISR( xWork, TEST_EVENT_A, NULL );
+    ( void ) xDeferredWorkSubmitFromISR( xWorkA, TEST_EVENT_A, NULL );
+
+    vTaskGenericNotifyGiveFromISR_Expect( laneTasks[ TEST_LANE ], tskDEFAULT_INDEX_TO_NOTIFY, NULL );
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeStub );
+    runWorker();
+
+    TEST_ASSERT_EQUAL( 3, workCallCount );
+    validateWorkCall( 0, &xWorkBuffer, TEST_EVENT_A );
+    validateWorkCall( 1, &workBufferA, TEST_EVENT_A );
+    validateWorkCall( 2, &workBufferB, TEST_EVENT_B );
+    TEST_ASSERT_EQUAL( 1, notifyTakeCalls );
+}
+
+/**
+ * @brief Items on one lane are not run by the worker task of another lane.
+ * @coverage prvDeferredWorkTask xDeferredWorkSubmitFromISR
+ */
+void test_prvDeferredWorkTask_other_lane( void )
+{
+    StaticDeferredWork_t xWorkBuffer;
+    DeferredWorkHandle_t xWork;
+    CEXCEPTION_T e = CEXCEPTION_NONE;
+
+    xWork = xDeferredWorkCreateStatic( vRecordWork, &xWorkBuffer, 0, &xWorkBuffer );
+
+    vTaskGenericNotifyGiveFromISR_Expect( laneTasks[ 0 ], tskDEFAULT_INDEX_TO_NOTIFY, NULL );
+    ( void ) xDeferredWorkSubmitFromISR( xWork, TEST_EVENT_A, NULL );
+
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeStub );
+    runWorker();
+    TEST_ASSERT_EQUAL( 0, workCallCount );
+
+    Try
+    {
+        workerFunction( laneParameters[ 0 ] );
+    }
+    Catch( e )
+    {
+        TEST_ASSERT_EQUAL( WORKER_BLOCKED_E, e );
+    }
+
+    TEST_ASSERT_EQUAL( 1, workCallCount );
+    validateWorkCall( 0, &xWorkBuffer, TEST_EVENT_A );
+}
@@ -0,0 +1,296 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file deferred_work_static_lanes_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Deferred work includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "deferred_work.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "unity_memory.h"
+#include "CException.h"
+
+/* Mock includes. */
+#include "mock_task.h"
+#include "mock_fake_assert.h"
+#include "mock_fake_port.h"
+
+/**
+ * @brief Stack depth, in words, of the worker task of each lane.
+ */
+#define TEST_LANE_STACK_DEPTH    ( 32U )
+
+/**
+ * @brief Event bits passed to the submit functions.
+ */
+#define TEST_EVENT_A             ( 0x01UL )
+
+/**
+ * @brief CException code used to leave the worker task's infinite loop.
+ */
+#define WORKER_BLOCKED_E         0xAA102
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/**
+ * @brief Global counter for the number of assertions in code.
+ */
+static int assertionFailed = 0;
+
+/**
+ * @brief Memory provided for the worker task of each lane.
+ */
+static StaticTask_t laneTCBs[ configDEFERRED_WORK_LANES ];
+static StackType_t laneStacks[ configDEFERRED_WORK_LANES ][ TEST_LANE_STACK_DEPTH ];
+
+/**
+ * @brief The lanes vApplicationGetDeferredWorkLaneMemory() was called for, in
+ * order.
+ */
+static UBaseType_t laneMemoryRequests[ configDEFERRED_WORK_LANES + 1 ];
+static UBaseType_t laneMemoryRequestCount;
+
+/**
+ * @brief Number of tasks xTaskCreateStatic() creates before failing.
+ */
+static UBaseType_t tasksBeforeFailure;
+
+/**
+ * @brief Arguments passed to xTaskCreateStatic() for each lane.
+ */
+static TaskFunction_t workerFunction;
+static void * laneParameters[ configDEFERRED_WORK_LANES ];
+static uint32_t laneStackDepths[ configDEFERRED_WORK_LANES ];
+static UBaseType_t lanePriorities[ configDEFERRED_WORK_LANES ];
+static StackType_t * laneStackBuffers[ configDEFERRED_WORK_LANES ];
+static StaticTask_t * laneTCBBuffers[ configDEFERRED_WORK_LANES ];
+static UBaseType_t taskCreateCalls;
+
+/**
+ * @brief Events passed to the test work function.
+ */
+static uint32_t workEvents;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+static void vFakeAssertStub( bool x,
+                             char * file,
+                             int line,
+                             int cmock_num_calls )
+{
+    if( !x )
+    {
+        assertionFailed++;
+    }
+}
+
+void vApplicationGetDeferredWorkLaneMemory( UBaseType_t uxLane,
+                                            StaticTask_t ** ppxLaneTaskTCBBuffer,
+                                            StackType_t ** ppxLaneTaskStackBuffer,
+                                            uint32_t * pulLaneTaskStackSize )
+{
+    TEST_ASSERT_LESS_THAN( configDEFERRED_WORK_LANES, uxLane );
+
+    laneMemoryRequests[ laneMemoryRequestCount++ ] = uxLane;
+    *ppxLaneTaskTCBBuffer = &( laneTCBs[ uxLane ] );
+    *ppxLaneTaskStackBuffer = laneStacks[ uxLane ];
+    *pulLaneTaskStackSize = TEST_LANE_STACK_DEPTH;
+}
+
+static TaskHandle_t xTaskCreateStaticStub( TaskFunction_t pxTaskCode,
+                                           const char * const pcName,
+                                           const uint32_t ulStackDepth,
+                                           void * const pvParameters,
+                                           UBaseType_t uxPriority,
+                                           StackType_t * const puxStackBuffer,
+                                           StaticTask_t * const pxTaskBuffer,
+                                           int cmock_num_calls )
+{
+    const UBaseType_t lane = taskCreateCalls++;
+
+    if( lane >= tasksBeforeFailure )
+    {
+        return NULL;
+    }
+
+    workerFunction = pxTaskCode;
+    laneParameters[ lane ] = pvParameters;
+    laneStackDepths[ lane ] = ulStackDepth;
+    lanePriorities[ lane ] = uxPriority;
+    laneStackBuffers[ lane ] = puxStackBuffer;
+    laneTCBBuffers[ lane ] = pxTaskBuffer;
+
+    /* The handle of a statically allocated task is its TCB. */
+    return ( TaskHandle_t ) pxTaskBuffer;
+}
+
+/* Leaves the worker task's loop when it blocks with nothing to do. */
+static uint32_t ulTaskGenericNotifyTakeStub( UBaseType_t uxIndexToWaitOn,
+                                             BaseType_t xClearCountOnExit,
+                                             TickType_t xTicksToWait,
+                                             int cmock_num_calls )
+{
+    Throw( WORKER_BLOCKED_E );
+
+    return 0;
+}
+
+static void vRecordWork( void * pvParameter,
+                         uint32_t ulEvents )
+{
+    ( void ) pvParameter;
+    workEvents |= ulEvents;
+}
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    assertionFailed = 0;
+    memset( laneMemoryRequests, 0xFF, sizeof( laneMemoryRequests ) );
+    laneMemoryRequestCount = 0;
+    tasksBeforeFailure = configDEFERRED_WORK_LANES;
+    taskCreateCalls = 0;
+    workerFunction = NULL;
+    memset( laneParameters, 0x00, sizeof( laneParameters ) );
+    workEvents = 0;
+
+    mock_task_Init();
+    mock_fake_assert_Init();
+    mock_fake_port_Init();
+
+    vFakeAssert_StubWithCallback( vFakeAssertStub );
+    xTaskCreateStatic_Stub( xTaskCreateStaticStub );
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+}
+
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL_MESSAGE( 0, assertionFailed, "Assertion check failed in code." );
+    UnityMalloc_EndTest();
+    mock_task_Verify();
+    mock_task_Destroy();
+    mock_fake_assert_Verify();
+    mock_fake_assert_Destroy();
+    mock_fake_port_Verify();
+    mock_fake_port_Destroy();
+}
+
+void suiteSetUp()
+{
+}
+
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief Without dynamic allocation each worker task is created in the
+ * memory the application provides for its lane.
+ * @coverage xDeferredWorkCreateLanes xDeferredWorkGetLaneTaskHandle
+ */
+void test_xDeferredWorkCreateLanes_static_success( void )
+{
+    const UBaseType_t uxExpectedPriorities[ configDEFERRED_WORK_LANES ] = configDEFERRED_WORK_LANE_PRIORITIES;
+    UBaseType_t uxLane;
+
+    TEST_ASSERT_EQUAL( pdPASS, xDeferredWorkCreateLanes() );
+
+    TEST_ASSERT_EQUAL( configDEFERRED_WORK_LANES, laneMemoryRequestCount );
+
+    for( uxLane = 0; uxLane < configDEFERRED_WORK_LANES; uxLane++ )
+    {
+        TEST_ASSERT_EQUAL( uxLane, laneMemoryRequests[ uxLane ] );
+        TEST_ASSERT_NOT_NULL( laneParameters[ uxLane ] );
+        TEST_ASSERT_EQUAL( TEST_LANE_STACK_DEPTH, laneStackDepths[ uxLane ] );
+        TEST_ASSERT_EQUAL( uxExpectedPriorities[ uxLane ] | portPRIVILEGE_BIT, lanePriorities[ uxLane ] );
+        TEST_ASSERT_EQUAL_PTR( laneStacks[ uxLane ], laneStackBuffers[ uxLane ] );
+        TEST_ASSERT_EQUAL_PTR( &( laneTCBs[ uxLane ] ), laneTCBBuffers[ uxLane ] );
+        TEST_ASSERT_EQUAL_PTR( &( laneTCBs[ uxLane ] ), xDeferredWorkGetLaneTaskHandle( uxLane ) );
+    }
+}
+
+/**
+ * @brief Lane creation stops at the first worker task that cannot be created.
+ * @coverage xDeferredWorkCreateLanes
+ */
+void test_xDeferredWorkCreateLanes_static_fail( void )
+{
+    tasksBeforeFailure = 0;
+
+    TEST_ASSERT_EQUAL( pdFAIL, xDeferredWorkCreateLanes() );
+
+    TEST_ASSERT_EQUAL( 1, laneMemoryRequestCount );
+    TEST_ASSERT_EQUAL( 1, taskCreateCalls );
+    TEST_ASSERT_NULL( xDeferredWorkGetLaneTaskHandle( 0 ) );
+
+    /* The failure is asserted. */
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+}
+
+/**
+ * @brief A statically allocated item submitted from an interrupt is run by the
+ * worker task of its lane.
+ * @coverage xDeferredWorkCreateStatic xDeferredWorkSubmitFromISR prvDeferredWorkTask
+ */
+void test_xDeferredWorkSubmitFromISR_static_lane( void )
+{
+    StaticDeferredWork_t xWorkBuffer;
+    DeferredWorkHandle_t xWork;
+    CEXCEPTION_T e = CEXCEPTION_NONE;
+
+    TEST_ASSERT_EQUAL( pdPASS, xDeferredWorkCreateLanes() );
+    xWork = xDeferredWorkCreateStatic( vRecordWork, NULL, 0, &xWorkBuffer );
+    TEST_ASSERT_EQUAL_PTR( &xWorkBuffer, xWork );
+
+    vTaskGenericNotifyGiveFromISR_Expect( ( TaskHandle_t ) &( laneTCBs[ 0 ] ), tskDEFAULT_INDEX_TO_NOTIFY, NULL );
+    TEST_ASSERT_EQUAL( pdTRUE, xDeferredWorkSubmitFromISR( xWork, TEST_EVENT_A, NULL ) );
+
+    ulTaskGenericNotifyTake_Stub( ulTaskGenericNotifyTakeStub );
+
+    Try
+    {
+        workerFunction( laneParameters[ 0 ] );
+    }
+    Catch( e )
+    {
+        TEST_ASSERT_EQUAL( WORKER_BLOCKED_E, e );
+    }
+
+    TEST_ASSERT_EQUAL_HEX32( TEST_EVENT_A, workEvents );
+}
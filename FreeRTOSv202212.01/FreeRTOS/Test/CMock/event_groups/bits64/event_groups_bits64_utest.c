@@ -0,0 +1,558 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file event_groups_bits64_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Event Group includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "event_groups.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "unity_memory.h"
+#include "CException.h"
+
+/* Mock includes. */
+#include "mock_task.h"
+#include "mock_timers.h"
+#include "mock_list.h"
+#include "mock_list_macros.h"
+#include "mock_fake_assert.h"
+#include "mock_fake_port.h"
+
+/* ===========================  DEFINES CONSTANTS  ========================== */
+/* Bits above bit 31 only exist when configUSE_64_BIT_EVENT_GROUPS is 1. */
+#define BIT( n )                   ( ( EventBits_t ) 1 << ( n ) )
+#define BIT_0                      BIT( 0 )
+#define BIT_31                     BIT( 31 )
+#define BIT_32                     BIT( 32 )
+#define BIT_33                     BIT( 33 )
+#define BIT_40                     BIT( 40 )
+#define BIT_47                     BIT( 47 )
+#define BIT_52                     BIT( 52 )
+#define BIT_55                     BIT( 55 )
+
+/* Bits above configEVENT_GROUP_INDEXED_BITS, waited for in the shared list. */
+#define BIT_50                     BIT( 50 )
+
+/* The lowest and highest of the control bits. */
+#define BIT_56                     BIT( 56 )
+#define BIT_63                     BIT( 63 )
+
+#define TEST_MAX_WAITERS           ( 4 )
+#define TEST_EVENT_GROUP_TICKS     ( 100 )
+
+/**
+ * @brief CException code for when a configASSERT should be intercepted.
+ */
+#define configASSERT_E             0xAA101
+
+/**
+ * @brief Expect a configASSERT from the function called.
+ *  Break out of the called function when this occurs.
+ */
+#define EXPECT_ASSERT_BREAK( call )                  \
+    do                                               \
+    {                                                \
+        CEXCEPTION_T e = CEXCEPTION_NONE;            \
+        Try                                          \
+        {                                            \
+            call;                                    \
+            TEST_FAIL_MESSAGE( "Expected Assert!" ); \
+        }                                            \
+        Catch( e )                                   \
+        {                                            \
+            TEST_ASSERT_EQUAL( configASSERT_E, e );  \
+        }                                            \
+    } while( 0 )
+
+/* ===========================  GLOBAL VARIABLES  =========================== */
+
+/**
+ * @brief A task that blocks on the event group.
+ */
+typedef struct
+{
+    ListItem_t xEventListItem;       /*< The task's event list item. */
+    BaseType_t xSync;                /*< Call xEventGroupSync() rather than xEventGroupWaitBits(). */
+    EventBits_t uxBitsToSet;         /*< The bits to set if xSync is pdTRUE. */
+    EventBits_t uxBitsToWaitFor;
+    BaseType_t xClearOnExit;
+    BaseType_t xWaitForAllBits;
+    List_t * pxEventList;            /*< The list the task was placed in when it blocked. */
+    BaseType_t xUnblockedByBits;     /*< Set when the task is removed from its list by the event group. */
+    EventBits_t uxReturn;            /*< The value returned to the task. */
+} Waiter_t;
+
+/**
+ * @brief Global event group handle used for tests.
+ */
+static EventGroupHandle_t xEventGroupHandle;
+static StaticEventGroup_t xStaticEventGroup;
+
+static Waiter_t xWaiters[ TEST_MAX_WAITERS ];
+static UBaseType_t uxWaiterCount;
+static UBaseType_t uxCurrentWaiter;
+
+/**
+ * @brief Run once every waiter has blocked, as if by another task.
+ */
+static void ( * pxWhileBlocked )( void );
+
+/**
+ * @brief The number of waiting tasks xEventGroupSetBits() looked at.
+ */
+static UBaseType_t uxItemsVisited;
+
+/**
+ * @brief The number of tasks unblocked by the event group.
+ */
+static UBaseType_t uxTasksUnblocked;
+
+/**
+ * @brief Global counter for the number of assertions in code.
+ */
+static int assertionFailed = 0;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+void * pvPortMalloc( size_t xSize )
+{
+    return unity_malloc( xSize );
+}
+void vPortFree( void * pv )
+{
+    return unity_free( pv );
+}
+
+static void vFakeAssertStub( bool x,
+                             char * file,
+                             int line,
+                             int cmock_num_calls )
+{
+    if( !x )
+    {
+        assertionFailed++;
+        Throw( configASSERT_E );
+    }
+}
+
+static void validate_and_clear_assertions( void )
+{
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+}
+
+/* The list functions and macros are mocked, so provide the behaviour of list.c
+ * and list.h for the lists of waiting tasks. */
+static void vListInitialiseCallback( List_t * const pxList,
+                                     int cmock_num_calls )
+{
+    pxList->pxIndex = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.xItemValue = portMAX_DELAY;
+    pxList->xListEnd.pxNext = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.pxPrevious = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
+}
+
+static void vListInsertEndCallback( List_t * const pxList,
+                                    ListItem_t * const pxNewListItem,
+                                    int cmock_num_calls )
+{
+    ListItem_t * const pxIndex = pxList->pxIndex;
+
+    pxNewListItem->pxNext = pxIndex;
+    pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    pxIndex->pxPrevious->pxNext = pxNewListItem;
+    pxIndex->pxPrevious = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    ( pxList->uxNumberOfItems )++;
+}
+
+static UBaseType_t uxListRemoveCallback( ListItem_t * const pxItemToRemove,
+                                         int cmock_num_calls )
+{
+    List_t * const pxList = pxItemToRemove->pxContainer;
+
+    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+
+    if( pxList->pxIndex == pxItemToRemove )
+    {
+        pxList->pxIndex = pxItemToRemove->pxPrevious;
+    }
+
+    pxItemToRemove->pxContainer = NULL;
+    ( pxList->uxNumberOfItems )--;
+
+    return pxList->uxNumberOfItems;
+}
+
+static ListItem_t * listGET_END_MARKERCallback( const List_t * pxList,
+                                                int cmock_num_calls )
+{
+    return ( ListItem_t * ) &( pxList->xListEnd );
+}
+
+static ListItem_t * listGET_NEXTCallback( ListItem_t * pxListItem,
+                                          int cmock_num_calls )
+{
+    return pxListItem->pxNext;
+}
+
+static TickType_t listGET_LIST_ITEM_VALUECallback( ListItem_t * listItem,
+                                                   int cmock_num_calls )
+{
+    uxItemsVisited++;
+    return listItem->xItemValue;
+}
+
+static UBaseType_t listCURRENT_LIST_LENGTHCallback( const List_t * list,
+                                                    int cmock_num_calls )
+{
+    return list->uxNumberOfItems;
+}
+
+/* The task functions the event group uses to block and unblock tasks. */
+static void vTaskPlaceOnUnorderedEventListCallback( List_t * pxEventList,
+                                                    const TickType_t xItemValue,
+                                                    const TickType_t xTicksToWait,
+                                                    int cmock_num_calls )
+{
+    Waiter_t * const pxWaiter = &( xWaiters[ uxCurrentWaiter ] );
+
+    TEST_ASSERT_EQUAL( TEST_EVENT_GROUP_TICKS, xTicksToWait );
+    pxWaiter->pxEventList = pxEventList;
+    pxWaiter->xEventListItem.xItemValue = xItemValue;
+    vListInsertEndCallback( pxEventList, &( pxWaiter->xEventListItem ), 0 );
+}
+
+static void vTaskRemoveFromUnorderedEventListCallback( ListItem_t * pxEventListItem,
+                                                       const TickType_t xItemValue,
+                                                       int cmock_num_calls )
+{
+    UBaseType_t uxWaiter;
+
+    for( uxWaiter = 0; uxWaiter < uxWaiterCount; uxWaiter++ )
+    {
+        if( pxEventListItem == &( xWaiters[ uxWaiter ].xEventListItem ) )
+        {
+            xWaiters[ uxWaiter ].xUnblockedByBits = pdTRUE;
+        }
+    }
+
+    uxTasksUnblocked++;
+    pxEventListItem->xItemValue = xItemValue;
+    ( void ) uxListRemoveCallback( pxEventListItem, 0 );
+}
+
+static TickType_t uxTaskResetEventItemValueCallback( int cmock_num_calls )
+{
+    Waiter_t * const pxWaiter = &( xWaiters[ uxCurrentWaiter ] );
+
+    if( pxWaiter->xEventListItem.pxContainer != NULL )
+    {
+        /* The block time expired while the task was still waiting. */
+        ( void ) uxListRemoveCallback( &( pxWaiter->xEventListItem ), 0 );
+    }
+
+    return pxWaiter->xEventListItem.xItemValue;
+}
+
+/* ===========================  Static Functions  =========================== */
+
+static void block_waiter( UBaseType_t uxWaiter )
+{
+    Waiter_t * const pxWaiter = &( xWaiters[ uxWaiter ] );
+    const UBaseType_t uxPreviousWaiter = uxCurrentWaiter;
+
+    uxCurrentWaiter = uxWaiter;
+
+    if( pxWaiter->xSync != pdFALSE )
+    {
+        pxWaiter->uxReturn = xEventGroupSync( xEventGroupHandle,
+                                              pxWaiter->uxBitsToSet,
+                                              pxWaiter->uxBitsToWaitFor,
+                                              TEST_EVENT_GROUP_TICKS );
+    }
+    else
+    {
+        pxWaiter->uxReturn = xEventGroupWaitBits( xEventGroupHandle,
+                                                  pxWaiter->uxBitsToWaitFor,
+                                                  pxWaiter->xClearOnExit,
+                                                  pxWaiter->xWaitForAllBits,
+                                                  TEST_EVENT_GROUP_TICKS );
+    }
+
+    uxCurrentWaiter = uxPreviousWaiter;
+}
+
+/* The calling waiter has blocked, so let the next one run, or once they have
+ * all blocked run the test's action. */
+static void vFakePortYieldWithinAPICallback( int cmock_num_calls )
+{
+    if( ( uxCurrentWaiter + 1 ) < uxWaiterCount )
+    {
+        block_waiter( uxCurrentWaiter + 1 );
+    }
+    else
+    {
+        pxWhileBlocked();
+    }
+}
+
+static void add_waiter( EventBits_t uxBitsToWaitFor,
+                        BaseType_t xClearOnExit,
+                        BaseType_t xWaitForAllBits )
+{
+    TEST_ASSERT_LESS_THAN( TEST_MAX_WAITERS, uxWaiterCount );
+    xWaiters[ uxWaiterCount ].uxBitsToWaitFor = uxBitsToWaitFor;
+    xWaiters[ uxWaiterCount ].xClearOnExit = xClearOnExit;
+    xWaiters[ uxWaiterCount ].xWaitForAllBits = xWaitForAllBits;
+    uxWaiterCount++;
+}
+
+static void add_sync_waiter( EventBits_t uxBitsToSet,
+                             EventBits_t uxBitsToWaitFor )
+{
+    TEST_ASSERT_LESS_THAN( TEST_MAX_WAITERS, uxWaiterCount );
+    xWaiters[ uxWaiterCount ].xSync = pdTRUE;
+    xWaiters[ uxWaiterCount ].uxBitsToSet = uxBitsToSet;
+    xWaiters[ uxWaiterCount ].uxBitsToWaitFor = uxBitsToWaitFor;
+    uxWaiterCount++;
+}
+
+/* Block every waiter in turn, run pxAction while they are all blocked, then
+ * let each waiter return. */
+static void run_waiters( void ( * pxAction )( void ) )
+{
+    pxWhileBlocked = pxAction;
+    block_waiter( 0 );
+}
+
+/* Set bits as another task, and return the number of waiting tasks visited. */
+static UBaseType_t set_bits( EventBits_t uxBitsToSet )
+{
+    uxItemsVisited = 0;
+    ( void ) xEventGroupSetBits( xEventGroupHandle, uxBitsToSet );
+    return uxItemsVisited;
+}
+
+/* ============================  Unity Fixtures  ============================ */
+/*! called before each testcase */
+void setUp( void )
+{
+    memset( xWaiters, 0, sizeof( xWaiters ) );
+    uxWaiterCount = 0;
+    uxCurrentWaiter = 0;
+    pxWhileBlocked = NULL;
+    uxItemsVisited = 0;
+    uxTasksUnblocked = 0;
+    assertionFailed = 0;
+
+    vFakeAssert_StubWithCallback( vFakeAssertStub );
+    vFakePortEnterCriticalSection_Ignore();
+    vFakePortExitCriticalSection_Ignore();
+    vFakePortYieldWithinAPI_StubWithCallback( vFakePortYieldWithinAPICallback );
+
+    vListInitialise_StubWithCallback( vListInitialiseCallback );
+    vListInsertEnd_StubWithCallback( vListInsertEndCallback );
+    uxListRemove_StubWithCallback( uxListRemoveCallback );
+    listGET_END_MARKER_StubWithCallback( listGET_END_MARKERCallback );
+    listGET_NEXT_StubWithCallback( listGET_NEXTCallback );
+    listGET_LIST_ITEM_VALUE_StubWithCallback( listGET_LIST_ITEM_VALUECallback );
+    listCURRENT_LIST_LENGTH_StubWithCallback( listCURRENT_LIST_LENGTHCallback );
+
+    xTaskGetSchedulerState_IgnoreAndReturn( taskSCHEDULER_RUNNING );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdFALSE );
+    vTaskPlaceOnUnorderedEventList_StubWithCallback( vTaskPlaceOnUnorderedEventListCallback );
+    vTaskRemoveFromUnorderedEventList_StubWithCallback( vTaskRemoveFromUnorderedEventListCallback );
+    uxTaskResetEventItemValue_StubWithCallback( uxTaskResetEventItemValueCallback );
+
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+
+    xEventGroupHandle = xEventGroupCreateStatic( &xStaticEventGroup );
+    TEST_ASSERT_NOT_NULL( xEventGroupHandle );
+}
+
+/*! called after each testcase */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL_MESSAGE( 0, assertionFailed, "Assertion check failed in code." );
+    UnityMalloc_EndTest();
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/*!
+ * @brief validate the event bits are 64 bits wide
+ * @coverage xEventGroupSetBits xEventGroupClearBits xEventGroupGetBits
+ */
+void test_xEventGroupSetBits_SetsBitsAbove31( void )
+{
+    TEST_ASSERT_EQUAL( sizeof( uint64_t ), sizeof( EventBits_t ) );
+
+    TEST_ASSERT_EQUAL_UINT64( BIT_0 | BIT_40 | BIT_55, xEventGroupSetBits( xEventGroupHandle, BIT_0 | BIT_40 | BIT_55 ) );
+    TEST_ASSERT_EQUAL_UINT64( BIT_0 | BIT_40 | BIT_55, xEventGroupClearBits( xEventGroupHandle, BIT_40 ) );
+    TEST_ASSERT_EQUAL_UINT64( BIT_0 | BIT_55, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+static void set_high_bits( void )
+{
+    /* The task waiting for bits 33 and 47 is in the list of bit 33.  The task
+     * waiting for bit 50 is in the shared list, which is always visited. */
+    TEST_ASSERT_EQUAL( 2, set_bits( BIT_33 ) );
+    TEST_ASSERT_EQUAL( 0, uxTasksUnblocked );
+
+    TEST_ASSERT_EQUAL( 2, set_bits( BIT_47 ) );
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblockedByBits );
+
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_50 ) );
+    TEST_ASSERT_TRUE( xWaiters[ 1 ].xUnblockedByBits );
+}
+
+/*!
+ * @brief validate tasks waiting for bits above 31 are unblocked when the bits
+ * are set, and that the returned bits are not truncated
+ * @coverage xEventGroupWaitBits xEventGroupSetBits
+ */
+void test_xEventGroupWaitBits_BitsAbove31( void )
+{
+    add_waiter( BIT_33 | BIT_47, pdTRUE, pdTRUE );
+    add_waiter( BIT_50, pdFALSE, pdFALSE );
+
+    run_waiters( set_high_bits );
+
+    TEST_ASSERT_EQUAL_UINT64( BIT_33 | BIT_47, xWaiters[ 0 ].uxReturn );
+    TEST_ASSERT_EQUAL_UINT64( BIT_50, xWaiters[ 1 ].uxReturn );
+    TEST_ASSERT_EQUAL_UINT64( BIT_50, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+static void set_unrelated_bit( void )
+{
+    ( void ) set_bits( BIT_55 );
+}
+
+/*!
+ * @brief validate a task that times out is returned all 64 bits
+ * @coverage xEventGroupWaitBits
+ */
+void test_xEventGroupWaitBits_TimeoutReturnsBitsAbove31( void )
+{
+    ( void ) set_bits( BIT_52 );
+    add_waiter( BIT_40, pdTRUE, pdFALSE );
+
+    run_waiters( set_unrelated_bit );
+
+    TEST_ASSERT_FALSE( xWaiters[ 0 ].xUnblockedByBits );
+    TEST_ASSERT_EQUAL_UINT64( BIT_52 | BIT_55, xWaiters[ 0 ].uxReturn );
+}
+
+static void set_second_sync_bit( void )
+{
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_52 ) );
+    TEST_ASSERT_EQUAL( 1, uxTasksUnblocked );
+}
+
+/*!
+ * @brief validate a rendezvous on bits above 31
+ * @coverage xEventGroupSync
+ */
+void test_xEventGroupSync_BitsAbove31( void )
+{
+    add_sync_waiter( BIT_40, BIT_40 | BIT_52 );
+
+    run_waiters( set_second_sync_bit );
+
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblockedByBits );
+    TEST_ASSERT_EQUAL_UINT64( BIT_40 | BIT_52, xWaiters[ 0 ].uxReturn );
+    TEST_ASSERT_EQUAL_UINT64( 0, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+/*!
+ * @brief validate the control bits at the top of the 64-bit value cannot be
+ * set or waited for
+ * @coverage xEventGroupSetBits xEventGroupWaitBits
+ */
+void test_xEventGroup_ControlBitsAssert( void )
+{
+    EXPECT_ASSERT_BREAK( ( void ) xEventGroupSetBits( xEventGroupHandle, BIT_56 ) );
+    validate_and_clear_assertions();
+
+    EXPECT_ASSERT_BREAK( ( void ) xEventGroupWaitBits( xEventGroupHandle, BIT_63, pdFALSE, pdFALSE, TEST_EVENT_GROUP_TICKS ) );
+    validate_and_clear_assertions();
+
+    TEST_ASSERT_EQUAL_UINT64( 0, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+/*!
+ * @brief validate bits 0 to 31 can be set and cleared from an interrupt
+ * @coverage xEventGroupSetBitsFromISR xEventGroupClearBitsFromISR
+ */
+void test_xEventGroupFromISR_Bit31( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    xTimerPendFunctionCallFromISR_ExpectAndReturn( vEventGroupSetBitsCallback, xEventGroupHandle, 0x80000000UL, &xHigherPriorityTaskWoken, pdPASS );
+    TEST_ASSERT_EQUAL( pdPASS, xEventGroupSetBitsFromISR( xEventGroupHandle, BIT_31, &xHigherPriorityTaskWoken ) );
+
+    xTimerPendFunctionCallFromISR_ExpectAndReturn( vEventGroupClearBitsCallback, xEventGroupHandle, 0x80000000UL, NULL, pdPASS );
+    TEST_ASSERT_EQUAL( pdPASS, xEventGroupClearBitsFromISR( xEventGroupHandle, BIT_31 ) );
+}
+
+/*!
+ * @brief validate bits above 31, which cannot be passed to the timer service
+ * task, cannot be set or cleared from an interrupt
+ * @coverage xEventGroupSetBitsFromISR xEventGroupClearBitsFromISR
+ */
+void test_xEventGroupFromISR_BitsAbove31Assert( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    EXPECT_ASSERT_BREAK( ( void ) xEventGroupSetBitsFromISR( xEventGroupHandle, BIT_32, &xHigherPriorityTaskWoken ) );
+    validate_and_clear_assertions();
+
+    EXPECT_ASSERT_BREAK( ( void ) xEventGroupClearBitsFromISR( xEventGroupHandle, BIT_40 ) );
+    validate_and_clear_assertions();
+}
@@ -0,0 +1,663 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file event_groups_indexed_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Event Group includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "event_groups.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "unity_memory.h"
+#include "CException.h"
+
+/* Mock includes. */
+#include "mock_task.h"
+#include "mock_timers.h"
+#include "mock_list.h"
+#include "mock_list_macros.h"
+#include "mock_fake_assert.h"
+#include "mock_fake_port.h"
+
+/* ===========================  DEFINES CONSTANTS  ========================== */
+#define BIT_0                      ( 1 << 0 )
+#define BIT_1                      ( 1 << 1 )
+#define BIT_2                      ( 1 << 2 )
+#define BIT_3                      ( 1 << 3 )
+#define BIT_4                      ( 1 << 4 )
+#define BIT_5                      ( 1 << 5 )
+#define BIT_7                      ( 1 << 7 )
+
+/* Bits above configEVENT_GROUP_INDEXED_BITS, waited for in the shared list. */
+#define BIT_9                      ( 1 << 9 )
+#define BIT_12                     ( 1 << 12 )
+
+#define TEST_MAX_WAITERS           ( 4 )
+#define TEST_EVENT_GROUP_TICKS     ( 100 )
+
+/**
+ * @brief CException code for when a configASSERT should be intercepted.
+ */
+#define configASSERT_E             0xAA101
+
+/* ===========================  GLOBAL VARIABLES  =========================== */
+
+/**
+ * @brief A task that blocks on the event group.
+ */
+typedef struct
+{
+    ListItem_t xEventListItem;       /*< The task's event list item. */
+    BaseType_t xSync;                /*< Call xEventGroupSync() rather than xEventGroupWaitBits(). */
+    EventBits_t uxBitsToSet;         /*< The bits to set if xSync is pdTRUE. */
+    EventBits_t uxBitsToWaitFor;
+    BaseType_t xClearOnExit;
+    BaseType_t xWaitForAllBits;
+    List_t * pxEventList;            /*< The list the task was placed in when it blocked. */
+    BaseType_t xUnblockedByBits;     /*< Set when the task is removed from its list by the event group. */
+    EventBits_t uxReturn;            /*< The value returned to the task. */
+} Waiter_t;
+
+/**
+ * @brief Global event group handle used for tests.
+ */
+static EventGroupHandle_t xEventGroupHandle;
+static StaticEventGroup_t xStaticEventGroup;
+
+static Waiter_t xWaiters[ TEST_MAX_WAITERS ];
+static UBaseType_t uxWaiterCount;
+static UBaseType_t uxCurrentWaiter;
+
+/**
+ * @brief Run once every waiter has blocked, as if by another task.
+ */
+static void ( * pxWhileBlocked )( void );
+
+/**
+ * @brief The number of waiting tasks xEventGroupSetBits() looked at.
+ */
+static UBaseType_t uxItemsVisited;
+
+/**
+ * @brief The number of tasks unblocked by the event group.
+ */
+static UBaseType_t uxTasksUnblocked;
+
+/**
+ * @brief Global counter for the number of assertions in code.
+ */
+static int assertionFailed = 0;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+void * pvPortMalloc( size_t xSize )
+{
+    return unity_malloc( xSize );
+}
+void vPortFree( void * pv )
+{
+    return unity_free( pv );
+}
+
+static void vFakeAssertStub( bool x,
+                             char * file,
+                             int line,
+                             int cmock_num_calls )
+{
+    if( !x )
+    {
+        assertionFailed++;
+        Throw( configASSERT_E );
+    }
+}
+
+/* The list functions and macros are mocked, so provide the behaviour of list.c
+ * and list.h for the lists of waiting tasks. */
+static void vListInitialiseCallback( List_t * const pxList,
+                                     int cmock_num_calls )
+{
+    pxList->pxIndex = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.xItemValue = portMAX_DELAY;
+    pxList->xListEnd.pxNext = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.pxPrevious = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
+}
+
+static void vListInsertEndCallback( List_t * const pxList,
+                                    ListItem_t * const pxNewListItem,
+                                    int cmock_num_calls )
+{
+    ListItem_t * const pxIndex = pxList->pxIndex;
+
+    pxNewListItem->pxNext = pxIndex;
+    pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    pxIndex->pxPrevious->pxNext = pxNewListItem;
+    pxIndex->pxPrevious = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    ( pxList->uxNumberOfItems )++;
+}
+
+static UBaseType_t uxListRemoveCallback( ListItem_t * const pxItemToRemove,
+                                         int cmock_num_calls )
+{
+    List_t * const pxList = pxItemToRemove->pxContainer;
+
+    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+
+    if( pxList->pxIndex == pxItemToRemove )
+    {
+        pxList->pxIndex = pxItemToRemove->pxPrevious;
+    }
+
+    pxItemToRemove->pxContainer = NULL;
+    ( pxList->uxNumberOfItems )--;
+
+    return pxList->uxNumberOfItems;
+}
+
+static ListItem_t * listGET_END_MARKERCallback( const List_t * pxList,
+                                                int cmock_num_calls )
+{
+    return ( ListItem_t * ) &( pxList->xListEnd );
+}
+
+static ListItem_t * listGET_NEXTCallback( ListItem_t * pxListItem,
+                                          int cmock_num_calls )
+{
+    return pxListItem->pxNext;
+}
+
+static TickType_t listGET_LIST_ITEM_VALUECallback( ListItem_t * listItem,
+                                                   int cmock_num_calls )
+{
+    uxItemsVisited++;
+    return listItem->xItemValue;
+}
+
+static UBaseType_t listCURRENT_LIST_LENGTHCallback( const List_t * list,
+                                                    int cmock_num_calls )
+{
+    return list->uxNumberOfItems;
+}
+
+/* The task functions the event group uses to block and unblock tasks. */
+static void vTaskPlaceOnUnorderedEventListCallback( List_t * pxEventList,
+                                                    const TickType_t xItemValue,
+                                                    const TickType_t xTicksToWait,
+                                                    int cmock_num_calls )
+{
+    Waiter_t * const pxWaiter = &( xWaiters[ uxCurrentWaiter ] );
+
+    TEST_ASSERT_EQUAL( TEST_EVENT_GROUP_TICKS, xTicksToWait );
+    pxWaiter->pxEventList = pxEventList;
+    pxWaiter->xEventListItem.xItemValue = xItemValue;
+    vListInsertEndCallback( pxEventList, &( pxWaiter->xEventListItem ), 0 );
+}
+
+static void vTaskRemoveFromUnorderedEventListCallback( ListItem_t * pxEventListItem,
+                                                       const TickType_t xItemValue,
+                                                       int cmock_num_calls )
+{
+    UBaseType_t uxWaiter;
+
+    for( uxWaiter = 0; uxWaiter < uxWaiterCount; uxWaiter++ )
+    {
+        if( pxEventListItem == &( xWaiters[ uxWaiter ].xEventListItem ) )
+        {
+            xWaiters[ uxWaiter ].xUnblockedByBits = pdTRUE;
+        }
+    }
+
+    uxTasksUnblocked++;
+    pxEventListItem->xItemValue = xItemValue;
+    ( void ) uxListRemoveCallback( pxEventListItem, 0 );
+}
+
+static TickType_t uxTaskResetEventItemValueCallback( int cmock_num_calls )
+{
+    Waiter_t * const pxWaiter = &( xWaiters[ uxCurrentWaiter ] );
+
+    if( pxWaiter->xEventListItem.pxContainer != NULL )
+    {
+        /* The block time expired while the task was still waiting. */
+        ( void ) uxListRemoveCallback( &( pxWaiter->xEventListItem ), 0 );
+    }
+
+    return pxWaiter->xEventListItem.xItemValue;
+}
+
+/* ===========================  Static Functions  =========================== */
+
+static void block_waiter( UBaseType_t uxWaiter )
+{
+    Waiter_t * const pxWaiter = &( xWaiters[ uxWaiter ] );
+    const UBaseType_t uxPreviousWaiter = uxCurrentWaiter;
+
+    uxCurrentWaiter = uxWaiter;
+
+    if( pxWaiter->xSync != pdFALSE )
+    {
+        pxWaiter->uxReturn = xEventGroupSync( xEventGroupHandle,
+                                              pxWaiter->uxBitsToSet,
+                                              pxWaiter->uxBitsToWaitFor,
+                                              TEST_EVENT_GROUP_TICKS );
+    }
+    else
+    {
+        pxWaiter->uxReturn = xEventGroupWaitBits( xEventGroupHandle,
+                                                  pxWaiter->uxBitsToWaitFor,
+                                                  pxWaiter->xClearOnExit,
+                                                  pxWaiter->xWaitForAllBits,
+                                                  TEST_EVENT_GROUP_TICKS );
+    }
+
+    uxCurrentWaiter = uxPreviousWaiter;
+}
+
+/* The calling waiter has blocked, so let the next one run, or once they have
+ * all blocked run the test's action. */
+static void vFakePortYieldWithinAPICallback( int cmock_num_calls )
+{
+    if( ( uxCurrentWaiter + 1 ) < uxWaiterCount )
+    {
+        block_waiter( uxCurrentWaiter + 1 );
+    }
+    else
+    {
+        pxWhileBlocked();
+    }
+}
+
+static void add_waiter( EventBits_t uxBitsToWaitFor,
+                        BaseType_t xClearOnExit,
+                        BaseType_t xWaitForAllBits )
+{
+    TEST_ASSERT_LESS_THAN( TEST_MAX_WAITERS, uxWaiterCount );
+    xWaiters[ uxWaiterCount ].uxBitsToWaitFor = uxBitsToWaitFor;
+    xWaiters[ uxWaiterCount ].xClearOnExit = xClearOnExit;
+    xWaiters[ uxWaiterCount ].xWaitForAllBits = xWaitForAllBits;
+    uxWaiterCount++;
+}
+
+static void add_sync_waiter( EventBits_t uxBitsToSet,
+                             EventBits_t uxBitsToWaitFor )
+{
+    TEST_ASSERT_LESS_THAN( TEST_MAX_WAITERS, uxWaiterCount );
+    xWaiters[ uxWaiterCount ].xSync = pdTRUE;
+    xWaiters[ uxWaiterCount ].uxBitsToSet = uxBitsToSet;
+    xWaiters[ uxWaiterCount ].uxBitsToWaitFor = uxBitsToWaitFor;
+    uxWaiterCount++;
+}
+
+/* Block every waiter in turn, run pxAction while they are all blocked, then
+ * let each waiter return. */
+static void run_waiters( void ( * pxAction )( void ) )
+{
+    pxWhileBlocked = pxAction;
+    block_waiter( 0 );
+}
+
+/* Set bits as another task, and return the number of waiting tasks visited. */
+static UBaseType_t set_bits( EventBits_t uxBitsToSet )
+{
+    uxItemsVisited = 0;
+    ( void ) xEventGroupSetBits( xEventGroupHandle, uxBitsToSet );
+    return uxItemsVisited;
+}
+
+/* ============================  Unity Fixtures  ============================ */
+/*! called before each testcase */
+void setUp( void )
+{
+    memset( xWaiters, 0, sizeof( xWaiters ) );
+    uxWaiterCount = 0;
+    uxCurrentWaiter = 0;
+    pxWhileBlocked = NULL;
+    uxItemsVisited = 0;
+    uxTasksUnblocked = 0;
+    assertionFailed = 0;
+
+    vFakeAssert_StubWithCallback( vFakeAssertStub );
+    vFakePortEnterCriticalSection_Ignore();
+    vFakePortExitCriticalSection_Ignore();
+    vFakePortYieldWithinAPI_StubWithCallback( vFakePortYieldWithinAPICallback );
+
+    vListInitialise_StubWithCallback( vListInitialiseCallback );
+    vListInsertEnd_StubWithCallback( vListInsertEndCallback );
+    uxListRemove_StubWithCallback( uxListRemoveCallback );
+    listGET_END_MARKER_StubWithCallback( listGET_END_MARKERCallback );
+    listGET_NEXT_StubWithCallback( listGET_NEXTCallback );
+    listGET_LIST_ITEM_VALUE_StubWithCallback( listGET_LIST_ITEM_VALUECallback );
+    listCURRENT_LIST_LENGTH_StubWithCallback( listCURRENT_LIST_LENGTHCallback );
+
+    xTaskGetSchedulerState_IgnoreAndReturn( taskSCHEDULER_RUNNING );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdFALSE );
+    vTaskPlaceOnUnorderedEventList_StubWithCallback( vTaskPlaceOnUnorderedEventListCallback );
+    vTaskRemoveFromUnorderedEventList_StubWithCallback( vTaskRemoveFromUnorderedEventListCallback );
+    uxTaskResetEventItemValue_StubWithCallback( uxTaskResetEventItemValueCallback );
+
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+
+    xEventGroupHandle = xEventGroupCreateStatic( &xStaticEventGroup );
+    TEST_ASSERT_NOT_NULL( xEventGroupHandle );
+}
+
+/*! called after each testcase */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL_MESSAGE( 0, assertionFailed, "Assertion check failed in code." );
+    UnityMalloc_EndTest();
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ==============================  Test Cases  ============================== */
+
+static void set_bits_one_at_a_time( void )
+{
+    /* Only the task waiting for bit 0 is visited. */
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_0 ) );
+    TEST_ASSERT_EQUAL( 1, uxTasksUnblocked );
+    TEST_ASSERT_TRUE( xWaiters[ 3 ].xUnblockedByBits );
+
+    /* Both tasks waiting for bit 1 are visited and unblocked. */
+    TEST_ASSERT_EQUAL( 2, set_bits( BIT_1 ) );
+    TEST_ASSERT_EQUAL( 3, uxTasksUnblocked );
+
+    /* Nobody is waiting for bit 5. */
+    TEST_ASSERT_EQUAL( 0, set_bits( BIT_5 ) );
+    TEST_ASSERT_EQUAL( 3, uxTasksUnblocked );
+}
+
+/*!
+ * @brief validate that setting bits only visits the tasks waiting for those bits
+ * @coverage xEventGroupWaitBits xEventGroupSetBits
+ */
+void test_xEventGroupSetBits_VisitsOnlyWaitersOfBitsSet( void )
+{
+    add_waiter( BIT_1, pdFALSE, pdFALSE );
+    add_waiter( BIT_2, pdFALSE, pdFALSE );
+    add_waiter( BIT_1, pdFALSE, pdFALSE );
+    add_waiter( BIT_0, pdFALSE, pdFALSE );
+
+    run_waiters( set_bits_one_at_a_time );
+
+    /* Tasks waiting for the same bit share a list. */
+    TEST_ASSERT_EQUAL_PTR( xWaiters[ 0 ].pxEventList, xWaiters[ 2 ].pxEventList );
+    TEST_ASSERT_NOT_EQUAL( xWaiters[ 0 ].pxEventList, xWaiters[ 1 ].pxEventList );
+    TEST_ASSERT_NOT_EQUAL( xWaiters[ 0 ].pxEventList, xWaiters[ 3 ].pxEventList );
+    TEST_ASSERT_NOT_EQUAL( xWaiters[ 1 ].pxEventList, xWaiters[ 3 ].pxEventList );
+
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_1, xWaiters[ 0 ].uxReturn );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_1, xWaiters[ 2 ].uxReturn );
+    TEST_ASSERT_EQUAL( BIT_0, xWaiters[ 3 ].uxReturn );
+
+    /* The task waiting for bit 2 timed out. */
+    TEST_ASSERT_FALSE( xWaiters[ 1 ].xUnblockedByBits );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_1 | BIT_5, xWaiters[ 1 ].uxReturn );
+}
+
+static void set_bits_for_all_bits_waiter( void )
+{
+    /* Bit 0 is set, but bits 1 and 2 are not, so the task moves to the list
+     * of bit 1. */
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_0 ) );
+    TEST_ASSERT_EQUAL( 0, uxTasksUnblocked );
+
+    /* The task is in neither the list of bit 2 nor the list of bit 0. */
+    TEST_ASSERT_EQUAL( 0, set_bits( BIT_2 ) );
+    TEST_ASSERT_EQUAL( 0, set_bits( BIT_0 ) );
+
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_1 ) );
+    TEST_ASSERT_EQUAL( 1, uxTasksUnblocked );
+
+    /* The bits were cleared on exit. */
+    TEST_ASSERT_EQUAL( 0, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+/*!
+ * @brief validate a task waiting for all of several bits moves between the
+ * lists of the bits as they are set
+ * @coverage xEventGroupWaitBits xEventGroupSetBits
+ */
+void test_xEventGroupWaitBits_WaitForAllMovesToNextClearBit( void )
+{
+    add_waiter( BIT_0 | BIT_1 | BIT_2, pdTRUE, pdTRUE );
+
+    run_waiters( set_bits_for_all_bits_waiter );
+
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblockedByBits );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_1 | BIT_2, xWaiters[ 0 ].uxReturn );
+}
+
+static void set_already_set_bit( void )
+{
+    /* The task is in the list of bit 3, the lowest bit that was clear. */
+    TEST_ASSERT_EQUAL( 0, set_bits( BIT_1 ) );
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_3 ) );
+    TEST_ASSERT_EQUAL( 1, uxTasksUnblocked );
+}
+
+/*!
+ * @brief validate a task waiting for all of several bits, some of which are
+ * already set, is placed in the list of the lowest bit still clear
+ * @coverage xEventGroupWaitBits xEventGroupSetBits
+ */
+void test_xEventGroupWaitBits_WaitForAllPlacedByLowestClearBit( void )
+{
+    ( void ) set_bits( BIT_1 );
+    add_waiter( BIT_1 | BIT_3, pdFALSE, pdTRUE );
+
+    run_waiters( set_already_set_bit );
+
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblockedByBits );
+    TEST_ASSERT_EQUAL( BIT_1 | BIT_3, xWaiters[ 0 ].uxReturn );
+    TEST_ASSERT_EQUAL( BIT_1 | BIT_3, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+static void set_bits_for_shared_list( void )
+{
+    /* Both tasks are visited whichever bit is set. */
+    TEST_ASSERT_EQUAL( 2, set_bits( BIT_3 ) );
+    TEST_ASSERT_EQUAL( 0, uxTasksUnblocked );
+
+    TEST_ASSERT_EQUAL( 2, set_bits( BIT_1 ) );
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblockedByBits );
+
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_9 ) );
+    TEST_ASSERT_TRUE( xWaiters[ 1 ].xUnblockedByBits );
+}
+
+/*!
+ * @brief validate tasks waiting for any of several bits, or for bits that are
+ * not indexed, are held in the shared list
+ * @coverage xEventGroupWaitBits xEventGroupSetBits
+ */
+void test_xEventGroupWaitBits_AnyOfSeveralBitsUsesSharedList( void )
+{
+    add_waiter( BIT_0 | BIT_1, pdTRUE, pdFALSE );
+    add_waiter( BIT_9, pdFALSE, pdFALSE );
+
+    run_waiters( set_bits_for_shared_list );
+
+    TEST_ASSERT_EQUAL_PTR( xWaiters[ 0 ].pxEventList, xWaiters[ 1 ].pxEventList );
+    TEST_ASSERT_EQUAL( BIT_1 | BIT_3, xWaiters[ 0 ].uxReturn );
+    TEST_ASSERT_EQUAL( BIT_3 | BIT_9, xWaiters[ 1 ].uxReturn );
+    /* Bit 1 was cleared when the first task was unblocked. */
+    TEST_ASSERT_EQUAL( BIT_3 | BIT_9, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+static void set_other_bit( void )
+{
+    TEST_ASSERT_EQUAL( 0, set_bits( BIT_1 ) );
+}
+
+/*!
+ * @brief validate a task that times out is no longer visited when its bit is set
+ * @coverage xEventGroupWaitBits xEventGroupSetBits
+ */
+void test_xEventGroupWaitBits_TimeoutRemovesWaiter( void )
+{
+    add_waiter( BIT_0, pdTRUE, pdFALSE );
+
+    run_waiters( set_other_bit );
+
+    TEST_ASSERT_FALSE( xWaiters[ 0 ].xUnblockedByBits );
+    TEST_ASSERT_EQUAL( BIT_1, xWaiters[ 0 ].uxReturn );
+
+    TEST_ASSERT_EQUAL( 0, set_bits( BIT_0 ) );
+    TEST_ASSERT_EQUAL( 0, uxTasksUnblocked );
+}
+
+static void set_second_sync_bit( void )
+{
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_1 ) );
+    TEST_ASSERT_EQUAL( 1, uxTasksUnblocked );
+}
+
+/*!
+ * @brief validate a task in a rendezvous waits in the list of a bit that is
+ * still clear
+ * @coverage xEventGroupSync xEventGroupSetBits
+ */
+void test_xEventGroupSync_WaitsInListOfClearBit( void )
+{
+    add_sync_waiter( BIT_0, BIT_0 | BIT_1 );
+
+    run_waiters( set_second_sync_bit );
+
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblockedByBits );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_1, xWaiters[ 0 ].uxReturn );
+    TEST_ASSERT_EQUAL( 0, xEventGroupGetBits( xEventGroupHandle ) );
+}
+
+static void delete_event_group( void )
+{
+    vEventGroupDelete( xEventGroupHandle );
+    TEST_ASSERT_EQUAL( 4, uxTasksUnblocked );
+}
+
+/*!
+ * @brief validate deleting an event group unblocks the tasks in every list
+ * @coverage vEventGroupDelete
+ */
+void test_vEventGroupDelete_UnblocksWaitersInEveryList( void )
+{
+    UBaseType_t uxWaiter;
+
+    add_waiter( BIT_0, pdFALSE, pdFALSE );
+    add_waiter( BIT_7, pdFALSE, pdFALSE );
+    add_waiter( BIT_0 | BIT_1, pdFALSE, pdFALSE );
+    add_waiter( BIT_12, pdFALSE, pdTRUE );
+
+    run_waiters( delete_event_group );
+
+    for( uxWaiter = 0; uxWaiter < uxWaiterCount; uxWaiter++ )
+    {
+        TEST_ASSERT_TRUE( xWaiters[ uxWaiter ].xUnblockedByBits );
+        TEST_ASSERT_EQUAL( 0, xWaiters[ uxWaiter ].uxReturn );
+    }
+}
+
+static void set_bit_from_isr( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    xTimerPendFunctionCallFromISR_ExpectAndReturn( vEventGroupSetBitsCallback, xEventGroupHandle, BIT_4, &xHigherPriorityTaskWoken, pdPASS );
+    TEST_ASSERT_EQUAL( pdPASS, xEventGroupSetBitsFromISR( xEventGroupHandle, BIT_4, &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( 0, uxTasksUnblocked );
+
+    /* The timer service task sets the bits. */
+    uxItemsVisited = 0;
+    vEventGroupSetBitsCallback( xEventGroupHandle, BIT_4 );
+    TEST_ASSERT_EQUAL( 1, uxItemsVisited );
+    TEST_ASSERT_EQUAL( 1, uxTasksUnblocked );
+}
+
+/*!
+ * @brief validate setting a bit from an interrupt unblocks the task waiting
+ * in the bit's list
+ * @coverage xEventGroupSetBitsFromISR vEventGroupSetBitsCallback
+ */
+void test_xEventGroupSetBitsFromISR_UnblocksIndexedWaiter( void )
+{
+    add_waiter( BIT_4, pdFALSE, pdFALSE );
+
+    run_waiters( set_bit_from_isr );
+
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblockedByBits );
+    TEST_ASSERT_EQUAL( BIT_4, xWaiters[ 0 ].uxReturn );
+}
+
+static void clear_bit_from_isr( void )
+{
+    /* The task moves to the list of bit 1. */
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_0 ) );
+
+    xTimerPendFunctionCallFromISR_ExpectAndReturn( vEventGroupClearBitsCallback, xEventGroupHandle, BIT_0, NULL, pdPASS );
+    TEST_ASSERT_EQUAL( pdPASS, xEventGroupClearBitsFromISR( xEventGroupHandle, BIT_0 ) );
+    vEventGroupClearBitsCallback( xEventGroupHandle, BIT_0 );
+
+    /* Bit 0 is clear again, so the task moves back to the list of bit 0. */
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_1 ) );
+    TEST_ASSERT_EQUAL( 0, uxTasksUnblocked );
+
+    TEST_ASSERT_EQUAL( 1, set_bits( BIT_0 ) );
+    TEST_ASSERT_EQUAL( 1, uxTasksUnblocked );
+}
+
+/*!
+ * @brief validate a task waiting for all of several bits moves back to the
+ * list of a bit cleared from an interrupt
+ * @coverage xEventGroupClearBitsFromISR vEventGroupClearBitsCallback xEventGroupSetBits
+ */
+void test_xEventGroupClearBitsFromISR_WaiterMovesToClearedBit( void )
+{
+    add_waiter( BIT_0 | BIT_1, pdFALSE, pdTRUE );
+
+    run_waiters( clear_bit_from_isr );
+
+    TEST_ASSERT_TRUE( xWaiters[ 0 ].xUnblockedByBits );
+    TEST_ASSERT_EQUAL( BIT_0 | BIT_1, xWaiters[ 0 ].uxReturn );
+}
@@ -28,6 +28,7 @@
 /* C runtime includes. */
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 
 /* Message Buffer includes */
 #include "FreeRTOS.h"
@@ -137,6 +138,26 @@ static MessageBufferHandle_t xMessageBuffer;
  */
 static BaseType_t shouldAbortOnAssertion;
 
+/**
+ * @brief Number of messages in the batches sent by the tests.
+ */
+#define TEST_BATCH_MESSAGES    ( 3U )
+
+/**
+ * @brief Messages sent as a batch by the tests, each a different length.
+ */
+static const uint8_t batchMessage0[] = { 0x10 };
+static const uint8_t batchMessage1[] = { 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
+static const uint8_t batchMessage2[] = { 0x30, 0x31, 0x32 };
+
+static const void * const batchMessages[ TEST_BATCH_MESSAGES ] = { batchMessage0, batchMessage1, batchMessage2 };
+static const size_t batchMessageLengths[ TEST_BATCH_MESSAGES ] = { sizeof( batchMessage0 ), sizeof( batchMessage1 ), sizeof( batchMessage2 ) };
+
+/**
+ * @brief Total number of data bytes in a batch.
+ */
+#define TEST_BATCH_BYTES    ( sizeof( batchMessage0 ) + sizeof( batchMessage1 ) + sizeof( batchMessage2 ) )
+
 /* ==========================  CALLBACK FUNCTIONS =========================== */
 
 void * pvPortMalloc( size_t xSize )
@@ -240,6 +261,54 @@ static BaseType_t messageBufferSendCallback( UBaseType_t uxIndexToWaitOn,
     return pdTRUE;
 }
 
+static BaseType_t messageBufferSendMultipleCallback( UBaseType_t uxIndexToWaitOn,
+                                                     uint32_t ulBitsToClearOnEntry,
+                                                     uint32_t ulBitsToClearOnExit,
+                                                     uint32_t * pulNotificationValue,
+                                                     TickType_t xTicksToWait,
+                                                     int cmock_num_calls )
+{
+    size_t messagesSent = 0;
+
+    /* Send a batch of messages to wake up the receiver task. */
+    messagesSent = xMessageBufferSendMultiple( xMessageBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, 0 );
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES, messagesSent );
+    return pdTRUE;
+}
+
+static BaseType_t messageBufferSendMultipleFromISRCallback( UBaseType_t uxIndexToWaitOn,
+                                                            uint32_t ulBitsToClearOnEntry,
+                                                            uint32_t ulBitsToClearOnExit,
+                                                            uint32_t * pulNotificationValue,
+                                                            TickType_t xTicksToWait,
+                                                            int cmock_num_calls )
+{
+    BaseType_t receiverTaskWokenFromISR = pdFALSE;
+    size_t messagesSent = 0;
+
+    messagesSent = xMessageBufferSendMultipleFromISR( xMessageBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, &receiverTaskWokenFromISR );
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES, messagesSent );
+    TEST_ASSERT_EQUAL( pdTRUE, receiverTaskWokenFromISR );
+    return pdTRUE;
+}
+
+static BaseType_t messageBufferReceiveMultipleFromISRCallback( UBaseType_t uxIndexToWaitOn,
+                                                               uint32_t ulBitsToClearOnEntry,
+                                                               uint32_t ulBitsToClearOnExit,
+                                                               uint32_t * pulNotificationValue,
+                                                               TickType_t xTicksToWait,
+                                                               int cmock_num_calls )
+{
+    uint8_t data[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t lengths[ 2 ] = { 0 };
+    BaseType_t senderTaskWokenFromISR = pdFALSE;
+
+    TEST_ASSERT_EQUAL( 1, xMessageBufferReceiveMultipleFromISR( xMessageBuffer, data, sizeof( data ), lengths, 2, &senderTaskWokenFromISR ) );
+    TEST_ASSERT_EQUAL( TEST_MAX_MESSAGE_SIZE, lengths[ 0 ] );
+    TEST_ASSERT_EQUAL( pdTRUE, senderTaskWokenFromISR );
+    return pdTRUE;
+}
+
 static BaseType_t receiverTaskNotificationCallback( TaskHandle_t xTaskToNotify,
                                                     UBaseType_t uxIndexToNotify,
                                                     uint32_t ulValue,
@@ -798,3 +867,465 @@ void test_xMessageBufferReceiveFromISR_success( void )
 
     vStreamBufferDelete( xMessageBuffer );
 }
+
+/**
+ * @brief Validates that a received batch holds the messages of batchMessages, packed one after another.
+ */
+static void validate_received_batch( const uint8_t * data,
+                                     const size_t * lengths,
+                                     size_t messageCount )
+{
+    size_t offset = 0;
+
+    for( size_t i = 0; i < messageCount; i++ )
+    {
+        TEST_ASSERT_EQUAL( batchMessageLengths[ i ], lengths[ i ] );
+        TEST_ASSERT_EQUAL_MEMORY( batchMessages[ i ], &data[ offset ], lengths[ i ] );
+        offset += lengths[ i ];
+    }
+}
+
+/**
+ * @brief Validates that a batch of messages is sent in one call and each message can be received on its own.
+ */
+void test_xMessageBufferSendMultiple_success( void )
+{
+    uint8_t data[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t sent = 0, received = 0;
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    sent = xMessageBufferSendMultiple( xMessageBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, 0 );
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES, sent );
+    TEST_ASSERT_EQUAL( TEST_MESSAGE_BUFFER_SIZE - TEST_BATCH_BYTES - ( TEST_BATCH_MESSAGES * TEST_MESSAGE_METADATA_SIZE ),
+                       xMessageBufferSpacesAvailable( xMessageBuffer ) );
+
+    for( size_t i = 0; i < TEST_BATCH_MESSAGES; i++ )
+    {
+        received = xMessageBufferReceive( xMessageBuffer, data, sizeof( data ), 0 );
+        TEST_ASSERT_EQUAL( batchMessageLengths[ i ], received );
+        TEST_ASSERT_EQUAL_MEMORY( batchMessages[ i ], data, received );
+    }
+
+    TEST_ASSERT_TRUE( xMessageBufferIsEmpty( xMessageBuffer ) );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that only the messages that fit in the buffer are sent, in order, and that
+ * sending stops at a zero length message.
+ */
+void test_xMessageBufferSendMultiple_partial( void )
+{
+    const size_t messageLength = ( TEST_MESSAGE_BUFFER_SIZE / 2U ) - TEST_MESSAGE_METADATA_SIZE;
+    uint8_t message[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    const void * messages[ 3 ] = { message, message, message };
+    size_t lengths[ 3 ] = { messageLength, messageLength, messageLength };
+    size_t sent = 0;
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    /* Only two of the three messages fit. */
+    sent = xMessageBufferSendMultiple( xMessageBuffer, messages, lengths, 3, 0 );
+    TEST_ASSERT_EQUAL( 2, sent );
+    TEST_ASSERT_EQUAL( 0, xMessageBufferSpacesAvailable( xMessageBuffer ) );
+
+    TEST_ASSERT_EQUAL( pdPASS, xMessageBufferReset( xMessageBuffer ) );
+
+    /* A zero length message ends the batch. */
+    lengths[ 1 ] = 0;
+    sent = xMessageBufferSendMultiple( xMessageBuffer, messages, lengths, 3, 0 );
+    TEST_ASSERT_EQUAL( 1, sent );
+
+    /* An empty batch is not sent, and does not wait. */
+    sent = xMessageBufferSendMultiple( xMessageBuffer, messages, lengths, 0, TEST_MESSAGE_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( 0, sent );
+
+    /* Neither does a batch whose first message could never fit. */
+    lengths[ 0 ] = TEST_MESSAGE_BUFFER_SIZE;
+    sent = xMessageBufferSendMultiple( xMessageBuffer, messages, lengths, 3, TEST_MESSAGE_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( 0, sent );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that sending a batch to a full buffer blocks until a message is received, then
+ * sends the messages that fit.
+ */
+void test_xMessageBufferSendMultiple_blocking( void )
+{
+    uint8_t message[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t sent = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+    xTaskGenericNotifyWait_StubWithCallback( messageBufferReceiveCallback );
+    xTaskGenericNotify_StubWithCallback( senderTaskNotificationCallback );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdFALSE );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    sent = xMessageBufferSend( xMessageBuffer, message, TEST_MAX_MESSAGE_SIZE, 0 );
+    TEST_ASSERT_EQUAL( TEST_MAX_MESSAGE_SIZE, sent );
+
+    /* The buffer is full, so the task blocks until the receive callback has emptied it. */
+    sent = xMessageBufferSendMultiple( xMessageBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, TEST_MESSAGE_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES, sent );
+    TEST_ASSERT_EQUAL( 1, senderTaskWoken );
+    TEST_ASSERT_EQUAL( batchMessageLengths[ 0 ], xStreamBufferNextMessageLengthBytes( xMessageBuffer ) );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that sending a batch to a buffer that stays full returns 0 once the block time expires.
+ */
+void test_xMessageBufferSendMultiple_blocking_timeout( void )
+{
+    uint8_t message[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t sent = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+    xTaskGenericNotifyWait_IgnoreAndReturn( pdFALSE );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdTRUE );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    sent = xMessageBufferSend( xMessageBuffer, message, TEST_MAX_MESSAGE_SIZE, 0 );
+    TEST_ASSERT_EQUAL( TEST_MAX_MESSAGE_SIZE, sent );
+
+    sent = xMessageBufferSendMultiple( xMessageBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, TEST_MESSAGE_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( 0, sent );
+    TEST_ASSERT_EQUAL( TEST_MAX_MESSAGE_SIZE, xStreamBufferNextMessageLengthBytes( xMessageBuffer ) );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that a batch of messages is received packed into one buffer, limited by the
+ * number of messages and by the space left in the buffer.
+ */
+void test_xMessageBufferReceiveMultiple_success( void )
+{
+    uint8_t data[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t lengths[ TEST_BATCH_MESSAGES ] = { 0 };
+    size_t received = 0;
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    /* Nothing to receive. */
+    received = xMessageBufferReceiveMultiple( xMessageBuffer, data, sizeof( data ), lengths, TEST_BATCH_MESSAGES, 0 );
+    TEST_ASSERT_EQUAL( 0, received );
+
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES, xMessageBufferSendMultiple( xMessageBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, 0 ) );
+
+    /* At most xMaxMessages messages are received. */
+    received = xMessageBufferReceiveMultiple( xMessageBuffer, data, sizeof( data ), lengths, 1, 0 );
+    TEST_ASSERT_EQUAL( 1, received );
+    validate_received_batch( data, lengths, received );
+
+    /* The second message does not fit in what is left of the buffer after the first. */
+    received = xMessageBufferReceiveMultiple( xMessageBuffer, data, sizeof( batchMessage1 ) + sizeof( batchMessage2 ) - 1, lengths, TEST_BATCH_MESSAGES, 0 );
+    TEST_ASSERT_EQUAL( 1, received );
+    TEST_ASSERT_EQUAL( sizeof( batchMessage1 ), lengths[ 0 ] );
+    TEST_ASSERT_EQUAL_MEMORY( batchMessage1, data, lengths[ 0 ] );
+
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES, xMessageBufferSendMultiple( xMessageBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, 0 ) );
+
+    /* The rest, which wraps around the end of the buffer, is received in one go. */
+    received = xMessageBufferReceiveMultiple( xMessageBuffer, data, sizeof( data ), lengths, TEST_BATCH_MESSAGES + 1, 0 );
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES + 1, received );
+    TEST_ASSERT_EQUAL( sizeof( batchMessage2 ), lengths[ 0 ] );
+    TEST_ASSERT_EQUAL_MEMORY( batchMessage2, data, lengths[ 0 ] );
+    validate_received_batch( &data[ sizeof( batchMessage2 ) ], &lengths[ 1 ], TEST_BATCH_MESSAGES );
+
+    TEST_ASSERT_TRUE( xMessageBufferIsEmpty( xMessageBuffer ) );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that a task blocked receiving a batch is notified once for a whole batch sent
+ * by another task, and receives all of it.
+ */
+void test_xMessageBufferReceiveMultiple_blocking( void )
+{
+    uint8_t data[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t lengths[ TEST_BATCH_MESSAGES ] = { 0 };
+    size_t received = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_StubWithCallback( messageBufferSendMultipleCallback );
+    xTaskGenericNotify_StubWithCallback( receiverTaskNotificationCallback );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdFALSE );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    received = xMessageBufferReceiveMultiple( xMessageBuffer, data, sizeof( data ), lengths, TEST_BATCH_MESSAGES, TEST_MESSAGE_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES, received );
+    TEST_ASSERT_EQUAL( 1, receiverTaskWoken );
+    validate_received_batch( data, lengths, received );
+
+    /* A zero length batch does not wait. */
+    received = xMessageBufferReceiveMultiple( xMessageBuffer, data, sizeof( data ), lengths, 0, TEST_MESSAGE_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( 0, received );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that receiving a batch from a buffer that stays empty returns 0 once the block time expires.
+ */
+void test_xMessageBufferReceiveMultiple_blocking_timeout( void )
+{
+    uint8_t data[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t lengths[ TEST_BATCH_MESSAGES ] = { 0 };
+    size_t received = 0;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_IgnoreAndReturn( pdFALSE );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    received = xMessageBufferReceiveMultiple( xMessageBuffer, data, sizeof( data ), lengths, TEST_BATCH_MESSAGES, TEST_MESSAGE_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( 0, received );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that a batch sent from an ISR unblocks a task waiting to receive.
+ */
+void test_xMessageBufferSendMultipleFromISR_success( void )
+{
+    uint8_t data[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t lengths[ TEST_BATCH_MESSAGES ] = { 0 };
+    size_t received = 0;
+    BaseType_t highPriorityTaskWoken = pdFALSE;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_StubWithCallback( messageBufferSendMultipleFromISRCallback );
+    xTaskGenericNotifyFromISR_ExpectAndReturn( receiverTask, tskDEFAULT_INDEX_TO_NOTIFY, 0, eNoAction, NULL, NULL, pdTRUE );
+    xTaskGenericNotifyFromISR_IgnoreArg_pxHigherPriorityTaskWoken();
+    xTaskGenericNotifyFromISR_ReturnThruPtr_pxHigherPriorityTaskWoken( &( BaseType_t ) { pdTRUE } );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdFALSE );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    received = xMessageBufferReceiveMultiple( xMessageBuffer, data, sizeof( data ), lengths, TEST_BATCH_MESSAGES, TEST_MESSAGE_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES, received );
+    validate_received_batch( data, lengths, received );
+
+    /* No task is waiting now, so a batch from an ISR wakes nobody. */
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES, xMessageBufferSendMultipleFromISR( xMessageBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, &highPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( pdFALSE, highPriorityTaskWoken );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that a batch received from an ISR unblocks a task waiting to send, and that
+ * receiving from an empty buffer in an ISR returns 0.
+ */
+void test_xMessageBufferReceiveMultipleFromISR_success( void )
+{
+    uint8_t message[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t lengths[ TEST_BATCH_MESSAGES ] = { 0 };
+    size_t sent = 0;
+    BaseType_t highPriorityTaskWoken = pdFALSE;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+    xTaskGenericNotifyWait_StubWithCallback( messageBufferReceiveMultipleFromISRCallback );
+    xTaskGenericNotifyFromISR_ExpectAndReturn( senderTask, tskDEFAULT_INDEX_TO_NOTIFY, 0, eNoAction, NULL, NULL, pdTRUE );
+    xTaskGenericNotifyFromISR_IgnoreArg_pxHigherPriorityTaskWoken();
+    xTaskGenericNotifyFromISR_ReturnThruPtr_pxHigherPriorityTaskWoken( &( BaseType_t ) { pdTRUE } );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdFALSE );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    TEST_ASSERT_EQUAL( 0, xMessageBufferReceiveMultipleFromISR( xMessageBuffer, message, sizeof( message ), lengths, TEST_BATCH_MESSAGES, &highPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( pdFALSE, highPriorityTaskWoken );
+
+    sent = xMessageBufferSend( xMessageBuffer, message, TEST_MAX_MESSAGE_SIZE, 0 );
+    TEST_ASSERT_EQUAL( TEST_MAX_MESSAGE_SIZE, sent );
+
+    /* The buffer is full, so the batch waits until the ISR has received the message. */
+    sent = xMessageBufferSendMultiple( xMessageBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, TEST_MESSAGE_BUFFER_WAIT_TICKS );
+    TEST_ASSERT_EQUAL( TEST_BATCH_MESSAGES, sent );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that the batch functions assert when used on a stream buffer.
+ */
+void test_xMessageBufferMultiple_stream_buffer( void )
+{
+    uint8_t data[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+    size_t lengths[ TEST_BATCH_MESSAGES ] = { 0 };
+    StreamBufferHandle_t xStreamBuffer;
+
+    xStreamBuffer = xStreamBufferCreate( TEST_MESSAGE_BUFFER_SIZE, 1 );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferSendMessages( xStreamBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, 0 ) );
+    validate_and_clear_assertions();
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferReceiveMessages( xStreamBuffer, data, sizeof( data ), lengths, TEST_BATCH_MESSAGES, 0 ) );
+    validate_and_clear_assertions();
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferSendMessagesFromISR( xStreamBuffer, batchMessages, batchMessageLengths, TEST_BATCH_MESSAGES, NULL ) );
+    validate_and_clear_assertions();
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferReceiveMessagesFromISR( xStreamBuffer, data, sizeof( data ), lengths, TEST_BATCH_MESSAGES, NULL ) );
+    validate_and_clear_assertions();
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that a message written in place is sent with its length once committed,
+ * and that the space reserved leaves room for that length.
+ */
+void test_xMessageBufferSendReserve_commit_success( void )
+{
+    StreamBufferSpans_t spans;
+    uint8_t data[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_MAX_MESSAGE_SIZE, xMessageBufferSendReserve( xMessageBuffer, &spans, 0 ) );
+    TEST_ASSERT_EQUAL( TEST_MAX_MESSAGE_SIZE, spans.xSpanLength[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, spans.xSpanLength[ 1 ] );
+
+    memcpy( spans.pucSpan[ 0 ], batchMessage1, sizeof( batchMessage1 ) );
+    TEST_ASSERT_EQUAL( sizeof( batchMessage1 ), xMessageBufferSendCommit( xMessageBuffer, sizeof( batchMessage1 ) ) );
+    TEST_ASSERT_EQUAL( sizeof( batchMessage1 ), xStreamBufferNextMessageLengthBytes( xMessageBuffer ) );
+
+    /* The next message is reserved after the first one and its length. */
+    TEST_ASSERT_EQUAL( TEST_MAX_MESSAGE_SIZE - sizeof( batchMessage1 ) - TEST_MESSAGE_METADATA_SIZE, xMessageBufferSendReserveFromISR( xMessageBuffer, &spans ) );
+
+    /* A message larger than the space reserved can't be committed. */
+    EXPECT_ASSERT_BREAK( ( void ) xMessageBufferSendCommit( xMessageBuffer, TEST_MAX_MESSAGE_SIZE ) );
+    validate_and_clear_assertions();
+
+    TEST_ASSERT_EQUAL( sizeof( batchMessage1 ), xMessageBufferReceive( xMessageBuffer, data, sizeof( data ), 0 ) );
+    TEST_ASSERT_EQUAL_MEMORY( batchMessage1, data, sizeof( batchMessage1 ) );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that no space is reserved in a message buffer without room for more than a
+ * message length.
+ */
+void test_xMessageBufferSendReserve_no_room_for_message( void )
+{
+    StreamBufferSpans_t spans;
+    uint8_t data[ TEST_MAX_MESSAGE_SIZE ] = { 0 };
+
+    vTaskSetTimeOutState_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    /* Leave exactly enough space for the length of another message. */
+    TEST_ASSERT_EQUAL( TEST_MAX_MESSAGE_SIZE - TEST_MESSAGE_METADATA_SIZE, xMessageBufferSend( xMessageBuffer, data, TEST_MAX_MESSAGE_SIZE - TEST_MESSAGE_METADATA_SIZE, 0 ) );
+    TEST_ASSERT_EQUAL( TEST_MESSAGE_METADATA_SIZE, xMessageBufferSpacesAvailable( xMessageBuffer ) );
+
+    TEST_ASSERT_EQUAL( 0, xMessageBufferSendReserve( xMessageBuffer, &spans, 0 ) );
+    TEST_ASSERT_EQUAL( 0, spans.xSpanLength[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, spans.xSpanLength[ 1 ] );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
+
+/**
+ * @brief Validates that only the body of the next message is acquired, and that messages are
+ * released whole.
+ */
+void test_xMessageBufferReceiveAcquire_release_success( void )
+{
+    StreamBufferSpans_t spans;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    vTaskSetTimeOutState_Ignore();
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xMessageBuffer = xMessageBufferCreate( TEST_MESSAGE_BUFFER_SIZE );
+    TEST_ASSERT_NOT_NULL( xMessageBuffer );
+
+    TEST_ASSERT_EQUAL( 0, xMessageBufferReceiveAcquire( xMessageBuffer, &spans, 0 ) );
+
+    TEST_ASSERT_EQUAL( sizeof( batchMessage1 ), xMessageBufferSend( xMessageBuffer, batchMessage1, sizeof( batchMessage1 ), 0 ) );
+    TEST_ASSERT_EQUAL( sizeof( batchMessage2 ), xMessageBufferSend( xMessageBuffer, batchMessage2, sizeof( batchMessage2 ), 0 ) );
+
+    TEST_ASSERT_EQUAL( sizeof( batchMessage1 ), xMessageBufferReceiveAcquire( xMessageBuffer, &spans, 0 ) );
+    TEST_ASSERT_EQUAL( sizeof( batchMessage1 ), spans.xSpanLength[ 0 ] + spans.xSpanLength[ 1 ] );
+    TEST_ASSERT_EQUAL_MEMORY( batchMessage1, spans.pucSpan[ 0 ], spans.xSpanLength[ 0 ] );
+
+    /* Part of a message can't be released. */
+    EXPECT_ASSERT_BREAK( ( void ) xMessageBufferReceiveRelease( xMessageBuffer, 1 ) );
+    validate_and_clear_assertions();
+
+    TEST_ASSERT_EQUAL( sizeof( batchMessage1 ), xMessageBufferReceiveRelease( xMessageBuffer, sizeof( batchMessage1 ) ) );
+
+    TEST_ASSERT_EQUAL( sizeof( batchMessage2 ), xMessageBufferReceiveAcquireFromISR( xMessageBuffer, &spans ) );
+    TEST_ASSERT_EQUAL_MEMORY( batchMessage2, spans.pucSpan[ 0 ], spans.xSpanLength[ 0 ] );
+    TEST_ASSERT_EQUAL( sizeof( batchMessage2 ), xMessageBufferReceiveReleaseFromISR( xMessageBuffer, sizeof( batchMessage2 ), &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xHigherPriorityTaskWoken );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xMessageBufferIsEmpty( xMessageBuffer ) );
+
+    vStreamBufferDelete( xMessageBuffer );
+}
@@ -0,0 +1,626 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file queue_multiple_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../queue_utest_common.h"
+
+/* Queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "queue.h"
+#include "mock_fake_port.h"
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* Used to share a QueueHandle_t between a test case and it's callbacks */
+static QueueHandle_t xQueueHandleStatic;
+
+/* Event list items standing in for further tasks blocked on a queue */
+static ListItem_t xWaitingTaskItems[ 2 ];
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    commonSetUp();
+    vFakePortAssertIfInterruptPriorityInvalid_Ignore();
+    xQueueHandleStatic = NULL;
+}
+
+void tearDown( void )
+{
+    commonTearDown();
+}
+
+void suiteSetUp()
+{
+    commonSuiteSetUp();
+}
+
+int suiteTearDown( int numFailures )
+{
+    return commonSuiteTearDown( numFailures );
+}
+
+/* ==========================  Helper functions =========================== */
+
+/**
+ * @brief Place one of xWaitingTaskItems on the given event list as a task of
+ * the given priority.
+ */
+static void vAddWaitingTask( List_t * pxEventList,
+                             ListItem_t * pxItem,
+                             UBaseType_t uxPriority )
+{
+    vListInitialiseItem( pxItem );
+    listSET_LIST_ITEM_VALUE( pxItem, ( configMAX_PRIORITIES - uxPriority ) );
+    vListInsert( pxEventList, pxItem );
+}
+
+/**
+ * @brief Take any of xWaitingTaskItems that are still on an event list off it.
+ */
+static void vRemoveWaitingTasks( void )
+{
+    for( int i = 0; i < 2; i++ )
+    {
+        if( listLIST_ITEM_CONTAINER( &xWaitingTaskItems[ i ] ) != NULL )
+        {
+            ( void ) uxListRemove( &xWaitingTaskItems[ i ] );
+        }
+    }
+}
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+/**
+ * @brief Callback for xTaskCheckForTimeOut which receives two items from the
+ * test queue from an ISR while the calling task is blocked.
+ */
+static BaseType_t xReceiveMultipleFromISR_xTaskCheckForTimeOutCB( TimeOut_t * const pxTimeOut,
+                                                                  TickType_t * const pxTicksToWait,
+                                                                  int cmock_num_calls )
+{
+    BaseType_t xReturnValue = td_task_xTaskCheckForTimeOutStub( pxTimeOut, pxTicksToWait, cmock_num_calls );
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        uint32_t checkVals[ 2 ] = { INVALID_UINT32, INVALID_UINT32 };
+
+        TEST_ASSERT_EQUAL( 2, xQueueReceiveMultipleFromISR( xQueueHandleStatic, checkVals, 2, NULL ) );
+        TEST_ASSERT_EQUAL( 0, checkVals[ 0 ] );
+        TEST_ASSERT_EQUAL( 1, checkVals[ 1 ] );
+    }
+
+    return xReturnValue;
+}
+
+/**
+ * @brief Callback for xTaskCheckForTimeOut which sends three items to the
+ * test queue from an ISR while the calling task is blocked.
+ */
+static BaseType_t xSendMultipleFromISR_xTaskCheckForTimeOutCB( TimeOut_t * const pxTimeOut,
+                                                               TickType_t * const pxTicksToWait,
+                                                               int cmock_num_calls )
+{
+    BaseType_t xReturnValue = td_task_xTaskCheckForTimeOutStub( pxTimeOut, pxTicksToWait, cmock_num_calls );
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        uint32_t testVals[ 3 ] = { 7, 8, 9 };
+
+        TEST_ASSERT_EQUAL( 3, xQueueSendMultipleFromISR( xQueueHandleStatic, testVals, 3, NULL ) );
+    }
+
+    return xReturnValue;
+}
+
+/* ==============================  Test Cases ============================== */
+
+/**
+ * @brief Send a batch that fits in the queue and receive it item by item.
+ * @coverage xQueueSendMultiple
+ */
+void test_xQueueSendMultiple_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 3, sizeof( uint32_t ) );
+    uint32_t testVals[ 3 ] = { 0, 1, 2 };
+
+    TEST_ASSERT_EQUAL( 3, xQueueSendMultiple( xQueue, testVals, 3, 0 ) );
+    TEST_ASSERT_EQUAL( 3, uxQueueMessagesWaiting( xQueue ) );
+
+    queue_common_receive_sequential_from_queue( xQueue, 3, 3, 0 );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Only as many items as there is space for are sent.
+ * @coverage xQueueSendMultiple
+ */
+void test_xQueueSendMultiple_partial( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    uint32_t testVals[ 5 ] = { 1, 2, 3, 4, 5 };
+
+    queue_common_add_sequential_to_queue( xQueue, 1 );
+
+    TEST_ASSERT_EQUAL( 3, xQueueSendMultiple( xQueue, testVals, 5, 0 ) );
+    TEST_ASSERT_EQUAL( 4, uxQueueMessagesWaiting( xQueue ) );
+
+    queue_common_receive_sequential_from_queue( xQueue, 4, 4, 0 );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Sending to a full queue without a block time sends nothing.
+ * @coverage xQueueSendMultiple
+ */
+void test_xQueueSendMultiple_full_nonblocking( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t testVals[ 2 ] = { 0, 1 };
+
+    queue_common_add_sequential_to_queue( xQueue, 2 );
+
+    TEST_ASSERT_EQUAL( 0, xQueueSendMultiple( xQueue, testVals, 2, 0 ) );
+    TEST_ASSERT_EQUAL( 2, uxQueueMessagesWaiting( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief An empty batch returns straight away, even with a block time.
+ * @coverage xQueueSendMultiple
+ */
+void test_xQueueSendMultiple_zero_items( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+
+    queue_common_add_sequential_to_queue( xQueue, 1 );
+
+    TEST_ASSERT_EQUAL( 0, xQueueSendMultiple( xQueue, &testVal, 0, TICKS_TO_WAIT ) );
+    TEST_ASSERT_EQUAL( 0, td_task_getYieldCount() );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Sending to a queue that stays full times out after blocking.
+ * @coverage xQueueSendMultiple
+ */
+void test_xQueueSendMultiple_blocking_timeout( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t testVals[ 2 ] = { 0, 1 };
+
+    queue_common_add_sequential_to_queue( xQueue, 2 );
+
+    TEST_ASSERT_EQUAL( 0, xQueueSendMultiple( xQueue, testVals, 2, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+    TEST_ASSERT_EQUAL( 2, uxQueueMessagesWaiting( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A task blocked on a full queue sends as many items as fit once an
+ * ISR has made space.
+ * @coverage xQueueSendMultiple xQueueReceiveMultipleFromISR
+ */
+void test_xQueueSendMultiple_blocking_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 3, sizeof( uint32_t ) );
+    uint32_t testVals[ 3 ] = { 3, 4, 5 };
+
+    xQueueHandleStatic = xQueue;
+
+    queue_common_add_sequential_to_queue( xQueue, 3 );
+
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 1 );
+    xTaskCheckForTimeOut_Stub( &xReceiveMultipleFromISR_xTaskCheckForTimeOutCB );
+
+    TEST_ASSERT_EQUAL( 2, xQueueSendMultiple( xQueue, testVals, 3, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getCount_vPortYieldWithinAPI() );
+
+    queue_common_receive_sequential_from_queue( xQueue, 3, 3, 2 );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief One waiting receiver is unblocked per item sent, and the sender
+ * yields once for the whole batch.
+ * @coverage xQueueSendMultiple prvUnblockReceivers
+ */
+void test_xQueueSendMultiple_unblocks_one_receiver_per_item( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    uint32_t testVals[ 2 ] = { 0, 1 };
+
+    vAddWaitingTask( pxGetTasksWaitingToReceiveFromQueue( xQueue ), &xWaitingTaskItems[ 0 ], DEFAULT_PRIORITY + 1 );
+    vAddWaitingTask( pxGetTasksWaitingToReceiveFromQueue( xQueue ), &xWaitingTaskItems[ 1 ], DEFAULT_PRIORITY + 1 );
+
+    TEST_ASSERT_EQUAL( 1, xQueueSendMultiple( xQueue, testVals, 1, 0 ) );
+
+    TEST_ASSERT_EQUAL( 1, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToReceiveFromQueue( xQueue ) ) );
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+
+    vAddWaitingTask( pxGetTasksWaitingToReceiveFromQueue( xQueue ), &xWaitingTaskItems[ 0 ], DEFAULT_PRIORITY + 1 );
+
+    TEST_ASSERT_EQUAL( 2, xQueueSendMultiple( xQueue, testVals, 2, 0 ) );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToReceiveFromQueue( xQueue ) ) );
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+
+    vRemoveWaitingTasks();
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A lower priority receiver is unblocked without a yield.
+ * @coverage xQueueSendMultiple prvUnblockReceivers
+ */
+void test_xQueueSendMultiple_unblocks_lower_priority_receiver( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    uint32_t testVals[ 2 ] = { 0, 1 };
+
+    vAddWaitingTask( pxGetTasksWaitingToReceiveFromQueue( xQueue ), &xWaitingTaskItems[ 0 ], DEFAULT_PRIORITY - 1 );
+
+    TEST_ASSERT_EQUAL( 2, xQueueSendMultiple( xQueue, testVals, 2, 0 ) );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToReceiveFromQueue( xQueue ) ) );
+    TEST_ASSERT_EQUAL( 0, td_task_getYieldCount() );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Sending a batch from an ISR unblocks a waiting higher priority
+ * receiver and reports that a context switch is needed.
+ * @coverage xQueueSendMultipleFromISR
+ */
+void test_xQueueSendMultipleFromISR_unblocks_receiver( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t testVals[ 3 ] = { 0, 1, 2 };
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToReceiveFromQueue( xQueue );
+
+    TEST_ASSERT_EQUAL( 2, xQueueSendMultipleFromISR( xQueue, testVals, 3, &xHigherPriorityTaskWoken ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xHigherPriorityTaskWoken );
+    TEST_ASSERT_EQUAL( pdTRUE, td_task_getYieldPending() );
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToReceiveFromQueue( xQueue ) ) );
+
+    queue_common_receive_sequential_from_queue( xQueue, 2, 2, 0 );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Sending a batch from an ISR to a full queue sends nothing.
+ * @coverage xQueueSendMultipleFromISR
+ */
+void test_xQueueSendMultipleFromISR_full( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    queue_common_add_sequential_to_queue( xQueue, 1 );
+
+    TEST_ASSERT_EQUAL( 0, xQueueSendMultipleFromISR( xQueue, &testVal, 1, &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xHigherPriorityTaskWoken );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Sending a batch from an ISR to a locked queue increments cTxLock once
+ * per item instead of unblocking tasks.
+ * @coverage xQueueSendMultipleFromISR
+ */
+void test_xQueueSendMultipleFromISR_locked( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 3, sizeof( uint32_t ) );
+    uint32_t testVals[ 3 ] = { 0, 1, 2 };
+
+    vSetQueueRxLock( xQueue, queueLOCKED_UNMODIFIED );
+    vSetQueueTxLock( xQueue, queueLOCKED_UNMODIFIED );
+
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 5 );
+
+    td_task_addFakeTaskWaitingToReceiveFromQueue( xQueue );
+
+    TEST_ASSERT_EQUAL( 3, xQueueSendMultipleFromISR( xQueue, testVals, 3, NULL ) );
+
+    TEST_ASSERT_EQUAL( queueLOCKED_UNMODIFIED + 3, cGetQueueTxLock( xQueue ) );
+    TEST_ASSERT_EQUAL( queueLOCKED_UNMODIFIED, cGetQueueRxLock( xQueue ) );
+    TEST_ASSERT_EQUAL( 1, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToReceiveFromQueue( xQueue ) ) );
+
+    vSetQueueRxLock( xQueue, queueUNLOCKED );
+    vSetQueueTxLock( xQueue, queueUNLOCKED );
+
+    queue_common_receive_sequential_from_queue( xQueue, 3, 3, 0 );
+
+    ( void ) uxListRemove( listGET_HEAD_ENTRY( pxGetTasksWaitingToReceiveFromQueue( xQueue ) ) );
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Receive a batch that holds every item in the queue.
+ * @coverage xQueueReceiveMultiple
+ */
+void test_xQueueReceiveMultiple_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 5, sizeof( uint32_t ) );
+    uint32_t checkVals[ 5 ];
+
+    queue_common_add_sequential_to_queue( xQueue, 3 );
+
+    TEST_ASSERT_EQUAL( 3, xQueueReceiveMultiple( xQueue, checkVals, 5, 0 ) );
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+
+    for( uint32_t i = 0; i < 3; i++ )
+    {
+        TEST_ASSERT_EQUAL( i, checkVals[ i ] );
+    }
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief No more than uxMaxItems items are received, and the rest stay in the
+ * queue in order, including across the wrap of the storage area.
+ * @coverage xQueueReceiveMultiple
+ */
+void test_xQueueReceiveMultiple_partial( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    uint32_t testVals[ 3 ] = { 4, 5, 6 };
+    uint32_t checkVals[ 4 ];
+
+    queue_common_add_sequential_to_queue( xQueue, 4 );
+
+    TEST_ASSERT_EQUAL( 3, xQueueReceiveMultiple( xQueue, checkVals, 3, 0 ) );
+    TEST_ASSERT_EQUAL( 3, xQueueSendMultiple( xQueue, testVals, 3, 0 ) );
+    TEST_ASSERT_EQUAL( 4, xQueueReceiveMultiple( xQueue, checkVals, 4, 0 ) );
+
+    for( uint32_t i = 0; i < 4; i++ )
+    {
+        TEST_ASSERT_EQUAL( i + 3, checkVals[ i ] );
+    }
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Receiving from an empty queue, or into an empty buffer, without a
+ * block time receives nothing.
+ * @coverage xQueueReceiveMultiple
+ */
+void test_xQueueReceiveMultiple_nonblocking_empty( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t checkVals[ 2 ] = { INVALID_UINT32, INVALID_UINT32 };
+
+    TEST_ASSERT_EQUAL( 0, xQueueReceiveMultiple( xQueue, checkVals, 2, 0 ) );
+    TEST_ASSERT_EQUAL( INVALID_UINT32, checkVals[ 0 ] );
+
+    queue_common_add_sequential_to_queue( xQueue, 1 );
+
+    /* A zero length buffer never waits. */
+    TEST_ASSERT_EQUAL( 0, xQueueReceiveMultiple( xQueue, checkVals, 0, TICKS_TO_WAIT ) );
+    TEST_ASSERT_EQUAL( 0, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, uxQueueMessagesWaiting( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Receiving from a queue that stays empty times out after blocking.
+ * @coverage xQueueReceiveMultiple
+ */
+void test_xQueueReceiveMultiple_blocking_timeout( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t checkVals[ 2 ];
+
+    TEST_ASSERT_EQUAL( 0, xQueueReceiveMultiple( xQueue, checkVals, 2, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A task blocked on an empty queue receives every item a batch sent
+ * from an ISR placed on the locked queue.
+ * @coverage xQueueReceiveMultiple xQueueSendMultipleFromISR
+ */
+void test_xQueueReceiveMultiple_blocking_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    uint32_t checkVals[ 4 ] = { 0 };
+
+    xQueueHandleStatic = xQueue;
+
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 1 );
+    xTaskCheckForTimeOut_Stub( &xSendMultipleFromISR_xTaskCheckForTimeOutCB );
+
+    TEST_ASSERT_EQUAL( 3, xQueueReceiveMultiple( xQueue, checkVals, 4, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( 7, checkVals[ 0 ] );
+    TEST_ASSERT_EQUAL( 8, checkVals[ 1 ] );
+    TEST_ASSERT_EQUAL( 9, checkVals[ 2 ] );
+
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief One waiting sender is unblocked per item received, and the receiver
+ * yields once for the whole batch.
+ * @coverage xQueueReceiveMultiple prvUnblockSenders
+ */
+void test_xQueueReceiveMultiple_unblocks_one_sender_per_item( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 3, sizeof( uint32_t ) );
+    uint32_t checkVals[ 3 ];
+
+    queue_common_add_sequential_to_queue( xQueue, 3 );
+
+    vAddWaitingTask( pxGetTasksWaitingToSendToQueue( xQueue ), &xWaitingTaskItems[ 0 ], DEFAULT_PRIORITY + 1 );
+    vAddWaitingTask( pxGetTasksWaitingToSendToQueue( xQueue ), &xWaitingTaskItems[ 1 ], DEFAULT_PRIORITY + 1 );
+
+    TEST_ASSERT_EQUAL( 1, xQueueReceiveMultiple( xQueue, checkVals, 1, 0 ) );
+
+    TEST_ASSERT_EQUAL( 1, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToSendToQueue( xQueue ) ) );
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+
+    vAddWaitingTask( pxGetTasksWaitingToSendToQueue( xQueue ), &xWaitingTaskItems[ 0 ], DEFAULT_PRIORITY + 1 );
+
+    TEST_ASSERT_EQUAL( 2, xQueueReceiveMultiple( xQueue, checkVals, 3, 0 ) );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToSendToQueue( xQueue ) ) );
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+
+    vRemoveWaitingTasks();
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Receiving a batch from an ISR unblocks a waiting higher priority
+ * sender and reports that a context switch is needed.
+ * @coverage xQueueReceiveMultipleFromISR
+ */
+void test_xQueueReceiveMultipleFromISR_unblocks_sender( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 3, sizeof( uint32_t ) );
+    uint32_t checkVals[ 3 ] = { INVALID_UINT32, INVALID_UINT32, INVALID_UINT32 };
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    queue_common_add_sequential_to_queue( xQueue, 2 );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToSendToQueue( xQueue );
+
+    TEST_ASSERT_EQUAL( 2, xQueueReceiveMultipleFromISR( xQueue, checkVals, 3, &xHigherPriorityTaskWoken ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xHigherPriorityTaskWoken );
+    TEST_ASSERT_EQUAL( pdTRUE, td_task_getYieldPending() );
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToSendToQueue( xQueue ) ) );
+    TEST_ASSERT_EQUAL( 0, checkVals[ 0 ] );
+    TEST_ASSERT_EQUAL( 1, checkVals[ 1 ] );
+    TEST_ASSERT_EQUAL( INVALID_UINT32, checkVals[ 2 ] );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Receiving a batch from an ISR on an empty queue receives nothing.
+ * @coverage xQueueReceiveMultipleFromISR
+ */
+void test_xQueueReceiveMultipleFromISR_empty( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t checkVals[ 2 ];
+
+    TEST_ASSERT_EQUAL( 0, xQueueReceiveMultipleFromISR( xQueue, checkVals, 2, NULL ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Receiving a batch from an ISR on a locked queue increments cRxLock
+ * once per item instead of unblocking tasks.
+ * @coverage xQueueReceiveMultipleFromISR
+ */
+void test_xQueueReceiveMultipleFromISR_locked( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    uint32_t checkVals[ 4 ];
+
+    queue_common_add_sequential_to_queue( xQueue, 4 );
+
+    vSetQueueRxLock( xQueue, queueLOCKED_UNMODIFIED );
+    vSetQueueTxLock( xQueue, queueLOCKED_UNMODIFIED );
+
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 5 );
+
+    td_task_addFakeTaskWaitingToSendToQueue( xQueue );
+
+    TEST_ASSERT_EQUAL( 3, xQueueReceiveMultipleFromISR( xQueue, checkVals, 3, NULL ) );
+
+    TEST_ASSERT_EQUAL( queueLOCKED_UNMODIFIED + 3, cGetQueueRxLock( xQueue ) );
+    TEST_ASSERT_EQUAL( queueLOCKED_UNMODIFIED, cGetQueueTxLock( xQueue ) );
+    TEST_ASSERT_EQUAL( 1, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToSendToQueue( xQueue ) ) );
+
+    vSetQueueRxLock( xQueue, queueUNLOCKED );
+    vSetQueueTxLock( xQueue, queueUNLOCKED );
+
+    ( void ) uxListRemove( listGET_HEAD_ENTRY( pxGetTasksWaitingToSendToQueue( xQueue ) ) );
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Semaphores are given and taken one at a time.
+ * @coverage xQueueSendMultiple xQueueReceiveMultiple xQueueSendMultipleFromISR xQueueReceiveMultipleFromISR
+ */
+void test_queue_multiple_semaphore_assert( void )
+{
+    QueueHandle_t xSemaphore = xQueueCreate( 2, 0 );
+    uint32_t ulBuffer = 0;
+
+    EXPECT_ASSERT_BREAK( xQueueSendMultiple( xSemaphore, &ulBuffer, 1, 0 ) );
+    EXPECT_ASSERT_BREAK( xQueueReceiveMultiple( xSemaphore, &ulBuffer, 1, 0 ) );
+    EXPECT_ASSERT_BREAK( xQueueSendMultipleFromISR( xSemaphore, &ulBuffer, 1, NULL ) );
+    EXPECT_ASSERT_BREAK( xQueueReceiveMultipleFromISR( xSemaphore, &ulBuffer, 1, NULL ) );
+
+    vQueueDelete( xSemaphore );
+}
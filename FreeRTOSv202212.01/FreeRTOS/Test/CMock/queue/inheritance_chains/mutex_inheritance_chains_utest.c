@@ -0,0 +1,351 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file mutex_inheritance_chains_utest.c */
+
+#include "../queue_utest_common.h"
+
+/* Queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "semphr.h"
+#include "mock_fake_port.h"
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* Used to share a SemaphoreHandle_t between a test case and its callbacks. */
+static SemaphoreHandle_t xSemaphoreHandleStatic = NULL;
+
+/* Stands in for the list of mutexes held by the task that takes the mutex. */
+static List_t xMutexesHeld;
+
+/* The list item the mutex passed to the task functions that track the
+ * mutexes held. */
+static ListItem_t * pxMutexHeldListItem;
+
+/* The holder returned by pvTaskAddHeldMutex. */
+static TaskHandle_t xFakeMutexHolder;
+
+/* The value xTaskRemoveHeldMutex returns, pdTRUE if giving the mutex lowered
+ * the priority of the giving task. */
+static BaseType_t xPriorityLowered;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+static TaskHandle_t pvTaskAddHeldMutexStub( ListItem_t * const pxItem,
+                                            int cmock_num_calls )
+{
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( pxItem ) );
+
+    pxMutexHeldListItem = pxItem;
+    vListInsertEnd( &xMutexesHeld, pxItem );
+
+    return xFakeMutexHolder;
+}
+
+static BaseType_t xTaskRemoveHeldMutexStub( ListItem_t * const pxItem,
+                                            int cmock_num_calls )
+{
+    /* The mutex is only referenced from a list once it has been taken by a
+     * task, as it is when the mutex is created. */
+    if( listLIST_ITEM_CONTAINER( pxItem ) != NULL )
+    {
+        TEST_ASSERT_EQUAL_PTR( pxMutexHeldListItem, pxItem );
+        ( void ) uxListRemove( pxItem );
+    }
+    else
+    {
+        pxMutexHeldListItem = pxItem;
+    }
+
+    return xPriorityLowered;
+}
+
+static BaseType_t xTaskPriorityInheritChainStub( TaskHandle_t * const pxMutexHolder,
+                                                 int cmock_num_calls )
+{
+    /* The task about to block records where to find the holder, so must be
+     * passed the holder field of the mutex rather than its current value. */
+    TEST_ASSERT_EQUAL_PTR( xFakeMutexHolder, *pxMutexHolder );
+
+    return pdTRUE;
+}
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    commonSetUp();
+
+    vListInitialise( &xMutexesHeld );
+    pxMutexHeldListItem = NULL;
+    xFakeMutexHolder = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+    xPriorityLowered = pdFALSE;
+
+    pvTaskAddHeldMutex_Stub( &pvTaskAddHeldMutexStub );
+    xTaskRemoveHeldMutex_Stub( &xTaskRemoveHeldMutexStub );
+}
+
+void tearDown( void )
+{
+    commonTearDown();
+}
+
+void suiteSetUp()
+{
+    commonSuiteSetUp();
+}
+
+int suiteTearDown( int numFailures )
+{
+    return commonSuiteTearDown( numFailures );
+}
+
+/* ==========================  Helper functions =========================== */
+
+static List_t * pxTasksWaitingToReceive( SemaphoreHandle_t xSemaphore )
+{
+    StaticQueue_t * pxQueue = ( StaticQueue_t * ) xSemaphore;
+
+    return ( List_t * ) &( pxQueue->xDummy3[ 1 ] );
+}
+
+/* ==========================  Test Cases =========================== */
+
+/**
+ * @brief Test the list item a new mutex uses to reference itself from the
+ * mutexes held by its holder.
+ * @details The item leads to the tasks waiting for the mutex, and carries the
+ * idle priority as the mutex has no ceiling.
+ * @coverage xQueueCreateMutex prvInitialiseMutex
+ */
+void test_xSemaphoreCreateMutex_held_list_item( void )
+{
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutex();
+
+    TEST_ASSERT_NOT_NULL( pxMutexHeldListItem );
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( pxMutexHeldListItem ) );
+    TEST_ASSERT_EQUAL_PTR( pxTasksWaitingToReceive( xSemaphore ), listGET_LIST_ITEM_OWNER( pxMutexHeldListItem ) );
+    TEST_ASSERT_EQUAL( tskIDLE_PRIORITY, listGET_LIST_ITEM_VALUE( pxMutexHeldListItem ) );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test a mutex that is taken is added to the mutexes held by the
+ * calling task, and removed again when it is given.
+ * @coverage xQueueSemaphoreTake prvCopyDataToQueue
+ */
+void test_xSemaphoreTake_xSemaphoreGive_held_list( void )
+{
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutex();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+
+    TEST_ASSERT_EQUAL( 1, listCURRENT_LIST_LENGTH( &xMutexesHeld ) );
+    TEST_ASSERT_TRUE( listIS_CONTAINED_WITHIN( &xMutexesHeld, pxMutexHeldListItem ) );
+    TEST_ASSERT_EQUAL_PTR( xFakeMutexHolder, xSemaphoreGetMutexHolder( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreGive( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( &xMutexesHeld ) );
+    TEST_ASSERT_NULL( xSemaphoreGetMutexHolder( xSemaphore ) );
+    TEST_ASSERT_EQUAL( 0, td_task_getYieldCount() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test giving a mutex yields when the recalculated priority of the
+ * giving task is lower than the priority it ran at while holding the mutex.
+ * @coverage xQueueGenericSend prvCopyDataToQueue
+ */
+void test_xSemaphoreGive_priority_lowered_yields( void )
+{
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutex();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+
+    xPriorityLowered = pdTRUE;
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreGive( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( &xMutexesHeld ) );
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test a task that times out waiting for a held mutex recalculates the
+ * priorities along the chain from the holder.
+ * @coverage xQueueSemaphoreTake
+ */
+void test_xSemaphoreTake_blocking_inherit_chain_timeout( void )
+{
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutex();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+
+    xTaskPriorityInheritChain_Stub( &xTaskPriorityInheritChainStub );
+    vTaskPriorityDisinheritChainAfterTimeout_Expect( xFakeMutexHolder );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xSemaphoreTake( xSemaphore, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    /* The mutex is still held by the task that took it first. */
+    TEST_ASSERT_EQUAL( 1, listCURRENT_LIST_LENGTH( &xMutexesHeld ) );
+    TEST_ASSERT_EQUAL_PTR( xFakeMutexHolder, xSemaphoreGetMutexHolder( xSemaphore ) );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test a task that times out waiting for a held mutex without raising
+ * the priority of any task does not recalculate any priorities.
+ * @coverage xQueueSemaphoreTake
+ */
+void test_xSemaphoreTake_blocking_no_inheritance_timeout( void )
+{
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutex();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+
+    for( int i = 0; i < TICKS_TO_WAIT; i++ )
+    {
+        xTaskPriorityInheritChain_ExpectAnyArgsAndReturn( pdFALSE );
+    }
+
+    TEST_ASSERT_EQUAL( pdFALSE, xSemaphoreTake( xSemaphore, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Callback for test_xSemaphoreTake_blocking_inherit_chain_given
+ */
+static BaseType_t xSemaphoreTake_blocking_xTaskResumeAllStub( int cmock_num_calls )
+{
+    BaseType_t xReturnValue = td_task_xTaskResumeAllStub( cmock_num_calls );
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        TEST_ASSERT_TRUE( xSemaphoreGive( xSemaphoreHandleStatic ) );
+    }
+
+    return xReturnValue;
+}
+
+/**
+ * @brief Test a task that blocks on a held mutex is added to the chain, and
+ * records the mutex as held once the mutex is given to it.
+ * @coverage xQueueSemaphoreTake
+ */
+void test_xSemaphoreTake_blocking_inherit_chain_given( void )
+{
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutex();
+
+    xSemaphoreHandleStatic = xSemaphore;
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+
+    xTaskResumeAll_Stub( &xSemaphoreTake_blocking_xTaskResumeAllStub );
+    xTaskPriorityInheritChain_Stub( &xTaskPriorityInheritChainStub );
+
+    /* The holder gives the mutex back, which removes it from the mutexes the
+     * holder holds, then the waiting task takes it. */
+    xPriorityLowered = pdTRUE;
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( 1, listCURRENT_LIST_LENGTH( &xMutexesHeld ) );
+    TEST_ASSERT_EQUAL_PTR( xFakeMutexHolder, xSemaphoreGetMutexHolder( xSemaphore ) );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT + 2, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT + 2, td_task_getCount_vPortYieldWithinAPI() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test a mutex taken and given from an interrupt is never referenced
+ * from the mutexes held by a task.
+ * @coverage xQueueReceiveFromISR xQueueGiveFromISR
+ */
+void test_xSemaphoreTakeFromISR_xSemaphoreGiveFromISR_held_list( void )
+{
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutex();
+
+    vFakePortAssertIfInterruptPriorityInvalid_Expect();
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTakeFromISR( xSemaphore, NULL ) );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( &xMutexesHeld ) );
+    TEST_ASSERT_NULL( xSemaphoreGetMutexHolderFromISR( xSemaphore ) );
+
+    vFakePortAssertIfInterruptPriorityInvalid_Expect();
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreGiveFromISR( xSemaphore, NULL ) );
+
+    TEST_ASSERT_NULL( listLIST_ITEM_CONTAINER( pxMutexHeldListItem ) );
+    TEST_ASSERT_EQUAL( B_SEMPHR_AVAILABLE, uxSemaphoreGetCount( xSemaphore ) );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test deleting a mutex that is still held removes it from the mutexes
+ * held by its holder.
+ * @coverage vQueueDelete
+ */
+void test_vSemaphoreDelete_held_mutex( void )
+{
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutex();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+    TEST_ASSERT_EQUAL( 1, listCURRENT_LIST_LENGTH( &xMutexesHeld ) );
+
+    vSemaphoreDelete( xSemaphore );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( &xMutexesHeld ) );
+}
+
+/**
+ * @brief Test a statically allocated mutex has the same list item set up.
+ * @coverage xQueueCreateMutexStatic prvInitialiseMutex vQueueDelete
+ */
+void test_xSemaphoreCreateMutexStatic_held_list_item( void )
+{
+    StaticSemaphore_t xSemaphoreBuffer;
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutexStatic( &xSemaphoreBuffer );
+
+    TEST_ASSERT_EQUAL_PTR( pxTasksWaitingToReceive( xSemaphore ), listGET_LIST_ITEM_OWNER( pxMutexHeldListItem ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+    vSemaphoreDelete( xSemaphore );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( &xMutexesHeld ) );
+}
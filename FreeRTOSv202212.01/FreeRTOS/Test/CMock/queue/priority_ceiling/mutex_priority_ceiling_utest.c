@@ -0,0 +1,289 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file mutex_priority_ceiling_utest.c */
+
+#include "../queue_utest_common.h"
+
+/* Queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "semphr.h"
+#include "mock_fake_port.h"
+
+/* ================================  CONSTANTS ===============================*/
+
+#define CEILING_PRIORITY    ( DEFAULT_PRIORITY + 1 )
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* Used to share a SemaphoreHandle_t between a test case and its callbacks. */
+static SemaphoreHandle_t xSemaphoreHandleStatic = NULL;
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    commonSetUp();
+}
+
+void tearDown( void )
+{
+    commonTearDown();
+}
+
+void suiteSetUp()
+{
+    commonSuiteSetUp();
+}
+
+int suiteTearDown( int numFailures )
+{
+    return commonSuiteTearDown( numFailures );
+}
+
+/* ==========================  Helper functions =========================== */
+
+static UBaseType_t uxGetCeilingPriority( SemaphoreHandle_t xSemaphore )
+{
+    StaticQueue_t * pxQueue = ( StaticQueue_t * ) xSemaphore;
+
+    return pxQueue->uxDummy12;
+}
+
+/* ==========================  Test Cases =========================== */
+
+/**
+ * @brief Test xSemaphoreCreateMutexWithCeiling where the call to malloc fails
+ * @coverage xQueueCreateMutexWithCeiling prvSetMutexCeiling
+ */
+void test_macro_xSemaphoreCreateMutexWithCeiling_malloc_fail( void )
+{
+    UnityMalloc_MakeMallocFailAfterCount( 0 );
+
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutexWithCeiling( CEILING_PRIORITY );
+
+    TEST_ASSERT_EQUAL( NULL, xSemaphore );
+}
+
+/**
+ * @brief Test xSemaphoreCreateMutexWithCeiling
+ * @details A mutex with a ceiling is created available and records the
+ * ceiling priority.
+ * @coverage xQueueCreateMutexWithCeiling prvSetMutexCeiling
+ */
+void test_macro_xSemaphoreCreateMutexWithCeiling_success( void )
+{
+    xTaskPriorityDisinherit_ExpectAndReturn( NULL, pdFALSE );
+
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutexWithCeiling( CEILING_PRIORITY );
+
+    TEST_ASSERT_NOT_EQUAL( NULL, xSemaphore );
+    TEST_ASSERT_EQUAL( QUEUE_T_SIZE, getLastMallocSize() );
+    TEST_ASSERT_EQUAL( B_SEMPHR_AVAILABLE, uxSemaphoreGetCount( xSemaphore ) );
+    TEST_ASSERT_EQUAL( CEILING_PRIORITY, uxGetCeilingPriority( xSemaphore ) );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test xSemaphoreCreateMutexWithCeilingStatic
+ * @coverage xQueueCreateMutexWithCeilingStatic prvSetMutexCeiling
+ */
+void test_macro_xSemaphoreCreateMutexWithCeilingStatic_success( void )
+{
+    StaticSemaphore_t xSemaphoreBuffer;
+
+    xTaskPriorityDisinherit_ExpectAndReturn( NULL, pdFALSE );
+
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutexWithCeilingStatic( CEILING_PRIORITY, &xSemaphoreBuffer );
+
+    TEST_ASSERT_EQUAL_PTR( &xSemaphoreBuffer, xSemaphore );
+    TEST_ASSERT_EQUAL( 0, getLastMallocSize() );
+    TEST_ASSERT_EQUAL( CEILING_PRIORITY, uxGetCeilingPriority( xSemaphore ) );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test xSemaphoreCreateMutexWithCeiling with a ceiling that is not a
+ * valid priority.
+ * @coverage xQueueCreateMutexWithCeiling prvSetMutexCeiling
+ */
+void test_macro_xSemaphoreCreateMutexWithCeiling_invalid_priority( void )
+{
+    xTaskPriorityDisinherit_ExpectAndReturn( NULL, pdFALSE );
+    fakeAssertExpectFail();
+
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutexWithCeiling( configMAX_PRIORITIES );
+
+    TEST_ASSERT_EQUAL( true, fakeAssertGetFlagAndClear() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test a mutex created without a ceiling uses priority inheritance.
+ * @details Taking the mutex does not raise the priority of the taking task.
+ * @coverage xQueueCreateMutex xQueueSemaphoreTake
+ */
+void test_macro_xSemaphoreTake_no_ceiling( void )
+{
+    TaskHandle_t xFakeMutexHolder = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+
+    xTaskPriorityDisinherit_ExpectAndReturn( NULL, pdFALSE );
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutex();
+
+    TEST_ASSERT_EQUAL( configMAX_PRIORITIES, uxGetCeilingPriority( xSemaphore ) );
+
+    pvTaskIncrementMutexHeldCount_ExpectAndReturn( xFakeMutexHolder );
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test taking a mutex with a ceiling raises the taking task to the
+ * ceiling, and giving it back disinherits the ceiling.
+ * @coverage xQueueSemaphoreTake xQueueGenericSend
+ */
+void test_macro_xSemaphoreTake_xSemaphoreGive_ceiling( void )
+{
+    TaskHandle_t xFakeMutexHolder = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+
+    xTaskPriorityDisinherit_ExpectAndReturn( NULL, pdFALSE );
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutexWithCeiling( CEILING_PRIORITY );
+
+    pvTaskIncrementMutexHeldCount_ExpectAndReturn( xFakeMutexHolder );
+    vTaskPriorityRaiseToCeiling_Expect( CEILING_PRIORITY );
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+
+    TEST_ASSERT_EQUAL_PTR( xFakeMutexHolder, xSemaphoreGetMutexHolder( xSemaphore ) );
+
+    /* Dropping from the ceiling requires a yield. */
+    xTaskPriorityDisinherit_ExpectAndReturn( xFakeMutexHolder, pdTRUE );
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreGive( xSemaphore ) );
+
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test a task that blocks on a mutex with a ceiling does not pass its
+ * priority to the holder, so has nothing to disinherit when it times out.
+ * @coverage xQueueSemaphoreTake
+ */
+void test_macro_xSemaphoreTake_blocking_ceiling_timeout( void )
+{
+    TaskHandle_t xFakeMutexHolder = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+
+    xTaskPriorityDisinherit_ExpectAndReturn( NULL, pdFALSE );
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutexWithCeiling( CEILING_PRIORITY );
+
+    pvTaskIncrementMutexHeldCount_ExpectAndReturn( xFakeMutexHolder );
+    vTaskPriorityRaiseToCeiling_Expect( CEILING_PRIORITY );
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+
+    /* No calls to xTaskPriorityInherit or vTaskPriorityDisinheritAfterTimeout
+     * are expected. */
+    TEST_ASSERT_EQUAL( pdFALSE, xSemaphoreTake( xSemaphore, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Callback for test_macro_xSemaphoreTake_blocking_ceiling_given
+ */
+static BaseType_t xSemaphoreTake_blocking_xTaskResumeAllStub( int cmock_num_calls )
+{
+    BaseType_t xReturnValue = td_task_xTaskResumeAllStub( cmock_num_calls );
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        TEST_ASSERT_TRUE( xSemaphoreGive( xSemaphoreHandleStatic ) );
+    }
+
+    return xReturnValue;
+}
+
+/**
+ * @brief Test a task that blocks on a mutex with a ceiling is raised to the
+ * ceiling once the mutex is given to it.
+ * @coverage xQueueSemaphoreTake
+ */
+void test_macro_xSemaphoreTake_blocking_ceiling_given( void )
+{
+    TaskHandle_t xFakeMutexHolder = ( TaskHandle_t ) ( ( uint64_t ) 0 + getNextMonotonicTestValue() );
+
+    xTaskPriorityDisinherit_ExpectAndReturn( NULL, pdFALSE );
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutexWithCeiling( CEILING_PRIORITY );
+
+    xSemaphoreHandleStatic = xSemaphore;
+
+    pvTaskIncrementMutexHeldCount_ExpectAndReturn( xFakeMutexHolder );
+    vTaskPriorityRaiseToCeiling_Expect( CEILING_PRIORITY );
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, 0 ) );
+
+    xTaskResumeAll_Stub( &xSemaphoreTake_blocking_xTaskResumeAllStub );
+
+    xTaskPriorityDisinherit_ExpectAndReturn( xFakeMutexHolder, pdTRUE );
+    pvTaskIncrementMutexHeldCount_ExpectAndReturn( xFakeMutexHolder );
+    vTaskPriorityRaiseToCeiling_Expect( CEILING_PRIORITY );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTake( xSemaphore, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT + 2, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT + 2, td_task_getCount_vPortYieldWithinAPI() );
+
+    vSemaphoreDelete( xSemaphore );
+}
+
+/**
+ * @brief Test a mutex with a ceiling taken from an interrupt does not raise
+ * the priority of any task.
+ * @coverage xQueueReceiveFromISR xQueueGiveFromISR
+ */
+void test_macro_xSemaphoreTakeFromISR_ceiling( void )
+{
+    xTaskPriorityDisinherit_ExpectAndReturn( NULL, pdFALSE );
+    SemaphoreHandle_t xSemaphore = xSemaphoreCreateMutexWithCeiling( CEILING_PRIORITY );
+
+    vFakePortAssertIfInterruptPriorityInvalid_Expect();
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreTakeFromISR( xSemaphore, NULL ) );
+
+    TEST_ASSERT_NULL( xSemaphoreGetMutexHolderFromISR( xSemaphore ) );
+
+    vFakePortAssertIfInterruptPriorityInvalid_Expect();
+    TEST_ASSERT_EQUAL( pdTRUE, xSemaphoreGiveFromISR( xSemaphore, NULL ) );
+
+    TEST_ASSERT_EQUAL( B_SEMPHR_AVAILABLE, uxSemaphoreGetCount( xSemaphore ) );
+
+    vSemaphoreDelete( xSemaphore );
+}
@@ -0,0 +1,163 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file queue_multiple_in_set_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../queue_utest_common.h"
+
+/* Queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "queue.h"
+#include "mock_fake_port.h"
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    commonSetUp();
+    vFakePortAssertIfInterruptPriorityInvalid_Ignore();
+}
+
+void tearDown( void )
+{
+    commonTearDown();
+}
+
+void suiteSetUp()
+{
+    commonSuiteSetUp();
+}
+
+int suiteTearDown( int numFailures )
+{
+    return commonSuiteTearDown( numFailures );
+}
+
+/* ===========================  Helper functions ============================ */
+
+/* ==============================  Test Cases =============================== */
+
+/**
+ * @brief Test xQueueSendMultiple on a member Queue (size 3) of a QueueSet (size 3)
+ * @details: Send a batch of three items to a queue that is part of a QueueSet.
+ *  Verify that the queue is selected from the set once per item.
+ * @coverage xQueueSendMultiple prvUnblockReceivers
+ */
+void test_xQueueSendMultiple_xQueueSelectFromSet_once_per_item( void )
+{
+    QueueSetHandle_t xQueueSet = xQueueCreateSet( 3 );
+    QueueHandle_t xQueue = xQueueCreate( 3, sizeof( uint32_t ) );
+    uint32_t testVals[ 3 ] = { 0, 1, 2 };
+
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueAddToSet( xQueue, xQueueSet ) );
+
+    TEST_ASSERT_EQUAL( 3, xQueueSendMultiple( xQueue, testVals, 3, 0 ) );
+
+    for( uint32_t i = 0; i < 3; i++ )
+    {
+        uint32_t checkValue = INVALID_UINT32;
+
+        TEST_ASSERT_EQUAL( xQueue, xQueueSelectFromSet( xQueueSet, 0 ) );
+        TEST_ASSERT_EQUAL( pdTRUE, xQueueReceive( xQueue, &checkValue, 0 ) );
+        TEST_ASSERT_EQUAL( i, checkValue );
+    }
+
+    TEST_ASSERT_EQUAL( NULL, xQueueSelectFromSet( xQueueSet, 0 ) );
+
+    vQueueDelete( xQueueSet );
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Test xQueueSendMultipleFromISR on a member Queue (size 2) of a QueueSet (size 2)
+ * @details: Send a batch of two items from an ISR to a queue that is part of
+ *  a QueueSet.  Verify that the queue is selected from the set once per item
+ *  via xQueueSelectFromSetFromISR, and the batch read back with
+ *  xQueueReceiveMultipleFromISR.
+ * @coverage xQueueSendMultipleFromISR xQueueReceiveMultipleFromISR
+ */
+void test_xQueueSendMultipleFromISR_xQueueSelectFromSetFromISR_once_per_item( void )
+{
+    QueueSetHandle_t xQueueSet = xQueueCreateSet( 2 );
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t testVals[ 2 ] = { 5, 6 };
+    uint32_t checkVals[ 2 ] = { INVALID_UINT32, INVALID_UINT32 };
+
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueAddToSet( xQueue, xQueueSet ) );
+
+    TEST_ASSERT_EQUAL( 2, xQueueSendMultipleFromISR( xQueue, testVals, 2, NULL ) );
+
+    TEST_ASSERT_EQUAL( xQueue, xQueueSelectFromSetFromISR( xQueueSet ) );
+    TEST_ASSERT_EQUAL( xQueue, xQueueSelectFromSetFromISR( xQueueSet ) );
+    TEST_ASSERT_EQUAL( NULL, xQueueSelectFromSetFromISR( xQueueSet ) );
+
+    TEST_ASSERT_EQUAL( 2, xQueueReceiveMultipleFromISR( xQueue, checkVals, 2, NULL ) );
+    TEST_ASSERT_EQUAL( 5, checkVals[ 0 ] );
+    TEST_ASSERT_EQUAL( 6, checkVals[ 1 ] );
+
+    vQueueDelete( xQueueSet );
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Test xQueueSendMultiple on a member Queue of a QueueSet with a higher
+ * priority task blocked on the QueueSet.
+ * @details: Verify that the waiting task is unblocked and the sender yields
+ *  once for the whole batch.
+ * @coverage xQueueSendMultiple prvUnblockReceivers
+ */
+void test_xQueueSendMultiple_unblocks_task_waiting_on_set( void )
+{
+    QueueSetHandle_t xQueueSet = xQueueCreateSet( 2 );
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t testVals[ 2 ] = { 0, 1 };
+
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueAddToSet( xQueue, xQueueSet ) );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToReceiveFromQueue( xQueueSet );
+
+    TEST_ASSERT_EQUAL( 2, xQueueSendMultiple( xQueue, testVals, 2, 0 ) );
+
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToReceiveFromQueue( xQueueSet ) ) );
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+    TEST_ASSERT_EQUAL( 2, uxQueueMessagesWaiting( xQueueSet ) );
+
+    ( void ) xQueueReset( xQueue );
+    ( void ) xQueueReset( xQueueSet );
+    vQueueDelete( xQueueSet );
+    vQueueDelete( xQueue );
+}
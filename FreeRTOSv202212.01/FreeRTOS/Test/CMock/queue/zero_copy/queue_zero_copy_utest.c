@@ -0,0 +1,606 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file queue_zero_copy_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../queue_utest_common.h"
+
+/* Queue includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "queue.h"
+#include "mock_fake_port.h"
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* Used to share a QueueHandle_t between a test case and it's callbacks */
+static QueueHandle_t xQueueHandleStatic;
+
+/* ============================= Unity Fixtures ============================= */
+
+void setUp( void )
+{
+    commonSetUp();
+    vFakePortAssertIfInterruptPriorityInvalid_Ignore();
+    xQueueHandleStatic = NULL;
+}
+
+void tearDown( void )
+{
+    commonTearDown();
+}
+
+void suiteSetUp()
+{
+    commonSuiteSetUp();
+}
+
+int suiteTearDown( int numFailures )
+{
+    return commonSuiteTearDown( numFailures );
+}
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+/**
+ * @brief Callback for xTaskCheckForTimeOut which receives an item from the
+ * test queue from an ISR once the calling task has blocked a few times.
+ */
+static BaseType_t xReceiveFromISR_xTaskCheckForTimeOutCB( TimeOut_t * const pxTimeOut,
+                                                          TickType_t * const pxTicksToWait,
+                                                          int cmock_num_calls )
+{
+    BaseType_t xReturnValue = td_task_xTaskCheckForTimeOutStub( pxTimeOut, pxTicksToWait, cmock_num_calls );
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        uint32_t checkVal = INVALID_UINT32;
+        TEST_ASSERT_EQUAL( pdTRUE, xQueueReceiveFromISR( xQueueHandleStatic, &checkVal, NULL ) );
+        TEST_ASSERT_EQUAL( getLastMonotonicTestValue(), checkVal );
+    }
+
+    return xReturnValue;
+}
+
+/**
+ * @brief Callback for xTaskCheckForTimeOut which sends an item to the test
+ * queue from an ISR once the calling task has blocked a few times.
+ */
+static BaseType_t xSendFromISR_xTaskCheckForTimeOutCB( TimeOut_t * const pxTimeOut,
+                                                       TickType_t * const pxTicksToWait,
+                                                       int cmock_num_calls )
+{
+    BaseType_t xReturnValue = td_task_xTaskCheckForTimeOutStub( pxTimeOut, pxTicksToWait, cmock_num_calls );
+
+    if( cmock_num_calls == NUM_CALLS_TO_INTERCEPT )
+    {
+        uint32_t testVal = getNextMonotonicTestValue();
+        TEST_ASSERT_EQUAL( pdTRUE, xQueueSendFromISR( xQueueHandleStatic, &testVal, NULL ) );
+    }
+
+    return xReturnValue;
+}
+
+/* ===========================  Send slot tests  =========================== */
+
+/**
+ * @brief An item written into an acquired slot is received once it is committed.
+ * @coverage pvQueueAcquireSendSlot vQueueCommitSendSlot
+ */
+void test_pvQueueAcquireSendSlot_commit_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t checkVal = INVALID_UINT32;
+    uint32_t * pulSlot;
+
+    pulSlot = ( uint32_t * ) pvQueueAcquireSendSlot( xQueue, 0 );
+    TEST_ASSERT_NOT_NULL( pulSlot );
+
+    *pulSlot = getNextMonotonicTestValue();
+
+    /* The lent slot is not yet an item, but is no longer free. */
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+    TEST_ASSERT_EQUAL( 1, uxQueueSpacesAvailable( xQueue ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xQueueReceive( xQueue, &checkVal, 0 ) );
+
+    vQueueCommitSendSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( 1, uxQueueMessagesWaiting( xQueue ) );
+    TEST_ASSERT_EQUAL( 1, uxQueueSpacesAvailable( xQueue ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueReceive( xQueue, &checkVal, 0 ) );
+    TEST_ASSERT_EQUAL( getLastMonotonicTestValue(), checkVal );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Committed items are received in order, including when the write
+ * position wraps from the end of the storage area to the start.
+ * @coverage pvQueueAcquireSendSlot vQueueCommitSendSlot
+ */
+void test_pvQueueAcquireSendSlot_commit_wraps( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 3, sizeof( uint32_t ) );
+    uint32_t checkVal = INVALID_UINT32;
+    uint32_t * pulSlot;
+    uint32_t i;
+
+    for( i = 0; i < 7; i++ )
+    {
+        pulSlot = ( uint32_t * ) pvQueueAcquireSendSlot( xQueue, 0 );
+        TEST_ASSERT_NOT_NULL( pulSlot );
+        *pulSlot = getNextMonotonicTestValue();
+        vQueueCommitSendSlot( xQueue );
+
+        TEST_ASSERT_EQUAL( pdTRUE, xQueueReceive( xQueue, &checkVal, 0 ) );
+        TEST_ASSERT_EQUAL( getLastMonotonicTestValue(), checkVal );
+    }
+
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Only one send slot can be lent at a time, and no slot is lent from a
+ * full queue.
+ * @coverage pvQueueAcquireSendSlot
+ */
+void test_pvQueueAcquireSendSlot_unavailable_nonblocking( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+
+    TEST_ASSERT_NOT_NULL( pvQueueAcquireSendSlot( xQueue, 0 ) );
+    TEST_ASSERT_NULL( pvQueueAcquireSendSlot( xQueue, 0 ) );
+    vQueueCommitSendSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueSend( xQueue, &testVal, 0 ) );
+    TEST_ASSERT_EQUAL( 0, uxQueueSpacesAvailable( xQueue ) );
+    TEST_ASSERT_NULL( pvQueueAcquireSendSlot( xQueue, 0 ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief While the send slot is lent, sends to the back of the queue from
+ * tasks and ISRs fail, but a send to the front still succeeds.
+ * @coverage pvQueueAcquireSendSlot xQueueGenericSend xQueueGenericSendFromISR
+ */
+void test_pvQueueAcquireSendSlot_blocks_send_to_back( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 3, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+    uint32_t checkVal = INVALID_UINT32;
+    uint32_t * pulSlot;
+
+    pulSlot = ( uint32_t * ) pvQueueAcquireSendSlot( xQueue, 0 );
+    TEST_ASSERT_NOT_NULL( pulSlot );
+    *pulSlot = testVal + 1;
+
+    TEST_ASSERT_EQUAL( errQUEUE_FULL, xQueueSendToBack( xQueue, &testVal, 0 ) );
+    TEST_ASSERT_EQUAL( errQUEUE_FULL, xQueueSendToBackFromISR( xQueue, &testVal, NULL ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueSendToFront( xQueue, &testVal, 0 ) );
+
+    vQueueCommitSendSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueReceive( xQueue, &checkVal, 0 ) );
+    TEST_ASSERT_EQUAL( testVal, checkVal );
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueReceive( xQueue, &checkVal, 0 ) );
+    TEST_ASSERT_EQUAL( testVal + 1, checkVal );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Acquiring a send slot on a full queue times out after blocking.
+ * @coverage pvQueueAcquireSendSlot
+ */
+void test_pvQueueAcquireSendSlot_blocking_timeout( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueSend( xQueue, &testVal, 0 ) );
+
+    TEST_ASSERT_NULL( pvQueueAcquireSendSlot( xQueue, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+    TEST_ASSERT_EQUAL( 1, uxQueueMessagesWaiting( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A task blocked acquiring a send slot gets one once an ISR has
+ * received from the full queue.
+ * @coverage pvQueueAcquireSendSlot
+ */
+void test_pvQueueAcquireSendSlot_blocking_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+
+    xQueueHandleStatic = xQueue;
+
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueSend( xQueue, &testVal, 0 ) );
+
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 1 );
+    xTaskCheckForTimeOut_Stub( &xReceiveFromISR_xTaskCheckForTimeOutCB );
+
+    TEST_ASSERT_NOT_NULL( pvQueueAcquireSendSlot( xQueue, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueCommitSendSlot( xQueue );
+    TEST_ASSERT_EQUAL( 1, uxQueueMessagesWaiting( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Committing a slot unblocks a higher priority task waiting to receive.
+ * @coverage vQueueCommitSendSlot
+ */
+void test_vQueueCommitSendSlot_wakes_receiver( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+
+    TEST_ASSERT_NOT_NULL( pvQueueAcquireSendSlot( xQueue, 0 ) );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToReceiveFromQueue( xQueue );
+
+    vQueueCommitSendSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToReceiveFromQueue( xQueue ) ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Committing a slot unblocks a higher priority task that was waiting to
+ * send only because the send slot was lent.
+ * @coverage vQueueCommitSendSlot
+ */
+void test_vQueueCommitSendSlot_wakes_sender( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+
+    TEST_ASSERT_NOT_NULL( pvQueueAcquireSendSlot( xQueue, 0 ) );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToSendToQueue( xQueue );
+
+    vQueueCommitSendSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToSendToQueue( xQueue ) ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A sender waiting on a queue that is still full after a commit is left
+ * blocked.
+ * @coverage vQueueCommitSendSlot
+ */
+void test_vQueueCommitSendSlot_full_leaves_sender_blocked( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+
+    TEST_ASSERT_NOT_NULL( pvQueueAcquireSendSlot( xQueue, 0 ) );
+
+    td_task_addFakeTaskWaitingToSendToQueue( xQueue );
+
+    vQueueCommitSendSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( 0, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToSendToQueue( xQueue ) ) );
+    TEST_ASSERT_EQUAL( 1, uxQueueMessagesWaiting( xQueue ) );
+
+    /* Take the fake task back off the event list before deleting the queue. */
+    ( void ) uxListRemove( listGET_HEAD_ENTRY( pxGetTasksWaitingToSendToQueue( xQueue ) ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Committing a slot of a queue that is a member of a queue set makes the
+ * queue available from the set.
+ * @coverage vQueueCommitSendSlot prvNotifyQueueSetContainer
+ */
+void test_vQueueCommitSendSlot_notifies_queue_set( void )
+{
+    QueueSetHandle_t xQueueSet = xQueueCreateSet( 1 );
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueAddToSet( xQueue, xQueueSet ) );
+
+    TEST_ASSERT_NOT_NULL( pvQueueAcquireSendSlot( xQueue, 0 ) );
+    TEST_ASSERT_NULL( xQueueSelectFromSet( xQueueSet, 0 ) );
+
+    vQueueCommitSendSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( xQueue, xQueueSelectFromSet( xQueueSet, 0 ) );
+
+    ( void ) xQueueReset( xQueue );
+    TEST_ASSERT_EQUAL( pdPASS, xQueueRemoveFromSet( xQueue, xQueueSet ) );
+    vQueueDelete( xQueueSet );
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Committing without a lent send slot is an error.
+ * @coverage vQueueCommitSendSlot
+ */
+void test_vQueueCommitSendSlot_not_acquired( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+
+    EXPECT_ASSERT_BREAK( vQueueCommitSendSlot( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Semaphores have no storage area, so cannot lend a slot.
+ * @coverage pvQueueAcquireSendSlot pvQueueBorrowReceiveSlot
+ */
+void test_zero_copy_semaphore_assert( void )
+{
+    QueueHandle_t xSemaphore = xQueueCreate( 1, 0 );
+
+    EXPECT_ASSERT_BREAK( pvQueueAcquireSendSlot( xSemaphore, 0 ) );
+    EXPECT_ASSERT_BREAK( pvQueueBorrowReceiveSlot( xSemaphore, 0 ) );
+
+    vQueueDelete( xSemaphore );
+}
+
+/* ==========================  Receive slot tests  ========================= */
+
+/**
+ * @brief A borrowed slot holds the item at the front of the queue, and is not
+ * reused until it is released.
+ * @coverage pvQueueBorrowReceiveSlot vQueueReleaseReceiveSlot
+ */
+void test_pvQueueBorrowReceiveSlot_release_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+    uint32_t * pulSlot;
+
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueSend( xQueue, &testVal, 0 ) );
+
+    pulSlot = ( uint32_t * ) pvQueueBorrowReceiveSlot( xQueue, 0 );
+    TEST_ASSERT_NOT_NULL( pulSlot );
+    TEST_ASSERT_EQUAL( testVal, *pulSlot );
+
+    /* The item has been removed, but its slot is not free yet. */
+    TEST_ASSERT_EQUAL( 0, uxQueueMessagesWaiting( xQueue ) );
+    TEST_ASSERT_EQUAL( 1, uxQueueSpacesAvailable( xQueue ) );
+
+    vQueueReleaseReceiveSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( 2, uxQueueSpacesAvailable( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief While a receive slot is borrowed the queue appears empty to tasks and
+ * ISRs, and items cannot be sent to its front.
+ * @coverage pvQueueBorrowReceiveSlot xQueueReceive xQueueReceiveFromISR
+ */
+void test_pvQueueBorrowReceiveSlot_blocks_receive( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 3, sizeof( uint32_t ) );
+    uint32_t checkVal = INVALID_UINT32;
+
+    queue_common_add_sequential_to_queue( xQueue, 2 );
+
+    TEST_ASSERT_NOT_NULL( pvQueueBorrowReceiveSlot( xQueue, 0 ) );
+    TEST_ASSERT_NULL( pvQueueBorrowReceiveSlot( xQueue, 0 ) );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xQueueReceive( xQueue, &checkVal, 0 ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xQueueReceiveFromISR( xQueue, &checkVal, NULL ) );
+    TEST_ASSERT_EQUAL( errQUEUE_FULL, xQueueSendToFront( xQueue, &checkVal, 0 ) );
+
+    vQueueReleaseReceiveSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xQueueReceive( xQueue, &checkVal, 0 ) );
+    TEST_ASSERT_EQUAL( 1, checkVal );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Borrowing a receive slot from an empty queue times out after
+ * blocking.
+ * @coverage pvQueueBorrowReceiveSlot
+ */
+void test_pvQueueBorrowReceiveSlot_blocking_timeout( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+
+    TEST_ASSERT_NULL( pvQueueBorrowReceiveSlot( xQueue, 0 ) );
+    TEST_ASSERT_NULL( pvQueueBorrowReceiveSlot( xQueue, TICKS_TO_WAIT ) );
+
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( TICKS_TO_WAIT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief A task blocked borrowing a receive slot gets the item an ISR sends.
+ * @coverage pvQueueBorrowReceiveSlot
+ */
+void test_pvQueueBorrowReceiveSlot_blocking_success( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    uint32_t * pulSlot;
+
+    xQueueHandleStatic = xQueue;
+
+    uxTaskGetNumberOfTasks_IgnoreAndReturn( 1 );
+    xTaskCheckForTimeOut_Stub( &xSendFromISR_xTaskCheckForTimeOutCB );
+
+    pulSlot = ( uint32_t * ) pvQueueBorrowReceiveSlot( xQueue, TICKS_TO_WAIT );
+    TEST_ASSERT_NOT_NULL( pulSlot );
+    TEST_ASSERT_EQUAL( getLastMonotonicTestValue(), *pulSlot );
+
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( NUM_CALLS_TO_INTERCEPT, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueReleaseReceiveSlot( xQueue );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Releasing a slot unblocks a higher priority task waiting to send.
+ * @coverage vQueueReleaseReceiveSlot
+ */
+void test_vQueueReleaseReceiveSlot_wakes_sender( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+
+    queue_common_add_sequential_to_queue( xQueue, 1 );
+    TEST_ASSERT_NOT_NULL( pvQueueBorrowReceiveSlot( xQueue, 0 ) );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToSendToQueue( xQueue );
+
+    vQueueReleaseReceiveSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Releasing a slot unblocks a higher priority task that was waiting to
+ * receive only because the receive slot was borrowed.
+ * @coverage vQueueReleaseReceiveSlot
+ */
+void test_vQueueReleaseReceiveSlot_wakes_receiver( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 2, sizeof( uint32_t ) );
+
+    queue_common_add_sequential_to_queue( xQueue, 2 );
+    TEST_ASSERT_NOT_NULL( pvQueueBorrowReceiveSlot( xQueue, 0 ) );
+
+    td_task_setFakeTaskPriority( DEFAULT_PRIORITY + 1 );
+    td_task_addFakeTaskWaitingToReceiveFromQueue( xQueue );
+
+    vQueueReleaseReceiveSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( 1, td_task_getYieldCount() );
+    TEST_ASSERT_EQUAL( 1, td_task_getCount_vPortYieldWithinAPI() );
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTH( pxGetTasksWaitingToReceiveFromQueue( xQueue ) ) );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief Releasing without a borrowed receive slot is an error.
+ * @coverage vQueueReleaseReceiveSlot
+ */
+void test_vQueueReleaseReceiveSlot_not_borrowed( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+
+    EXPECT_ASSERT_BREAK( vQueueReleaseReceiveSlot( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
+
+/* ============================  Overwrite tests  ========================== */
+
+/**
+ * @brief xQueueOverwrite and xQueueOverwriteFromISR return errQUEUE_FULL
+ * while the only slot is lent for sending, and succeed once it is committed.
+ * @coverage xQueueGenericSend xQueueGenericSendFromISR
+ */
+void test_xQueueOverwrite_send_slot_lent( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+    uint32_t checkVal = INVALID_UINT32;
+    uint32_t * pulSlot;
+
+    pulSlot = ( uint32_t * ) pvQueueAcquireSendSlot( xQueue, 0 );
+    TEST_ASSERT_NOT_NULL( pulSlot );
+    *pulSlot = testVal;
+
+    TEST_ASSERT_EQUAL( errQUEUE_FULL, xQueueOverwrite( xQueue, &testVal ) );
+    TEST_ASSERT_EQUAL( errQUEUE_FULL, xQueueOverwriteFromISR( xQueue, &testVal, NULL ) );
+
+    vQueueCommitSendSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueOverwrite( xQueue, &testVal ) );
+    TEST_ASSERT_EQUAL( pdPASS, xQueueOverwriteFromISR( xQueue, &testVal, NULL ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xQueuePeek( xQueue, &checkVal, 0 ) );
+    TEST_ASSERT_EQUAL( testVal, checkVal );
+
+    vQueueDelete( xQueue );
+}
+
+/**
+ * @brief xQueueOverwrite and xQueueOverwriteFromISR return errQUEUE_FULL
+ * while the only slot is borrowed for receiving, and succeed once it is
+ * released.
+ * @coverage xQueueGenericSend xQueueGenericSendFromISR
+ */
+void test_xQueueOverwrite_receive_slot_lent( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    uint32_t testVal = getNextMonotonicTestValue();
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueOverwrite( xQueue, &testVal ) );
+    TEST_ASSERT_NOT_NULL( pvQueueBorrowReceiveSlot( xQueue, 0 ) );
+
+    TEST_ASSERT_EQUAL( errQUEUE_FULL, xQueueOverwrite( xQueue, &testVal ) );
+    TEST_ASSERT_EQUAL( errQUEUE_FULL, xQueueOverwriteFromISR( xQueue, &testVal, NULL ) );
+
+    vQueueReleaseReceiveSlot( xQueue );
+
+    TEST_ASSERT_EQUAL( pdPASS, xQueueOverwriteFromISR( xQueue, &testVal, NULL ) );
+    TEST_ASSERT_EQUAL( 1, uxQueueMessagesWaiting( xQueue ) );
+
+    vQueueDelete( xQueue );
+}
@@ -0,0 +1,743 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file stream_buffer_spans_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Stream Buffer includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "stream_buffer.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "unity_memory.h"
+#include "CException.h"
+
+/* Mock includes. */
+#include "mock_task.h"
+#include "mock_fake_assert.h"
+#include "mock_fake_port.h"
+
+/**
+ * @brief Sample size in bytes of the stream buffer used for test.
+ * The size is kept short enough so that the buffer can be allocated on stack.
+ */
+#define TEST_STREAM_BUFFER_SIZE             ( 64U )
+
+/**
+ * @brief Sample trigger level in bytes used for stream buffer tests.
+ */
+#define TEST_STREAM_BUFFER_TRIGGER_LEVEL    ( 32U )
+
+/**
+ * @brief Wait ticks passed into from tests if the stream buffer is full while reserving space or
+ * empty while acquiring data.
+ */
+#define TEST_STREAM_BUFFER_WAIT_TICKS       ( 1000U )
+
+/**
+ * @brief Offset into the buffer of the stream buffer at which the tests make free space and data
+ * wrap from the end of the storage area to its start.
+ */
+#define TEST_WRAP_OFFSET                    ( 50U )
+
+/**
+ * @brief CException code for when a configASSERT should be intercepted.
+ */
+#define configASSERT_E                      0xAA101
+
+/**
+ * @brief Expect a configASSERT from the function called.
+ *  Break out of the called function when this occurs.
+ * @details Use this macro when the call passed in as a parameter is expected
+ * to cause invalid memory access.
+ */
+#define EXPECT_ASSERT_BREAK( call )                  \
+    do                                               \
+    {                                                \
+        shouldAbortOnAssertion = true;               \
+        CEXCEPTION_T e = CEXCEPTION_NONE;            \
+        Try                                          \
+        {                                            \
+            call;                                    \
+            TEST_FAIL_MESSAGE( "Expected Assert!" ); \
+        }                                            \
+        Catch( e )                                   \
+        {                                            \
+            TEST_ASSERT_EQUAL( configASSERT_E, e );  \
+        }                                            \
+    } while( 0 )
+
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/**
+ * @brief Global counter for the number of assertions in code.
+ */
+static int assertionFailed = 0;
+
+/**
+ * @brief Global counter to keep track of how many times a sender task was woken up by a task receiving from the stream buffer.
+ */
+static int senderTaskWoken = 0;
+
+/**
+ * @brief Global counter to keep track of how many times a receiver task was woken up by a task sending to the buffer.
+ */
+static int receiverTaskWoken = 0;
+
+/**
+ * @brief Dummy sender task handle to which the stream buffer receive APIs will send notification.
+ */
+static TaskHandle_t senderTask = ( TaskHandle_t ) ( 0xAABBCCDD );
+
+/**
+ * @brief Dummy receiver task handle to which the stream buffer send APIs will send notifications.
+ */
+static TaskHandle_t receiverTask = ( TaskHandle_t ) ( 0xABCDEEFF );
+
+/**
+ * @brief Global Stream buffer handle used for tests.
+ */
+static StreamBufferHandle_t xStreamBuffer;
+
+/**
+ * @brief Flag which denotes if test need to abort on assertion.
+ */
+static BaseType_t shouldAbortOnAssertion;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+void * pvPortMalloc( size_t xSize )
+{
+    return unity_malloc( xSize );
+}
+void vPortFree( void * pv )
+{
+    return unity_free( pv );
+}
+
+static void vFakeAssertStub( bool x,
+                             char * file,
+                             int line,
+                             int cmock_num_calls )
+{
+    if( !x )
+    {
+        assertionFailed++;
+
+        if( shouldAbortOnAssertion == pdTRUE )
+        {
+            Throw( configASSERT_E );
+        }
+    }
+}
+
+static BaseType_t reserveAndCommitCallback( UBaseType_t uxIndexToWaitOn,
+                                            uint32_t ulBitsToClearOnEntry,
+                                            uint32_t ulBitsToClearOnExit,
+                                            uint32_t * pulNotificationValue,
+                                            TickType_t xTicksToWait,
+                                            int cmock_num_calls )
+{
+    StreamBufferSpans_t spans;
+
+    /* Write trigger level bytes in place to wake up the receiver task. */
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSendReserve( xStreamBuffer, &spans, 0 ) );
+    memset( spans.pucSpan[ 0 ], 0xA5, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferSendCommit( xStreamBuffer, TEST_STREAM_BUFFER_TRIGGER_LEVEL ) );
+    return pdTRUE;
+}
+
+static BaseType_t reserveAndCommitFromISRCallback( UBaseType_t uxIndexToWaitOn,
+                                                   uint32_t ulBitsToClearOnEntry,
+                                                   uint32_t ulBitsToClearOnExit,
+                                                   uint32_t * pulNotificationValue,
+                                                   TickType_t xTicksToWait,
+                                                   int cmock_num_calls )
+{
+    StreamBufferSpans_t spans;
+    BaseType_t receiverTaskWokenFromISR = pdFALSE;
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSendReserveFromISR( xStreamBuffer, &spans ) );
+    memset( spans.pucSpan[ 0 ], 0x5A, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+
+    /* Less than the trigger level does not wake up the receiver task. */
+    TEST_ASSERT_EQUAL( 1, xStreamBufferSendCommitFromISR( xStreamBuffer, 1, &receiverTaskWokenFromISR ) );
+    TEST_ASSERT_EQUAL( pdFALSE, receiverTaskWokenFromISR );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL - 1, xStreamBufferSendCommitFromISR( xStreamBuffer, TEST_STREAM_BUFFER_TRIGGER_LEVEL - 1, &receiverTaskWokenFromISR ) );
+    TEST_ASSERT_EQUAL( pdTRUE, receiverTaskWokenFromISR );
+    return pdTRUE;
+}
+
+static BaseType_t acquireAndReleaseCallback( UBaseType_t uxIndexToWaitOn,
+                                             uint32_t ulBitsToClearOnEntry,
+                                             uint32_t ulBitsToClearOnExit,
+                                             uint32_t * pulNotificationValue,
+                                             TickType_t xTicksToWait,
+                                             int cmock_num_calls )
+{
+    StreamBufferSpans_t spans;
+
+    /* Read all the data in place to wake up the sender task. */
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceiveAcquire( xStreamBuffer, &spans, 0 ) );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceiveRelease( xStreamBuffer, TEST_STREAM_BUFFER_SIZE ) );
+    return pdTRUE;
+}
+
+static BaseType_t acquireAndReleaseFromISRCallback( UBaseType_t uxIndexToWaitOn,
+                                                    uint32_t ulBitsToClearOnEntry,
+                                                    uint32_t ulBitsToClearOnExit,
+                                                    uint32_t * pulNotificationValue,
+                                                    TickType_t xTicksToWait,
+                                                    int cmock_num_calls )
+{
+    StreamBufferSpans_t spans;
+    BaseType_t senderTaskWokenFromISR = pdFALSE;
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceiveAcquireFromISR( xStreamBuffer, &spans ) );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceiveReleaseFromISR( xStreamBuffer, TEST_STREAM_BUFFER_SIZE, &senderTaskWokenFromISR ) );
+    TEST_ASSERT_EQUAL( pdTRUE, senderTaskWokenFromISR );
+    return pdTRUE;
+}
+
+static BaseType_t senderTaskNotificationCallback( TaskHandle_t xTaskToNotify,
+                                                  UBaseType_t uxIndexToNotify,
+                                                  uint32_t ulValue,
+                                                  eNotifyAction eAction,
+                                                  uint32_t * pulPreviousNotificationValue,
+                                                  int cmock_num_calls )
+{
+    TEST_ASSERT_EQUAL( senderTask, xTaskToNotify );
+    senderTaskWoken++;
+    return pdTRUE;
+}
+
+static BaseType_t senderTaskNotificationFromISRCallback( TaskHandle_t xTaskToNotify,
+                                                         UBaseType_t uxIndexToNotify,
+                                                         uint32_t ulValue,
+                                                         eNotifyAction eAction,
+                                                         uint32_t * pulPreviousNotificationValue,
+                                                         BaseType_t * pxHigherPriorityTaskWoken,
+                                                         int cmock_num_calls )
+{
+    TEST_ASSERT_EQUAL( senderTask, xTaskToNotify );
+    senderTaskWoken++;
+    *pxHigherPriorityTaskWoken = pdTRUE;
+
+    return pdTRUE;
+}
+
+static BaseType_t receiverTaskNotificationCallback( TaskHandle_t xTaskToNotify,
+                                                    UBaseType_t uxIndexToNotify,
+                                                    uint32_t ulValue,
+                                                    eNotifyAction eAction,
+                                                    uint32_t * pulPreviousNotificationValue,
+                                                    int cmock_num_calls )
+{
+    TEST_ASSERT_EQUAL( receiverTask, xTaskToNotify );
+    receiverTaskWoken++;
+    return pdTRUE;
+}
+
+static BaseType_t receiverTaskNotificationFromISRCallback( TaskHandle_t xTaskToNotify,
+                                                           UBaseType_t uxIndexToNotify,
+                                                           uint32_t ulValue,
+                                                           eNotifyAction eAction,
+                                                           uint32_t * pulPreviousNotificationValue,
+                                                           BaseType_t * pxHigherPriorityTaskWoken,
+                                                           int cmock_num_calls )
+{
+    TEST_ASSERT_EQUAL( receiverTask, xTaskToNotify );
+    receiverTaskWoken++;
+    *pxHigherPriorityTaskWoken = pdTRUE;
+
+    return pdTRUE;
+}
+
+/*******************************************************************************
+ * Unity fixtures
+ ******************************************************************************/
+void setUp( void )
+{
+    assertionFailed = 0;
+    xStreamBuffer = NULL;
+    senderTaskWoken = 0;
+    receiverTaskWoken = 0;
+    shouldAbortOnAssertion = pdTRUE;
+
+    mock_task_Init();
+    mock_fake_assert_Init();
+    mock_fake_port_Init();
+
+    vFakePortEnterCriticalSection_Ignore();
+    vFakePortExitCriticalSection_Ignore();
+    ulFakePortSetInterruptMaskFromISR_IgnoreAndReturn( 0U );
+    vFakePortClearInterruptMaskFromISR_Ignore();
+    vFakeAssert_StubWithCallback( vFakeAssertStub );
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+}
+
+/*! called before each test case */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL_MESSAGE( 0, assertionFailed, "Assertion check failed in code." );
+    UnityMalloc_EndTest();
+    mock_task_Verify();
+    mock_task_Destroy();
+    mock_fake_assert_Verify();
+    mock_fake_assert_Destroy();
+    mock_fake_port_Verify();
+    mock_fake_port_Destroy();
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+static void validate_and_clear_assertions( void )
+{
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+}
+
+/**
+ * @brief Sends and receives TEST_WRAP_OFFSET bytes so that the free space, and then data, wraps
+ * from the end of the stream buffer's storage area to its start.
+ */
+static void move_to_wrap_offset( void )
+{
+    uint8_t data[ TEST_WRAP_OFFSET ] = { 0 };
+
+    TEST_ASSERT_EQUAL( TEST_WRAP_OFFSET, xStreamBufferSend( xStreamBuffer, data, TEST_WRAP_OFFSET, 0 ) );
+    TEST_ASSERT_EQUAL( TEST_WRAP_OFFSET, xStreamBufferReceive( xStreamBuffer, data, TEST_WRAP_OFFSET, 0 ) );
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief Validates that the free space of an empty stream buffer is reserved as one span, and the
+ * bytes written in place are received once they are committed.
+ */
+void test_xStreamBufferSendReserve_commit_success( void )
+{
+    StreamBufferSpans_t spans;
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+    uint8_t expected[ TEST_STREAM_BUFFER_SIZE ];
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSendReserve( xStreamBuffer, &spans, 0 ) );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, spans.xSpanLength[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, spans.xSpanLength[ 1 ] );
+
+    for( size_t i = 0; i < TEST_STREAM_BUFFER_SIZE; i++ )
+    {
+        expected[ i ] = ( uint8_t ) i;
+    }
+
+    memcpy( spans.pucSpan[ 0 ], expected, 40 );
+
+    /* Nothing is added until the bytes are committed. */
+    TEST_ASSERT_EQUAL( 0, xStreamBufferBytesAvailable( xStreamBuffer ) );
+
+    /* Committing no bytes adds nothing. */
+    TEST_ASSERT_EQUAL( 0, xStreamBufferSendCommit( xStreamBuffer, 0 ) );
+    TEST_ASSERT_EQUAL( 0, xStreamBufferBytesAvailable( xStreamBuffer ) );
+
+    TEST_ASSERT_EQUAL( 40, xStreamBufferSendCommit( xStreamBuffer, 40 ) );
+    TEST_ASSERT_EQUAL( 40, xStreamBufferBytesAvailable( xStreamBuffer ) );
+
+    TEST_ASSERT_EQUAL( 40, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), 0 ) );
+    TEST_ASSERT_EQUAL_MEMORY( expected, data, 40 );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that free space that wraps around the end of the storage area is reserved as
+ * two spans, and that a commit fills span 0 before span 1.
+ */
+void test_xStreamBufferSendReserve_wraps( void )
+{
+    StreamBufferSpans_t spans;
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+    uint8_t expected[ TEST_STREAM_BUFFER_SIZE ];
+    size_t firstSpanLength;
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    move_to_wrap_offset();
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSendReserve( xStreamBuffer, &spans, 0 ) );
+
+    /* The storage area holds one byte more than the stream buffer size. */
+    firstSpanLength = TEST_STREAM_BUFFER_SIZE + 1U - TEST_WRAP_OFFSET;
+    TEST_ASSERT_EQUAL( firstSpanLength, spans.xSpanLength[ 0 ] );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE - firstSpanLength, spans.xSpanLength[ 1 ] );
+    TEST_ASSERT_EQUAL_PTR( spans.pucSpan[ 0 ] + firstSpanLength, spans.pucSpan[ 1 ] + TEST_STREAM_BUFFER_SIZE + 1U );
+
+    for( size_t i = 0; i < TEST_STREAM_BUFFER_SIZE; i++ )
+    {
+        expected[ i ] = ( uint8_t ) ( 0x80 + i );
+    }
+
+    memcpy( spans.pucSpan[ 0 ], expected, spans.xSpanLength[ 0 ] );
+    memcpy( spans.pucSpan[ 1 ], &expected[ firstSpanLength ], spans.xSpanLength[ 1 ] );
+
+    TEST_ASSERT_EQUAL( firstSpanLength + 5U, xStreamBufferSendCommit( xStreamBuffer, firstSpanLength + 5U ) );
+    TEST_ASSERT_EQUAL( firstSpanLength + 5U, xStreamBufferBytesAvailable( xStreamBuffer ) );
+
+    TEST_ASSERT_EQUAL( firstSpanLength + 5U, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), 0 ) );
+    TEST_ASSERT_EQUAL_MEMORY( expected, data, firstSpanLength + 5U );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that no space is reserved in a full stream buffer, and that committing more
+ * bytes than are free asserts.
+ */
+void test_xStreamBufferSendReserve_full( void )
+{
+    StreamBufferSpans_t spans;
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+
+    TEST_ASSERT_EQUAL( 0, xStreamBufferSendReserve( xStreamBuffer, &spans, 0 ) );
+    TEST_ASSERT_EQUAL( 0, spans.xSpanLength[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, spans.xSpanLength[ 1 ] );
+    TEST_ASSERT_EQUAL( 0, xStreamBufferSendReserveFromISR( xStreamBuffer, &spans ) );
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferSendCommit( xStreamBuffer, 1 ) );
+    validate_and_clear_assertions();
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that reserving space in a full stream buffer blocks until a task has read
+ * the data in place and released it.
+ */
+void test_xStreamBufferSendReserve_blocking( void )
+{
+    StreamBufferSpans_t spans;
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+    xTaskGenericNotifyWait_StubWithCallback( acquireAndReleaseCallback );
+    xTaskGenericNotify_StubWithCallback( senderTaskNotificationCallback );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdFALSE );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSendReserve( xStreamBuffer, &spans, TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    TEST_ASSERT_EQUAL( 1, senderTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that reserving space in a full stream buffer blocks until space is released
+ * from an ISR.
+ */
+void test_xStreamBufferSendReserve_blocking_release_from_isr( void )
+{
+    StreamBufferSpans_t spans;
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+    xTaskGenericNotifyWait_StubWithCallback( acquireAndReleaseFromISRCallback );
+    xTaskGenericNotifyFromISR_StubWithCallback( senderTaskNotificationFromISRCallback );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdFALSE );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSendReserve( xStreamBuffer, &spans, TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    TEST_ASSERT_EQUAL( 1, senderTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that reserving space in a stream buffer that stays full returns 0 once the
+ * block time expires.
+ */
+void test_xStreamBufferSendReserve_blocking_timeout( void )
+{
+    StreamBufferSpans_t spans;
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+    xTaskGenericNotifyWait_IgnoreAndReturn( pdFALSE );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdTRUE );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+
+    TEST_ASSERT_EQUAL( 0, xStreamBufferSendReserve( xStreamBuffer, &spans, TEST_STREAM_BUFFER_WAIT_TICKS ) );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that the data in a stream buffer is described in place, and removed only
+ * as far as it is released.
+ */
+void test_xStreamBufferReceiveAcquire_release_success( void )
+{
+    StreamBufferSpans_t spans;
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    /* Nothing to acquire. */
+    TEST_ASSERT_EQUAL( 0, xStreamBufferReceiveAcquire( xStreamBuffer, &spans, 0 ) );
+    TEST_ASSERT_EQUAL( 0, xStreamBufferReceiveAcquireFromISR( xStreamBuffer, &spans ) );
+
+    for( size_t i = 0; i < TEST_STREAM_BUFFER_SIZE; i++ )
+    {
+        data[ i ] = ( uint8_t ) i;
+    }
+
+    TEST_ASSERT_EQUAL( 20, xStreamBufferSend( xStreamBuffer, data, 20, 0 ) );
+
+    TEST_ASSERT_EQUAL( 20, xStreamBufferReceiveAcquire( xStreamBuffer, &spans, 0 ) );
+    TEST_ASSERT_EQUAL( 20, spans.xSpanLength[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, spans.xSpanLength[ 1 ] );
+    TEST_ASSERT_EQUAL_MEMORY( data, spans.pucSpan[ 0 ], 20 );
+
+    /* Releasing no bytes removes nothing. */
+    TEST_ASSERT_EQUAL( 0, xStreamBufferReceiveRelease( xStreamBuffer, 0 ) );
+    TEST_ASSERT_EQUAL( 20, xStreamBufferBytesAvailable( xStreamBuffer ) );
+
+    TEST_ASSERT_EQUAL( 8, xStreamBufferReceiveRelease( xStreamBuffer, 8 ) );
+    TEST_ASSERT_EQUAL( 12, xStreamBufferBytesAvailable( xStreamBuffer ) );
+
+    TEST_ASSERT_EQUAL( 12, xStreamBufferReceiveAcquire( xStreamBuffer, &spans, 0 ) );
+    TEST_ASSERT_EQUAL_MEMORY( &data[ 8 ], spans.pucSpan[ 0 ], 12 );
+
+    /* Can't release more than was acquired. */
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferReceiveRelease( xStreamBuffer, 13 ) );
+    validate_and_clear_assertions();
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that data that wraps around the end of the storage area is acquired as two spans.
+ */
+void test_xStreamBufferReceiveAcquire_wraps( void )
+{
+    StreamBufferSpans_t spans;
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+    size_t firstSpanLength;
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    move_to_wrap_offset();
+
+    for( size_t i = 0; i < TEST_STREAM_BUFFER_SIZE; i++ )
+    {
+        data[ i ] = ( uint8_t ) ( 0x40 + i );
+    }
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceiveAcquire( xStreamBuffer, &spans, 0 ) );
+
+    firstSpanLength = TEST_STREAM_BUFFER_SIZE + 1U - TEST_WRAP_OFFSET;
+    TEST_ASSERT_EQUAL( firstSpanLength, spans.xSpanLength[ 0 ] );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE - firstSpanLength, spans.xSpanLength[ 1 ] );
+    TEST_ASSERT_EQUAL_MEMORY( data, spans.pucSpan[ 0 ], spans.xSpanLength[ 0 ] );
+    TEST_ASSERT_EQUAL_MEMORY( &data[ firstSpanLength ], spans.pucSpan[ 1 ], spans.xSpanLength[ 1 ] );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceiveRelease( xStreamBuffer, TEST_STREAM_BUFFER_SIZE ) );
+    TEST_ASSERT_TRUE( xStreamBufferIsEmpty( xStreamBuffer ) );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that acquiring data from an empty stream buffer blocks until bytes written in
+ * place by another task are committed, which notifies the receiver.
+ */
+void test_xStreamBufferReceiveAcquire_blocking( void )
+{
+    StreamBufferSpans_t spans;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_StubWithCallback( reserveAndCommitCallback );
+    xTaskGenericNotify_StubWithCallback( receiverTaskNotificationCallback );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferReceiveAcquire( xStreamBuffer, &spans, TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    TEST_ASSERT_EQUAL( 1, receiverTaskWoken );
+    TEST_ASSERT_EQUAL_HEX8( 0xA5, spans.pucSpan[ 0 ][ 0 ] );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that acquiring data from an empty stream buffer blocks until bytes written in
+ * place from an ISR are committed, and that a commit below the trigger level does not notify.
+ */
+void test_xStreamBufferReceiveAcquire_blocking_commit_from_isr( void )
+{
+    StreamBufferSpans_t spans;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_StubWithCallback( reserveAndCommitFromISRCallback );
+    xTaskGenericNotifyFromISR_StubWithCallback( receiverTaskNotificationFromISRCallback );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferReceiveAcquire( xStreamBuffer, &spans, TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    TEST_ASSERT_EQUAL( 1, receiverTaskWoken );
+    TEST_ASSERT_EQUAL_HEX8( 0x5A, spans.pucSpan[ 0 ][ 0 ] );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that acquiring data from a stream buffer that stays empty returns 0 once the
+ * block time expires.
+ */
+void test_xStreamBufferReceiveAcquire_blocking_timeout( void )
+{
+    StreamBufferSpans_t spans;
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_IgnoreAndReturn( pdFALSE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( 0, xStreamBufferReceiveAcquire( xStreamBuffer, &spans, TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    TEST_ASSERT_EQUAL( 0, spans.xSpanLength[ 0 ] );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that the span functions assert when passed NULL.
+ */
+void test_stream_buffer_spans_null_parameters( void )
+{
+    StreamBufferSpans_t spans;
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferSendReserve( xStreamBuffer, NULL, 0 ) );
+    validate_and_clear_assertions();
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferSendReserveFromISR( NULL, &spans ) );
+    validate_and_clear_assertions();
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferReceiveAcquire( xStreamBuffer, NULL, 0 ) );
+    validate_and_clear_assertions();
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferReceiveAcquireFromISR( NULL, &spans ) );
+    validate_and_clear_assertions();
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferSendCommit( NULL, 1 ) );
+    validate_and_clear_assertions();
+
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferReceiveReleaseFromISR( NULL, 1, NULL ) );
+    validate_and_clear_assertions();
+
+    vStreamBufferDelete( xStreamBuffer );
+}
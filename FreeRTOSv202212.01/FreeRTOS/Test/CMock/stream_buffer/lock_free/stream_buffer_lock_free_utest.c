@@ -0,0 +1,652 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file stream_buffer_lock_free_utest.c */
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Stream Buffer includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "stream_buffer.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "unity_memory.h"
+#include "CException.h"
+
+/* Mock includes. */
+#include "mock_task.h"
+#include "mock_fake_assert.h"
+#include "mock_fake_port.h"
+
+/**
+ * @brief Sample size in bytes of the stream buffer used for test.
+ * The size is kept short enough so that the buffer can be allocated on stack.
+ */
+#define TEST_STREAM_BUFFER_SIZE             ( 64U )
+
+/**
+ * @brief Sample trigger level in bytes used for stream buffer tests.
+ */
+#define TEST_STREAM_BUFFER_TRIGGER_LEVEL    ( 32U )
+
+/**
+ * @brief Wait ticks passed into from tests if the stream buffer is full while sending or
+ * empty while receiving.
+ */
+#define TEST_STREAM_BUFFER_WAIT_TICKS       ( 1000U )
+
+/**
+ * @brief CException code for when a configASSERT should be intercepted.
+ */
+#define configASSERT_E                      0xAA101
+
+/**
+ * @brief Expect a configASSERT from the function called.
+ *  Break out of the called function when this occurs.
+ * @details Use this macro when the call passed in as a parameter is expected
+ * to cause invalid memory access.
+ */
+#define EXPECT_ASSERT_BREAK( call )                  \
+    do                                               \
+    {                                                \
+        shouldAbortOnAssertion = true;               \
+        CEXCEPTION_T e = CEXCEPTION_NONE;            \
+        Try                                          \
+        {                                            \
+            call;                                    \
+            TEST_FAIL_MESSAGE( "Expected Assert!" ); \
+        }                                            \
+        Catch( e )                                   \
+        {                                            \
+            TEST_ASSERT_EQUAL( configASSERT_E, e );  \
+        }                                            \
+    } while( 0 )
+
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/**
+ * @brief Global counter for the number of assertions in code.
+ */
+static int assertionFailed = 0;
+
+/**
+ * @brief Global counter to keep track of how many times a sender task was woken up by a task receiving from the stream buffer.
+ */
+static int senderTaskWoken = 0;
+
+/**
+ * @brief Global counter to keep track of how many times a receiver task was woken up by a task sending to the buffer.
+ */
+static int receiverTaskWoken = 0;
+
+/**
+ * @brief Dummy sender task handle to which the stream buffer receive APIs will send notification.
+ */
+static TaskHandle_t senderTask = ( TaskHandle_t ) ( 0xAABBCCDD );
+
+/**
+ * @brief Dummy receiver task handle to which the stream buffer send APIs will send notifications.
+ */
+static TaskHandle_t receiverTask = ( TaskHandle_t ) ( 0xABCDEEFF );
+
+/**
+ * @brief Global Stream buffer handle used for tests.
+ */
+static StreamBufferHandle_t xStreamBuffer;
+
+/**
+ * @brief Flag which denotes if test need to abort on assertion.
+ */
+static BaseType_t shouldAbortOnAssertion;
+
+/* ==========================  CALLBACK FUNCTIONS =========================== */
+
+void * pvPortMalloc( size_t xSize )
+{
+    return unity_malloc( xSize );
+}
+void vPortFree( void * pv )
+{
+    return unity_free( pv );
+}
+
+static void vFakeAssertStub( bool x,
+                             char * file,
+                             int line,
+                             int cmock_num_calls )
+{
+    if( !x )
+    {
+        assertionFailed++;
+
+        if( shouldAbortOnAssertion == pdTRUE )
+        {
+            Throw( configASSERT_E );
+        }
+    }
+}
+
+
+static BaseType_t sendCallback( UBaseType_t uxIndexToWaitOn,
+                                uint32_t ulBitsToClearOnEntry,
+                                uint32_t ulBitsToClearOnExit,
+                                uint32_t * pulNotificationValue,
+                                TickType_t xTicksToWait,
+                                int cmock_num_calls )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_TRIGGER_LEVEL ] = { 0xA5 };
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+    return pdTRUE;
+}
+
+static BaseType_t sendFromISRCallback( UBaseType_t uxIndexToWaitOn,
+                                       uint32_t ulBitsToClearOnEntry,
+                                       uint32_t ulBitsToClearOnExit,
+                                       uint32_t * pulNotificationValue,
+                                       TickType_t xTicksToWait,
+                                       int cmock_num_calls )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_TRIGGER_LEVEL ] = { 0x5A };
+    BaseType_t receiverTaskWokenFromISR = pdFALSE;
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferSendFromISR( xStreamBuffer, data, sizeof( data ), &receiverTaskWokenFromISR ) );
+    TEST_ASSERT_EQUAL( pdTRUE, receiverTaskWokenFromISR );
+    return pdTRUE;
+}
+
+static BaseType_t receiveCallback( UBaseType_t uxIndexToWaitOn,
+                                   uint32_t ulBitsToClearOnEntry,
+                                   uint32_t ulBitsToClearOnExit,
+                                   uint32_t * pulNotificationValue,
+                                   TickType_t xTicksToWait,
+                                   int cmock_num_calls )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), 0 ) );
+    return pdTRUE;
+}
+
+static BaseType_t receiveFromISRCallback( UBaseType_t uxIndexToWaitOn,
+                                          uint32_t ulBitsToClearOnEntry,
+                                          uint32_t ulBitsToClearOnExit,
+                                          uint32_t * pulNotificationValue,
+                                          TickType_t xTicksToWait,
+                                          int cmock_num_calls )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+    BaseType_t senderTaskWokenFromISR = pdFALSE;
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceiveFromISR( xStreamBuffer, data, sizeof( data ), &senderTaskWokenFromISR ) );
+    TEST_ASSERT_EQUAL( pdTRUE, senderTaskWokenFromISR );
+    return pdTRUE;
+}
+
+static BaseType_t sendCompletedFromISRCallback( UBaseType_t uxIndexToWaitOn,
+                                                uint32_t ulBitsToClearOnEntry,
+                                                uint32_t ulBitsToClearOnExit,
+                                                uint32_t * pulNotificationValue,
+                                                TickType_t xTicksToWait,
+                                                int cmock_num_calls )
+{
+    BaseType_t receiverTaskWokenFromISR = pdFALSE;
+
+    /* Only the first call finds, and notifies, the waiting receiver. */
+    TEST_ASSERT_EQUAL( pdTRUE, xStreamBufferSendCompletedFromISR( xStreamBuffer, &receiverTaskWokenFromISR ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xStreamBufferSendCompletedFromISR( xStreamBuffer, &receiverTaskWokenFromISR ) );
+    TEST_ASSERT_EQUAL( pdTRUE, receiverTaskWokenFromISR );
+    return pdTRUE;
+}
+
+static BaseType_t secondReceiverCallback( UBaseType_t uxIndexToWaitOn,
+                                          uint32_t ulBitsToClearOnEntry,
+                                          uint32_t ulBitsToClearOnExit,
+                                          uint32_t * pulNotificationValue,
+                                          TickType_t xTicksToWait,
+                                          int cmock_num_calls )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+
+    /* A stream buffer has a single reader, so a second one can't register. */
+    EXPECT_ASSERT_BREAK( ( void ) xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    return pdFALSE;
+}
+
+static BaseType_t sendBeforeRegisteringCallback( TaskHandle_t xTask,
+                                                 UBaseType_t uxIndexToClear,
+                                                 int cmock_num_calls )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_TRIGGER_LEVEL ] = { 0 };
+
+    /* The receiver has found the buffer empty but has not yet registered
+     * itself as waiting, so the send does not notify it. */
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+    return pdTRUE;
+}
+
+static BaseType_t receiveBeforeRegisteringCallback( TaskHandle_t xTask,
+                                                    UBaseType_t uxIndexToClear,
+                                                    int cmock_num_calls )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+
+    /* The sender has found the buffer full but has not yet registered itself
+     * as waiting, so the receive does not notify it. */
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), 0 ) );
+    return pdTRUE;
+}
+
+static BaseType_t senderTaskNotificationCallback( TaskHandle_t xTaskToNotify,
+                                                  UBaseType_t uxIndexToNotify,
+                                                  uint32_t ulValue,
+                                                  eNotifyAction eAction,
+                                                  uint32_t * pulPreviousNotificationValue,
+                                                  int cmock_num_calls )
+{
+    TEST_ASSERT_EQUAL( senderTask, xTaskToNotify );
+    senderTaskWoken++;
+    return pdTRUE;
+}
+
+static BaseType_t senderTaskNotificationFromISRCallback( TaskHandle_t xTaskToNotify,
+                                                         UBaseType_t uxIndexToNotify,
+                                                         uint32_t ulValue,
+                                                         eNotifyAction eAction,
+                                                         uint32_t * pulPreviousNotificationValue,
+                                                         BaseType_t * pxHigherPriorityTaskWoken,
+                                                         int cmock_num_calls )
+{
+    TEST_ASSERT_EQUAL( senderTask, xTaskToNotify );
+    senderTaskWoken++;
+    *pxHigherPriorityTaskWoken = pdTRUE;
+
+    return pdTRUE;
+}
+
+static BaseType_t receiverTaskNotificationCallback( TaskHandle_t xTaskToNotify,
+                                                    UBaseType_t uxIndexToNotify,
+                                                    uint32_t ulValue,
+                                                    eNotifyAction eAction,
+                                                    uint32_t * pulPreviousNotificationValue,
+                                                    int cmock_num_calls )
+{
+    TEST_ASSERT_EQUAL( receiverTask, xTaskToNotify );
+    receiverTaskWoken++;
+    return pdTRUE;
+}
+
+static BaseType_t receiverTaskNotificationFromISRCallback( TaskHandle_t xTaskToNotify,
+                                                           UBaseType_t uxIndexToNotify,
+                                                           uint32_t ulValue,
+                                                           eNotifyAction eAction,
+                                                           uint32_t * pulPreviousNotificationValue,
+                                                           BaseType_t * pxHigherPriorityTaskWoken,
+                                                           int cmock_num_calls )
+{
+    TEST_ASSERT_EQUAL( receiverTask, xTaskToNotify );
+    receiverTaskWoken++;
+    *pxHigherPriorityTaskWoken = pdTRUE;
+
+    return pdTRUE;
+}
+
+/*******************************************************************************
+ * Unity fixtures
+ ******************************************************************************/
+void setUp( void )
+{
+    assertionFailed = 0;
+    xStreamBuffer = NULL;
+    senderTaskWoken = 0;
+    receiverTaskWoken = 0;
+    shouldAbortOnAssertion = pdTRUE;
+
+    mock_task_Init();
+    mock_fake_assert_Init();
+    mock_fake_port_Init();
+
+    /* No expectations are set for critical sections, interrupt masking or
+     * scheduler suspension, so the tests fail if the lock free paths use them. */
+    vFakeAssert_StubWithCallback( vFakeAssertStub );
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+}
+
+/*! called before each test case */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL_MESSAGE( 0, assertionFailed, "Assertion check failed in code." );
+    UnityMalloc_EndTest();
+    mock_task_Verify();
+    mock_task_Destroy();
+    mock_fake_assert_Verify();
+    mock_fake_assert_Destroy();
+    mock_fake_port_Verify();
+    mock_fake_port_Destroy();
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+static void validate_and_clear_assertions( void )
+{
+    TEST_ASSERT_EQUAL( 1, assertionFailed );
+    assertionFailed = 0;
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief Validates that data is sent and received, from tasks and ISRs, without entering a
+ * critical section or suspending the scheduler.
+ */
+void test_xStreamBufferSend_receive_lock_free( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+    uint8_t received[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    for( size_t i = 0; i < TEST_STREAM_BUFFER_SIZE; i++ )
+    {
+        data[ i ] = ( uint8_t ) i;
+    }
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferSend( xStreamBuffer, data, TEST_STREAM_BUFFER_TRIGGER_LEVEL, 0 ) );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferSendFromISR( xStreamBuffer, &data[ TEST_STREAM_BUFFER_TRIGGER_LEVEL ], TEST_STREAM_BUFFER_TRIGGER_LEVEL, &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xStreamBufferIsFull( xStreamBuffer ) );
+
+    TEST_ASSERT_EQUAL( 16, xStreamBufferReceive( xStreamBuffer, received, 16, 0 ) );
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE - 16, xStreamBufferReceiveFromISR( xStreamBuffer, &received[ 16 ], TEST_STREAM_BUFFER_SIZE, &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL_MEMORY( data, received, TEST_STREAM_BUFFER_SIZE );
+    TEST_ASSERT_EQUAL( pdFALSE, xHigherPriorityTaskWoken );
+
+    /* Nobody is waiting, so there is nobody to notify. */
+    TEST_ASSERT_EQUAL( pdFALSE, xStreamBufferSendCompletedFromISR( xStreamBuffer, &xHigherPriorityTaskWoken ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xStreamBufferReceiveCompletedFromISR( xStreamBuffer, &xHigherPriorityTaskWoken ) );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that a receiver blocked on an empty stream buffer is notified once by a task
+ * sending up to the trigger level.
+ */
+void test_xStreamBufferReceive_blocking( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_StubWithCallback( sendCallback );
+    xTaskGenericNotify_StubWithCallback( receiverTaskNotificationCallback );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    TEST_ASSERT_EQUAL( 1, receiverTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that a receiver blocked on an empty stream buffer is notified by an ISR
+ * sending up to the trigger level.
+ */
+void test_xStreamBufferReceive_blocking_send_from_isr( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_StubWithCallback( sendFromISRCallback );
+    xTaskGenericNotifyFromISR_StubWithCallback( receiverTaskNotificationFromISRCallback );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    TEST_ASSERT_EQUAL( 1, receiverTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that the waiting receiver is taken by exactly one call to
+ * xStreamBufferSendCompletedFromISR().
+ */
+void test_xStreamBufferSendCompletedFromISR_notifies_once( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_StubWithCallback( sendCompletedFromISRCallback );
+    xTaskGenericNotifyFromISR_StubWithCallback( receiverTaskNotificationFromISRCallback );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    /* Woken without any data being sent. */
+    TEST_ASSERT_EQUAL( 0, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    TEST_ASSERT_EQUAL( 1, receiverTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that a receiver that finds data sent after it first checked, but before it
+ * registered as waiting, does not block and stays unregistered.
+ */
+void test_xStreamBufferReceive_data_sent_while_registering( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_StubWithCallback( sendBeforeRegisteringCallback );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    /* xTaskNotifyWait() is not expected, so the receiver must not block. */
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+
+    /* xTaskNotify() is not expected either, as the receiver deregistered itself. */
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferSend( xStreamBuffer, data, TEST_STREAM_BUFFER_TRIGGER_LEVEL, 0 ) );
+    TEST_ASSERT_EQUAL( 0, receiverTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that a receiver that times out is no longer notified by later sends.
+ */
+void test_xStreamBufferReceive_blocking_timeout( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_IgnoreAndReturn( pdFALSE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( 0, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_TRIGGER_LEVEL, xStreamBufferSend( xStreamBuffer, data, TEST_STREAM_BUFFER_TRIGGER_LEVEL, 0 ) );
+    TEST_ASSERT_EQUAL( 0, receiverTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that a second task can't wait to receive while a receiver is already waiting.
+ */
+void test_xStreamBufferReceive_second_reader( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ];
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( receiverTask );
+    xTaskGenericNotifyWait_StubWithCallback( secondReceiverCallback );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( 0, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    validate_and_clear_assertions();
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that a sender blocked on a full stream buffer is notified once by a task
+ * receiving from it.
+ */
+void test_xStreamBufferSend_blocking( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+    xTaskGenericNotifyWait_StubWithCallback( receiveCallback );
+    xTaskGenericNotify_StubWithCallback( senderTaskNotificationCallback );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdFALSE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    TEST_ASSERT_EQUAL( 1, senderTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that a sender blocked on a full stream buffer is notified by an ISR
+ * receiving from it.
+ */
+void test_xStreamBufferSend_blocking_receive_from_isr( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+    xTaskGenericNotifyWait_StubWithCallback( receiveFromISRCallback );
+    xTaskGenericNotifyFromISR_StubWithCallback( senderTaskNotificationFromISRCallback );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdFALSE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+    TEST_ASSERT_EQUAL( 1, senderTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that a sender that finds space freed after it first checked, but before it
+ * registered as waiting, does not block and stays unregistered.
+ */
+void test_xStreamBufferSend_space_freed_while_registering( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_StubWithCallback( receiveBeforeRegisteringCallback );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+
+    /* xTaskNotifyWait() is not expected, so the sender must not block. */
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+
+    /* xTaskNotify() is not expected either, as the sender deregistered itself. */
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), 0 ) );
+    TEST_ASSERT_EQUAL( 0, senderTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+
+/**
+ * @brief Validates that a sender that times out is no longer notified by later receives.
+ */
+void test_xStreamBufferSend_blocking_timeout( void )
+{
+    uint8_t data[ TEST_STREAM_BUFFER_SIZE ] = { 0 };
+
+    vTaskSetTimeOutState_Ignore();
+    xTaskGenericNotifyStateClear_IgnoreAndReturn( pdTRUE );
+    xTaskGetCurrentTaskHandle_IgnoreAndReturn( senderTask );
+    xTaskGenericNotifyWait_IgnoreAndReturn( pdFALSE );
+    xTaskCheckForTimeOut_IgnoreAndReturn( pdTRUE );
+
+    xStreamBuffer = xStreamBufferCreate( TEST_STREAM_BUFFER_SIZE, TEST_STREAM_BUFFER_TRIGGER_LEVEL );
+    TEST_ASSERT_NOT_NULL( xStreamBuffer );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), 0 ) );
+
+    TEST_ASSERT_EQUAL( 0, xStreamBufferSend( xStreamBuffer, data, sizeof( data ), TEST_STREAM_BUFFER_WAIT_TICKS ) );
+
+    TEST_ASSERT_EQUAL( TEST_STREAM_BUFFER_SIZE, xStreamBufferReceive( xStreamBuffer, data, sizeof( data ), 0 ) );
+    TEST_ASSERT_EQUAL( 0, senderTaskWoken );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
@@ -107,6 +107,11 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+        List_t xMutexesHeld;
+        TaskHandle_t * pxBlockedOnMutexHolder;
+    #endif
 } tskTCB;
 
 
@@ -46,7 +46,7 @@ BaseType_t listIS_CONTAINED_WITHIN( List_t * list,
                                     const ListItem_t * listItem );
 
 #undef listGET_LIST_ITEM_VALUE
-TickType_t listGET_LIST_ITEM_VALUE( ListItem_t * listItem );
+TickType_t listGET_LIST_ITEM_VALUE( const ListItem_t * listItem );
 
 #undef listSET_LIST_ITEM_VALUE
 void listSET_LIST_ITEM_VALUE( ListItem_t * listItem,
@@ -63,7 +63,7 @@ UBaseType_t listCURRENT_LIST_LENGTH( List_t * list );
 TickType_t listGET_ITEM_VALUE_OF_HEAD_ENTRY( List_t * list );
 
 #undef listGET_LIST_ITEM_OWNER
-TCB_t * listGET_LIST_ITEM_OWNER( ListItem_t * listItem );
+TCB_t * listGET_LIST_ITEM_OWNER( const ListItem_t * listItem );
 
 #undef listINSERT_END
 void listINSERT_END( List_t * pxList,
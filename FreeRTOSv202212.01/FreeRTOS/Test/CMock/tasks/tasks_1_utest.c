@@ -2329,6 +2329,7 @@ void test_xtaskGetHandle_success( void )
     /*  prvSearchForNameWithinSingleList */
     listCURRENT_LIST_LENGTH_ExpectAndReturn( &pxReadyTasksLists[ configMAX_PRIORITIES - 1 ],
                                              1 );
+    listGET_LIST_ITEM_OWNER_ExpectAndReturn( &list_item, ptcb );
     /* vTaskResumeAll */
     listLIST_IS_EMPTY_ExpectAndReturn( &xPendingReadyList, pdTRUE );
 
@@ -2346,6 +2347,7 @@ void test_xtaskGetHandle_success_2elements( void )
     task_handle = create_task();
     task_handle2 = create_task();
     ptcb = task_handle;
+    strcpy( ptcb->pcTaskName, "other_task" );
     INITIALIZE_LIST_2E( pxReadyTasksLists[ configMAX_PRIORITIES - 1 ],
                         list_item, list_item2,
                         ptcb, task_handle2 );
@@ -2353,6 +2355,8 @@ void test_xtaskGetHandle_success_2elements( void )
     /*  prvSearchForNameWithinSingleList */
     listCURRENT_LIST_LENGTH_ExpectAndReturn( &pxReadyTasksLists[ configMAX_PRIORITIES - 1 ],
                                              1 );
+    listGET_LIST_ITEM_OWNER_ExpectAndReturn( &list_item, ptcb );
+    listGET_LIST_ITEM_OWNER_ExpectAndReturn( &list_item2, task_handle2 );
     /* vTaskResumeAll */
     listLIST_IS_EMPTY_ExpectAndReturn( &xPendingReadyList, pdTRUE );
 
@@ -2370,6 +2374,7 @@ void test_xtaskGetHandle_success_2elements_set_index( void )
     task_handle = create_task();
     task_handle2 = create_task();
     ptcb = task_handle;
+    strcpy( ptcb->pcTaskName, "other_task" );
     INITIALIZE_LIST_2E( pxReadyTasksLists[ configMAX_PRIORITIES - 1 ],
                         list_item, list_item2,
                         task_handle, task_handle2 );
@@ -2383,6 +2388,9 @@ void test_xtaskGetHandle_success_2elements_set_index( void )
     /*  prvSearchForNameWithinSingleList */
     listCURRENT_LIST_LENGTH_ExpectAndReturn( &pxReadyTasksLists[ configMAX_PRIORITIES - 1 ],
                                              1 );
+    /* the search starts from the head of the list, not from the index */
+    listGET_LIST_ITEM_OWNER_ExpectAndReturn( &list_item, task_handle );
+    listGET_LIST_ITEM_OWNER_ExpectAndReturn( &list_item2, task_handle2 );
     /* vTaskResumeAll */
     listLIST_IS_EMPTY_ExpectAndReturn( &xPendingReadyList, pdTRUE );
 
@@ -2390,6 +2398,9 @@ void test_xtaskGetHandle_success_2elements_set_index( void )
     ret_task_handle = xTaskGetHandle( "create_task" );
     /* Validations */
     TEST_ASSERT_EQUAL_PTR( task_handle2, ret_task_handle );
+    /* the search leaves the index where the scheduler put it */
+    TEST_ASSERT_EQUAL_PTR( &list_item2,
+                           pxReadyTasksLists[ configMAX_PRIORITIES - 1 ].pxIndex );
 }
 
 void test_xtaskGetHandle_fail_no_task_found( void )
@@ -2408,6 +2419,8 @@ void test_xtaskGetHandle_fail_no_task_found( void )
     listCURRENT_LIST_LENGTH_ExpectAndReturn(
         &pxReadyTasksLists[ configMAX_PRIORITIES - 1 ],
         2 );
+    listGET_LIST_ITEM_OWNER_ExpectAndReturn( &list_item, ptcb );
+    listGET_LIST_ITEM_OWNER_ExpectAndReturn( &list_item2, task_handle2 );
     int i = configMAX_PRIORITIES - 1;
 
     do
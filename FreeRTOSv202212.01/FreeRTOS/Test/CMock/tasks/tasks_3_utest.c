@@ -0,0 +1,973 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file tasks_3_utest.c */
+
+/* Tasks includes */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "task.h"
+
+#include "mock_list.h"
+#include "mock_list_macros.h"
+#include "mock_timers.h"
+#include "mock_portable.h"
+
+/* Test includes. */
+#include "unity.h"
+#include "global_vars.h"
+
+/* C runtime includes. */
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+extern TCB_t * volatile pxCurrentTCB;
+extern List_t pxReadyTasksLists[ configMAX_PRIORITIES ];
+extern List_t xDelayedTaskList1;
+extern List_t xDelayedTaskList2;
+extern List_t * volatile pxDelayedTaskList;
+extern List_t * volatile pxOverflowDelayedTaskList;
+extern List_t xPendingReadyList;
+/* INCLUDE_vTaskDelete */
+extern List_t xTasksWaitingTermination;
+extern volatile UBaseType_t uxDeletedTasksWaitingCleanUp;
+extern List_t xSuspendedTaskList;
+
+extern volatile UBaseType_t uxCurrentNumberOfTasks;
+extern volatile TickType_t xTickCount;
+extern volatile UBaseType_t uxTopReadyPriority;
+extern volatile BaseType_t xSchedulerRunning;
+extern volatile TickType_t xPendedTicks;
+extern volatile BaseType_t xYieldPending;
+extern volatile BaseType_t xNumOfOverflows;
+extern UBaseType_t uxTaskNumber;
+extern volatile TickType_t xNextTaskUnblockTime;
+extern TaskHandle_t xIdleTaskHandle;
+extern volatile UBaseType_t uxSchedulerSuspended;
+
+
+/* ===========================  DEFINES CONSTANTS  ========================== */
+
+/* As tasks.c for the 32-bit ticks used by this configuration. */
+#define taskEVENT_LIST_ITEM_VALUE_IN_USE    0x80000000UL
+
+/* Stands in for the members of a queue.c mutex used by the task functions
+ * that implement priority inheritance chains. */
+typedef struct
+{
+    List_t xTasksWaitingToReceive;
+    ListItem_t xMutexHeldListItem;
+    TaskHandle_t xMutexHolder;
+} Mutex_t;
+
+/* ===========================  GLOBAL VARIABLES  =========================== */
+static StaticTask_t xIdleTaskTCB;
+static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+static bool getIddleTaskMemoryValid = false;
+static uint32_t critical_section_counter = 0;
+static port_yield_operation py_operation;
+static bool vTaskDeletePre_called = false;
+static bool getIddleTaskMemory_called = false;
+static bool vApplicationTickHook_called = false;
+static bool port_yield_called = false;
+static bool port_enable_interrupts_called = false;
+static bool port_disable_interrupts_called = false;
+static bool port_yield_within_api_called = false;
+static bool port_setup_tcb_called = false;
+static bool portClear_Interrupt_called = false;
+static bool portSet_Interrupt_called = false;
+static bool portClear_Interrupt_from_isr_called = false;
+static bool portSet_Interrupt_from_isr_called = false;
+static bool port_invalid_interrupt_called = false;
+static bool vApplicationStackOverflowHook_called = false;
+static bool vApplicationIdleHook_called = false;
+static bool port_allocate_secure_context_called = false;
+static bool port_assert_if_in_isr_called = false;
+static bool vApplicationMallocFailedHook_called = false;
+
+static TCB_t xTaskL; /* Base priority 1. */
+static TCB_t xTaskM; /* Base priority 2. */
+static TCB_t xTaskX; /* Base priority 3. */
+static TCB_t xTaskH; /* Base priority 4. */
+static Mutex_t xMutexA;
+static Mutex_t xMutexB;
+static Mutex_t xMutexC;
+
+/* ============================  LIST FAKES  ================================ */
+
+/* The list functions and macros are mocked for this suite.  The fakes below
+ * give them the behaviour of list.c so the priority inheritance chains can be
+ * followed through real lists. */
+
+static void vListInitialiseCallback( List_t * const pxList,
+                                     int cmock_num_calls )
+{
+    pxList->pxIndex = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.xItemValue = portMAX_DELAY;
+    pxList->xListEnd.pxNext = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.pxPrevious = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
+}
+
+static void vListInitialiseItemCallback( ListItem_t * const pxItem,
+                                         int cmock_num_calls )
+{
+    pxItem->pxContainer = NULL;
+}
+
+static void vListInsertEndCallback( List_t * const pxList,
+                                    ListItem_t * const pxNewListItem,
+                                    int cmock_num_calls )
+{
+    ListItem_t * const pxIndex = pxList->pxIndex;
+
+    pxNewListItem->pxNext = pxIndex;
+    pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    pxIndex->pxPrevious->pxNext = pxNewListItem;
+    pxIndex->pxPrevious = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    ( pxList->uxNumberOfItems )++;
+}
+
+static void vListInsertCallback( List_t * const pxList,
+                                 ListItem_t * const pxNewListItem,
+                                 int cmock_num_calls )
+{
+    ListItem_t * pxIterator;
+    const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+
+    for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext )
+    {
+        if( pxIterator->pxNext == ( ListItem_t * ) &( pxList->xListEnd ) )
+        {
+            break;
+        }
+    }
+
+    pxNewListItem->pxNext = pxIterator->pxNext;
+    pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+    pxNewListItem->pxPrevious = pxIterator;
+    pxIterator->pxNext = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    ( pxList->uxNumberOfItems )++;
+}
+
+static UBaseType_t uxListRemoveCallback( ListItem_t * const pxItemToRemove,
+                                         int cmock_num_calls )
+{
+    List_t * const pxList = pxItemToRemove->pxContainer;
+
+    TEST_ASSERT_NOT_NULL( pxList );
+
+    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+
+    if( pxList->pxIndex == pxItemToRemove )
+    {
+        pxList->pxIndex = pxItemToRemove->pxPrevious;
+    }
+
+    pxItemToRemove->pxContainer = NULL;
+    ( pxList->uxNumberOfItems )--;
+
+    return pxList->uxNumberOfItems;
+}
+
+static void listINSERT_ENDCallback( List_t * pxList,
+                                    ListItem_t * listItem,
+                                    int cmock_num_calls )
+{
+    vListInsertEndCallback( pxList, listItem, cmock_num_calls );
+}
+
+static void listREMOVE_ITEMCallback( ListItem_t * listItem,
+                                     int cmock_num_calls )
+{
+    ( void ) uxListRemoveCallback( listItem, cmock_num_calls );
+}
+
+static BaseType_t listLIST_IS_EMPTYCallback( const List_t * pxList,
+                                             int cmock_num_calls )
+{
+    return ( pxList->uxNumberOfItems == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+}
+
+static TCB_t * listGET_OWNER_OF_HEAD_ENTRYCallback( const List_t * pxList,
+                                                    int cmock_num_calls )
+{
+    return ( TCB_t * ) pxList->xListEnd.pxNext->pvOwner;
+}
+
+static BaseType_t listIS_CONTAINED_WITHINCallback( List_t * list,
+                                                   const ListItem_t * listItem,
+                                                   int cmock_num_calls )
+{
+    return ( listItem->pxContainer == list ) ? pdTRUE : pdFALSE;
+}
+
+static TickType_t listGET_LIST_ITEM_VALUECallback( const ListItem_t * listItem,
+                                                   int cmock_num_calls )
+{
+    return listItem->xItemValue;
+}
+
+static void listSET_LIST_ITEM_VALUECallback( ListItem_t * listItem,
+                                             TickType_t itemValue,
+                                             int cmock_num_calls )
+{
+    listItem->xItemValue = itemValue;
+}
+
+static List_t * listLIST_ITEM_CONTAINERCallback( const ListItem_t * listItem,
+                                                 int cmock_num_calls )
+{
+    return listItem->pxContainer;
+}
+
+static UBaseType_t listCURRENT_LIST_LENGTHCallback( List_t * list,
+                                                    int cmock_num_calls )
+{
+    return list->uxNumberOfItems;
+}
+
+static TickType_t listGET_ITEM_VALUE_OF_HEAD_ENTRYCallback( List_t * list,
+                                                            int cmock_num_calls )
+{
+    return list->xListEnd.pxNext->xItemValue;
+}
+
+static TCB_t * listGET_LIST_ITEM_OWNERCallback( const ListItem_t * listItem,
+                                                int cmock_num_calls )
+{
+    return ( TCB_t * ) listItem->pvOwner;
+}
+
+/* ===========================  Static Functions  =========================== */
+
+static void init_mutex( Mutex_t * pxMutex )
+{
+    vListInitialiseCallback( &( pxMutex->xTasksWaitingToReceive ), 0 );
+    vListInitialiseItemCallback( &( pxMutex->xMutexHeldListItem ), 0 );
+    listSET_LIST_ITEM_OWNER( &( pxMutex->xMutexHeldListItem ), &( pxMutex->xTasksWaitingToReceive ) );
+    pxMutex->xMutexHeldListItem.xItemValue = tskIDLE_PRIORITY;
+    pxMutex->xMutexHolder = NULL;
+}
+
+static void make_ready( TCB_t * pxTCB )
+{
+    vListInsertEndCallback( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ), 0 );
+    portRECORD_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+}
+
+static void init_task( TCB_t * pxTCB,
+                       UBaseType_t uxPriority )
+{
+    memset( pxTCB, 0x00, sizeof( TCB_t ) );
+    vListInitialiseItemCallback( &( pxTCB->xStateListItem ), 0 );
+    vListInitialiseItemCallback( &( pxTCB->xEventListItem ), 0 );
+    listSET_LIST_ITEM_OWNER( &( pxTCB->xStateListItem ), pxTCB );
+    listSET_LIST_ITEM_OWNER( &( pxTCB->xEventListItem ), pxTCB );
+    pxTCB->xEventListItem.xItemValue = configMAX_PRIORITIES - uxPriority;
+    pxTCB->uxPriority = uxPriority;
+    pxTCB->uxBasePriority = uxPriority;
+    vListInitialiseCallback( &( pxTCB->xMutexesHeld ), 0 );
+    pxTCB->pxBlockedOnMutexHolder = NULL;
+    make_ready( pxTCB );
+}
+
+/* As xQueueSemaphoreTake() when the mutex is available. */
+static void take_mutex( TCB_t * pxTCB,
+                        Mutex_t * pxMutex )
+{
+    pxCurrentTCB = pxTCB;
+    pxMutex->xMutexHolder = pvTaskAddHeldMutex( &( pxMutex->xMutexHeldListItem ) );
+    TEST_ASSERT_EQUAL_PTR( pxTCB, pxMutex->xMutexHolder );
+}
+
+/* As xQueueSemaphoreTake() when a mutex with a ceiling is available. */
+static void take_ceiling_mutex( TCB_t * pxTCB,
+                                Mutex_t * pxMutex,
+                                UBaseType_t uxCeilingPriority )
+{
+    pxMutex->xMutexHeldListItem.xItemValue = uxCeilingPriority;
+    take_mutex( pxTCB, pxMutex );
+    vTaskPriorityRaiseToCeiling( uxCeilingPriority );
+}
+
+/* As xQueueSemaphoreTake() when the mutex is held, leaving the task in the
+ * list of tasks waiting for the mutex. */
+static BaseType_t block_on_mutex( TCB_t * pxTCB,
+                                  Mutex_t * pxMutex )
+{
+    BaseType_t xInheritanceOccurred;
+
+    pxCurrentTCB = pxTCB;
+    xInheritanceOccurred = xTaskPriorityInheritChain( &( pxMutex->xMutexHolder ) );
+
+    if( uxListRemoveCallback( &( pxTCB->xStateListItem ), 0 ) == 0 )
+    {
+        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+    }
+
+    vListInsertCallback( &( pxMutex->xTasksWaitingToReceive ), &( pxTCB->xEventListItem ), 0 );
+
+    return xInheritanceOccurred;
+}
+
+/* As xQueueGenericSend() when the holder gives the mutex back. */
+static BaseType_t give_mutex( TCB_t * pxTCB,
+                              Mutex_t * pxMutex )
+{
+    BaseType_t xReturn;
+
+    pxCurrentTCB = pxTCB;
+    xReturn = xTaskRemoveHeldMutex( &( pxMutex->xMutexHeldListItem ) );
+    pxMutex->xMutexHolder = NULL;
+
+    return xReturn;
+}
+
+/* As xQueueSemaphoreTake() when a task waiting for the mutex times out. */
+static void time_out_on_mutex( TCB_t * pxTCB,
+                               Mutex_t * pxMutex )
+{
+    TimeOut_t xTimeOut;
+    TickType_t xTicksToWait = 5;
+
+    ( void ) uxListRemoveCallback( &( pxTCB->xEventListItem ), 0 );
+    make_ready( pxTCB );
+    pxCurrentTCB = pxTCB;
+
+    xTimeOut.xOverflowCount = xNumOfOverflows;
+    xTimeOut.xTimeOnEntering = xTickCount - xTicksToWait;
+    TEST_ASSERT_EQUAL( pdTRUE, xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) );
+
+    vTaskPriorityDisinheritChainAfterTimeout( pxMutex->xMutexHolder );
+}
+
+/* Checks the priority of a task and that it is in the lists for that
+ * priority. */
+static void assert_priority( TCB_t * pxTCB,
+                             UBaseType_t uxPriority )
+{
+    TEST_ASSERT_EQUAL( uxPriority, pxTCB->uxPriority );
+    TEST_ASSERT_EQUAL( configMAX_PRIORITIES - uxPriority, pxTCB->xEventListItem.xItemValue );
+
+    if( pxTCB->xStateListItem.pxContainer != NULL )
+    {
+        TEST_ASSERT_EQUAL_PTR( &( pxReadyTasksLists[ uxPriority ] ), pxTCB->xStateListItem.pxContainer );
+    }
+}
+
+static TCB_t * head_waiter( Mutex_t * pxMutex )
+{
+    return listGET_OWNER_OF_HEAD_ENTRYCallback( &( pxMutex->xTasksWaitingToReceive ), 0 );
+}
+
+/* ============================  HOOK FUNCTIONS  ============================ */
+static void dummy_operation()
+{
+    HOOK_DIAG();
+}
+
+void vFakePortAssertIfISR( void )
+{
+    port_assert_if_in_isr_called = true;
+    HOOK_DIAG();
+}
+
+void port_allocate_secure_context( BaseType_t stackSize )
+{
+    HOOK_DIAG();
+    port_allocate_secure_context_called = true;
+}
+
+void vApplicationIdleHook( void )
+{
+    HOOK_DIAG();
+    vApplicationIdleHook_called = true;
+}
+
+void vApplicationMallocFailedHook( void )
+{
+    vApplicationMallocFailedHook_called = true;
+    HOOK_DIAG();
+}
+
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    uint32_t * pulIdleTaskStackSize )
+{
+    HOOK_DIAG();
+
+    if( getIddleTaskMemoryValid == true )
+    {
+        /* Pass out a pointer to the StaticTask_t structure in which the Idle task's
+         * state will be stored. */
+        *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+
+        /* Pass out the array that will be used as the Idle task's stack. */
+        *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+
+        /* Pass out the size of the array pointed to by *ppxIdleTaskStackBuffer.
+         * Note that, as the array is necessarily of type StackType_t,
+         * configMINIMAL_STACK_SIZE is specified in words, not bytes. */
+        *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+    }
+    else
+    {
+        *ppxIdleTaskTCBBuffer = NULL;
+        *ppxIdleTaskStackBuffer = NULL;
+        *pulIdleTaskStackSize = 0;
+    }
+
+    getIddleTaskMemory_called = true;
+}
+
+void vConfigureTimerForRunTimeStats( void )
+{
+    HOOK_DIAG();
+}
+
+long unsigned int ulGetRunTimeCounterValue( void )
+{
+    HOOK_DIAG();
+    return 3;
+}
+
+void vApplicationTickHook()
+{
+    HOOK_DIAG();
+    vApplicationTickHook_called = true;
+}
+
+void vPortCurrentTaskDying( void * pvTaskToDelete,
+                            volatile BaseType_t * pxPendYield )
+{
+    HOOK_DIAG();
+    vTaskDeletePre_called = true;
+}
+
+void vFakePortEnterCriticalSection( void )
+{
+    HOOK_DIAG();
+    critical_section_counter++;
+}
+
+void vFakePortExitCriticalSection( void )
+{
+    HOOK_DIAG();
+    critical_section_counter--;
+}
+
+void vFakePortYieldWithinAPI()
+{
+    HOOK_DIAG();
+    port_yield_within_api_called = true;
+    py_operation();
+}
+
+void vFakePortYieldFromISR()
+{
+    HOOK_DIAG();
+}
+
+void vFakePortDisableInterrupts()
+{
+    port_disable_interrupts_called = true;
+    HOOK_DIAG();
+}
+
+void vFakePortEnableInterrupts()
+{
+    port_enable_interrupts_called = true;
+    HOOK_DIAG();
+}
+
+void vFakePortYield()
+{
+    HOOK_DIAG();
+    port_yield_called = true;
+    py_operation();
+}
+
+void portSetupTCB_CB( void * tcb )
+{
+    HOOK_DIAG();
+    port_setup_tcb_called = true;
+}
+
+void vFakePortClearInterruptMask( UBaseType_t bt )
+{
+    HOOK_DIAG();
+    portClear_Interrupt_called = true;
+}
+
+UBaseType_t ulFakePortSetInterruptMask( void )
+{
+    HOOK_DIAG();
+    portSet_Interrupt_called = true;
+    return 1;
+}
+
+void vFakePortClearInterruptMaskFromISR( UBaseType_t bt )
+{
+    HOOK_DIAG();
+    portClear_Interrupt_from_isr_called = true;
+}
+
+UBaseType_t ulFakePortSetInterruptMaskFromISR( void )
+{
+    HOOK_DIAG();
+    portSet_Interrupt_from_isr_called = true;
+    return 1;
+}
+
+void vFakePortAssertIfInterruptPriorityInvalid( void )
+{
+    HOOK_DIAG();
+    port_invalid_interrupt_called = true;
+}
+
+void vApplicationStackOverflowHook( TaskHandle_t xTask,
+                                    char * stack )
+{
+    HOOK_DIAG();
+    vApplicationStackOverflowHook_called = true;
+}
+
+/* ============================  Unity Fixtures  ============================ */
+/*! called before each testcase */
+void setUp( void )
+{
+    RESET_ALL_HOOKS();
+
+    vListInitialise_StubWithCallback( vListInitialiseCallback );
+    vListInitialiseItem_StubWithCallback( vListInitialiseItemCallback );
+    vListInsert_StubWithCallback( vListInsertCallback );
+    vListInsertEnd_StubWithCallback( vListInsertEndCallback );
+    uxListRemove_StubWithCallback( uxListRemoveCallback );
+    listINSERT_END_StubWithCallback( listINSERT_ENDCallback );
+    listREMOVE_ITEM_StubWithCallback( listREMOVE_ITEMCallback );
+    listLIST_IS_EMPTY_StubWithCallback( listLIST_IS_EMPTYCallback );
+    listGET_OWNER_OF_HEAD_ENTRY_StubWithCallback( listGET_OWNER_OF_HEAD_ENTRYCallback );
+    listIS_CONTAINED_WITHIN_StubWithCallback( listIS_CONTAINED_WITHINCallback );
+    listGET_LIST_ITEM_VALUE_StubWithCallback( listGET_LIST_ITEM_VALUECallback );
+    listSET_LIST_ITEM_VALUE_StubWithCallback( listSET_LIST_ITEM_VALUECallback );
+    listLIST_ITEM_CONTAINER_StubWithCallback( listLIST_ITEM_CONTAINERCallback );
+    listCURRENT_LIST_LENGTH_StubWithCallback( listCURRENT_LIST_LENGTHCallback );
+    listGET_ITEM_VALUE_OF_HEAD_ENTRY_StubWithCallback( listGET_ITEM_VALUE_OF_HEAD_ENTRYCallback );
+    listGET_LIST_ITEM_OWNER_StubWithCallback( listGET_LIST_ITEM_OWNERCallback );
+
+    for( UBaseType_t uxPriority = 0; uxPriority < configMAX_PRIORITIES; uxPriority++ )
+    {
+        vListInitialiseCallback( &( pxReadyTasksLists[ uxPriority ] ), 0 );
+    }
+
+    uxTopReadyPriority = tskIDLE_PRIORITY;
+    xTickCount = ( TickType_t ) 500;
+    xNumOfOverflows = ( BaseType_t ) 0;
+    xSchedulerRunning = pdTRUE;
+    uxSchedulerSuspended = ( UBaseType_t ) 0;
+    xYieldPending = pdFALSE;
+    py_operation = dummy_operation;
+
+    init_task( &xTaskL, 1 );
+    init_task( &xTaskM, 2 );
+    init_task( &xTaskX, 3 );
+    init_task( &xTaskH, 4 );
+    init_mutex( &xMutexA );
+    init_mutex( &xMutexB );
+    init_mutex( &xMutexC );
+    pxCurrentTCB = &xTaskH;
+}
+
+/*! called after each testcase */
+void tearDown( void )
+{
+    TEST_ASSERT_EQUAL( 0, critical_section_counter );
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/*!
+ * @brief taking a mutex adds it to the mutexes held by the calling task
+ * @coverage pvTaskAddHeldMutex
+ */
+void test_pvTaskAddHeldMutex_AddsToHeldList( void )
+{
+    xTaskL.pxBlockedOnMutexHolder = &( xMutexB.xMutexHolder );
+
+    take_mutex( &xTaskL, &xMutexA );
+    take_mutex( &xTaskL, &xMutexC );
+
+    TEST_ASSERT_EQUAL( 2, xTaskL.uxMutexesHeld );
+    TEST_ASSERT_EQUAL( 2, listCURRENT_LIST_LENGTHCallback( &( xTaskL.xMutexesHeld ), 0 ) );
+    TEST_ASSERT_EQUAL_PTR( &( xTaskL.xMutexesHeld ), xMutexA.xMutexHeldListItem.pxContainer );
+
+    /* A task that obtains a mutex no longer waits for one. */
+    TEST_ASSERT_NULL( xTaskL.pxBlockedOnMutexHolder );
+}
+
+/*!
+ * @brief a mutex taken before the scheduler has any tasks is not held by a
+ * task
+ * @coverage pvTaskAddHeldMutex
+ */
+void test_pvTaskAddHeldMutex_NoTasks( void )
+{
+    pxCurrentTCB = NULL;
+
+    TEST_ASSERT_NULL( pvTaskAddHeldMutex( &( xMutexA.xMutexHeldListItem ) ) );
+    TEST_ASSERT_NULL( xMutexA.xMutexHeldListItem.pxContainer );
+}
+
+/*!
+ * @brief a task that blocks on a mutex raises the holder, the holder of the
+ * mutex the holder waits for, and so on along the chain
+ * @coverage xTaskPriorityInheritChain prvSetInheritedPriority
+ */
+void test_xTaskPriorityInheritChain_RaisesEveryHolder( void )
+{
+    take_mutex( &xTaskL, &xMutexA );
+    take_mutex( &xTaskM, &xMutexB );
+    TEST_ASSERT_EQUAL( pdTRUE, block_on_mutex( &xTaskM, &xMutexA ) );
+    assert_priority( &xTaskL, 2 );
+
+    TEST_ASSERT_EQUAL( pdTRUE, block_on_mutex( &xTaskH, &xMutexB ) );
+
+    assert_priority( &xTaskM, 4 );
+    assert_priority( &xTaskL, 4 );
+    TEST_ASSERT_EQUAL( 1, xTaskL.uxBasePriority );
+    TEST_ASSERT_EQUAL( 2, xTaskM.uxBasePriority );
+    TEST_ASSERT_EQUAL_PTR( &( xMutexB.xMutexHolder ), xTaskH.pxBlockedOnMutexHolder );
+    TEST_ASSERT_EQUAL_PTR( &( xMutexA.xMutexHolder ), xTaskM.pxBlockedOnMutexHolder );
+}
+
+/*!
+ * @brief the walk along the chain stops at the first task already running at
+ * or above the priority of the task that blocks
+ * @coverage xTaskPriorityInheritChain
+ */
+void test_xTaskPriorityInheritChain_StopsAtHigherPriority( void )
+{
+    take_mutex( &xTaskL, &xMutexA );
+    take_mutex( &xTaskX, &xMutexB );
+    TEST_ASSERT_EQUAL( pdTRUE, block_on_mutex( &xTaskX, &xMutexA ) );
+    assert_priority( &xTaskL, 3 );
+
+    /* X already runs above M so neither X nor L is raised. */
+    TEST_ASSERT_EQUAL( pdFALSE, block_on_mutex( &xTaskM, &xMutexB ) );
+
+    assert_priority( &xTaskX, 3 );
+    assert_priority( &xTaskL, 3 );
+}
+
+/*!
+ * @brief a waiting task that inherits a priority is moved to its new place in
+ * the list of tasks waiting for the mutex
+ * @coverage xTaskPriorityInheritChain prvSetInheritedPriority
+ */
+void test_xTaskPriorityInheritChain_ReordersWaitingTask( void )
+{
+    take_mutex( &xTaskL, &xMutexA );
+    take_mutex( &xTaskM, &xMutexB );
+    ( void ) block_on_mutex( &xTaskX, &xMutexA );
+    ( void ) block_on_mutex( &xTaskM, &xMutexA );
+    TEST_ASSERT_EQUAL_PTR( &xTaskX, head_waiter( &xMutexA ) );
+
+    ( void ) block_on_mutex( &xTaskH, &xMutexB );
+
+    TEST_ASSERT_EQUAL_PTR( &xTaskM, head_waiter( &xMutexA ) );
+    TEST_ASSERT_EQUAL( 2, listCURRENT_LIST_LENGTHCallback( &( xMutexA.xTasksWaitingToReceive ), 0 ) );
+    assert_priority( &xTaskL, 4 );
+}
+
+/*!
+ * @brief the walk ends when the mutex holders have deadlocked
+ * @coverage xTaskPriorityInheritChain
+ */
+void test_xTaskPriorityInheritChain_Deadlock( void )
+{
+    take_mutex( &xTaskL, &xMutexA );
+    take_mutex( &xTaskM, &xMutexB );
+    TEST_ASSERT_EQUAL( pdFALSE, block_on_mutex( &xTaskL, &xMutexB ) );
+
+    /* L waits for M, which now waits for L. */
+    TEST_ASSERT_EQUAL( pdTRUE, block_on_mutex( &xTaskM, &xMutexA ) );
+
+    assert_priority( &xTaskL, 2 );
+    assert_priority( &xTaskM, 2 );
+}
+
+/*!
+ * @brief a mutex given back while the calling task was about to block leaves
+ * no holder to raise
+ * @coverage xTaskPriorityInheritChain
+ */
+void test_xTaskPriorityInheritChain_NoHolder( void )
+{
+    pxCurrentTCB = &xTaskH;
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTaskPriorityInheritChain( &( xMutexA.xMutexHolder ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( xMutexA.xMutexHolder ), xTaskH.pxBlockedOnMutexHolder );
+}
+
+/*!
+ * @brief giving a mutex drops only the priority inherited through that mutex
+ * @coverage xTaskRemoveHeldMutex prvUpdateInheritedPriorities prvGetInheritedPriority
+ */
+void test_xTaskRemoveHeldMutex_KeepsPriorityOfOtherMutexes( void )
+{
+    take_mutex( &xTaskL, &xMutexA );
+    take_mutex( &xTaskL, &xMutexC );
+    ( void ) block_on_mutex( &xTaskM, &xMutexC );
+    ( void ) block_on_mutex( &xTaskH, &xMutexA );
+    assert_priority( &xTaskL, 4 );
+
+    /* Giving A drops L to the priority of M, which waits for C. */
+    TEST_ASSERT_EQUAL( pdTRUE, give_mutex( &xTaskL, &xMutexA ) );
+    assert_priority( &xTaskL, 2 );
+    TEST_ASSERT_EQUAL( 1, xTaskL.uxMutexesHeld );
+
+    TEST_ASSERT_EQUAL( pdTRUE, give_mutex( &xTaskL, &xMutexC ) );
+    assert_priority( &xTaskL, 1 );
+    TEST_ASSERT_EQUAL( 0, xTaskL.uxMutexesHeld );
+}
+
+/*!
+ * @brief giving a mutex that did not raise the priority does not request a
+ * yield
+ * @coverage xTaskRemoveHeldMutex prvUpdateInheritedPriorities
+ */
+void test_xTaskRemoveHeldMutex_NoInheritance( void )
+{
+    take_mutex( &xTaskM, &xMutexA );
+    ( void ) block_on_mutex( &xTaskL, &xMutexA );
+
+    TEST_ASSERT_EQUAL( pdFALSE, give_mutex( &xTaskM, &xMutexA ) );
+    assert_priority( &xTaskM, 2 );
+}
+
+/*!
+ * @brief a mutex given from an interrupt is not referenced from the mutexes
+ * held by any task
+ * @coverage xTaskRemoveHeldMutex
+ */
+void test_xTaskRemoveHeldMutex_GivenFromISR( void )
+{
+    take_mutex( &xTaskL, &xMutexC );
+    pxCurrentTCB = &xTaskL;
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTaskRemoveHeldMutex( &( xMutexA.xMutexHeldListItem ) ) );
+    TEST_ASSERT_EQUAL( 1, xTaskL.uxMutexesHeld );
+}
+
+/*!
+ * @brief a task that times out stops passing its priority along the chain
+ * @coverage vTaskPriorityDisinheritChainAfterTimeout prvUpdateInheritedPriorities
+ */
+void test_vTaskPriorityDisinheritChainAfterTimeout_DropsChain( void )
+{
+    take_mutex( &xTaskL, &xMutexA );
+    take_mutex( &xTaskM, &xMutexB );
+    ( void ) block_on_mutex( &xTaskM, &xMutexA );
+    ( void ) block_on_mutex( &xTaskH, &xMutexB );
+    assert_priority( &xTaskL, 4 );
+
+    time_out_on_mutex( &xTaskH, &xMutexB );
+
+    /* M still waits for A, so L keeps the priority of M. */
+    assert_priority( &xTaskM, 2 );
+    assert_priority( &xTaskL, 2 );
+    TEST_ASSERT_NULL( xTaskH.pxBlockedOnMutexHolder );
+    TEST_ASSERT_EQUAL_PTR( &xTaskM, head_waiter( &xMutexA ) );
+}
+
+/*!
+ * @brief the holder keeps the priority of the next task waiting for the mutex
+ * @coverage vTaskPriorityDisinheritChainAfterTimeout prvGetInheritedPriority
+ */
+void test_vTaskPriorityDisinheritChainAfterTimeout_KeepsNextWaiter( void )
+{
+    take_mutex( &xTaskL, &xMutexA );
+    ( void ) block_on_mutex( &xTaskM, &xMutexA );
+    ( void ) block_on_mutex( &xTaskH, &xMutexA );
+    assert_priority( &xTaskL, 4 );
+
+    time_out_on_mutex( &xTaskH, &xMutexA );
+
+    assert_priority( &xTaskL, 2 );
+}
+
+/*!
+ * @brief changing the priority of a waiting task is passed on along the chain
+ * @coverage vTaskPrioritySet prvUpdateInheritedPriorities
+ */
+void test_vTaskPrioritySet_PassedOnToHolder( void )
+{
+    take_mutex( &xTaskL, &xMutexA );
+    ( void ) block_on_mutex( &xTaskM, &xMutexA );
+    pxCurrentTCB = &xTaskH;
+
+    vTaskPrioritySet( &xTaskM, 6 );
+    assert_priority( &xTaskM, 6 );
+    assert_priority( &xTaskL, 6 );
+
+    vTaskPrioritySet( &xTaskM, 0 );
+    assert_priority( &xTaskM, 0 );
+    assert_priority( &xTaskL, 1 );
+}
+
+/*!
+ * @brief a task that holds mutexes cannot be set below the priority it
+ * inherited
+ * @coverage vTaskPrioritySet prvUpdateInheritedPriorities
+ */
+void test_vTaskPrioritySet_HolderKeepsInheritedPriority( void )
+{
+    take_mutex( &xTaskL, &xMutexA );
+    ( void ) block_on_mutex( &xTaskX, &xMutexA );
+    pxCurrentTCB = &xTaskH;
+
+    vTaskPrioritySet( &xTaskL, 2 );
+    assert_priority( &xTaskL, 3 );
+    TEST_ASSERT_EQUAL( 2, xTaskL.uxBasePriority );
+
+    TEST_ASSERT_EQUAL( pdTRUE, give_mutex( &xTaskL, &xMutexA ) );
+    assert_priority( &xTaskL, 2 );
+}
+
+/*!
+ * @brief taking a mutex with a ceiling moves the running task to the ready
+ * list for the ceiling
+ * @coverage vTaskPriorityRaiseToCeiling
+ */
+void test_vTaskPriorityRaiseToCeiling_RaisesRunningTask( void )
+{
+    take_ceiling_mutex( &xTaskL, &xMutexA, 3 );
+
+    assert_priority( &xTaskL, 3 );
+    TEST_ASSERT_EQUAL( 1, xTaskL.uxBasePriority );
+    TEST_ASSERT_EQUAL( 0, listCURRENT_LIST_LENGTHCallback( &( pxReadyTasksLists[ 1 ] ), 0 ) );
+}
+
+/*!
+ * @brief a task that already runs above the ceiling is not lowered to it
+ * @coverage vTaskPriorityRaiseToCeiling
+ */
+void test_vTaskPriorityRaiseToCeiling_DoesNotLower( void )
+{
+    take_mutex( &xTaskL, &xMutexA );
+    ( void ) block_on_mutex( &xTaskH, &xMutexA );
+    assert_priority( &xTaskL, 4 );
+
+    take_ceiling_mutex( &xTaskL, &xMutexB, 2 );
+
+    assert_priority( &xTaskL, 4 );
+}
+
+/*!
+ * @brief a mutex with a ceiling taken before the scheduler has any tasks does
+ * not raise a task
+ * @coverage vTaskPriorityRaiseToCeiling
+ */
+void test_vTaskPriorityRaiseToCeiling_NoTasks( void )
+{
+    pxCurrentTCB = NULL;
+
+    vTaskPriorityRaiseToCeiling( 3 );
+
+    assert_priority( &xTaskL, 1 );
+    assert_priority( &xTaskM, 2 );
+}
+
+/*!
+ * @brief an event list item value that is in use is left unchanged when the
+ * running task is raised to the ceiling
+ * @coverage vTaskPriorityRaiseToCeiling
+ */
+void test_vTaskPriorityRaiseToCeiling_EventItemValueInUse( void )
+{
+    xTaskL.xEventListItem.xItemValue = 7 | taskEVENT_LIST_ITEM_VALUE_IN_USE;
+
+    take_ceiling_mutex( &xTaskL, &xMutexA, 3 );
+
+    TEST_ASSERT_EQUAL( 3, xTaskL.uxPriority );
+    TEST_ASSERT_EQUAL( 7 | taskEVENT_LIST_ITEM_VALUE_IN_USE, xTaskL.xEventListItem.xItemValue );
+    TEST_ASSERT_EQUAL_PTR( &( pxReadyTasksLists[ 3 ] ), xTaskL.xStateListItem.pxContainer );
+}
+
+/*!
+ * @brief giving back a mutex the holder inherited a priority through keeps
+ * the ceiling of a mutex it still holds, and giving back the mutex with the
+ * ceiling drops the holder to its base priority
+ * @coverage xTaskRemoveHeldMutex prvGetInheritedPriority
+ */
+void test_xTaskRemoveHeldMutex_KeepsCeilingOfHeldMutex( void )
+{
+    take_ceiling_mutex( &xTaskL, &xMutexA, 2 );
+    take_mutex( &xTaskL, &xMutexB );
+    ( void ) block_on_mutex( &xTaskH, &xMutexB );
+    assert_priority( &xTaskL, 4 );
+
+    TEST_ASSERT_EQUAL( pdTRUE, give_mutex( &xTaskL, &xMutexB ) );
+    assert_priority( &xTaskL, 2 );
+
+    TEST_ASSERT_EQUAL( pdTRUE, give_mutex( &xTaskL, &xMutexA ) );
+    assert_priority( &xTaskL, 1 );
+}
+
+/*!
+ * @brief a task that times out waiting for a mutex leaves the holder at the
+ * ceiling of the mutex the holder has
+ * @coverage vTaskPriorityDisinheritChainAfterTimeout prvGetInheritedPriority
+ */
+void test_vTaskPriorityDisinheritChainAfterTimeout_KeepsCeiling( void )
+{
+    take_ceiling_mutex( &xTaskL, &xMutexA, 2 );
+    take_mutex( &xTaskL, &xMutexB );
+    ( void ) block_on_mutex( &xTaskX, &xMutexB );
+    assert_priority( &xTaskL, 3 );
+
+    time_out_on_mutex( &xTaskX, &xMutexB );
+
+    assert_priority( &xTaskL, 2 );
+}
@@ -0,0 +1,824 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/*! @file timers_wheel_utest.c */
+
+/* Test includes. */
+#include "FreeRTOS.h"
+#include "FreeRTOSConfig.h"
+#include "portmacro.h"
+#include "timers.h"
+
+#include "global_vars.h"
+
+#include "unity.h"
+#include "unity_memory.h"
+
+/* Mock includes. */
+#include "mock_queue.h"
+#include "mock_list.h"
+#include "mock_list_macros.h"
+#include "mock_fake_assert.h"
+#include "mock_portable.h"
+#include "mock_task.h"
+
+/* C runtime includes. */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+void stopTimers();
+
+/* =================================  DEFINES  ============================== */
+
+/* The number of ticks covered by the timer wheel configured in
+ * FreeRTOSConfig_wheel.h, beyond which timers are held in the sorted list. */
+#define TEST_WHEEL_SPAN        ( 1U << ( configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS ) )
+
+#define TEST_MAX_TIMERS        ( 12 )
+#define TEST_MAX_EXPIRIES      ( 64 )
+#define TEST_MAX_EVENTS        ( 4 )
+#define TEST_NO_TIMER          ( -1 )
+
+#define TEST_TIMER_NAME        "ut_timer"
+
+/* ============================  GLOBAL VARIABLES =========================== */
+
+/* A timer expiry recorded by the timer callback. */
+typedef struct
+{
+    int32_t lTimer;
+    TickType_t xTime;
+} Expiry_t;
+
+/* A function the test runs, as an application task, when the timer service
+ * task blocks and xElapsed has reached xTime. */
+typedef struct
+{
+    TickType_t xTime;
+    void ( * pxFunction )( void );
+} Event_t;
+
+static char task_memory[ 200 ];
+static TaskHandle_t const xApplicationTask = ( TaskHandle_t ) 0x1234;
+static TaskHandle_t const xTimerTask = ( TaskHandle_t ) task_memory;
+static TaskHandle_t xCurrentTask;
+
+static TickType_t xStartTime;
+static TickType_t xElapsed;
+static TickType_t xEndTime;
+static TickType_t xTickCount;
+
+static Event_t xEvents[ TEST_MAX_EVENTS ];
+static UBaseType_t uxEventCount;
+static UBaseType_t uxNextEvent;
+
+static StaticTimer_t xTimerBuffers[ TEST_MAX_TIMERS ];
+static TimerHandle_t xTimers[ TEST_MAX_TIMERS ];
+
+static Expiry_t xExpiries[ TEST_MAX_EXPIRIES ];
+static UBaseType_t uxExpiryCount;
+
+/* The timer command queue, as a ring buffer. */
+static DaemonTaskMessage_t xCommandQueue[ configTIMER_QUEUE_LENGTH ];
+static UBaseType_t uxCommandQueueHead;
+static UBaseType_t uxCommandsQueued;
+static UBaseType_t uxCommandsSentByTimerTask;
+static UBaseType_t uxCommandsSentFromISR;
+static UBaseType_t uxBatchesReceived;
+static UBaseType_t uxLargestBatch;
+
+/* The action taken by xTimerCallback() when the timer it is called for
+ * expires. */
+static void ( * pxTimerAction[ TEST_MAX_TIMERS ] )( void );
+
+/* =============================  FUNCTION HOOKS  =========================== */
+void vFakePortEnterCriticalSection( void )
+{
+}
+
+void vFakePortExitCriticalSection( void )
+{
+}
+
+void vFakePortYieldWithinAPI()
+{
+    /* xTaskResumeAll() always returns pdTRUE, so the timer service task never
+     * yields. */
+    TEST_FAIL();
+}
+
+void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                     StackType_t ** ppxTimerTaskStackBuffer,
+                                     uint32_t * pulTimerTaskStackSize )
+{
+    static StaticTask_t xTimerTaskTCB;
+    static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+    *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+    *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+void vApplicationDaemonTaskStartupHook( void )
+{
+}
+
+/* ==========================  CALLBACK FUNCTIONS  ========================== */
+
+/* The list functions are mocked for the other timers tests, so provide the
+ * behaviour of list.c and the list macros here.  The timer wheel also walks
+ * the lists directly, through the macros that are not mocked. */
+static void vListInitialiseCallback( List_t * const pxList,
+                                     int cmock_num_calls )
+{
+    pxList->pxIndex = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.xItemValue = portMAX_DELAY;
+    pxList->xListEnd.pxNext = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->xListEnd.pxPrevious = ( ListItem_t * ) &( pxList->xListEnd );
+    pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
+}
+
+static void vListInitialiseItemCallback( ListItem_t * const pxItem,
+                                         int cmock_num_calls )
+{
+    pxItem->pxContainer = NULL;
+}
+
+static void vListInsertEndCallback( List_t * const pxList,
+                                    ListItem_t * const pxNewListItem,
+                                    int cmock_num_calls )
+{
+    ListItem_t * const pxIndex = pxList->pxIndex;
+
+    pxNewListItem->pxNext = pxIndex;
+    pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    pxIndex->pxPrevious->pxNext = pxNewListItem;
+    pxIndex->pxPrevious = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    ( pxList->uxNumberOfItems )++;
+}
+
+static void vListInsertCallback( List_t * const pxList,
+                                 ListItem_t * const pxNewListItem,
+                                 int cmock_num_calls )
+{
+    ListItem_t * pxIterator;
+
+    for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd );
+         ( pxIterator->pxNext != ( ListItem_t * ) &( pxList->xListEnd ) ) && ( pxIterator->pxNext->xItemValue <= pxNewListItem->xItemValue );
+         pxIterator = pxIterator->pxNext )
+    {
+    }
+
+    pxNewListItem->pxNext = pxIterator->pxNext;
+    pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+    pxNewListItem->pxPrevious = pxIterator;
+    pxIterator->pxNext = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    ( pxList->uxNumberOfItems )++;
+}
+
+static UBaseType_t uxListRemoveCallback( ListItem_t * const pxItemToRemove,
+                                         int cmock_num_calls )
+{
+    List_t * const pxList = pxItemToRemove->pxContainer;
+
+    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+
+    if( pxList->pxIndex == pxItemToRemove )
+    {
+        pxList->pxIndex = pxItemToRemove->pxPrevious;
+    }
+
+    pxItemToRemove->pxContainer = NULL;
+    ( pxList->uxNumberOfItems )--;
+
+    return pxList->uxNumberOfItems;
+}
+
+static BaseType_t listLIST_IS_EMPTYCallback( const List_t * pxList,
+                                             int cmock_num_calls )
+{
+    return ( pxList->uxNumberOfItems == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+}
+
+static void * listGET_OWNER_OF_HEAD_ENTRYCallback( const List_t * pxList,
+                                                   int cmock_num_calls )
+{
+    return pxList->xListEnd.pxNext->pvOwner;
+}
+
+static BaseType_t listIS_CONTAINED_WITHINCallback( List_t * list,
+                                                   const ListItem_t * listItem,
+                                                   int cmock_num_calls )
+{
+    return ( listItem->pxContainer == list ) ? pdTRUE : pdFALSE;
+}
+
+static TickType_t listGET_LIST_ITEM_VALUECallback( ListItem_t * listItem,
+                                                   int cmock_num_calls )
+{
+    return listItem->xItemValue;
+}
+
+static void listSET_LIST_ITEM_VALUECallback( ListItem_t * listItem,
+                                             TickType_t itemValue,
+                                             int cmock_num_calls )
+{
+    listItem->xItemValue = itemValue;
+}
+
+static TickType_t listGET_ITEM_VALUE_OF_HEAD_ENTRYCallback( List_t * list,
+                                                            int cmock_num_calls )
+{
+    return list->xListEnd.pxNext->xItemValue;
+}
+
+/* The timer command queue. */
+static void push_command( const void * const pvItemToQueue )
+{
+    TEST_ASSERT_LESS_THAN( configTIMER_QUEUE_LENGTH, uxCommandsQueued );
+    memcpy( &( xCommandQueue[ ( uxCommandQueueHead + uxCommandsQueued ) % configTIMER_QUEUE_LENGTH ] ), pvItemToQueue, sizeof( DaemonTaskMessage_t ) );
+    uxCommandsQueued++;
+}
+
+static BaseType_t xQueueGenericSendCallback( QueueHandle_t xQueue,
+                                             const void * const pvItemToQueue,
+                                             TickType_t xTicksToWait,
+                                             const BaseType_t xCopyPosition,
+                                             int cmock_num_calls )
+{
+    if( xCurrentTask == xTimerTask )
+    {
+        uxCommandsSentByTimerTask++;
+    }
+
+    push_command( pvItemToQueue );
+
+    return pdPASS;
+}
+
+static BaseType_t xQueueGenericSendFromISRCallback( QueueHandle_t xQueue,
+                                                    const void * const pvItemToQueue,
+                                                    BaseType_t * const pxHigherPriorityTaskWoken,
+                                                    const BaseType_t xCopyPosition,
+                                                    int cmock_num_calls )
+{
+    uxCommandsSentFromISR++;
+    push_command( pvItemToQueue );
+
+    return pdPASS;
+}
+
+static UBaseType_t xQueueReceiveMultipleCallback( QueueHandle_t xQueue,
+                                                  void * const pvBuffer,
+                                                  UBaseType_t uxMaxItems,
+                                                  TickType_t xTicksToWait,
+                                                  int cmock_num_calls )
+{
+    DaemonTaskMessage_t * const pxMessages = ( DaemonTaskMessage_t * ) pvBuffer;
+    UBaseType_t uxReceived;
+
+    TEST_ASSERT_EQUAL( configTIMER_COMMAND_BATCH_SIZE, uxMaxItems );
+
+    for( uxReceived = 0; ( uxReceived < uxMaxItems ) && ( uxCommandsQueued > 0 ); uxReceived++ )
+    {
+        pxMessages[ uxReceived ] = xCommandQueue[ uxCommandQueueHead ];
+        uxCommandQueueHead = ( uxCommandQueueHead + 1 ) % configTIMER_QUEUE_LENGTH;
+        uxCommandsQueued--;
+    }
+
+    if( uxReceived > 0 )
+    {
+        uxBatchesReceived++;
+
+        if( uxReceived > uxLargestBatch )
+        {
+            uxLargestBatch = uxReceived;
+        }
+    }
+
+    return uxReceived;
+}
+
+static UBaseType_t uxQueueMessagesWaitingFromISRCallback( const QueueHandle_t xQueue,
+                                                          int cmock_num_calls )
+{
+    return uxCommandsQueued;
+}
+
+/* The timer service task blocks.  Move time on to the next event, which is run
+ * as if by an application task, or to the end of the block time.  The test ends
+ * when there is nothing left to do before xEndTime. */
+static void vQueueWaitForMessageRestrictedCallback( QueueHandle_t xQueue,
+                                                    TickType_t xTicksToWait,
+                                                    const BaseType_t xWaitIndefinitely,
+                                                    int cmock_num_calls )
+{
+    TickType_t xWakeTime = xEndTime;
+
+    if( uxCommandsQueued > 0 )
+    {
+        /* A command is waiting, so the task does not block. */
+        return;
+    }
+
+    if( ( xWaitIndefinitely == pdFALSE ) && ( xTicksToWait < ( xEndTime - xElapsed ) ) )
+    {
+        xWakeTime = xElapsed + xTicksToWait;
+    }
+
+    if( ( uxNextEvent < uxEventCount ) && ( xEvents[ uxNextEvent ].xTime <= xWakeTime ) )
+    {
+        xElapsed = xEvents[ uxNextEvent ].xTime;
+        xTickCount = xStartTime + xElapsed;
+        xCurrentTask = xApplicationTask;
+        xEvents[ uxNextEvent ].pxFunction();
+        xCurrentTask = xTimerTask;
+        uxNextEvent++;
+    }
+    else if( xWakeTime < xEndTime )
+    {
+        xElapsed = xWakeTime;
+        xTickCount = xStartTime + xElapsed;
+    }
+    else
+    {
+        xElapsed = xEndTime;
+        xTickCount = xStartTime + xElapsed;
+        pthread_exit( NULL );
+    }
+}
+
+static TickType_t xTaskGetTickCountCallback( int cmock_num_calls )
+{
+    return xTickCount;
+}
+
+static TaskHandle_t xTaskGetCurrentTaskHandleCallback( int cmock_num_calls )
+{
+    return xCurrentTask;
+}
+
+/* The callback of every timer.  Records the expiry, then takes the action set
+ * for the timer, if any. */
+static void xTimerCallback( TimerHandle_t xTimer )
+{
+    const int32_t lTimer = ( int32_t ) ( intptr_t ) pvTimerGetTimerID( xTimer );
+
+    TEST_ASSERT_LESS_THAN( TEST_MAX_EXPIRIES, uxExpiryCount );
+    xExpiries[ uxExpiryCount ].lTimer = lTimer;
+    xExpiries[ uxExpiryCount ].xTime = xTickCount;
+    uxExpiryCount++;
+
+    if( pxTimerAction[ lTimer ] != NULL )
+    {
+        pxTimerAction[ lTimer ]();
+    }
+}
+
+/* =============================  STATIC FUNCTIONS  ========================= */
+static void * timer_thread_function( void * args )
+{
+    void * pvParameters = NULL;
+
+    portTASK_FUNCTION( prvTimerTask, pvParameters );
+    ( void ) fool_static2; /* ignore unused variable warning */
+    xCurrentTask = xTimerTask;
+    /* API Call */
+    prvTimerTask( pvParameters );
+    return NULL;
+}
+
+static void create_timer_task( TickType_t xTime )
+{
+    xStartTime = xTime;
+    xTickCount = xTime;
+    TEST_ASSERT_TRUE( xTimerCreateTimerTask() );
+}
+
+static TimerHandle_t create_timer( int32_t lTimer,
+                                   TickType_t xPeriod,
+                                   BaseType_t xAutoReload )
+{
+    xTimers[ lTimer ] = xTimerCreateStatic( TEST_TIMER_NAME,
+                                            xPeriod,
+                                            xAutoReload,
+                                            ( void * ) ( intptr_t ) lTimer,
+                                            xTimerCallback,
+                                            &( xTimerBuffers[ lTimer ] ) );
+    TEST_ASSERT_NOT_NULL( xTimers[ lTimer ] );
+    return xTimers[ lTimer ];
+}
+
+static void add_event( TickType_t xTime,
+                       void ( * pxFunction )( void ) )
+{
+    TEST_ASSERT_LESS_THAN( TEST_MAX_EVENTS, uxEventCount );
+    xEvents[ uxEventCount ].xTime = xTime;
+    xEvents[ uxEventCount ].pxFunction = pxFunction;
+    uxEventCount++;
+}
+
+/* Run the timer service task until xEnd ticks after the start time. */
+static void run_timer_task( TickType_t xEnd )
+{
+    pthread_t thread_id;
+
+    xEndTime = xEnd;
+    pthread_create( &thread_id, NULL, &timer_thread_function, NULL );
+    pthread_join( thread_id, NULL );
+    xCurrentTask = xApplicationTask;
+}
+
+static void validate_expiries( const Expiry_t * pxExpected,
+                               UBaseType_t uxExpected )
+{
+    UBaseType_t ux;
+
+    for( ux = 0; ( ux < uxExpected ) && ( ux < uxExpiryCount ); ux++ )
+    {
+        TEST_ASSERT_EQUAL_INT32( pxExpected[ ux ].lTimer, xExpiries[ ux ].lTimer );
+        TEST_ASSERT_EQUAL_UINT32( xStartTime + pxExpected[ ux ].xTime, xExpiries[ ux ].xTime );
+    }
+
+    TEST_ASSERT_EQUAL( uxExpected, uxExpiryCount );
+}
+
+/* ============================  UNITY FIXTURES  =========================== */
+void setUp( void )
+{
+    vFakeAssert_Ignore();
+
+    vListInitialise_StubWithCallback( vListInitialiseCallback );
+    vListInitialiseItem_StubWithCallback( vListInitialiseItemCallback );
+    vListInsertEnd_StubWithCallback( vListInsertEndCallback );
+    vListInsert_StubWithCallback( vListInsertCallback );
+    uxListRemove_StubWithCallback( uxListRemoveCallback );
+    listLIST_IS_EMPTY_StubWithCallback( listLIST_IS_EMPTYCallback );
+    listGET_OWNER_OF_HEAD_ENTRY_StubWithCallback( listGET_OWNER_OF_HEAD_ENTRYCallback );
+    listIS_CONTAINED_WITHIN_StubWithCallback( listIS_CONTAINED_WITHINCallback );
+    listGET_LIST_ITEM_VALUE_StubWithCallback( listGET_LIST_ITEM_VALUECallback );
+    listSET_LIST_ITEM_VALUE_StubWithCallback( listSET_LIST_ITEM_VALUECallback );
+    listGET_ITEM_VALUE_OF_HEAD_ENTRY_StubWithCallback( listGET_ITEM_VALUE_OF_HEAD_ENTRYCallback );
+
+    xQueueGenericCreateStatic_IgnoreAndReturn( ( QueueHandle_t ) 3 );
+    vQueueAddToRegistry_Ignore();
+    xQueueGenericSend_StubWithCallback( xQueueGenericSendCallback );
+    xQueueGenericSendFromISR_StubWithCallback( xQueueGenericSendFromISRCallback );
+    xQueueReceiveMultiple_StubWithCallback( xQueueReceiveMultipleCallback );
+    uxQueueMessagesWaitingFromISR_StubWithCallback( uxQueueMessagesWaitingFromISRCallback );
+    vQueueWaitForMessageRestricted_StubWithCallback( vQueueWaitForMessageRestrictedCallback );
+
+    xTaskCreateStatic_IgnoreAndReturn( xTimerTask );
+    xTaskGetSchedulerState_IgnoreAndReturn( taskSCHEDULER_RUNNING );
+    xTaskGetTickCount_StubWithCallback( xTaskGetTickCountCallback );
+    xTaskGetTickCountFromISR_StubWithCallback( xTaskGetTickCountCallback );
+    xTaskGetCurrentTaskHandle_StubWithCallback( xTaskGetCurrentTaskHandleCallback );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdTRUE );
+
+    xCurrentTask = xApplicationTask;
+    xElapsed = 0;
+    uxEventCount = 0;
+    uxNextEvent = 0;
+    uxExpiryCount = 0;
+    uxCommandQueueHead = 0;
+    uxCommandsQueued = 0;
+    uxCommandsSentByTimerTask = 0;
+    uxCommandsSentFromISR = 0;
+    uxBatchesReceived = 0;
+    uxLargestBatch = 0;
+    memset( pxTimerAction, 0, sizeof( pxTimerAction ) );
+
+    /* Track calls to malloc / free */
+    UnityMalloc_StartTest();
+    stopTimers();
+}
+
+/*! called before each testcase */
+void tearDown( void )
+{
+    UnityMalloc_EndTest();
+}
+
+/*! called at the beginning of the whole suite */
+void suiteSetUp()
+{
+}
+
+/*! called at the end of the whole suite */
+int suiteTearDown( int numFailures )
+{
+    return numFailures;
+}
+
+/* ==============================  TEST FUNCTIONS  ========================== */
+
+/**
+ * @brief One-shot timers whose periods place them on each level of the wheel,
+ * and beyond it in the sorted list, expire in order at their expiry times.
+ */
+void test_timer_wheel_one_shot_timers_expire_in_order( void )
+{
+    static const TickType_t xPeriods[] = { 1, 2, 3, 7, 9, 30, TEST_WHEEL_SPAN - 1, TEST_WHEEL_SPAN, TEST_WHEEL_SPAN + 1, 200, 1000 };
+    Expiry_t xExpected[ sizeof( xPeriods ) / sizeof( xPeriods[ 0 ] ) ];
+    int32_t lTimer;
+
+    create_timer_task( 0 );
+
+    /* Start the longest timers first so expiry order is not creation order. */
+    for( lTimer = ( int32_t ) ( sizeof( xPeriods ) / sizeof( xPeriods[ 0 ] ) ) - 1; lTimer >= 0; lTimer-- )
+    {
+        create_timer( lTimer, xPeriods[ lTimer ], pdFALSE );
+        TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ lTimer ], 0 ) );
+        xExpected[ lTimer ].lTimer = lTimer;
+        xExpected[ lTimer ].xTime = xPeriods[ lTimer ];
+    }
+
+    run_timer_task( 2000 );
+
+    validate_expiries( xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+
+    for( lTimer = 0; lTimer < ( int32_t ) ( sizeof( xPeriods ) / sizeof( xPeriods[ 0 ] ) ); lTimer++ )
+    {
+        TEST_ASSERT_FALSE( xTimerIsTimerActive( xTimers[ lTimer ] ) );
+    }
+}
+
+/**
+ * @brief Auto-reload timers are reinserted into the wheel each time they
+ * expire, and expire at every multiple of their period.
+ */
+void test_timer_wheel_auto_reload_timers_expire_periodically( void )
+{
+    static const Expiry_t xExpected[] =
+    {
+        { 0, 5 }, { 0, 10 }, { 0, 15 }, { 0, 20 }, { 1, 23 }, { 0, 25 },
+        { 0, 30 }, { 0, 35 }, { 0, 40 }, { 0, 45 }, { 1, 46 }, { 0, 50 },
+        { 0, 55 }, { 0, 60 }, { 0, 65 }, { 1, 69 }, { 0, 70 }, { 0, 75 },
+        { 0, 80 }, { 0, 85 }, { 0, 90 }, { 1, 92 }, { 0, 95 }
+    };
+
+    create_timer_task( 0 );
+    create_timer( 0, 5, pdTRUE );
+    create_timer( 1, 23, pdTRUE );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 1 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 0 ], 0 ) );
+
+    run_timer_task( 100 );
+
+    validate_expiries( xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+    TEST_ASSERT_TRUE( xTimerIsTimerActive( xTimers[ 0 ] ) );
+    TEST_ASSERT_TRUE( xTimerIsTimerActive( xTimers[ 1 ] ) );
+}
+
+static void stop_reset_and_change_period( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStop( xTimers[ 0 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerReset( xTimers[ 1 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerChangePeriod( xTimers[ 2 ], 5, 0 ) );
+}
+
+static void start_first_timer( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 0 ], 0 ) );
+}
+
+/**
+ * @brief Commands sent by an application task while the timer service task is
+ * blocked move timers between slots of the wheel.
+ */
+void test_timer_wheel_commands_from_application_task( void )
+{
+    static const Expiry_t xExpected[] = { { 2, 15 }, { 1, 30 }, { 0, 70 } };
+
+    create_timer_task( 0 );
+    create_timer( 0, 20, pdFALSE );
+    create_timer( 1, 20, pdFALSE );
+    create_timer( 2, 30, pdFALSE );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 0 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 1 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 2 ], 0 ) );
+    add_event( 10, stop_reset_and_change_period );
+    add_event( 50, start_first_timer );
+
+    run_timer_task( 100 );
+
+    TEST_ASSERT_EQUAL( 2, uxNextEvent );
+    validate_expiries( xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+    TEST_ASSERT_EQUAL( 0, uxCommandsSentByTimerTask );
+}
+
+/**
+ * @brief Timers that expire after the tick count overflows are held until
+ * the timer lists are switched, then placed in the wheel from time zero.
+ */
+void test_timer_wheel_tick_count_overflow( void )
+{
+    static const Expiry_t xExpected[] = { { 0, 5 }, { 2, 8 }, { 2, 16 }, { 1, 20 }, { 2, 24 }, { 2, 32 } };
+
+    create_timer_task( portMAX_DELAY - 9 );
+    create_timer( 0, 5, pdFALSE );
+    create_timer( 1, 20, pdFALSE );
+    create_timer( 2, 8, pdTRUE );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 0 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 1 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 2 ], 0 ) );
+
+    run_timer_task( 35 );
+
+    validate_expiries( xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+}
+
+/**
+ * @brief Commands are taken from the queue configTIMER_COMMAND_BATCH_SIZE at a
+ * time, and are processed in the order they were sent.
+ */
+void test_timer_wheel_commands_received_in_batches( void )
+{
+    static const Expiry_t xExpected[] = { { 5, 10 }, { 4, 11 }, { 3, 12 }, { 2, 13 }, { 1, 14 }, { 0, 15 } };
+    int32_t lTimer;
+
+    create_timer_task( 0 );
+
+    for( lTimer = 0; lTimer < 6; lTimer++ )
+    {
+        create_timer( lTimer, 1, pdFALSE );
+        TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ lTimer ], 0 ) );
+    }
+
+    /* The period of each timer is changed after its start command, so the
+     * expiry times are only as expected if the order is kept. */
+    for( lTimer = 0; lTimer < 6; lTimer++ )
+    {
+        TEST_ASSERT_EQUAL( pdPASS, xTimerChangePeriod( xTimers[ lTimer ], 15 - lTimer, 0 ) );
+    }
+
+    run_timer_task( 20 );
+
+    validate_expiries( xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+    TEST_ASSERT_EQUAL( configTIMER_COMMAND_BATCH_SIZE, uxLargestBatch );
+    TEST_ASSERT_EQUAL( 3, uxBatchesReceived );
+}
+
+static BaseType_t xDirectResults[ 4 ];
+
+static void send_direct_commands( void )
+{
+    pxTimerAction[ 0 ] = NULL;
+    xDirectResults[ 0 ] = xTimerReset( xTimers[ 1 ], portMAX_DELAY );
+    xDirectResults[ 1 ] = xTimerStop( xTimers[ 2 ], portMAX_DELAY );
+    xDirectResults[ 2 ] = xTimerChangePeriod( xTimers[ 3 ], 5, portMAX_DELAY );
+    xDirectResults[ 3 ] = xTimerIsTimerActive( xTimers[ 2 ] );
+}
+
+/**
+ * @brief Commands sent by a callback, from the timer service task, are
+ * applied directly instead of being sent to the timer queue.
+ */
+void test_timer_wheel_direct_commands_from_callback( void )
+{
+    static const Expiry_t xExpected[] = { { 0, 10 }, { 3, 15 }, { 0, 20 }, { 1, 25 }, { 0, 30 } };
+
+    create_timer_task( 0 );
+    create_timer( 0, 10, pdTRUE );
+    create_timer( 1, 15, pdFALSE );
+    create_timer( 2, 12, pdFALSE );
+    create_timer( 3, 50, pdFALSE );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 0 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 1 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 2 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 3 ], 0 ) );
+    pxTimerAction[ 0 ] = send_direct_commands;
+
+    run_timer_task( 32 );
+
+    validate_expiries( xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+    TEST_ASSERT_EQUAL( pdPASS, xDirectResults[ 0 ] );
+    TEST_ASSERT_EQUAL( pdPASS, xDirectResults[ 1 ] );
+    TEST_ASSERT_EQUAL( pdPASS, xDirectResults[ 2 ] );
+    TEST_ASSERT_FALSE( xDirectResults[ 3 ] );
+    TEST_ASSERT_EQUAL( 0, uxCommandsSentByTimerTask );
+}
+
+static void delete_then_reset( void )
+{
+    pxTimerAction[ 0 ] = NULL;
+    xDirectResults[ 0 ] = xTimerDelete( xTimers[ 2 ], portMAX_DELAY );
+    xDirectResults[ 1 ] = xTimerReset( xTimers[ 1 ], portMAX_DELAY );
+    xDirectResults[ 2 ] = xTimerIsTimerActive( xTimers[ 2 ] );
+}
+
+/**
+ * @brief Deleting a timer from a callback is always sent to the timer queue,
+ * and a later command from the same callback is queued behind it so the order
+ * of the commands is kept.
+ */
+void test_timer_wheel_delete_from_callback_is_queued( void )
+{
+    static const Expiry_t xExpected[] = { { 0, 10 }, { 1, 25 } };
+
+    create_timer_task( 0 );
+    create_timer( 0, 10, pdFALSE );
+    create_timer( 1, 15, pdFALSE );
+    create_timer( 2, 12, pdFALSE );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 0 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 1 ], 0 ) );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 2 ], 0 ) );
+    pxTimerAction[ 0 ] = delete_then_reset;
+
+    run_timer_task( 40 );
+
+    validate_expiries( xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+    TEST_ASSERT_EQUAL( pdPASS, xDirectResults[ 0 ] );
+    TEST_ASSERT_EQUAL( pdPASS, xDirectResults[ 1 ] );
+    /* The delete command had not been processed when the callback returned. */
+    TEST_ASSERT_TRUE( xDirectResults[ 2 ] );
+    TEST_ASSERT_EQUAL( 2, uxCommandsSentByTimerTask );
+    TEST_ASSERT_FALSE( xTimerIsTimerActive( xTimers[ 2 ] ) );
+}
+
+static void change_own_period( void )
+{
+    pxTimerAction[ 0 ] = NULL;
+    xDirectResults[ 0 ] = xTimerChangePeriod( xTimers[ 0 ], 25, portMAX_DELAY );
+}
+
+/**
+ * @brief An auto-reload timer whose callback changes its period directly uses
+ * the new period from the time of the change.
+ */
+void test_timer_wheel_auto_reload_changes_own_period( void )
+{
+    static const Expiry_t xExpected[] = { { 0, 10 }, { 0, 35 }, { 0, 60 } };
+
+    create_timer_task( 0 );
+    create_timer( 0, 10, pdTRUE );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 0 ], 0 ) );
+    pxTimerAction[ 0 ] = change_own_period;
+
+    run_timer_task( 70 );
+
+    validate_expiries( xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+    TEST_ASSERT_EQUAL( pdPASS, xDirectResults[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, uxCommandsSentByTimerTask );
+    TEST_ASSERT_EQUAL( 25, xTimerGetPeriod( xTimers[ 0 ] ) );
+}
+
+static void start_from_isr( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    pxTimerAction[ 0 ] = NULL;
+    xDirectResults[ 0 ] = xTimerStartFromISR( xTimers[ 1 ], &xHigherPriorityTaskWoken );
+    xDirectResults[ 1 ] = xTimerIsTimerActive( xTimers[ 1 ] );
+}
+
+/**
+ * @brief Commands sent with the FromISR API are never applied directly, even
+ * when called from the timer service task.
+ */
+void test_timer_wheel_from_isr_command_is_queued( void )
+{
+    static const Expiry_t xExpected[] = { { 0, 10 }, { 1, 15 } };
+
+    create_timer_task( 0 );
+    create_timer( 0, 10, pdFALSE );
+    create_timer( 1, 5, pdFALSE );
+    TEST_ASSERT_EQUAL( pdPASS, xTimerStart( xTimers[ 0 ], 0 ) );
+    pxTimerAction[ 0 ] = start_from_isr;
+
+    run_timer_task( 20 );
+
+    validate_expiries( xExpected, sizeof( xExpected ) / sizeof( xExpected[ 0 ] ) );
+    TEST_ASSERT_EQUAL( pdPASS, xDirectResults[ 0 ] );
+    TEST_ASSERT_FALSE( xDirectResults[ 1 ] );
+    TEST_ASSERT_EQUAL( 1, uxCommandsSentFromISR );
+    TEST_ASSERT_EQUAL( 0, uxCommandsSentByTimerTask );
+}